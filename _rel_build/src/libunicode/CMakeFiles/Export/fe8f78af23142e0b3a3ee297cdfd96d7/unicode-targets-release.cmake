@@ -0,0 +1,39 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Release".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "unicode::unicode_ucd" for configuration "Release"
+set_property(TARGET unicode::unicode_ucd APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(unicode::unicode_ucd PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libunicode_ucd.so.0.3.1"
+  IMPORTED_SONAME_RELEASE "libunicode_ucd.so.0.3"
+  )
+
+list(APPEND _cmake_import_check_targets unicode::unicode_ucd )
+list(APPEND _cmake_import_check_files_for_unicode::unicode_ucd "${_IMPORT_PREFIX}/lib/libunicode_ucd.so.0.3.1" )
+
+# Import target "unicode::unicode_loader" for configuration "Release"
+set_property(TARGET unicode::unicode_loader APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(unicode::unicode_loader PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libunicode_loader.so.0.3.1"
+  IMPORTED_SONAME_RELEASE "libunicode_loader.so.0.3"
+  )
+
+list(APPEND _cmake_import_check_targets unicode::unicode_loader )
+list(APPEND _cmake_import_check_files_for_unicode::unicode_loader "${_IMPORT_PREFIX}/lib/libunicode_loader.so.0.3.1" )
+
+# Import target "unicode::unicode" for configuration "Release"
+set_property(TARGET unicode::unicode APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(unicode::unicode PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libunicode.so.0.3.1"
+  IMPORTED_SONAME_RELEASE "libunicode.so.0.3"
+  )
+
+list(APPEND _cmake_import_check_targets unicode::unicode )
+list(APPEND _cmake_import_check_files_for_unicode::unicode "${_IMPORT_PREFIX}/lib/libunicode.so.0.3.1" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
@@ -0,0 +1,54 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/libunicode/bidi_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/bidi_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/bidi_segmenter.cpp.o.d"
+  "/root/repo/src/libunicode/capi.cpp" "src/libunicode/CMakeFiles/unicode.dir/capi.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/capi.cpp.o.d"
+  "/root/repo/src/libunicode/case_mapping.cpp" "src/libunicode/CMakeFiles/unicode.dir/case_mapping.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/case_mapping.cpp.o.d"
+  "/root/repo/src/libunicode/codepoint_properties.cpp" "src/libunicode/CMakeFiles/unicode.dir/codepoint_properties.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/codepoint_properties.cpp.o.d"
+  "/root/repo/src/libunicode/codepoint_properties_data.cpp" "src/libunicode/CMakeFiles/unicode.dir/codepoint_properties_data.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/codepoint_properties_data.cpp.o.d"
+  "/root/repo/src/libunicode/codepoint_properties_file.cpp" "src/libunicode/CMakeFiles/unicode.dir/codepoint_properties_file.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/codepoint_properties_file.cpp.o.d"
+  "/root/repo/src/libunicode/codepoint_properties_names.cpp" "src/libunicode/CMakeFiles/unicode.dir/codepoint_properties_names.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/codepoint_properties_names.cpp.o.d"
+  "/root/repo/src/libunicode/column_slice.cpp" "src/libunicode/CMakeFiles/unicode.dir/column_slice.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/column_slice.cpp.o.d"
+  "/root/repo/src/libunicode/convert.cpp" "src/libunicode/CMakeFiles/unicode.dir/convert.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/convert.cpp.o.d"
+  "/root/repo/src/libunicode/document_segmentation.cpp" "src/libunicode/CMakeFiles/unicode.dir/document_segmentation.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/document_segmentation.cpp.o.d"
+  "/root/repo/src/libunicode/emoji_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/emoji_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/emoji_segmenter.cpp.o.d"
+  "/root/repo/src/libunicode/fused_run_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/fused_run_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/fused_run_segmenter.cpp.o.d"
+  "/root/repo/src/libunicode/grapheme_cluster_cache.cpp" "src/libunicode/CMakeFiles/unicode.dir/grapheme_cluster_cache.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/grapheme_cluster_cache.cpp.o.d"
+  "/root/repo/src/libunicode/grapheme_search.cpp" "src/libunicode/CMakeFiles/unicode.dir/grapheme_search.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/grapheme_search.cpp.o.d"
+  "/root/repo/src/libunicode/grapheme_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/grapheme_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/grapheme_segmenter.cpp.o.d"
+  "/root/repo/src/libunicode/identifier.cpp" "src/libunicode/CMakeFiles/unicode.dir/identifier.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/identifier.cpp.o.d"
+  "/root/repo/src/libunicode/line_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/line_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/line_segmenter.cpp.o.d"
+  "/root/repo/src/libunicode/normalization.cpp" "src/libunicode/CMakeFiles/unicode.dir/normalization.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/normalization.cpp.o.d"
+  "/root/repo/src/libunicode/orientation_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/orientation_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/orientation_segmenter.cpp.o.d"
+  "/root/repo/src/libunicode/parallel_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/parallel_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/parallel_segmenter.cpp.o.d"
+  "/root/repo/src/libunicode/scan.cpp" "src/libunicode/CMakeFiles/unicode.dir/scan.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/scan.cpp.o.d"
+  "/root/repo/src/libunicode/script_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/script_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/script_segmenter.cpp.o.d"
+  "/root/repo/src/libunicode/utf8_run_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/utf8_run_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/utf8_run_segmenter.cpp.o.d"
+  "/root/repo/src/libunicode/width_policy.cpp" "src/libunicode/CMakeFiles/unicode.dir/width_policy.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/width_policy.cpp.o.d"
+  "/root/repo/src/libunicode/word_segmenter.cpp" "src/libunicode/CMakeFiles/unicode.dir/word_segmenter.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode.dir/word_segmenter.cpp.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_rel_build/src/libunicode/codepoint_properties.bin" "/root/repo/src/libunicode/codepoint_properties_data.cpp"
+  "/root/repo/_rel_build/src/libunicode/libunicode.so" "/root/repo/_rel_build/src/libunicode/libunicode.so.0.3.1"
+  "/root/repo/_rel_build/src/libunicode/libunicode.so.0.3" "/root/repo/_rel_build/src/libunicode/libunicode.so.0.3.1"
+  "/root/repo/src/libunicode/codepoint_properties_data.h" "/root/repo/src/libunicode/codepoint_properties_data.cpp"
+  "/root/repo/src/libunicode/codepoint_properties_names.cpp" "/root/repo/src/libunicode/codepoint_properties_data.cpp"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel_build/src/libunicode/CMakeFiles/unicode_ucd.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
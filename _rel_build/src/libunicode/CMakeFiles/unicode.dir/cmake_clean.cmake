@@ -0,0 +1,65 @@
+file(REMOVE_RECURSE
+  "/root/repo/src/libunicode/codepoint_properties_data.cpp"
+  "/root/repo/src/libunicode/codepoint_properties_data.h"
+  "/root/repo/src/libunicode/codepoint_properties_names.cpp"
+  "CMakeFiles/unicode.dir/bidi_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/bidi_segmenter.cpp.o.d"
+  "CMakeFiles/unicode.dir/capi.cpp.o"
+  "CMakeFiles/unicode.dir/capi.cpp.o.d"
+  "CMakeFiles/unicode.dir/case_mapping.cpp.o"
+  "CMakeFiles/unicode.dir/case_mapping.cpp.o.d"
+  "CMakeFiles/unicode.dir/codepoint_properties.cpp.o"
+  "CMakeFiles/unicode.dir/codepoint_properties.cpp.o.d"
+  "CMakeFiles/unicode.dir/codepoint_properties_data.cpp.o"
+  "CMakeFiles/unicode.dir/codepoint_properties_data.cpp.o.d"
+  "CMakeFiles/unicode.dir/codepoint_properties_file.cpp.o"
+  "CMakeFiles/unicode.dir/codepoint_properties_file.cpp.o.d"
+  "CMakeFiles/unicode.dir/codepoint_properties_names.cpp.o"
+  "CMakeFiles/unicode.dir/codepoint_properties_names.cpp.o.d"
+  "CMakeFiles/unicode.dir/column_slice.cpp.o"
+  "CMakeFiles/unicode.dir/column_slice.cpp.o.d"
+  "CMakeFiles/unicode.dir/convert.cpp.o"
+  "CMakeFiles/unicode.dir/convert.cpp.o.d"
+  "CMakeFiles/unicode.dir/document_segmentation.cpp.o"
+  "CMakeFiles/unicode.dir/document_segmentation.cpp.o.d"
+  "CMakeFiles/unicode.dir/emoji_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/emoji_segmenter.cpp.o.d"
+  "CMakeFiles/unicode.dir/fused_run_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/fused_run_segmenter.cpp.o.d"
+  "CMakeFiles/unicode.dir/grapheme_cluster_cache.cpp.o"
+  "CMakeFiles/unicode.dir/grapheme_cluster_cache.cpp.o.d"
+  "CMakeFiles/unicode.dir/grapheme_search.cpp.o"
+  "CMakeFiles/unicode.dir/grapheme_search.cpp.o.d"
+  "CMakeFiles/unicode.dir/grapheme_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/grapheme_segmenter.cpp.o.d"
+  "CMakeFiles/unicode.dir/identifier.cpp.o"
+  "CMakeFiles/unicode.dir/identifier.cpp.o.d"
+  "CMakeFiles/unicode.dir/line_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/line_segmenter.cpp.o.d"
+  "CMakeFiles/unicode.dir/normalization.cpp.o"
+  "CMakeFiles/unicode.dir/normalization.cpp.o.d"
+  "CMakeFiles/unicode.dir/orientation_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/orientation_segmenter.cpp.o.d"
+  "CMakeFiles/unicode.dir/parallel_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/parallel_segmenter.cpp.o.d"
+  "CMakeFiles/unicode.dir/scan.cpp.o"
+  "CMakeFiles/unicode.dir/scan.cpp.o.d"
+  "CMakeFiles/unicode.dir/script_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/script_segmenter.cpp.o.d"
+  "CMakeFiles/unicode.dir/utf8_run_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/utf8_run_segmenter.cpp.o.d"
+  "CMakeFiles/unicode.dir/width_policy.cpp.o"
+  "CMakeFiles/unicode.dir/width_policy.cpp.o.d"
+  "CMakeFiles/unicode.dir/word_segmenter.cpp.o"
+  "CMakeFiles/unicode.dir/word_segmenter.cpp.o.d"
+  "codepoint_properties.bin"
+  "libunicode.pdb"
+  "libunicode.so"
+  "libunicode.so.0.3"
+  "libunicode.so.0.3.1"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unicode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/libunicode/codepoint_properties_loader.cpp" "src/libunicode/CMakeFiles/unicode_loader.dir/codepoint_properties_loader.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_loader.dir/codepoint_properties_loader.cpp.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_rel_build/src/libunicode/libunicode_loader.so" "/root/repo/_rel_build/src/libunicode/libunicode_loader.so.0.3.1"
+  "/root/repo/_rel_build/src/libunicode/libunicode_loader.so.0.3" "/root/repo/_rel_build/src/libunicode/libunicode_loader.so.0.3.1"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel_build/src/libunicode/CMakeFiles/unicode_ucd.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unicode_loader.dir/codepoint_properties_loader.cpp.o"
+  "CMakeFiles/unicode_loader.dir/codepoint_properties_loader.cpp.o.d"
+  "libunicode_loader.pdb"
+  "libunicode_loader.so"
+  "libunicode_loader.so.0.3"
+  "libunicode_loader.so.0.3.1"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unicode_loader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
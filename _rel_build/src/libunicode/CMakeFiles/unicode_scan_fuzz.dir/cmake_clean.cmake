@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unicode_scan_fuzz.dir/scan_fuzz.cpp.o"
+  "CMakeFiles/unicode_scan_fuzz.dir/scan_fuzz.cpp.o.d"
+  "unicode_scan_fuzz"
+  "unicode_scan_fuzz.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unicode_scan_fuzz.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unicode_tablegen.dir/tablegen.cpp.o"
+  "CMakeFiles/unicode_tablegen.dir/tablegen.cpp.o.d"
+  "unicode_tablegen"
+  "unicode_tablegen.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unicode_tablegen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
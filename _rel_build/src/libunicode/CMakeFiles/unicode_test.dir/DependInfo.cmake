@@ -0,0 +1,50 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/libunicode/bidi_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/bidi_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/bidi_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/capi_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/capi_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/capi_test.cpp.o.d"
+  "/root/repo/src/libunicode/case_mapping_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/case_mapping_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/case_mapping_test.cpp.o.d"
+  "/root/repo/src/libunicode/codepoint_properties_file_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/codepoint_properties_file_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/codepoint_properties_file_test.cpp.o.d"
+  "/root/repo/src/libunicode/codepoint_properties_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/codepoint_properties_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/codepoint_properties_test.cpp.o.d"
+  "/root/repo/src/libunicode/column_slice_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/column_slice_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/column_slice_test.cpp.o.d"
+  "/root/repo/src/libunicode/convert_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/convert_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/convert_test.cpp.o.d"
+  "/root/repo/src/libunicode/document_segmentation_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/document_segmentation_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/document_segmentation_test.cpp.o.d"
+  "/root/repo/src/libunicode/emoji_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/emoji_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/emoji_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/emoji_sequence_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/emoji_sequence_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/emoji_sequence_test.cpp.o.d"
+  "/root/repo/src/libunicode/fused_run_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/fused_run_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/fused_run_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/grapheme_cluster_cache_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/grapheme_cluster_cache_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/grapheme_cluster_cache_test.cpp.o.d"
+  "/root/repo/src/libunicode/grapheme_search_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/grapheme_search_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/grapheme_search_test.cpp.o.d"
+  "/root/repo/src/libunicode/grapheme_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/grapheme_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/grapheme_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/identifier_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/identifier_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/identifier_test.cpp.o.d"
+  "/root/repo/src/libunicode/line_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/line_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/line_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/normalization_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/normalization_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/normalization_test.cpp.o.d"
+  "/root/repo/src/libunicode/orientation_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/orientation_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/orientation_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/parallel_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/parallel_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/parallel_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/run_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/run_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/run_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/scan_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/scan_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/scan_test.cpp.o.d"
+  "/root/repo/src/libunicode/script_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/script_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/script_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/statistics_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/statistics_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/statistics_test.cpp.o.d"
+  "/root/repo/src/libunicode/test_main.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/test_main.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/test_main.cpp.o.d"
+  "/root/repo/src/libunicode/unicode_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/unicode_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/unicode_test.cpp.o.d"
+  "/root/repo/src/libunicode/utf8_grapheme_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/utf8_grapheme_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/utf8_grapheme_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/utf8_run_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/utf8_run_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/utf8_run_segmenter_test.cpp.o.d"
+  "/root/repo/src/libunicode/utf8_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/utf8_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/utf8_test.cpp.o.d"
+  "/root/repo/src/libunicode/width_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/width_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/width_test.cpp.o.d"
+  "/root/repo/src/libunicode/word_segmenter_test.cpp" "src/libunicode/CMakeFiles/unicode_test.dir/word_segmenter_test.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_test.dir/word_segmenter_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel_build/src/libunicode/CMakeFiles/unicode.dir/DependInfo.cmake"
+  "/root/repo/_rel_build/src/libunicode/CMakeFiles/unicode_ucd.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,69 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unicode_test.dir/bidi_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/bidi_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/capi_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/capi_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/case_mapping_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/case_mapping_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/codepoint_properties_file_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/codepoint_properties_file_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/codepoint_properties_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/codepoint_properties_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/column_slice_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/column_slice_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/convert_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/convert_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/document_segmentation_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/document_segmentation_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/emoji_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/emoji_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/emoji_sequence_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/emoji_sequence_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/fused_run_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/fused_run_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/grapheme_cluster_cache_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/grapheme_cluster_cache_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/grapheme_search_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/grapheme_search_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/grapheme_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/grapheme_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/identifier_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/identifier_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/line_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/line_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/normalization_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/normalization_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/orientation_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/orientation_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/parallel_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/parallel_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/run_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/run_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/scan_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/scan_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/script_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/script_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/statistics_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/statistics_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/test_main.cpp.o"
+  "CMakeFiles/unicode_test.dir/test_main.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/unicode_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/unicode_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/utf8_grapheme_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/utf8_grapheme_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/utf8_run_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/utf8_run_segmenter_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/utf8_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/utf8_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/width_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/width_test.cpp.o.d"
+  "CMakeFiles/unicode_test.dir/word_segmenter_test.cpp.o"
+  "CMakeFiles/unicode_test.dir/word_segmenter_test.cpp.o.d"
+  "unicode_test"
+  "unicode_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unicode_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/libunicode/ucd.cpp" "src/libunicode/CMakeFiles/unicode_ucd.dir/ucd.cpp.o" "gcc" "src/libunicode/CMakeFiles/unicode_ucd.dir/ucd.cpp.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_rel_build/src/libunicode/libunicode_ucd.so" "/root/repo/_rel_build/src/libunicode/libunicode_ucd.so.0.3.1"
+  "/root/repo/_rel_build/src/libunicode/libunicode_ucd.so.0.3" "/root/repo/_rel_build/src/libunicode/libunicode_ucd.so.0.3.1"
+  "/root/repo/src/libunicode/ucd.h" "/root/repo/src/libunicode/ucd.cpp"
+  "/root/repo/src/libunicode/ucd_enums.h" "/root/repo/src/libunicode/ucd.cpp"
+  "/root/repo/src/libunicode/ucd_fmt.h" "/root/repo/src/libunicode/ucd.cpp"
+  "/root/repo/src/libunicode/ucd_ostream.h" "/root/repo/src/libunicode/ucd.cpp"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,18 @@
+file(REMOVE_RECURSE
+  "/root/repo/src/libunicode/ucd.cpp"
+  "/root/repo/src/libunicode/ucd.h"
+  "/root/repo/src/libunicode/ucd_enums.h"
+  "/root/repo/src/libunicode/ucd_fmt.h"
+  "/root/repo/src/libunicode/ucd_ostream.h"
+  "CMakeFiles/unicode_ucd.dir/ucd.cpp.o"
+  "CMakeFiles/unicode_ucd.dir/ucd.cpp.o.d"
+  "libunicode_ucd.pdb"
+  "libunicode_ucd.so"
+  "libunicode_ucd.so.0.3"
+  "libunicode_ucd.so.0.3.1"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unicode_ucd.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/libunicode
+# Build directory: /root/repo/_rel_build/src/libunicode
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(unicode_test "unicode_test")
+set_tests_properties(unicode_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/libunicode/CMakeLists.txt;321;add_test;/root/repo/src/libunicode/CMakeLists.txt;0;")
+add_test(unicode_scan_fuzz "unicode_scan_fuzz" "--runs" "20000")
+set_tests_properties(unicode_scan_fuzz PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/libunicode/CMakeLists.txt;326;add_test;/root/repo/src/libunicode/CMakeLists.txt;0;")
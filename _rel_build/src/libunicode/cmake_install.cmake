@@ -0,0 +1,298 @@
+# Install script for directory: /root/repo/src/libunicode
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so.0.3.1"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so.0.3"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHECK
+           FILE "${file}"
+           RPATH "")
+    endif()
+  endforeach()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES
+    "/root/repo/_rel_build/src/libunicode/libunicode_ucd.so.0.3.1"
+    "/root/repo/_rel_build/src/libunicode/libunicode_ucd.so.0.3"
+    )
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so.0.3.1"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so.0.3"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      if(CMAKE_INSTALL_DO_STRIP)
+        execute_process(COMMAND "/usr/bin/strip" "${file}")
+      endif()
+    endif()
+  endforeach()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so"
+         RPATH "")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES "/root/repo/_rel_build/src/libunicode/libunicode_ucd.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_ucd.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so.0.3.1"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so.0.3"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHECK
+           FILE "${file}"
+           RPATH "")
+    endif()
+  endforeach()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES
+    "/root/repo/_rel_build/src/libunicode/libunicode_loader.so.0.3.1"
+    "/root/repo/_rel_build/src/libunicode/libunicode_loader.so.0.3"
+    )
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so.0.3.1"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so.0.3"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHANGE
+           FILE "${file}"
+           OLD_RPATH "/root/repo/_rel_build/src/libunicode:"
+           NEW_RPATH "")
+      if(CMAKE_INSTALL_DO_STRIP)
+        execute_process(COMMAND "/usr/bin/strip" "${file}")
+      endif()
+    endif()
+  endforeach()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so"
+         RPATH "")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES "/root/repo/_rel_build/src/libunicode/libunicode_loader.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so"
+         OLD_RPATH "/root/repo/_rel_build/src/libunicode:"
+         NEW_RPATH "")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode_loader.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so.0.3.1"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so.0.3"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHECK
+           FILE "${file}"
+           RPATH "")
+    endif()
+  endforeach()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES
+    "/root/repo/_rel_build/src/libunicode/libunicode.so.0.3.1"
+    "/root/repo/_rel_build/src/libunicode/libunicode.so.0.3"
+    )
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so.0.3.1"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so.0.3"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHANGE
+           FILE "${file}"
+           OLD_RPATH "/root/repo/_rel_build/src/libunicode:"
+           NEW_RPATH "")
+      if(CMAKE_INSTALL_DO_STRIP)
+        execute_process(COMMAND "/usr/bin/strip" "${file}")
+      endif()
+    endif()
+  endforeach()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so"
+         RPATH "")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES "/root/repo/_rel_build/src/libunicode/libunicode.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so"
+         OLD_RPATH "/root/repo/_rel_build/src/libunicode:"
+         NEW_RPATH "")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libunicode.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  list(APPEND CMAKE_ABSOLUTE_DESTINATION_FILES
+   "/usr/local/include/libunicode/multistage_table_generator.h;/usr/local/include/libunicode/scoped_timer.h")
+  if(CMAKE_WARN_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(WARNING "ABSOLUTE path INSTALL DESTINATION : ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  if(CMAKE_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(FATAL_ERROR "ABSOLUTE path INSTALL DESTINATION forbidden (by caller): ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  file(INSTALL DESTINATION "/usr/local/include/libunicode" TYPE FILE FILES
+    "/root/repo/src/libunicode/multistage_table_generator.h"
+    "/root/repo/src/libunicode/scoped_timer.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  list(APPEND CMAKE_ABSOLUTE_DESTINATION_FILES
+   "/usr/local/include/libunicode/bidi_segmenter.h;/usr/local/include/libunicode/capi.h;/usr/local/include/libunicode/case_mapping.h;/usr/local/include/libunicode/codepoint_properties.h;/usr/local/include/libunicode/codepoint_properties_file.h;/usr/local/include/libunicode/column_slice.h;/usr/local/include/libunicode/convert.h;/usr/local/include/libunicode/document_segmentation.h;/usr/local/include/libunicode/emoji_segmenter.h;/usr/local/include/libunicode/emoji_sequence.h;/usr/local/include/libunicode/fused_run_segmenter.h;/usr/local/include/libunicode/grapheme_cluster_cache.h;/usr/local/include/libunicode/grapheme_search.h;/usr/local/include/libunicode/grapheme_segmenter.h;/usr/local/include/libunicode/identifier.h;/usr/local/include/libunicode/intrinsics.h;/usr/local/include/libunicode/line_segmenter.h;/usr/local/include/libunicode/multistage_table_view.h;/usr/local/include/libunicode/normalization.h;/usr/local/include/libunicode/orientation_segmenter.h;/usr/local/include/libunicode/parallel_segmenter.h;/usr/local/include/libunicode/run_segmenter.h;/usr/local/include/libunicode/scan.h;/usr/local/include/libunicode/script_segmenter.h;/usr/local/include/libunicode/statistics.h;/usr/local/include/libunicode/support.h;/usr/local/include/libunicode/utf8.h;/usr/local/include/libunicode/utf8_grapheme_segmenter.h;/usr/local/include/libunicode/utf8_run_segmenter.h;/usr/local/include/libunicode/width.h;/usr/local/include/libunicode/width_policy.h;/usr/local/include/libunicode/word_segmenter.h")
+  if(CMAKE_WARN_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(WARNING "ABSOLUTE path INSTALL DESTINATION : ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  if(CMAKE_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(FATAL_ERROR "ABSOLUTE path INSTALL DESTINATION forbidden (by caller): ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  file(INSTALL DESTINATION "/usr/local/include/libunicode" TYPE FILE FILES
+    "/root/repo/src/libunicode/bidi_segmenter.h"
+    "/root/repo/src/libunicode/capi.h"
+    "/root/repo/src/libunicode/case_mapping.h"
+    "/root/repo/src/libunicode/codepoint_properties.h"
+    "/root/repo/src/libunicode/codepoint_properties_file.h"
+    "/root/repo/src/libunicode/column_slice.h"
+    "/root/repo/src/libunicode/convert.h"
+    "/root/repo/src/libunicode/document_segmentation.h"
+    "/root/repo/src/libunicode/emoji_segmenter.h"
+    "/root/repo/src/libunicode/emoji_sequence.h"
+    "/root/repo/src/libunicode/fused_run_segmenter.h"
+    "/root/repo/src/libunicode/grapheme_cluster_cache.h"
+    "/root/repo/src/libunicode/grapheme_search.h"
+    "/root/repo/src/libunicode/grapheme_segmenter.h"
+    "/root/repo/src/libunicode/identifier.h"
+    "/root/repo/src/libunicode/intrinsics.h"
+    "/root/repo/src/libunicode/line_segmenter.h"
+    "/root/repo/src/libunicode/multistage_table_view.h"
+    "/root/repo/src/libunicode/normalization.h"
+    "/root/repo/src/libunicode/orientation_segmenter.h"
+    "/root/repo/src/libunicode/parallel_segmenter.h"
+    "/root/repo/src/libunicode/run_segmenter.h"
+    "/root/repo/src/libunicode/scan.h"
+    "/root/repo/src/libunicode/script_segmenter.h"
+    "/root/repo/src/libunicode/statistics.h"
+    "/root/repo/src/libunicode/support.h"
+    "/root/repo/src/libunicode/utf8.h"
+    "/root/repo/src/libunicode/utf8_grapheme_segmenter.h"
+    "/root/repo/src/libunicode/utf8_run_segmenter.h"
+    "/root/repo/src/libunicode/width.h"
+    "/root/repo/src/libunicode/width_policy.h"
+    "/root/repo/src/libunicode/word_segmenter.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/libunicode" TYPE FILE FILES
+    "/root/repo/src/libunicode/ucd.h"
+    "/root/repo/src/libunicode/ucd_enums.h"
+    "/root/repo/src/libunicode/ucd_fmt.h"
+    "/root/repo/src/libunicode/ucd_ostream.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/share/libunicode" TYPE FILE FILES "/root/repo/_rel_build/src/libunicode/codepoint_properties.bin")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/cmake/libunicode" TYPE FILE FILES
+    "/root/repo/_rel_build/src/libunicode/libunicode-config.cmake"
+    "/root/repo/_rel_build/src/libunicode/libunicode-config-version.cmake"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/cmake/libunicode/unicode-targets.cmake")
+    file(DIFFERENT _cmake_export_file_changed FILES
+         "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/cmake/libunicode/unicode-targets.cmake"
+         "/root/repo/_rel_build/src/libunicode/CMakeFiles/Export/fe8f78af23142e0b3a3ee297cdfd96d7/unicode-targets.cmake")
+    if(_cmake_export_file_changed)
+      file(GLOB _cmake_old_config_files "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/cmake/libunicode/unicode-targets-*.cmake")
+      if(_cmake_old_config_files)
+        string(REPLACE ";" ", " _cmake_old_config_files_text "${_cmake_old_config_files}")
+        message(STATUS "Old export file \"$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/cmake/libunicode/unicode-targets.cmake\" will be replaced.  Removing files [${_cmake_old_config_files_text}].")
+        unset(_cmake_old_config_files_text)
+        file(REMOVE ${_cmake_old_config_files})
+      endif()
+      unset(_cmake_old_config_files)
+    endif()
+    unset(_cmake_export_file_changed)
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/cmake/libunicode" TYPE FILE FILES "/root/repo/_rel_build/src/libunicode/CMakeFiles/Export/fe8f78af23142e0b3a3ee297cdfd96d7/unicode-targets.cmake")
+  if(CMAKE_INSTALL_CONFIG_NAME MATCHES "^([Rr][Ee][Ll][Ee][Aa][Ss][Ee])$")
+    file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/cmake/libunicode" TYPE FILE FILES "/root/repo/_rel_build/src/libunicode/CMakeFiles/Export/fe8f78af23142e0b3a3ee297cdfd96d7/unicode-targets-release.cmake")
+  endif()
+endif()
+
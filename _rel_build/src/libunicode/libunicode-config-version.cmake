@@ -0,0 +1,7 @@
+set(PACKAGE_VERSION "0.3.1")
+if(NOT "${PACKAGE_FIND_VERSION}" VERSION_GREATER "0.3.1")
+    set(PACKAGE_VERSION_COMPATIBLE 1) # compatible with older
+    if("${PACKAGE_FIND_VERSION}" VERSION_EQUAL "0.3.1")
+        set(PACKAGE_VERSION_EXACT 1) # exact match for this version
+    endif()
+endif()
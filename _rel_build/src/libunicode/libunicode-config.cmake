@@ -0,0 +1,14 @@
+# Compute installation prefix relative to this file.
+get_filename_component(_dir "${CMAKE_CURRENT_LIST_FILE}" PATH)
+get_filename_component(_prefix "${_dir}/../../.." ABSOLUTE)
+
+# Dependencies of the imported targets.
+include(CMakeFindDependencyMacro)
+find_dependency(Threads)
+
+# Import the targets.
+include("${_dir}/unicode-targets.cmake")
+
+# Report other information.
+set(libunicode_INCLUDE_DIRS "${_prefix}/include")
+set(libunicode_FOUND TRUE)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/uc-inspect.dir/uc-inspect.cpp.o"
+  "CMakeFiles/uc-inspect.dir/uc-inspect.cpp.o.d"
+  "uc-inspect"
+  "uc-inspect.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/uc-inspect.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
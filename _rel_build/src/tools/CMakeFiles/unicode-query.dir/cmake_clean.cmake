@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unicode-query.dir/unicode-query.cpp.o"
+  "CMakeFiles/unicode-query.dir/unicode-query.cpp.o.d"
+  "unicode-query"
+  "unicode-query.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unicode-query.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -49,11 +49,23 @@ else()
     set(THIRDPARTY_BUILTIN_fmt "system package")
 endif()
 
+if(LIBUNICODE_BENCHMARK)
+    if(TARGET benchmark::benchmark)
+        set(THIRDPARTY_BUILTIN_benchmark "embedded")
+    else()
+        find_package(benchmark REQUIRED)
+        set(THIRDPARTY_BUILTIN_benchmark "system package")
+    endif()
+endif()
+
 macro(ThirdPartiesSummary2)
     message(STATUS "==============================================================================")
     message(STATUS "    ThirdParties")
     message(STATUS "------------------------------------------------------------------------------")
     message(STATUS "Catch2              ${THIRDPARTY_BUILTIN_Catch2}")
     message(STATUS "fmt                 ${THIRDPARTY_BUILTIN_fmt}")
+    if(LIBUNICODE_BENCHMARK)
+        message(STATUS "benchmark           ${THIRDPARTY_BUILTIN_benchmark}")
+    endif()
     message(STATUS "------------------------------------------------------------------------------")
 endmacro()
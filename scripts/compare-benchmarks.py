@@ -0,0 +1,62 @@
+#! /usr/bin/env python3
+"""Compares two JSON reports of unicode_bench, as written with --benchmark_out.
+
+    unicode_bench --benchmark_out=current.json --benchmark_out_format=json
+    scripts/compare-benchmarks.py benchmarks/baseline.json current.json
+
+Reports of repeated runs (--benchmark_repetitions) are compared by their medians.
+Prints the change of the throughput of each benchmark found in both reports,
+and exits with a non-zero status if any of them regressed by more than the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """Returns the runs of each benchmark by name, preferring the median of repeated runs."""
+    with open(path, encoding='utf-8') as file:
+        report = json.load(file)
+    runs = {}
+    for run in report['benchmarks']:
+        if run.get('run_type', 'iteration') == 'iteration':
+            runs.setdefault(run['run_name'], run)
+    for run in report['benchmarks']:
+        if run.get('aggregate_name') == 'median':
+            runs[run['run_name']] = run
+    return runs
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='maximum tolerated slowdown, in percent [default: 5]')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    regressions = 0
+    print(f"{'Benchmark':<44} {'Baseline':>12} {'Current':>12} {'Change':>8}")
+    for name, run in current.items():
+        if name not in baseline or 'bytes_per_second' not in run:
+            continue
+        old = baseline[name]['bytes_per_second']
+        new = run['bytes_per_second']
+        change = (new - old) / old * 100.0
+        marker = ''
+        if change < -args.threshold:
+            regressions += 1
+            marker = ' <--'
+        print(f"{name:<44} {old / 2**20:>8.1f}MB/s {new / 2**20:>8.1f}MB/s {change:>+7.1f}%{marker}")
+
+    if regressions:
+        print(f'{regressions} benchmark(s) regressed by more than {args.threshold}%.')
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,698 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/bidi_segmenter.h>
+#include <libunicode/ucd.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace unicode
+{
+
+namespace
+{
+    using BC = Bidi_Class;
+
+    constexpr auto npos = std::numeric_limits<size_t>::max();
+
+    // Maximum explicit embedding level (BD2), and maximum depth of the bracket stack (BD16).
+    constexpr uint8_t MaxDepth = 125;      // NOLINT(readability-identifier-naming)
+    constexpr size_t MaxBracketDepth = 63; // NOLINT(readability-identifier-naming)
+
+    constexpr bool is_isolate_initiator(BC c) noexcept
+    {
+        return c == BC::Left_To_Right_Isolate || c == BC::Right_To_Left_Isolate
+               || c == BC::First_Strong_Isolate;
+    }
+
+    constexpr bool is_isolate_control(BC c) noexcept
+    {
+        return is_isolate_initiator(c) || c == BC::Pop_Directional_Isolate;
+    }
+
+    /// Tests whether a character of the given initial class is removed by rule X9.
+    constexpr bool is_removed(BC c) noexcept
+    {
+        switch (c)
+        {
+            case BC::Right_To_Left_Embedding:
+            case BC::Left_To_Right_Embedding:
+            case BC::Right_To_Left_Override:
+            case BC::Left_To_Right_Override:
+            case BC::Pop_Directional_Format:
+            case BC::Boundary_Neutral: return true;
+            default: return false;
+        }
+    }
+
+    /// Tests whether the class is a neutral or isolate formatting character (NI) for rules N1 and N2.
+    constexpr bool is_neutral_or_isolate(BC c) noexcept
+    {
+        switch (c)
+        {
+            case BC::Paragraph_Separator:
+            case BC::Segment_Separator:
+            case BC::White_Space:
+            case BC::Other_Neutral:
+            case BC::Boundary_Neutral: return true;
+            default: return is_isolate_control(c);
+        }
+    }
+
+    /// Returns the strong direction (L or R) of a resolved class for rules N0 to N2, where numbers count
+    /// as R, or Other_Neutral for any other class.
+    constexpr BC strong_direction(BC c) noexcept
+    {
+        switch (c)
+        {
+            case BC::Left_To_Right: return BC::Left_To_Right;
+            case BC::Right_To_Left:
+            case BC::European_Number:
+            case BC::Arabic_Number: return BC::Right_To_Left;
+            default: return BC::Other_Neutral;
+        }
+    }
+
+    constexpr BC direction_of(uint8_t level) noexcept
+    {
+        return (level & 1) != 0 ? BC::Right_To_Left : BC::Left_To_Right;
+    }
+
+    constexpr uint8_t next_odd_level(uint8_t level) noexcept
+    {
+        return static_cast<uint8_t>((level + 1) | 1);
+    }
+
+    constexpr uint8_t next_even_level(uint8_t level) noexcept
+    {
+        return static_cast<uint8_t>((level + 2) & ~1);
+    }
+
+    /// Maps brackets to their canonical equivalent, for matching them in rule BD16.
+    constexpr char32_t canonical_bracket(char32_t codepoint) noexcept
+    {
+        switch (codepoint)
+        {
+            case 0x2329: return 0x3008; // LEFT-POINTING ANGLE BRACKET
+            case 0x232A: return 0x3009; // RIGHT-POINTING ANGLE BRACKET
+            default: return codepoint;
+        }
+    }
+} // namespace
+
+namespace detail
+{
+    struct bidi_resolver
+    {
+        bidi_arena& arena;
+        std::u32string_view text;
+
+        void resolve(std::optional<uint8_t> paragraphLevel)
+        {
+            auto const size = text.size();
+            arena.initialClasses_.resize(size);
+            arena.classes_.resize(size);
+            arena.levels_.resize(size);
+            arena.matchingPDI_.resize(size);
+            arena.matchingInitiator_.resize(size);
+            arena.runStartingAt_.resize(size);
+
+            for (size_t i = 0; i < size; ++i)
+                arena.initialClasses_[i] = arena.classes_[i] = bidi_class(text[i]);
+
+            // P1: Split the text into paragraphs, keeping the paragraph separator with each.
+            for (size_t start = 0; start < size;)
+            {
+                auto end = start;
+                while (end < size && arena.initialClasses_[end++] != BC::Paragraph_Separator)
+                    ;
+                resolveParagraph(start, end, paragraphLevel);
+                start = end;
+            }
+        }
+
+        [[nodiscard]] BC initialClass(size_t i) const noexcept { return arena.initialClasses_[i]; }
+        [[nodiscard]] BC& classOf(size_t i) const noexcept { return arena.classes_[i]; }
+        [[nodiscard]] uint8_t& levelOf(size_t i) const noexcept { return arena.levels_[i]; }
+
+        /// BD9: Matches the isolate initiators of a paragraph with their PDIs.
+        void matchIsolates(size_t start, size_t end)
+        {
+            arena.isolates_.clear();
+            for (auto i = start; i < end; ++i)
+            {
+                arena.matchingPDI_[i] = npos;
+                arena.matchingInitiator_[i] = npos;
+                if (is_isolate_initiator(initialClass(i)))
+                    arena.isolates_.push_back(i);
+                else if (initialClass(i) == BC::Pop_Directional_Isolate && !arena.isolates_.empty())
+                {
+                    arena.matchingPDI_[arena.isolates_.back()] = i;
+                    arena.matchingInitiator_[i] = arena.isolates_.back();
+                    arena.isolates_.pop_back();
+                }
+            }
+        }
+
+        /// P2, P3: Determines the embedding level of the first strong character in [start, end),
+        /// skipping isolates.
+        [[nodiscard]] std::optional<uint8_t> firstStrongLevel(size_t start, size_t end) const noexcept
+        {
+            for (auto i = start; i < end; ++i)
+            {
+                switch (initialClass(i))
+                {
+                    case BC::Left_To_Right: return 0;
+                    case BC::Right_To_Left:
+                    case BC::Arabic_Letter: return 1;
+                    default:
+                        if (is_isolate_initiator(initialClass(i)))
+                        {
+                            if (arena.matchingPDI_[i] == npos)
+                                return std::nullopt;
+                            i = arena.matchingPDI_[i];
+                        }
+                        break;
+                }
+            }
+            return std::nullopt;
+        }
+
+        void resolveParagraph(size_t start, size_t end, std::optional<uint8_t> givenLevel)
+        {
+            matchIsolates(start, end);
+            auto const paragraphLevel = givenLevel.value_or(firstStrongLevel(start, end).value_or(0));
+
+            resolveExplicitLevels(start, end, paragraphLevel);
+            resolveLevelRuns(start, end);
+
+            // X10: Resolve each isolating run sequence on its own, starting at a level run that does not
+            // continue an isolate.
+            for (auto const& run: arena.runs_)
+            {
+                auto const first = arena.chars_[run.first];
+                if (initialClass(first) == BC::Pop_Directional_Isolate
+                    && arena.matchingInitiator_[first] != npos)
+                    continue;
+                collectSequence(run);
+                resolveSequence(start, end, paragraphLevel);
+            }
+            resolveImplicitLevels();
+
+            // X9 removed characters get the level of the character before them.
+            for (auto i = start; i < end; ++i)
+                if (is_removed(initialClass(i)))
+                    levelOf(i) = i == start ? paragraphLevel : levelOf(i - 1);
+
+            resetWhitespaceLevels(start, end, paragraphLevel);
+        }
+
+        /// X1 to X8: Determines the explicit embedding levels and directional overrides.
+        void resolveExplicitLevels(size_t start, size_t end, uint8_t paragraphLevel)
+        {
+            auto& stack = arena.stack_;
+            stack.clear();
+            stack.push_back({ paragraphLevel, BC::Other_Neutral, false });
+
+            auto overflowIsolates = size_t { 0 };
+            auto overflowEmbeddings = size_t { 0 };
+            auto validIsolates = size_t { 0 };
+
+            auto const applyOverride = [&](size_t i) {
+                levelOf(i) = stack.back().level;
+                if (stack.back().override != BC::Other_Neutral)
+                    classOf(i) = stack.back().override;
+            };
+
+            for (auto i = start; i < end; ++i)
+            {
+                switch (auto const c = initialClass(i); c)
+                {
+                    case BC::Right_To_Left_Embedding:
+                    case BC::Left_To_Right_Embedding:
+                    case BC::Right_To_Left_Override:
+                    case BC::Left_To_Right_Override: {
+                        // X2 to X5
+                        levelOf(i) = stack.back().level;
+                        auto const rtl = c == BC::Right_To_Left_Embedding || c == BC::Right_To_Left_Override;
+                        auto const level = rtl ? next_odd_level(stack.back().level)
+                                               : next_even_level(stack.back().level);
+                        if (level <= MaxDepth && overflowIsolates == 0 && overflowEmbeddings == 0)
+                        {
+                            auto const override = c == BC::Right_To_Left_Override   ? BC::Right_To_Left
+                                                  : c == BC::Left_To_Right_Override ? BC::Left_To_Right
+                                                                                    : BC::Other_Neutral;
+                            stack.push_back({ level, override, false });
+                        }
+                        else if (overflowIsolates == 0)
+                            ++overflowEmbeddings;
+                        break;
+                    }
+                    case BC::Right_To_Left_Isolate:
+                    case BC::Left_To_Right_Isolate:
+                    case BC::First_Strong_Isolate: {
+                        // X5a to X5c
+                        applyOverride(i);
+                        auto const isolateEnd = arena.matchingPDI_[i] == npos ? end : arena.matchingPDI_[i];
+                        auto const rtl = c == BC::Right_To_Left_Isolate
+                                         || (c == BC::First_Strong_Isolate
+                                             && firstStrongLevel(i + 1, isolateEnd).value_or(0) == 1);
+                        auto const level = rtl ? next_odd_level(stack.back().level)
+                                               : next_even_level(stack.back().level);
+                        if (level <= MaxDepth && overflowIsolates == 0 && overflowEmbeddings == 0)
+                        {
+                            ++validIsolates;
+                            stack.push_back({ level, BC::Other_Neutral, true });
+                        }
+                        else
+                            ++overflowIsolates;
+                        break;
+                    }
+                    case BC::Pop_Directional_Isolate:
+                        // X6a
+                        if (overflowIsolates > 0)
+                            --overflowIsolates;
+                        else if (validIsolates > 0)
+                        {
+                            overflowEmbeddings = 0;
+                            while (!stack.back().isolate)
+                                stack.pop_back();
+                            stack.pop_back();
+                            --validIsolates;
+                        }
+                        applyOverride(i);
+                        break;
+                    case BC::Pop_Directional_Format:
+                        // X7
+                        if (overflowIsolates > 0)
+                            ;
+                        else if (overflowEmbeddings > 0)
+                            --overflowEmbeddings;
+                        else if (!stack.back().isolate && stack.size() >= 2)
+                            stack.pop_back();
+                        levelOf(i) = stack.back().level;
+                        break;
+                    case BC::Paragraph_Separator:
+                        // X8
+                        levelOf(i) = paragraphLevel;
+                        break;
+                    case BC::Boundary_Neutral: levelOf(i) = stack.back().level; break;
+                    default:
+                        // X6
+                        applyOverride(i);
+                        break;
+                }
+            }
+        }
+
+        /// X9, X10: Collects the codepoints not removed by X9, and the level runs they form.
+        void resolveLevelRuns(size_t start, size_t end)
+        {
+            arena.chars_.clear();
+            arena.runs_.clear();
+            for (auto i = start; i < end; ++i)
+            {
+                arena.runStartingAt_[i] = npos;
+                if (is_removed(initialClass(i)))
+                    continue;
+                if (arena.chars_.empty() || levelOf(arena.chars_.back()) != levelOf(i))
+                {
+                    if (!arena.runs_.empty())
+                        arena.runs_.back().last = arena.chars_.size();
+                    arena.runStartingAt_[i] = arena.runs_.size();
+                    arena.runs_.push_back({ arena.chars_.size(), arena.chars_.size() });
+                }
+                arena.chars_.push_back(i);
+            }
+            if (!arena.runs_.empty())
+                arena.runs_.back().last = arena.chars_.size();
+        }
+
+        /// BD13: Collects the isolating run sequence starting with @p run, following isolate initiators
+        /// to the level runs starting with their matching PDIs.
+        void collectSequence(bidi_arena::level_run run)
+        {
+            arena.sequence_.clear();
+            for (;;)
+            {
+                for (auto k = run.first; k < run.last; ++k)
+                    arena.sequence_.push_back(arena.chars_[k]);
+                auto const last = arena.sequence_.back();
+                if (!is_isolate_initiator(initialClass(last)) || arena.matchingPDI_[last] == npos)
+                    break;
+                auto const next = arena.runStartingAt_[arena.matchingPDI_[last]];
+                if (next == npos)
+                    break;
+                run = arena.runs_[next];
+            }
+        }
+
+        [[nodiscard]] BC sequenceClass(size_t k) const noexcept { return classOf(arena.sequence_[k]); }
+
+        void resolveSequence(size_t start, size_t end, uint8_t paragraphLevel)
+        {
+            auto const& sequence = arena.sequence_;
+            auto const level = levelOf(sequence.front());
+
+            // X10: sos and eos, from the higher of the sequence's level and the level of the character
+            // adjacent to it, or the paragraph level.
+            auto before = paragraphLevel;
+            for (auto i = sequence.front(); i > start; --i)
+                if (!is_removed(initialClass(i - 1)))
+                {
+                    before = levelOf(i - 1);
+                    break;
+                }
+            auto after = paragraphLevel;
+            if (!is_isolate_initiator(initialClass(sequence.back())))
+                for (auto i = sequence.back() + 1; i < end; ++i)
+                    if (!is_removed(initialClass(i)))
+                    {
+                        after = levelOf(i);
+                        break;
+                    }
+            auto const sos = direction_of(std::max(level, before));
+            auto const eos = direction_of(std::max(level, after));
+
+            resolveWeakTypes(sos);
+            resolveBracketPairs(sos, direction_of(level));
+            resolveNeutralTypes(sos, eos, direction_of(level));
+        }
+
+        /// I1, I2: Resolves the implicit levels, once all isolating run sequences have been resolved,
+        /// as their explicit levels determine each other's sos and eos.
+        void resolveImplicitLevels()
+        {
+            for (auto const i: arena.chars_)
+            {
+                auto const c = classOf(i);
+                if ((levelOf(i) & 1) == 0)
+                {
+                    if (c == BC::Right_To_Left)
+                        levelOf(i) += 1;
+                    else if (c == BC::Arabic_Number || c == BC::European_Number)
+                        levelOf(i) += 2;
+                }
+                else if (c == BC::Left_To_Right || c == BC::Arabic_Number || c == BC::European_Number)
+                    levelOf(i) += 1;
+            }
+        }
+
+        /// W1 to W7
+        void resolveWeakTypes(BC sos)
+        {
+            auto const& sequence = arena.sequence_;
+            auto const count = sequence.size();
+
+            // W1
+            auto previous = sos;
+            for (auto const i: sequence)
+            {
+                if (classOf(i) == BC::Nonspacing_Mark)
+                    classOf(i) = previous;
+                else
+                    previous = is_isolate_control(classOf(i)) ? BC::Other_Neutral : classOf(i);
+            }
+
+            // W2, W3
+            auto lastStrong = sos;
+            for (auto const i: sequence)
+            {
+                auto& c = classOf(i);
+                if (c == BC::Left_To_Right || c == BC::Right_To_Left || c == BC::Arabic_Letter)
+                    lastStrong = c;
+                else if (c == BC::European_Number && lastStrong == BC::Arabic_Letter)
+                    c = BC::Arabic_Number;
+            }
+            for (auto const i: sequence)
+                if (classOf(i) == BC::Arabic_Letter)
+                    classOf(i) = BC::Right_To_Left;
+
+            // W4
+            for (size_t k = 1; k + 1 < count; ++k)
+            {
+                auto& c = classOf(sequence[k]);
+                auto const left = sequenceClass(k - 1);
+                auto const right = sequenceClass(k + 1);
+                if (c == BC::European_Separator && left == BC::European_Number
+                    && right == BC::European_Number)
+                    c = BC::European_Number;
+                else if (c == BC::Common_Separator && left == right
+                         && (left == BC::European_Number || left == BC::Arabic_Number))
+                    c = left;
+            }
+
+            // W5
+            for (size_t k = 0; k < count;)
+            {
+                if (sequenceClass(k) != BC::European_Terminator)
+                {
+                    ++k;
+                    continue;
+                }
+                auto const first = k;
+                while (k < count && sequenceClass(k) == BC::European_Terminator)
+                    ++k;
+                if ((first > 0 && sequenceClass(first - 1) == BC::European_Number)
+                    || (k < count && sequenceClass(k) == BC::European_Number))
+                    for (auto j = first; j < k; ++j)
+                        classOf(sequence[j]) = BC::European_Number;
+            }
+
+            // W6
+            for (auto const i: sequence)
+            {
+                auto& c = classOf(i);
+                if (c == BC::European_Separator || c == BC::European_Terminator || c == BC::Common_Separator)
+                    c = BC::Other_Neutral;
+            }
+
+            // W7
+            lastStrong = sos;
+            for (auto const i: sequence)
+            {
+                auto& c = classOf(i);
+                if (c == BC::Left_To_Right || c == BC::Right_To_Left)
+                    lastStrong = c;
+                else if (c == BC::European_Number && lastStrong == BC::Left_To_Right)
+                    c = BC::Left_To_Right;
+            }
+        }
+
+        /// BD16: Locates the bracket pairs of the isolating run sequence, sorted by their opening brackets.
+        void locateBracketPairs()
+        {
+            auto const& sequence = arena.sequence_;
+            arena.openers_.clear();
+            arena.pairs_.clear();
+            // Processing stops at an opening bracket exceeding the maximum depth.
+            auto overflow = false;
+            for (size_t k = 0; k < sequence.size() && !overflow; ++k)
+            {
+                if (sequenceClass(k) != BC::Other_Neutral)
+                    continue;
+                auto const codepoint = text[sequence[k]];
+                switch (bidi_paired_bracket_type(codepoint))
+                {
+                    case Bidi_Paired_Bracket_Type::Open:
+                        overflow = arena.openers_.size() == MaxBracketDepth;
+                        if (!overflow)
+                            arena.openers_.push_back(
+                                { canonical_bracket(bidi_paired_bracket(codepoint)), k });
+                        break;
+                    case Bidi_Paired_Bracket_Type::Close:
+                        for (auto j = arena.openers_.size(); j > 0; --j)
+                        {
+                            if (arena.openers_[j - 1].codepoint != canonical_bracket(codepoint))
+                                continue;
+                            arena.pairs_.push_back({ arena.openers_[j - 1].position, k });
+                            arena.openers_.resize(j - 1);
+                            break;
+                        }
+                        break;
+                    case Bidi_Paired_Bracket_Type::None: break;
+                }
+            }
+            std::sort(arena.pairs_.begin(), arena.pairs_.end(), [](auto a, auto b) {
+                return a.opening < b.opening;
+            });
+        }
+
+        /// N0
+        void resolveBracketPairs(BC sos, BC embedding)
+        {
+            locateBracketPairs();
+
+            auto const& sequence = arena.sequence_;
+            auto const opposite = embedding == BC::Left_To_Right ? BC::Right_To_Left : BC::Left_To_Right;
+            for (auto const pair: arena.pairs_)
+            {
+                auto foundEmbedding = false;
+                auto foundOpposite = false;
+                for (auto k = pair.opening + 1; k < pair.closing && !foundEmbedding; ++k)
+                {
+                    auto const direction = strong_direction(sequenceClass(k));
+                    foundEmbedding = direction == embedding;
+                    foundOpposite = foundOpposite || direction == opposite;
+                }
+
+                auto direction = embedding;
+                if (!foundEmbedding)
+                {
+                    if (!foundOpposite)
+                        continue;
+                    auto preceding = sos;
+                    for (auto k = pair.opening; k > 0; --k)
+                        if (auto const d = strong_direction(sequenceClass(k - 1)); d != BC::Other_Neutral)
+                        {
+                            preceding = d;
+                            break;
+                        }
+                    direction = preceding == opposite ? opposite : embedding;
+                }
+
+                // The brackets, and the nonspacing marks following them, take the direction.
+                for (auto const bracket: { pair.opening, pair.closing })
+                {
+                    classOf(sequence[bracket]) = direction;
+                    for (auto k = bracket + 1;
+                         k < sequence.size() && initialClass(sequence[k]) == BC::Nonspacing_Mark;
+                         ++k)
+                        classOf(sequence[k]) = direction;
+                }
+            }
+        }
+
+        /// N1, N2
+        void resolveNeutralTypes(BC sos, BC eos, BC embedding)
+        {
+            auto const& sequence = arena.sequence_;
+            auto const count = sequence.size();
+            for (size_t k = 0; k < count;)
+            {
+                if (!is_neutral_or_isolate(sequenceClass(k)))
+                {
+                    ++k;
+                    continue;
+                }
+                auto const first = k;
+                while (k < count && is_neutral_or_isolate(sequenceClass(k)))
+                    ++k;
+                auto const before = first == 0 ? sos : strong_direction(sequenceClass(first - 1));
+                auto const after = k == count ? eos : strong_direction(sequenceClass(k));
+                auto const direction = before == after ? before : embedding;
+                for (auto j = first; j < k; ++j)
+                    classOf(sequence[j]) = direction;
+            }
+        }
+
+        /// L1: Resets segment and paragraph separators, and the whitespace before them and at the end
+        /// of the line, to the paragraph level.
+        void resetWhitespaceLevels(size_t start, size_t end, uint8_t paragraphLevel)
+        {
+            auto const isWhitespace = [&](size_t i) {
+                auto const c = initialClass(i);
+                return c == BC::White_Space || is_isolate_control(c) || is_removed(c);
+            };
+            auto const resetBefore = [&](size_t i) {
+                for (; i > start && isWhitespace(i - 1); --i)
+                    levelOf(i - 1) = paragraphLevel;
+            };
+            for (auto i = start; i < end; ++i)
+            {
+                auto const c = initialClass(i);
+                if (c == BC::Segment_Separator || c == BC::Paragraph_Separator)
+                {
+                    levelOf(i) = paragraphLevel;
+                    resetBefore(i);
+                }
+            }
+            resetBefore(end);
+        }
+    };
+} // namespace detail
+
+std::span<uint8_t const> resolve_bidi_levels(std::u32string_view text,
+                                             bidi_arena& arena,
+                                             std::optional<uint8_t> paragraphLevel)
+{
+    detail::bidi_resolver { arena, text }.resolve(paragraphLevel);
+    return arena.levels();
+}
+
+std::span<size_t const> reorder_bidi(std::span<uint8_t const> levels, bidi_arena& arena)
+{
+    auto& order = arena.order_;
+    auto& visualLevels = arena.visualLevels_;
+    order.resize(levels.size());
+    std::iota(order.begin(), order.end(), size_t { 0 });
+    visualLevels.assign(levels.begin(), levels.end());
+    if (levels.empty())
+        return order;
+
+    // L2: From the highest level down to the lowest odd level, reverse any contiguous sequence
+    // of characters at that level or higher.
+    auto const [lowest, highest] = std::minmax_element(levels.begin(), levels.end());
+    auto const lowestOdd = *lowest | 1;
+    for (int level = *highest; level >= lowestOdd; --level)
+    {
+        for (size_t i = 0; i < visualLevels.size();)
+        {
+            if (visualLevels[i] < level)
+            {
+                ++i;
+                continue;
+            }
+            auto j = i;
+            while (j < visualLevels.size() && visualLevels[j] >= level)
+                ++j;
+            std::reverse(order.begin() + static_cast<std::ptrdiff_t>(i),
+                         order.begin() + static_cast<std::ptrdiff_t>(j));
+            std::reverse(visualLevels.begin() + static_cast<std::ptrdiff_t>(i),
+                         visualLevels.begin() + static_cast<std::ptrdiff_t>(j));
+            i = j;
+        }
+    }
+    return order;
+}
+
+bidi_segmenter::bidi_segmenter(char32_t const* text, size_t size):
+    ownArena_ { std::make_shared<bidi_arena>() }
+{
+    levels_ = resolve_bidi_levels(std::u32string_view(text, size), *ownArena_);
+}
+
+bidi_segmenter::bidi_segmenter(std::u32string_view text,
+                               bidi_arena& arena,
+                               std::optional<uint8_t> paragraphLevel):
+    levels_ { resolve_bidi_levels(text, arena, paragraphLevel) }
+{
+}
+
+bool bidi_segmenter::consume(out<size_t> size, out<bidi_level> level) noexcept
+{
+    if (offset_ >= levels_.size())
+        return false;
+
+    auto const current = levels_[offset_];
+    while (offset_ < levels_.size() && levels_[offset_] == current)
+        ++offset_;
+
+    *size = offset_;
+    *level = bidi_level { current };
+    return true;
+}
+
+} // namespace unicode
@@ -0,0 +1,163 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/support.h>
+#include <libunicode/ucd_enums.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace unicode
+{
+
+/// Resolved embedding level of bidirectional text (see UAX #9), being odd for right-to-left text.
+struct bidi_level
+{
+    uint8_t value = 0;
+
+    [[nodiscard]] constexpr bool is_rtl() const noexcept { return (value & 1) != 0; }
+
+    constexpr bool operator==(bidi_level const&) const noexcept = default;
+};
+
+inline std::ostream& operator<<(std::ostream& os, bidi_level level)
+{
+    return os << "level " << static_cast<unsigned>(level.value);
+}
+
+namespace detail
+{
+    struct bidi_resolver;
+}
+
+/// Caller-owned storage for resolve_bidi_levels() and reorder_bidi().
+///
+/// These keep all of their temporary arrays in here, and only ever grow them, such that resolving
+/// text repeatedly (e.g. line by line) does not allocate anymore, once the arena has grown to the
+/// longest text.
+class bidi_arena
+{
+  public:
+    /// Embedding levels of the text last resolved, one per codepoint.
+    [[nodiscard]] std::span<uint8_t const> levels() const noexcept { return levels_; }
+
+    /// Visual order of the levels last reordered, i.e. their logical indices from left to right.
+    [[nodiscard]] std::span<size_t const> order() const noexcept { return order_; }
+
+  private:
+    friend struct detail::bidi_resolver;
+    friend std::span<size_t const> reorder_bidi(std::span<uint8_t const> levels, bidi_arena& arena);
+
+    struct directional_status
+    {
+        uint8_t level;
+        Bidi_Class override; // Other_Neutral if neutral.
+        bool isolate;
+    };
+
+    struct level_run
+    {
+        size_t first; // Index into chars_ of the first codepoint of the level run.
+        size_t last;  // Index into chars_ behind the last codepoint of the level run.
+    };
+
+    struct bracket
+    {
+        char32_t codepoint; // Closing bracket of an opening one.
+        size_t position;    // Index into sequence_.
+    };
+
+    struct bracket_pair
+    {
+        size_t opening; // Index into sequence_.
+        size_t closing; // Index into sequence_.
+    };
+
+    // Per codepoint.
+    std::vector<Bidi_Class> initialClasses_;
+    std::vector<Bidi_Class> classes_;
+    std::vector<uint8_t> levels_;
+    std::vector<size_t> matchingPDI_;
+    std::vector<size_t> matchingInitiator_;
+    std::vector<size_t> runStartingAt_;
+
+    std::vector<size_t> isolates_;
+    std::vector<directional_status> stack_;
+    std::vector<size_t> chars_; // Codepoints not removed by rule X9.
+    std::vector<level_run> runs_;
+    std::vector<size_t> sequence_; // Codepoints of the isolating run sequence being resolved.
+    std::vector<bracket> openers_;
+    std::vector<bracket_pair> pairs_;
+
+    std::vector<size_t> order_;
+    std::vector<uint8_t> visualLevels_;
+};
+
+/// Resolves the embedding levels of the bidirectional @p text, as per UAX #9.
+///
+/// Each paragraph of @p text gets the given @p paragraphLevel, or the one determined by its first
+/// strong character (rules P2 and P3), and the end of each paragraph is considered the end of a line
+/// for rule L1.
+///
+/// Characters removed by rule X9 (such as explicit embeddings) get the level of the character
+/// before them.
+///
+/// @returns the levels, one per codepoint, being valid until @p arena is used again.
+[[nodiscard]] std::span<uint8_t const> resolve_bidi_levels(
+    std::u32string_view text, bidi_arena& arena, std::optional<uint8_t> paragraphLevel = std::nullopt);
+
+/// Reorders a line of resolved embedding levels into visual order, as per rule L2 of UAX #9.
+///
+/// The levels may be those of codepoints, or of consecutive runs of codepoints, such as those
+/// segmented by a basic_run_segmenter with a bidi_segmenter.
+///
+/// @returns the logical indices of the levels from left to right, being valid until @p arena is used again.
+[[nodiscard]] std::span<size_t const> reorder_bidi(std::span<uint8_t const> levels, bidi_arena& arena);
+
+/// Segments text into runs of the same resolved embedding level (see resolve_bidi_levels()),
+/// e.g. as part of a basic_run_segmenter.
+class bidi_segmenter
+{
+  public:
+    using property_type = bidi_level;
+
+    bidi_segmenter() noexcept = default;
+
+    /// Resolves @p text with an arena of its own, allocating it.
+    bidi_segmenter(char32_t const* text, size_t size);
+
+    /// Resolves @p text with the given caller-owned @p arena, which must outlive the segmenter.
+    bidi_segmenter(std::u32string_view text,
+                   bidi_arena& arena,
+                   std::optional<uint8_t> paragraphLevel = std::nullopt);
+
+    bool consume(out<size_t> size, out<bidi_level> level) noexcept;
+
+    /// @returns the resolved embedding levels of the text, one per codepoint.
+    [[nodiscard]] std::span<uint8_t const> levels() const noexcept { return levels_; }
+
+  private:
+    std::shared_ptr<bidi_arena> ownArena_;
+    std::span<uint8_t const> levels_;
+    size_t offset_ = 0;
+};
+
+} // namespace unicode
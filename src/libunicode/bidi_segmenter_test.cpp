@@ -0,0 +1,165 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/bidi_segmenter.h>
+#include <libunicode/run_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::string_view_literals;
+using unicode::bidi_arena;
+using unicode::bidi_level;
+
+namespace
+{
+std::vector<int> levels(std::u32string_view text, std::optional<uint8_t> paragraphLevel = std::nullopt)
+{
+    auto arena = bidi_arena {};
+    auto const levels = unicode::resolve_bidi_levels(text, arena, paragraphLevel);
+    return { levels.begin(), levels.end() };
+}
+
+std::vector<size_t> reordered(std::vector<uint8_t> const& levels)
+{
+    auto arena = bidi_arena {};
+    auto const order = unicode::reorder_bidi(levels, arena);
+    return { order.begin(), order.end() };
+}
+
+using ints = std::vector<int>;
+} // namespace
+
+TEST_CASE("bidi_segmenter.strong", "[bidi_segmenter]")
+{
+    CHECK(levels(U""sv).empty());
+    CHECK(levels(U"abc"sv) == ints { 0, 0, 0 });
+    CHECK(levels(U"\u05D0\u05D1\u05D2"sv) == ints { 1, 1, 1 });
+    CHECK(levels(U"abc \u05D0\u05D1\u05D2 def"sv) == ints { 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0 });
+    CHECK(levels(U"\u05D0\u05D1\u05D2 abc"sv) == ints { 1, 1, 1, 1, 2, 2, 2 });
+    CHECK(levels(U"abc"sv, 1) == ints { 2, 2, 2 });
+
+    // Nonspacing marks take the direction of the character before them.
+    CHECK(levels(U"\u05D0\u05D1\u05BC"sv, 0) == ints { 1, 1, 1 });
+}
+
+TEST_CASE("bidi_segmenter.numbers", "[bidi_segmenter]")
+{
+    CHECK(levels(U"abc 123"sv) == ints { 0, 0, 0, 0, 0, 0, 0 });
+    CHECK(levels(U"\u05D0\u05D1\u05D2 123"sv) == ints { 1, 1, 1, 1, 2, 2, 2 });
+    CHECK(levels(U"\u05D0 1.5"sv) == ints { 1, 1, 2, 2, 2 });
+
+    // European numbers after Arabic letters become Arabic numbers.
+    CHECK(levels(U"\u0627 12"sv) == ints { 1, 1, 2, 2 });
+    CHECK(levels(U"\u0627 1 a"sv, 0) == ints { 1, 1, 2, 0, 0 });
+}
+
+TEST_CASE("bidi_segmenter.brackets", "[bidi_segmenter]")
+{
+    // The brackets take the direction of their contents, being established by the context before them.
+    CHECK(levels(U"\u05D0(\u05D1)abc"sv, 0) == ints { 1, 1, 1, 1, 0, 0, 0 });
+    CHECK(levels(U"a(\u05D1)abc"sv, 0) == ints { 0, 0, 1, 0, 0, 0, 0 });
+    CHECK(levels(U"\u05D0(b)"sv) == ints { 1, 1, 2, 1 });
+
+    // Unmatched and too deeply nested brackets are neutrals.
+    CHECK(levels(U"\u05D0(abc"sv, 0) == ints { 1, 0, 0, 0, 0 });
+    auto const deep = std::u32string(100, U'(') + U"\u05D0" + std::u32string(100, U')');
+    CHECK(levels(deep, 0).size() == deep.size());
+}
+
+TEST_CASE("bidi_segmenter.explicit", "[bidi_segmenter]")
+{
+    // Isolates, which are skipped when determining the paragraph level.
+    CHECK(levels(U"abc \u2067\u05D0\u05D1\u05D2\u2069 def"sv)
+          == ints { 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0 });
+    CHECK(levels(U"\u2067\u05D0\u05D1\u05D2\u2069abc"sv) == ints { 0, 1, 1, 1, 0, 0, 0, 0 });
+    CHECK(levels(U"\u2068\u05D0\u05D1\u05D2\u2069 abc"sv) == ints { 0, 1, 1, 1, 0, 0, 0, 0, 0 });
+    CHECK(levels(U"\u2068abc\u2069 \u05D0\u05D1\u05D2"sv) == ints { 1, 2, 2, 2, 1, 1, 1, 1, 1 });
+
+    // Embeddings and overrides, whose removed formatting characters get the level before them,
+    // and trailing whitespace the paragraph level.
+    CHECK(levels(U"a\u202Bb\u202Cc"sv) == ints { 0, 0, 2, 2, 0 });
+    CHECK(levels(U"\u202Eab \u202C"sv) == ints { 0, 1, 1, 0, 0 });
+
+    // Overflowing the maximum depth.
+    auto const deep = std::u32string(130, U'\u202B') + U"a";
+    auto const deepLevels = levels(deep);
+    CHECK(deepLevels.back() == 126);
+}
+
+TEST_CASE("bidi_segmenter.paragraphs", "[bidi_segmenter]")
+{
+    CHECK(levels(U"\u05D0\u05D1\u05D2\nabc"sv) == ints { 1, 1, 1, 1, 0, 0, 0 });
+    CHECK(levels(U"abc\t\u05D0\u05D1\u05D2"sv, 1) == ints { 2, 2, 2, 1, 1, 1, 1 });
+}
+
+TEST_CASE("bidi_segmenter.reorder", "[bidi_segmenter]")
+{
+    CHECK(reordered({}).empty());
+    CHECK(reordered({ 0, 0, 0 }) == std::vector<size_t> { 0, 1, 2 });
+    CHECK(reordered({ 0, 0, 1, 1, 1, 0 }) == std::vector<size_t> { 0, 1, 4, 3, 2, 5 });
+    CHECK(reordered({ 1, 1, 2, 2, 1 }) == std::vector<size_t> { 4, 2, 3, 1, 0 });
+    CHECK(reordered({ 2, 2 }) == std::vector<size_t> { 0, 1 });
+    CHECK(reordered({ 0, 1, 2, 1, 0 }) == std::vector<size_t> { 0, 3, 2, 1, 4 });
+}
+
+TEST_CASE("bidi_segmenter.arena", "[bidi_segmenter]")
+{
+    auto arena = bidi_arena {};
+    auto const long_text = std::u32string(1000, U'\u05D0') + U" (abc) \u2067123\u2069";
+    auto const data = unicode::resolve_bidi_levels(long_text, arena).data();
+    auto const order = unicode::reorder_bidi(arena.levels(), arena).data();
+
+    // Resolving shorter text reuses the arena's storage.
+    for (auto const text:
+         { U"abc \u05D0\u05D1\u05D2 def"sv, U"\u05D0(\u05D1)abc"sv, U"\u2068abc\u2069 \u05D0\u05D1\u05D2"sv })
+    {
+        auto const resolved = unicode::resolve_bidi_levels(text, arena);
+        CHECK(resolved.data() == data);
+        CHECK(std::vector<int>(resolved.begin(), resolved.end()) == levels(text));
+        CHECK(unicode::reorder_bidi(resolved, arena).data() == order);
+    }
+}
+
+TEST_CASE("bidi_segmenter.run_segmenter", "[bidi_segmenter]")
+{
+    auto const text = U"abc \u05D0\u05D1\u05D2 def"sv;
+    auto arena = bidi_arena {};
+    auto segmenter =
+        unicode::basic_run_segmenter<unicode::bidi_segmenter>(text, unicode::bidi_segmenter(text, arena));
+    using range = decltype(segmenter)::range;
+    auto runs = std::vector<range> {};
+    auto run = range {};
+    while (segmenter.consume(unicode::out(run)))
+        runs.push_back(run);
+    CHECK(runs
+          == std::vector<range> {
+              { 0, 4, { bidi_level { 0 } } },
+              { 4, 7, { bidi_level { 1 } } },
+              { 7, 11, { bidi_level { 0 } } },
+          });
+
+    // Same as above, but with an arena of the segmenter's own, and along with the other segmenters.
+    auto runSegmenter = unicode::bidi_run_segmenter { text };
+    auto bidiRuns = std::vector<std::pair<size_t, bidi_level>> {};
+    auto bidiRun = unicode::bidi_run_segmenter::range {};
+    while (runSegmenter.consume(unicode::out(bidiRun)))
+        bidiRuns.emplace_back(bidiRun.end, std::get<bidi_level>(bidiRun.properties));
+    CHECK(bidiRuns.back() == std::pair { size_t { 11 }, bidi_level { 0 } });
+    for (auto const& [end, level]: bidiRuns)
+        CHECK(level.is_rtl() == (end == 7));
+}
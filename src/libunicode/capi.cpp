@@ -14,10 +14,196 @@
 #include <libunicode/capi.h>
 #include <libunicode/convert.h>
 #include <libunicode/grapheme_segmenter.h>
+#include <libunicode/scan.h>
 #include <libunicode/ucd.h>
 #include <libunicode/width.h>
+#include <libunicode/width_policy.h>
 
+#include <exception>
 #include <iterator>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct gc_width_policy
+{
+    unicode::width_policy policy;
+};
+
+namespace
+{
+
+/// Returns the width of @p codepoint, as per @p policy, if any.
+int width_of(char32_t codepoint, unicode::width_policy const* policy) noexcept
+{
+    return policy ? policy->width(codepoint) : unicode::width(codepoint);
+}
+
+/// Returns the width of a grapheme cluster of width @p clusterWidth, with @p codepoint appended to it.
+int append_to_cluster_width(int clusterWidth,
+                            char32_t codepoint,
+                            unicode::width_policy const* policy) noexcept
+{
+    auto const width = [&]() {
+        switch (codepoint)
+        {
+            case 0xFE0E: return 1;
+            case 0xFE0F: return 2;
+            default: return width_of(codepoint, policy);
+        }
+    }();
+    return width && width != clusterWidth ? width : clusterWidth;
+}
+
+/// Counts the grapheme clusters and their widths as scanned by scan_text().
+class gc_receiver
+{
+  public:
+    explicit gc_receiver(int mode, unicode::width_policy const* policy = nullptr) noexcept:
+        _mode { mode }, _policy { policy }
+    {
+    }
+
+    [[nodiscard]] unicode::width_policy const* policy() const noexcept { return _policy; }
+
+    void receiveAsciiSequence(std::string_view sequence) noexcept
+    {
+        _count += sequence.size();
+        _width += sequence.size();
+        _asciiEnd = sequence.data() + sequence.size();
+        _asciiLast = sequence.back();
+    }
+
+    void receiveGraphemeCluster(std::string_view cluster, size_t columnCount) noexcept
+    {
+        auto const first = unicode::decode_utf8_sequence(cluster);
+
+        // scan_text() passes codepoints continuing the grapheme cluster of the last US-ASCII character
+        // (e.g. VS16 or combining marks) on their own, which thus only add to the width of that one.
+        auto const asciiEnd = std::exchange(_asciiEnd, nullptr);
+        if (cluster.data() == asciiEnd
+            && !unicode::grapheme_segmenter::breakable(static_cast<char32_t>(_asciiLast), first.value))
+        {
+            if (_mode != GC_WIDTH_MODE_NON_MODIFIABLE)
+            {
+                auto const asciiWidth = width_of(static_cast<char32_t>(_asciiLast), _policy);
+                _width += static_cast<size_t>(append_to_width(asciiWidth, cluster, 0) - asciiWidth);
+            }
+            return;
+        }
+
+        ++_count;
+
+        // The column count already is the width of a single codepoint grapheme cluster.
+        if (first.length == cluster.size())
+        {
+            _width += columnCount;
+            return;
+        }
+
+        auto clusterWidth = width_of(first.value, _policy);
+        if (_mode != GC_WIDTH_MODE_NON_MODIFIABLE)
+            clusterWidth = append_to_width(clusterWidth, cluster, first.length);
+        _width += static_cast<size_t>(clusterWidth);
+    }
+
+    void receiveInvalidGraphemeCluster() noexcept
+    {
+        ++_count;
+        ++_width;
+        _asciiEnd = nullptr;
+    }
+
+    void receiveControlCharacter(char ch) noexcept
+    {
+        ++_count;
+        _width += static_cast<size_t>(unicode::width(static_cast<uint8_t>(ch)));
+    }
+
+    [[nodiscard]] int count() const noexcept { return static_cast<int>(_count); }
+    [[nodiscard]] int width() const noexcept { return static_cast<int>(_width); }
+
+  private:
+    /// Returns the width of a grapheme cluster of width @p clusterWidth, with the codepoints of
+    /// @p cluster from the byte @p offset on appended to it.
+    [[nodiscard]] int append_to_width(int clusterWidth,
+                                      std::string_view cluster,
+                                      size_t offset) const noexcept
+    {
+        for (auto i = offset; i < cluster.size();)
+        {
+            auto const next = unicode::decode_utf8_sequence(cluster.substr(i));
+            clusterWidth = append_to_cluster_width(clusterWidth, next.value, _policy);
+            i += next.length;
+        }
+        return clusterWidth;
+    }
+
+    int _mode;
+    unicode::width_policy const* _policy;
+    size_t _count = 0;
+    size_t _width = 0;
+
+    // End and last character of the last US-ASCII sequence received.
+    char const* _asciiEnd = nullptr;
+    char _asciiLast = 0;
+};
+
+/// Scans all of @p text, including the C0 control characters scan_text() stops at,
+/// each of which is a grapheme cluster of its own, except for CR LF.
+void scan_all(std::string_view text, gc_receiver& receiver) noexcept
+{
+    char const* input = text.data();
+    char const* const end = input + text.size();
+    auto state = unicode::scan_state {};
+    state.widths = receiver.policy();
+    while (input != end)
+    {
+        (void) unicode::scan_text(state,
+                                  std::string_view(input, static_cast<size_t>(end - input)),
+                                  std::numeric_limits<size_t>::max(),
+                                  receiver);
+        input = state.next;
+        if (input == end)
+            break;
+
+        // Stopped at a control character.
+        receiver.receiveControlCharacter(*input);
+        input += *input == '\r' && input + 1 != end && input[1] == '\n' ? 2 : 1;
+        state = {};
+        state.widths = receiver.policy();
+    }
+
+    // A trailing incomplete UTF-8 sequence is invalid.
+    if (state.utf8.expectedLength)
+        receiver.receiveInvalidGraphemeCluster();
+}
+
+unicode::width_policy const* policy_of(gc_width_policy_t handle) noexcept
+{
+    return handle ? &handle->policy : nullptr;
+}
+
+/// Computes u32_gc_width(), with the widths of @p policy, if any.
+int gc_width(u32_char_t const* codepoints, size_t size, int mode, unicode::width_policy const* policy)
+{
+    int totalWidth = 0;
+    auto segmenter =
+        unicode::grapheme_segmenter((char32_t const*) codepoints, (char32_t const*) codepoints + size);
+    for (; !(*segmenter).empty(); ++segmenter)
+    {
+        auto const cluster = *segmenter;
+        int thisWidth = width_of(cluster.front(), policy);
+        if (mode != GC_WIDTH_MODE_NON_MODIFIABLE)
+            for (size_t i = 1; i < cluster.size(); ++i)
+                thisWidth = append_to_cluster_width(thisWidth, cluster[i], policy);
+        totalWidth += thisWidth;
+    }
+    return totalWidth;
+}
+
+} // namespace
 
 int u32_gc_count(u32_char_t const* codepoints, size_t size)
 {
@@ -37,49 +223,82 @@ int u32_gc_count(u32_char_t const* codepoints, size_t size)
 
 int u8_gc_count(u8_char_t const* codepoints, size_t size)
 {
-    auto const u32 = unicode::convert_to<char32_t>(std::string_view(codepoints, size));
-    return u32_gc_count((uint32_t const*) u32.data(), u32.size());
+    auto receiver = gc_receiver { GC_WIDTH_MODE_MODIFIABLE };
+    scan_all(std::string_view(codepoints, size), receiver);
+    return receiver.count();
+}
+
+void u8_gc_count_batch(u8_char_t const* const* strings, size_t const* sizes, size_t count, int* counts)
+{
+    for (size_t i = 0; i < count; ++i)
+        counts[i] = u8_gc_count(strings[i], sizes[i]);
 }
 
 int u32_gc_width(u32_char_t const* codepoints, size_t size, int mode)
 {
-    int totalWidth = 0;
-    auto segmenter =
-        unicode::grapheme_segmenter((char32_t const*) codepoints, (char32_t const*) codepoints + size);
-    while (segmenter.codepointsAvailable())
+    return gc_width(codepoints, size, mode, nullptr);
+}
+
+int u8_gc_width(u8_char_t const* codepoints, size_t size, int mode)
+{
+    auto receiver = gc_receiver { mode };
+    scan_all(std::string_view(codepoints, size), receiver);
+    return receiver.width();
+}
+
+void u8_gc_width_batch(
+    u8_char_t const* const* strings, size_t const* sizes, size_t count, int mode, int* widths)
+{
+    for (size_t i = 0; i < count; ++i)
+        widths[i] = u8_gc_width(strings[i], sizes[i], mode);
+}
+
+gc_width_policy_t gc_width_policy_create(int ambiguous_width,
+                                         gc_width_override_t const* overrides,
+                                         size_t count)
+{
+    if (ambiguous_width != 1 && ambiguous_width != 2)
+        return nullptr;
+
+    try
     {
-        auto const cluster = *segmenter;
-        int thisWidth = unicode::width(cluster.front());
-        if (mode != GC_WIDTH_MODE_NON_MODIFIABLE)
+        auto entries = std::vector<unicode::width_override>();
+        entries.reserve(count);
+        for (size_t i = 0; i < count; ++i)
         {
-            for (size_t i = 1; i < size; ++i)
-            {
-                auto const codepoint = codepoints[i];
-                auto const width = [&]() {
-                    switch (codepoint)
-                    {
-                        case 0xFE0E: return 1;
-                        case 0xFE0F: return 2;
-                        default: return unicode::width(codepoint);
-                    }
-                }();
-                if (width && width != thisWidth)
-                    thisWidth = width;
-            }
+            if (overrides[i].width < 0 || overrides[i].width > 3)
+                return nullptr;
+            entries.push_back({ static_cast<char32_t>(overrides[i].first),
+                                static_cast<char32_t>(overrides[i].last),
+                                static_cast<uint8_t>(overrides[i].width) });
         }
-        totalWidth += thisWidth;
-        ++segmenter;
+
+        auto const ambiguous =
+            ambiguous_width == 2 ? unicode::ambiguous_width::Wide : unicode::ambiguous_width::Narrow;
+        return new gc_width_policy { unicode::width_policy(ambiguous, entries) };
+    }
+    catch (std::exception const&)
+    {
+        return nullptr;
     }
-    return totalWidth;
 }
 
-int u8_gc_width(u8_char_t const* codepoints, size_t count, int allowMod)
+void gc_width_policy_destroy(gc_width_policy_t* handle)
 {
-    (void) codepoints;
-    (void) count;
-    (void) allowMod;
+    delete *handle;
+    *handle = nullptr;
+}
+
+int u32_gc_width_with_policy(u32_char_t const* codepoints, size_t size, int mode, gc_width_policy_t policy)
+{
+    return gc_width(codepoints, size, mode, policy_of(policy));
+}
 
-    return -1; // TODO
+int u8_gc_width_with_policy(u8_char_t const* codepoints, size_t size, int mode, gc_width_policy_t policy)
+{
+    auto receiver = gc_receiver { mode, policy_of(policy) };
+    scan_all(std::string_view(codepoints, size), receiver);
+    return receiver.width();
 }
 
 int u32_grapheme_unbreakable(u32_char_t a, u32_char_t b)
@@ -113,6 +332,59 @@ void u8u32_stream_convert_destroy(u8u32_stream_state_t* handle)
     *handle = nullptr;
 }
 
+struct u8_scanner
+{
+    unicode::scan_state state {};
+};
+
+u8_scanner_t u8_scanner_create(void)
+{
+    return new u8_scanner();
+}
+
+u8_scan_result_t u8_scanner_feed(
+    u8_scanner_t handle, u8_char_t const* text, size_t n, size_t max_columns, u8_cluster_buffer_t* clusters)
+{
+    auto& state = handle->state;
+
+    // The position of the last call is within the text fed back then.
+    state.next = nullptr;
+
+    auto const input = std::string_view(text, n);
+    auto result = unicode::scan_result {};
+    if (clusters)
+    {
+        auto buffer = unicode::grapheme_cluster_buffer {
+            clusters->offsets, clusters->widths, clusters->invalid, clusters->capacity, 0
+        };
+        result = unicode::scan_text(state, input, max_columns, buffer);
+        clusters->size = buffer.size;
+    }
+    else
+        result = unicode::scan_text(state, input, max_columns);
+
+    auto const consumed = state.next ? static_cast<size_t>(state.next - text) : 0;
+    return { result.count, result.start, result.end, consumed };
+}
+
+void u8_scanner_reset(u8_scanner_t handle)
+{
+    auto const* const widths = handle->state.widths;
+    handle->state = {};
+    handle->state.widths = widths;
+}
+
+void u8_scanner_set_width_policy(u8_scanner_t handle, gc_width_policy_t policy)
+{
+    handle->state.widths = policy_of(policy);
+}
+
+void u8_scanner_destroy(u8_scanner_t* handle)
+{
+    delete *handle;
+    *handle = nullptr;
+}
+
 int u32u8_convert(u32_char_t const* source, size_t slen, u8_char_t* dest, size_t dlen)
 {
     auto conv = unicode::encoder<u8_char_t> {};
@@ -14,10 +14,11 @@
 #ifndef LIBUNICODE_CAPI_H
 #define LIBUNICODE_CAPI_H 1
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
-#if !defined(__cplusplus)
+#if defined(__cplusplus)
 extern "C"
 {
 #endif
@@ -38,7 +39,7 @@ extern "C"
  * Verifies that _p codepoint is a valid codepoint,
  */
 #define u32_is_valid_codepoint(_codepoint) \
-    ((_codepoint) < 0xD800 || ((_codepoint) > 0xDFFF && (_codepoint) <= 0x10FFFF)
+    ((_codepoint) < 0xD800 || ((_codepoint) > 0xDFFF && (_codepoint) <= 0x10FFFF))
 
 /**
  * Extracts the unused higher order bits and moves them bit-wise to the right.
@@ -92,8 +93,25 @@ extern "C"
      *         in [codepoints, codepoints+n).
      */
     int u32_gc_count(u32_char_t const* codepoints, size_t n);
+
+    /**
+     * UTF-8 version of @c u32_gc_count().
+     *
+     * The text is scanned in linear time without allocating. Each ill-formed UTF-8 sequence
+     * counts as one grapheme cluster.
+     */
     int u8_gc_count(u8_char_t const* codepoints, size_t n);
 
+    /**
+     * Counts the number of grapheme clusters for each of the @p count UTF-8 strings in one call.
+     *
+     * @param strings  pointers to the first byte of each string.
+     * @param sizes    number of bytes of each string.
+     * @param count    number of strings.
+     * @param counts   receives the u8_gc_count() of each string, must be able to hold @p count elements.
+     */
+    void u8_gc_count_batch(u8_char_t const* const* strings, size_t const* sizes, size_t count, int* counts);
+
 /**
  * Determines that u32_gc_width()/u8_gc_width() must not respect
  * variation selectors, and thus, will not change the width of a
@@ -131,9 +149,75 @@ extern "C"
     /**
      * UTF-8 version of @c u32_gc_width().
      *
-     * @see u32_gc_width(u32_char_t const* codepoints, size_t n, int allowMod)
+     * The text is scanned in linear time without allocating. Each ill-formed UTF-8 sequence
+     * counts as one grapheme cluster of width 1.
+     *
+     * @see u32_gc_width(u32_char_t const* codepoints, size_t n, int mode)
      */
-    int u8_gc_width(u8_char_t const* codepoints, size_t n, int allowMod);
+    int u8_gc_width(u8_char_t const* codepoints, size_t n, int mode);
+
+    /**
+     * Computes the display width for each of the @p count UTF-8 strings in one call.
+     *
+     * @param strings  pointers to the first byte of each string.
+     * @param sizes    number of bytes of each string.
+     * @param count    number of strings.
+     * @param mode     see u32_gc_width().
+     * @param widths   receives the u8_gc_width() of each string, must be able to hold @p count elements.
+     */
+    void u8_gc_width_batch(
+        u8_char_t const* const* strings, size_t const* sizes, size_t count, int mode, int* widths);
+
+    /**
+     * Opaque handle for a policy of the widths of codepoints, e.g. for the font and locale
+     * text is rendered with.
+     *
+     * The widths are compiled into lookup tables of their own when the policy is created,
+     * such that computing the policy adjusted width costs no more than the default one.
+     */
+    struct gc_width_policy;
+    typedef struct gc_width_policy* gc_width_policy_t;
+
+    /**
+     * Width of the codepoints in [first, last], overriding their default width.
+     */
+    typedef struct gc_width_override
+    {
+        u32_char_t first;
+        u32_char_t last;
+        int width;
+    } gc_width_override_t;
+
+    /**
+     * Constructs a width policy.
+     *
+     * @param ambiguous_width  width of the codepoints of East_Asian_Width Ambiguous that are
+     *                         not zero-width, either 1 (the default) or 2 (for East Asian contexts).
+     * @param overrides        widths of ranges of codepoints, where later ones take precedence over
+     *                         earlier ones. Overrides of US-ASCII characters are ignored.
+     * @param count            number of overrides.
+     *
+     * @return the policy, or NULL if any of the arguments is invalid, e.g. a width greater than 3.
+     */
+    gc_width_policy_t gc_width_policy_create(int ambiguous_width,
+                                             gc_width_override_t const* overrides,
+                                             size_t count);
+
+    /**
+     * Destroys the width policy.
+     * The parameter @p handle will be set to NULL when this call leaves.
+     */
+    void gc_width_policy_destroy(gc_width_policy_t* handle);
+
+    /**
+     * Same as u32_gc_width(), but with the widths of @p policy, or the default ones if NULL.
+     */
+    int u32_gc_width_with_policy(u32_char_t const* codepoints, size_t n, int mode, gc_width_policy_t policy);
+
+    /**
+     * Same as u8_gc_width(), but with the widths of @p policy, or the default ones if NULL.
+     */
+    int u8_gc_width_with_policy(u8_char_t const* codepoints, size_t n, int mode, gc_width_policy_t policy);
 
     /**
      * Tests if two consecutive codepoints do belong to the same grapheme cluster,
@@ -184,6 +268,102 @@ extern "C"
      */
     void u8u32_stream_convert_destroy(u8u32_stream_state_t* handle);
 
+    /**
+     * Opaque handle for the streaming UTF-8 text scanner.
+     *
+     * The scanner keeps the UTF-8 decoding and grapheme segmentation state from one call
+     * of u8_scanner_feed() to the next, such that text split across reads (e.g. from a PTY)
+     * is scanned as if it had been scanned at once.
+     */
+    struct u8_scanner;
+    typedef struct u8_scanner* u8_scanner_t;
+
+    /**
+     * Caller provided buffer to be filled with the grapheme clusters scanned by u8_scanner_feed().
+     *
+     * Each array must be able to hold @c capacity elements.
+     */
+    typedef struct u8_cluster_buffer
+    {
+        /// Byte offsets at which the grapheme clusters start, relative to u8_scan_result::start.
+        size_t* offsets;
+
+        /// Widths of the grapheme clusters in columns.
+        uint8_t* widths;
+
+        /// Whether or not the grapheme cluster is an invalid UTF-8 sequence.
+        bool* invalid;
+
+        /// Number of elements each of the arrays can hold.
+        size_t capacity;
+
+        /// Number of grapheme clusters filled in by the last call to u8_scanner_feed().
+        size_t size;
+    } u8_cluster_buffer_t;
+
+    /**
+     * Result of a call to u8_scanner_feed().
+     */
+    typedef struct u8_scan_result
+    {
+        /// Number of columns scanned.
+        size_t columns;
+
+        /// Pointer to the start of the scanned text. This is before the fed text if it starts
+        /// with the remainder of a UTF-8 sequence started by the previous call.
+        u8_char_t const* start;
+
+        /// Pointer to one byte behind the last completely scanned UTF-8 sequence.
+        u8_char_t const* end;
+
+        /// Number of bytes of the fed text processed. The next call continues
+        /// right behind them.
+        size_t consumed;
+    } u8_scan_result_t;
+
+    /**
+     * Constructs a streaming UTF-8 text scanner.
+     */
+    u8_scanner_t u8_scanner_create(void);
+
+    /**
+     * Scans UTF-8 text incrementally, mirroring scan_text() of the C++ API.
+     *
+     * Scanning stops before a C0 control character, before the grapheme cluster that would
+     * exceed @p max_columns, or when @p clusters is full. A trailing incomplete UTF-8 sequence
+     * is kept by the scanner, and completed by the next call.
+     *
+     * @param handle       The handle to the previously created scanner.
+     * @param text         Pointer to the first byte of the text to scan.
+     * @param n            Number of bytes to scan at most.
+     * @param max_columns  Number of columns to scan at most.
+     * @param clusters     If not NULL, filled with the scanned grapheme clusters.
+     *
+     * @return the number of columns scanned and the bytes they span.
+     */
+    u8_scan_result_t u8_scanner_feed(u8_scanner_t handle,
+                                     u8_char_t const* text,
+                                     size_t n,
+                                     size_t max_columns,
+                                     u8_cluster_buffer_t* clusters);
+
+    /**
+     * Resets the scanner to the start of a new text, discarding any incomplete UTF-8 sequence.
+     */
+    void u8_scanner_reset(u8_scanner_t handle);
+
+    /**
+     * Makes the scanner scan with the widths of @p policy, or the default ones if NULL,
+     * which must outlive the scanner or the next call to this function.
+     */
+    void u8_scanner_set_width_policy(u8_scanner_t handle, gc_width_policy_t policy);
+
+    /**
+     * Destroys the scanner.
+     * The parameter @p handle will be set to NULL when this call leaves.
+     */
+    void u8_scanner_destroy(u8_scanner_t* handle);
+
     /**
      * Convertes a UTF-32 sequence to UTF-8.
      *
@@ -201,7 +381,7 @@ extern "C"
      */
     int u32u8_convert(u32_char_t const* source, size_t slen, u8_char_t* dest, size_t dlen);
 
-#if !defined(__cplusplus)
+#if defined(__cplusplus)
 }
 #endif
 
@@ -12,6 +12,7 @@
  * limitations under the License.
  */
 #include <libunicode/capi.h>
+#include <libunicode/convert.h>
 
 #include <fmt/format.h>
 
@@ -59,4 +60,168 @@ TEST_CASE("capi.u8u32_stream_convert_and_inverse")
     CHECK(inverseSV == input);
 }
 
+TEST_CASE("capi.u8_gc_count")
+{
+    auto const count = [](string_view text) { return u8_gc_count(text.data(), text.size()); };
+    CHECK(0 == count(""sv));
+    CHECK(1 == count("\U0001F600\uFE0E"sv));
+    CHECK(2 == count("\U0001F600\uFE0E\U0001F600"sv));
+    CHECK(4 == count("Hi \U0001F600\uFE0E"sv));
+    CHECK(1 == count("\U0001F468\U0001F3FE\u200D\U0001F9B3"sv));
+
+    // Control characters are grapheme clusters of their own, except for CR LF.
+    CHECK(5 == count("a\r\nb\tc"sv));
+    CHECK(3 == count("\n\n\u00E4"sv));
+
+    // Ill-formed UTF-8 sequences count as one grapheme cluster each.
+    CHECK(3 == count("a\xFF\xC3"sv));
+    CHECK(3 == count("\xE4\xB8\nb"sv));
+
+    // Codepoints continuing the grapheme cluster of a US-ASCII character are counted along with it,
+    // as by the UTF-32 version.
+    for (auto const text:
+         { U"e\u0301"sv, U"ae\u0301"sv, U"e\u0301x"sv, U"a\uFE0F"sv, U"x\u200D\U0001F600"sv })
+    {
+        auto const utf8 = unicode::convert_to<char>(text);
+        CHECK(count(utf8) == u32_gc_count((u32_char_t const*) text.data(), text.size()));
+    }
+    CHECK(1 == count("e\u0301"sv));
+    CHECK(2 == count("x\u200D\U0001F600"sv));
+}
+
+TEST_CASE("capi.gc_width")
+{
+    auto const u8_width = [](string_view text, int mode) {
+        return u8_gc_width(text.data(), text.size(), mode);
+    };
+    auto const u32_width = [](u32string_view text, int mode) {
+        return u32_gc_width((u32_char_t const*) text.data(), text.size(), mode);
+    };
+
+    auto constexpr Modifiable = GC_WIDTH_MODE_MODIFIABLE;
+    auto constexpr NonModifiable = GC_WIDTH_MODE_NON_MODIFIABLE;
+
+    CHECK(u8_width("Hello"sv, Modifiable) == 5);
+    CHECK(u8_width("\u4E00\u4E01"sv, Modifiable) == 4);
+    CHECK(u8_width("a\u0301b"sv, Modifiable) == 2);
+    CHECK(u8_width("\u2764\uFE0F"sv, Modifiable) == 2);
+    CHECK(u8_width("\u2764\uFE0F"sv, NonModifiable) == 1);
+    CHECK(u8_width("\U0001F600\uFE0E"sv, Modifiable) == 1);
+    CHECK(u8_width("\U0001F600\uFE0E"sv, NonModifiable) == 2);
+    CHECK(u8_width("a\xFF" "b"sv, Modifiable) == 3);
+
+    // The UTF-8 and UTF-32 versions agree, and only look at the codepoints of each grapheme cluster.
+    for (auto const text: { U"\u2764\uFE0F\u2764"sv,
+                            U"x\U0001F600\uFE0E y"sv,
+                            U"\u4E00\u0301a"sv,
+                            U"ae\u0301"sv,
+                            U"a\uFE0F"sv,
+                            U"x\u200D\U0001F600"sv })
+    {
+        auto const utf8 = unicode::convert_to<char>(text);
+        CHECK(u8_width(utf8, Modifiable) == u32_width(text, Modifiable));
+        CHECK(u8_width(utf8, NonModifiable) == u32_width(text, NonModifiable));
+    }
+    CHECK(u32_width(U"\u2764\uFE0F\u2764"sv, Modifiable) == 3);
+}
+
+TEST_CASE("capi.gc_batch")
+{
+    auto const texts = array { "Hello"sv, ""sv, "\u4E00\u4E01"sv, "a\r\nb"sv };
+    auto strings = array<u8_char_t const*, texts.size()> {};
+    auto sizes = array<size_t, texts.size()> {};
+    for (size_t i = 0; i < texts.size(); ++i)
+    {
+        strings[i] = texts[i].data();
+        sizes[i] = texts[i].size();
+    }
+
+    auto results = array<int, texts.size()> {};
+    u8_gc_count_batch(strings.data(), sizes.data(), texts.size(), results.data());
+    CHECK(results == array { 5, 0, 2, 3 });
+
+    u8_gc_width_batch(strings.data(), sizes.data(), texts.size(), GC_WIDTH_MODE_MODIFIABLE, results.data());
+    for (size_t i = 0; i < texts.size(); ++i)
+        CHECK(results[i] == u8_gc_width(texts[i].data(), texts[i].size(), GC_WIDTH_MODE_MODIFIABLE));
+}
+
+TEST_CASE("capi.u8_scanner")
+{
+    u8_scanner_t scanner = u8_scanner_create();
+
+    // A grapheme cluster split across two calls is scanned as if it had been scanned at once.
+    auto const text = "ab\u4E00\U0001F600\uFE0Ecd"sv;
+    auto const split = size_t { 4 }; // within U+4E00
+    auto offsets = array<size_t, 8> {};
+    auto widths = array<uint8_t, 8> {};
+    auto invalid = array<bool, 8> {};
+    auto clusters = u8_cluster_buffer_t { offsets.data(), widths.data(), invalid.data(), offsets.size(), 0 };
+
+    auto const first = u8_scanner_feed(scanner, text.data(), split, 80, &clusters);
+    CHECK(first.columns == 2);
+    CHECK(first.consumed == split);
+    CHECK(first.start == text.data());
+    CHECK(first.end == text.data() + 2);
+    CHECK(clusters.size == 2);
+
+    auto const second = u8_scanner_feed(scanner, text.data() + split, text.size() - split, 80, &clusters);
+    CHECK(second.columns == 6);
+    CHECK(second.consumed == text.size() - split);
+    CHECK(second.start == text.data() + 2);
+    CHECK(second.end == text.data() + text.size());
+    REQUIRE(clusters.size == 4);
+    CHECK(offsets[0] == 0);
+    CHECK(widths[0] == 2);
+    CHECK(offsets[1] == 3);
+    CHECK(widths[1] == 2);
+    CHECK(!invalid[1]);
+
+    // Scanning stops before control characters and at the column limit.
+    u8_scanner_reset(scanner);
+    auto const line = "abc\r\n"sv;
+    auto const third = u8_scanner_feed(scanner, line.data(), line.size(), 80, nullptr);
+    CHECK(third.columns == 3);
+    CHECK(third.consumed == 3);
+    auto const fourth = u8_scanner_feed(scanner, line.data(), line.size(), 2, nullptr);
+    CHECK(fourth.columns == 2);
+    CHECK(fourth.consumed == 2);
+
+    u8_scanner_destroy(&scanner);
+    CHECK(scanner == nullptr);
+}
+
+TEST_CASE("capi.gc_width_policy")
+{
+    auto const overrides = std::array { gc_width_override_t { 0xE000, 0xF8FF, 2 } };
+    gc_width_policy_t policy = gc_width_policy_create(2, overrides.data(), overrides.size());
+    REQUIRE(policy != nullptr);
+
+    // U+00A1 (East_Asian_Width Ambiguous), a Private Use Area codepoint, "a".
+    auto constexpr u32 = U"\u00A1\uE000a"sv;
+    auto const u8 = unicode::convert_to<char>(u32);
+    auto const* const codepoints = (u32_char_t const*) u32.data();
+    CHECK(3 == u32_gc_width(codepoints, u32.size(), GC_WIDTH_MODE_MODIFIABLE));
+    CHECK(5 == u32_gc_width_with_policy(codepoints, u32.size(), GC_WIDTH_MODE_MODIFIABLE, policy));
+    CHECK(3 == u32_gc_width_with_policy(codepoints, u32.size(), GC_WIDTH_MODE_MODIFIABLE, nullptr));
+    CHECK(5 == u8_gc_width_with_policy(u8.data(), u8.size(), GC_WIDTH_MODE_MODIFIABLE, policy));
+    CHECK(3 == u8_gc_width(u8.data(), u8.size(), GC_WIDTH_MODE_MODIFIABLE));
+
+    u8_scanner_t scanner = u8_scanner_create();
+    u8_scanner_set_width_policy(scanner, policy);
+    CHECK(u8_scanner_feed(scanner, u8.data(), u8.size(), 80, nullptr).columns == 5);
+    u8_scanner_reset(scanner);
+    CHECK(u8_scanner_feed(scanner, u8.data(), u8.size(), 80, nullptr).columns == 5);
+    u8_scanner_set_width_policy(scanner, nullptr);
+    u8_scanner_reset(scanner);
+    CHECK(u8_scanner_feed(scanner, u8.data(), u8.size(), 80, nullptr).columns == 3);
+    u8_scanner_destroy(&scanner);
+
+    gc_width_policy_destroy(&policy);
+    CHECK(policy == nullptr);
+
+    auto const invalid = std::array { gc_width_override_t { 0xE000, 0xF8FF, 4 } };
+    CHECK(gc_width_policy_create(1, invalid.data(), invalid.size()) == nullptr);
+    CHECK(gc_width_policy_create(3, nullptr, 0) == nullptr);
+}
+
 // TODO more C-API tests
@@ -0,0 +1,336 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/case_mapping.h>
+#include <libunicode/intrinsics.h>
+#include <libunicode/ucd.h>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+namespace unicode
+{
+
+namespace
+{
+    constexpr char32_t CapitalSigma = 0x03A3;    // NOLINT(readability-identifier-naming)
+    constexpr char32_t SmallFinalSigma = 0x03C2; // NOLINT(readability-identifier-naming)
+
+    struct decoded_codepoint
+    {
+        char32_t value;
+        size_t length;
+        bool valid;
+    };
+
+    decoded_codepoint decode_at(std::string_view text, size_t offset) noexcept
+    {
+        auto const sequence = decode_utf8_sequence(text.substr(offset));
+        return { sequence.value, sequence.length, sequence.status == ConversionStatus::Success };
+    }
+
+    decoded_codepoint decode_at(std::u32string_view text, size_t offset) noexcept
+    {
+        return { text[offset], 1, text[offset] <= 0x10FFFF };
+    }
+
+    /// Decodes the codepoint in front of @p offset, moving @p offset to its start.
+    std::optional<char32_t> decode_before(std::string_view text, size_t& offset) noexcept
+    {
+        auto start = offset - 1;
+        while (start > 0 && offset - start < 4 && (static_cast<uint8_t>(text[start]) & 0xC0) == 0x80)
+            --start;
+        auto const sequence = decode_utf8_sequence(text.substr(start, offset - start));
+        if (sequence.status != ConversionStatus::Success || sequence.length != offset - start)
+            return std::nullopt;
+        offset = start;
+        return sequence.value;
+    }
+
+    std::optional<char32_t> decode_before(std::u32string_view text, size_t& offset) noexcept
+    {
+        return text[--offset];
+    }
+
+    /// Tests the Final_Sigma condition of table 3-17 of the Unicode Standard for the codepoint at
+    /// @p offset of @p length code units, where ill-formed sequences are neither cased nor case-ignorable.
+    template <typename Char>
+    bool is_final_sigma(std::basic_string_view<Char> text, size_t offset, size_t length) noexcept
+    {
+        auto precededByCased = false;
+        for (auto i = offset; i > 0;)
+        {
+            auto const codepoint = decode_before(text, i);
+            if (!codepoint.has_value())
+                return false;
+            if (!contains(Core_Property::Case_Ignorable, *codepoint))
+            {
+                precededByCased = contains(Core_Property::Cased, *codepoint);
+                break;
+            }
+        }
+        if (!precededByCased)
+            return false;
+
+        for (auto i = offset + length; i < text.size();)
+        {
+            auto const next = decode_at(text, i);
+            if (!next.valid)
+                return true;
+            if (!contains(Core_Property::Case_Ignorable, next.value))
+                return !contains(Core_Property::Cased, next.value);
+            i += next.length;
+        }
+        return true;
+    }
+
+    char ascii_converted(char ch, case_conversion conversion) noexcept
+    {
+        if (conversion == case_conversion::Uppercase)
+            return 'a' <= ch && ch <= 'z' ? static_cast<char>(ch - 0x20) : ch;
+        return 'A' <= ch && ch <= 'Z' ? static_cast<char>(ch + 0x20) : ch;
+    }
+
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+    /// Case converts 16 US-ASCII bytes at once, by flipping the case bit of the letters from
+    /// @p first to @p first + 25.
+    intrinsics::m128i ascii_converted(intrinsics::m128i bytes, char first) noexcept
+    {
+        auto const belowFirst = intrinsics::compare_less(bytes, intrinsics::set1_epi8(first));
+        auto const end = intrinsics::set1_epi8(static_cast<char>(first + 26));
+        auto const belowLast = intrinsics::compare_less(bytes, end);
+        auto const letters = intrinsics::xor128(belowFirst, belowLast);
+        return intrinsics::xor128(bytes, intrinsics::and128(letters, intrinsics::set1_epi8(0x20)));
+    }
+#endif
+
+    /// The case converted codepoint, being either the full mapping, if not empty, or the simple one.
+    struct converted_codepoint
+    {
+        std::u32string_view full;
+        char32_t simple;
+    };
+
+    converted_codepoint case_converted(char32_t codepoint, case_conversion conversion) noexcept
+    {
+        switch (conversion)
+        {
+            case case_conversion::Lowercase:
+                return { full_lowercase_mapping(codepoint), simple_lowercase_mapping(codepoint) };
+            case case_conversion::Uppercase:
+                return { full_uppercase_mapping(codepoint), simple_uppercase_mapping(codepoint) };
+            case case_conversion::Folding:
+                return { full_case_folding(codepoint), simple_case_folding(codepoint) };
+        }
+        return { {}, codepoint };
+    }
+
+    size_t encode(char32_t codepoint, char* output) noexcept
+    {
+        return static_cast<size_t>(encoder<char> {}(codepoint, output) - output);
+    }
+
+    size_t encode(char32_t codepoint, char32_t* output) noexcept
+    {
+        *output = codepoint;
+        return 1;
+    }
+
+    /// Output of convert(), writing to a caller provided buffer until it is full.
+    template <typename Char>
+    class buffer_output
+    {
+      public:
+        explicit buffer_output(std::span<Char> output) noexcept: _output { output } {}
+
+        [[nodiscard]] size_t written() const noexcept { return _written; }
+
+        /// @returns the storage for the next @p count code units, or nullptr if the buffer is full.
+        Char* allocate(size_t count) noexcept
+        {
+            if (_output.size() - _written < count)
+                return nullptr;
+            _written += count;
+            return _output.data() + _written - count;
+        }
+
+      private:
+        std::span<Char> _output;
+        size_t _written = 0;
+    };
+
+    /// Output of convert(), only counting the code units written to it.
+    template <typename Char>
+    class counting_output
+    {
+      public:
+        [[nodiscard]] size_t written() const noexcept { return _written; }
+
+        Char* allocate(size_t count) noexcept
+        {
+            _written += count;
+            return _scratch.data();
+        }
+
+      private:
+        std::array<Char, 16> _scratch {};
+        size_t _written = 0;
+    };
+
+    /// Case converts @p input into @p output.
+    ///
+    /// @returns the number of code units of @p input consumed.
+    template <typename Char, typename Output>
+    size_t convert(std::basic_string_view<Char> input, case_conversion conversion, Output& output) noexcept
+    {
+        size_t i = 0;
+        while (i < input.size())
+        {
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+            if constexpr (sizeof(Char) == 1)
+            {
+                auto constexpr BlockSize = sizeof(intrinsics::m128i);
+                if (i + BlockSize <= input.size())
+                {
+                    auto const* const source = (intrinsics::m128i const*) (input.data() + i);
+                    auto const bytes = intrinsics::load_unaligned(source);
+                    if (intrinsics::movemask_epi8(bytes) == 0)
+                    {
+                        auto* const target = output.allocate(BlockSize);
+                        if (!target)
+                            break;
+                        auto const first = conversion == case_conversion::Uppercase ? 'a' : 'A';
+                        intrinsics::store_unaligned((intrinsics::m128i*) target,
+                                                    ascii_converted(bytes, first));
+                        i += BlockSize;
+                        continue;
+                    }
+                }
+            }
+#endif
+
+            if (static_cast<uint32_t>(input[i]) < 0x80)
+            {
+                auto* const target = output.allocate(1);
+                if (!target)
+                    break;
+                *target = static_cast<Char>(ascii_converted(static_cast<char>(input[i]), conversion));
+                ++i;
+                continue;
+            }
+
+            auto const current = decode_at(input, i);
+            if (!current.valid)
+            {
+                auto* const target = output.allocate(current.length);
+                if (!target)
+                    break;
+                std::copy_n(input.data() + i, current.length, target);
+                i += current.length;
+                continue;
+            }
+
+            auto units = std::array<Char, 12> {};
+            size_t count = 0;
+            if (conversion == case_conversion::Lowercase && current.value == CapitalSigma
+                && is_final_sigma(input, i, current.length))
+                count = encode(SmallFinalSigma, units.data());
+            else if (auto const converted = case_converted(current.value, conversion); converted.full.empty())
+                count = encode(converted.simple, units.data());
+            else
+                for (auto const codepoint: converted.full)
+                    count += encode(codepoint, units.data() + count);
+
+            auto* const target = output.allocate(count);
+            if (!target)
+                break;
+            std::copy_n(units.data(), count, target);
+            i += current.length;
+        }
+        return i;
+    }
+
+    template <typename Char>
+    std::basic_string<Char> converted(std::basic_string_view<Char> text, case_conversion conversion)
+    {
+        auto result = std::basic_string<Char>(case_converted_length(text, conversion), Char {});
+        auto output = buffer_output<Char> { result };
+        convert(text, conversion, output);
+        return result;
+    }
+} // namespace
+
+size_t case_converted_length(std::string_view input, case_conversion conversion) noexcept
+{
+    auto output = counting_output<char> {};
+    convert(input, conversion, output);
+    return output.written();
+}
+
+size_t case_converted_length(std::u32string_view input, case_conversion conversion) noexcept
+{
+    auto output = counting_output<char32_t> {};
+    convert(input, conversion, output);
+    return output.written();
+}
+
+conversion_result convert_case(std::string_view input,
+                               std::span<char> output,
+                               case_conversion conversion) noexcept
+{
+    auto target = buffer_output<char> { output };
+    auto const consumed = convert(input, conversion, target);
+    return { consumed, target.written(), ConversionStatus::Success };
+}
+
+conversion_result convert_case(std::u32string_view input,
+                               std::span<char32_t> output,
+                               case_conversion conversion) noexcept
+{
+    auto target = buffer_output<char32_t> { output };
+    auto const consumed = convert(input, conversion, target);
+    return { consumed, target.written(), ConversionStatus::Success };
+}
+
+std::string to_lower(std::string_view text)
+{
+    return converted(text, case_conversion::Lowercase);
+}
+
+std::u32string to_lower(std::u32string_view text)
+{
+    return converted(text, case_conversion::Lowercase);
+}
+
+std::string to_upper(std::string_view text)
+{
+    return converted(text, case_conversion::Uppercase);
+}
+
+std::u32string to_upper(std::u32string_view text)
+{
+    return converted(text, case_conversion::Uppercase);
+}
+
+std::string case_fold(std::string_view text)
+{
+    return converted(text, case_conversion::Folding);
+}
+
+std::u32string case_fold(std::u32string_view text)
+{
+    return converted(text, case_conversion::Folding);
+}
+
+} // namespace unicode
@@ -0,0 +1,81 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/convert.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace unicode
+{
+
+/// The default case conversions, as per section 3.13 "Default Case Algorithms" of the Unicode Standard.
+///
+/// These use the full (possibly expanding) mappings, but none of the language-specific ones.
+enum class case_conversion : uint8_t
+{
+    /// toLowercase(X), including the Final_Sigma condition.
+    Lowercase,
+    /// toUppercase(X).
+    Uppercase,
+    /// toCasefold(X), for caseless matching.
+    Folding,
+};
+
+/// Returns the maximum number of code units @p size UTF-8 bytes or UTF-32 codepoints can be
+/// case converted to.
+constexpr size_t max_case_converted_length(size_t size) noexcept
+{
+    return 3 * size;
+}
+
+/// Returns the number of UTF-8 bytes the UTF-8 @p input is case converted to,
+/// e.g. to size the output buffer of convert_case().
+[[nodiscard]] size_t case_converted_length(std::string_view input, case_conversion conversion) noexcept;
+
+/// Returns the number of codepoints the UTF-32 @p input is case converted to.
+[[nodiscard]] size_t case_converted_length(std::u32string_view input, case_conversion conversion) noexcept;
+
+/// Case converts UTF-8 @p input, writing to the caller provided @p output buffer.
+///
+/// Ill-formed UTF-8 sequences are copied unchanged. Conversion stops early, at a codepoint boundary,
+/// when @p output is full. Use case_converted_length() or max_case_converted_length() to size it for
+/// converting all of @p input at once. The Final_Sigma condition only takes @p input into account.
+///
+/// Runs of US-ASCII characters are converted 16 bytes at a time, where SIMD is available.
+conversion_result convert_case(std::string_view input,
+                               std::span<char> output,
+                               case_conversion conversion) noexcept;
+
+/// Same as convert_case(std::string_view, std::span<char>, case_conversion), but for UTF-32.
+///
+/// Values that are not codepoints are copied unchanged.
+conversion_result convert_case(std::u32string_view input,
+                               std::span<char32_t> output,
+                               case_conversion conversion) noexcept;
+
+[[nodiscard]] std::string to_lower(std::string_view text);
+[[nodiscard]] std::u32string to_lower(std::u32string_view text);
+
+[[nodiscard]] std::string to_upper(std::string_view text);
+[[nodiscard]] std::u32string to_upper(std::u32string_view text);
+
+[[nodiscard]] std::string case_fold(std::string_view text);
+[[nodiscard]] std::u32string case_fold(std::u32string_view text);
+
+} // namespace unicode
@@ -0,0 +1,133 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/case_mapping.h>
+#include <libunicode/convert.h>
+#include <libunicode/ucd.h>
+
+#include <fmt/format.h>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+
+using namespace std::string_view_literals;
+using unicode::case_conversion;
+
+TEST_CASE("case_mapping.ucd", "[case_mapping]")
+{
+    CHECK(unicode::simple_lowercase_mapping(U'A') == U'a');
+    CHECK(unicode::simple_lowercase_mapping(U'a') == U'a');
+    CHECK(unicode::simple_lowercase_mapping(U'\u0130') == U'i');
+    CHECK(unicode::simple_lowercase_mapping(U'\u10A0') == U'\u2D00');
+    CHECK(unicode::simple_lowercase_mapping(U'\U00010400') == U'\U00010428');
+    CHECK(unicode::simple_uppercase_mapping(U'\u00DF') == U'\u00DF');
+    CHECK(unicode::simple_uppercase_mapping(U'\u00FF') == U'\u0178');
+    CHECK(unicode::simple_case_folding(U'\u212A') == U'k');
+    CHECK(unicode::simple_case_folding(U'\u1E9E') == U'\u00DF');
+    CHECK(unicode::simple_case_folding(U'1') == U'1');
+
+    CHECK(unicode::full_lowercase_mapping(U'A').empty());
+    CHECK(unicode::full_lowercase_mapping(U'\u0130') == U"i\u0307");
+    CHECK(unicode::full_uppercase_mapping(U'\u00DF') == U"SS");
+    CHECK(unicode::full_uppercase_mapping(U'\uFB03') == U"FFI");
+    CHECK(unicode::full_case_folding(U'\u1E9E') == U"ss");
+    CHECK(unicode::full_case_folding(U'\u212A').empty());
+}
+
+TEST_CASE("case_mapping.ascii", "[case_mapping]")
+{
+    // Longer than a SIMD block, including the characters around the letters.
+    auto const text = "@AZ[`az{ Hello, World! 0123 The quick brown fox jumps over the lazy dog."sv;
+    CHECK(unicode::to_lower(text)
+          == "@az[`az{ hello, world! 0123 the quick brown fox jumps over the lazy dog.");
+    CHECK(unicode::to_upper(text)
+          == "@AZ[`AZ{ HELLO, WORLD! 0123 THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG.");
+    CHECK(unicode::case_fold(text) == unicode::to_lower(text));
+    CHECK(unicode::to_upper(U"Hello, World!"sv) == U"HELLO, WORLD!");
+    CHECK(unicode::to_lower(""sv).empty());
+}
+
+TEST_CASE("case_mapping.full", "[case_mapping]")
+{
+    CHECK(unicode::to_upper(U"stra\u00DFe"sv) == U"STRASSE");
+    CHECK(unicode::case_fold(U"Stra\u00DFe"sv) == U"strasse");
+    CHECK(unicode::case_fold(U"STRASSE"sv) == U"strasse");
+    CHECK(unicode::to_lower(U"\u0130stanbul"sv) == U"i\u0307stanbul");
+    CHECK(unicode::to_upper(U"\u0390"sv) == U"\u0399\u0308\u0301");
+    CHECK(unicode::to_lower(U"\u03A9\u212B"sv) == U"\u03C9\u00E5");
+    CHECK(unicode::case_fold(U"\u13F8"sv) == U"\u13F0");
+
+    CHECK(unicode::to_upper("Ma\xC3\x9F bitte, \xC3\xA9t\xC3\xA9"sv) == "MASS BITTE, \xC3\x89T\xC3\x89");
+    CHECK(unicode::to_lower("\xF0\x90\x90\x80"sv) == "\xF0\x90\x90\xA8");
+}
+
+TEST_CASE("case_mapping.final_sigma", "[case_mapping]")
+{
+    CHECK(unicode::to_lower(U"\u039F\u0394\u039F\u03A3"sv) == U"\u03BF\u03B4\u03BF\u03C2");
+    CHECK(unicode::to_lower(U"\u039F\u0394\u039F\u03A3 \u03A3\u039F"sv)
+          == U"\u03BF\u03B4\u03BF\u03C2 \u03C3\u03BF");
+    CHECK(unicode::to_lower(U"\u03A3"sv) == U"\u03C3");
+    CHECK(unicode::to_lower(U"A\u03A3."sv) == U"a\u03C2.");
+    CHECK(unicode::to_lower(U"A.\u03A3'"sv) == U"a.\u03C2'");
+    CHECK(unicode::to_lower(U"A\u03A3'a"sv) == U"a\u03C3'a");
+    CHECK(unicode::to_lower("A\xCE\xA3"sv) == "a\xCF\x82");
+    CHECK(unicode::to_lower("\xFF\xCE\xA3"sv) == "\xFF\xCF\x83");
+    CHECK(unicode::case_fold(U"A\u03A3"sv) == U"a\u03C3");
+}
+
+TEST_CASE("case_mapping.ill_formed", "[case_mapping]")
+{
+    CHECK(unicode::to_lower("\xFF" "A\xC3" "B\xE2\x82"sv) == "\xFF" "a\xC3" "b\xE2\x82");
+    CHECK(unicode::to_upper(U"a\xD800" "b\x110000"sv) == U"A\xD800" "B\x110000");
+}
+
+TEST_CASE("case_mapping.convert_case", "[case_mapping]")
+{
+    auto const input = "stra\xC3\x9F" "e"sv;
+    CHECK(unicode::case_converted_length(input, case_conversion::Uppercase) == 7);
+    CHECK(unicode::case_converted_length(input, case_conversion::Lowercase) == input.size());
+
+    // Stops in front of a codepoint that does not fit into the output buffer.
+    auto output = std::array<char, 5> {};
+    auto const result = unicode::convert_case(input, output, case_conversion::Uppercase);
+    CHECK(result.consumed == 4);
+    CHECK(result.written == 4);
+    CHECK(result.status == unicode::ConversionStatus::Success);
+    CHECK(std::string_view(output.data(), result.written) == "STRA");
+
+    auto const rest =
+        unicode::convert_case(input.substr(result.consumed), output, case_conversion::Uppercase);
+    CHECK(rest.consumed == 3);
+    CHECK(std::string_view(output.data(), rest.written) == "SSE");
+}
+
+TEST_CASE("case_mapping.max_length", "[case_mapping]")
+{
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+    {
+        auto const utf32 = std::u32string_view(&codepoint, 1);
+        auto const utf8 = unicode::convert_to<char>(utf32);
+        for (auto const conversion:
+             { case_conversion::Lowercase, case_conversion::Uppercase, case_conversion::Folding })
+        {
+            if (unicode::case_converted_length(utf32, conversion) > unicode::max_case_converted_length(1))
+                FAIL(fmt::format("U+{:04X} exceeds the max UTF-32 length", static_cast<uint32_t>(codepoint)));
+            auto const maxLength = unicode::max_case_converted_length(utf8.size());
+            if (unicode::case_converted_length(utf8, conversion) > maxLength)
+                FAIL(fmt::format("U+{:04X} exceeds the max UTF-8 length", static_cast<uint32_t>(codepoint)));
+        }
+    }
+}
@@ -13,18 +13,307 @@
  */
 #include <libunicode/codepoint_properties.h>
 #include <libunicode/codepoint_properties_data.h>
+#include <libunicode/intrinsics.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+// AVX2 gather instructions are opt-in (LIBUNICODE_USE_GATHER), because on many microarchitectures
+// they are not faster than (or even slower than) the equivalent sequence of scalar loads.
+#if defined(LIBUNICODE_USE_GATHER) && (defined(__x86_64__) || defined(_M_AMD64))
+    #define LIBUNICODE_GATHER_AVX2 1
+#endif
 
 namespace unicode
 {
 
-codepoint_properties::tables_view codepoint_properties::configured_tables { precompiled::stage1.data(),
-                                                                            precompiled::stage2.data(),
-                                                                            precompiled::properties.data() };
-
-codepoint_properties::names_view codepoint_properties::configured_names {
-    precompiled::names_stage1.data(),
-    precompiled::names_stage2.data(),
-    precompiled::names_stage3.data(),
+property_tables const property_tables::precompiled {
+    {
+        unicode::precompiled::stage1.data(),
+        unicode::precompiled::stage2.data(),
+        unicode::precompiled::properties.data(),
+        unicode::precompiled::properties_direct.data(),
+    },
+    {
+        unicode::precompiled::stage1.data(),
+        unicode::precompiled::stage2.data(),
+        unicode::precompiled::narrow_properties.data(),
+        unicode::precompiled::narrow_properties_direct.data(),
+    },
+    {
+        {
+            unicode::precompiled::names_stage1.data(),
+            unicode::precompiled::names_stage2.data(),
+            unicode::precompiled::names_stage3.data(),
+        },
+        unicode::precompiled::names_data.data(),
+        unicode::precompiled::names_word_offsets.data(),
+        reinterpret_cast<char const*>(precompiled::names_words.data()),
+    },
+    {
+        unicode::precompiled::stage1.data(),
+        unicode::precompiled::stage2.data(),
+        unicode::precompiled::scripts.data(),
+        unicode::precompiled::scripts_direct.data(),
+    },
+    unicode::precompiled::script_sets.data(),
+    {
+        unicode::precompiled::stage1.data(),
+        unicode::precompiled::stage2.data(),
+        unicode::precompiled::breaks.data(),
+        unicode::precompiled::breaks_direct.data(),
+    },
+    {
+        unicode::precompiled::stage1.data(),
+        unicode::precompiled::stage2.data(),
+        unicode::precompiled::normalization.data(),
+        unicode::precompiled::normalization_direct.data(),
+    },
+    {
+        unicode::precompiled::identifier_stage1.data(),
+        unicode::precompiled::identifier_blocks.data(),
+    },
 };
 
+std::atomic<property_tables const*> property_tables::_current { &property_tables::precompiled };
+
+// {{{ codepoint_names_view
+namespace
+{
+    // Jamo short names, as used for the Hangul syllable name generation (Unicode, chapter 3.12).
+    constexpr char JamoLeading[19][3] = { "G", "GG", "N", "D", "DD", "R", "M", "B", "BB", "S",
+                                          "SS", "", "J", "JJ", "C", "K", "T", "P", "H" };
+    constexpr char JamoVowel[21][4] = { "A",  "AE", "YA", "YAE", "EO", "E",  "YEO", "YE", "O",  "WA", "WAE",
+                                        "OE", "YO", "U",  "WEO", "WE", "WI", "YU",  "EU", "YI", "I" };
+    constexpr char JamoTrailing[28][3] = { "",  "G",  "GG", "GS", "N",  "NJ", "NH", "D",  "L",  "LG",
+                                           "LM", "LB", "LS", "LT", "LP", "LH", "M",  "B",  "BS", "S",
+                                           "SS", "NG", "J",  "C",  "K",  "T",  "P",  "H" };
+} // namespace
+
+std::string_view codepoint_names_view::get(char32_t codepoint, std::span<char> buffer) const noexcept
+{
+    size_t length = 0;
+    auto const append = [&](std::string_view text) noexcept {
+        auto const count = std::min(text.size(), buffer.size() - length);
+        std::copy_n(text.data(), count, buffer.data() + length);
+        length += count;
+    };
+
+    auto const* encoded = names + index.get(codepoint);
+    auto const header = *encoded++;
+    for (unsigned i = 0; i < (header & TokenCountMask); ++i)
+    {
+        size_t word = *encoded++;
+        if (word & WideWordIndexFlag)
+            word = ((word & ~size_t { WideWordIndexFlag }) << 8) | *encoded++;
+        if (i != 0)
+            append(" ");
+        append(std::string_view(words + word_offsets[word], word_offsets[word + 1] - word_offsets[word]));
+    }
+
+    if (header & FlagHexSuffix)
+    {
+        auto constexpr Digits = std::string_view("0123456789ABCDEF");
+        char hex[8];
+        size_t digits = 0;
+        for (auto value = static_cast<uint32_t>(codepoint); value != 0 || digits < 4; value >>= 4)
+            hex[digits++] = Digits[value & 0xF];
+        std::reverse(hex, hex + digits);
+        append(std::string_view(hex, digits));
+    }
+    else if ((header & FlagHangulSyllable) && 0xAC00 <= codepoint && codepoint <= 0xD7A3)
+    {
+        auto constexpr VowelCount = 21;
+        auto constexpr TrailingCount = 28;
+        auto const syllable = static_cast<uint32_t>(codepoint) - 0xAC00;
+        append(JamoLeading[syllable / (VowelCount * TrailingCount)]);
+        append(JamoVowel[(syllable % (VowelCount * TrailingCount)) / TrailingCount]);
+        append(JamoTrailing[syllable % TrailingCount]);
+    }
+
+    return std::string_view(buffer.data(), length);
+}
+
+std::string codepoint_names_view::get(char32_t codepoint) const
+{
+    char buffer[MaxNameLength];
+    return std::string(get(codepoint, buffer));
+}
+// }}}
+
+namespace
+{
+    // {{{ bulk lookup implementations
+    void get_many_scalar(char32_t const* in, size_t count, codepoint_properties* out) noexcept
+    {
+        codepoint_properties::configured_tables().get_many(in, count, out);
+    }
+
+    void get_char_widths_scalar(char32_t const* in, size_t count, uint8_t* out) noexcept
+    {
+        codepoint_properties::configured_tables().get_many(
+            in, count, out, [](codepoint_properties const& properties) { return properties.char_width; });
+    }
+
+    void get_grapheme_cluster_breaks_scalar(char32_t const* in,
+                                            size_t count,
+                                            Grapheme_Cluster_Break* out) noexcept
+    {
+        codepoint_properties::configured_tables().get_many(
+            in, count, out, [](codepoint_properties const& properties) {
+                return properties.grapheme_cluster_break;
+            });
+    }
+
+#if defined(LIBUNICODE_GATHER_AVX2)
+    using tables_view = codepoint_properties::tables_view;
+
+    // The gather based lookups below support power-of-two block sizes and 8-bit or 16-bit stage elements.
+    static_assert(std::has_single_bit(tables_view::block_size));
+    static_assert(sizeof(codepoint_properties) == 8);
+
+    constexpr int BlockShift = std::countr_zero(tables_view::block_size);
+
+    // Gathers the 8-bit or 16-bit table elements at the given 8 indices.
+    //
+    // The gather instructions load 32-bit words. In order to never read past the end of the narrower
+    // tables, the aligned 32-bit word containing the element is loaded, and the element is then
+    // shifted out of it. This works because the tables' sizes in bytes are a multiple of 4.
+    template <typename Element>
+    LIBUNICODE_TARGET("avx2") __m256i gather_elements_avx2(Element const* table, __m256i indices) noexcept
+    {
+        static_assert(sizeof(Element) == 1 || sizeof(Element) == 2);
+        auto const three = _mm256_set1_epi32(3);
+        auto const offsets = _mm256_slli_epi32(indices, sizeof(Element) - 1);
+        auto const words = _mm256_i32gather_epi32(
+            reinterpret_cast<int const*>(table), _mm256_andnot_si256(three, offsets), 1);
+        return _mm256_and_si256(_mm256_srlv_epi32(words, _mm256_slli_epi32(_mm256_and_si256(offsets, three), 3)),
+                                _mm256_set1_epi32((1 << (8 * sizeof(Element))) - 1));
+    }
+
+    // Resolves 8 codepoints to their index into stage 3.
+    LIBUNICODE_TARGET("avx2") __m256i property_indices_avx2(tables_view const& tables, char32_t const* in) noexcept
+    {
+        auto codepoints = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in));
+
+        // Out of range codepoints resolve to U+0000, just like tables_view::get() does.
+        auto const valid = _mm256_cmpeq_epi32(_mm256_min_epu32(codepoints, _mm256_set1_epi32(0x10FFFF)), codepoints);
+        codepoints = _mm256_and_si256(codepoints, valid);
+
+        // stage 1: block number = stage1[codepoint / block_size]
+        auto const blockNumber = gather_elements_avx2(tables.stage1, _mm256_srli_epi32(codepoints, BlockShift));
+
+        // stage 2: property index = stage2[block number * block_size + codepoint % block_size]
+        auto const stage2Index =
+            _mm256_or_si256(_mm256_slli_epi32(blockNumber, BlockShift),
+                            _mm256_and_si256(codepoints, _mm256_set1_epi32(tables_view::block_size - 1)));
+        return gather_elements_avx2(tables.stage2, stage2Index);
+    }
+
+    // Stores the lowest byte of each of the 8 32-bit lanes of v into out[0..7].
+    LIBUNICODE_TARGET("avx2") void store_low_bytes_avx2(__m256i v, void* out) noexcept
+    {
+        // clang-format off
+        auto const shuffle = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                              0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        // clang-format on
+        auto const packed =
+            _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, shuffle), _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+        _mm_storel_epi64(static_cast<__m128i*>(out), _mm256_castsi256_si128(packed));
+    }
+
+    // Gathers a single byte member (at the given offset) of the codepoint properties of 8 codepoints.
+    LIBUNICODE_TARGET("avx2")
+    void gather_member_avx2(tables_view const& tables, char32_t const* in, size_t offset, void* out) noexcept
+    {
+        auto const indices = property_indices_avx2(tables, in);
+        auto const base = reinterpret_cast<char const*>(tables.stage3) + offset;
+        store_low_bytes_avx2(_mm256_i32gather_epi32(reinterpret_cast<int const*>(base), indices, 8), out);
+    }
+
+    LIBUNICODE_TARGET("avx2") void get_many_avx2(char32_t const* in, size_t count, codepoint_properties* out) noexcept
+    {
+        auto const& tables = codepoint_properties::configured_tables();
+        auto const base = reinterpret_cast<long long const*>(tables.stage3);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto const indices = property_indices_avx2(tables, in + i);
+            auto const low = _mm256_i32gather_epi64(base, _mm256_castsi256_si128(indices), 8);
+            auto const high = _mm256_i32gather_epi64(base, _mm256_extracti128_si256(indices, 1), 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), low);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4), high);
+        }
+        get_many_scalar(in + i, count - i, out + i);
+    }
+
+    LIBUNICODE_TARGET("avx2") void get_char_widths_avx2(char32_t const* in, size_t count, uint8_t* out) noexcept
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            gather_member_avx2(
+                codepoint_properties::configured_tables(), in + i, offsetof(codepoint_properties, char_width), out + i);
+        get_char_widths_scalar(in + i, count - i, out + i);
+    }
+
+    LIBUNICODE_TARGET("avx2")
+    void get_grapheme_cluster_breaks_avx2(char32_t const* in, size_t count, Grapheme_Cluster_Break* out) noexcept
+    {
+        static_assert(sizeof(Grapheme_Cluster_Break) == 1);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            gather_member_avx2(codepoint_properties::configured_tables(),
+                               in + i,
+                               offsetof(codepoint_properties, grapheme_cluster_break),
+                               out + i);
+        get_grapheme_cluster_breaks_scalar(in + i, count - i, out + i);
+    }
+#endif
+
+    template <typename F>
+    F select(F scalar, [[maybe_unused]] F avx2) noexcept
+    {
+#if defined(LIBUNICODE_GATHER_AVX2)
+        if (cpu_supports_avx2())
+            return avx2;
+#endif
+        return scalar;
+    }
+    // }}}
+} // namespace
+
+void codepoint_properties::get_many(char32_t const* in, size_t count, codepoint_properties* out) noexcept
+{
+#if defined(LIBUNICODE_GATHER_AVX2)
+    static auto const impl = select(&get_many_scalar, &get_many_avx2);
+#else
+    static auto const impl = &get_many_scalar;
+#endif
+    impl(in, count, out);
+}
+
+void codepoint_properties::get_char_widths(char32_t const* in, size_t count, uint8_t* out) noexcept
+{
+#if defined(LIBUNICODE_GATHER_AVX2)
+    static auto const impl = select(&get_char_widths_scalar, &get_char_widths_avx2);
+#else
+    static auto const impl = &get_char_widths_scalar;
+#endif
+    impl(in, count, out);
+}
+
+void codepoint_properties::get_grapheme_cluster_breaks(char32_t const* in,
+                                                       size_t count,
+                                                       Grapheme_Cluster_Break* out) noexcept
+{
+#if defined(LIBUNICODE_GATHER_AVX2)
+    static auto const impl = select(&get_grapheme_cluster_breaks_scalar, &get_grapheme_cluster_breaks_avx2);
+#else
+    static auto const impl = &get_grapheme_cluster_breaks_scalar;
+#endif
+    impl(in, count, out);
+}
+
 } // namespace unicode
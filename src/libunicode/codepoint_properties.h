@@ -18,11 +18,66 @@
 #include <libunicode/support.h>   // Only for LIBUNICODE_PACKED.
 #include <libunicode/ucd_enums.h> // Only for the UCD enums.
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
 namespace unicode
 {
 
+/// Compressed codepoint names.
+///
+/// Each distinct name is stored as a sequence of indices into a dictionary of words,
+/// with the words joined by a single space when decoding.
+/// An encoded name starts with a header byte, holding the number of words (TokenCountMask)
+/// and whether the name ends with an algorithmically derived suffix:
+/// the codepoint in hexadecimal (FlagHexSuffix, e.g. "CJK UNIFIED IDEOGRAPH-4E00"),
+/// or the syllable's Jamo short names (FlagHangulSyllable, "HANGUL SYLLABLE GAG").
+/// A word index below 0x80 is stored in one byte, larger ones in two bytes, most significant first,
+/// with the highest bit of the first byte set.
+///
+/// None of the tables contain pointers, so that they need no relocations when loading the library.
+struct codepoint_names_view
+{
+    static uint8_t constexpr TokenCountMask = 0x3F;      // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagHexSuffix = 0x40;       // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagHangulSyllable = 0x80;  // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr WideWordIndexFlag = 0x80;   // NOLINT(readability-identifier-naming)
+    static size_t constexpr MaxWordCount = 0x8000;       // NOLINT(readability-identifier-naming)
+
+    /// No codepoint name is longer than this. A buffer of this size therefore fits any name.
+    static size_t constexpr MaxNameLength = 128; // NOLINT(readability-identifier-naming)
+
+    /// Maps a codepoint to the offset of its encoded name in @c names.
+    using index_view = support::multistage_table_view<uint32_t,
+                                                      uint32_t,     // source type
+                                                      uint8_t,      // stage 1
+                                                      uint16_t,     // stage 2
+                                                      256,          // block size
+                                                      0x110'000 - 1 // max value
+                                                      >;
+
+    index_view index;
+    uint8_t const* names;         // encoded names
+    uint32_t const* word_offsets; // (number of words + 1) offsets into words
+    char const* words;            // all words, concatenated
+
+    /// Decodes the name of the given codepoint into @p buffer, truncating it if it does not fit.
+    ///
+    /// @returns the name, pointing into @p buffer, or an empty string if the codepoint has no name.
+    std::string_view get(char32_t codepoint, std::span<char> buffer) const noexcept;
+
+    /// Decodes the name of the given codepoint.
+    std::string get(char32_t codepoint) const;
+};
+
 struct LIBUNICODE_PACKED codepoint_properties
 {
     uint8_t char_width = 0;
@@ -32,7 +87,10 @@ struct LIBUNICODE_PACKED codepoint_properties
     East_Asian_Width east_asian_width = East_Asian_Width::Narrow;
     General_Category general_category = General_Category::Unassigned;
     EmojiSegmentationCategory emoji_segmentation_category = EmojiSegmentationCategory::Invalid;
-    Age age = Age::Unassigned;
+
+    // Age and Vertical_Orientation share a byte, keeping the properties at 8 bytes.
+    Age age : 6 = Age::Unassigned;
+    Vertical_Orientation vertical_orientation : 2 = Vertical_Orientation::Rotated;
 
     static uint8_t constexpr FlagEmoji = 0x01;                // NOLINT(readability-identifier-naming)
     static uint8_t constexpr FlagEmojiPresentation = 0x02;    // NOLINT(readability-identifier-naming)
@@ -50,36 +108,516 @@ struct LIBUNICODE_PACKED codepoint_properties
     constexpr bool extended_pictographic() const noexcept { return flags & FlagExtendedPictographic; }
     constexpr bool core_grapheme_extend() const noexcept { return flags & FlagCoreGraphemeExtend; }
 
+    /// Codepoints below this value (U+0000..U+07FF, i.e. all 1- and 2-byte UTF-8 sequences)
+    /// are looked up in a flat table, rather than walking through all table stages.
+    static constexpr uint32_t direct_size = 0x800;
+
     using tables_view = support::multistage_table_view<codepoint_properties,
-                                                       uint32_t,     // source type
-                                                       uint8_t,      // stage 1
-                                                       uint16_t,     // stage 2
-                                                       256,          // block size
-                                                       0x110'000 - 1 // max value
+                                                       uint32_t,      // source type
+                                                       uint16_t,      // stage 1
+                                                       uint16_t,      // stage 2
+                                                       128,           // block size
+                                                       0x110'000 - 1, // max value
+                                                       direct_size    // direct size
                                                        >;
 
-    using names_view = support::multistage_table_view<std::string_view,
-                                                      uint32_t,     // source type
-                                                      uint8_t,      // stage 1
-                                                      uint16_t,     // stage 2
-                                                      256,          // block size
-                                                      0x110'000 - 1 // max value
-                                                      >;
+    using names_view = codepoint_names_view;
+
+    /// The tables of the currently configured property_tables.
+    [[nodiscard]] static tables_view const& configured_tables() noexcept;
 
-    static tables_view configured_tables;
-    static names_view configured_names;
+    /// The names of the currently configured property_tables.
+    [[nodiscard]] static names_view const& configured_names() noexcept;
 
     /// Retrieves the codepoint properties for the given codepoint.
     [[nodiscard]] static codepoint_properties get(char32_t codepoint) noexcept
     {
-        return configured_tables.get(codepoint);
+        return configured_tables().get(codepoint);
+    }
+
+    /// Retrieves the codepoint properties for each of the @p count codepoints in @p in.
+    ///
+    /// This is semantically equivalent to calling get() for each codepoint, but resolves a whole
+    /// sequence (e.g. a line of text) at once, using vector gather instructions where available.
+    static void get_many(char32_t const* in, size_t count, codepoint_properties* out) noexcept;
+
+    /// Same as get_many() but only retrieving the character width of each codepoint.
+    static void get_char_widths(char32_t const* in, size_t count, uint8_t* out) noexcept;
+
+    /// Same as get_many() but only retrieving the Grapheme_Cluster_Break property of each codepoint.
+    static void get_grapheme_cluster_breaks(char32_t const* in,
+                                            size_t count,
+                                            Grapheme_Cluster_Break* out) noexcept;
+
+    /// Retrieves the name of the given codepoint, decoded into @p buffer.
+    ///
+    /// A buffer of codepoint_names_view::MaxNameLength bytes fits any name.
+    [[nodiscard]] static std::string_view name(char32_t codepoint, std::span<char> buffer) noexcept
+    {
+        return configured_names().get(codepoint, buffer);
     }
 
-    [[nodiscard]] static std::string_view name(char32_t codepoint) { return configured_names.get(codepoint); }
+    /// Retrieves the name of the given codepoint, or an empty string if it has none.
+    [[nodiscard]] static std::string name(char32_t codepoint) { return configured_names().get(codepoint); }
 };
 
 static_assert(std::has_unique_object_representations_v<codepoint_properties>);
 
+/// Compact projection of those codepoint properties that are needed on the hot paths
+/// of computing the display width and grapheme cluster segmentation, packed into a single byte.
+///
+/// Its tables share stage 1 and stage 2 with codepoint_properties::configured_tables(), but their values
+/// are only an eighth of the size, and the direct (flat) table for the low range fits into 32 cache lines.
+struct narrow_codepoint_properties
+{
+    uint8_t value = 0;
+
+    static uint8_t constexpr WidthMask = 0x03;                   // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr GraphemeClusterBreakShift = 2;      // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr GraphemeClusterBreakMask = 0x1F;    // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagExtendedPictographic = 0x80;    // NOLINT(readability-identifier-naming)
+
+    [[nodiscard]] constexpr uint8_t char_width() const noexcept { return value & WidthMask; }
+
+    [[nodiscard]] constexpr Grapheme_Cluster_Break grapheme_cluster_break() const noexcept
+    {
+        return static_cast<Grapheme_Cluster_Break>((value >> GraphemeClusterBreakShift)
+                                                   & GraphemeClusterBreakMask);
+    }
+
+    [[nodiscard]] constexpr bool extended_pictographic() const noexcept
+    {
+        return value & FlagExtendedPictographic;
+    }
+
+    [[nodiscard]] static constexpr narrow_codepoint_properties from(codepoint_properties const& properties) noexcept
+    {
+        return narrow_codepoint_properties { static_cast<uint8_t>(
+            (properties.char_width & WidthMask)
+            | (static_cast<uint8_t>(properties.grapheme_cluster_break) << GraphemeClusterBreakShift)
+            | (properties.extended_pictographic() ? FlagExtendedPictographic : 0)) };
+    }
+
+    using tables_view = support::multistage_table_view<narrow_codepoint_properties,
+                                                       uint32_t,                          // source type
+                                                       uint16_t,                          // stage 1
+                                                       uint16_t,                          // stage 2
+                                                       128,                               // block size
+                                                       0x110'000 - 1,                     // max value
+                                                       codepoint_properties::direct_size  // direct size
+                                                       >;
+
+    /// The tables of the currently configured property_tables.
+    [[nodiscard]] static tables_view const& configured_tables() noexcept;
+
+    /// Retrieves the narrow codepoint properties for the given codepoint.
+    [[nodiscard]] static narrow_codepoint_properties get(char32_t codepoint) noexcept
+    {
+        return configured_tables().get(codepoint);
+    }
+};
+
+static_assert(sizeof(narrow_codepoint_properties) == 1);
+
+/// Set of scripts, such as the Script_Extensions of a codepoint, stored as a bitset indexed by Script.
+class script_set
+{
+  public:
+    static constexpr size_t WordCount = 3; // NOLINT(readability-identifier-naming)
+    static constexpr size_t Capacity = WordCount * 64; // NOLINT(readability-identifier-naming)
+
+    constexpr script_set() noexcept = default;
+
+    constexpr explicit script_set(std::array<uint64_t, WordCount> const& words) noexcept: _words { words } {}
+
+    constexpr script_set(std::initializer_list<Script> scripts) noexcept
+    {
+        for (auto const script: scripts)
+            insert(script);
+    }
+
+    constexpr void insert(Script script) noexcept
+    {
+        auto const index = static_cast<size_t>(script);
+        _words[index / 64] |= uint64_t { 1 } << (index % 64);
+    }
+
+    constexpr void erase(Script script) noexcept
+    {
+        auto const index = static_cast<size_t>(script);
+        _words[index / 64] &= ~(uint64_t { 1 } << (index % 64));
+    }
+
+    [[nodiscard]] constexpr bool contains(Script script) const noexcept
+    {
+        auto const index = static_cast<size_t>(script);
+        return (_words[index / 64] >> (index % 64)) & 1;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return (_words[0] | _words[1] | _words[2]) == 0; }
+
+    [[nodiscard]] constexpr size_t size() const noexcept
+    {
+        return static_cast<size_t>(std::popcount(_words[0]) + std::popcount(_words[1])
+                                   + std::popcount(_words[2]));
+    }
+
+    /// @returns the script with the lowest value in this set, or Script::Invalid if it is empty.
+    [[nodiscard]] constexpr Script first() const noexcept
+    {
+        for (size_t i = 0; i < WordCount; ++i)
+            if (_words[i])
+                return static_cast<Script>(i * 64 + static_cast<size_t>(std::countr_zero(_words[i])));
+        return Script::Invalid;
+    }
+
+    [[nodiscard]] constexpr std::array<uint64_t, WordCount> const& words() const noexcept { return _words; }
+
+    constexpr script_set& operator&=(script_set const& other) noexcept
+    {
+        for (size_t i = 0; i < WordCount; ++i)
+            _words[i] &= other._words[i];
+        return *this;
+    }
+
+    constexpr script_set& operator|=(script_set const& other) noexcept
+    {
+        for (size_t i = 0; i < WordCount; ++i)
+            _words[i] |= other._words[i];
+        return *this;
+    }
+
+    constexpr bool operator==(script_set const& other) const noexcept = default;
+
+  private:
+    std::array<uint64_t, WordCount> _words {};
+};
+
+constexpr script_set operator&(script_set a, script_set const& b) noexcept
+{
+    return a &= b;
+}
+
+constexpr script_set operator|(script_set a, script_set const& b) noexcept
+{
+    return a |= b;
+}
+
+/// Bitmaps of the identifier properties (see identifier.h) of a block of BlockSize codepoints.
+///
+/// The blocks are deduplicated by unicode_tablegen into the identifier_blocks table,
+/// which is indexed by the block number through the identifier_stage1 table.
+class identifier_bitmap
+{
+  public:
+    struct tables_view;
+
+    enum class property : uint8_t
+    {
+        Start,
+        Continue,
+        PatternWhiteSpace,
+    };
+
+    static constexpr size_t BlockSize = 256;                   // NOLINT(readability-identifier-naming)
+    static constexpr size_t WordsPerProperty = BlockSize / 64; // NOLINT(readability-identifier-naming)
+    static constexpr size_t WordCount = 3 * WordsPerProperty;  // NOLINT(readability-identifier-naming)
+    static constexpr size_t BlockCount = 0x110'000 / BlockSize; // NOLINT(readability-identifier-naming)
+
+    /// The tables of the currently configured property_tables.
+    [[nodiscard]] static tables_view const& configured_tables() noexcept;
+
+    constexpr identifier_bitmap() noexcept = default;
+
+    constexpr explicit identifier_bitmap(std::array<uint64_t, WordCount> const& words) noexcept:
+        _words { words }
+    {
+    }
+
+    /// Marks the codepoint at @p index of the block as being of the given property.
+    constexpr void insert(property p, size_t index) noexcept
+    {
+        _words[static_cast<size_t>(p) * WordsPerProperty + index / 64] |= uint64_t { 1 } << (index % 64);
+    }
+
+    [[nodiscard]] constexpr bool contains(property p, size_t index) const noexcept
+    {
+        return (_words[static_cast<size_t>(p) * WordsPerProperty + index / 64] >> (index % 64)) & 1;
+    }
+
+    [[nodiscard]] constexpr std::array<uint64_t, WordCount> const& words() const noexcept { return _words; }
+
+    constexpr bool operator==(identifier_bitmap const& other) const noexcept = default;
+
+  private:
+    std::array<uint64_t, WordCount> _words {};
+};
+
+/// The identifier bitmaps of all codepoints.
+struct identifier_bitmap::tables_view
+{
+    uint8_t const* stage1;           // index into blocks, for each block of codepoints
+    identifier_bitmap const* blocks; // distinct bitmaps
+
+    [[nodiscard]] bool contains(property p, char32_t codepoint) const noexcept
+    {
+        if (codepoint > 0x10FFFF)
+            return false;
+        return blocks[stage1[codepoint / BlockSize]].contains(p, codepoint % BlockSize);
+    }
+};
+
+/// The Script and Script_Extensions properties of a codepoint.
+///
+/// Its tables share stage 1 and stage 2 with codepoint_properties::configured_tables().
+/// The Script_Extensions are stored as an index into a list of distinct script sets,
+/// such that looking up both properties costs a single table walk.
+struct script_properties
+{
+    Script script = Script::Unknown;
+
+    /// Index into configured_sets, or NoExtensions if the Script_Extensions are just the Script.
+    uint8_t extensions = NoExtensions;
+
+    static constexpr uint8_t NoExtensions = 0; // NOLINT(readability-identifier-naming)
+
+    using tables_view = support::multistage_table_view<script_properties,
+                                                       uint32_t,                          // source type
+                                                       uint16_t,                          // stage 1
+                                                       uint16_t,                          // stage 2
+                                                       128,                               // block size
+                                                       0x110'000 - 1,                     // max value
+                                                       codepoint_properties::direct_size  // direct size
+                                                       >;
+
+    /// The tables of the currently configured property_tables.
+    [[nodiscard]] static tables_view const& configured_tables() noexcept;
+
+    /// The distinct Script_Extensions sets of the currently configured property_tables,
+    /// indexed by script_properties::extensions.
+    [[nodiscard]] static script_set const* configured_sets() noexcept;
+
+    /// Retrieves the script properties for the given codepoint.
+    [[nodiscard]] static script_properties get(char32_t codepoint) noexcept
+    {
+        return configured_tables().get(codepoint);
+    }
+
+    /// @returns the Script_Extensions (scx) property, that is, the set of scripts the codepoint
+    ///          is used with, as per UAX #24.
+    [[nodiscard]] script_set script_extensions() const noexcept
+    {
+        return extensions == NoExtensions ? script_set { script } : configured_sets()[extensions];
+    }
+
+    constexpr bool operator==(script_properties const&) const noexcept = default;
+};
+
+static_assert(sizeof(script_properties) == 2);
+static_assert(std::has_unique_object_representations_v<script_properties>);
+
+/// The properties of a codepoint that word segmentation (UAX #29) and line breaking (UAX #14) depend on.
+///
+/// Its tables share stage 1 and stage 2 with codepoint_properties::configured_tables().
+struct break_properties
+{
+    Word_Break word_break = Word_Break::Other;
+    Line_Break line_break = Line_Break::Unknown;
+    uint8_t flags = 0;
+
+    static uint8_t constexpr FlagExtendedPictographic = 0x01; // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagMark = 0x02;                 // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagUnassigned = 0x04;           // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagEastAsianWide = 0x08;        // NOLINT(readability-identifier-naming)
+
+    [[nodiscard]] constexpr bool extended_pictographic() const noexcept
+    {
+        return flags & FlagExtendedPictographic;
+    }
+
+    /// Tests if the General_Category is Nonspacing_Mark or Spacing_Mark.
+    [[nodiscard]] constexpr bool mark() const noexcept { return flags & FlagMark; }
+
+    /// Tests if the General_Category is Unassigned.
+    [[nodiscard]] constexpr bool unassigned() const noexcept { return flags & FlagUnassigned; }
+
+    /// Tests if the East_Asian_Width is Fullwidth, Wide or Halfwidth.
+    [[nodiscard]] constexpr bool east_asian_wide() const noexcept { return flags & FlagEastAsianWide; }
+
+    using tables_view = support::multistage_table_view<break_properties,
+                                                       uint32_t,                          // source type
+                                                       uint16_t,                          // stage 1
+                                                       uint16_t,                          // stage 2
+                                                       128,                               // block size
+                                                       0x110'000 - 1,                     // max value
+                                                       codepoint_properties::direct_size  // direct size
+                                                       >;
+
+    /// The tables of the currently configured property_tables.
+    [[nodiscard]] static tables_view const& configured_tables() noexcept;
+
+    /// Retrieves the break properties for the given codepoint.
+    [[nodiscard]] static break_properties get(char32_t codepoint) noexcept
+    {
+        return configured_tables().get(codepoint);
+    }
+
+    constexpr bool operator==(break_properties const&) const noexcept = default;
+};
+
+static_assert(sizeof(break_properties) == 3);
+static_assert(std::has_unique_object_representations_v<break_properties>);
+
+/// The properties of a codepoint that normalization (UAX #15) depends on, other than its decomposition
+/// and composition mappings.
+///
+/// Its tables share stage 1 and stage 2 with codepoint_properties::configured_tables().
+struct normalization_properties
+{
+    uint8_t canonical_combining_class = 0;
+    uint8_t flags = 0;
+
+    static uint8_t constexpr FlagNFCQuickCheckNo = 0x01;     // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagNFCQuickCheckMaybe = 0x02;  // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagNFDQuickCheckNo = 0x04;     // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagNFKCQuickCheckNo = 0x08;    // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagNFKCQuickCheckMaybe = 0x10; // NOLINT(readability-identifier-naming)
+    static uint8_t constexpr FlagNFKDQuickCheckNo = 0x20;    // NOLINT(readability-identifier-naming)
+
+    [[nodiscard]] constexpr NFC_Quick_Check nfc_quick_check() const noexcept
+    {
+        return (flags & FlagNFCQuickCheckNo)      ? NFC_Quick_Check::No
+               : (flags & FlagNFCQuickCheckMaybe) ? NFC_Quick_Check::Maybe
+                                                  : NFC_Quick_Check::Yes;
+    }
+
+    [[nodiscard]] constexpr NFKC_Quick_Check nfkc_quick_check() const noexcept
+    {
+        return (flags & FlagNFKCQuickCheckNo)      ? NFKC_Quick_Check::No
+               : (flags & FlagNFKCQuickCheckMaybe) ? NFKC_Quick_Check::Maybe
+                                                   : NFKC_Quick_Check::Yes;
+    }
+
+    /// Tests if NFD_Quick_Check is Yes, it being No otherwise.
+    [[nodiscard]] constexpr bool nfd_quick_check() const noexcept { return !(flags & FlagNFDQuickCheckNo); }
+
+    /// Tests if NFKD_Quick_Check is Yes, it being No otherwise.
+    [[nodiscard]] constexpr bool nfkd_quick_check() const noexcept { return !(flags & FlagNFKDQuickCheckNo); }
+
+    using tables_view = support::multistage_table_view<normalization_properties,
+                                                       uint32_t,                          // source type
+                                                       uint16_t,                          // stage 1
+                                                       uint16_t,                          // stage 2
+                                                       128,                               // block size
+                                                       0x110'000 - 1,                     // max value
+                                                       codepoint_properties::direct_size  // direct size
+                                                       >;
+
+    /// The tables of the currently configured property_tables.
+    [[nodiscard]] static tables_view const& configured_tables() noexcept;
+
+    /// Retrieves the normalization properties for the given codepoint.
+    [[nodiscard]] static normalization_properties get(char32_t codepoint) noexcept
+    {
+        return configured_tables().get(codepoint);
+    }
+
+    constexpr bool operator==(normalization_properties const&) const noexcept = default;
+};
+
+static_assert(sizeof(normalization_properties) == 2);
+static_assert(std::has_unique_object_representations_v<normalization_properties>);
+
+/// A complete set of the tables the properties of codepoints are looked up in, such as the ones
+/// precompiled into libunicode or those of a codepoint_properties_file.
+///
+/// The configured set of tables is published atomically, such that it can be switched while other
+/// threads look up properties. Lookups that started before keep using the previous set of tables,
+/// which must therefore outlive them. Functions segmenting or scanning text capture the configured
+/// tables once per call, and keep using them throughout the call.
+struct property_tables
+{
+    codepoint_properties::tables_view properties;
+    narrow_codepoint_properties::tables_view narrow_properties;
+    codepoint_properties::names_view names;
+    script_properties::tables_view scripts;
+    script_set const* script_sets;
+    break_properties::tables_view breaks;
+    normalization_properties::tables_view normalization;
+    identifier_bitmap::tables_view identifiers;
+
+    /// The tables precompiled into libunicode, as configured initially.
+    static property_tables const precompiled;
+
+    /// @returns the currently configured tables.
+    [[nodiscard]] static property_tables const& configured() noexcept
+    {
+        return *_current.load(std::memory_order_acquire);
+    }
+
+    /// Configures the given @p tables, which must outlive any use of them.
+    ///
+    /// @returns the previously configured tables, e.g. for restoring them later on.
+    static property_tables const& configure(property_tables const& tables) noexcept
+    {
+        return *_current.exchange(&tables, std::memory_order_acq_rel);
+    }
+
+  private:
+    static std::atomic<property_tables const*> _current;
+};
+
+inline codepoint_properties::tables_view const& codepoint_properties::configured_tables() noexcept
+{
+    return property_tables::configured().properties;
+}
+
+inline identifier_bitmap::tables_view const& identifier_bitmap::configured_tables() noexcept
+{
+    return property_tables::configured().identifiers;
+}
+
+inline codepoint_properties::names_view const& codepoint_properties::configured_names() noexcept
+{
+    return property_tables::configured().names;
+}
+
+inline narrow_codepoint_properties::tables_view const& narrow_codepoint_properties::
+    configured_tables() noexcept
+{
+    return property_tables::configured().narrow_properties;
+}
+
+inline script_properties::tables_view const& script_properties::configured_tables() noexcept
+{
+    return property_tables::configured().scripts;
+}
+
+inline script_set const* script_properties::configured_sets() noexcept
+{
+    return property_tables::configured().script_sets;
+}
+
+inline break_properties::tables_view const& break_properties::configured_tables() noexcept
+{
+    return property_tables::configured().breaks;
+}
+
+inline normalization_properties::tables_view const& normalization_properties::configured_tables() noexcept
+{
+    return property_tables::configured().normalization;
+}
+
+constexpr bool operator==(narrow_codepoint_properties a, narrow_codepoint_properties b) noexcept
+{
+    return a.value == b.value;
+}
+
+constexpr bool operator!=(narrow_codepoint_properties a, narrow_codepoint_properties b) noexcept
+{
+    return !(a == b);
+}
+
 constexpr bool operator==(codepoint_properties const& a, codepoint_properties const& b) noexcept
 {
     return __builtin_memcmp(&a, &b, sizeof(codepoint_properties)) == 0;
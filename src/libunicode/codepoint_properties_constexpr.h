@@ -0,0 +1,63 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#if !defined(LIBUNICODE_CONSTEXPR_TABLES)
+    #error "codepoint_properties_constexpr.h requires libunicode to be built with LIBUNICODE_CONSTEXPR_TABLES."
+#endif
+
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/codepoint_properties_data.h>
+
+// Header-only lookups into the precompiled codepoint properties tables, usable in constant expressions.
+//
+// Unlike codepoint_properties::get() and friends, these always use the tables precompiled into libunicode,
+// rather than the ones configured at runtime (e.g. loaded from a file), and are inlined into the caller.
+namespace unicode::precompiled
+{
+
+inline constexpr codepoint_properties::tables_view properties_tables {
+    stage1.data(),
+    stage2.data(),
+    properties.data(),
+    properties_direct.data(),
+};
+
+inline constexpr narrow_codepoint_properties::tables_view narrow_properties_tables {
+    stage1.data(),
+    stage2.data(),
+    narrow_properties.data(),
+    narrow_properties_direct.data(),
+};
+
+/// Retrieves the precompiled codepoint properties for the given codepoint.
+[[nodiscard]] constexpr codepoint_properties get(char32_t codepoint) noexcept
+{
+    return properties_tables.get(codepoint);
+}
+
+/// Retrieves the precompiled narrow codepoint properties for the given codepoint.
+[[nodiscard]] constexpr narrow_codepoint_properties get_narrow(char32_t codepoint) noexcept
+{
+    return narrow_properties_tables.get(codepoint);
+}
+
+/// Returns the number of text columns the given codepoint would need to be displayed,
+/// same as unicode::width(char32_t).
+[[nodiscard]] constexpr int width(char32_t codepoint) noexcept
+{
+    return get_narrow(codepoint).char_width();
+}
+
+} // namespace unicode::precompiled
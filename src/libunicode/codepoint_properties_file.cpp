@@ -0,0 +1,454 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/codepoint_properties_file.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace std::string_literals;
+
+namespace unicode
+{
+
+namespace
+{
+    using properties_view = codepoint_properties::tables_view;
+    using names_view = codepoint_properties::names_view;
+    using names_index_view = names_view::index_view;
+
+    [[noreturn]] void fail(std::string const& path, std::string const& reason)
+    {
+        throw std::runtime_error("Invalid codepoint properties file " + path + ": " + reason);
+    }
+
+    /// Maps the whole file read-only into memory, returning its address and size.
+    std::pair<void const*, size_t> map_file(std::string const& path)
+    {
+#if defined(_WIN32)
+        auto const file = CreateFileA(path.c_str(),
+                                      GENERIC_READ,
+                                      FILE_SHARE_READ,
+                                      nullptr,
+                                      OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL,
+                                      nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Could not open file: "s + path);
+
+        auto fileSize = LARGE_INTEGER {};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            fail(path, "could not determine file size");
+        }
+
+        auto const mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            throw std::runtime_error("Could not map file: "s + path);
+
+        auto const* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!data)
+            throw std::runtime_error("Could not map file: "s + path);
+
+        return { data, static_cast<size_t>(fileSize.QuadPart) };
+#else
+        auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::runtime_error("Could not open file: "s + path);
+
+        struct stat st {};
+        if (fstat(fd, &st) < 0 || st.st_size <= 0)
+        {
+            ::close(fd);
+            fail(path, "could not determine file size");
+        }
+
+        auto const size = static_cast<size_t>(st.st_size);
+        auto* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+            throw std::runtime_error("Could not map file: "s + path);
+
+        return { data, size };
+#endif
+    }
+
+    /// Ensures that all @p count elements are below @p limit, so that lookups never read out of bounds.
+    template <typename T>
+    void validate_indices(
+        std::string const& path, char const* name, T const* elements, size_t count, size_t limit)
+    {
+        for (size_t i = 0; i < count; ++i)
+            if (static_cast<size_t>(elements[i]) >= limit)
+                fail(path, "index out of range in "s + name);
+    }
+
+    void validate(std::string const& path, void const* data, size_t size)
+    {
+        using table_file::section;
+
+        if (size < sizeof(table_file::header))
+            fail(path, "file too small");
+
+        auto const& header = *static_cast<table_file::header const*>(data);
+        if (std::memcmp(header.magic, table_file::Magic, sizeof(table_file::Magic)) != 0)
+            fail(path, "bad magic");
+        if (header.byte_order_mark != table_file::ByteOrderMark)
+            fail(path, "byte order mismatch");
+        if (header.format_version != table_file::FormatVersion)
+            fail(path, "unsupported format version " + std::to_string(header.format_version));
+
+        // clang-format off
+        if (header.block_size != properties_view::block_size
+            || header.direct_size != properties_view::direct_size
+            || header.stage1_element_size != sizeof(properties_view::stage1_element_type)
+            || header.stage2_element_size != sizeof(properties_view::stage2_element_type)
+            || header.properties_size != sizeof(codepoint_properties)
+            || header.names_block_size != names_index_view::block_size)
+            fail(path, "table layout mismatch");
+        // clang-format on
+
+        for (auto const& entry: header.sections)
+            if (entry.offset % table_file::SectionAlignment != 0 || entry.offset > size
+                || entry.size > size - entry.offset)
+                fail(path, "section out of bounds");
+
+        auto const sectionSize = [&](section id) {
+            return static_cast<size_t>(header.sections[static_cast<size_t>(id)].size);
+        };
+        auto const sectionData = [&](section id) {
+            return static_cast<char const*>(data) + header.sections[static_cast<size_t>(id)].offset;
+        };
+
+        // {{{ codepoint properties
+        using stage1_type = properties_view::stage1_element_type;
+        using stage2_type = properties_view::stage2_element_type;
+        auto constexpr Stage1Count = (0x110'000 + properties_view::block_size - 1) / properties_view::block_size;
+        auto constexpr Stage2BlockBytes = properties_view::block_size * sizeof(stage2_type);
+
+        auto const propertiesCount = sectionSize(section::properties) / sizeof(codepoint_properties);
+        if (sectionSize(section::stage1) != Stage1Count * sizeof(stage1_type)
+            || sectionSize(section::stage2) == 0 || sectionSize(section::stage2) % Stage2BlockBytes != 0
+            || propertiesCount == 0 || sectionSize(section::properties) % sizeof(codepoint_properties) != 0
+            || sectionSize(section::properties_direct)
+                   != properties_view::direct_size * sizeof(codepoint_properties)
+            || sectionSize(section::narrow_properties) != propertiesCount * sizeof(narrow_codepoint_properties)
+            || sectionSize(section::narrow_properties_direct)
+                   != properties_view::direct_size * sizeof(narrow_codepoint_properties)
+            || sectionSize(section::script_properties) != propertiesCount * sizeof(script_properties)
+            || sectionSize(section::script_properties_direct)
+                   != properties_view::direct_size * sizeof(script_properties)
+            || sectionSize(section::script_sets) == 0
+            || sectionSize(section::script_sets) % sizeof(script_set) != 0
+            || sectionSize(section::break_properties) != propertiesCount * sizeof(break_properties)
+            || sectionSize(section::break_properties_direct)
+                   != properties_view::direct_size * sizeof(break_properties)
+            || sectionSize(section::normalization_properties)
+                   != propertiesCount * sizeof(normalization_properties)
+            || sectionSize(section::normalization_properties_direct)
+                   != properties_view::direct_size * sizeof(normalization_properties))
+            fail(path, "unexpected properties table sizes");
+
+        validate_indices(path,
+                         "stage1",
+                         reinterpret_cast<stage1_type const*>(sectionData(section::stage1)),
+                         Stage1Count,
+                         sectionSize(section::stage2) / Stage2BlockBytes);
+        validate_indices(path,
+                         "stage2",
+                         reinterpret_cast<stage2_type const*>(sectionData(section::stage2)),
+                         sectionSize(section::stage2) / sizeof(stage2_type),
+                         propertiesCount);
+
+        auto const scriptSetCount = sectionSize(section::script_sets) / sizeof(script_set);
+        for (auto const id: { section::script_properties, section::script_properties_direct })
+        {
+            auto const* scripts = reinterpret_cast<script_properties const*>(sectionData(id));
+            for (size_t i = 0; i < sectionSize(id) / sizeof(script_properties); ++i)
+                if (scripts[i].extensions >= scriptSetCount)
+                    fail(path, "index out of range in script_properties");
+        }
+
+        // The word and line segmenters index their transition tables by Word_Break and Line_Break.
+        for (auto const id: { section::break_properties, section::break_properties_direct })
+        {
+            auto const* breaks = reinterpret_cast<break_properties const*>(sectionData(id));
+            for (size_t i = 0; i < sectionSize(id) / sizeof(break_properties); ++i)
+                if (breaks[i].word_break > Word_Break::ZWJ || breaks[i].line_break > Line_Break::ZWSpace)
+                    fail(path, "Word_Break or Line_Break out of range in break_properties");
+        }
+        // }}}
+
+        // {{{ identifier bitmaps
+        auto const identifierBlockCount = sectionSize(section::identifier_blocks) / sizeof(identifier_bitmap);
+        if (sectionSize(section::identifier_stage1) != identifier_bitmap::BlockCount * sizeof(uint8_t)
+            || identifierBlockCount == 0
+            || sectionSize(section::identifier_blocks) % sizeof(identifier_bitmap) != 0)
+            fail(path, "unexpected identifier table sizes");
+
+        validate_indices(path,
+                         "identifier_stage1",
+                         reinterpret_cast<uint8_t const*>(sectionData(section::identifier_stage1)),
+                         identifier_bitmap::BlockCount,
+                         identifierBlockCount);
+        // }}}
+
+        // {{{ names
+        using names_stage1_type = names_index_view::stage1_element_type;
+        using names_stage2_type = names_index_view::stage2_element_type;
+        auto constexpr NamesStage1Count =
+            (0x110'000 + names_index_view::block_size - 1) / names_index_view::block_size;
+        auto constexpr NamesStage2BlockBytes = names_index_view::block_size * sizeof(names_stage2_type);
+
+        auto const namesCount = sectionSize(section::names_stage3) / sizeof(uint32_t);
+        auto const wordCount = sectionSize(section::names_word_offsets) / sizeof(uint32_t);
+        if (sectionSize(section::names_stage1) != NamesStage1Count * sizeof(names_stage1_type)
+            || sectionSize(section::names_stage2) == 0
+            || sectionSize(section::names_stage2) % NamesStage2BlockBytes != 0 || namesCount == 0
+            || sectionSize(section::names_stage3) % sizeof(uint32_t) != 0 || wordCount == 0
+            || sectionSize(section::names_word_offsets) % sizeof(uint32_t) != 0)
+            fail(path, "unexpected names table sizes");
+
+        validate_indices(path,
+                         "names_stage1",
+                         reinterpret_cast<names_stage1_type const*>(sectionData(section::names_stage1)),
+                         NamesStage1Count,
+                         sectionSize(section::names_stage2) / NamesStage2BlockBytes);
+        validate_indices(path,
+                         "names_stage2",
+                         reinterpret_cast<names_stage2_type const*>(sectionData(section::names_stage2)),
+                         sectionSize(section::names_stage2) / sizeof(names_stage2_type),
+                         namesCount);
+
+        auto const* wordOffsets = reinterpret_cast<uint32_t const*>(sectionData(section::names_word_offsets));
+        for (size_t i = 0; i + 1 < wordCount; ++i)
+            if (wordOffsets[i] > wordOffsets[i + 1])
+                fail(path, "word offsets not in ascending order");
+        if (wordOffsets[wordCount - 1] > sectionSize(section::names_words))
+            fail(path, "words out of bounds");
+
+        // Walk each encoded name, so that decoding never reads out of bounds.
+        auto const* namesData = reinterpret_cast<uint8_t const*>(sectionData(section::names_data));
+        auto const dataSize = sectionSize(section::names_data);
+        auto const* offsets = reinterpret_cast<uint32_t const*>(sectionData(section::names_stage3));
+        for (size_t i = 0; i < namesCount; ++i)
+        {
+            auto position = static_cast<size_t>(offsets[i]);
+            if (position >= dataSize)
+                fail(path, "name out of bounds");
+            auto const nameHeader = namesData[position++];
+            if ((nameHeader & names_view::FlagHexSuffix) && (nameHeader & names_view::FlagHangulSyllable))
+                fail(path, "invalid name encoding");
+            for (unsigned k = 0; k < (nameHeader & names_view::TokenCountMask); ++k)
+            {
+                if (position >= dataSize)
+                    fail(path, "name out of bounds");
+                size_t word = namesData[position++];
+                if (word & names_view::WideWordIndexFlag)
+                {
+                    if (position >= dataSize)
+                        fail(path, "name out of bounds");
+                    word = ((word & ~size_t { names_view::WideWordIndexFlag }) << 8) | namesData[position++];
+                }
+                if (word + 1 >= wordCount)
+                    fail(path, "word index out of range in names_data");
+            }
+        }
+        // }}}
+    }
+} // namespace
+
+codepoint_properties_file codepoint_properties_file::open(std::string const& path)
+{
+    auto const [data, size] = map_file(path);
+    auto file = codepoint_properties_file(data, size);
+
+    validate(path, data, size);
+    file._tables = std::make_unique<property_tables const>(property_tables {
+        file.properties(),
+        file.narrow_properties(),
+        file.names(),
+        file.scripts(),
+        file.script_sets(),
+        file.breaks(),
+        file.normalization(),
+        file.identifiers(),
+    });
+
+    return file;
+}
+
+codepoint_properties_file::codepoint_properties_file(void const* data, size_t size): _data { data }, _size { size }
+{
+}
+
+codepoint_properties_file::codepoint_properties_file(codepoint_properties_file&& other) noexcept:
+    _data { std::exchange(other._data, nullptr) },
+    _size { std::exchange(other._size, 0) },
+    _tables { std::move(other._tables) }
+{
+}
+
+codepoint_properties_file& codepoint_properties_file::operator=(codepoint_properties_file&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _tables = std::move(other._tables);
+    }
+    return *this;
+}
+
+codepoint_properties_file::~codepoint_properties_file()
+{
+    unmap();
+}
+
+void codepoint_properties_file::unmap() noexcept
+{
+    if (!_data)
+        return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(_data);
+#else
+    munmap(const_cast<void*>(_data), _size);
+#endif
+    _data = nullptr;
+    _size = 0;
+}
+
+table_file::header const& codepoint_properties_file::header() const noexcept
+{
+    return *static_cast<table_file::header const*>(_data);
+}
+
+template <typename T>
+T const* codepoint_properties_file::section_data(table_file::section id) const noexcept
+{
+    auto const offset = header().sections[static_cast<size_t>(id)].offset;
+    return reinterpret_cast<T const*>(static_cast<char const*>(_data) + offset);
+}
+
+std::string_view codepoint_properties_file::ucd_version() const noexcept
+{
+    auto const& version = header().ucd_version;
+    return std::string_view(version, strnlen(version, sizeof(version)));
+}
+
+codepoint_properties::tables_view codepoint_properties_file::properties() const noexcept
+{
+    using table_file::section;
+    return properties_view {
+        section_data<properties_view::stage1_element_type>(section::stage1),
+        section_data<properties_view::stage2_element_type>(section::stage2),
+        section_data<codepoint_properties>(section::properties),
+        section_data<codepoint_properties>(section::properties_direct),
+    };
+}
+
+narrow_codepoint_properties::tables_view codepoint_properties_file::narrow_properties() const noexcept
+{
+    using table_file::section;
+    return narrow_codepoint_properties::tables_view {
+        section_data<properties_view::stage1_element_type>(section::stage1),
+        section_data<properties_view::stage2_element_type>(section::stage2),
+        section_data<narrow_codepoint_properties>(section::narrow_properties),
+        section_data<narrow_codepoint_properties>(section::narrow_properties_direct),
+    };
+}
+
+codepoint_properties::names_view codepoint_properties_file::names() const noexcept
+{
+    using table_file::section;
+    return names_view {
+        {
+            section_data<names_index_view::stage1_element_type>(section::names_stage1),
+            section_data<names_index_view::stage2_element_type>(section::names_stage2),
+            section_data<uint32_t>(section::names_stage3),
+        },
+        section_data<uint8_t>(section::names_data),
+        section_data<uint32_t>(section::names_word_offsets),
+        section_data<char>(section::names_words),
+    };
+}
+
+script_properties::tables_view codepoint_properties_file::scripts() const noexcept
+{
+    using table_file::section;
+    return script_properties::tables_view {
+        section_data<properties_view::stage1_element_type>(section::stage1),
+        section_data<properties_view::stage2_element_type>(section::stage2),
+        section_data<script_properties>(section::script_properties),
+        section_data<script_properties>(section::script_properties_direct),
+    };
+}
+
+script_set const* codepoint_properties_file::script_sets() const noexcept
+{
+    return section_data<script_set>(table_file::section::script_sets);
+}
+
+break_properties::tables_view codepoint_properties_file::breaks() const noexcept
+{
+    using table_file::section;
+    return break_properties::tables_view {
+        section_data<properties_view::stage1_element_type>(section::stage1),
+        section_data<properties_view::stage2_element_type>(section::stage2),
+        section_data<break_properties>(section::break_properties),
+        section_data<break_properties>(section::break_properties_direct),
+    };
+}
+
+normalization_properties::tables_view codepoint_properties_file::normalization() const noexcept
+{
+    using table_file::section;
+    return normalization_properties::tables_view {
+        section_data<properties_view::stage1_element_type>(section::stage1),
+        section_data<properties_view::stage2_element_type>(section::stage2),
+        section_data<normalization_properties>(section::normalization_properties),
+        section_data<normalization_properties>(section::normalization_properties_direct),
+    };
+}
+
+identifier_bitmap::tables_view codepoint_properties_file::identifiers() const noexcept
+{
+    using table_file::section;
+    return identifier_bitmap::tables_view {
+        section_data<uint8_t>(section::identifier_stage1),
+        section_data<identifier_bitmap>(section::identifier_blocks),
+    };
+}
+
+property_tables const& codepoint_properties_file::configure() const noexcept
+{
+    return property_tables::configure(*_tables);
+}
+
+} // namespace unicode
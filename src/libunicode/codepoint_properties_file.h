@@ -0,0 +1,149 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/codepoint_properties.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace unicode
+{
+
+/// Binary file format of the codepoint properties tables, as written by unicode_tablegen.
+///
+/// A file starts with a header, followed by the sections it refers to by offset, each aligned
+/// to a cache line. It contains no pointers and can therefore be memory-mapped at any address.
+/// Numbers are stored in the byte order of the machine that wrote the file, which is recorded
+/// in the header and verified when loading.
+namespace table_file
+{
+    constexpr char Magic[8] = { 'L', 'I', 'B', 'U', 'C', 'T', 'B', 'L' }; // NOLINT
+    constexpr uint32_t FormatVersion = 8;                                      // NOLINT
+    constexpr uint32_t ByteOrderMark = 0x01020304;                             // NOLINT
+    constexpr size_t SectionAlignment = 64;                                    // NOLINT
+
+    enum class section : uint32_t
+    {
+        stage1,
+        stage2,
+        properties,
+        properties_direct,
+        narrow_properties,
+        narrow_properties_direct,
+        names_stage1,
+        names_stage2,
+        names_stage3,
+        names_data,
+        names_word_offsets,
+        names_words,
+        script_properties,
+        script_properties_direct,
+        script_sets,
+        break_properties,
+        break_properties_direct,
+        normalization_properties,
+        normalization_properties_direct,
+        identifier_stage1,
+        identifier_blocks,
+    };
+
+    // NOLINTNEXTLINE(readability-identifier-naming)
+    constexpr size_t SectionCount = static_cast<size_t>(section::identifier_blocks) + 1;
+
+    struct section_entry
+    {
+        uint64_t offset; // in bytes, relative to the start of the file
+        uint64_t size;   // in bytes
+    };
+
+    struct header
+    {
+        char magic[sizeof(Magic)];
+        uint32_t format_version;
+        uint32_t byte_order_mark;
+        char ucd_version[16]; // zero terminated, for informational purposes only
+
+        // Layout of the tables, which must match the one that libunicode was compiled with.
+        uint32_t block_size;
+        uint32_t direct_size;
+        uint32_t stage1_element_size;
+        uint32_t stage2_element_size;
+        uint32_t properties_size;
+        uint32_t names_block_size;
+
+        section_entry sections[SectionCount];
+    };
+} // namespace table_file
+
+/// Codepoint properties tables, memory-mapped from a file written by unicode_tablegen.
+///
+/// The tables are used in place, so that multiple processes share the same (page cache)
+/// copy of them.
+class codepoint_properties_file
+{
+  public:
+    /// Maps the given file into memory and validates it.
+    ///
+    /// @throws std::runtime_error if the file cannot be mapped, or is not a table file that
+    ///         is compatible with this build of libunicode.
+    static codepoint_properties_file open(std::string const& path);
+
+    codepoint_properties_file(codepoint_properties_file&& other) noexcept;
+    codepoint_properties_file& operator=(codepoint_properties_file&& other) noexcept;
+    codepoint_properties_file(codepoint_properties_file const&) = delete;
+    codepoint_properties_file& operator=(codepoint_properties_file const&) = delete;
+    ~codepoint_properties_file();
+
+    [[nodiscard]] std::string_view ucd_version() const noexcept;
+
+    [[nodiscard]] codepoint_properties::tables_view properties() const noexcept;
+    [[nodiscard]] narrow_codepoint_properties::tables_view narrow_properties() const noexcept;
+    [[nodiscard]] codepoint_properties::names_view names() const noexcept;
+    [[nodiscard]] script_properties::tables_view scripts() const noexcept;
+    [[nodiscard]] script_set const* script_sets() const noexcept;
+    [[nodiscard]] break_properties::tables_view breaks() const noexcept;
+    [[nodiscard]] normalization_properties::tables_view normalization() const noexcept;
+    [[nodiscard]] identifier_bitmap::tables_view identifiers() const noexcept;
+
+    /// All of the tables of this file, at an address that stays the same when moving the file.
+    [[nodiscard]] property_tables const& tables() const noexcept { return *_tables; }
+
+    /// Configures the tables of this file, see property_tables::configure().
+    ///
+    /// This file must be kept open for as long as those are in use, including by other threads
+    /// that are still looking up properties after configuring other tables.
+    ///
+    /// @returns the previously configured tables, e.g. for restoring them later on.
+    property_tables const& configure() const noexcept;
+
+  private:
+    codepoint_properties_file(void const* data, size_t size);
+
+    [[nodiscard]] table_file::header const& header() const noexcept;
+
+    template <typename T>
+    [[nodiscard]] T const* section_data(table_file::section id) const noexcept;
+
+    void unmap() noexcept;
+
+    void const* _data;
+    size_t _size;
+    std::unique_ptr<property_tables const> _tables;
+};
+
+} // namespace unicode
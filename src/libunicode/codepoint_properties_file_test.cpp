@@ -0,0 +1,186 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/codepoint_properties_file.h>
+#include <libunicode/identifier.h>
+#include <libunicode/width.h>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using unicode::break_properties;
+using unicode::codepoint_properties;
+using unicode::codepoint_properties_file;
+using unicode::identifier_bitmap;
+using unicode::narrow_codepoint_properties;
+using unicode::normalization_properties;
+using unicode::property_tables;
+using unicode::script_properties;
+
+namespace
+{
+
+std::string read_file(std::string const& path)
+{
+    auto file = std::ifstream(path, std::ios::binary);
+    auto contents = std::string {};
+    file.seekg(0, std::ios::end);
+    contents.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+    return contents;
+}
+
+std::string temporary_file_path()
+{
+    return (std::filesystem::temp_directory_path() / "libunicode_test_tables.bin").string();
+}
+
+std::string write_temporary_file(std::string const& contents)
+{
+    auto const path = temporary_file_path();
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    return path;
+}
+
+} // namespace
+
+TEST_CASE("codepoint_properties_file.open")
+{
+    auto const file = codepoint_properties_file::open(LIBUNICODE_TABLE_FILE);
+    CHECK(!file.ucd_version().empty());
+
+    auto const properties = file.properties();
+    auto const narrow = file.narrow_properties();
+    auto const names = file.names();
+    auto const scripts = file.scripts();
+    auto const scriptSets = file.script_sets();
+    auto const breaks = file.breaks();
+    auto const normalization = file.normalization();
+    auto const identifiers = file.identifiers();
+    auto const& precompiledIdentifiers = property_tables::precompiled.identifiers;
+    auto const sameIdentifier = [&](char32_t codepoint) {
+        using property = identifier_bitmap::property;
+        for (auto const p: { property::Start, property::Continue, property::PatternWhiteSpace })
+            if (identifiers.contains(p, codepoint) != precompiledIdentifiers.contains(p, codepoint))
+                return false;
+        return true;
+    };
+
+    size_t mismatches = 0;
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+    {
+        auto const& scriptProperties = scripts.get(codepoint);
+        if (properties.get(codepoint) != codepoint_properties::get(codepoint)
+            || narrow.get(codepoint) != narrow_codepoint_properties::get(codepoint)
+            || names.get(codepoint) != codepoint_properties::name(codepoint)
+            || scriptProperties != script_properties::get(codepoint)
+            || scriptSets[scriptProperties.extensions]
+                   != script_properties::configured_sets()[scriptProperties.extensions]
+            || breaks.get(codepoint) != break_properties::get(codepoint)
+            || normalization.get(codepoint) != normalization_properties::get(codepoint)
+            || !sameIdentifier(codepoint))
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+    CHECK(names.get(U'A') == "LATIN CAPITAL LETTER A");
+}
+
+TEST_CASE("codepoint_properties_file.configure")
+{
+    {
+        auto const file = codepoint_properties_file::open(LIBUNICODE_TABLE_FILE);
+        auto const& saved = file.configure();
+        CHECK(&saved == &property_tables::precompiled);
+        CHECK(&property_tables::configured() == &file.tables());
+
+        CHECK(codepoint_properties::configured_tables().stage3 == file.properties().stage3);
+        CHECK(narrow_codepoint_properties::configured_tables().stage3 == file.narrow_properties().stage3);
+        CHECK(codepoint_properties::get(U'\U0001F600').emoji());
+        CHECK(narrow_codepoint_properties::get(U'一').char_width() == 2);
+        CHECK(codepoint_properties::name(U'A') == "LATIN CAPITAL LETTER A");
+        CHECK(script_properties::configured_sets() == file.script_sets());
+        CHECK(script_properties::get(U'λ').script == unicode::Script::Greek);
+        CHECK(break_properties::configured_tables().stage3 == file.breaks().stage3);
+        CHECK(normalization_properties::configured_tables().stage3 == file.normalization().stage3);
+        CHECK(normalization_properties::get(U'\u0301').canonical_combining_class == 230);
+        CHECK(identifier_bitmap::configured_tables().blocks == file.identifiers().blocks);
+        CHECK(unicode::is_identifier_start(U'λ'));
+
+        CHECK(&property_tables::configure(saved) == &file.tables());
+    }
+
+    CHECK(codepoint_properties::name(U'A') == "LATIN CAPITAL LETTER A");
+}
+
+TEST_CASE("codepoint_properties_file.configure_concurrently")
+{
+    // Lookups keep working while the tables are switched back and forth, both being of the same UCD.
+    auto const file = codepoint_properties_file::open(LIBUNICODE_TABLE_FILE);
+    auto done = std::atomic<bool> { false };
+    auto switcher = std::thread([&]() {
+        for (int i = 0; i < 10000 && !done.load(); ++i)
+            (void) property_tables::configure(i % 2 ? property_tables::precompiled : file.tables());
+        (void) property_tables::configure(property_tables::precompiled);
+    });
+
+    auto mismatches = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        mismatches += unicode::width(U'\u4E00') != 2;
+        mismatches += codepoint_properties::name(U'A') != "LATIN CAPITAL LETTER A";
+        mismatches += script_properties::get(U'\u03BB').script != unicode::Script::Greek;
+    }
+    done = true;
+    switcher.join();
+    CHECK(mismatches == 0);
+    CHECK(&property_tables::configured() == &property_tables::precompiled);
+}
+
+TEST_CASE("codepoint_properties_file.invalid")
+{
+    auto const contents = read_file(LIBUNICODE_TABLE_FILE);
+    REQUIRE(contents.size() > sizeof(unicode::table_file::header));
+
+    CHECK_THROWS_AS(codepoint_properties_file::open("/nonexistent/codepoint_properties.bin"), std::runtime_error);
+
+    // Truncated file.
+    CHECK_THROWS_AS(codepoint_properties_file::open(write_temporary_file(contents.substr(0, contents.size() / 2))),
+                    std::runtime_error);
+
+    // Bad magic.
+    auto badMagic = contents;
+    badMagic[0] = 'X';
+    CHECK_THROWS_AS(codepoint_properties_file::open(write_temporary_file(badMagic)), std::runtime_error);
+
+    // Stage 1 referring to a non-existing stage 2 block.
+    auto badIndex = contents;
+    auto const& header = *reinterpret_cast<unicode::table_file::header const*>(contents.data());
+    auto const stage1Offset =
+        header.sections[static_cast<size_t>(unicode::table_file::section::stage1)].offset;
+    badIndex[stage1Offset] = '\xFF';
+    badIndex[stage1Offset + 1] = '\xFF';
+    CHECK_THROWS_AS(codepoint_properties_file::open(write_temporary_file(badIndex)), std::runtime_error);
+
+    // The unmodified file is fine.
+    CHECK_NOTHROW(codepoint_properties_file::open(write_temporary_file(contents)));
+
+    std::filesystem::remove(temporary_file_path());
+}
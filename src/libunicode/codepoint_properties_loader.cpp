@@ -19,10 +19,14 @@
 #include <cassert>
 #include <chrono>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <map>
 #include <optional>
-#include <regex>
+#include <limits>
+#include <sstream>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 
 using namespace std;
@@ -317,6 +321,113 @@ namespace
         return nullopt;
     }
 
+    constexpr optional<unicode::Vertical_Orientation> make_vertical_orientation(string_view value) noexcept
+    {
+        auto /*static*/ constexpr mappings = array {
+            pair { "R"sv, unicode::Vertical_Orientation::Rotated },
+            pair { "Tr"sv, unicode::Vertical_Orientation::Transformed_Rotated },
+            pair { "Tu"sv, unicode::Vertical_Orientation::Transformed_Upright },
+            pair { "U"sv, unicode::Vertical_Orientation::Upright },
+        };
+
+        for (auto const& mapping: mappings)
+            if (mapping.first == value)
+                return mapping.second;
+
+        return nullopt;
+    }
+
+    constexpr optional<unicode::Word_Break> make_word_break(string_view value) noexcept
+    {
+        auto /*static*/ constexpr mappings = array {
+            pair { "ALetter"sv, unicode::Word_Break::ALetter },
+            pair { "CR"sv, unicode::Word_Break::CR },
+            pair { "Double_Quote"sv, unicode::Word_Break::Double_Quote },
+            pair { "E_Base"sv, unicode::Word_Break::E_Base },
+            pair { "E_Base_GAZ"sv, unicode::Word_Break::E_Base_GAZ },
+            pair { "E_Modifier"sv, unicode::Word_Break::E_Modifier },
+            pair { "Extend"sv, unicode::Word_Break::Extend },
+            pair { "ExtendNumLet"sv, unicode::Word_Break::ExtendNumLet },
+            pair { "Format"sv, unicode::Word_Break::Format },
+            pair { "Glue_After_Zwj"sv, unicode::Word_Break::Glue_After_Zwj },
+            pair { "Hebrew_Letter"sv, unicode::Word_Break::Hebrew_Letter },
+            pair { "Katakana"sv, unicode::Word_Break::Katakana },
+            pair { "LF"sv, unicode::Word_Break::LF },
+            pair { "MidLetter"sv, unicode::Word_Break::MidLetter },
+            pair { "MidNum"sv, unicode::Word_Break::MidNum },
+            pair { "MidNumLet"sv, unicode::Word_Break::MidNumLet },
+            pair { "Newline"sv, unicode::Word_Break::Newline },
+            pair { "Numeric"sv, unicode::Word_Break::Numeric },
+            pair { "Other"sv, unicode::Word_Break::Other },
+            pair { "Regional_Indicator"sv, unicode::Word_Break::Regional_Indicator },
+            pair { "Single_Quote"sv, unicode::Word_Break::Single_Quote },
+            pair { "WSegSpace"sv, unicode::Word_Break::WSegSpace },
+            pair { "ZWJ"sv, unicode::Word_Break::ZWJ },
+        };
+
+        for (auto const& mapping: mappings)
+            if (mapping.first == value)
+                return mapping.second;
+
+        return nullopt;
+    }
+
+    constexpr optional<unicode::Line_Break> make_line_break(string_view value) noexcept
+    {
+        // LineBreak.txt uses the short property value aliases.
+        auto /*static*/ constexpr mappings = array {
+            pair { "AI"sv, unicode::Line_Break::Ambiguous },
+            pair { "AL"sv, unicode::Line_Break::Alphabetic },
+            pair { "B2"sv, unicode::Line_Break::Break_Both },
+            pair { "BA"sv, unicode::Line_Break::Break_After },
+            pair { "BB"sv, unicode::Line_Break::Break_Before },
+            pair { "BK"sv, unicode::Line_Break::Mandatory_Break },
+            pair { "CB"sv, unicode::Line_Break::Contingent_Break },
+            pair { "CJ"sv, unicode::Line_Break::Conditional_Japanese_Starter },
+            pair { "CL"sv, unicode::Line_Break::Close_Punctuation },
+            pair { "CM"sv, unicode::Line_Break::Combining_Mark },
+            pair { "CP"sv, unicode::Line_Break::Close_Parenthesis },
+            pair { "CR"sv, unicode::Line_Break::Carriage_Return },
+            pair { "EB"sv, unicode::Line_Break::E_Base },
+            pair { "EM"sv, unicode::Line_Break::E_Modifier },
+            pair { "EX"sv, unicode::Line_Break::Exclamation },
+            pair { "GL"sv, unicode::Line_Break::Glue },
+            pair { "H2"sv, unicode::Line_Break::H2 },
+            pair { "H3"sv, unicode::Line_Break::H3 },
+            pair { "HL"sv, unicode::Line_Break::Hebrew_Letter },
+            pair { "HY"sv, unicode::Line_Break::Hyphen },
+            pair { "ID"sv, unicode::Line_Break::Ideographic },
+            pair { "IN"sv, unicode::Line_Break::Inseparable },
+            pair { "IS"sv, unicode::Line_Break::Infix_Numeric },
+            pair { "JL"sv, unicode::Line_Break::JL },
+            pair { "JT"sv, unicode::Line_Break::JT },
+            pair { "JV"sv, unicode::Line_Break::JV },
+            pair { "LF"sv, unicode::Line_Break::Line_Feed },
+            pair { "NL"sv, unicode::Line_Break::Next_Line },
+            pair { "NS"sv, unicode::Line_Break::Nonstarter },
+            pair { "NU"sv, unicode::Line_Break::Numeric },
+            pair { "OP"sv, unicode::Line_Break::Open_Punctuation },
+            pair { "PO"sv, unicode::Line_Break::Postfix_Numeric },
+            pair { "PR"sv, unicode::Line_Break::Prefix_Numeric },
+            pair { "QU"sv, unicode::Line_Break::Quotation },
+            pair { "RI"sv, unicode::Line_Break::Regional_Indicator },
+            pair { "SA"sv, unicode::Line_Break::Complex_Context },
+            pair { "SG"sv, unicode::Line_Break::Surrogate },
+            pair { "SP"sv, unicode::Line_Break::Space },
+            pair { "SY"sv, unicode::Line_Break::Break_Symbols },
+            pair { "WJ"sv, unicode::Line_Break::Word_Joiner },
+            pair { "XX"sv, unicode::Line_Break::Unknown },
+            pair { "ZW"sv, unicode::Line_Break::ZWSpace },
+            pair { "ZWJ"sv, unicode::Line_Break::ZWJ },
+        };
+
+        for (auto const& mapping: mappings)
+            if (mapping.first == value)
+                return mapping.second;
+
+        return nullopt;
+    }
+
     constexpr optional<unicode::Grapheme_Cluster_Break> make_gb(string_view value) noexcept
     {
         auto /*static*/ constexpr mappings = array {
@@ -430,11 +541,175 @@ namespace
         return EmojiSegmentationCategory::Invalid;
     }
 
+    // Codepoint properties along with their script and break properties, such that the multistage tables
+    // generated for them can be shared.
+    struct combined_properties
+    {
+        codepoint_properties properties;
+        script_properties scripts;
+        break_properties breaks;
+        normalization_properties normalization;
+
+        constexpr bool operator==(combined_properties const& other) const noexcept
+        {
+            return properties == other.properties && scripts == other.scripts && breaks == other.breaks
+                   && normalization == other.normalization;
+        }
+    };
+
+    static_assert(std::has_unique_object_representations_v<combined_properties>);
+
+    using combined_properties_table = support::multistage_table<combined_properties,
+                                                                uint32_t,      // source type
+                                                                uint16_t,      // stage 1
+                                                                uint16_t,      // stage 2
+                                                                128,           // block size
+                                                                0x110'000 - 1, // max value
+                                                                0x800          // direct size
+                                                                >;
+
+    using loaded_tables = std::tuple<codepoint_properties_table,
+                                     codepoint_names_table,
+                                     script_properties_table,
+                                     break_properties_table,
+                                     normalization_properties_table,
+                                     identifier_bitmaps_table>;
+
+    // {{{ UCD file parsing
+    string_view trimmed(string_view text) noexcept
+    {
+        auto const isSpace = [](char ch) {
+            return ch == ' ' || ch == '\t' || ch == '\r';
+        };
+        while (!text.empty() && isSpace(text.front()))
+            text.remove_prefix(1);
+        while (!text.empty() && isSpace(text.back()))
+            text.remove_suffix(1);
+        return text;
+    }
+
+    optional<char32_t> parse_codepoint(string_view text) noexcept
+    {
+        if (text.empty() || text.size() > 6)
+            return nullopt;
+        auto codepoint = char32_t { 0 };
+        for (auto const ch: text)
+        {
+            if ('0' <= ch && ch <= '9')
+                codepoint = codepoint * 16 + static_cast<char32_t>(ch - '0');
+            else if ('A' <= ch && ch <= 'F')
+                codepoint = codepoint * 16 + static_cast<char32_t>(ch - 'A' + 10);
+            else
+                return nullopt;
+        }
+        return codepoint;
+    }
+
+    /// A data line of a UCD file, such as "0041..005A ; Latin # comment", of a codepoint (range)
+    /// and up to two values, trimmed.
+    struct ucd_record
+    {
+        char32_t first;
+        char32_t last;
+        std::array<string_view, 2> values;
+    };
+
+    optional<ucd_record> parse_record(string_view line) noexcept
+    {
+        if (auto const comment = line.find('#'); comment != string_view::npos)
+            line = line.substr(0, comment);
+
+        auto const fieldEnd = line.find(';');
+        if (fieldEnd == string_view::npos)
+            return nullopt;
+        auto const codepoints = trimmed(line.substr(0, fieldEnd));
+        auto const separator = codepoints.find("..");
+        auto const first = parse_codepoint(codepoints.substr(0, separator));
+        auto const last =
+            separator == string_view::npos ? first : parse_codepoint(codepoints.substr(separator + 2));
+        if (!first || !last || *first > *last || *last > 0x10FFFF)
+            return nullopt;
+
+        auto record = ucd_record { *first, *last, {} };
+        auto rest = line.substr(fieldEnd + 1);
+        for (auto& value: record.values)
+        {
+            auto const end = rest.find(';');
+            value = trimmed(rest.substr(0, end));
+            if (end == string_view::npos)
+                break;
+            rest.remove_prefix(end + 1);
+        }
+        if (record.values[0].empty())
+            return nullopt;
+        return record;
+    }
+
+    template <typename T>
+    void for_each_line(string_view text, T callback)
+    {
+        while (!text.empty())
+        {
+            auto const end = text.find('\n');
+            callback(text.substr(0, end));
+            if (end == string_view::npos)
+                break;
+            text.remove_prefix(end + 1);
+        }
+    }
+
+    /// A UCD file, read at once and split into its records.
+    struct ucd_file
+    {
+        string contents;
+        vector<ucd_record> records;
+    };
+
+    ucd_file read_ucd_file(string const& filePath)
+    {
+        auto f = ifstream(filePath, std::ios::binary);
+        if (!f.good())
+            throw std::runtime_error("Could not open file: "s + filePath);
+
+        auto file = ucd_file {};
+        f.seekg(0, std::ios::end);
+        file.contents.resize(static_cast<size_t>(f.tellg()));
+        f.seekg(0, std::ios::beg);
+        f.read(file.contents.data(), static_cast<std::streamsize>(file.contents.size()));
+        if (!f.good())
+            throw std::runtime_error("Could not read file: "s + filePath);
+
+        for_each_line(file.contents, [&](string_view line) {
+            if (auto const record = parse_record(line); record.has_value())
+                file.records.emplace_back(*record);
+        });
+        return file;
+    }
+
+    // The UCD files the loader reads, which are read and parsed in parallel up front.
+    constexpr auto UcdFilePaths = array { // NOLINT(readability-identifier-naming)
+        "Scripts.txt"sv,
+        "PropertyValueAliases.txt"sv,
+        "ScriptExtensions.txt"sv,
+        "DerivedCoreProperties.txt"sv,
+        "DerivedAge.txt"sv,
+        "extracted/DerivedGeneralCategory.txt"sv,
+        "extracted/DerivedName.txt"sv,
+        "auxiliary/GraphemeBreakProperty.txt"sv,
+        "auxiliary/WordBreakProperty.txt"sv,
+        "EastAsianWidth.txt"sv,
+        "VerticalOrientation.txt"sv,
+        "LineBreak.txt"sv,
+        "extracted/DerivedCombiningClass.txt"sv,
+        "DerivedNormalizationProps.txt"sv,
+        "emoji/emoji-data.txt"sv,
+    };
+    // }}}
+
     class codepoint_properties_loader
     {
       public:
-        static std::tuple<codepoint_properties_table, codepoint_names_table> load_from_directory(
-            string const& ucdDataDirectory, std::ostream* log = nullptr);
+        static loaded_tables load_from_directory(string const& ucdDataDirectory, std::ostream* log = nullptr);
 
       private:
         using tables_view = codepoint_properties::tables_view;
@@ -442,6 +717,10 @@ namespace
         codepoint_properties_loader(string ucdDataDirectory, std::ostream* log = nullptr);
 
         void load();
+        void load_names();
+        void load_script_extensions();
+        void load_line_break();
+        void load_normalization();
         void create_multistage_tables();
 
         [[nodiscard]] codepoint_properties& properties(char32_t codepoint) noexcept
@@ -449,48 +728,49 @@ namespace
             return _codepoints[static_cast<size_t>(codepoint)];
         }
 
+        void insert_identifier(identifier_bitmap::property property, char32_t codepoint) noexcept
+        {
+            auto constexpr BlockSize = identifier_bitmap::BlockSize;
+            auto const index = static_cast<size_t>(codepoint);
+            _identifiers[index / BlockSize].insert(property, index % BlockSize);
+        }
+
+        /// Waits for the given UCD file to be read and parsed.
+        [[nodiscard]] ucd_file const& file(string_view filePathSuffix) const
+        {
+            return _files.at(filePathSuffix).get();
+        }
+
         template <typename T>
-        void process_properties(string const& filePathSuffix, T callback)
+        void process_properties(string_view filePathSuffix, T callback)
         {
-            auto const _ = scoped_timer { _log, "Loading file " + filePathSuffix };
-
-            // clang-format off
-            // [SPACE] ALNUMDOT ([SPACE] ALNUMDOT)::= (\s+[A-Za-z_0-9\.]+)*
-            auto const singleCodepointPattern = regex(R"(^([0-9A-F]+)\s*;\s*([A-Za-z_0-9\.]+(\s+[A-Za-z_0-9\.]+)*))");
-            auto const codepointRangePattern = regex(R"(^([0-9A-F]+)\.\.([0-9A-F]+)\s*;\s*([A-Za-z_0-9\.]+))");
-            // clang-format on
-
-            auto const filePath = _ucdDataDirectory + "/" + filePathSuffix;
-            auto f = ifstream(filePath);
-            if (!f.good())
-                throw std::runtime_error("Could not open file: "s + filePath);
-            while (f.good())
-            {
-                string line;
-                getline(f, line);
-                auto sm = smatch {};
-                if (regex_search(line, sm, singleCodepointPattern))
-                {
-                    auto const codepoint = static_cast<char32_t>(stoul(sm[1], nullptr, 16));
-                    callback(codepoint, sm.str(2));
-                }
-                else if (regex_search(line, sm, codepointRangePattern))
-                {
-                    auto const first = static_cast<char32_t>(stoul(sm[1], nullptr, 16));
-                    auto const last = static_cast<char32_t>(stoul(sm[2], nullptr, 16));
-                    for (auto codepoint = first; codepoint <= last; ++codepoint)
-                        callback(codepoint, sm.str(3));
-                }
-            }
+            auto const _ = scoped_timer { _log, "Loading file "s + string(filePathSuffix) };
+
+            for (auto const& record: file(filePathSuffix).records)
+                for (auto codepoint = record.first; codepoint <= record.last; ++codepoint)
+                    callback(codepoint, record.values[0]);
         }
 
         string _ucdDataDirectory;
         std::ostream* _log;
+        std::unordered_map<string_view, std::shared_future<ucd_file>> _files {};
         vector<codepoint_properties> _codepoints {}; // Meh!
         codepoint_properties_table _output {};
 
         vector<std::string> _names {};
         codepoint_names_table _outputNames {};
+
+        vector<uint8_t> _scriptExtensions {}; // index into _outputScripts.sets, for each codepoint
+        script_properties_table _outputScripts {};
+
+        vector<break_properties> _breaks {};
+        break_properties_table _outputBreaks {};
+
+        vector<normalization_properties> _normalization {};
+        normalization_properties_table _outputNormalization {};
+
+        vector<identifier_bitmap> _identifiers {}; // for each block of codepoints
+        identifier_bitmaps_table _outputIdentifiers {};
     };
 
     codepoint_properties_loader::codepoint_properties_loader(string ucdDataDirectory, std::ostream* log):
@@ -498,6 +778,17 @@ namespace
     {
         _codepoints.resize(0x110'000);
         _names.resize(0x110'000);
+        _scriptExtensions.resize(0x110'000, script_properties::NoExtensions);
+        _breaks.resize(0x110'000);
+        _normalization.resize(0x110'000);
+        _identifiers.resize(0x110'000 / identifier_bitmap::BlockSize);
+
+        for (auto const filePathSuffix: UcdFilePaths)
+            _files.emplace(filePathSuffix,
+                           std::async(std::launch::async,
+                                      read_ucd_file,
+                                      _ucdDataDirectory + "/" + string(filePathSuffix))
+                               .share());
 
         // _output.names.emplace_back(""); // All unassigned codepoints point here.
     }
@@ -508,6 +799,8 @@ namespace
             properties(codepoint).script = make_script(value).value_or(unicode::Script::Invalid);
         });
 
+        load_script_extensions();
+
         process_properties("DerivedCoreProperties.txt", [&](char32_t codepoint, string_view value) {
             // Generically written such that we can easily add more core properties here, once relevant.
             auto static constexpr mappings = array {
@@ -519,8 +812,18 @@ namespace
 
             if (auto const i = find_if(begin(mappings), end(mappings), equalName); i != end(mappings))
                 properties(codepoint).flags |= i->second;
+            else if (value == "XID_Start")
+                insert_identifier(identifier_bitmap::property::Start, codepoint);
+            else if (value == "XID_Continue")
+                insert_identifier(identifier_bitmap::property::Continue, codepoint);
         });
 
+        // Pattern_White_Space is immutable as per the Unicode Character Encoding Stability Policy,
+        // so it is not worth reading it from PropList.txt.
+        for (char32_t const codepoint: array<char32_t, 11> {
+                 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x0020, 0x0085, 0x200E, 0x200F, 0x2028, 0x2029 })
+            insert_identifier(identifier_bitmap::property::PatternWhiteSpace, codepoint);
+
         process_properties("DerivedAge.txt", [&](char32_t codepoint, string_view value) {
             properties(codepoint).age = make_age(value).value_or(unicode::Age::Unassigned);
         });
@@ -530,19 +833,27 @@ namespace
                                properties(codepoint).general_category = make_general_category(value).value();
                            });
 
-        // Prep-work for names loading
-        process_properties("extracted/DerivedName.txt", [&](char32_t codepoint, string_view value) {
-            _names[static_cast<size_t>(codepoint)] = string(value.data(), value.size());
-        });
+        load_names();
 
         process_properties("auxiliary/GraphemeBreakProperty.txt", [&](char32_t codepoint, string_view value) {
             properties(codepoint).grapheme_cluster_break = make_gb(value).value();
         });
 
+        process_properties("auxiliary/WordBreakProperty.txt", [&](char32_t codepoint, string_view value) {
+            _breaks[static_cast<size_t>(codepoint)].word_break = make_word_break(value).value();
+        });
+
         process_properties("EastAsianWidth.txt", [&](char32_t codepoint, string_view value) {
             properties(codepoint).east_asian_width = make_width(value).value();
         });
 
+        process_properties("VerticalOrientation.txt", [&](char32_t codepoint, string_view value) {
+            properties(codepoint).vertical_orientation = make_vertical_orientation(value).value();
+        });
+
+        load_line_break();
+        load_normalization();
+
         // {{{ fill EmojiSegmentationCategory and other emoji related properties
         // clang-format off
         properties(0x20e3).emoji_segmentation_category = EmojiSegmentationCategory::CombiningEnclosingKeyCap;
@@ -587,6 +898,23 @@ namespace
         }
         // }}}
 
+        for (char32_t codepoint = 0; codepoint < 0x110'000; ++codepoint)
+        {
+            auto const& source = properties(codepoint);
+            auto& flags = _breaks[static_cast<size_t>(codepoint)].flags;
+            if (source.extended_pictographic())
+                flags |= break_properties::FlagExtendedPictographic;
+            if (source.general_category == General_Category::Nonspacing_Mark
+                || source.general_category == General_Category::Spacing_Mark)
+                flags |= break_properties::FlagMark;
+            if (source.general_category == General_Category::Unassigned)
+                flags |= break_properties::FlagUnassigned;
+            if (source.east_asian_width == East_Asian_Width::Fullwidth
+                || source.east_asian_width == East_Asian_Width::Wide
+                || source.east_asian_width == East_Asian_Width::Halfwidth)
+                flags |= break_properties::FlagEastAsianWide;
+        }
+
         // {{{ assign char_width
         {
             auto const _ = scoped_timer { _log, "Assigning char_width" };
@@ -596,21 +924,223 @@ namespace
         // }}}
     }
 
-    std::tuple<codepoint_properties_table, codepoint_names_table> codepoint_properties_loader::
-        load_from_directory(string const& ucdDataDirectory, std::ostream* log)
+    void codepoint_properties_loader::load_names()
+    {
+        auto constexpr FilePathSuffix = "extracted/DerivedName.txt"sv;
+        auto const _ = scoped_timer { _log, "Loading file "s + string(FilePathSuffix) };
+
+        // Names may contain spaces and hyphens. Ranges of algorithmically derived names
+        // end with "-*", a placeholder for the codepoint in hexadecimal.
+        for (auto const& record: file(FilePathSuffix).records)
+        {
+            auto const name = string(record.values[0]);
+            for (auto codepoint = record.first; codepoint <= record.last; ++codepoint)
+                _names[static_cast<size_t>(codepoint)] = name;
+        }
+
+        // Hangul syllable names are derived from their Jamo short names (Unicode, chapter 3.12),
+        // "*" being a placeholder for those, too.
+        for (char32_t codepoint = 0xAC00; codepoint <= 0xD7A3; ++codepoint)
+            _names[static_cast<size_t>(codepoint)] = "HANGUL SYLLABLE *";
+    }
+
+    void codepoint_properties_loader::load_script_extensions()
+    {
+        // Script_Extensions refer to scripts by their short names (e.g. "Latn"), which are mapped
+        // to their long names (e.g. "Latin") in PropertyValueAliases.txt.
+        auto shortNames = std::unordered_map<string, Script> {};
+        {
+            auto constexpr FilePathSuffix = "PropertyValueAliases.txt"sv;
+            auto const _ = scoped_timer { _log, "Loading file "s + string(FilePathSuffix) };
+
+            // Lines of the form "sc ; Latn ; Latin", which are not of a codepoint, hence this own parsing.
+            for_each_line(file(FilePathSuffix).contents, [&](string_view line) {
+                auto fields = std::array<string_view, 3> {};
+                for (auto& field: fields)
+                {
+                    auto const end = line.find_first_of(";#");
+                    field = trimmed(line.substr(0, end));
+                    if (end == string_view::npos || line[end] == '#')
+                        break;
+                    line.remove_prefix(end + 1);
+                }
+                if (fields[0] == "sc" && !fields[1].empty() && !fields[2].empty())
+                    shortNames[string(fields[1])] = make_script(fields[2]).value_or(unicode::Script::Invalid);
+            });
+        }
+
+        // Index 0 is reserved for codepoints whose Script_Extensions are just their Script.
+        _outputScripts.sets.resize(1);
+        auto setIndices = std::unordered_map<string, uint8_t> {};
+
+        process_properties("ScriptExtensions.txt", [&](char32_t codepoint, string_view value) {
+            auto [iter, inserted] = setIndices.try_emplace(string(value), uint8_t {});
+            if (inserted)
+            {
+                auto scripts = script_set {};
+                auto words = std::istringstream(string(value));
+                for (string name; words >> name;)
+                {
+                    auto const script = shortNames.find(name);
+                    if (script == shortNames.end())
+                        throw std::runtime_error("Unknown script in Script_Extensions: "s + name);
+                    if (static_cast<size_t>(script->second) >= script_set::Capacity)
+                        throw std::runtime_error("Script does not fit into script_set: "s + name);
+                    scripts.insert(script->second);
+                }
+                if (_outputScripts.sets.size() > std::numeric_limits<uint8_t>::max())
+                    throw std::runtime_error("Too many distinct Script_Extensions sets.");
+                iter->second = static_cast<uint8_t>(_outputScripts.sets.size());
+                _outputScripts.sets.push_back(scripts);
+            }
+            _scriptExtensions[static_cast<size_t>(codepoint)] = iter->second;
+        });
+    }
+
+    void codepoint_properties_loader::load_line_break()
+    {
+        auto const lineBreak = [&](string_view value) {
+            if (auto const result = make_line_break(value); result.has_value())
+                return *result;
+            throw std::runtime_error("Unknown Line_Break value: "s + string(value));
+        };
+
+        // Unlisted codepoints default to Unknown, except for the ranges given by @missing lines,
+        // such as Ideographic for the CJK and the pictographic blocks.
+        for_each_line(file("LineBreak.txt").contents, [&](string_view line) {
+            auto constexpr Missing = "@missing:"sv;
+            if (!line.starts_with('#'))
+                return;
+            line = trimmed(line.substr(1));
+            if (!line.starts_with(Missing))
+                return;
+            auto const record = parse_record(line.substr(Missing.size()));
+            if (!record.has_value())
+                return;
+            auto const value = lineBreak(record->values[0]);
+            for (auto codepoint = record->first; codepoint <= record->last; ++codepoint)
+                _breaks[static_cast<size_t>(codepoint)].line_break = value;
+        });
+
+        process_properties("LineBreak.txt", [&](char32_t codepoint, string_view value) {
+            _breaks[static_cast<size_t>(codepoint)].line_break = lineBreak(value);
+        });
+    }
+
+    void codepoint_properties_loader::load_normalization()
+    {
+        process_properties("extracted/DerivedCombiningClass.txt", [&](char32_t codepoint, string_view value) {
+            auto const combiningClass = stoul(string(value));
+            if (combiningClass > std::numeric_limits<uint8_t>::max())
+                throw std::runtime_error("Canonical_Combining_Class out of range: "s + string(value));
+            _normalization[static_cast<size_t>(codepoint)].canonical_combining_class =
+                static_cast<uint8_t>(combiningClass);
+        });
+
+        // The quick check properties are listed along with their value, such as "NFC_QC; M",
+        // where unlisted codepoints are Yes.
+        auto constexpr FilePathSuffix = "DerivedNormalizationProps.txt"sv;
+        auto const _ = scoped_timer { _log, "Loading file "s + string(FilePathSuffix) };
+
+        auto static constexpr mappings = array {
+            pair { "NFC_QC; N"sv, normalization_properties::FlagNFCQuickCheckNo },
+            pair { "NFC_QC; M"sv, normalization_properties::FlagNFCQuickCheckMaybe },
+            pair { "NFD_QC; N"sv, normalization_properties::FlagNFDQuickCheckNo },
+            pair { "NFKC_QC; N"sv, normalization_properties::FlagNFKCQuickCheckNo },
+            pair { "NFKC_QC; M"sv, normalization_properties::FlagNFKCQuickCheckMaybe },
+            pair { "NFKD_QC; N"sv, normalization_properties::FlagNFKDQuickCheckNo },
+        };
+        for (auto const& record: file(FilePathSuffix).records)
+        {
+            auto const& [property, quickCheck] = record.values;
+            if (!property.ends_with("_QC") || (quickCheck != "N" && quickCheck != "M"))
+                continue;
+            auto const value = string(property) + "; " + string(quickCheck);
+            auto const equalName = [&](auto x) {
+                return x.first == value;
+            };
+            auto const i = find_if(begin(mappings), end(mappings), equalName);
+            if (i == end(mappings))
+                throw std::runtime_error("Unknown quick check value: "s + value);
+            for (auto codepoint = record.first; codepoint <= record.last; ++codepoint)
+                _normalization[static_cast<size_t>(codepoint)].flags |= i->second;
+        }
+    }
+
+    loaded_tables codepoint_properties_loader::load_from_directory(string const& ucdDataDirectory,
+                                                                   std::ostream* log)
     {
         auto loader = codepoint_properties_loader { ucdDataDirectory, log };
         loader.load();
         loader.create_multistage_tables();
 
-        return { std::move(loader._output), std::move(loader._outputNames) };
+        return { std::move(loader._output),
+                 std::move(loader._outputNames),
+                 std::move(loader._outputScripts),
+                 std::move(loader._outputBreaks),
+                 std::move(loader._outputNormalization),
+                 std::move(loader._outputIdentifiers) };
     }
 
     void codepoint_properties_loader::create_multistage_tables()
     {
         {
             auto const _ = scoped_timer { _log, "Creating multistage tables (properties)" };
-            support::generate(_codepoints.data(), _codepoints.size(), _output);
+
+            auto input = vector<combined_properties>(_codepoints.size());
+            for (size_t i = 0; i < input.size(); ++i)
+                input[i] = { _codepoints[i],
+                             { _codepoints[i].script, _scriptExtensions[i] },
+                             _breaks[i],
+                             _normalization[i] };
+
+            auto combined = combined_properties_table {};
+            support::generate(input.data(), input.size(), combined);
+
+            auto const split = [](vector<combined_properties> const& values,
+                                  vector<codepoint_properties>& properties,
+                                  vector<script_properties>& scripts,
+                                  vector<break_properties>& breaks,
+                                  vector<normalization_properties>& normalization) {
+                for (auto const& value: values)
+                {
+                    properties.emplace_back(value.properties);
+                    scripts.emplace_back(value.scripts);
+                    breaks.emplace_back(value.breaks);
+                    normalization.emplace_back(value.normalization);
+                }
+            };
+            _output.stage1 = std::move(combined.stage1);
+            _output.stage2 = std::move(combined.stage2);
+            split(combined.stage3,
+                  _output.stage3,
+                  _outputScripts.stage3,
+                  _outputBreaks.stage3,
+                  _outputNormalization.stage3);
+            split(combined.direct,
+                  _output.direct,
+                  _outputScripts.direct,
+                  _outputBreaks.direct,
+                  _outputNormalization.direct);
+        }
+
+        {
+            auto const _ = scoped_timer { _log, "Deduplicating identifier bitmaps" };
+
+            // Most blocks have no identifier characters at all, and thus share a single bitmap.
+            auto indices = std::map<std::array<uint64_t, identifier_bitmap::WordCount>, uint8_t> {};
+            for (auto const& block: _identifiers)
+            {
+                auto const index = static_cast<uint8_t>(_outputIdentifiers.blocks.size());
+                auto const [i, inserted] = indices.try_emplace(block.words(), index);
+                if (inserted)
+                {
+                    if (_outputIdentifiers.blocks.size() > std::numeric_limits<uint8_t>::max())
+                        throw std::runtime_error("Too many distinct identifier bitmaps.");
+                    _outputIdentifiers.blocks.push_back(block);
+                }
+                _outputIdentifiers.stage1.push_back(i->second);
+            }
         }
 
         {
@@ -620,8 +1150,13 @@ namespace
     }
 } // namespace
 
-std::tuple<codepoint_properties_table, codepoint_names_table> load_from_directory(
-    std::string const& ucdDataDirectory, std::ostream* log)
+std::tuple<codepoint_properties_table,
+           codepoint_names_table,
+           script_properties_table,
+           break_properties_table,
+           normalization_properties_table,
+           identifier_bitmaps_table>
+load_from_directory(std::string const& ucdDataDirectory, std::ostream* log)
 {
     return codepoint_properties_loader::load_from_directory(ucdDataDirectory, log);
 }
@@ -16,17 +16,20 @@
 #include <libunicode/codepoint_properties.h>
 #include <libunicode/multistage_table_generator.h>
 
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace unicode
 {
 
 using codepoint_properties_table = support::multistage_table<codepoint_properties,
-                                                             uint32_t,     // source type
-                                                             uint8_t,      // stage 1
-                                                             uint16_t,     // stage 2
-                                                             256,          // block size
-                                                             0x110'000 - 1 // max value
+                                                             uint32_t,      // source type
+                                                             uint16_t,      // stage 1
+                                                             uint16_t,      // stage 2
+                                                             128,           // block size
+                                                             0x110'000 - 1, // max value
+                                                             0x800          // direct size
                                                              >;
 
 using codepoint_names_table = support::multistage_table<std::string,
@@ -37,7 +40,44 @@ using codepoint_names_table = support::multistage_table<std::string,
                                                         0x110'000 - 1 // max value
                                                         >;
 
-std::tuple<codepoint_properties_table, codepoint_names_table> load_from_directory(
-    std::string const& ucdDataDirectory, std::ostream* log);
+/// Script properties for each of the values of a codepoint_properties_table, sharing its stage 1
+/// and stage 2, along with the distinct Script_Extensions sets they refer to.
+struct script_properties_table
+{
+    std::vector<script_properties> stage3;
+    std::vector<script_properties> direct;
+    std::vector<script_set> sets;
+};
+
+/// Break properties for each of the values of a codepoint_properties_table, sharing its stage 1 and stage 2.
+struct break_properties_table
+{
+    std::vector<break_properties> stage3;
+    std::vector<break_properties> direct;
+};
+
+/// Normalization properties for each of the values of a codepoint_properties_table, sharing its stage 1
+/// and stage 2.
+struct normalization_properties_table
+{
+    std::vector<normalization_properties> stage3;
+    std::vector<normalization_properties> direct;
+};
+
+/// Identifier property bitmaps for each block of identifier_bitmap::BlockSize codepoints,
+/// as indices into the distinct bitmaps.
+struct identifier_bitmaps_table
+{
+    std::vector<uint8_t> stage1;
+    std::vector<identifier_bitmap> blocks;
+};
+
+std::tuple<codepoint_properties_table,
+           codepoint_names_table,
+           script_properties_table,
+           break_properties_table,
+           normalization_properties_table,
+           identifier_bitmaps_table>
+load_from_directory(std::string const& ucdDataDirectory, std::ostream* log);
 
 } // namespace unicode
@@ -0,0 +1,266 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/multistage_table_generator.h>
+#if defined(LIBUNICODE_CONSTEXPR_TABLES)
+    #include <libunicode/codepoint_properties_constexpr.h>
+#endif
+#include <libunicode/ucd.h>
+#include <libunicode/width.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using unicode::codepoint_properties;
+using unicode::Grapheme_Cluster_Break;
+using unicode::Script;
+
+TEST_CASE("codepoint_properties.get_many")
+{
+    // All codepoints, plus some out-of-range values that must resolve like U+0000.
+    auto codepoints = std::vector<char32_t> {};
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+        codepoints.push_back(codepoint);
+    codepoints.insert(codepoints.end(), { 0x110000, 0x7FFFFFFF, 0xFFFFFFFF, U'A' });
+
+    auto properties = std::vector<codepoint_properties>(codepoints.size());
+    auto widths = std::vector<uint8_t>(codepoints.size());
+    auto breaks = std::vector<Grapheme_Cluster_Break>(codepoints.size());
+
+    codepoint_properties::get_many(codepoints.data(), codepoints.size(), properties.data());
+    codepoint_properties::get_char_widths(codepoints.data(), codepoints.size(), widths.data());
+    codepoint_properties::get_grapheme_cluster_breaks(codepoints.data(), codepoints.size(), breaks.data());
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < codepoints.size(); ++i)
+    {
+        auto const expected = codepoint_properties::get(codepoints[i]);
+        if (properties[i] != expected || widths[i] != expected.char_width
+            || breaks[i] != expected.grapheme_cluster_break)
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("codepoint_properties.get_many.partial")
+{
+    // Counts that are not a multiple of the vector width, and must not write past count.
+    auto const codepoints = std::u32string_view(
+        U"A\u00E9\u4E00\U0001F600\u0301\u200D\U0001F1E6B\uFE0F\u1100\uAC00\u0E33");
+    for (size_t count = 0; count <= codepoints.size(); ++count)
+    {
+        auto widths = std::vector<uint8_t>(codepoints.size(), 0xFF);
+        codepoint_properties::get_char_widths(codepoints.data(), count, widths.data());
+        for (size_t i = 0; i < codepoints.size(); ++i)
+            CHECK(widths[i] == (i < count ? codepoint_properties::get(codepoints[i]).char_width : 0xFF));
+    }
+}
+
+TEST_CASE("codepoint_properties.direct")
+{
+    // The flat table for the low range must agree with walking all table stages.
+    auto const& tables = codepoint_properties::configured_tables();
+    auto const& narrowTables = unicode::narrow_codepoint_properties::configured_tables();
+    size_t mismatches = 0;
+    for (char32_t codepoint = 0; codepoint < codepoint_properties::direct_size; ++codepoint)
+    {
+        auto const stage2Index = tables.stage1[codepoint / tables.block_size] * tables.block_size
+                                 + codepoint % tables.block_size;
+        if (tables.get(codepoint) != tables.stage3[tables.stage2[stage2Index]]
+            || narrowTables.get(codepoint) != narrowTables.stage3[narrowTables.stage2[stage2Index]])
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("codepoint_properties.narrow")
+{
+    size_t mismatches = 0;
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+    {
+        auto const properties = codepoint_properties::get(codepoint);
+        auto const narrow = unicode::narrow_codepoint_properties::get(codepoint);
+        if (narrow.char_width() != properties.char_width
+            || narrow.grapheme_cluster_break() != properties.grapheme_cluster_break
+            || narrow.extended_pictographic() != properties.extended_pictographic())
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+    CHECK(unicode::narrow_codepoint_properties::get(0x110000) == unicode::narrow_codepoint_properties::get(0));
+}
+
+#if defined(LIBUNICODE_CONSTEXPR_TABLES)
+// Box drawing, CJK, emoji and combining characters, as looked up at compile time.
+static_assert(unicode::precompiled::width(U'A') == 1);
+static_assert(unicode::precompiled::width(U'\u2500') == 1);
+static_assert(unicode::precompiled::width(U'\u4E00') == 2);
+static_assert(unicode::precompiled::width(U'\U0001F600') == 2);
+static_assert(unicode::precompiled::width(U'\u0301') == 0);
+static_assert(unicode::precompiled::get(U'\u2500').general_category
+              == unicode::General_Category::Other_Symbol);
+static_assert(unicode::precompiled::get_narrow(0x110000) == unicode::precompiled::get_narrow(0));
+
+TEST_CASE("codepoint_properties.constexpr")
+{
+    size_t mismatches = 0;
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+    {
+        using unicode::narrow_codepoint_properties;
+        if (unicode::precompiled::get(codepoint) != codepoint_properties::get(codepoint)
+            || unicode::precompiled::get_narrow(codepoint) != narrow_codepoint_properties::get(codepoint)
+            || unicode::precompiled::width(codepoint) != unicode::width(codepoint))
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+}
+#endif
+
+TEST_CASE("codepoint_properties.script")
+{
+    // Agrees with the Script and Script_Extensions lookups generated into ucd.cpp.
+    size_t mismatches = 0;
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+    {
+        auto const properties = unicode::script_properties::get(codepoint);
+
+        auto extensions = std::array<Script, 64> {};
+        auto const count = unicode::script_extensions(codepoint, extensions.data(), extensions.size());
+        auto expected = unicode::script_set {};
+        for (size_t i = 0; i < count; ++i)
+            expected.insert(extensions[i]);
+
+        if (properties.script != codepoint_properties::get(codepoint).script
+            || properties.script != unicode::script(codepoint) || properties.script_extensions() != expected)
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+
+    auto const danda = unicode::script_properties::get(0x0964).script_extensions();
+    CHECK(danda.contains(Script::Devanagari));
+    CHECK(danda.contains(Script::Bengali));
+    CHECK(!danda.contains(Script::Common));
+    CHECK(unicode::script_properties::get(U'A').script_extensions() == unicode::script_set { Script::Latin });
+}
+
+TEST_CASE("script_set")
+{
+    auto set = unicode::script_set { Script::Latin, Script::Greek, Script::Zanabazar_Square };
+    CHECK(set.size() == 3);
+    CHECK(set.contains(Script::Zanabazar_Square));
+    CHECK(!set.contains(Script::Han));
+    CHECK(set.first() == std::min(Script::Latin, Script::Greek));
+
+    auto const intersection = set & unicode::script_set { Script::Greek, Script::Han };
+    CHECK(intersection == unicode::script_set { Script::Greek });
+    CHECK((intersection | unicode::script_set { Script::Han }).size() == 2);
+
+    set.erase(Script::Latin);
+    set.erase(Script::Greek);
+    CHECK(set.first() == Script::Zanabazar_Square);
+    set.erase(Script::Zanabazar_Square);
+    CHECK(set.empty());
+    CHECK(set.first() == Script::Invalid);
+}
+
+TEST_CASE("ucd.property_accessors")
+{
+    // Agrees with the properties loaded by tablegen, whichever kind of tables ucd.cpp was generated with.
+    size_t mismatches = 0;
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+    {
+        auto const& properties = codepoint_properties::get(codepoint);
+        if (unicode::general_category::get(codepoint) != properties.general_category
+            || unicode::script(codepoint) != properties.script)
+            ++mismatches;
+    }
+    CHECK(mismatches == 0);
+
+    CHECK(unicode::block(U'A') == unicode::Block::Basic_Latin);
+    CHECK(unicode::bidi_class(U'A') == unicode::Bidi_Class::Left_To_Right);
+    CHECK(unicode::bidi_class(0x05D0) == unicode::Bidi_Class::Right_To_Left);
+    CHECK(unicode::line_break(U'0') == unicode::Line_Break::Numeric);
+    CHECK(unicode::line_break(U'(') == unicode::Line_Break::Open_Punctuation);
+    CHECK(unicode::word_break(U'a') == unicode::Word_Break::ALetter);
+    CHECK(unicode::word_break(U'0') == unicode::Word_Break::Numeric);
+
+    // Codepoints beyond U+10FFFF get the default values.
+    CHECK(unicode::block(0x110000) == unicode::Block::Unspecified);
+    CHECK(unicode::script(0x110000) == Script::Unknown);
+    CHECK(unicode::line_break(0x110000) == unicode::Line_Break::Unknown);
+    CHECK(unicode::word_break(0x110000) == unicode::Word_Break::Other);
+}
+
+TEST_CASE("codepoint_properties.name")
+{
+    CHECK(codepoint_properties::name(U'A') == "LATIN CAPITAL LETTER A");
+    CHECK(codepoint_properties::name(U'-') == "HYPHEN-MINUS");
+    CHECK(codepoint_properties::name(0x11AA) == "HANGUL JONGSEONG KIYEOK-SIOS");
+    CHECK(codepoint_properties::name(0x1F600) == "GRINNING FACE");
+    CHECK(codepoint_properties::name(0x0378).empty()); // unassigned
+
+    // Algorithmically derived names.
+    CHECK(codepoint_properties::name(0x4E00) == "CJK UNIFIED IDEOGRAPH-4E00");
+    CHECK(codepoint_properties::name(0x9FFF) == "CJK UNIFIED IDEOGRAPH-9FFF");
+    CHECK(codepoint_properties::name(0xAC00) == "HANGUL SYLLABLE GA");
+    CHECK(codepoint_properties::name(0xAC01) == "HANGUL SYLLABLE GAG");
+    CHECK(codepoint_properties::name(0xC544) == "HANGUL SYLLABLE A");
+    CHECK(codepoint_properties::name(0xD7A3) == "HANGUL SYLLABLE HIH");
+
+    // Decoding into a caller provided buffer.
+    char buffer[unicode::codepoint_names_view::MaxNameLength];
+    CHECK(codepoint_properties::name(0x4E01, buffer) == "CJK UNIFIED IDEOGRAPH-4E01");
+    CHECK(codepoint_properties::name(U'A', std::span(buffer, 5)) == "LATIN");
+    CHECK(codepoint_properties::name(U'A', std::span<char>()).empty());
+}
+
+TEST_CASE("multistage_table.generate")
+{
+    // Two distinct blocks of 4 (one of them repeated), using three distinct values.
+    auto const input = std::vector<uint32_t> { 1, 2, 3, 1, 1, 1, 1, 1, 1, 2, 3, 1, 7, 7, 7, 7 };
+
+    auto table = support::multistage_table<uint32_t, uint32_t, uint8_t, uint8_t, 4, 15, 2> {};
+    support::generate(input.data(), input.size(), table);
+
+    CHECK(table.stage1 == std::vector<uint8_t> { 0, 1, 0, 2 });
+    CHECK(table.stage2.size() == 3 * 4);
+    CHECK(table.stage3 == std::vector<uint32_t> { 1, 2, 3, 7 });
+    CHECK(table.direct == std::vector<uint32_t> { 1, 2 });
+    for (uint32_t i = 0; i < input.size(); ++i)
+        CHECK(table.get(i) == input[i]);
+}
+
+TEST_CASE("multistage_table.explore_layout")
+{
+    auto input = std::vector<uint32_t>(1024);
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] = i < 512 ? 0 : uint32_t(i % 4);
+
+    // Single index stage: stage 1 (1024 / 16 elements), two unique blocks of 16, four values.
+    auto const twoLevels = support::explore_layout(input.data(), input.size(), { 16 }, 0);
+    CHECK(twoLevels.stageSizes == std::vector<size_t> { 64, 2 * 16, 4 });
+    CHECK(twoLevels.stageElementSizes == std::vector<size_t> { 1, 1, 4 });
+    CHECK(twoLevels.totalBytes == 64 + 32 + 16);
+    CHECK(twoLevels.cacheLinesPerLookup == 3);
+
+    // Two index stages: stage 1 (1024 / 64 elements), two unique blocks of 4 (of block numbers),
+    // two unique blocks of 16 and four values.
+    auto const threeLevels = support::explore_layout(input.data(), input.size(), { 4, 16 }, input.size());
+    CHECK(threeLevels.stageSizes == std::vector<size_t> { 16, 2 * 4, 2 * 16, 4 });
+    CHECK(threeLevels.totalBytes == 16 + 8 + 32 + 16);
+    CHECK(threeLevels.cacheLinesPerLookup == 4);
+    CHECK(threeLevels.probedCacheLines == 4); // each stage fits into a single cache line
+}
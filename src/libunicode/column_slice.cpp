@@ -0,0 +1,421 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/column_slice.h>
+#include <libunicode/convert.h>
+#include <libunicode/grapheme_segmenter.h>
+#include <libunicode/scan.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace unicode
+{
+
+namespace
+{
+    constexpr bool is_control(char ch) noexcept
+    {
+        return static_cast<uint8_t>(ch) < 0x20;
+    }
+
+    /// Adapts a visitor of grapheme clusters into a receiver for scan_text(),
+    /// which stops scanning once the visitor is done.
+    template <typename Visitor>
+    struct column_receiver
+    {
+        Visitor& visitor;
+
+        // Start of the grapheme cluster continuing the one scanned by a previous call, if any.
+        char const* continuation = nullptr;
+
+        // End and last character of the last US-ASCII sequence received, as scan_text() passes
+        // codepoints continuing its last grapheme cluster (e.g. VS16 or combining marks) on their own.
+        char const* asciiEnd = nullptr;
+        char asciiLast = 0;
+
+        [[nodiscard]] size_t remaining() const noexcept
+        {
+            return visitor.done ? 0 : std::numeric_limits<size_t>::max();
+        }
+
+        void receiveAsciiSequence(std::string_view sequence) noexcept
+        {
+            visitor.ascii(sequence.data(), sequence.size());
+            asciiEnd = sequence.data() + sequence.size();
+            asciiLast = sequence.back();
+        }
+
+        void receiveGraphemeCluster(std::string_view cluster, size_t columnCount) noexcept
+        {
+            if (cluster.data() == continuation
+                || (cluster.data() == asciiEnd
+                    && !grapheme_segmenter::breakable(static_cast<char32_t>(asciiLast),
+                                                      decode_utf8_sequence(cluster).value)))
+                visitor.extend(columnCount);
+            else
+                visitor.cluster(cluster.data(), columnCount);
+            asciiEnd = nullptr;
+        }
+
+        void receiveInvalidGraphemeCluster(std::string_view sequence) noexcept
+        {
+            visitor.cluster(sequence.data(), 1);
+            asciiEnd = nullptr;
+        }
+    };
+
+    /// Passes the grapheme clusters of @p text from the byte @p offset on to @p visitor, along with
+    /// their widths, until the visitor is done, resuming the scan of the bytes in front of @p offset
+    /// by @p state.
+    ///
+    /// A run of US-ASCII characters is passed at once, where the grapheme cluster of its last character
+    /// may be extended by what follows it.
+    ///
+    /// Unlike scan_text(), this does not stop at C0 control characters, but passes each of them
+    /// as a zero-width grapheme cluster. A trailing incomplete UTF-8 sequence is left in @p state.
+    template <typename Visitor>
+    void resume_columns(std::string_view text, size_t offset, scan_state& state, Visitor& visitor) noexcept
+    {
+        char const* input = text.data() + offset;
+        char const* const end = text.data() + text.size();
+
+        // The first codepoint (or the rest of it) may continue the last grapheme cluster scanned.
+        auto continuation = static_cast<char const*>(nullptr);
+        if (offset != 0 && !is_control(text[offset - 1]))
+        {
+            auto const start = offset - state.utf8.currentLength;
+            auto const sequence = decode_utf8_sequence(text.substr(start));
+            auto grapheme = state.grapheme;
+            if (sequence.status == ConversionStatus::Success
+                && !grapheme_process_breakable(sequence.value, grapheme))
+                continuation = text.data() + start;
+        }
+
+        while (input != end && !visitor.done)
+        {
+            // A pending UTF-8 sequence is interrupted by the control character, which scan_text() tells.
+            if (is_control(*input) && !state.utf8.expectedLength)
+            {
+                visitor.cluster(input++, 0);
+                state = {}; // Grapheme clusters always break around control characters.
+                continue;
+            }
+
+            auto receiver = column_receiver<Visitor> { visitor, continuation };
+            auto const run = std::string_view(input, static_cast<size_t>(end - input));
+            state.next = input;
+            scan_text(state, run, std::numeric_limits<size_t>::max(), receiver);
+            input = state.next;
+            continuation = nullptr;
+        }
+    }
+
+    /// Passes the grapheme clusters of @p text to @p visitor, see resume_columns(),
+    /// and finally the end of the text, if it got that far.
+    ///
+    /// A trailing incomplete UTF-8 sequence is passed as an invalid grapheme cluster.
+    template <typename Visitor>
+    void scan_columns(std::string_view text, Visitor& visitor) noexcept
+    {
+        auto state = scan_state {};
+        resume_columns(text, 0, state, visitor);
+        if (!visitor.done && state.utf8.expectedLength)
+            visitor.cluster(text.data() + text.size() - state.utf8.currentLength, 1);
+        if (!visitor.done)
+            visitor.boundary(text.data() + text.size());
+    }
+
+    /// Locates the grapheme cluster boundaries of a range of columns, scanning from a grapheme cluster
+    /// boundary at a known column.
+    struct column_locator
+    {
+        char const* base;
+        size_t firstColumn;
+        size_t lastColumn;
+        size_t column;
+
+        column_slice result {};
+        bool found = false; // Whether the start of the slice has been found yet.
+        bool done = false;
+
+        void boundary(char const* position) noexcept
+        {
+            if (!found && column >= firstColumn)
+            {
+                found = true;
+                result.begin = offset_of(position);
+                result.firstColumn = column;
+            }
+            if (column <= lastColumn)
+            {
+                result.end = offset_of(position);
+                result.lastColumn = column;
+            }
+            else
+                done = true;
+        }
+
+        void cluster(char const* position, size_t width) noexcept
+        {
+            if (done)
+                return;
+            boundary(position);
+            column += width;
+        }
+
+        void extend(size_t width) noexcept { column += width; }
+
+        void ascii(char const* position, size_t count) noexcept
+        {
+            // Each US-ASCII character starts a grapheme cluster of one column.
+            if (done)
+                return;
+            if (!found && column + count > firstColumn)
+            {
+                auto const skip = firstColumn - std::min(firstColumn, column);
+                found = true;
+                result.begin = offset_of(position + skip);
+                result.firstColumn = column + skip;
+            }
+            if (column > lastColumn)
+            {
+                done = true;
+                return;
+            }
+            auto const take = std::min(count - 1, lastColumn - column);
+            result.end = offset_of(position + take);
+            result.lastColumn = column + take;
+            done = take < count - 1;
+            column += count;
+        }
+
+        [[nodiscard]] size_t offset_of(char const* position) const noexcept
+        {
+            return static_cast<size_t>(position - base);
+        }
+    };
+
+    column_slice locate(
+        std::string_view text, size_t offset, size_t column, size_t firstColumn, size_t lastColumn) noexcept
+    {
+        auto locator = column_locator { text.data(), firstColumn, std::max(firstColumn, lastColumn), column };
+        scan_columns(text.substr(offset), locator);
+
+        auto result = locator.result;
+        if (!locator.found)
+        {
+            // The text is not wide enough to start at the requested column.
+            result.begin = text.size();
+            result.firstColumn = locator.column;
+        }
+        return result;
+    }
+
+    /// Makes @p slice empty, at its start, if it ends before that, i.e. if a wide grapheme cluster
+    /// straddles the whole range of columns it has been located for.
+    column_slice clamped(column_slice slice) noexcept
+    {
+        if (slice.end < slice.begin)
+        {
+            slice.end = slice.begin;
+            slice.lastColumn = slice.firstColumn;
+        }
+        return slice;
+    }
+} // namespace
+
+column_slice slice_columns(std::string_view text, size_t firstColumn, size_t lastColumn) noexcept
+{
+    return clamped(locate(text, 0, 0, firstColumn, lastColumn));
+}
+
+std::string_view truncate_columns(std::string_view text, size_t columns) noexcept
+{
+    return slice_columns(text, 0, columns).of(text);
+}
+
+namespace
+{
+    /// Records the grapheme cluster boundary at (or right behind) every stride columns.
+    template <typename Checkpoint>
+    struct checkpoint_recorder
+    {
+        char const* base;
+        size_t stride;
+        std::vector<Checkpoint>& checkpoints;
+
+        size_t column = 0;
+        size_t nextColumn = stride;
+        bool done = false;
+
+        void boundary(char const* position) noexcept
+        {
+            if (column < nextColumn)
+                return;
+            checkpoints.push_back({ column, static_cast<size_t>(position - base) });
+            nextColumn = (column / stride + 1) * stride;
+        }
+
+        void cluster(char const* position, size_t width) noexcept
+        {
+            boundary(position);
+            column += width;
+        }
+
+        void extend(size_t width) noexcept { column += width; }
+
+        void ascii(char const* position, size_t count) noexcept
+        {
+            boundary(position);
+            for (; nextColumn < column + count; nextColumn += stride)
+                checkpoints.push_back(
+                    { nextColumn, static_cast<size_t>(position + (nextColumn - column) - base) });
+            column += count;
+        }
+    };
+} // namespace
+
+column_index::column_index(std::string_view text, size_t stride): _stride { std::max(stride, size_t { 1 }) }
+{
+    _checkpoints.push_back({ 0, 0 });
+    extend(text);
+}
+
+void column_index::extend(std::string_view text)
+{
+    // The checkpoints are at the starts of grapheme clusters, which are boundaries for good,
+    // whereas the end of the text may not be, so scanning the appended bytes only adds to them.
+    auto const offset = _text.size();
+
+    // Every column takes at least one byte, so the checkpoints never need to be reallocated while scanning,
+    // which must not throw. Grown geometrically, as the text may be appended to in many small pieces.
+    auto const capacity = _checkpoints.size() + (text.size() - offset) / _stride + 1;
+    if (capacity > _checkpoints.capacity())
+        _checkpoints.reserve(std::max(capacity, 2 * _checkpoints.capacity()));
+
+    _text = text;
+    auto const nextColumn = (_checkpoints.back().column / _stride + 1) * _stride;
+    auto recorder =
+        checkpoint_recorder<checkpoint> { text.data(), _stride, _checkpoints, _scannedColumns, nextColumn };
+    resume_columns(text, offset, _state, recorder);
+    _scannedColumns = recorder.column;
+
+    // A trailing incomplete UTF-8 sequence counts as an invalid one, unless completed by what follows.
+    _columns = _scannedColumns + (_state.utf8.expectedLength ? 1 : 0);
+}
+
+column_index::checkpoint const& column_index::checkpoint_before(size_t column) const noexcept
+{
+    auto const i = std::upper_bound(_checkpoints.begin(),
+                                    _checkpoints.end(),
+                                    column,
+                                    [](size_t value, checkpoint const& c) { return value < c.column; });
+    return *std::prev(i);
+}
+
+column_index::checkpoint const& column_index::checkpoint_at(size_t offset) const noexcept
+{
+    auto const i = std::upper_bound(_checkpoints.begin(),
+                                    _checkpoints.end(),
+                                    offset,
+                                    [](size_t value, checkpoint const& c) { return value < c.offset; });
+    return *std::prev(i);
+}
+
+column_slice column_index::slice(size_t firstColumn, size_t lastColumn) const noexcept
+{
+    lastColumn = std::max(firstColumn, lastColumn);
+    auto const& from = checkpoint_before(firstColumn);
+    auto const& to = checkpoint_before(lastColumn);
+    if (&from == &to)
+        return clamped(locate(_text, from.offset, from.column, firstColumn, lastColumn));
+
+    // Far apart, so locate each end of the slice from the checkpoint nearest to it.
+    // The latter is a grapheme cluster boundary within the columns, so the ends do not cross.
+    auto result = locate(_text, from.offset, from.column, firstColumn, firstColumn);
+    auto const tail = locate(_text, to.offset, to.column, lastColumn, lastColumn);
+    result.end = tail.end;
+    result.lastColumn = tail.lastColumn;
+    return result;
+}
+
+std::string_view column_index::truncate(size_t columns) const noexcept
+{
+    return slice(0, columns).of(_text);
+}
+
+namespace
+{
+    /// Finds the column that the grapheme cluster containing a given byte starts at.
+    struct column_finder
+    {
+        char const* target;
+        size_t column;
+
+        size_t result = column;
+        bool done = false;
+
+        void boundary(char const* /*end*/) noexcept {}
+
+        void cluster(char const* position, size_t width) noexcept
+        {
+            if (done || position > target)
+            {
+                done = true;
+                return;
+            }
+            result = column;
+            column += width;
+        }
+
+        void extend(size_t width) noexcept { column += width; }
+
+        void ascii(char const* position, size_t count) noexcept
+        {
+            if (done || position > target)
+            {
+                done = true;
+                return;
+            }
+            if (target < position + count)
+            {
+                result = column + static_cast<size_t>(target - position);
+                done = true;
+                return;
+            }
+            result = column + count - 1;
+            column += count;
+        }
+    };
+} // namespace
+
+size_t column_index::column_of(size_t offset) const noexcept
+{
+    if (offset >= _text.size())
+        return _columns;
+
+    auto const& from = checkpoint_at(offset);
+    auto finder = column_finder { _text.data() + offset, from.column };
+    scan_columns(_text.substr(from.offset), finder);
+    return finder.result;
+}
+
+size_t column_index::offset_of(size_t column) const noexcept
+{
+    auto const& from = checkpoint_before(column);
+    return locate(_text, from.offset, from.column, column, column).begin;
+}
+
+} // namespace unicode
@@ -0,0 +1,136 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/scan.h>
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace unicode
+{
+
+/// Byte range of a UTF-8 text covering a range of columns, as returned by slice_columns().
+///
+/// Columns are counted as by scan_text(), except that C0 control characters occupy no columns
+/// rather than stopping the scan.
+struct column_slice
+{
+    /// Byte offset of the first grapheme cluster within the requested columns.
+    size_t begin = 0;
+
+    /// Byte offset one behind the last grapheme cluster within the requested columns.
+    size_t end = 0;
+
+    /// Column the grapheme cluster at @c begin starts at.
+    ///
+    /// This is greater than the requested first column, if a wide grapheme cluster straddles it.
+    size_t firstColumn = 0;
+
+    /// Column one behind the grapheme cluster ending at @c end.
+    ///
+    /// This is less than the requested last column, if a wide grapheme cluster straddles it,
+    /// or if the text is not wide enough.
+    size_t lastColumn = 0;
+
+    [[nodiscard]] std::string_view of(std::string_view text) const noexcept
+    {
+        return text.substr(begin, end - begin);
+    }
+
+    constexpr bool operator==(column_slice const&) const noexcept = default;
+};
+
+/// Returns the byte range of the grapheme clusters of @p text that lie entirely within
+/// the columns [firstColumn, lastColumn), in a single pass up to the last column.
+///
+/// Zero-width grapheme clusters at either boundary are included.
+[[nodiscard]] column_slice slice_columns(std::string_view text,
+                                         size_t firstColumn,
+                                         size_t lastColumn) noexcept;
+
+/// Returns the longest prefix of @p text that occupies at most @p columns columns,
+/// without splitting a grapheme cluster.
+[[nodiscard]] std::string_view truncate_columns(std::string_view text, size_t columns) noexcept;
+
+/// Precomputed index of the columns of a UTF-8 text, e.g. a long line that is repeatedly
+/// sliced for horizontal scrolling, or that columns are mapped to bytes and back in.
+///
+/// The index holds the byte offset of the grapheme cluster boundary at (or right behind)
+/// every @c stride columns, such that queries only binary search these and scan from the nearest one,
+/// rather than from the start of the text.
+///
+/// The index can be extended as the text is appended to (e.g. a megabytes long line of a terminal
+/// or log), scanning only the appended bytes, by resuming the scan where the last one stopped.
+///
+/// The index refers to the text it has been built from, which must outlive it.
+class column_index
+{
+  public:
+    /// Builds the index of @p text, scanning it once.
+    explicit column_index(std::string_view text, size_t stride = 64);
+
+    /// Extends the index to @p text, which must start with the text indexed so far,
+    /// though it may have moved (e.g. by its buffer growing), and may end within a grapheme cluster
+    /// or a UTF-8 sequence.
+    ///
+    /// Only the bytes behind the text indexed so far are scanned.
+    void extend(std::string_view text);
+
+    /// Same as slice_columns(), but scanning at most about @p stride columns per boundary.
+    [[nodiscard]] column_slice slice(size_t firstColumn, size_t lastColumn) const noexcept;
+
+    /// Same as truncate_columns(), but scanning at most about @p stride columns.
+    [[nodiscard]] std::string_view truncate(size_t columns) const noexcept;
+
+    /// Returns the column that the grapheme cluster containing the byte @p offset starts at,
+    /// or columns() if @p offset is not within the text.
+    [[nodiscard]] size_t column_of(size_t offset) const noexcept;
+
+    /// Returns the byte offset of the first grapheme cluster starting at or behind @p column,
+    /// or the size of the text if there is none.
+    [[nodiscard]] size_t offset_of(size_t column) const noexcept;
+
+    [[nodiscard]] std::string_view text() const noexcept { return _text; }
+    [[nodiscard]] size_t stride() const noexcept { return _stride; }
+
+    /// Total number of columns of the text.
+    [[nodiscard]] size_t columns() const noexcept { return _columns; }
+
+  private:
+    struct checkpoint
+    {
+        size_t column;
+        size_t offset;
+    };
+
+    /// Returns the last checkpoint at or before @p column.
+    [[nodiscard]] checkpoint const& checkpoint_before(size_t column) const noexcept;
+
+    /// Returns the last checkpoint at or before the byte @p offset.
+    [[nodiscard]] checkpoint const& checkpoint_at(size_t offset) const noexcept;
+
+    std::string_view _text;
+    size_t _stride;
+    size_t _columns = 0;
+    std::vector<checkpoint> _checkpoints;
+
+    // The state of the scan to resume when extending the text, and the columns scanned up to
+    // a trailing incomplete UTF-8 sequence, which is not yet scanned.
+    scan_state _state {};
+    size_t _scannedColumns = 0;
+};
+
+} // namespace unicode
@@ -0,0 +1,254 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/column_slice.h>
+
+#include <fmt/format.h>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+
+using namespace std::string_view_literals;
+using unicode::column_index;
+using unicode::column_slice;
+using unicode::slice_columns;
+using unicode::truncate_columns;
+
+namespace Catch
+{
+template <>
+struct StringMaker<column_slice>
+{
+    static std::string convert(column_slice const& value)
+    {
+        return fmt::format("bytes [{}, {}), columns [{}, {})",
+                           value.begin,
+                           value.end,
+                           value.firstColumn,
+                           value.lastColumn);
+    }
+};
+} // namespace Catch
+
+TEST_CASE("column_slice.ascii", "[column_slice]")
+{
+    auto constexpr Text = "Hello, World!"sv;
+    CHECK(slice_columns(Text, 7, 12) == column_slice { 7, 12, 7, 12 });
+    CHECK(slice_columns(Text, 0, 5).of(Text) == "Hello");
+    CHECK(slice_columns(Text, 7, 100) == column_slice { 7, 13, 7, 13 });
+    CHECK(slice_columns(Text, 20, 30) == column_slice { 13, 13, 13, 13 });
+    CHECK(slice_columns(Text, 5, 5) == column_slice { 5, 5, 5, 5 });
+    CHECK(slice_columns(Text, 5, 2) == column_slice { 5, 5, 5, 5 });
+    CHECK(slice_columns(""sv, 0, 5) == column_slice {});
+
+    CHECK(truncate_columns(Text, 5) == "Hello");
+    CHECK(truncate_columns(Text, 0).empty());
+    CHECK(truncate_columns(Text, 100) == Text);
+}
+
+TEST_CASE("column_slice.wide", "[column_slice]")
+{
+    // a (1 column), U+4E2D and U+6587 (2 columns each), b (1 column)
+    auto constexpr Text = "a\xE4\xB8\xAD\xE6\x96\x87"
+                          "b"sv;
+    CHECK(slice_columns(Text, 1, 3) == column_slice { 1, 4, 1, 3 });
+    CHECK(slice_columns(Text, 1, 6) == column_slice { 1, 8, 1, 6 });
+
+    // Wide grapheme clusters straddling either boundary are left out.
+    CHECK(slice_columns(Text, 2, 5) == column_slice { 4, 7, 3, 5 });
+    CHECK(slice_columns(Text, 0, 2) == column_slice { 0, 1, 0, 1 });
+    CHECK(slice_columns(Text, 2, 4) == column_slice { 4, 4, 3, 3 });
+    CHECK(truncate_columns(Text, 4) == "a\xE4\xB8\xAD"sv);
+}
+
+TEST_CASE("column_slice.grapheme_clusters", "[column_slice]")
+{
+    // e with U+0301 COMBINING ACUTE ACCENT, then x.
+    CHECK(truncate_columns("e\xCC\x81x"sv, 1) == "e\xCC\x81"sv);
+
+    // U+0023 U+FE0F (VS16 widens it to 2 columns), then x.
+    CHECK(slice_columns("#\xEF\xB8\x8Fx"sv, 0, 1) == column_slice { 0, 0, 0, 0 });
+    CHECK(slice_columns("#\xEF\xB8\x8Fx"sv, 0, 3) == column_slice { 0, 5, 0, 3 });
+    CHECK(slice_columns("ab#\xEF\xB8\x8Fx"sv, 0, 3) == column_slice { 0, 2, 0, 2 });
+    CHECK(slice_columns("ab#\xEF\xB8\x8Fx"sv, 2, 4) == column_slice { 2, 6, 2, 4 });
+    CHECK(slice_columns("xe\xCC\x81y"sv, 1, 2) == column_slice { 1, 4, 1, 2 });
+
+    // U+1F468 U+200D U+1F469 (one grapheme cluster of 2 columns), then x.
+    auto constexpr Family = "\xF0\x9F\x91\xA8\xE2\x80\x8D\xF0\x9F\x91\xA9"
+                            "x"sv;
+    CHECK(slice_columns(Family, 0, 2) == column_slice { 0, 11, 0, 2 });
+    CHECK(slice_columns(Family, 1, 3) == column_slice { 11, 12, 2, 3 });
+}
+
+TEST_CASE("column_slice.control_and_invalid", "[column_slice]")
+{
+    // Control characters occupy no columns, but do not stop slicing.
+    CHECK(slice_columns("ab\tcd"sv, 2, 4) == column_slice { 2, 5, 2, 4 });
+    CHECK(slice_columns("ab\r\ncd"sv, 1, 3) == column_slice { 1, 5, 1, 3 });
+
+    // Invalid UTF-8 sequences, including a trailing incomplete one, occupy one column each.
+    CHECK(slice_columns("a\xFF"
+                        "b"sv,
+                        1,
+                        3)
+          == column_slice { 1, 3, 1, 3 });
+    CHECK(slice_columns("ab\xE2\x82"sv, 0, 10) == column_slice { 0, 4, 0, 3 });
+}
+
+TEST_CASE("column_slice.index", "[column_slice]")
+{
+    auto text = std::string {};
+    for (int i = 0; i < 8; ++i)
+        text += "ab\xE4\xB8\xAD"
+                "c\t\xF0\x9F\x91\xA8\xE2\x80\x8D\xF0\x9F\x91\xA9"
+                "e\xCC\x81#\xEF\xB8\x8F\xFF"
+                "xyz";
+
+    auto const columns = column_index(text, 1).columns();
+    CHECK(columns == 8 * 14);
+    CHECK(slice_columns(text, 0, columns + 1).end == text.size());
+
+    for (auto const stride: { 1u, 3u, 7u, 64u })
+    {
+        auto const index = column_index(text, stride);
+        REQUIRE(index.columns() == columns);
+        for (size_t first = 0; first <= columns + 1; ++first)
+        {
+            for (size_t last = first; last <= columns + 1; ++last)
+            {
+                INFO(fmt::format("stride {}, columns [{}, {})", stride, first, last));
+                REQUIRE(index.slice(first, last) == slice_columns(text, first, last));
+            }
+            REQUIRE(index.truncate(first) == truncate_columns(text, first));
+        }
+    }
+}
+
+TEST_CASE("column_slice.index.extend", "[column_slice]")
+{
+    // U+4E2D (2 columns), e with U+0301, U+0023 U+FE0F (2 columns), U+1F468 U+200D U+1F469 (2 columns).
+    auto text = std::string {};
+    auto index = column_index(text, 4);
+    for (auto const chunk: { "ab\xE4"sv,
+                             "\xB8\xAD"sv,
+                             "e"sv,
+                             "\xCC"sv,
+                             "\x81#"sv,
+                             "\xEF\xB8\x8F"sv,
+                             "\tx\xF0\x9F\x91\xA8"sv,
+                             "\xE2\x80\x8D\xF0\x9F"sv,
+                             "\x91\xA9y"sv })
+    {
+        text += chunk;
+        index.extend(text);
+    }
+
+    REQUIRE(index.text() == "ab\xE4\xB8\xAD"
+                            "e\xCC\x81#\xEF\xB8\x8F\tx\xF0\x9F\x91\xA8\xE2\x80\x8D\xF0\x9F\x91\xA9y"sv);
+    CHECK(index.columns() == 11);
+
+    CHECK(index.column_of(1) == 1);
+    CHECK(index.column_of(2) == 2);
+    CHECK(index.column_of(4) == 2);
+    CHECK(index.column_of(5) == 4);
+    CHECK(index.column_of(7) == 4);
+    CHECK(index.column_of(8) == 5);
+    CHECK(index.column_of(11) == 5);
+    CHECK(index.column_of(12) == 7);
+    CHECK(index.column_of(13) == 7);
+    CHECK(index.column_of(20) == 8);
+    CHECK(index.column_of(25) == 10);
+    CHECK(index.column_of(100) == 11);
+
+    CHECK(index.offset_of(2) == 2);
+    CHECK(index.offset_of(3) == 5);
+    CHECK(index.offset_of(7) == 12);
+    CHECK(index.offset_of(8) == 14);
+    CHECK(index.offset_of(9) == 25);
+    CHECK(index.offset_of(100) == text.size());
+
+    auto empty = column_index(""sv);
+    CHECK(empty.columns() == 0);
+    CHECK(empty.column_of(0) == 0);
+    empty.extend("abc"sv);
+    CHECK(empty.columns() == 3);
+}
+
+TEST_CASE("column_slice.index.extend.chunks", "[column_slice]")
+{
+    auto text = std::string {};
+    for (int i = 0; i < 8; ++i)
+        text += "ab\xE4\xB8\xAD"
+                "c\t\xF0\x9F\x91\xA8\xE2\x80\x8D\xF0\x9F\x91\xA9"
+                "e\xCC\x81#\xEF\xB8\x8F\xFF"
+                "xyz\xF0\x9F\x87\xA9\xF0\x9F\x87\xAA\xF0\x9F\x87\xAB\r\nlong line";
+
+    auto const whole = column_index(text, text.size());
+    auto const columns = whole.columns();
+    REQUIRE(columns == slice_columns(text, 0, text.size()).lastColumn);
+
+    auto constexpr ChunkSizes = std::array<size_t, 6> { 1, 2, 3, 5, 8, 13 };
+    for (auto const stride: { 1u, 3u, 7u, 64u })
+    {
+        for (size_t shift = 0; shift < ChunkSizes.size(); ++shift)
+        {
+            // Appends chunks of varying sizes, splitting grapheme clusters and UTF-8 sequences alike.
+            auto line = std::string {};
+            auto index = column_index(line, stride);
+            for (size_t i = shift; line.size() < text.size(); ++i)
+            {
+                line += std::string_view(text).substr(line.size(), ChunkSizes[i % ChunkSizes.size()]);
+                index.extend(line);
+                REQUIRE(index.columns() == slice_columns(line, 0, line.size()).lastColumn);
+            }
+
+            for (size_t offset = 0; offset <= text.size(); ++offset)
+            {
+                INFO(fmt::format("stride {}, shift {}, offset {}", stride, shift, offset));
+                REQUIRE(index.column_of(offset) == whole.column_of(offset));
+            }
+            for (size_t first = 0; first <= columns + 1; ++first)
+            {
+                INFO(fmt::format("stride {}, shift {}, column {}", stride, shift, first));
+                REQUIRE(index.offset_of(first) == slice_columns(text, first, first).begin);
+                for (size_t last = first; last <= columns + 1; last += 3)
+                    REQUIRE(index.slice(first, last) == slice_columns(text, first, last));
+                REQUIRE(index.truncate(first) == truncate_columns(text, first));
+            }
+        }
+    }
+}
+
+TEST_CASE("column_slice.index.extend.long_cluster", "[column_slice]")
+{
+    // A grapheme cluster of a base and many combining marks, arriving a byte at a time.
+    auto const mark = "\xCC\x81"sv; // U+0301
+    auto text = std::string("x");
+    auto index = column_index(text, 1);
+    for (int i = 0; i < 1000; ++i)
+        for (auto const byte: mark)
+        {
+            text += byte;
+            index.extend(text);
+        }
+    text += "y";
+    index.extend(text);
+
+    CHECK(index.columns() == 2);
+    CHECK(index.column_of(text.size() - 2) == 0);
+    CHECK(index.column_of(text.size() - 1) == 1);
+    CHECK(index.offset_of(1) == text.size() - 1);
+}
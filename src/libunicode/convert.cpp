@@ -0,0 +1,691 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/intrinsics.h>
+#include <libunicode/utf8.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace unicode
+{
+
+namespace
+{
+    constexpr char32_t ReplacementCharacter = 0xFFFD; // NOLINT(readability-identifier-naming)
+
+    // {{{ vectorized kernels
+    /// Widens the leading US-ASCII bytes of [input, input + count) into UTF-32.
+    ///
+    /// @return number of bytes widened, i.e. the offset of the first non-US-ASCII byte, or @p count.
+    using ascii_widener = size_t (*)(uint8_t const* input, size_t count, char32_t* output) noexcept;
+
+    /// Validates and decodes a leading run of UTF-8 sequences of one particular length (such as
+    /// 3 bytes for CJK text) from [input, input + count) into at most @p capacity codepoints.
+    ///
+    /// Decoding is done in vector sized chunks, and stops at the first chunk that does not entirely
+    /// consist of valid sequences of the given length, leaving it to the scalar decoder.
+    ///
+    /// @return number of codepoints decoded.
+    using multibyte_decoder = size_t (*)(uint8_t const* input,
+                                         size_t count,
+                                         char32_t* output,
+                                         size_t capacity) noexcept;
+
+    /// Narrows the leading US-ASCII codepoints of [input, input + count) into UTF-8.
+    ///
+    /// @return number of codepoints narrowed.
+    using ascii_narrower = size_t (*)(char32_t const* input, size_t count, char* output) noexcept;
+
+    /// Narrows the leading codepoints of [input, input + count) that are in the Basic Multilingual Plane,
+    /// but no surrogates, into UTF-16.
+    ///
+    /// @return number of codepoints narrowed.
+    using bmp_narrower = size_t (*)(char32_t const* input, size_t count, char16_t* output) noexcept;
+
+    /// Widens the leading UTF-16 code units of [input, input + count) that are no surrogates into UTF-32.
+    ///
+    /// @return number of code units widened.
+    using bmp_widener = size_t (*)(char16_t const* input, size_t count, char32_t* output) noexcept;
+
+    struct conversion_kernels
+    {
+        ascii_widener widenAscii;
+        multibyte_decoder decode2ByteSequences; // may be nullptr
+        multibyte_decoder decode3ByteSequences; // may be nullptr
+        ascii_narrower narrowAscii;
+        bmp_narrower narrowBmp;
+        bmp_widener widenBmp;
+    };
+
+    constexpr bool is_surrogate(char32_t codepoint) noexcept
+    {
+        return 0xD800 <= codepoint && codepoint <= 0xDFFF;
+    }
+
+    constexpr bool is_bmp_non_surrogate(char32_t codepoint) noexcept
+    {
+        return codepoint <= 0xFFFF && !is_surrogate(codepoint);
+    }
+
+    size_t narrow_ascii_scalar(char32_t const* input, size_t count, char* output) noexcept
+    {
+        size_t i = 0;
+        while (i != count && input[i] < 0x80)
+        {
+            output[i] = static_cast<char>(input[i]);
+            ++i;
+        }
+        return i;
+    }
+
+    size_t narrow_bmp_scalar(char32_t const* input, size_t count, char16_t* output) noexcept
+    {
+        size_t i = 0;
+        while (i != count && is_bmp_non_surrogate(input[i]))
+        {
+            output[i] = static_cast<char16_t>(input[i]);
+            ++i;
+        }
+        return i;
+    }
+
+    size_t widen_bmp_scalar(char16_t const* input, size_t count, char32_t* output) noexcept
+    {
+        size_t i = 0;
+        while (i != count && !is_surrogate(input[i]))
+        {
+            output[i] = input[i];
+            ++i;
+        }
+        return i;
+    }
+
+    size_t widen_ascii_scalar(uint8_t const* input, size_t count, char32_t* output) noexcept
+    {
+        size_t i = 0;
+        while (i != count && input[i] < 0x80)
+        {
+            output[i] = input[i];
+            ++i;
+        }
+        return i;
+    }
+
+#if defined(__x86_64__) || defined(_M_AMD64)
+    size_t widen_ascii_sse2(uint8_t const* input, size_t count, char32_t* output) noexcept
+    {
+        auto const zero = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (; count - i >= 16; i += 16)
+        {
+            auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i));
+            if (_mm_movemask_epi8(bytes) != 0)
+                break;
+            auto const low = _mm_unpacklo_epi8(bytes, zero);
+            auto const high = _mm_unpackhi_epi8(bytes, zero);
+            auto* out = reinterpret_cast<__m128i*>(output + i);
+            _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(low, zero));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, zero));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, zero));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, zero));
+        }
+        return i + widen_ascii_scalar(input + i, count - i, output + i);
+    }
+
+    LIBUNICODE_TARGET("avx2")
+    size_t widen_ascii_avx2(uint8_t const* input, size_t count, char32_t* output) noexcept
+    {
+        size_t i = 0;
+        for (; count - i >= 32; i += 32)
+        {
+            auto const bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(input + i));
+            if (_mm256_movemask_epi8(bytes) != 0)
+                break;
+            auto* out = reinterpret_cast<__m256i*>(output + i);
+            for (int k = 0; k < 4; ++k)
+            {
+                auto const eight = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(input + i + 8 * k));
+                _mm256_storeu_si256(out + k, _mm256_cvtepu8_epi32(eight));
+            }
+        }
+        return i + widen_ascii_sse2(input + i, count - i, output + i);
+    }
+
+    // Decodes 16 codepoints per iteration, being 16-bit little endian lanes of the form 10xx'xxxx'110x'xxxx.
+    LIBUNICODE_TARGET("avx2")
+    size_t decode_2byte_sequences_avx2(uint8_t const* input,
+                                        size_t count,
+                                        char32_t* output,
+                                        size_t capacity) noexcept
+    {
+        auto const patternMask = _mm256_set1_epi16(static_cast<short>(0xC0E0));
+        auto const pattern = _mm256_set1_epi16(static_cast<short>(0x80C0));
+        auto const minimum = _mm256_set1_epi16(0x80); // anything lower is an overlong encoding
+
+        size_t written = 0;
+        while (count >= 32 && capacity - written >= 16)
+        {
+            auto const lanes = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(input));
+            auto const codepoints =
+                _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(lanes, _mm256_set1_epi16(0x1F)), 6),
+                                _mm256_and_si256(_mm256_srli_epi16(lanes, 8), _mm256_set1_epi16(0x3F)));
+            auto const invalid =
+                _mm256_or_si256(_mm256_xor_si256(_mm256_and_si256(lanes, patternMask), pattern),
+                                _mm256_cmpgt_epi16(minimum, codepoints));
+            if (!_mm256_testz_si256(invalid, invalid))
+                break;
+
+            auto* out = reinterpret_cast<__m256i*>(output + written);
+            _mm256_storeu_si256(out + 0, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(codepoints)));
+            _mm256_storeu_si256(out + 1, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(codepoints, 1)));
+
+            input += 32;
+            count -= 32;
+            written += 16;
+        }
+        return written;
+    }
+
+    // Decodes 8 codepoints per iteration, by shuffling each 3-byte sequence into a 32-bit lane,
+    // being 0000'0000'1110'xxxx'10xx'xxxx'10xx'xxxx.
+    LIBUNICODE_TARGET("avx2")
+    size_t decode_3byte_sequences_avx2(uint8_t const* input,
+                                        size_t count,
+                                        char32_t* output,
+                                        size_t capacity) noexcept
+    {
+        auto const shuffle = _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1, //
+                                              2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+        auto const patternMask = _mm256_set1_epi32(0x00F0C0C0);
+        auto const pattern = _mm256_set1_epi32(0x00E08080);
+        auto const minimum = _mm256_set1_epi32(0x800); // anything lower is an overlong encoding
+        auto const surrogateMask = _mm256_set1_epi32(0xF800);
+        auto const surrogates = _mm256_set1_epi32(0xD800);
+
+        size_t written = 0;
+        // Each iteration consumes 24 bytes, but loads 28.
+        while (count >= 28 && capacity - written >= 8)
+        {
+            auto const low = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input));
+            auto const high = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + 12));
+            auto const lanes = _mm256_shuffle_epi8(_mm256_set_m128i(high, low), shuffle);
+            auto const lead = _mm256_and_si256(_mm256_srli_epi32(lanes, 16), _mm256_set1_epi32(0x0F));
+            auto const second = _mm256_and_si256(_mm256_srli_epi32(lanes, 8), _mm256_set1_epi32(0x3F));
+            auto const third = _mm256_and_si256(lanes, _mm256_set1_epi32(0x3F));
+            auto const codepoints = _mm256_or_si256(
+                _mm256_or_si256(_mm256_slli_epi32(lead, 12), _mm256_slli_epi32(second, 6)), third);
+            auto const invalid = _mm256_or_si256(
+                _mm256_or_si256(_mm256_xor_si256(_mm256_and_si256(lanes, patternMask), pattern),
+                                _mm256_cmpgt_epi32(minimum, codepoints)),
+                _mm256_cmpeq_epi32(_mm256_and_si256(codepoints, surrogateMask), surrogates));
+            if (!_mm256_testz_si256(invalid, invalid))
+                break;
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + written), codepoints);
+
+            input += 24;
+            count -= 24;
+            written += 8;
+        }
+        return written;
+    }
+
+    size_t narrow_ascii_sse2(char32_t const* input, size_t count, char* output) noexcept
+    {
+        auto const nonAscii = _mm_set1_epi32(~0x7F);
+        auto const zero = _mm_setzero_si128();
+
+        size_t i = 0;
+        for (; count - i >= 16; i += 16)
+        {
+            auto const* in = reinterpret_cast<__m128i const*>(input + i);
+            auto const a = _mm_loadu_si128(in + 0);
+            auto const b = _mm_loadu_si128(in + 1);
+            auto const c = _mm_loadu_si128(in + 2);
+            auto const d = _mm_loadu_si128(in + 3);
+            auto const any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, nonAscii), zero)) != 0xFFFF)
+                break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                             _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+        }
+        return i + narrow_ascii_scalar(input + i, count - i, output + i);
+    }
+
+    LIBUNICODE_TARGET("avx2")
+    size_t narrow_ascii_avx2(char32_t const* input, size_t count, char* output) noexcept
+    {
+        auto const nonAscii = _mm256_set1_epi32(~0x7F);
+        auto const order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        size_t i = 0;
+        for (; count - i >= 32; i += 32)
+        {
+            auto const* in = reinterpret_cast<__m256i const*>(input + i);
+            auto const a = _mm256_loadu_si256(in + 0);
+            auto const b = _mm256_loadu_si256(in + 1);
+            auto const c = _mm256_loadu_si256(in + 2);
+            auto const d = _mm256_loadu_si256(in + 3);
+            auto const any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+            if (!_mm256_testz_si256(any, nonAscii))
+                break;
+            // The packs operate per 128-bit lane, which the final permutation reverts.
+            auto const bytes = _mm256_packus_epi16(_mm256_packus_epi32(a, b), _mm256_packus_epi32(c, d));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                                _mm256_permutevar8x32_epi32(bytes, order));
+        }
+        return i + narrow_ascii_sse2(input + i, count - i, output + i);
+    }
+
+    LIBUNICODE_TARGET("avx2")
+    size_t narrow_bmp_avx2(char32_t const* input, size_t count, char16_t* output) noexcept
+    {
+        auto const nonBmp = _mm256_set1_epi32(static_cast<int>(0xFFFF'0000));
+        auto const surrogateMask = _mm256_set1_epi32(static_cast<int>(0xFFFF'F800));
+        auto const surrogates = _mm256_set1_epi32(0xD800);
+
+        size_t i = 0;
+        for (; count - i >= 16; i += 16)
+        {
+            auto const* in = reinterpret_cast<__m256i const*>(input + i);
+            auto const a = _mm256_loadu_si256(in + 0);
+            auto const b = _mm256_loadu_si256(in + 1);
+            auto const surrogatesA = _mm256_cmpeq_epi32(_mm256_and_si256(a, surrogateMask), surrogates);
+            auto const surrogatesB = _mm256_cmpeq_epi32(_mm256_and_si256(b, surrogateMask), surrogates);
+            auto const invalid = _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(a, b), nonBmp),
+                                                 _mm256_or_si256(surrogatesA, surrogatesB));
+            if (!_mm256_testz_si256(invalid, invalid))
+                break;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                                _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0b11'01'10'00));
+        }
+        return i + narrow_bmp_scalar(input + i, count - i, output + i);
+    }
+
+    LIBUNICODE_TARGET("avx2")
+    size_t widen_bmp_avx2(char16_t const* input, size_t count, char32_t* output) noexcept
+    {
+        auto const surrogateMask = _mm256_set1_epi16(static_cast<short>(0xF800));
+        auto const surrogates = _mm256_set1_epi16(static_cast<short>(0xD800));
+
+        size_t i = 0;
+        for (; count - i >= 16; i += 16)
+        {
+            auto const units = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(input + i));
+            auto const invalid = _mm256_cmpeq_epi16(_mm256_and_si256(units, surrogateMask), surrogates);
+            if (!_mm256_testz_si256(invalid, invalid))
+                break;
+            auto* out = reinterpret_cast<__m256i*>(output + i);
+            _mm256_storeu_si256(out + 0, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(units)));
+            _mm256_storeu_si256(out + 1, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(units, 1)));
+        }
+        return i + widen_bmp_scalar(input + i, count - i, output + i);
+    }
+
+    conversion_kernels select_conversion_kernels() noexcept
+    {
+        if (cpu_supports_avx2())
+            return { &widen_ascii_avx2,  &decode_2byte_sequences_avx2, &decode_3byte_sequences_avx2,
+                     &narrow_ascii_avx2, &narrow_bmp_avx2,             &widen_bmp_avx2 };
+        return { &widen_ascii_sse2,  nullptr,            nullptr,
+                 &narrow_ascii_sse2, &narrow_bmp_scalar, &widen_bmp_scalar };
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    size_t widen_ascii_neon(uint8_t const* input, size_t count, char32_t* output) noexcept
+    {
+        size_t i = 0;
+        for (; count - i >= 16; i += 16)
+        {
+            auto const bytes = vld1q_u8(input + i);
+            if (vmaxvq_u8(bytes) >= 0x80)
+                break;
+            auto const low = vmovl_u8(vget_low_u8(bytes));
+            auto const high = vmovl_u8(vget_high_u8(bytes));
+            auto* out = reinterpret_cast<uint32_t*>(output + i);
+            vst1q_u32(out + 0, vmovl_u16(vget_low_u16(low)));
+            vst1q_u32(out + 4, vmovl_u16(vget_high_u16(low)));
+            vst1q_u32(out + 8, vmovl_u16(vget_low_u16(high)));
+            vst1q_u32(out + 12, vmovl_u16(vget_high_u16(high)));
+        }
+        return i + widen_ascii_scalar(input + i, count - i, output + i);
+    }
+
+    size_t narrow_ascii_neon(char32_t const* input, size_t count, char* output) noexcept
+    {
+        size_t i = 0;
+        for (; count - i >= 16; i += 16)
+        {
+            auto const* in = reinterpret_cast<uint32_t const*>(input + i);
+            auto const a = vld1q_u32(in + 0);
+            auto const b = vld1q_u32(in + 4);
+            auto const c = vld1q_u32(in + 8);
+            auto const d = vld1q_u32(in + 12);
+            if (vmaxvq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d))) >= 0x80)
+                break;
+            auto const low = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+            auto const high = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+            vst1q_u8(reinterpret_cast<uint8_t*>(output + i), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+        }
+        return i + narrow_ascii_scalar(input + i, count - i, output + i);
+    }
+
+    size_t narrow_bmp_neon(char32_t const* input, size_t count, char16_t* output) noexcept
+    {
+        auto const surrogateMask = vdupq_n_u32(0xFFFF'F800);
+        auto const surrogates = vdupq_n_u32(0xD800);
+
+        size_t i = 0;
+        for (; count - i >= 8; i += 8)
+        {
+            auto const* in = reinterpret_cast<uint32_t const*>(input + i);
+            auto const a = vld1q_u32(in + 0);
+            auto const b = vld1q_u32(in + 4);
+            auto const invalid = vorrq_u32(vceqq_u32(vandq_u32(a, surrogateMask), surrogates),
+                                           vceqq_u32(vandq_u32(b, surrogateMask), surrogates));
+            if (vmaxvq_u32(vorrq_u32(a, b)) > 0xFFFF || vmaxvq_u32(invalid) != 0)
+                break;
+            vst1q_u16(reinterpret_cast<uint16_t*>(output + i), vcombine_u16(vmovn_u32(a), vmovn_u32(b)));
+        }
+        return i + narrow_bmp_scalar(input + i, count - i, output + i);
+    }
+
+    size_t widen_bmp_neon(char16_t const* input, size_t count, char32_t* output) noexcept
+    {
+        auto const surrogateMask = vdupq_n_u16(0xF800);
+        auto const surrogates = vdupq_n_u16(0xD800);
+
+        size_t i = 0;
+        for (; count - i >= 8; i += 8)
+        {
+            auto const units = vld1q_u16(reinterpret_cast<uint16_t const*>(input + i));
+            if (vmaxvq_u16(vceqq_u16(vandq_u16(units, surrogateMask), surrogates)) != 0)
+                break;
+            auto* out = reinterpret_cast<uint32_t*>(output + i);
+            vst1q_u32(out + 0, vmovl_u16(vget_low_u16(units)));
+            vst1q_u32(out + 4, vmovl_u16(vget_high_u16(units)));
+        }
+        return i + widen_bmp_scalar(input + i, count - i, output + i);
+    }
+
+    conversion_kernels select_conversion_kernels() noexcept
+    {
+        return { &widen_ascii_neon,  nullptr,          nullptr,
+                 &narrow_ascii_neon, &narrow_bmp_neon, &widen_bmp_neon };
+    }
+#else
+    conversion_kernels select_conversion_kernels() noexcept
+    {
+        return { &widen_ascii_scalar,  nullptr,           nullptr,
+                 &narrow_ascii_scalar, &narrow_bmp_scalar, &widen_bmp_scalar };
+    }
+#endif
+    // }}}
+
+    conversion_kernels const& kernels() noexcept
+    {
+        // The best implementation for the running CPU is determined once, on first use.
+        static conversion_kernels const instance = select_conversion_kernels();
+        return instance;
+    }
+} // namespace
+
+conversion_result convert_utf8_to_utf32(std::string_view input,
+                                        std::span<char32_t> output,
+                                        ConversionErrorPolicy policy) noexcept
+{
+    auto const& kernels = unicode::kernels();
+
+    auto const* const begin = reinterpret_cast<uint8_t const*>(input.data());
+    auto const* const end = begin + input.size();
+    auto const* in = begin;
+
+    auto* const outBegin = output.data();
+    auto* const outEnd = outBegin + output.size();
+    auto* out = outBegin;
+
+    auto const result = [&](ConversionStatus status) noexcept {
+        return conversion_result {
+            static_cast<size_t>(in - begin), static_cast<size_t>(out - outBegin), status
+        };
+    };
+
+    while (in != end && out != outEnd)
+    {
+        if (*in < 0x80)
+        {
+            auto const count =
+                kernels.widenAscii(in, static_cast<size_t>(std::min(end - in, outEnd - out)), out);
+            in += count;
+            out += count;
+            continue;
+        }
+
+        // Stay in here for as long as there is non-US-ASCII text, e.g. CJK.
+        do
+        {
+            auto const lead = *in;
+            size_t const runLength = lead < 0xC2 ? 0 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 0;
+            auto const decodeRun = runLength == 2   ? kernels.decode2ByteSequences
+                                   : runLength == 3 ? kernels.decode3ByteSequences
+                                                    : nullptr;
+            // Only worth it if likely followed by more sequences of the same length.
+            if (decodeRun && end - in >= 32 && (in[runLength] & 0xF0) == (lead & 0xF0))
+            {
+                auto const count =
+                    decodeRun(in, static_cast<size_t>(end - in), out, static_cast<size_t>(outEnd - out));
+                in += count * runLength;
+                out += count;
+                if (in == end || out == outEnd || *in < 0x80)
+                    break;
+            }
+
+            auto const sequence = decode_utf8_sequence(
+                std::string_view(reinterpret_cast<char const*>(in), static_cast<size_t>(end - in)));
+            if (sequence.status == ConversionStatus::Success)
+                *out++ = sequence.value;
+            else if (policy == ConversionErrorPolicy::Stop)
+                return result(sequence.status);
+            else if (policy == ConversionErrorPolicy::Replace)
+                *out++ = ReplacementCharacter;
+            in += sequence.length;
+        } while (in != end && out != outEnd && *in >= 0x80);
+    }
+
+    return result(ConversionStatus::Success);
+}
+
+size_t utf8_length(std::u32string_view input) noexcept
+{
+    size_t length = 0;
+    for (auto const codepoint: input)
+        length += codepoint < 0x80       ? 1
+                  : codepoint < 0x800    ? 2
+                  : codepoint < 0x10000  ? 3
+                  : codepoint < 0x110000 ? 4
+                                         : 3; // U+FFFD
+    return length;
+}
+
+conversion_result convert_utf32_to_utf8(std::u32string_view input,
+                                        std::span<char> output,
+                                        ConversionErrorPolicy policy) noexcept
+{
+    auto const& kernels = unicode::kernels();
+
+    auto const* const begin = input.data();
+    auto const* const end = begin + input.size();
+    auto const* in = begin;
+
+    auto* const outBegin = output.data();
+    auto* const outEnd = outBegin + output.size();
+    auto* out = outBegin;
+
+    auto const result = [&](ConversionStatus status) noexcept {
+        return conversion_result {
+            static_cast<size_t>(in - begin), static_cast<size_t>(out - outBegin), status
+        };
+    };
+
+    while (in != end && out != outEnd)
+    {
+        if (*in < 0x80)
+        {
+            // Runs of US-ASCII in between other text (such as words) are usually short,
+            // and not worth calling into the vectorized kernel for.
+            auto const available = static_cast<size_t>(std::min(end - in, outEnd - out));
+            auto count = narrow_ascii_scalar(in, std::min<size_t>(available, 8), out);
+            if (count == 8)
+                count += kernels.narrowAscii(in + 8, available - 8, out + 8);
+            in += count;
+            out += count;
+            continue;
+        }
+
+        auto codepoint = *in;
+        if (is_surrogate(codepoint) || codepoint > 0x10FFFF)
+        {
+            if (policy == ConversionErrorPolicy::Stop)
+                return result(ConversionStatus::Invalid);
+            if (policy == ConversionErrorPolicy::Skip)
+            {
+                ++in;
+                continue;
+            }
+            codepoint = ReplacementCharacter;
+        }
+
+        auto const length = codepoint < 0x800 ? 2 : codepoint < 0x10000 ? 3 : 4;
+        if (outEnd - out < length)
+            break;
+        out += to_utf8(codepoint, reinterpret_cast<uint8_t*>(out));
+        ++in;
+    }
+
+    return result(ConversionStatus::Success);
+}
+
+size_t utf16_length(std::u32string_view input) noexcept
+{
+    size_t length = 0;
+    for (auto const codepoint: input)
+        length += 0x10000 <= codepoint && codepoint < 0x110000 ? 2 : 1;
+    return length;
+}
+
+conversion_result convert_utf32_to_utf16(std::u32string_view input,
+                                         std::span<char16_t> output,
+                                         ConversionErrorPolicy policy) noexcept
+{
+    auto const& kernels = unicode::kernels();
+
+    auto const* const begin = input.data();
+    auto const* const end = begin + input.size();
+    auto const* in = begin;
+
+    auto* const outBegin = output.data();
+    auto* const outEnd = outBegin + output.size();
+    auto* out = outBegin;
+
+    auto const result = [&](ConversionStatus status) noexcept {
+        return conversion_result {
+            static_cast<size_t>(in - begin), static_cast<size_t>(out - outBegin), status
+        };
+    };
+
+    while (in != end && out != outEnd)
+    {
+        if (is_bmp_non_surrogate(*in))
+        {
+            auto const count =
+                kernels.narrowBmp(in, static_cast<size_t>(std::min(end - in, outEnd - out)), out);
+            in += count;
+            out += count;
+            continue;
+        }
+
+        auto const codepoint = *in;
+        if (is_surrogate(codepoint) || codepoint > 0x10FFFF)
+        {
+            if (policy == ConversionErrorPolicy::Stop)
+                return result(ConversionStatus::Invalid);
+            if (policy == ConversionErrorPolicy::Replace)
+                *out++ = static_cast<char16_t>(ReplacementCharacter);
+            ++in;
+            continue;
+        }
+
+        if (outEnd - out < 2)
+            break;
+        *out++ = static_cast<char16_t>(0xD7C0 + (codepoint >> 10));
+        *out++ = static_cast<char16_t>(0xDC00 + (codepoint & 0x3FF));
+        ++in;
+    }
+
+    return result(ConversionStatus::Success);
+}
+
+conversion_result convert_utf16_to_utf32(std::u16string_view input,
+                                         std::span<char32_t> output,
+                                         ConversionErrorPolicy policy) noexcept
+{
+    auto const& kernels = unicode::kernels();
+
+    auto const* const begin = input.data();
+    auto const* const end = begin + input.size();
+    auto const* in = begin;
+
+    auto* const outBegin = output.data();
+    auto* const outEnd = outBegin + output.size();
+    auto* out = outBegin;
+
+    auto const result = [&](ConversionStatus status) noexcept {
+        return conversion_result {
+            static_cast<size_t>(in - begin), static_cast<size_t>(out - outBegin), status
+        };
+    };
+
+    while (in != end && out != outEnd)
+    {
+        if (!is_surrogate(*in))
+        {
+            auto const count =
+                kernels.widenBmp(in, static_cast<size_t>(std::min(end - in, outEnd - out)), out);
+            in += count;
+            out += count;
+            continue;
+        }
+
+        auto const high = *in;
+        if (high < 0xDC00 && end - in >= 2 && 0xDC00 <= in[1] && in[1] <= 0xDFFF)
+        {
+            *out++ = (char32_t(high) << 10) + in[1] - 0x35FDC00;
+            in += 2;
+            continue;
+        }
+
+        if (policy == ConversionErrorPolicy::Stop)
+            return result(high < 0xDC00 && end - in == 1 ? ConversionStatus::Incomplete
+                                                         : ConversionStatus::Invalid);
+        if (policy == ConversionErrorPolicy::Replace)
+            *out++ = ReplacementCharacter;
+        ++in;
+    }
+
+    return result(ConversionStatus::Success);
+}
+
+} // namespace unicode
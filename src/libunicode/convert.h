@@ -14,9 +14,12 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <type_traits>
 
@@ -308,6 +311,205 @@ struct decoder<wchar_t> // {{{
             return decoder<char32_t> {}(input);
     }
 }; // }}}
+template <>
+struct encoder<char8_t> // {{{
+{
+    using char_type = char8_t;
+
+    template <typename OutputIterator>
+    constexpr OutputIterator operator()(char32_t input, OutputIterator output)
+    {
+        std::array<char, 4> bytes {};
+        auto const end = encoder<char> {}(input, bytes.begin());
+        for (auto i = bytes.begin(); i != end; ++i)
+            *output++ = static_cast<char_type>(*i);
+        return output;
+    }
+}; // }}}
+template <>
+struct decoder<char8_t>: decoder<char> // {{{
+{
+}; // }}}
+
+// {{{ bulk conversion
+/// Decides how bulk conversion functions handle ill-formed input.
+enum class ConversionErrorPolicy
+{
+    /// Substitutes each maximal subpart of an ill-formed sequence with U+FFFD REPLACEMENT CHARACTER.
+    Replace,
+    /// Drops ill-formed sequences.
+    Skip,
+    /// Stops at the first ill-formed or incomplete sequence and reports its offset.
+    Stop,
+};
+
+enum class ConversionStatus
+{
+    /// The input has been converted up until ConversionResult::consumed (which may be less than
+    /// the input size if the output buffer is full).
+    Success,
+    /// Stopped at an ill-formed sequence starting at ConversionResult::consumed.
+    Invalid,
+    /// Stopped at an incomplete sequence at the end of the input, starting at ConversionResult::consumed.
+    Incomplete,
+};
+
+/// Holds the result of a bulk conversion.
+struct conversion_result
+{
+    /// Number of input code units consumed.
+    size_t consumed;
+
+    /// Number of output code units written.
+    size_t written;
+
+    ConversionStatus status;
+};
+
+/// Holds the result of decoding a single UTF-8 sequence.
+struct utf8_sequence
+{
+    /// The decoded codepoint, if status is ConversionStatus::Success.
+    char32_t value;
+
+    /// Length of the sequence, or of the maximal subpart of the ill-formed or incomplete sequence, in bytes.
+    size_t length;
+
+    ConversionStatus status;
+};
+
+/// Decodes the UTF-8 sequence at the start of the non-empty @p input,
+/// as per table 3-7 "Well-Formed UTF-8 Byte Sequences" of the Unicode Standard.
+constexpr utf8_sequence decode_utf8_sequence(std::string_view input) noexcept
+{
+    auto const lead = static_cast<uint8_t>(input[0]);
+
+    size_t length = 0;
+    char32_t value = 0;
+    uint8_t lower = 0x80;
+    uint8_t upper = 0xBF;
+
+    if (lead < 0x80)
+        return { lead, 1, ConversionStatus::Success };
+    else if (lead < 0xC2) // continuation byte, or overlong 2-byte sequence
+        return { 0, 1, ConversionStatus::Invalid };
+    else if (lead < 0xE0)
+    {
+        length = 2;
+        value = lead & 0b0001'1111;
+    }
+    else if (lead < 0xF0)
+    {
+        length = 3;
+        value = lead & 0b0000'1111;
+        if (lead == 0xE0)
+            lower = 0xA0; // overlong
+        else if (lead == 0xED)
+            upper = 0x9F; // surrogates
+    }
+    else if (lead < 0xF5)
+    {
+        length = 4;
+        value = lead & 0b0000'0111;
+        if (lead == 0xF0)
+            lower = 0x90; // overlong
+        else if (lead == 0xF4)
+            upper = 0x8F; // above U+10FFFF
+    }
+    else
+        return { 0, 1, ConversionStatus::Invalid };
+
+    for (size_t i = 1; i < length; ++i)
+    {
+        if (i == input.size())
+            return { 0, i, ConversionStatus::Incomplete };
+        auto const byte = static_cast<uint8_t>(input[i]);
+        if (byte < lower || byte > upper)
+            return { 0, i, ConversionStatus::Invalid };
+        value = (value << 6) | (byte & 0b0011'1111);
+        lower = 0x80;
+        upper = 0xBF;
+    }
+
+    return { value, length, ConversionStatus::Success };
+}
+
+/// Returns the maximum number of UTF-32 codepoints @p size UTF-8 bytes can be converted to.
+constexpr size_t max_utf32_length_from_utf8(size_t size) noexcept
+{
+    return size;
+}
+
+/// Converts UTF-8 @p input into UTF-32, writing to the caller provided @p output buffer.
+///
+/// Input is validated as per the Unicode Standard, i.e. overlong encodings, surrogates, and
+/// values above U+10FFFF are ill-formed. Unless @p policy is ConversionErrorPolicy::Stop,
+/// an incomplete sequence at the end of the input is treated as ill-formed.
+///
+/// Conversion stops early when @p output is full. Use max_utf32_length_from_utf8()
+/// to size it for converting all of @p input at once.
+conversion_result convert_utf8_to_utf32(
+    std::string_view input,
+    std::span<char32_t> output,
+    ConversionErrorPolicy policy = ConversionErrorPolicy::Replace) noexcept;
+
+/// Returns the number of UTF-8 bytes @p input is converted to.
+///
+/// This is exact when converting with ConversionErrorPolicy::Replace, and an upper bound otherwise.
+size_t utf8_length(std::u32string_view input) noexcept;
+
+/// Returns the maximum number of UTF-8 bytes @p size UTF-32 codepoints can be converted to.
+constexpr size_t max_utf8_length_from_utf32(size_t size) noexcept
+{
+    return 4 * size;
+}
+
+/// Converts UTF-32 @p input into UTF-8, writing to the caller provided @p output buffer.
+///
+/// Surrogates and values above U+10FFFF are ill-formed.
+/// Conversion stops early, at a codepoint boundary, when @p output is full.
+conversion_result convert_utf32_to_utf8(
+    std::u32string_view input,
+    std::span<char> output,
+    ConversionErrorPolicy policy = ConversionErrorPolicy::Replace) noexcept;
+
+/// Returns the number of UTF-16 code units @p input is converted to.
+///
+/// This is exact when converting with ConversionErrorPolicy::Replace, and an upper bound otherwise.
+size_t utf16_length(std::u32string_view input) noexcept;
+
+/// Returns the maximum number of UTF-16 code units @p size UTF-32 codepoints can be converted to.
+constexpr size_t max_utf16_length_from_utf32(size_t size) noexcept
+{
+    return 2 * size;
+}
+
+/// Converts UTF-32 @p input into UTF-16, writing to the caller provided @p output buffer.
+///
+/// Surrogates and values above U+10FFFF are ill-formed.
+/// Conversion stops early, at a codepoint boundary, when @p output is full.
+conversion_result convert_utf32_to_utf16(
+    std::u32string_view input,
+    std::span<char16_t> output,
+    ConversionErrorPolicy policy = ConversionErrorPolicy::Replace) noexcept;
+
+/// Returns the maximum number of UTF-32 codepoints @p size UTF-16 code units can be converted to.
+constexpr size_t max_utf32_length_from_utf16(size_t size) noexcept
+{
+    return size;
+}
+
+/// Converts UTF-16 @p input into UTF-32, writing to the caller provided @p output buffer.
+///
+/// Unpaired surrogates are ill-formed. Unless @p policy is ConversionErrorPolicy::Stop,
+/// a high surrogate at the end of the input is treated as ill-formed.
+///
+/// Conversion stops early when @p output is full.
+conversion_result convert_utf16_to_utf32(
+    std::u16string_view input,
+    std::span<char32_t> output,
+    ConversionErrorPolicy policy = ConversionErrorPolicy::Replace) noexcept;
+// }}}
 
 namespace detail // {{{
 {
@@ -318,6 +520,24 @@ namespace detail // {{{
             *t++ = c;
         return t;
     }
+
+    /// Converts @p input in chunks into a fixed size buffer, using one of the bulk conversion functions,
+    /// and copies the result to @p output.
+    template <typename T, typename S, typename OutputIterator, typename BulkConversion>
+    OutputIterator convert_buffered(std::basic_string_view<S> input,
+                                    OutputIterator output,
+                                    BulkConversion convert)
+    {
+        std::array<T, 256> buffer; // NOLINT(cppcoreguidelines-pro-type-member-init)
+        while (!input.empty())
+        {
+            auto const result = convert(input, std::span<T>(buffer));
+            for (size_t i = 0; i < result.written; ++i)
+                *output++ = buffer[i];
+            input.remove_prefix(result.consumed);
+        }
+        return output;
+    }
 } // namespace detail
 
 /// @p _input with element type @p S to the appropricate type of @p _output.
@@ -326,6 +546,35 @@ OutputIterator convert_to(std::basic_string_view<S> input, OutputIterator output
 {
     if constexpr (std::is_same_v<S, T>)
         return detail::convert_identity(input, output);
+    else if constexpr (std::is_same_v<S, char8_t>)
+        return convert_to<T>(std::string_view(reinterpret_cast<char const*>(input.data()), input.size()),
+                             output);
+    else if constexpr (std::is_same_v<S, char> && std::is_same_v<T, char32_t>)
+        return detail::convert_buffered<char32_t>(input, output, [](auto in, auto out) noexcept {
+            return convert_utf8_to_utf32(in, out, ConversionErrorPolicy::Skip);
+        });
+    else if constexpr (std::is_same_v<S, char32_t> && std::is_same_v<T, char>)
+        return detail::convert_buffered<char>(input, output, [](auto in, auto out) noexcept {
+            return convert_utf32_to_utf8(in, out, ConversionErrorPolicy::Skip);
+        });
+    else if constexpr (std::is_same_v<S, char32_t> && std::is_same_v<T, char16_t>)
+        return detail::convert_buffered<char16_t>(input, output, [](auto in, auto out) noexcept {
+            return convert_utf32_to_utf16(in, out, ConversionErrorPolicy::Skip);
+        });
+    else if constexpr (std::is_same_v<S, char16_t> && std::is_same_v<T, char32_t>)
+        return detail::convert_buffered<char32_t>(input, output, [](auto in, auto out) noexcept {
+            return convert_utf16_to_utf32(in, out, ConversionErrorPolicy::Skip);
+        });
+    else if constexpr (std::is_same_v<S, char> && std::is_same_v<T, char16_t>)
+        return detail::convert_buffered<char16_t>(input, output, [](auto in, auto out) noexcept {
+            // Each codepoint in the intermediate buffer takes at most two UTF-16 code units.
+            std::array<char32_t, 128> codepoints; // NOLINT(cppcoreguidelines-pro-type-member-init)
+            auto const decoded = convert_utf8_to_utf32(
+                in, std::span(codepoints).first(out.size() / 2), ConversionErrorPolicy::Skip);
+            auto const encoded = convert_utf32_to_utf16(
+                std::u32string_view(codepoints.data(), decoded.written), out, ConversionErrorPolicy::Skip);
+            return conversion_result { decoded.consumed, encoded.written, decoded.status };
+        });
     else
     {
         auto i = begin(input);
@@ -347,7 +596,23 @@ template <typename T, typename S>
 std::basic_string<T> convert_to(std::basic_string_view<S> in)
 {
     std::basic_string<T> out;
-    convert_to<T>(in, std::back_inserter(out));
+    if constexpr (std::is_same_v<S, char> && std::is_same_v<T, char32_t>)
+    {
+        out.resize(max_utf32_length_from_utf8(in.size()));
+        out.resize(convert_utf8_to_utf32(in, out, ConversionErrorPolicy::Skip).written);
+    }
+    else if constexpr (std::is_same_v<S, char32_t> && std::is_same_v<T, char>)
+    {
+        out.resize(utf8_length(in));
+        out.resize(convert_utf32_to_utf8(in, out, ConversionErrorPolicy::Skip).written);
+    }
+    else if constexpr (std::is_same_v<S, char32_t> && std::is_same_v<T, char16_t>)
+    {
+        out.resize(utf16_length(in));
+        out.resize(convert_utf32_to_utf16(in, out, ConversionErrorPolicy::Skip).written);
+    }
+    else
+        convert_to<T>(in, std::back_inserter(out));
     return out;
 }
 
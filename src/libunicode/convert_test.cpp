@@ -116,3 +116,206 @@ TEST_CASE("convert.utf8.incremental_decode", "[utf8]")
     REQUIRE(result.has_value());
     REQUIRE(result.value() == U'\U0001F600'); // 😀
 }
+
+namespace
+{
+u32string convert_utf8_to_utf32(string_view input, unicode::ConversionErrorPolicy policy)
+{
+    auto output = u32string(unicode::max_utf32_length_from_utf8(input.size()), U'\0');
+    auto const result = unicode::convert_utf8_to_utf32(input, output, policy);
+    CHECK(result.status == unicode::ConversionStatus::Success);
+    CHECK(result.consumed == input.size());
+    output.resize(result.written);
+    return output;
+}
+} // namespace
+
+TEST_CASE("convert.utf8_to_utf32", "[convert]")
+{
+    using unicode::ConversionErrorPolicy;
+
+    // Long enough for the vectorized US-ASCII code paths, with multibyte sequences in between.
+    auto const ascii = "The quick brown fox jumps over the lazy dog. "s;
+    auto const ascii32 = U"The quick brown fox jumps over the lazy dog. "s;
+    auto const input = ascii + "\xC3\xB6" + ascii + "\xE2\x82\xAC\xF0\x9F\x98\x80" + ascii;
+    auto const expected = ascii32 + U"ö" + ascii32 + U"€😀" + ascii32;
+    CHECK(convert_utf8_to_utf32(input, ConversionErrorPolicy::Replace) == expected);
+    CHECK(convert_utf8_to_utf32(input, ConversionErrorPolicy::Stop) == expected);
+    CHECK(convert_utf8_to_utf32("", ConversionErrorPolicy::Replace).empty());
+}
+
+TEST_CASE("convert.utf8_to_utf32.invalid", "[convert]")
+{
+    using unicode::ConversionErrorPolicy;
+
+    // Each maximal subpart of an ill-formed sequence is replaced by a single U+FFFD.
+    CHECK(convert_utf8_to_utf32("a\x80z", ConversionErrorPolicy::Replace) == U"a�z");
+    CHECK(convert_utf8_to_utf32("a\xC0\xAFz", ConversionErrorPolicy::Replace) == U"a��z");
+    CHECK(convert_utf8_to_utf32("a\xE0\x80\xAFz", ConversionErrorPolicy::Replace) == U"a���z");
+    CHECK(convert_utf8_to_utf32("a\xED\xA0\x80z", ConversionErrorPolicy::Replace) == U"a���z");
+    CHECK(convert_utf8_to_utf32("a\xF4\x90\x80\x80z", ConversionErrorPolicy::Replace)
+          == U"a����z");
+    CHECK(convert_utf8_to_utf32("a\xE2\x82z", ConversionErrorPolicy::Replace) == U"a�z");
+    CHECK(convert_utf8_to_utf32("a\xF0\x9F\x98", ConversionErrorPolicy::Replace) == U"a�");
+    CHECK(convert_utf8_to_utf32("a\xFF\xF0\x9F\x98\x80", ConversionErrorPolicy::Replace) == U"a�😀");
+
+    CHECK(convert_utf8_to_utf32("a\x80z", ConversionErrorPolicy::Skip) == U"az");
+    CHECK(convert_utf8_to_utf32("a\xE2\x82z\xF0\x9F", ConversionErrorPolicy::Skip) == U"az");
+}
+
+TEST_CASE("convert.utf8_to_utf32.stop", "[convert]")
+{
+    using unicode::ConversionErrorPolicy;
+    using unicode::ConversionStatus;
+
+    auto output = u32string(16, U'\0');
+
+    auto const invalid = unicode::convert_utf8_to_utf32("ab\xE2\x82z", output, ConversionErrorPolicy::Stop);
+    CHECK(invalid.status == ConversionStatus::Invalid);
+    CHECK(invalid.consumed == 2);
+    CHECK(invalid.written == 2);
+
+    auto const incomplete = unicode::convert_utf8_to_utf32("ab\xE2\x82", output, ConversionErrorPolicy::Stop);
+    CHECK(incomplete.status == ConversionStatus::Incomplete);
+    CHECK(incomplete.consumed == 2);
+    CHECK(incomplete.written == 2);
+}
+
+TEST_CASE("convert.utf8_to_utf32.output_full", "[convert]")
+{
+    auto const input = "0123456789abcdef0123456789abcdef0123456789\xE2\x82\xAC"sv;
+    auto output = u32string(40, U'\0');
+    auto const result = unicode::convert_utf8_to_utf32(input, output);
+    CHECK(result.status == unicode::ConversionStatus::Success);
+    CHECK(result.consumed == 40);
+    CHECK(result.written == 40);
+    CHECK(output == convert_to<char32_t>(input.substr(0, 40)));
+}
+
+TEST_CASE("convert.utf8_to_utf32.runs", "[convert]")
+{
+    using unicode::ConversionErrorPolicy;
+
+    // Long runs of equally sized sequences, as decoded by the vectorized code paths.
+    auto all = u32string {};
+    for (char32_t codepoint = 0x80; codepoint <= 0x10FFFF; ++codepoint)
+        if (codepoint < 0xD800 || codepoint > 0xDFFF)
+            all.push_back(codepoint);
+    CHECK(convert_utf8_to_utf32(convert_to<char>(u32string_view(all)), ConversionErrorPolicy::Stop) == all);
+
+    // Ill-formed sequences within such runs.
+    auto const cjk = u32string(40, U'一');
+    auto const latin = u32string(40, U'ö');
+    for (auto const& [run, invalid]: { pair { cjk, "\xED\xA0\x80"s },
+                                       pair { cjk, "\xE0\x80\x80"s },
+                                       pair { cjk, "\xE2\x82\xAC\x80\x80\x80"s },
+                                       pair { latin, "\xC1\xBF"s },
+                                       pair { latin, "\xC3\xB6\x80\x80"s } })
+    {
+        auto const text = convert_to<char>(u32string_view(run));
+        size_t const sequenceLength = run == cjk ? 3 : 2;
+        for (size_t offset = 0; offset < text.size(); offset += sequenceLength)
+        {
+            auto const input = text.substr(0, offset) + invalid + text.substr(offset);
+            auto const output = convert_utf8_to_utf32(input, ConversionErrorPolicy::Replace);
+            CHECK(output.size() > run.size());
+            CHECK(output.substr(0, offset / sequenceLength) == run.substr(0, offset / sequenceLength));
+            CHECK(convert_utf8_to_utf32(input, ConversionErrorPolicy::Skip).size() < output.size());
+        }
+    }
+}
+
+namespace
+{
+u32string all_codepoints()
+{
+    auto all = u32string {};
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+        if (codepoint < 0xD800 || codepoint > 0xDFFF)
+            all.push_back(codepoint);
+    return all;
+}
+} // namespace
+
+TEST_CASE("convert.utf32_to_utf8", "[convert]")
+{
+    using unicode::ConversionErrorPolicy;
+    using unicode::ConversionStatus;
+
+    auto const all = all_codepoints();
+    auto utf8 = string(unicode::utf8_length(all), '\0');
+    auto const result = unicode::convert_utf32_to_utf8(all, utf8);
+    CHECK(result.status == ConversionStatus::Success);
+    CHECK(result.consumed == all.size());
+    CHECK(result.written == utf8.size());
+    CHECK(unicode::convert_to<char32_t>(string_view(utf8)) == all);
+
+    // Ill-formed codepoints.
+    auto const invalid = U"a\xD800z\x110000"sv;
+    CHECK(unicode::to_utf8(invalid) == "a\xEF\xBF\xBDz\xEF\xBF\xBD");
+    CHECK(unicode::utf8_length(invalid) == 8);
+    CHECK(unicode::convert_to<char>(invalid) == "az");
+    auto const stopped = unicode::convert_utf32_to_utf8(invalid, utf8, ConversionErrorPolicy::Stop);
+    CHECK(stopped.status == ConversionStatus::Invalid);
+    CHECK(stopped.consumed == 1);
+    CHECK(stopped.written == 1);
+
+    // The output buffer is filled up to the last complete codepoint only.
+    auto output = string(5, '\0');
+    auto const full = unicode::convert_utf32_to_utf8(U"a€€", output);
+    CHECK(full.status == ConversionStatus::Success);
+    CHECK(full.consumed == 2);
+    CHECK(full.written == 4);
+
+    // Reusing the output storage.
+    auto reused = string {};
+    unicode::to_utf8(U"Hello, 😀"sv, reused);
+    CHECK(reused == "Hello, \xF0\x9F\x98\x80");
+    unicode::to_utf8(U"€"sv, reused);
+    CHECK(reused == "\xE2\x82\xAC");
+}
+
+TEST_CASE("convert.utf16", "[convert]")
+{
+    using unicode::ConversionErrorPolicy;
+    using unicode::ConversionStatus;
+
+    auto const all = all_codepoints();
+    auto utf16 = u16string(unicode::utf16_length(all), u'\0');
+    auto const encoded = unicode::convert_utf32_to_utf16(all, utf16);
+    CHECK(encoded.status == ConversionStatus::Success);
+    CHECK(encoded.consumed == all.size());
+    CHECK(encoded.written == utf16.size());
+
+    auto utf32 = u32string(unicode::max_utf32_length_from_utf16(utf16.size()), U'\0');
+    auto const decoded = unicode::convert_utf16_to_utf32(utf16, utf32);
+    CHECK(decoded.status == ConversionStatus::Success);
+    CHECK(decoded.consumed == utf16.size());
+    utf32.resize(decoded.written);
+    CHECK(utf32 == all);
+
+    CHECK(unicode::convert_to<char16_t>(string_view(unicode::to_utf8(all))) == utf16);
+    CHECK(unicode::convert_to<char32_t>(u16string_view(utf16)) == all);
+
+    // Ill-formed UTF-32 and unpaired surrogates.
+    CHECK(unicode::convert_to<char16_t>(U"a\xDC00z\x110000"sv) == u"az");
+    auto output = u32string(8, U'\0');
+    auto const replaced = unicode::convert_utf16_to_utf32(u"a\xDC00\xD800z\xD800"sv, output);
+    CHECK(replaced.written == 5);
+    CHECK(output.substr(0, 5) == U"a\xFFFD\xFFFDz\xFFFD");
+
+    auto const incomplete =
+        unicode::convert_utf16_to_utf32(u"ab\xD83D"sv, output, ConversionErrorPolicy::Stop);
+    CHECK(incomplete.status == ConversionStatus::Incomplete);
+    CHECK(incomplete.consumed == 2);
+    auto const invalid = unicode::convert_utf16_to_utf32(u"ab\xD83Dz"sv, output, ConversionErrorPolicy::Stop);
+    CHECK(invalid.status == ConversionStatus::Invalid);
+    CHECK(invalid.consumed == 2);
+}
+
+TEST_CASE("convert.char8_t", "[convert]")
+{
+    auto const s8 = u8"[ö€😀]"sv;
+    CHECK(unicode::convert_to<char32_t>(s8) == U"[ö€😀]");
+    CHECK(unicode::convert_to<char8_t>(U"[ö€😀]"sv) == s8);
+}
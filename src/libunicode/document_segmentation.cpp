@@ -0,0 +1,125 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/document_segmentation.h>
+#include <libunicode/utf8_grapheme_segmenter.h>
+#include <libunicode/utf8_run_segmenter.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace unicode
+{
+
+namespace
+{
+    /// Array in a monotonic arena, leaving the memory outgrown to the arena.
+    ///
+    /// When full, it grows to the capacity extrapolated from the part of the text segmented so far,
+    /// but at least by half of its capacity.
+    template <typename T>
+    class arena_array
+    {
+      public:
+        arena_array(std::pmr::memory_resource& arena, size_t capacity, size_t total):
+            _arena { arena }, _total { total }
+        {
+            reserve(std::max(capacity, size_t { 1 }));
+        }
+
+        /// Appends @p value, being at offset @p progress of the text.
+        void push_back(T value, size_t progress)
+        {
+            if (_size == _capacity)
+            {
+                auto const extrapolated = static_cast<double>(_size) * static_cast<double>(_total)
+                                          / static_cast<double>(std::max(progress, size_t { 1 }));
+                reserve(std::max(_capacity + _capacity / 2, static_cast<size_t>(extrapolated * 1.125) + 16));
+            }
+            std::construct_at(_data + _size, value);
+            ++_size;
+        }
+
+        [[nodiscard]] std::span<T const> view() const noexcept { return { _data, _size }; }
+
+      private:
+        void reserve(size_t capacity)
+        {
+            auto* const data = static_cast<T*>(_arena.allocate(capacity * sizeof(T), alignof(T)));
+            std::uninitialized_copy_n(_data, _size, data);
+            _data = data;
+            _capacity = capacity;
+        }
+
+        std::pmr::memory_resource& _arena;
+        size_t _total;
+        T* _data = nullptr;
+        size_t _size = 0;
+        size_t _capacity = 0;
+    };
+} // namespace
+
+document_segmentation segment_document(std::string_view text, std::pmr::monotonic_buffer_resource& arena)
+{
+    // The grapheme clusters and runs are segmented window by window, for both to work on the same bytes
+    // while these are still in the cache.
+    auto constexpr WindowSize = size_t { 64 * 1024 };
+
+    // Text of two or more bytes per grapheme cluster fits right away, and US-ASCII text takes one growth.
+    auto const size = text.size();
+    auto const clusterCapacity = size / 2 + 1;
+    auto const runCapacity = size / 64 + 1;
+
+    auto clusterOffsets = arena_array<size_t> { arena, clusterCapacity + 1, size };
+    auto clusterWidths = arena_array<uint8_t> { arena, clusterCapacity, size };
+    auto runOffsets = arena_array<size_t> { arena, runCapacity + 1, size };
+    auto runScripts = arena_array<Script> { arena, runCapacity, size };
+    auto runPresentations = arena_array<PresentationStyle> { arena, runCapacity, size };
+
+    auto const onRun = utf8_run_segmenter::range_handler { [&](utf8_run_segmenter::range const& run) {
+        runOffsets.push_back(run.start, run.start);
+        runScripts.push_back(std::get<Script>(run.properties), run.start);
+        runPresentations.push_back(std::get<PresentationStyle>(run.properties), run.start);
+    } };
+    auto const onCluster = [&](utf8_grapheme_cluster const& cluster) {
+        auto const offset = static_cast<size_t>(cluster.text.data() - text.data());
+        clusterOffsets.push_back(offset, offset);
+        clusterWidths.push_back(static_cast<uint8_t>(cluster.width), offset);
+    };
+
+    auto const clusters = utf8_grapheme_cluster_segmenter { text };
+    auto cluster = clusters.begin();
+    auto const clustersEnd = clusters.end();
+    auto runs = utf8_run_segmenter {};
+    for (size_t windowStart = 0; windowStart < text.size(); windowStart += WindowSize)
+    {
+        auto const window = text.substr(windowStart, WindowSize);
+        runs.feed(window, onRun);
+        auto const* const windowEnd = window.data() + window.size();
+        for (; cluster != clustersEnd && cluster->text.data() + cluster->text.size() <= windowEnd; ++cluster)
+            onCluster(*cluster);
+    }
+    runs.finish(onRun);
+    for (; cluster != clustersEnd; ++cluster)
+        onCluster(*cluster);
+
+    clusterOffsets.push_back(size, size);
+    runOffsets.push_back(size, size);
+
+    return document_segmentation {
+        clusterOffsets.view(), clusterWidths.view(),
+        runOffsets.view(),     runScripts.view(),    runPresentations.view(),
+    };
+}
+
+} // namespace unicode
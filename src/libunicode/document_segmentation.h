@@ -0,0 +1,60 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/emoji_segmenter.h>
+#include <libunicode/ucd_enums.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+
+namespace unicode
+{
+
+/// Grapheme clusters and runs of a whole UTF-8 document, stored as structure of arrays.
+///
+/// The arrays are allocated from the arena passed to segment_document() and stay valid as long as
+/// its memory is not released. The offsets are in bytes and have one element more than the other
+/// arrays, being the size of the text, such that the i-th element spans [offsets[i], offsets[i + 1]).
+struct document_segmentation
+{
+    /// Grapheme clusters, as segmented by utf8_grapheme_cluster_segmenter.
+    std::span<size_t const> cluster_offsets;
+    std::span<uint8_t const> cluster_widths;
+
+    /// Runs, as segmented by utf8_run_segmenter.
+    std::span<size_t const> run_offsets;
+    std::span<Script const> run_scripts;
+    std::span<PresentationStyle const> run_presentations;
+
+    [[nodiscard]] size_t cluster_count() const noexcept { return cluster_widths.size(); }
+    [[nodiscard]] size_t run_count() const noexcept { return run_scripts.size(); }
+};
+
+/// Segments the UTF-8 @p text into grapheme clusters and runs in a single pass, allocating the
+/// arrays of the result from @p arena.
+///
+/// Each array is allocated at a size estimated from the size of @p text, and grown to the size
+/// extrapolated from the part segmented so far if it does not fit, such that the whole result
+/// takes a handful of allocations only.
+/// The memory outgrown is not reclaimed before @p arena is released as a whole.
+///
+/// Ill-formed UTF-8 sequences are segmented as U+FFFD REPLACEMENT CHARACTER.
+[[nodiscard]] document_segmentation segment_document(std::string_view text,
+                                                     std::pmr::monotonic_buffer_resource& arena);
+
+} // namespace unicode
@@ -0,0 +1,130 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/document_segmentation.h>
+#include <libunicode/parallel_segmenter.h>
+#include <libunicode/utf8_run_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::string_view_literals;
+using namespace unicode;
+
+namespace
+{
+/// Counts the allocations made by a monotonic_buffer_resource.
+class counting_resource: public std::pmr::memory_resource
+{
+  public:
+    size_t allocations = 0;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+std::vector<utf8_run_segmenter::range> runs_of(std::string_view text)
+{
+    auto runs = std::vector<utf8_run_segmenter::range> {};
+    auto segmenter = utf8_run_segmenter {};
+    auto const collect = [&](utf8_run_segmenter::range const& run) {
+        runs.push_back(run);
+    };
+    segmenter.feed(text, collect);
+    segmenter.finish(collect);
+    return runs;
+}
+
+void check_segmentation(std::string_view text, document_segmentation const& segmentation)
+{
+    auto expectedOffsets = grapheme_cluster_offsets(text);
+    expectedOffsets.push_back(text.size());
+    CHECK(std::vector(segmentation.cluster_offsets.begin(), segmentation.cluster_offsets.end())
+          == expectedOffsets);
+    auto const& widths = segmentation.cluster_widths;
+    CHECK(std::accumulate(widths.begin(), widths.end(), size_t { 0 })
+          == count_grapheme_clusters(text).columns);
+
+    auto const& offsets = segmentation.run_offsets;
+    REQUIRE(offsets.size() == segmentation.run_count() + 1);
+    auto runs = std::vector<utf8_run_segmenter::range> {};
+    for (size_t i = 0; i < segmentation.run_count(); ++i)
+        runs.push_back({ offsets[i],
+                         offsets[i + 1],
+                         { segmentation.run_scripts[i], segmentation.run_presentations[i] } });
+    CHECK(runs == runs_of(text));
+}
+} // namespace
+
+TEST_CASE("document_segmentation.empty")
+{
+    auto arena = std::pmr::monotonic_buffer_resource {};
+    auto const segmentation = segment_document(""sv, arena);
+    CHECK(segmentation.cluster_count() == 0);
+    CHECK(segmentation.run_count() == 0);
+    CHECK(std::vector(segmentation.cluster_offsets.begin(), segmentation.cluster_offsets.end())
+          == std::vector<size_t> { 0 });
+    CHECK(std::vector(segmentation.run_offsets.begin(), segmentation.run_offsets.end())
+          == std::vector<size_t> { 0 });
+}
+
+TEST_CASE("document_segmentation.mixed")
+{
+    auto text = convert_to<char>(std::u32string_view(U"Hello \U0001F600 World\r\n\u4E00\u4E8C\u0301 "
+                                                     U"\u0627\u0644\U0001F469\u200D\U0001F469\u200D"
+                                                     U"\U0001F467 1\uFE0F\u20E3"));
+    text += "\xFF\xFE"sv;
+    auto arena = std::pmr::monotonic_buffer_resource {};
+    auto const segmentation = segment_document(text, arena);
+    CHECK(segmentation.cluster_widths[6] == 2);
+    check_segmentation(text, segmentation);
+}
+
+TEST_CASE("document_segmentation.large")
+{
+    // Larger than the windows the text is segmented in, and than the estimated capacities.
+    auto const line = convert_to<char>(std::u32string_view(U"Some text \U0001F600\u4E00\u4E8C, "));
+    auto text = std::string {};
+    while (text.size() < 1024 * 1024)
+        text += line;
+    text += "\xE4\xB8"sv; // incomplete UTF-8 sequence at the end
+
+    auto upstream = counting_resource {};
+    auto arena = std::pmr::monotonic_buffer_resource { &upstream };
+    check_segmentation(text, segment_document(text, arena));
+    CHECK(upstream.allocations < 16);
+
+    arena.release();
+    auto const ascii = std::string(200'000, 'a');
+    check_segmentation(ascii, segment_document(ascii, arena));
+}
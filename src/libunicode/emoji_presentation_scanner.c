@@ -102,6 +102,7 @@ static const int emoji_presentation_start = 2;
 #line 89 "emoji_presentation_scanner.rl"
 
 
+template <typename emoji_text_iter_t>
 static emoji_text_iter_t
 scan_emoji_presentation (emoji_text_iter_t p,
     const emoji_text_iter_t pe,
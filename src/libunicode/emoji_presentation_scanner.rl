@@ -91,6 +91,7 @@ text_run => { *is_emoji = false; return te; };
 
 }%%
 
+template <typename emoji_text_iter_t>
 static emoji_text_iter_t
 scan_emoji_presentation (emoji_text_iter_t p,
     const emoji_text_iter_t pe,
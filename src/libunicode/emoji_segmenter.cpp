@@ -14,8 +14,10 @@
 
 #include <libunicode/codepoint_properties_data.h>
 #include <libunicode/emoji_segmenter.h>
+#include <libunicode/intrinsics.h>
 #include <libunicode/ucd.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -25,33 +27,56 @@ namespace unicode
 namespace
 {
 
+    /// Looks up the EmojiSegmentationCategory of the codepoints of a text.
+    struct codepoint_categories
+    {
+        char32_t const* text = U"";
+        codepoint_properties::tables_view const* tables = &codepoint_properties::configured_tables();
+
+        EmojiSegmentationCategory operator()(size_t position) const noexcept
+        {
+            return tables->get(text[position]).emoji_segmentation_category;
+        }
+    };
+
+    /// Takes the EmojiSegmentationCategory of the codepoints of a text from an emoji_category_source.
+    struct source_categories
+    {
+        detail::emoji_category_source* source = nullptr;
+
+        EmojiSegmentationCategory operator()(size_t position) const noexcept
+        {
+            return source->category(position);
+        }
+    };
+
+    template <typename Categories>
     class RagelIterator
     {
         EmojiSegmentationCategory category_;
-        char32_t const* buffer_;
+        Categories categories_;
         size_t size_;
         size_t currentCursorEnd_;
 
       public:
-        RagelIterator(char32_t const* buffer, size_t size, size_t cursor) noexcept:
+        RagelIterator(Categories categories, size_t size, size_t cursor) noexcept:
             category_ { EmojiSegmentationCategory::Invalid },
-            buffer_ { buffer },
+            categories_ { categories },
             size_ { size },
             currentCursorEnd_ { cursor }
         {
             updateCategory();
         }
 
-        RagelIterator() noexcept: RagelIterator(U"", 0, 0) {}
+        RagelIterator() noexcept: RagelIterator(Categories {}, 0, 0) {}
 
-        constexpr char32_t codepoint() const noexcept { return buffer_[currentCursorEnd_]; }
         constexpr EmojiSegmentationCategory category() const noexcept { return category_; }
         constexpr size_t cursor() const noexcept { return currentCursorEnd_; }
 
         void updateCategory() noexcept
         {
             if (currentCursorEnd_ < size_)
-                category_ = codepoint_properties::get(codepoint()).emoji_segmentation_category;
+                category_ = categories_(currentCursorEnd_);
             else
                 category_ = EmojiSegmentationCategory::Invalid;
         }
@@ -74,7 +99,7 @@ namespace
         RagelIterator operator+(long v) const noexcept
         {
             // TODO: assert() on integer overflow
-            return { buffer_, size_, currentCursorEnd_ + (size_t) v };
+            return { categories_, size_, currentCursorEnd_ + (size_t) v };
         }
 
         RagelIterator operator-(long v) const noexcept
@@ -82,7 +107,7 @@ namespace
             if (v >= 0)
             {
                 assert(currentCursorEnd_ >= static_cast<size_t>(v));
-                return { buffer_, size_, currentCursorEnd_ - (size_t) v };
+                return { categories_, size_, currentCursorEnd_ - (size_t) v };
             }
             else
             {
@@ -98,19 +123,117 @@ namespace
             return *this;
         }
 
+        // Iterators are only compared with the ones of the same text.
         constexpr bool operator==(RagelIterator const& rhs) const noexcept
         {
-            return buffer_ == rhs.buffer_ && size_ == rhs.size_ && currentCursorEnd_ == rhs.currentCursorEnd_;
+            return size_ == rhs.size_ && currentCursorEnd_ == rhs.currentCursorEnd_;
         }
 
         constexpr bool operator!=(RagelIterator const& rhs) const noexcept { return !(*this == rhs); }
     };
 
-    using emoji_text_iter_t = RagelIterator;
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+    /// Tests if any of the 4 codepoints in @p batch lies within any of the EmojiCandidateRanges.
+    bool any_emoji_candidate(intrinsics::m128i batch) noexcept
+    {
+        auto result = intrinsics::setzero();
+        for (auto const range: detail::EmojiCandidateRanges)
+        {
+            auto const offset = intrinsics::sub_epi32(batch, intrinsics::set1_epi32(range.first));
+            auto const within = intrinsics::compare_less_epu32(offset, intrinsics::set1_epi32(range.count));
+            result = intrinsics::or128(result, within);
+        }
+        return intrinsics::any(result);
+    }
+#endif
+
+    /// Tests if the codepoint at @p position of the @p size codepoints of @p text is scanned as text
+    /// presentation on its own, i.e. if it is not part of any emoji, or an emoji of text presentation
+    /// by default that is not followed by what would make it part of a longer sequence.
+    template <typename Categories>
+    bool is_plain_text(char32_t const* text, size_t position, size_t size, Categories const& categories) noexcept
+    {
+        switch (categories(position))
+        {
+            case EmojiSegmentationCategory::Invalid: return true;
+            case EmojiSegmentationCategory::Emoji:
+            case EmojiSegmentationCategory::EmojiTextPresentation:
+            case EmojiSegmentationCategory::KeyCapBase: {
+                // Such as digits or U+00A9 COPYRIGHT SIGN, unless followed by
+                // ZWJ, U+20E0 COMBINING ENCLOSING CIRCLE BACKSLASH, VS15 or VS16.
+                if (position + 1 == size)
+                    return true;
+                auto const next = text[position + 1];
+                return next != 0x200D && next != 0x20E0 && next != 0xFE0E && next != 0xFE0F;
+            }
+            default: return false;
+        }
+    }
+
+    /// Returns the position of the first codepoint in [position, limit) of the @p size codepoints
+    /// of @p text that is not plain text (see above), or limit if there is none.
+    template <typename Categories>
+    size_t find_emoji_candidate(
+        char32_t const* text, size_t position, size_t limit, size_t size, Categories const& categories) noexcept
+    {
+        constexpr auto BatchSize = static_cast<ptrdiff_t>(4);
+
+        auto const* input = text + position;
+        auto const* const end = text + limit;
+        while (input != end)
+        {
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+            while (end - input >= BatchSize
+                   && !any_emoji_candidate(intrinsics::load_unaligned((intrinsics::m128i const*) input)))
+                input += BatchSize;
+#endif
+            for (auto const* const batchEnd = input + std::min(BatchSize, end - input); input != batchEnd;
+                 ++input)
+                if (detail::is_emoji_candidate(*input)
+                    && !is_plain_text(text, static_cast<size_t>(input - text), size, categories))
+                    return static_cast<size_t>(input - text);
+        }
+
+        return limit;
+    }
 
 #include "emoji_presentation_scanner.c"
+
+    /// Scans the token starting at @p cursor, see detail::scan_emoji_token().
+    template <typename Categories>
+    size_t scan_token(char32_t const* text,
+                      size_t size,
+                      size_t cursor,
+                      size_t limit,
+                      Categories const& categories,
+                      bool* isEmoji) noexcept
+    {
+        // Plain text is scanned as text presentation codepoint by codepoint,
+        // so skip all of it at once, and only run the scanner on what may be an emoji.
+        if (auto const candidate = find_emoji_candidate(text, cursor, limit, size, categories);
+            candidate != cursor)
+        {
+            *isEmoji = false;
+            return candidate;
+        }
+
+        auto const i = RagelIterator<Categories>(categories, size, cursor);
+        auto const e = RagelIterator<Categories>(categories, size, size);
+        auto const o = scan_emoji_presentation(i, e, isEmoji);
+        return o.cursor();
+    }
 } // namespace
 
+size_t detail::scan_emoji_token(char32_t const* text,
+                                size_t size,
+                                size_t cursor,
+                                size_t limit,
+                                emoji_category_source& categories,
+                                bool* isEmoji) noexcept
+{
+    return scan_token(text, size, cursor, limit, source_categories { &categories }, isEmoji);
+}
+
 emoji_segmenter::emoji_segmenter(char32_t const* buffer, size_t size) noexcept:
     buffer_ { buffer }, size_ { size }
 {
@@ -160,10 +283,7 @@ bool emoji_segmenter::consume(out<size_t> size, out<PresentationStyle> emoji) no
 
 size_t emoji_segmenter::consume_once()
 {
-    auto const i = RagelIterator(buffer_, size_, currentCursorEnd_);
-    auto const e = RagelIterator(buffer_, size_, size_);
-    auto const o = scan_emoji_presentation(i, e, &isNextEmoji_);
-    return o.cursor();
+    return scan_token(buffer_, size_, currentCursorEnd_, size_, codepoint_categories { buffer_ }, &isNextEmoji_);
 }
 
 } // namespace unicode
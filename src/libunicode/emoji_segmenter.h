@@ -17,6 +17,8 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <ostream>
 #include <utility>
 
@@ -51,6 +53,61 @@ enum class EmojiSegmentationCategory : int8_t
     TagTerm = 15,
 };
 
+namespace detail
+{
+    struct codepoint_range
+    {
+        char32_t first;
+        char32_t count;
+    };
+
+    /// Ranges of codepoints that contain all codepoints of an EmojiSegmentationCategory other than Invalid.
+    ///
+    /// Most text outside of emoji lies outside of these, and is thus known not to be part of an emoji
+    /// without looking up its codepoint properties.
+    inline constexpr std::array<codepoint_range, 6> EmojiCandidateRanges { {
+        { 0x0023, 0x17 },   // U+0023 NUMBER SIGN .. U+0039 DIGIT NINE
+        { 0x00A9, 0x06 },   // U+00A9 COPYRIGHT SIGN .. U+00AE REGISTERED SIGN
+        { 0x200D, 0x128D }, // U+200D ZERO WIDTH JOINER .. U+3299 CIRCLED IDEOGRAPH SECRET
+        { 0xFE0E, 0x02 },   // VS15, VS16
+        { 0x1F004, 0xAF3 }, // U+1F004 MAHJONG TILE RED DRAGON .. U+1FAF6 HEART HANDS
+        { 0xE0030, 0x50 },  // U+E0030 TAG DIGIT ZERO .. U+E007F CANCEL TAG
+    } };
+
+    /// Tests if the codepoint lies within any of the EmojiCandidateRanges.
+    constexpr bool is_emoji_candidate(char32_t codepoint) noexcept
+    {
+        return std::any_of(EmojiCandidateRanges.begin(), EmojiCandidateRanges.end(), [=](auto range) {
+            return codepoint - range.first < range.count;
+        });
+    }
+
+    /// Source of the EmojiSegmentationCategory of the codepoints of a text, for segmenters that
+    /// look up the codepoint properties of the text themselves, such as fused_run_segmenter.
+    class emoji_category_source
+    {
+      public:
+        virtual ~emoji_category_source() = default;
+
+        /// @returns the EmojiSegmentationCategory of the codepoint at @p position.
+        virtual EmojiSegmentationCategory category(size_t position) noexcept = 0;
+    };
+
+    /// Scans the token starting at the codepoint @p cursor of the @p size codepoints of @p text
+    /// the way emoji_segmenter does, with the emoji segmentation categories taken from @p categories.
+    ///
+    /// Plain text is skipped up to @p limit at most (which must be beyond @p cursor),
+    /// such that a caller can bound how far ahead of it the categories are asked for.
+    ///
+    /// @returns the end of the token, storing whether it is of emoji presentation into @p isEmoji.
+    size_t scan_emoji_token(char32_t const* text,
+                            size_t size,
+                            size_t cursor,
+                            size_t limit,
+                            emoji_category_source& categories,
+                            bool* isEmoji) noexcept;
+} // namespace detail
+
 /**
  * emoji_segmenter API for segmenting emojis into text-emoji and emoji-emoji presentations.
  *
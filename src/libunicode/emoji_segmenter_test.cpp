@@ -140,3 +140,35 @@ TEST_CASE("emoji_segmenter.mixed_complex", "[emoji_segmenter]")
                       { U")合!", PresentationStyle::Text },             // Kanji text
                   });
 }
+
+TEST_CASE("emoji_segmenter.candidate_ranges", "[emoji_segmenter]")
+{
+    // Codepoints outside of the candidate ranges are skipped as text without looking at their properties.
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+        if (codepoint_properties::get(codepoint).emoji_segmentation_category
+            != EmojiSegmentationCategory::Invalid)
+        {
+            INFO(fmt::format("U+{:04X}", static_cast<unsigned>(codepoint)));
+            REQUIRE(detail::is_emoji_candidate(codepoint));
+        }
+}
+
+TEST_CASE("emoji_segmenter.long_text_runs", "[emoji_segmenter]")
+{
+    // Long runs of text, including codepoints within the candidate ranges that are no emoji
+    // (such as U+3042 HIRAGANA LETTER A), around emoji, and at odd offsets to the batches skipped at once.
+    auto const latin = u32string(37, U'a');
+    auto const mixed = U"Hello, \u4E16\u754C \u3042\u3044\u3046 \u00E9t\u00E9 (1) " + latin;
+    test_segments(__LINE__,
+                  {
+                      { mixed, PresentationStyle::Text },
+                      { U"\U0001F600\U0001F1E9\U0001F1EA", PresentationStyle::Emoji },
+                      { latin + U"1\u20E3" + latin, PresentationStyle::Text },
+                      { U"1\uFE0F\u20E3", PresentationStyle::Emoji },
+                      { mixed + U"\u00A9", PresentationStyle::Text },
+                      { U"\u00A9\uFE0F", PresentationStyle::Emoji },
+                      { U"2024-01-01 12:00 \u00A9\u2122 #1 \u260E\uFE0E", PresentationStyle::Text },
+                      { U"#\u200D\U0001F600\u2122\uFE0F", PresentationStyle::Emoji },
+                      { U"9", PresentationStyle::Text },
+                  });
+}
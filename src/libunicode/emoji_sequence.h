@@ -0,0 +1,76 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace unicode
+{
+
+/// Hash of a sequence of codepoints (FNV-1a over whole codepoints), as used for looking up
+/// RGI emoji sequences.
+///
+/// It is computed one codepoint at a time, such that segmenters can compute it along with
+/// the grapheme cluster they are segmenting, rather than in another pass over it.
+struct emoji_sequence_hash
+{
+    uint32_t value = 0x811C9DC5;
+
+    constexpr void append(char32_t codepoint) noexcept
+    {
+        value = static_cast<uint32_t>((value ^ codepoint) * 0x01000193u);
+    }
+
+    [[nodiscard]] static constexpr emoji_sequence_hash of(std::u32string_view sequence) noexcept
+    {
+        auto hash = emoji_sequence_hash {};
+        for (auto const codepoint: sequence)
+            hash.append(codepoint);
+        return hash;
+    }
+
+    constexpr bool operator==(emoji_sequence_hash const&) const noexcept = default;
+};
+
+namespace detail
+{
+    /// Maps @p hash to one of @p count slots of a perfect hash table, as generated by mktables.py,
+    /// varying with @p salt.
+    [[nodiscard]] constexpr size_t perfect_hash_slot(uint32_t hash, uint32_t salt, size_t count) noexcept
+    {
+        auto const mixed = static_cast<uint32_t>(((hash + salt) * 0x9E3779B9u) ^ (hash * 0x31415926u));
+        return static_cast<size_t>((uint64_t { mixed } * count) >> 32);
+    }
+} // namespace detail
+
+/// Tests whether @p sequence is a recommended for general interchange (RGI) emoji sequence,
+/// as listed in emoji-sequences.txt and emoji-zwj-sequences.txt (see UTS #51), e.g. a flag,
+/// keycap, tag, emoji modifier or emoji ZWJ sequence, or a basic emoji.
+///
+/// RGI emoji sequences are commonly displayed as a single glyph, whereas other sequences
+/// of emoji are displayed as their individual emoji.
+///
+/// The sequences are looked up in a minimal perfect hash table in constant time,
+/// given @p hash being the emoji_sequence_hash of @p sequence.
+[[nodiscard]] bool is_rgi_emoji_sequence(std::u32string_view sequence, emoji_sequence_hash hash) noexcept;
+
+/// Same as above, but computing the hash of @p sequence.
+[[nodiscard]] inline bool is_rgi_emoji_sequence(std::u32string_view sequence) noexcept
+{
+    return is_rgi_emoji_sequence(sequence, emoji_sequence_hash::of(sequence));
+}
+
+} // namespace unicode
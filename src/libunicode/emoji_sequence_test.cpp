@@ -0,0 +1,99 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/emoji_sequence.h>
+#include <libunicode/utf8_grapheme_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::string_view_literals;
+using unicode::emoji_sequence_hash;
+using unicode::is_rgi_emoji_sequence;
+
+TEST_CASE("emoji_sequence.hash", "[emoji_sequence]")
+{
+    static_assert(emoji_sequence_hash::of(U""sv).value == 0x811C9DC5);
+
+    auto hash = emoji_sequence_hash {};
+    for (auto const codepoint: U"\U0001F468\u200D\U0001F469"sv)
+        hash.append(codepoint);
+    CHECK(hash == emoji_sequence_hash::of(U"\U0001F468\u200D\U0001F469"sv));
+    CHECK(hash != emoji_sequence_hash::of(U"\U0001F469\u200D\U0001F468"sv));
+}
+
+TEST_CASE("emoji_sequence.rgi", "[emoji_sequence]")
+{
+    // basic emoji
+    CHECK(is_rgi_emoji_sequence(U"\U0001F600"sv));
+    CHECK(is_rgi_emoji_sequence(U"\u00A9\uFE0F"sv));
+
+    // keycap sequence
+    CHECK(is_rgi_emoji_sequence(U"1\uFE0F\u20E3"sv));
+    CHECK(is_rgi_emoji_sequence(U"#\uFE0F\u20E3"sv));
+
+    // flag sequences: DE, US
+    CHECK(is_rgi_emoji_sequence(U"\U0001F1E9\U0001F1EA"sv));
+    CHECK(is_rgi_emoji_sequence(U"\U0001F1FA\U0001F1F8"sv));
+
+    // tag sequence: flag of England
+    CHECK(is_rgi_emoji_sequence(U"\U0001F3F4\U000E0067\U000E0062\U000E0065\U000E006E\U000E0067\U000E007F"sv));
+
+    // modifier sequence: thumbs up, medium skin tone
+    CHECK(is_rgi_emoji_sequence(U"\U0001F44D\U0001F3FD"sv));
+
+    // ZWJ sequences: family of man, woman, girl, boy, and rainbow flag
+    CHECK(is_rgi_emoji_sequence(U"\U0001F468\u200D\U0001F469\u200D\U0001F467\u200D\U0001F466"sv));
+    CHECK(is_rgi_emoji_sequence(U"\U0001F3F3\uFE0F\u200D\U0001F308"sv));
+}
+
+TEST_CASE("emoji_sequence.not_rgi", "[emoji_sequence]")
+{
+    CHECK_FALSE(is_rgi_emoji_sequence(U""sv));
+    CHECK_FALSE(is_rgi_emoji_sequence(U"a"sv));
+    CHECK_FALSE(is_rgi_emoji_sequence(U"1\u20E3"sv));
+
+    // Incomplete, reordered or extended sequences.
+    CHECK_FALSE(is_rgi_emoji_sequence(U"\U0001F468\u200D"sv));
+    CHECK_FALSE(is_rgi_emoji_sequence(U"\U0001F466\u200D\U0001F467\u200D\U0001F469\u200D\U0001F468"sv));
+    CHECK_FALSE(is_rgi_emoji_sequence(U"\U0001F44D\U0001F3FD\U0001F3FD"sv));
+
+    // flag sequence of AA, which is no region
+    CHECK_FALSE(is_rgi_emoji_sequence(U"\U0001F1E6\U0001F1E6"sv));
+
+    // two emoji joined with ZWJ, that are not displayed as one
+    CHECK_FALSE(is_rgi_emoji_sequence(U"\U0001F600\u200D\U0001F600"sv));
+    CHECK_FALSE(is_rgi_emoji_sequence(U"\u00A9"sv));
+}
+
+TEST_CASE("emoji_sequence.utf8_grapheme_segmenter", "[emoji_sequence]")
+{
+    // flag of DE, family of man, woman, girl, boy, x, thumbs up with skin tone,
+    // and two emoji joined with ZWJ.
+    auto const text = unicode::convert_to<char>(U"\U0001F1E9\U0001F1EA"
+                                                U"\U0001F468\u200D\U0001F469\u200D\U0001F467\u200D\U0001F466"
+                                                U"x\U0001F44D\U0001F3FD"
+                                                U"\U0001F600\u200D\U0001F600"sv);
+    auto rgi = std::vector<bool> {};
+    auto const segmenter = unicode::utf8_grapheme_segmenter(text);
+    for (auto i = segmenter.begin(); i != segmenter.end(); ++i)
+    {
+        CHECK(i.isRGIEmojiSequence() == is_rgi_emoji_sequence(*i));
+        rgi.push_back(i.isRGIEmojiSequence());
+    }
+    CHECK(rgi == std::vector<bool> { true, true, false, true, false });
+}
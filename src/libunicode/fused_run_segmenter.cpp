@@ -0,0 +1,126 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/fused_run_segmenter.h>
+
+#include <algorithm>
+
+namespace unicode
+{
+
+fused_run_segmenter::entry fused_run_segmenter::lookup(size_t position) const noexcept
+{
+    // script_properties share stage 1 and 2 with codepoint_properties, as well as the direct range.
+    auto const codepoint = _text[position] <= 0x10FFFF ? _text[position] : char32_t { 0 };
+    if (codepoint < codepoint_properties::tables_view::direct_size)
+        return { &_propertyTables.direct[codepoint], _scriptTables.direct[codepoint] };
+
+    auto const index = _propertyTables.unsafe_stage3_index(codepoint);
+    return { &_propertyTables.stage3[index], _scriptTables.stage3[index] };
+}
+
+fused_run_segmenter::entry fused_run_segmenter::at(size_t position) noexcept
+{
+    if (position < _filled)
+        return position + Capacity >= _filled ? _entries[position % Capacity] : lookup(position);
+
+    // Never overwrite what the state machines may still ask for.
+    auto const reach = low() + Capacity;
+    if (position >= reach)
+        return lookup(position);
+
+    // Batches of independent lookups, such that their latencies overlap.
+    auto const target = std::min({ std::max(position + 1, _filled + BatchSize), reach, _size });
+    for (; _filled < target; ++_filled)
+        _entries[_filled % Capacity] = lookup(_filled);
+    return _entries[position % Capacity];
+}
+
+EmojiSegmentationCategory fused_run_segmenter::category(size_t position) noexcept
+{
+    return at(position).properties->emoji_segmentation_category;
+}
+
+void fused_run_segmenter::scanEmojiToken()
+{
+    // Plain text is skipped for no further than the ring buffer reaches.
+    auto const limit = std::min(_size, std::max(low() + Capacity, _emojiPosition + 1));
+    auto isEmoji = false;
+    auto const end = detail::scan_emoji_token(_text, _size, _emojiPosition, limit, *this, &isEmoji);
+    auto const presentation = isEmoji ? PresentationStyle::Emoji : PresentationStyle::Text;
+
+    // An emoji segment ends where a token of the other presentation style starts.
+    if (!_emojiStarted)
+        _emojiStarted = true;
+    else if (presentation != _presentation)
+        _emojiSegments.push_back({ _emojiPosition, _presentation });
+    _presentation = presentation;
+    _emojiPosition = end;
+}
+
+void fused_run_segmenter::advanceScriptSegment()
+{
+    while (_scriptPosition < _size)
+    {
+        auto const position = _scriptPosition;
+
+        // Keeps the emoji state machine just ahead, such that both consume the same entries.
+        while (_emojiPosition <= position)
+            scanEmojiToken();
+
+        auto const properties = at(position).script;
+        ++_scriptPosition;
+        if (auto const script = _scripts.push(properties); script.has_value())
+        {
+            _scriptEnd = position;
+            _script = *script;
+            return;
+        }
+    }
+
+    _scriptEnd = _size;
+    _script = _scripts.currentScript();
+}
+
+bool fused_run_segmenter::consume(out<range> result)
+{
+    if (finished())
+        return false;
+
+    while (_scriptEnd <= _lastSplit)
+        advanceScriptSegment();
+    while (_emojiPosition < _scriptEnd)
+        scanEmojiToken();
+
+    while (_emojiHead < _emojiSegments.size() && _emojiSegments[_emojiHead].end <= _lastSplit)
+        ++_emojiHead;
+    if (_emojiHead == _emojiSegments.size())
+    {
+        _emojiSegments.clear();
+        _emojiHead = 0;
+    }
+
+    auto end = _scriptEnd;
+    auto presentation = _presentation;
+    if (_emojiHead < _emojiSegments.size())
+    {
+        end = std::min(end, _emojiSegments[_emojiHead].end);
+        presentation = _emojiSegments[_emojiHead].presentation;
+    }
+
+    *result = range { _lastSplit, end, { _script, presentation } };
+    _lastSplit = end;
+    return true;
+}
+
+} // namespace unicode
@@ -0,0 +1,109 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/emoji_segmenter.h>
+#include <libunicode/run_segmenter.h>
+#include <libunicode/script_segmenter.h>
+#include <libunicode/support.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace unicode
+{
+
+/// Segments text into the same runs as run_segmenter, but looking up the properties of each codepoint
+/// only once, rather than once for each of the segmenters.
+///
+/// The properties of each codepoint are looked up with a single walk of the shared stages of the
+/// codepoint properties tables into a small ring buffer, from which the script and the emoji
+/// state machines are advanced in lockstep (and further ones can be, such as for bidi or orientation).
+/// Positions the state machines ask for out of the ring buffer's reach are looked up directly.
+class fused_run_segmenter: private detail::emoji_category_source
+{
+  public:
+    using range = run_segmenter::range;
+
+    explicit fused_run_segmenter(std::u32string_view text) noexcept:
+        fused_run_segmenter(text.data(), text.size())
+    {
+    }
+
+    fused_run_segmenter(char32_t const* text, size_t size) noexcept: _text { text }, _size { size } {}
+
+    [[nodiscard]] bool finished() const noexcept { return _lastSplit >= _size; }
+
+    /// Splits input text into segments, such as pure text by script, emoji-emoji, or emoji-text.
+    ///
+    /// @retval true more data can be processed
+    /// @retval false end of input data has been reached.
+    bool consume(out<range> result);
+
+  private:
+    /// The properties of a codepoint, the state machines advance by.
+    struct entry
+    {
+        codepoint_properties const* properties;
+        script_properties script;
+    };
+
+    struct emoji_segment
+    {
+        size_t end;
+        PresentationStyle presentation;
+    };
+
+    static constexpr size_t Capacity = 256;  // NOLINT(readability-identifier-naming)
+    static constexpr size_t BatchSize = 32;  // NOLINT(readability-identifier-naming)
+
+    [[nodiscard]] entry lookup(size_t position) const noexcept;
+    [[nodiscard]] entry at(size_t position) noexcept;
+    EmojiSegmentationCategory category(size_t position) noexcept override;
+
+    /// The lowest position any of the state machines may still ask for.
+    [[nodiscard]] size_t low() const noexcept { return std::min(_scriptPosition, _emojiPosition); }
+
+    void advanceScriptSegment();
+    void scanEmojiToken();
+
+    char32_t const* _text;
+    size_t _size;
+    size_t _lastSplit = 0;
+
+    // The tables as configured when constructing the segmenter.
+    codepoint_properties::tables_view _propertyTables = codepoint_properties::configured_tables();
+    script_properties::tables_view _scriptTables = script_properties::configured_tables();
+
+    // Properties of the codepoints [_filled - Capacity, _filled), at their position modulo Capacity.
+    std::array<entry, Capacity> _entries {};
+    size_t _filled = 0;
+
+    script_segmenter _scripts {};
+    size_t _scriptPosition = 0; // next codepoint to push into _scripts
+    size_t _scriptEnd = 0;      // end of the current script segment
+    Script _script = Script::Common;
+
+    size_t _emojiPosition = 0; // end of the emoji tokens scanned so far
+    bool _emojiStarted = false;
+    PresentationStyle _presentation = PresentationStyle::Text; // of the emoji segment not ended yet
+    std::vector<emoji_segment> _emojiSegments;                 // ended emoji segments
+    size_t _emojiHead = 0;                                     // first one ending after _lastSplit
+};
+
+} // namespace unicode
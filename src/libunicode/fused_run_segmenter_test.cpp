@@ -0,0 +1,112 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/fused_run_segmenter.h>
+#include <libunicode/run_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace unicode;
+
+namespace
+{
+
+using range = run_segmenter::range;
+
+std::vector<range> segment(std::u32string_view text)
+{
+    auto ranges = std::vector<range> {};
+    auto segmenter = run_segmenter { text };
+    auto current = range {};
+    while (segmenter.consume(out(current)))
+        ranges.push_back(current);
+    return ranges;
+}
+
+std::vector<range> segment_fused(std::u32string_view text)
+{
+    auto ranges = std::vector<range> {};
+    auto segmenter = fused_run_segmenter { text };
+    auto current = range {};
+    while (segmenter.consume(out(current)))
+        ranges.push_back(current);
+    CHECK(segmenter.finished());
+    return ranges;
+}
+
+} // namespace
+
+TEST_CASE("fused_run_segmenter.empty")
+{
+    CHECK(segment_fused(U"").empty());
+}
+
+TEST_CASE("fused_run_segmenter.same_as_run_segmenter")
+{
+    auto const texts = std::vector<std::u32string_view> {
+        U"Hello, World",
+        U"A \U0001F600",
+        U"AB\U0001F600CD",
+        U"\U0001F600\uFE0E",
+        U"\u2764\uFE0F\u2764\uFE0E\u2764",
+        U"\u0646\u0635\uD0A4\uC2A4\uC758",
+        U"\u767E\u5BB6\u59D3\u090B\u0937\u093F\u092F\u094B\u0902\U0001F331\U0001F332\u767E\u5BB6",
+        U"\u25CC\u0301\u25CC\u0300\u25CC\u0308",
+        U"\u3044\u308D\u306F.\u2026\u00A1\u307B\u3078",
+        U"\U0001F469\u200D\U0001F469\u200D\U0001F467\u200D\U0001F466abcd\U0001F469\u200D\u200Defg",
+        U"\u26F9\U0001F3FB\u270D\U0001F3FB\u270A\U0001F3FC",
+        U"\u0561\u0562\u0563\u03B1\u03B2\u03B3\u0531\u0532\u0533",
+        U"\U0001F3F4\U000E0067\U000E0062\U000E0077\U000E006C\U000E0073\U000E007F\U0001F1E9\U0001F1EA"
+        U"1\uFE0F\u20E3x",
+        U"\U0001F1E9\U0001F1EA\U0001F1E9",
+        U"1\uFE0F\u20E3#\u20E31",
+    };
+
+    for (auto const text: texts)
+    {
+        INFO("text of " << text.size() << " codepoints");
+        CHECK(segment_fused(text) == segment(text));
+    }
+}
+
+TEST_CASE("fused_run_segmenter.long_text")
+{
+    // Longer than the ring buffer of looked up properties, with runs across its wrap-around.
+    auto const pool = std::u32string_view(U"a \u0301\u200D\uFE0F\uFE0E\u20E3\u0627\u05D0\u4E00\u3042\u0E01"
+                                          U"\u2764\u00A9\U0001F600\U0001F3FB\U0001F1E9\U000E0067\U000E007F"
+                                          U"1.#");
+    auto generator = std::mt19937 { 4711 };
+    auto pick = std::uniform_int_distribution<size_t> { 0, pool.size() - 1 };
+    auto runLength = std::uniform_int_distribution<size_t> { 1, 300 };
+
+    for (int i = 0; i < 50; ++i)
+    {
+        auto text = std::u32string {};
+        while (text.size() < 2000)
+            text.append(runLength(generator), pool[pick(generator)]);
+        for (size_t k = 0; k < 500; ++k)
+            text[pick(generator) * text.size() / pool.size()] = pool[pick(generator)];
+        INFO("iteration " << i);
+        CHECK(segment_fused(text) == segment(text));
+    }
+
+    auto mixed = std::u32string {};
+    while (mixed.size() < 5000)
+        mixed.push_back(pool[pick(generator)]);
+    CHECK(segment_fused(mixed) == segment(mixed));
+}
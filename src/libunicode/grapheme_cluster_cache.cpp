@@ -0,0 +1,133 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/grapheme_cluster_cache.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace unicode
+{
+
+namespace
+{
+    /// Returns the length of the UTF-8 sequence starting with the lead byte @p lead.
+    constexpr size_t sequence_length(char lead) noexcept
+    {
+        auto const byte = static_cast<uint8_t>(lead);
+        if (byte >= 0xF0)
+            return 4;
+        if (byte >= 0xE0)
+            return 3;
+        if (byte >= 0xC0)
+            return 2;
+        return 1;
+    }
+
+    /// Returns the number of bytes of the first two UTF-8 sequences of the non-empty @p text.
+    constexpr size_t key_size(std::string_view text) noexcept
+    {
+        auto const first = std::min(sequence_length(text[0]), text.size());
+        return first < text.size() ? std::min(first + sequence_length(text[first]), text.size()) : first;
+    }
+} // namespace
+
+grapheme_cluster_cache::grapheme_cluster_cache(size_t capacity):
+    _entries(std::bit_ceil(std::max(capacity, Ways))),
+    _next(_entries.size() / Ways),
+    _setMask { _entries.size() / Ways - 1 }
+{
+}
+
+uint64_t grapheme_cluster_cache::key_of(std::string_view text) noexcept
+{
+    // Every grapheme cluster of more than one codepoint starts with the same two UTF-8 sequences
+    // as any of its cached prefixes, so these are the key to the set it is stored in.
+    auto const length = key_size(text);
+
+    uint64_t key = 0;
+    if (text.size() >= sizeof(key))
+    {
+        std::memcpy(&key, text.data(), sizeof(key));
+        if (length < sizeof(key))
+            key &= (uint64_t { 1 } << (8 * length)) - 1; // NB: Bytes are in memory order on little endian.
+    }
+    else
+        std::memcpy(&key, text.data(), length);
+    return key;
+}
+
+size_t grapheme_cluster_cache::set_of(uint64_t key) const noexcept
+{
+    return static_cast<size_t>((key * 0x9E37'79B9'7F4A'7C15ull) >> 40) & _setMask;
+}
+
+grapheme_cluster_cache::entry const* grapheme_cluster_cache::find(std::string_view text) noexcept
+{
+    entry const* found = nullptr;
+    if (!text.empty())
+    {
+        auto const key = key_of(text);
+        auto const* const set = _entries.data() + set_of(key) * Ways;
+        for (size_t way = 0; way < Ways; ++way)
+        {
+            // The key is compared first, as most grapheme clusters are at most the two UTF-8 sequences
+            // it consists of, followed by the remaining bytes, if any.
+            auto const& candidate = set[way];
+            if (candidate.key == key && candidate.size && candidate.size <= text.size()
+                && (!found || candidate.size > found->size)
+                && std::memcmp(candidate.bytes.data() + candidate.keySize,
+                               text.data() + candidate.keySize,
+                               candidate.size - candidate.keySize)
+                       == 0)
+                found = &candidate;
+        }
+    }
+
+    if (found)
+        ++_stats.hits;
+    else
+        ++_stats.misses;
+    return found;
+}
+
+void grapheme_cluster_cache::insert(std::string_view cluster,
+                                    size_t width,
+                                    grapheme_segmenter_state const& state) noexcept
+{
+    if (cluster.empty() || cluster.size() > MaxClusterSize)
+        return;
+
+    auto const key = key_of(cluster);
+    auto const setIndex = set_of(key);
+    auto& way = _next[setIndex];
+    auto& slot = _entries[setIndex * Ways + way];
+    way = static_cast<uint8_t>((way + 1) % Ways);
+
+    slot.key = key;
+    slot.keySize = static_cast<uint8_t>(key_size(cluster));
+    slot.state = state;
+    slot.size = static_cast<uint8_t>(cluster.size());
+    slot.width = static_cast<uint8_t>(width);
+    std::copy(cluster.begin(), cluster.end(), slot.bytes.begin());
+}
+
+void grapheme_cluster_cache::clear() noexcept
+{
+    std::fill(_entries.begin(), _entries.end(), entry {});
+    std::fill(_next.begin(), _next.end(), uint8_t { 0 });
+    _stats = {};
+}
+
+} // namespace unicode
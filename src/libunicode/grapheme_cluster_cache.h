@@ -0,0 +1,108 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/grapheme_segmenter.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace unicode
+{
+
+/// Bounded cache of recently segmented grapheme clusters of more than one codepoint,
+/// such as emoji ZWJ sequences, emoji flags or Indic conjuncts, keyed by their UTF-8 bytes.
+///
+/// Each entry holds the width of the grapheme cluster and the grapheme segmentation state
+/// after it, such that a repeated grapheme cluster is skipped in one go rather than
+/// segmented codepoint by codepoint.
+///
+/// The cache is set associative and its capacity never grows. It is not synchronized,
+/// i.e. each thread must use a cache of its own, e.g. a @c thread_local one.
+class grapheme_cluster_cache
+{
+  public:
+    /// Maximum number of bytes of a cached grapheme cluster, such that an entry fits into a cache line.
+    static constexpr size_t MaxClusterSize = 44;
+
+    /// Number of entries a grapheme cluster can be stored in.
+    static constexpr size_t Ways = 4;
+
+    struct entry
+    {
+        /// The first two UTF-8 sequences of the grapheme cluster, zero padded.
+        uint64_t key = 0;
+
+        /// Grapheme segmentation state after the last codepoint of the grapheme cluster.
+        grapheme_segmenter_state state {};
+
+        /// Number of bytes of the grapheme cluster, or 0 if the entry is unused.
+        uint8_t size = 0;
+
+        /// Number of columns the grapheme cluster occupies.
+        uint8_t width = 0;
+
+        /// Number of bytes of the key.
+        uint8_t keySize = 0;
+
+        std::array<char, MaxClusterSize> bytes {};
+
+        [[nodiscard]] std::string_view text() const noexcept { return { bytes.data(), size }; }
+    };
+    static_assert(sizeof(entry) == 64);
+
+    struct statistics
+    {
+        /// Number of lookups that found a cached grapheme cluster.
+        uint64_t hits = 0;
+
+        /// Number of lookups that did not.
+        uint64_t misses = 0;
+    };
+
+    /// Constructs a cache of at least @p capacity entries, rounded up to a power of two.
+    explicit grapheme_cluster_cache(size_t capacity = 256);
+
+    /// Returns the longest cached grapheme cluster @p text starts with, if any.
+    ///
+    /// The grapheme cluster found is a prefix of the grapheme cluster at the start of @p text,
+    /// if @p text starts a grapheme cluster, i.e. with a grapheme cluster break before it.
+    [[nodiscard]] entry const* find(std::string_view text) noexcept;
+
+    /// Stores the grapheme cluster @p cluster, along with its width and the grapheme segmentation
+    /// state after it, replacing the oldest entry for it.
+    ///
+    /// Grapheme clusters longer than MaxClusterSize are not stored.
+    void insert(std::string_view cluster, size_t width, grapheme_segmenter_state const& state) noexcept;
+
+    /// Removes all entries and resets the statistics.
+    void clear() noexcept;
+
+    [[nodiscard]] size_t capacity() const noexcept { return _entries.size(); }
+    [[nodiscard]] statistics const& stats() const noexcept { return _stats; }
+
+  private:
+    [[nodiscard]] static uint64_t key_of(std::string_view text) noexcept;
+    [[nodiscard]] size_t set_of(uint64_t key) const noexcept;
+
+    std::vector<entry> _entries;
+    std::vector<uint8_t> _next; // The way to replace next, for each set.
+    size_t _setMask;
+    statistics _stats {};
+};
+
+} // namespace unicode
@@ -0,0 +1,185 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/grapheme_cluster_cache.h>
+#include <libunicode/scan.h>
+#include <libunicode/utf8_grapheme_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace unicode;
+using namespace std::string_literals;
+using namespace std;
+
+namespace
+{
+
+// Grapheme clusters of more than one codepoint, including prefixes of one another,
+// mixed with single codepoint grapheme clusters, US-ASCII and ill-formed UTF-8.
+auto const Text = "\U0001F468\u200D\U0001F469\u200D\U0001F467 hi \U0001F1E9\U0001F1EA\u2764\uFE0F"
+                  "\U0001F468\u200D\U0001F469\u4E00e\u0301\u0301\U0001F468\u200D\U0001F469\u200D\U0001F467"
+                  "\u0915\u094D\u0937\xFF\u0301\U0001F1E9\U0001F1EA\U0001F1E9\u2764\uFE0F\u261D\U0001F3FB"s;
+
+// Scans all of the text, in chunks of @p chunkSize bytes, into (offset, width) pairs.
+auto scan_clusters(string_view text, grapheme_cluster_cache* cache, size_t chunkSize)
+{
+    auto result = vector<pair<size_t, unsigned>> {};
+    auto offsets = array<size_t, 16> {};
+    auto widths = array<uint8_t, 16> {};
+    auto invalid = array<bool, 16> {};
+    auto state = scan_state {};
+    state.cache = cache;
+    for (size_t chunk = 0; chunk < text.size(); chunk += chunkSize)
+    {
+        auto input = text.substr(chunk, chunkSize);
+        while (!input.empty())
+        {
+            auto buffer =
+                grapheme_cluster_buffer { offsets.data(), widths.data(), invalid.data(), offsets.size() };
+            auto const scanned = scan_text(state, input, 1000, buffer);
+            auto const base = static_cast<size_t>(scanned.start - text.data());
+            for (size_t i = 0; i < buffer.size; ++i)
+                result.emplace_back(base + offsets[i], widths[i]);
+            input.remove_prefix(static_cast<size_t>(state.next - input.data()));
+        }
+    }
+    return result;
+}
+
+auto segment_clusters(string_view text, grapheme_cluster_cache* cache)
+{
+    auto result = vector<pair<string_view, size_t>> {};
+    auto const segmenter =
+        cache ? utf8_grapheme_cluster_segmenter(text, cache) : utf8_grapheme_cluster_segmenter(text);
+    for (auto const& cluster: segmenter)
+        result.emplace_back(cluster.text, cluster.width);
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("grapheme_cluster_cache.find", "[grapheme_cluster_cache]")
+{
+    auto cache = grapheme_cluster_cache { 5 };
+    CHECK(cache.capacity() == 8);
+
+    auto const family = "\U0001F468\u200D\U0001F469\u200D\U0001F467"sv;
+    auto const couple = family.substr(0, 11);
+    CHECK(cache.find(family) == nullptr);
+
+    auto state = grapheme_segmenter_state {};
+    state.pictographic_sequence = 1;
+    cache.insert(couple, 2, state);
+    auto const* found = cache.find(family);
+    REQUIRE(found != nullptr);
+    CHECK(found->text() == couple);
+    CHECK(found->width == 2);
+    CHECK(found->state == state);
+
+    // The longest cached grapheme cluster is found.
+    cache.insert(family, 2, state);
+    found = cache.find("\U0001F468\u200D\U0001F469\u200D\U0001F467\u200D\U0001F466"sv);
+    REQUIRE(found != nullptr);
+    CHECK(found->text() == family);
+    CHECK(cache.find(couple)->text() == couple);
+
+    // Only grapheme clusters the text starts with are found.
+    CHECK(cache.find(family.substr(4)) == nullptr);
+    CHECK(cache.find(couple.substr(0, 10)) == nullptr);
+
+    CHECK(cache.stats().hits == 3);
+    CHECK(cache.stats().misses == 3);
+
+    // Grapheme clusters that do not fit into an entry are not stored.
+    auto const tooLong = string(grapheme_cluster_cache::MaxClusterSize + 1, '\x80');
+    cache.insert(tooLong, 1, state);
+    CHECK(cache.find(tooLong) == nullptr);
+
+    cache.clear();
+    CHECK(cache.find(family) == nullptr);
+    CHECK(cache.stats().hits == 0);
+    CHECK(cache.stats().misses == 1);
+}
+
+TEST_CASE("grapheme_cluster_cache.eviction", "[grapheme_cluster_cache]")
+{
+    // With a single set, the oldest of more grapheme clusters than ways is replaced.
+    auto cache = grapheme_cluster_cache { 1 };
+    auto clusters = vector<string> {};
+    for (char32_t mark = 0x0300; mark < 0x0300 + grapheme_cluster_cache::Ways + 1; ++mark)
+        clusters.emplace_back(convert_to<char>(u32string_view(u32string { U'e', mark })));
+
+    for (auto const& cluster: clusters)
+        cache.insert(cluster, 1, {});
+
+    CHECK(cache.find(clusters.front()) == nullptr);
+    for (size_t i = 1; i < clusters.size(); ++i)
+        CHECK(cache.find(clusters[i]) != nullptr);
+}
+
+TEST_CASE("grapheme_cluster_cache.scan_text", "[grapheme_cluster_cache]")
+{
+    auto const twice = Text + Text;
+
+    // Scanning with a cache yields the same grapheme clusters, also if they are split across calls.
+    for (auto const capacity: { 4, 256 })
+    {
+        for (auto const chunkSize: { Text.size(), size_t { 1 }, size_t { 3 }, size_t { 7 } })
+        {
+            INFO("capacity " << capacity << ", chunk size " << chunkSize);
+            auto cache = grapheme_cluster_cache { static_cast<size_t>(capacity) };
+            CHECK(scan_clusters(Text, &cache, chunkSize) == scan_clusters(Text, nullptr, chunkSize));
+            for (int repeat = 0; repeat < 2; ++repeat)
+                CHECK(scan_clusters(twice, &cache, chunkSize) == scan_clusters(twice, nullptr, chunkSize));
+        }
+    }
+
+    auto cache = grapheme_cluster_cache {};
+    (void) scan_clusters(Text, &cache, Text.size());
+    auto const misses = cache.stats().misses;
+    CHECK(cache.stats().hits > 0);
+    (void) scan_clusters(Text, &cache, Text.size());
+    CHECK(cache.stats().misses == misses);
+}
+
+TEST_CASE("grapheme_cluster_cache.scan_text.column_limit", "[grapheme_cluster_cache]")
+{
+    // A narrow first codepoint followed by VS16 of a cached grapheme cluster does not fit into one column.
+    auto cache = grapheme_cluster_cache {};
+    auto state = scan_state {};
+    state.cache = &cache;
+    auto const heart = "\u2764\uFE0F"sv;
+    CHECK(scan_text(state, heart, 80).count == 2);
+    state = {};
+    state.cache = &cache;
+    auto const result = scan_text(state, heart, 1);
+    CHECK(cache.stats().hits == 1);
+    CHECK(result.count == 0);
+    CHECK(state.next == heart.data());
+}
+
+TEST_CASE("grapheme_cluster_cache.utf8_grapheme_cluster_segmenter", "[grapheme_cluster_cache]")
+{
+    auto const text = Text + Text;
+    auto const expected = segment_clusters(text, nullptr);
+    auto cache = grapheme_cluster_cache { 4 };
+    CHECK(segment_clusters(text, &cache) == expected);
+    CHECK(segment_clusters(text, &cache) == expected);
+    CHECK(cache.stats().hits > 0);
+}
@@ -0,0 +1,253 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/case_mapping.h>
+#include <libunicode/convert.h>
+#include <libunicode/grapheme_search.h>
+#include <libunicode/grapheme_segmenter.h>
+#include <libunicode/intrinsics.h>
+#include <libunicode/ucd.h>
+
+#include <bit>
+#include <cstring>
+
+namespace unicode
+{
+
+namespace
+{
+    constexpr char32_t ReplacementCharacter = 0xFFFD; // NOLINT(readability-identifier-naming)
+
+    bool is_continuation(char byte) noexcept
+    {
+        return (static_cast<uint8_t>(byte) & 0xC0) == 0x80;
+    }
+
+    char ascii_folded(char byte) noexcept
+    {
+        return 'A' <= byte && byte <= 'Z' ? static_cast<char>(byte + 0x20) : byte;
+    }
+
+    struct decoded_codepoint
+    {
+        char32_t value;
+        size_t length;
+        bool valid;
+    };
+
+    decoded_codepoint decode_at(std::string_view text, size_t offset) noexcept
+    {
+        auto const sequence = decode_utf8_sequence(text.substr(offset));
+        auto const valid = sequence.status == ConversionStatus::Success;
+        return { valid ? sequence.value : ReplacementCharacter, sequence.length, valid };
+    }
+
+    /// Tests whether the grapheme segmentation state behind a codepoint does not depend on
+    /// the codepoints preceding it, i.e. whether segmentation can be (re)started at it.
+    bool is_restartable(narrow_codepoint_properties::tables_view const& tables, char32_t codepoint) noexcept
+    {
+        auto const gcb = tables.get(codepoint).grapheme_cluster_break();
+        return gcb != Grapheme_Cluster_Break::Extend && gcb != Grapheme_Cluster_Break::ZWJ
+               && gcb != Grapheme_Cluster_Break::Regional_Indicator;
+    }
+
+    bool is_grapheme_match(std::string_view haystack, size_t offset, size_t length) noexcept
+    {
+        return is_grapheme_boundary(haystack, offset) && is_grapheme_boundary(haystack, offset + length);
+    }
+} // namespace
+
+bool is_grapheme_boundary(std::string_view text, size_t offset) noexcept
+{
+    if (offset == 0 || offset >= text.size())
+        return offset == 0 || offset == text.size();
+
+    // UTF-8 decoding synchronizes at any byte but a continuation byte, so step back from one
+    // of those to the next, until reaching a codepoint to restart segmentation at.
+    auto const tables = narrow_codepoint_properties::configured_tables();
+    auto restart = offset;
+    auto current = decoded_codepoint {};
+    do
+    {
+        --restart;
+        while (restart > 0 && is_continuation(text[restart]))
+            --restart;
+        current = decode_at(text, restart);
+    } while (restart > 0 && !is_restartable(tables, current.value));
+
+    auto state = grapheme_segmenter_state {};
+    grapheme_process_init(current.value, state);
+    auto position = restart + current.length;
+    while (position < offset)
+    {
+        current = decode_at(text, position);
+        (void) grapheme_process_breakable(current.value, state);
+        position += current.length;
+    }
+    if (position != offset)
+        return false;
+
+    return grapheme_process_breakable(decode_at(text, offset).value, state);
+}
+
+grapheme_searcher::grapheme_searcher(std::string_view needle, case_sensitivity sensitivity):
+    _sensitivity { sensitivity }
+{
+    if (sensitivity == case_sensitivity::Sensitive)
+    {
+        _needle = needle;
+        return;
+    }
+
+    auto decoded = std::u32string(max_utf32_length_from_utf8(needle.size()), U'\0');
+    decoded.resize(convert_utf8_to_utf32(needle, decoded, ConversionErrorPolicy::Replace).written);
+    _foldedNeedle = case_fold(decoded);
+}
+
+std::optional<size_t> grapheme_searcher::match_folded(std::string_view haystack, size_t offset) const noexcept
+{
+    if (is_continuation(haystack[offset]))
+        return std::nullopt;
+
+    auto position = offset;
+    for (size_t i = 0; i < _foldedNeedle.size();)
+    {
+        if (position == haystack.size())
+            return std::nullopt;
+
+        if (static_cast<uint8_t>(haystack[position]) < 0x80)
+        {
+            if (static_cast<char32_t>(ascii_folded(haystack[position])) != _foldedNeedle[i])
+                return std::nullopt;
+            ++i;
+            ++position;
+            continue;
+        }
+
+        auto const current = decode_at(haystack, position);
+        if (!current.valid)
+            return std::nullopt;
+        auto const simple = simple_case_folding(current.value);
+        auto folded = full_case_folding(current.value);
+        if (folded.empty())
+            folded = std::u32string_view(&simple, 1);
+        if (_foldedNeedle.size() - i < folded.size() || _foldedNeedle.compare(i, folded.size(), folded) != 0)
+            return std::nullopt;
+        i += folded.size();
+        position += current.length;
+    }
+    return position - offset;
+}
+
+std::optional<text_match> grapheme_searcher::find(std::string_view haystack, size_t start) const noexcept
+{
+    if (start > haystack.size())
+        return std::nullopt;
+
+    if (_needle.empty() && _foldedNeedle.empty())
+    {
+        for (auto i = start; i <= haystack.size(); ++i)
+            if (is_grapheme_boundary(haystack, i))
+                return text_match { i, 0 };
+        return std::nullopt;
+    }
+
+    auto i = start;
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+    auto constexpr BlockSize = sizeof(intrinsics::m128i);
+#endif
+
+    if (_sensitivity == case_sensitivity::Sensitive)
+    {
+        auto const size = _needle.size();
+        auto const first = _needle.front();
+        auto const last = _needle.back();
+        auto const matches_at = [&](size_t offset) {
+            return std::memcmp(haystack.data() + offset + 1, _needle.data() + 1, size - 1) == 0
+                   && is_grapheme_match(haystack, offset, size);
+        };
+
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+        // Compares a block of candidate positions at once against the needle's first and last byte.
+        auto const firsts = intrinsics::set1_epi8(first);
+        auto const lasts = intrinsics::set1_epi8(last);
+        for (; i + size - 1 + BlockSize <= haystack.size(); i += BlockSize)
+        {
+            auto const* const block = haystack.data() + i;
+            auto const firstBytes = intrinsics::load_unaligned((intrinsics::m128i const*) block);
+            auto const lastBytes = intrinsics::load_unaligned((intrinsics::m128i const*) (block + size - 1));
+            auto const matches = intrinsics::and128(intrinsics::compare_equal_epi8(firstBytes, firsts),
+                                                    intrinsics::compare_equal_epi8(lastBytes, lasts));
+            for (auto candidates = static_cast<uint32_t>(intrinsics::movemask_epi8(matches)); candidates != 0;
+                 candidates &= candidates - 1)
+            {
+                auto const offset = i + static_cast<size_t>(std::countr_zero(candidates));
+                if (matches_at(offset))
+                    return text_match { offset, size };
+            }
+        }
+#endif
+
+        for (; i + size <= haystack.size(); ++i)
+            if (haystack[i] == first && haystack[i + size - 1] == last && matches_at(i))
+                return text_match { i, size };
+        return std::nullopt;
+    }
+
+    // Candidates are the bytes that are (or may be the start of a codepoint that is) case folded
+    // to the needle's first codepoint, that is, US-ASCII letters of either case and any non-US-ASCII byte.
+    auto const firstFolded = _foldedNeedle.front();
+    auto const firstIsAscii = firstFolded < 0x80;
+    auto const matches_at = [&](size_t offset) -> std::optional<text_match> {
+        if (auto const length = match_folded(haystack, offset);
+            length.has_value() && is_grapheme_match(haystack, offset, *length))
+            return text_match { offset, *length };
+        return std::nullopt;
+    };
+
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+    auto const lower = static_cast<char>(firstIsAscii ? firstFolded : 0x80);
+    auto const upper = 'a' <= lower && lower <= 'z' ? static_cast<char>(lower - 0x20) : lower;
+    auto const lowers = intrinsics::set1_epi8(lower);
+    auto const uppers = intrinsics::set1_epi8(upper);
+    for (; i + BlockSize <= haystack.size(); i += BlockSize)
+    {
+        auto const bytes = intrinsics::load_unaligned((intrinsics::m128i const*) (haystack.data() + i));
+        auto candidates = static_cast<uint32_t>(intrinsics::movemask_epi8(
+            intrinsics::or128(bytes,
+                              intrinsics::or128(intrinsics::compare_equal_epi8(bytes, lowers),
+                                                intrinsics::compare_equal_epi8(bytes, uppers)))));
+        for (; candidates != 0; candidates &= candidates - 1)
+            if (auto const match = matches_at(i + static_cast<size_t>(std::countr_zero(candidates))))
+                return match;
+    }
+#endif
+
+    for (; i < haystack.size(); ++i)
+    {
+        auto const byte = haystack[i];
+        if (static_cast<uint8_t>(byte) >= 0x80 || static_cast<uint8_t>(ascii_folded(byte)) == firstFolded)
+            if (auto const match = matches_at(i))
+                return match;
+    }
+    return std::nullopt;
+}
+
+std::optional<text_match> find_graphemes(std::string_view haystack,
+                                         std::string_view needle,
+                                         case_sensitivity sensitivity)
+{
+    return grapheme_searcher { needle, sensitivity }.find(haystack);
+}
+
+} // namespace unicode
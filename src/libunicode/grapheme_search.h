@@ -0,0 +1,88 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace unicode
+{
+
+/// Tests whether a grapheme cluster boundary is at the byte @p offset of the UTF-8 @p text,
+/// with ill-formed UTF-8 sequences being decoded as U+FFFD, like utf8_grapheme_segmenter does.
+///
+/// Rather than segmenting @p text from its start, this only segments the codepoints in front
+/// of @p offset back to the last one that the segmentation state does not depend on the
+/// preceding codepoints of (i.e. one that is neither an Extend, ZWJ nor Regional_Indicator).
+///
+/// @returns false if @p offset is within a codepoint.
+[[nodiscard]] bool is_grapheme_boundary(std::string_view text, size_t offset) noexcept;
+
+enum class case_sensitivity : uint8_t
+{
+    Sensitive,
+    /// Matches text that is equal after full case folding (see case_fold()).
+    Insensitive,
+};
+
+/// A match found by grapheme_searcher, in bytes of the searched text.
+struct text_match
+{
+    size_t offset;
+    size_t length;
+
+    constexpr bool operator==(text_match const&) const noexcept = default;
+};
+
+/// Finds a needle in UTF-8 text, only matching whole grapheme clusters.
+///
+/// Candidate positions are found by comparing 16 bytes at a time, where SIMD is available, against the
+/// needle's first and last byte (or its case folded first byte, when searching case insensitively).
+/// Grapheme cluster boundaries are then verified at the edges of each match only,
+/// see is_grapheme_boundary().
+class grapheme_searcher
+{
+  public:
+    /// Prepares searching for the UTF-8 @p needle.
+    ///
+    /// When searching case insensitively, ill-formed UTF-8 sequences of @p needle are replaced by U+FFFD
+    /// and ill-formed UTF-8 sequences of the searched text never match.
+    explicit grapheme_searcher(std::string_view needle,
+                               case_sensitivity sensitivity = case_sensitivity::Sensitive);
+
+    [[nodiscard]] case_sensitivity sensitivity() const noexcept { return _sensitivity; }
+
+    /// Finds the first match in @p haystack starting at or behind the byte @p start.
+    ///
+    /// An empty needle matches at the first grapheme cluster boundary.
+    [[nodiscard]] std::optional<text_match> find(std::string_view haystack, size_t start = 0) const noexcept;
+
+  private:
+    [[nodiscard]] std::optional<size_t> match_folded(std::string_view haystack, size_t offset) const noexcept;
+
+    case_sensitivity _sensitivity;
+    std::string _needle;
+    std::u32string _foldedNeedle;
+};
+
+/// Finds the first match of @p needle in @p haystack, see grapheme_searcher.
+[[nodiscard]] std::optional<text_match> find_graphemes(
+    std::string_view haystack,
+    std::string_view needle,
+    case_sensitivity sensitivity = case_sensitivity::Sensitive);
+
+} // namespace unicode
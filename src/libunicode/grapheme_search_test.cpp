@@ -0,0 +1,153 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/grapheme_search.h>
+#include <libunicode/grapheme_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::string_view_literals;
+using unicode::case_sensitivity;
+using unicode::find_graphemes;
+using unicode::grapheme_searcher;
+using unicode::text_match;
+
+namespace
+{
+
+// Returns whether a grapheme cluster starts at each byte offset of @p text, by segmenting all of it.
+std::vector<bool> grapheme_boundaries(std::string_view text)
+{
+    auto boundaries = std::vector<bool>(text.size() + 1, false);
+    auto const codepoints = unicode::convert_to<char32_t>(text);
+    auto state = unicode::grapheme_segmenter_state {};
+    size_t offset = 0;
+    size_t i = 0;
+    state.feed(codepoints, [&](size_t next) {
+        for (; i < next; ++i)
+            offset += unicode::convert_to<char>(codepoints[i]).size();
+        boundaries[offset] = true;
+    });
+    boundaries[text.size()] = true;
+    return boundaries;
+}
+
+} // namespace
+
+TEST_CASE("grapheme_search.is_grapheme_boundary", "[grapheme_search]")
+{
+    auto const text = "e\u0301x\r\n\U0001F1E9\U0001F1EA\U0001F1EB\U0001F1F7\U0001F468\u200D\U0001F469!"sv;
+    auto const expected = grapheme_boundaries(text);
+    for (size_t offset = 0; offset <= text.size(); ++offset)
+    {
+        INFO(offset);
+        CHECK(unicode::is_grapheme_boundary(text, offset) == expected[offset]);
+    }
+    CHECK(unicode::is_grapheme_boundary(text, 0));
+    CHECK(!unicode::is_grapheme_boundary(text, 1));  // in front of U+0301
+    CHECK(!unicode::is_grapheme_boundary(text, 2));  // within U+0301
+    CHECK(!unicode::is_grapheme_boundary(text, 5));  // within CR LF
+    CHECK(!unicode::is_grapheme_boundary(text, 10)); // within the first regional indicator pair
+    CHECK(unicode::is_grapheme_boundary(text, 14));
+    CHECK(!unicode::is_grapheme_boundary(text, text.size() + 1));
+
+    // Ill-formed UTF-8 sequences are grapheme clusters of their own.
+    CHECK(unicode::is_grapheme_boundary("a\xFF\xCC\x81"sv, 1));
+    CHECK(!unicode::is_grapheme_boundary("a\xFF\xCC\x81"sv, 2));
+    CHECK(unicode::is_grapheme_boundary("\x80\x80\x80\x80"sv, 3));
+}
+
+TEST_CASE("grapheme_search.case_sensitive", "[grapheme_search]")
+{
+    CHECK(find_graphemes("Hello, World!"sv, "World"sv) == text_match { 7, 5 });
+    CHECK(find_graphemes("Hello, World!"sv, "world"sv) == std::nullopt);
+    CHECK(find_graphemes("Hello"sv, "Hello, World!"sv) == std::nullopt);
+    CHECK(find_graphemes("Hello"sv, ""sv) == text_match { 0, 0 });
+
+    // Matching within a grapheme cluster is not a match.
+    CHECK(find_graphemes("cafe\u0301 au lait, cafe"sv, "cafe"sv) == text_match { 16, 4 });
+    CHECK(find_graphemes("\U0001F1E6\U0001F1E9\U0001F1EA\U0001F1EB"sv, "\U0001F1E9\U0001F1EA"sv)
+          == std::nullopt);
+    CHECK(find_graphemes("\U0001F1E6\U0001F1E9\U0001F1EA\U0001F1EB"sv, "\U0001F1EA\U0001F1EB"sv)
+          == text_match { 8, 8 });
+    CHECK(find_graphemes("\U0001F468\u200D\U0001F469"sv, "\U0001F469"sv) == std::nullopt);
+
+    // Long enough for the SIMD prefilter, with candidates straddling blocks.
+    auto const haystack = "The quick brown fox jumps over the lazy dog. The quick brown fox jumps!"sv;
+    auto const searcher = grapheme_searcher { "jumps"sv };
+    CHECK(searcher.find(haystack) == text_match { 20, 5 });
+    CHECK(searcher.find(haystack, 21) == text_match { 65, 5 });
+    CHECK(searcher.find(haystack, 66) == std::nullopt);
+    CHECK(searcher.find(haystack, haystack.size() + 1) == std::nullopt);
+}
+
+TEST_CASE("grapheme_search.case_insensitive", "[grapheme_search]")
+{
+    auto constexpr Insensitive = case_sensitivity::Insensitive;
+    CHECK(find_graphemes("Hello, World!"sv, "wORLD"sv, Insensitive) == text_match { 7, 5 });
+    CHECK(find_graphemes("Die Stra\u00DFe ist lang"sv, "STRASSE"sv, Insensitive) == text_match { 4, 7 });
+    CHECK(find_graphemes("MASSE"sv, "ma\u00DF"sv, Insensitive) == text_match { 0, 4 });
+    CHECK(find_graphemes("one \u212Aelvin"sv, "kelvin"sv, Insensitive) == text_match { 4, 8 });
+    CHECK(find_graphemes("\u039F\u0394\u039F\u03A3"sv, "\u03BF\u03B4\u03BF\u03C2"sv, Insensitive)
+          == text_match { 0, 8 });
+
+    // Matches must cover whole codepoints (and grapheme clusters) of the text.
+    CHECK(find_graphemes("Stra\u00DFe"sv, "s"sv, Insensitive) == text_match { 0, 1 });
+    CHECK(find_graphemes("Stra\u00DFe"sv, "as"sv, Insensitive) == std::nullopt);
+    CHECK(find_graphemes("E\u0301 e"sv, "e"sv, Insensitive) == text_match { 4, 1 });
+    CHECK(find_graphemes("\xFF"
+                         "a"sv,
+                         "\xFF"
+                         "a"sv,
+                         Insensitive)
+          == std::nullopt);
+
+    auto const haystack = "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG. \u00C9T\u00C9 \u00C9T\u00C9"sv;
+    auto const searcher = grapheme_searcher { "\u00E9t\u00E9"sv, Insensitive };
+    CHECK(searcher.find(haystack) == text_match { 45, 5 });
+    CHECK(searcher.find(haystack, 46) == text_match { 51, 5 });
+}
+
+TEST_CASE("grapheme_search.exhaustive", "[grapheme_search]")
+{
+    // Compares against a naive search over all texts of a few grapheme-interacting building blocks.
+    auto constexpr Blocks =
+        std::array { "a"sv, "\u0301"sv, "\U0001F1E9"sv, "\u200D"sv, "\U0001F469"sv, "\r"sv, "\n"sv };
+    auto const needles = std::array { "a"sv, "aa"sv, "\U0001F1E9"sv, "\U0001F1E9\U0001F1E9"sv, "\U0001F469"sv,
+                                      "\n"sv, "a\u0301"sv };
+
+    for (size_t index = 0; index < 7 * 7 * 7 * 7 * 7; ++index)
+    {
+        auto text = std::string {};
+        for (auto i = index; text.size() < 10 && i != 0; i /= 7)
+            text += Blocks[i % 7];
+        auto const boundaries = grapheme_boundaries(text);
+        for (auto const needle: needles)
+        {
+            auto expected = std::optional<text_match> {};
+            for (size_t offset = 0; !expected && offset + needle.size() <= text.size(); ++offset)
+                if (text.substr(offset, needle.size()) == needle && boundaries[offset]
+                    && boundaries[offset + needle.size()])
+                    expected = text_match { offset, needle.size() };
+            INFO(index);
+            CHECK(find_graphemes(text, needle) == expected);
+        }
+    }
+}
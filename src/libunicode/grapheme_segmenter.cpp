@@ -13,106 +13,162 @@
  */
 #include <libunicode/utf8_grapheme_segmenter.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
 namespace unicode
 {
 
-void grapheme_process_init(char32_t nextCodepoint, grapheme_segmenter_state& state) noexcept
+namespace
 {
-    auto const Pb = codepoint_properties::get(nextCodepoint);
-    auto const B = Pb.grapheme_cluster_break;
+    using namespace detail;
 
-    state.previousCodepoint = nextCodepoint;
-    state.previousProperties = codepoint_properties::get(nextCodepoint);
-    state.ri_counter = (B == Grapheme_Cluster_Break::Regional_Indicator) ? 1 : 0;
-}
+    enum class BreakRule : uint8_t
+    {
+        Break,
+        NoBreak,
+        RegionalIndicatorPair, // breaks only after an even number of regional indicators
+        EmojiZwjSequence,      // breaks only if the ZWJ does not follow an Extended_Pictographic Extend*
+    };
 
-bool grapheme_process_breakable(char32_t nextCodepoint, grapheme_segmenter_state& state) noexcept
-{
-    auto const a = state.previousCodepoint;
-    auto const Pa = state.previousProperties;
-    auto const A = Pa.grapheme_cluster_break;
+    constexpr bool is_one_of(Grapheme_Cluster_Break value, std::initializer_list<Grapheme_Cluster_Break> set)
+    {
+        return std::find(set.begin(), set.end(), value) != set.end();
+    }
 
-    auto const b = nextCodepoint;
-    auto const Pb = codepoint_properties::get(b);
-    auto const B = Pb.grapheme_cluster_break;
+    /// Implements the rules GB3 to GB999, for the Grapheme_Cluster_Break values @p A and @p B
+    /// and the Extended_Pictographic property @p pictographicB around a potential break.
+    constexpr BreakRule break_rule(Grapheme_Cluster_Break A, Grapheme_Cluster_Break B, bool pictographicB)
+    {
+        using GCB = Grapheme_Cluster_Break;
+
+        // GB3: Do not break between a CR and LF.
+        if (A == GCB::CR && B == GCB::LF)
+            return BreakRule::NoBreak;
+
+        // GB4 + GB5: Otherwise, break before and after controls.
+        if (is_one_of(A, { GCB::Control, GCB::CR, GCB::LF }) || is_one_of(B, { GCB::Control, GCB::CR, GCB::LF }))
+            return BreakRule::Break;
+
+        // GB6 to GB8: Do not break Hangul syllable sequences.
+        if (A == GCB::L && is_one_of(B, { GCB::L, GCB::V, GCB::LV, GCB::LVT }))
+            return BreakRule::NoBreak;
+        if (is_one_of(A, { GCB::LV, GCB::V }) && is_one_of(B, { GCB::V, GCB::T }))
+            return BreakRule::NoBreak;
+        if (is_one_of(A, { GCB::LVT, GCB::T }) && B == GCB::T)
+            return BreakRule::NoBreak;
+
+        // GB9: Do not break before extending characters.
+        if (is_one_of(B, { GCB::Extend, GCB::ZWJ }))
+            return BreakRule::NoBreak;
+
+        // GB9a: Do not break before SpacingMarks
+        if (B == GCB::SpacingMark)
+            return BreakRule::NoBreak;
+
+        // GB9b: or after Prepend characters.
+        if (A == GCB::Prepend)
+            return BreakRule::NoBreak;
+
+        // GB11: Do not break within emoji modifier sequences or emoji zwj sequences.
+        if (A == GCB::ZWJ && pictographicB)
+            return BreakRule::EmojiZwjSequence;
+
+        // GB12/GB13: Do not break within emoji flag sequences.
+        // That is, do not break between regional indicator (RI) symbols
+        // if there is an odd number of RI characters before the break point.
+        if (A == GCB::Regional_Indicator && B == GCB::Regional_Indicator)
+            return BreakRule::RegionalIndicatorPair;
+
+        // GB999: Otherwise, break everywhere.
+        return BreakRule::Break;
+    }
 
-    state.previousCodepoint = b;
-    state.previousProperties = Pb;
+    /// Returns the outcome of processing the next codepoint in the given @p context,
+    /// that is, whether to break before it (bit 0) and the next context (remaining bits).
+    constexpr uint8_t make_transition(Grapheme_Cluster_Break A,
+                                      Grapheme_Cluster_Break B,
+                                      bool pictographicB,
+                                      uint8_t context)
+    {
+        using GCB = Grapheme_Cluster_Break;
 
-    static constexpr char32_t CR = 0x000D; // NOLINT
-    static constexpr char32_t LF = 0x000A; // NOLINT
+        auto breakable = false;
+        switch (break_rule(A, B, pictographicB))
+        {
+            case BreakRule::Break: breakable = true; break;
+            case BreakRule::NoBreak: break;
+            case BreakRule::RegionalIndicatorPair: breakable = !(context & OddRegionalIndicators); break;
+            case BreakRule::EmojiZwjSequence: breakable = !(context & PictographicSequence); break;
+        }
 
-    {
-        // Set state.ri_counter to zero if the next codepoint is not of category Regional_Indicator.
-        //
-        // We move the state.ri_counter out to help GCC optimize
-        // this code to be branchless.
-        // Sadly only GCC succeeds in doing this and Clang fails.
-        auto const ri_counter = state.ri_counter;
-        state.ri_counter = (B == Grapheme_Cluster_Break::Regional_Indicator) ? ri_counter : 0;
+        auto next = uint8_t { 0 };
+
+        // Keep track of whether there is an odd number of consecutive regional indicators so far.
+        if (B == GCB::Regional_Indicator && (A != GCB::Regional_Indicator || !(context & OddRegionalIndicators)))
+            next |= OddRegionalIndicators;
+
+        // Keep track of whether the previous codepoints match Extended_Pictographic Extend* ZWJ? (GB11).
+        if (pictographicB
+            || ((context & PictographicSequence) && A != GCB::ZWJ && is_one_of(B, { GCB::Extend, GCB::ZWJ })))
+            next |= PictographicSequence;
+
+        return static_cast<uint8_t>((next << 1) | (breakable ? 1 : 0));
     }
 
-    // GB3: Do not break between a CR and LF. Otherwise, break before and after controls.
-    if (a == CR && b == LF)
-        return false;
-
-    // GB4 (a) + GB5 (b) part 1 (C0 characers) + US-ASCII shortcut
-    // The US-ASCII part is a pure optimization improving performance
-    // in standard Latin text.
-    if (a < 128 && b < 128)
-        return true;
-
-    // GB4: (part 2)
-    if (A == Grapheme_Cluster_Break::Control)
-        return true;
-
-    // GB5: (part 2)
-    if (B == Grapheme_Cluster_Break::Control)
-        return true;
-
-    // Do not break Hangul syllable sequences.
-    // GB6:
-    if (A == Grapheme_Cluster_Break::L
-        && (B == Grapheme_Cluster_Break::L || B == Grapheme_Cluster_Break::V
-            || B == Grapheme_Cluster_Break::LV || B == Grapheme_Cluster_Break::LVT))
-        return false;
-
-    // GB7:
-    if ((A == Grapheme_Cluster_Break::LV || A == Grapheme_Cluster_Break::V)
-        && (B == Grapheme_Cluster_Break::V || B == Grapheme_Cluster_Break::T))
-        return false;
-
-    // GB8:
-    if ((A == Grapheme_Cluster_Break::LV || A == Grapheme_Cluster_Break::T) && B == Grapheme_Cluster_Break::T)
-        return false;
-
-    // GB9: Do not break before extending characters.
-    if (B == Grapheme_Cluster_Break::Extend || B == Grapheme_Cluster_Break::ZWJ)
-        return false;
-
-    // GB9a: Do not break before SpacingMarks
-    if (B == Grapheme_Cluster_Break::SpacingMark)
-        return false;
-
-    // GB9b: or after Prepend characters.
-    if (A == Grapheme_Cluster_Break::Prepend)
-        return false;
-
-    // GB11: Do not break within emoji modifier sequences or emoji zwj sequences.
-    if (A == Grapheme_Cluster_Break::ZWJ && Pb.extended_pictographic())
-        return false;
-
-    // GB12/GB13: Do not break within emoji flag sequences.
-    // That is, do not break between regional indicator (RI) symbols
-    // if there is an odd number of RI characters before the break point.
-    if (A == Grapheme_Cluster_Break::Regional_Indicator && A == B && state.ri_counter == 1)
+    constexpr grapheme_transition_table make_transition_table()
     {
-        state.ri_counter = static_cast<uint8_t>((state.ri_counter + 1) % 2);
-        return false;
+        auto table = grapheme_transition_table {};
+        for (size_t a = 0; a < GraphemeClusterBreakCount; ++a)
+        {
+            for (size_t b = 0; b < NextPropertiesCount; ++b)
+            {
+                auto const next = narrow_codepoint_properties {
+                    static_cast<uint8_t>(b << narrow_codepoint_properties::GraphemeClusterBreakShift)
+                };
+                auto& transitions = table[a][b];
+                for (size_t context = 0; context < ContextCount; ++context)
+                    transitions[context] = make_transition(static_cast<Grapheme_Cluster_Break>(a),
+                                                           next.grapheme_cluster_break(),
+                                                           next.extended_pictographic(),
+                                                           static_cast<uint8_t>(context));
+                for (size_t context = 1; context < ContextCount; ++context)
+                    if (transitions[context] != transitions[0])
+                        transitions[0] |= ContextDependent;
+            }
+        }
+        return table;
     }
+} // namespace
+
+namespace detail
+{
+    grapheme_transition_table const grapheme_transitions = make_transition_table();
+} // namespace detail
 
-    // GB999: Otherwise, break everywhere.
-    return true; // GB10
+
+uint32_t grapheme_segmenter_state::serialize() const noexcept
+{
+    // Bits 0..20 hold the previous codepoint, followed by one bit for each of the flags.
+    return static_cast<uint32_t>(previousCodepoint) | (uint32_t { ri_counter } << 21)
+           | (uint32_t { pictographic_sequence } << 22);
+}
+
+grapheme_segmenter_state grapheme_segmenter_state::deserialize(uint32_t value) noexcept
+{
+    auto const codepoint = static_cast<char32_t>(value & 0x1FFFFF);
+    if (codepoint > 0x10FFFF || (value >> 23) != 0)
+        return {};
+
+    auto state = grapheme_segmenter_state {};
+    state.previousCodepoint = codepoint;
+    state.previousProperties = narrow_codepoint_properties::get(codepoint);
+    state.ri_counter = static_cast<uint8_t>((value >> 21) & 1);
+    state.pictographic_sequence = static_cast<uint8_t>((value >> 22) & 1);
+    return state;
 }
 
 } // namespace unicode
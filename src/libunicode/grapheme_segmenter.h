@@ -14,8 +14,12 @@
 #pragma once
 
 #include <libunicode/codepoint_properties.h>
+#include <libunicode/statistics.h>
 #include <libunicode/ucd.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 namespace unicode
@@ -26,33 +30,163 @@ namespace unicode
 /// allow proper processing of regional flags
 /// as well as reducing the number of invocations
 /// to codepoint_properties::get().
+///
+/// The state is complete, i.e. segmentation can be resumed with the next chunk of
+/// codepoints at any time, yielding the same boundaries as segmenting the whole text at once.
 struct grapheme_segmenter_state
 {
     char32_t previousCodepoint = {};
-    codepoint_properties previousProperties = codepoint_properties::get(0);
+    narrow_codepoint_properties previousProperties = narrow_codepoint_properties::get(0);
 
     uint8_t ri_counter = 0; // modulo 2
+
+    // 1 if the previous codepoints are an Extended_Pictographic followed by Extend* and an optional ZWJ.
+    uint8_t pictographic_sequence = 0;
+
+    /// Segments the next @p chunk of codepoints, continuing where the previous chunk ended.
+    ///
+    /// Invokes @p onBreak with the offset into @p chunk of every codepoint a grapheme cluster starts at.
+    /// With a default constructed state, the very first codepoint is considered to start
+    /// a grapheme cluster (GB1).
+    template <typename BreakHandler>
+    void feed(std::u32string_view chunk, BreakHandler&& onBreak);
+
+    /// Packs this state into a 32-bit value, e.g. to persist it along with the text segmented so far.
+    [[nodiscard]] uint32_t serialize() const noexcept;
+
+    /// Restores a state from a value previously returned by serialize().
+    ///
+    /// Values that serialize() will never return yield a default constructed state.
+    [[nodiscard]] static grapheme_segmenter_state deserialize(uint32_t value) noexcept;
+
+    constexpr bool operator==(grapheme_segmenter_state const& rhs) const noexcept
+    {
+        return previousCodepoint == rhs.previousCodepoint && previousProperties == rhs.previousProperties
+               && ri_counter == rhs.ri_counter && pictographic_sequence == rhs.pictographic_sequence;
+    }
+
+    constexpr bool operator!=(grapheme_segmenter_state const& rhs) const noexcept { return !(*this == rhs); }
 };
 
-void grapheme_process_init(char32_t nextCodepoint, grapheme_segmenter_state& state) noexcept;
+namespace detail
+{
+    // State bits that processing the next codepoint depends on, besides its Grapheme_Cluster_Break.
+    constexpr uint8_t OddRegionalIndicators = 0x01; // NOLINT(readability-identifier-naming)
+    constexpr uint8_t PictographicSequence = 0x02;  // NOLINT(readability-identifier-naming)
+    constexpr size_t ContextCount = 4;              // NOLINT(readability-identifier-naming)
+
+    // Set on transitions in context 0 if the transition differs in any other context.
+    constexpr uint8_t ContextDependent = 0x80; // NOLINT(readability-identifier-naming)
+
+    // Number of Grapheme_Cluster_Break values.
+    constexpr size_t GraphemeClusterBreakCount = // NOLINT(readability-identifier-naming)
+        static_cast<size_t>(Grapheme_Cluster_Break::ZWJ) + 1;
+
+    // Number of values the upper bits of narrow_codepoint_properties
+    // (Grapheme_Cluster_Break and Extended_Pictographic) can take.
+    constexpr size_t NextPropertiesCount = // NOLINT(readability-identifier-naming)
+        0x100 >> narrow_codepoint_properties::GraphemeClusterBreakShift;
+
+    using context_transitions = std::array<uint8_t, ContextCount>;
+    using grapheme_transition_table =
+        std::array<std::array<context_transitions, NextPropertiesCount>, GraphemeClusterBreakCount>;
+
+    /// Transitions by Grapheme_Cluster_Break of the previous codepoint, the upper bits of the narrow
+    /// codepoint properties (Grapheme_Cluster_Break and Extended_Pictographic) of the next codepoint,
+    /// and the context, that is, whether to break before the next codepoint (bit 0) and the next context
+    /// (remaining bits).
+    ///
+    /// The table is kept in the library, whereas the functions looking up in it are defined inline below,
+    /// as they are called for every single codepoint.
+    extern grapheme_transition_table const grapheme_transitions;
+} // namespace detail
+
+/// Same as grapheme_process_init(char32_t, grapheme_segmenter_state&) but with the
+/// codepoint properties of @p nextCodepoint already looked up by the caller.
+inline void grapheme_process_init(char32_t nextCodepoint,
+                                  narrow_codepoint_properties nextProperties,
+                                  grapheme_segmenter_state& state) noexcept
+{
+    auto const B = nextProperties.grapheme_cluster_break();
+
+    state.previousCodepoint = nextCodepoint;
+    state.previousProperties = nextProperties;
+    state.ri_counter = (B == Grapheme_Cluster_Break::Regional_Indicator) ? 1 : 0;
+    state.pictographic_sequence = nextProperties.extended_pictographic() ? 1 : 0;
+}
+
+inline void grapheme_process_init(char32_t nextCodepoint, grapheme_segmenter_state& state) noexcept
+{
+    grapheme_process_init(nextCodepoint, narrow_codepoint_properties::get(nextCodepoint), state);
+}
+
+/// Same as grapheme_process_breakable(char32_t, grapheme_segmenter_state&) but with the
+/// codepoint properties of @p nextCodepoint already looked up by the caller.
+///
+/// This allows resolving the properties for a whole block of codepoints upfront.
+inline bool grapheme_process_breakable(char32_t nextCodepoint,
+                                narrow_codepoint_properties nextProperties,
+                                grapheme_segmenter_state& state) noexcept
+{
+    // US-ASCII shortcut: all pairs are breakable except for CR LF (GB3).
+    if ((state.previousCodepoint | nextCodepoint) < 128 && state.previousCodepoint != '\r')
+    {
+        state.previousCodepoint = nextCodepoint;
+        state.previousProperties = nextProperties;
+        state.ri_counter = 0;
+        state.pictographic_sequence = 0;
+        return true;
+    }
+
+    auto const previous = static_cast<size_t>(state.previousProperties.grapheme_cluster_break());
+    auto const next =
+        size_t { nextProperties.value } >> narrow_codepoint_properties::GraphemeClusterBreakShift;
+    auto const& transitions = detail::grapheme_transitions[previous][next];
+
+    // Only looking at the context if needed keeps it off the critical path for most codepoints.
+    auto transition = transitions[0];
+    if (transition & detail::ContextDependent)
+        transition = transitions[static_cast<size_t>(state.ri_counter | (state.pictographic_sequence << 1))];
+
+    state.previousCodepoint = nextCodepoint;
+    state.previousProperties = nextProperties;
+    state.ri_counter = (transition >> 1) & detail::OddRegionalIndicators;
+    state.pictographic_sequence = (transition >> 2) & 1;
+
+    return transition & 1;
+}
 
 /// Tests if codepoint @p a and @p b are breakable, and thus, two different grapheme clusters.
 ///
 /// @retval true both codepoints to not belong to the same grapheme cluster
 /// @retval false both codepoints belong to the same grapheme cluster
-bool grapheme_process_breakable(char32_t nextCodepoint, grapheme_segmenter_state& state) noexcept;
+inline bool grapheme_process_breakable(char32_t nextCodepoint, grapheme_segmenter_state& state) noexcept
+{
+    return grapheme_process_breakable(nextCodepoint, narrow_codepoint_properties::get(nextCodepoint), state);
+}
+
+template <typename BreakHandler>
+void grapheme_segmenter_state::feed(std::u32string_view chunk, BreakHandler&& onBreak)
+{
+    for (size_t i = 0; i < chunk.size(); ++i)
+        if (grapheme_process_breakable(chunk[i], *this))
+            onBreak(i);
+}
 
 /// Implements http://www.unicode.org/reports/tr29/tr29-27.html#Grapheme_Cluster_Boundary_Rules
 class grapheme_segmenter
 {
   public:
-    grapheme_segmenter(char32_t const* begin, char32_t const* end) noexcept:
-        left_ { begin }, right_ { begin }, end_ { end }, state_ {}
+    /// Segments the codepoints from @p begin to @p end, optionally counting the work done
+    /// into @p stats (see statistics_enabled).
+    grapheme_segmenter(char32_t const* begin, char32_t const* end, statistics* stats = nullptr) noexcept:
+        left_ { begin }, right_ { begin }, end_ { end }, state_ {}, stats_ { stats }
     {
         ++*this;
     }
 
-    grapheme_segmenter(std::u32string_view sv) noexcept: grapheme_segmenter(sv.data(), sv.data() + sv.size())
+    grapheme_segmenter(std::u32string_view sv, statistics* stats = nullptr) noexcept:
+        grapheme_segmenter(sv.data(), sv.data() + sv.size(), stats)
     {
     }
 
@@ -69,6 +203,8 @@ class grapheme_segmenter
         while (right_ != end_ && !grapheme_process_breakable(*right_, state_))
             ++right_;
 
+        detail::count(stats_, &statistics::graphemeClusters);
+        detail::count(stats_, &statistics::propertyLookups, static_cast<uint64_t>(right_ - left_));
         return *this;
     }
 
@@ -91,15 +227,15 @@ class grapheme_segmenter
     ///
     /// @retval true both codepoints to not belong to the same grapheme cluster
     /// @retval false both codepoints belong to the same grapheme cluster
+    ///
+    /// As the preceding codepoints are unknown, a ZWJ @p a is assumed to continue
+    /// an emoji ZWJ sequence.
     static bool breakable(char32_t a, char32_t b) noexcept
     {
         auto state = grapheme_segmenter_state {};
-        state.previousCodepoint = a;
-        state.previousProperties = codepoint_properties::get(a);
-        state.ri_counter =
-            (state.previousProperties.grapheme_cluster_break == Grapheme_Cluster_Break::Regional_Indicator)
-                ? 1
-                : 0;
+        grapheme_process_init(a, state);
+        if (state.previousProperties.grapheme_cluster_break() == Grapheme_Cluster_Break::ZWJ)
+            state.pictographic_sequence = 1;
         return grapheme_process_breakable(b, state);
     }
 
@@ -110,6 +246,7 @@ class grapheme_segmenter
     char32_t const* right_;
     char32_t const* end_;
     grapheme_segmenter_state state_;
+    statistics* stats_;
 };
 
 } // namespace unicode
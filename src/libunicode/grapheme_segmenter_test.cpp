@@ -221,3 +221,97 @@ TEST_CASE("grapheme_segmenter.iterator_3: regional flags invalid 2", "[grapheme_
     REQUIRE(*gs == U"");
     REQUIRE_FALSE(gs.codepointsAvailable());
 }
+
+namespace
+{
+// Returns the positions of grapheme cluster breaks, when carrying the segmentation state forward.
+vector<size_t> grapheme_breaks(u32string_view text)
+{
+    auto breaks = vector<size_t> {};
+    auto state = grapheme_segmenter_state {};
+    grapheme_process_init(text[0], state);
+    for (size_t i = 1; i < text.size(); ++i)
+        if (grapheme_process_breakable(text[i], state))
+            breaks.push_back(i);
+    return breaks;
+}
+} // namespace
+
+TEST_CASE("grapheme_segmenter.rules", "[grapheme_segmenter]")
+{
+    // GB3, GB4, GB5
+    CHECK(grapheme_segmenter::nonbreakable('\r', '\n'));
+    CHECK(grapheme_segmenter::breakable('\n', '\r'));
+    CHECK(grapheme_segmenter::breakable('\r', U'̈'));
+    CHECK(grapheme_segmenter::breakable('\n', U'̈'));
+    CHECK(grapheme_segmenter::breakable(U'̈', '\t'));
+
+    // GB6 to GB8
+    CHECK(grapheme_segmenter::nonbreakable(U'ᄀ', U'ᅡ')); // L x V
+    CHECK(grapheme_segmenter::nonbreakable(U'가', U'ᆨ')); // LV x T
+    CHECK(grapheme_segmenter::nonbreakable(U'각', U'ᆨ')); // LVT x T
+    CHECK(grapheme_segmenter::breakable(U'각', U'ᅡ'));    // LVT / V
+
+    // GB9b
+    CHECK(grapheme_segmenter::nonbreakable(U'؀', 'a'));
+
+    // GB11
+    CHECK(grapheme_segmenter::nonbreakable(U'‍', U'\U0001F466'));
+    CHECK(grapheme_segmenter::breakable(U'‍', 'a'));
+}
+
+TEST_CASE("grapheme_segmenter.regional_indicators", "[grapheme_segmenter]")
+{
+    auto const ri = U'\U0001F1E9';
+    CHECK(grapheme_breaks(u32string { ri, ri, ri, ri, ri }) == vector<size_t> { 2, 4 });
+    CHECK(grapheme_breaks(u32string { 'a', ri, ri, ri, ri }) == vector<size_t> { 1, 3 });
+    CHECK(grapheme_breaks(u32string { ri, 'a', ri, ri, ri }) == vector<size_t> { 1, 2, 4 });
+}
+
+TEST_CASE("grapheme_segmenter.emoji_zwj_sequence_context", "[grapheme_segmenter]")
+{
+    // GB11 only applies if the ZWJ follows an Extended_Pictographic.
+    CHECK(grapheme_breaks(U"\U0001F468‍\U0001F469") == vector<size_t> {});
+    CHECK(grapheme_breaks(U"\U0001F468́‍\U0001F469") == vector<size_t> {});
+    CHECK(grapheme_breaks(U"a‍\U0001F469") == vector<size_t> { 2 });
+    CHECK(grapheme_breaks(U"\U0001F468‍‍\U0001F469") == vector<size_t> { 3 });
+}
+
+TEST_CASE("grapheme_segmenter_state.feed", "[grapheme_segmenter]")
+{
+    auto const text = u32string_view { U"\U0001F1E9\U0001F1EA\U0001F1E9\U0001F1EA\U0001F1E9x\U0001F468‍"
+                                       U"\U0001F469‍\U0001F467a‍\U0001F469\r\ń각ᆨ" };
+
+    auto whole = vector<size_t> {};
+    auto state = grapheme_segmenter_state {};
+    state.feed(text, [&](size_t offset) { whole.push_back(offset); });
+    CHECK(whole.front() == 0);
+
+    for (size_t split = 0; split <= text.size(); ++split)
+    {
+        INFO("split at " << split);
+        auto chunked = vector<size_t> {};
+        state = grapheme_segmenter_state {};
+        state.feed(text.substr(0, split), [&](size_t offset) { chunked.push_back(offset); });
+
+        // Resume from a serialized state.
+        state = grapheme_segmenter_state::deserialize(state.serialize());
+        state.feed(text.substr(split), [&](size_t offset) { chunked.push_back(split + offset); });
+        CHECK(chunked == whole);
+    }
+}
+
+TEST_CASE("grapheme_segmenter_state.serialize", "[grapheme_segmenter]")
+{
+    auto state = grapheme_segmenter_state {};
+    CHECK(grapheme_segmenter_state::deserialize(state.serialize()) == state);
+
+    for (auto const codepoint: { U'\U0001F1E9', U'\U0001F468', U'‍', U'\U0010FFFF' })
+    {
+        grapheme_process_breakable(codepoint, state);
+        CHECK(grapheme_segmenter_state::deserialize(state.serialize()) == state);
+    }
+
+    CHECK(grapheme_segmenter_state::deserialize(0x110000) == grapheme_segmenter_state {});
+    CHECK(grapheme_segmenter_state::deserialize(0xFFFFFFFF) == grapheme_segmenter_state {});
+}
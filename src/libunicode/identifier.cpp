@@ -0,0 +1,137 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/convert.h>
+#include <libunicode/identifier.h>
+#include <libunicode/intrinsics.h>
+
+#include <bit>
+#include <cstdint>
+
+namespace unicode
+{
+
+namespace
+{
+    using identifier_property = identifier_bitmap::property;
+
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+    /// Masks the bytes from the US-ASCII @p first to @p last, thus excluding any non-US-ASCII byte.
+    intrinsics::m128i in_range(intrinsics::m128i bytes, char first, char last) noexcept
+    {
+        return intrinsics::xor128(
+            intrinsics::compare_less(bytes, intrinsics::set1_epi8(first)),
+            intrinsics::compare_less(bytes, intrinsics::set1_epi8(static_cast<char>(last + 1))));
+    }
+
+    /// Masks the US-ASCII bytes of the given property (which is never Start, as it only applies to the
+    /// first codepoint).
+    intrinsics::m128i ascii_matches(intrinsics::m128i bytes, identifier_property property) noexcept
+    {
+        if (property == identifier_property::PatternWhiteSpace)
+            return intrinsics::or128(in_range(bytes, '\t', '\r'),
+                                     intrinsics::compare_equal_epi8(bytes, intrinsics::set1_epi8(' ')));
+
+        // Letters of either case are matched together, with their case bit set.
+        auto const letters = in_range(intrinsics::or128(bytes, intrinsics::set1_epi8(0x20)), 'a', 'z');
+        return intrinsics::or128(intrinsics::or128(letters, in_range(bytes, '0', '9')),
+                                 intrinsics::compare_equal_epi8(bytes, intrinsics::set1_epi8('_')));
+    }
+#endif
+
+    /// Scans the longest run of codepoints of the given property from the byte @p offset of @p text.
+    size_t scan_run(identifier_bitmap::tables_view const& tables,
+                    std::string_view text,
+                    size_t offset,
+                    identifier_property property) noexcept
+    {
+        auto i = offset;
+        while (i < text.size())
+        {
+#if defined(__x86_64__) || defined(_M_AMD64) || defined(__aarch64__) || defined(_M_ARM64)
+            auto constexpr VectorSize = sizeof(intrinsics::m128i);
+            if (i + VectorSize <= text.size())
+            {
+                auto const bytes = intrinsics::load_unaligned((intrinsics::m128i const*) (text.data() + i));
+                auto const matches =
+                    static_cast<uint32_t>(intrinsics::movemask_epi8(ascii_matches(bytes, property)));
+                auto const mismatches = ~matches & 0xFFFF;
+                if (mismatches == 0)
+                {
+                    i += VectorSize;
+                    continue;
+                }
+                // The byte at the first mismatch is either not of the property, or not US-ASCII.
+                i += static_cast<size_t>(std::countr_zero(mismatches));
+            }
+#endif
+
+            if (static_cast<uint8_t>(text[i]) < 0x80)
+            {
+                if (!tables.contains(property, static_cast<char32_t>(text[i])))
+                    break;
+                ++i;
+                continue;
+            }
+
+            auto const sequence = decode_utf8_sequence(text.substr(i));
+            if (sequence.status != ConversionStatus::Success || !tables.contains(property, sequence.value))
+                break;
+            i += sequence.length;
+        }
+        return i - offset;
+    }
+} // namespace
+
+bool is_identifier_start(char32_t codepoint) noexcept
+{
+    return identifier_bitmap::configured_tables().contains(identifier_property::Start, codepoint);
+}
+
+bool is_identifier_continue(char32_t codepoint) noexcept
+{
+    return identifier_bitmap::configured_tables().contains(identifier_property::Continue, codepoint);
+}
+
+bool is_pattern_white_space(char32_t codepoint) noexcept
+{
+    auto constexpr PatternWhiteSpace = identifier_property::PatternWhiteSpace;
+    return identifier_bitmap::configured_tables().contains(PatternWhiteSpace, codepoint);
+}
+
+size_t scan_identifier(std::string_view text) noexcept
+{
+    if (text.empty())
+        return 0;
+
+    auto const& tables = identifier_bitmap::configured_tables();
+    auto const first = decode_utf8_sequence(text);
+    if (first.status != ConversionStatus::Success
+        || !tables.contains(identifier_property::Start, first.value))
+        return 0;
+    return first.length + scan_run(tables, text, first.length, identifier_property::Continue);
+}
+
+size_t scan_identifier_continue(std::string_view text) noexcept
+{
+    return scan_run(identifier_bitmap::configured_tables(), text, 0, identifier_property::Continue);
+}
+
+size_t scan_pattern_white_space(std::string_view text) noexcept
+{
+    auto constexpr PatternWhiteSpace = identifier_property::PatternWhiteSpace;
+    return scan_run(identifier_bitmap::configured_tables(), text, 0, PatternWhiteSpace);
+}
+
+} // namespace unicode
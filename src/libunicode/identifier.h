@@ -0,0 +1,58 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace unicode
+{
+
+/// Tests whether @p codepoint may start an identifier, i.e. whether it is XID_Start,
+/// as per UAX #31 "Unicode Identifiers and Syntax".
+///
+/// This and the following tests are a lookup of the identifier bitmaps of the configured
+/// property_tables, rather than binary searches of the property's ranges like
+/// contains(Core_Property, char32_t).
+[[nodiscard]] bool is_identifier_start(char32_t codepoint) noexcept;
+
+/// Tests whether @p codepoint may continue an identifier, i.e. whether it is XID_Continue.
+[[nodiscard]] bool is_identifier_continue(char32_t codepoint) noexcept;
+
+/// Tests whether @p codepoint is Pattern_White_Space, i.e. white space in the syntax of
+/// programming languages and other formal grammars, as per UAX #31.
+[[nodiscard]] bool is_pattern_white_space(char32_t codepoint) noexcept;
+
+/// Scans the longest identifier at the start of the UTF-8 @p text,
+/// that is, an XID_Start codepoint followed by any number of XID_Continue codepoints.
+///
+/// US-ASCII text is scanned 16 bytes at a time, where SIMD is available.
+/// Scanning stops at the first ill-formed UTF-8 sequence.
+///
+/// @returns the length of the identifier in bytes, or 0 if @p text does not start with one.
+[[nodiscard]] size_t scan_identifier(std::string_view text) noexcept;
+
+/// Scans the longest run of XID_Continue codepoints at the start of the UTF-8 @p text,
+/// e.g. to scan the rest of an identifier of a language that also starts identifiers with other
+/// codepoints (such as U+005F LOW LINE).
+///
+/// @returns the length of the run in bytes.
+[[nodiscard]] size_t scan_identifier_continue(std::string_view text) noexcept;
+
+/// Scans the longest run of Pattern_White_Space codepoints at the start of the UTF-8 @p text.
+///
+/// @returns the length of the run in bytes.
+[[nodiscard]] size_t scan_pattern_white_space(std::string_view text) noexcept;
+
+} // namespace unicode
@@ -0,0 +1,134 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/identifier.h>
+#include <libunicode/ucd.h>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::string_literals;
+using unicode::scan_identifier;
+using unicode::scan_identifier_continue;
+using unicode::scan_pattern_white_space;
+
+namespace
+{
+
+// Scans the identifier at the start of @p text one codepoint at a time, by the property ranges.
+size_t scan_identifier_slowly(std::string_view text)
+{
+    size_t i = 0;
+    while (i < text.size())
+    {
+        auto const sequence = unicode::decode_utf8_sequence(text.substr(i));
+        auto const property =
+            i == 0 ? unicode::Core_Property::XID_Start : unicode::Core_Property::XID_Continue;
+        if (sequence.status != unicode::ConversionStatus::Success
+            || !unicode::contains(property, sequence.value))
+            break;
+        i += sequence.length;
+    }
+    return i;
+}
+
+} // namespace
+
+TEST_CASE("identifier.bitmaps")
+{
+    auto mismatches = std::vector<char32_t> {};
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+        if (unicode::is_identifier_start(codepoint)
+                != unicode::contains(unicode::Core_Property::XID_Start, codepoint)
+            || unicode::is_identifier_continue(codepoint)
+                   != unicode::contains(unicode::Core_Property::XID_Continue, codepoint))
+            mismatches.push_back(codepoint);
+    CHECK(mismatches.empty());
+
+    CHECK(unicode::is_identifier_start(U'\u00C5'));
+    CHECK_FALSE(unicode::is_identifier_start(U'\u0301'));
+    CHECK(unicode::is_identifier_continue(U'\u0301'));
+    CHECK_FALSE(unicode::is_identifier_start(0x110000));
+    CHECK_FALSE(unicode::is_identifier_continue(0x110000));
+}
+
+TEST_CASE("identifier.pattern_white_space")
+{
+    auto whiteSpace = std::vector<char32_t> {};
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+        if (unicode::is_pattern_white_space(codepoint))
+            whiteSpace.push_back(codepoint);
+    auto const expected =
+        std::vector<char32_t> { 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x20, 0x85, 0x200E, 0x200F, 0x2028, 0x2029 };
+    CHECK(whiteSpace == expected);
+
+    CHECK(scan_pattern_white_space("") == 0);
+    CHECK(scan_pattern_white_space("x ") == 0);
+    CHECK(scan_pattern_white_space(" \t\r\nx") == 4);
+    CHECK(scan_pattern_white_space("\u2028  \u0085\u3000") == 7); // U+3000 is White_Space only
+    CHECK(scan_pattern_white_space(std::string(40, ' ') + "\v\f;") == 42);
+}
+
+TEST_CASE("identifier.scan_identifier")
+{
+    CHECK(scan_identifier("") == 0);
+    CHECK(scan_identifier("foo_bar1 = 2") == 8);
+    CHECK(scan_identifier("1abc") == 0);
+    CHECK(scan_identifier("_abc") == 0);
+    CHECK(scan_identifier_continue("_abc") == 4);
+    CHECK(scan_identifier_continue("1abc-") == 4);
+    CHECK(scan_identifier("stra\u00DFe(") == 7);
+    CHECK(scan_identifier("e\u0301x") == 4);
+    CHECK(scan_identifier("\u0301e") == 0);
+    CHECK(scan_identifier("\u4E16\u754C.") == 6);
+    CHECK(scan_identifier("x\U0001F600") == 1);
+    CHECK(scan_identifier("x\xE4\xB8") == 1); // incomplete
+    CHECK(scan_identifier("abc\xFF" "def") == 3);
+    CHECK(scan_identifier("\xC3\x85") == 2);
+    CHECK(scan_identifier("\xC3") == 0);
+
+    // Around and across the blocks of 16 bytes scanned at once.
+    auto const ascii = "an_identifier_of_more_than_16_bytes"s;
+    CHECK(scan_identifier(ascii) == ascii.size());
+    CHECK(scan_identifier(ascii + "+1") == ascii.size());
+    CHECK(scan_identifier(ascii.substr(0, 15) + "\u00E9" + ascii + " ") == ascii.size() + 17);
+    CHECK(scan_identifier(ascii.substr(0, 16) + "\u00D7" + ascii) == 16); // U+00D7 MULTIPLICATION SIGN
+    CHECK(scan_identifier(ascii + "\x80" + ascii) == ascii.size());
+}
+
+TEST_CASE("identifier.scan_identifier.random")
+{
+    // Identifier characters of either width, and some that are not (or ill-formed UTF-8).
+    auto const pieces = std::array<std::string_view, 12> {
+        "a", "Z", "_", "7", "\u00E9", "\u0301", "\u4E16", "\U00010400", " ", "-", "\u00D7", "\xE4\xB8",
+    };
+    auto random = std::mt19937 { 4711 };
+    auto pick = std::uniform_int_distribution<size_t> { 0, pieces.size() - 1 };
+    auto identifierPick = std::uniform_int_distribution<size_t> { 0, 7 };
+
+    for (int round = 0; round < 1000; ++round)
+    {
+        auto text = std::string {};
+        auto const length = random() % 64;
+        for (size_t i = 0; i < length; ++i)
+            text += pieces[random() % 8 != 0 ? identifierPick(random) : pick(random)];
+        INFO(round);
+        CHECK(scan_identifier(text) == scan_identifier_slowly(text));
+    }
+}
@@ -13,15 +13,29 @@
  */
 #pragma once
 
+#include <cstdint>
+
 #if defined(__x86_64__) || defined(_M_AMD64)
     #include <emmintrin.h> // AVX, AVX2, FMP
     #include <immintrin.h> // SSE2
+    #if defined(_MSC_VER)
+        #include <intrin.h> // __cpuid, __cpuidex
+    #endif
 #endif
 
 #if defined(__aarch64__) || defined(_M_ARM64)
     #include <arm_neon.h>
 #endif
 
+// Marks a function to be compiled for the given instruction set extension(s), regardless of the
+// compiler flags the translation unit is built with. Such functions must only be called after checking
+// at runtime that the CPU actually supports the requested extension(s).
+#if defined(__GNUC__) || defined(__clang__)
+    #define LIBUNICODE_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define LIBUNICODE_TARGET(isa)
+#endif
+
 namespace unicode
 {
 
@@ -45,6 +59,10 @@ struct platform_intrinsics<__m128i>
 
     static inline m128i set1_epi8(signed char w) { return _mm_set1_epi8(w); }
 
+    static inline m128i set1_epi32(uint32_t w) noexcept { return _mm_set1_epi32(static_cast<int>(w)); }
+
+    static inline m128i sub_epi32(m128i a, m128i b) noexcept { return _mm_sub_epi32(a, b); }
+
     static inline m128i load32(uint32_t a, uint32_t b, uint32_t c, uint32_t d) noexcept
     {
         return _mm_set_epi32(
@@ -63,6 +81,8 @@ struct platform_intrinsics<__m128i>
         return _mm_loadu_si128(static_cast<m128i const*>(p));
     }
 
+    static inline void store_unaligned(m128i* p, m128i a) noexcept { _mm_storeu_si128(p, a); }
+
     static inline int32_t to_i32(m128i a) { return _mm_cvtsi128_si32(a); }
 
     static inline bool compare(m128i a, m128i b) noexcept
@@ -70,15 +90,132 @@ struct platform_intrinsics<__m128i>
         return _mm_movemask_epi8(_mm_cmpeq_epi32(a, b)) == 0xFFFF;
     }
 
+    static inline m128i compare_equal_epi8(m128i a, m128i b) noexcept { return _mm_cmpeq_epi8(a, b); }
+
     static inline m128i compare_less(m128i a, m128i b) noexcept { return _mm_cmplt_epi8(a, b); }
 
+    // Compares the 4 unsigned 32-bit integers in a and b for lesser than,
+    // by flipping their sign bits for the signed comparison, as SSE2 has no unsigned one.
+    static inline m128i compare_less_epu32(m128i a, m128i b) noexcept
+    {
+        auto const signBit = _mm_set1_epi32(static_cast<int>(0x8000'0000));
+        return _mm_cmplt_epi32(_mm_xor_si128(a, signBit), _mm_xor_si128(b, signBit));
+    }
+
     static inline int movemask_epi8(m128i a) { return _mm_movemask_epi8(a); }
 
+    // Tests if any bit in a is set.
+    static inline bool any(m128i a) noexcept
+    {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(a, setzero())) != 0xFFFF;
+    }
+
     static inline m128i cvtsi64_si128(int64_t a) { return _mm_cvtsi64_si128(a); }
 };
 
 using intrinsics = platform_intrinsics<__m128i>;
 
+// 256-bit wide vector operations (AVX2).
+template <>
+struct platform_intrinsics<__m256i>
+{
+    using m256i = __m256i;
+
+    LIBUNICODE_TARGET("avx2") static inline m256i set1_epi8(signed char w) noexcept
+    {
+        return _mm256_set1_epi8(w);
+    }
+
+    LIBUNICODE_TARGET("avx2") static inline m256i load_unaligned(void const* p) noexcept
+    {
+        return _mm256_loadu_si256(static_cast<m256i const*>(p));
+    }
+
+    LIBUNICODE_TARGET("avx2") static inline m256i and256(m256i a, m256i b) noexcept
+    {
+        return _mm256_and_si256(a, b);
+    }
+
+    LIBUNICODE_TARGET("avx2") static inline m256i or256(m256i a, m256i b) noexcept
+    {
+        return _mm256_or_si256(a, b);
+    }
+
+    // Compares the 32 signed 8-bit integers in a and b for lesser than.
+    LIBUNICODE_TARGET("avx2") static inline m256i compare_less(m256i a, m256i b) noexcept
+    {
+        return _mm256_cmpgt_epi8(b, a);
+    }
+
+    LIBUNICODE_TARGET("avx2") static inline uint32_t movemask_epi8(m256i a) noexcept
+    {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(a));
+    }
+};
+
+using intrinsics_avx2 = platform_intrinsics<__m256i>;
+
+// 512-bit wide vector operations (AVX-512F + AVX-512BW).
+template <>
+struct platform_intrinsics<__m512i>
+{
+    using m512i = __m512i;
+
+    LIBUNICODE_TARGET("avx512f,avx512bw") static inline m512i set1_epi8(signed char w) noexcept
+    {
+        return _mm512_set1_epi8(w);
+    }
+
+    LIBUNICODE_TARGET("avx512f,avx512bw") static inline m512i load_unaligned(void const* p) noexcept
+    {
+        return _mm512_loadu_si512(p);
+    }
+
+    // Compares the 64 signed 8-bit integers in a and b for lesser than,
+    // returning one bit per byte (just like movemask_epi8() on the narrower vector types).
+    LIBUNICODE_TARGET("avx512f,avx512bw") static inline uint64_t compare_less(m512i a, m512i b) noexcept
+    {
+        return static_cast<uint64_t>(_mm512_cmplt_epi8_mask(a, b));
+    }
+};
+
+using intrinsics_avx512 = platform_intrinsics<__m512i>;
+
+/// Tests at runtime whether or not the CPU (and operating system) supports AVX2.
+inline bool cpu_supports_avx2() noexcept
+{
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] {};
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool const osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 0x06) != 0x06) // XMM and YMM state enabled by the OS.
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+    #else
+    return __builtin_cpu_supports("avx2");
+    #endif
+}
+
+/// Tests at runtime whether or not the CPU (and operating system) supports AVX-512F and AVX-512BW.
+inline bool cpu_supports_avx512bw() noexcept
+{
+    #if defined(_MSC_VER) && !defined(__clang__)
+    if (!cpu_supports_avx2())
+        return false;
+    if ((_xgetbv(0) & 0xE6) != 0xE6) // opmask, ZMM_Hi256, Hi16_ZMM state enabled by the OS.
+        return false;
+    int info[4] {};
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0; // AVX512F && AVX512BW
+    #else
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    #endif
+}
+
 #endif
 // }}}
 
@@ -95,6 +232,13 @@ struct platform_intrinsics<int64x2_t>
 
     static inline m128i set1_epi8(signed char w) { return vreinterpretq_s64_s8(vdupq_n_s8(w)); }
 
+    static inline m128i set1_epi32(uint32_t w) noexcept { return vreinterpretq_s64_u32(vdupq_n_u32(w)); }
+
+    static inline m128i sub_epi32(m128i a, m128i b) noexcept
+    {
+        return vreinterpretq_s64_u32(vsubq_u32(vreinterpretq_u32_s64(a), vreinterpretq_u32_s64(b)));
+    }
+
     static inline m128i load32(uint32_t a, uint32_t b, uint32_t c, uint32_t d) noexcept
     {
         alignas(16) int32_t data[4] = {
@@ -131,6 +275,11 @@ struct platform_intrinsics<int64x2_t>
         return vreinterpretq_s64_s32(vld1q_s32((int32_t const*) p));
     }
 
+    static inline void store_unaligned(m128i* p, m128i a) noexcept
+    {
+        vst1q_s32((int32_t*) p, vreinterpretq_s32_s64(a));
+    }
+
     // Copy the lower 32-bit integer in a to dst.
     //
     //   dst[31:0] := a[31:0]
@@ -145,6 +294,11 @@ struct platform_intrinsics<int64x2_t>
                == 0xFFFF;
     }
 
+    static inline m128i compare_equal_epi8(m128i a, m128i b) noexcept
+    {
+        return vreinterpretq_s64_u8(vceqq_s8(vreinterpretq_s8_s64(a), vreinterpretq_s8_s64(b)));
+    }
+
     static inline m128i compare_less(m128i a, m128i b) noexcept
     {
         // Compares the 16 signed 8-bit integers in a and the 16 signed 8-bit integers
@@ -153,6 +307,12 @@ struct platform_intrinsics<int64x2_t>
         return vreinterpretq_s64_u8(vcltq_s8(vreinterpretq_s8_s64(a), vreinterpretq_s8_s64(b)));
     }
 
+    // Compares the 4 unsigned 32-bit integers in a and b for lesser than.
+    static inline m128i compare_less_epu32(m128i a, m128i b) noexcept
+    {
+        return vreinterpretq_s64_u32(vcltq_u32(vreinterpretq_u32_s64(a), vreinterpretq_u32_s64(b)));
+    }
+
     static inline int movemask_epi8(m128i a)
     {
         // Use increasingly wide shifts+adds to collect the sign bits
@@ -229,6 +389,16 @@ struct platform_intrinsics<int64x2_t>
         // Note: Little endian would return the correct value 4b (01001011) instead.
         return vgetq_lane_u8(paired64, 0) | ((int) vgetq_lane_u8(paired64, 8) << 8);
     }
+
+    // Tests if any bit in a is set.
+    static inline bool any(m128i a) noexcept { return vmaxvq_u32(vreinterpretq_u32_s64(a)) != 0; }
+
+    // Cheaper alternative to movemask_epi8() for byte masks (each byte being either 0x00 or 0xFF),
+    // returning 4 bits per byte. Use countTrailingZeroBits(result) / 4 to get the first matching byte.
+    static inline uint64_t movemask_nibbles(m128i a) noexcept
+    {
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_s64(a), 4)), 0);
+    }
 };
 
 using intrinsics = platform_intrinsics<int64x2_t>;
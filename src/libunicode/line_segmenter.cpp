@@ -0,0 +1,653 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/line_segmenter.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+using std::string_view;
+
+namespace unicode
+{
+
+namespace
+{
+    // Line breaking classes, as resolved by LB1 from the Line_Break property.
+    enum class Class : uint8_t
+    {
+        Sot, // start of text, only preceding a potential line break
+        BK,
+        CR,
+        LF,
+        NL,
+        SP,
+        ZW,
+        CM,
+        ZWJ,
+        WJ,
+        GL,
+        BA,
+        BB,
+        B2,
+        HY,
+        CB,
+        CL,
+        CP,
+        EX,
+        IN,
+        NS,
+        OP,
+        QU,
+        IS,
+        NU,
+        PO,
+        PR,
+        SY,
+        AL,
+        HL,
+        ID,
+        EB,
+        EM,
+        H2,
+        H3,
+        JL,
+        JV,
+        JT,
+        RI,
+
+        // Subsets of the above classes that some rules single out.
+        OPWide,         // OP with East_Asian_Width F, W or H (LB30)
+        CPWide,         // CP with East_Asian_Width F, W or H (LB30)
+        IDPictographic, // ID with Extended_Pictographic and General_Category Cn (LB30b)
+        HYAfterHL,      // HY after HL, only preceding a potential line break (LB21a)
+        BAAfterHL,      // BA after HL, only preceding a potential line break (LB21a)
+        RIOdd,          // RI after an odd number of RI, only preceding a potential line break (LB30a)
+    };
+
+    constexpr size_t ClassCount = static_cast<size_t>(Class::RIOdd) + 1;
+
+    // What is between the class preceding a potential line break and the codepoint following it.
+    enum class Mode : uint8_t
+    {
+        Plain,  // nothing
+        Spaces, // one or more SP (LB7, LB14 to LB18)
+        Zwj,    // a ZWJ (LB8a), that LB9 has attached to the preceding class
+    };
+
+    // The context is made up of the class preceding a potential line break (lower bits) and the mode.
+    constexpr size_t ModeShift = 6;                            // NOLINT(readability-identifier-naming)
+    constexpr size_t ContextCount = size_t { 3 } << ModeShift; // NOLINT(readability-identifier-naming)
+
+    static_assert(ClassCount <= (size_t { 1 } << ModeShift));
+
+    constexpr Class base_class(Class value)
+    {
+        switch (value)
+        {
+            case Class::OPWide: return Class::OP;
+            case Class::CPWide: return Class::CP;
+            case Class::IDPictographic: return Class::ID;
+            case Class::HYAfterHL: return Class::HY;
+            case Class::BAAfterHL: return Class::BA;
+            case Class::RIOdd: return Class::RI;
+            default: return value;
+        }
+    }
+
+    /// LB1: Resolves the Line_Break property value @p lb of a codepoint with the given break_properties
+    /// @p flags into its line breaking class.
+    constexpr Class resolve(Line_Break lb, uint8_t flags)
+    {
+        using LB = Line_Break;
+
+        auto const wide = (flags & break_properties::FlagEastAsianWide) != 0;
+        switch (lb)
+        {
+            case LB::Alphabetic:
+            case LB::Ambiguous:
+            case LB::Surrogate:
+            case LB::Unknown: return Class::AL;
+            case LB::Break_After: return Class::BA;
+            case LB::Break_Before: return Class::BB;
+            case LB::Break_Both: return Class::B2;
+            case LB::Break_Symbols: return Class::SY;
+            case LB::Carriage_Return: return Class::CR;
+            case LB::Close_Parenthesis: return wide ? Class::CPWide : Class::CP;
+            case LB::Close_Punctuation: return Class::CL;
+            case LB::Combining_Mark: return Class::CM;
+            case LB::Complex_Context: return (flags & break_properties::FlagMark) ? Class::CM : Class::AL;
+            case LB::Conditional_Japanese_Starter: return Class::NS;
+            case LB::Contingent_Break: return Class::CB;
+            case LB::E_Base: return Class::EB;
+            case LB::E_Modifier: return Class::EM;
+            case LB::Exclamation: return Class::EX;
+            case LB::Glue: return Class::GL;
+            case LB::H2: return Class::H2;
+            case LB::H3: return Class::H3;
+            case LB::Hebrew_Letter: return Class::HL;
+            case LB::Hyphen: return Class::HY;
+            case LB::Ideographic: {
+                auto constexpr Pictographic =
+                    break_properties::FlagExtendedPictographic | break_properties::FlagUnassigned;
+                return (flags & Pictographic) == Pictographic ? Class::IDPictographic : Class::ID;
+            }
+            case LB::Infix_Numeric: return Class::IS;
+            case LB::Inseparable: return Class::IN;
+            case LB::JL: return Class::JL;
+            case LB::JT: return Class::JT;
+            case LB::JV: return Class::JV;
+            case LB::Line_Feed: return Class::LF;
+            case LB::Mandatory_Break: return Class::BK;
+            case LB::Next_Line: return Class::NL;
+            case LB::Nonstarter: return Class::NS;
+            case LB::Numeric: return Class::NU;
+            case LB::Open_Punctuation: return wide ? Class::OPWide : Class::OP;
+            case LB::Postfix_Numeric: return Class::PO;
+            case LB::Prefix_Numeric: return Class::PR;
+            case LB::Quotation: return Class::QU;
+            case LB::Regional_Indicator: return Class::RI;
+            case LB::Space: return Class::SP;
+            case LB::Word_Joiner: return Class::WJ;
+            case LB::ZWJ: return Class::ZWJ;
+            case LB::ZWSpace: return Class::ZW;
+        }
+        return Class::AL;
+    }
+
+    // Only the lower bits of break_properties::flags are relevant to line breaking.
+    constexpr size_t FlagsCount = 16; // NOLINT(readability-identifier-naming)
+    constexpr size_t LineBreakCount = static_cast<size_t>(Line_Break::ZWSpace) + 1;
+
+    using class_table = std::array<Class, LineBreakCount * FlagsCount>;
+
+    constexpr class_table make_class_table()
+    {
+        auto table = class_table {};
+        for (size_t lb = 0; lb < LineBreakCount; ++lb)
+            for (size_t flags = 0; flags < FlagsCount; ++flags)
+                table[lb * FlagsCount + flags] =
+                    resolve(static_cast<Line_Break>(lb), static_cast<uint8_t>(flags));
+        return table;
+    }
+
+    constexpr class_table Classes = make_class_table(); // NOLINT(readability-identifier-naming)
+
+    constexpr Class class_of(break_properties properties) noexcept
+    {
+        auto const lb = static_cast<size_t>(properties.line_break);
+        return Classes[lb * FlagsCount + (properties.flags % FlagsCount)];
+    }
+
+    constexpr bool is_one_of(Class value, std::initializer_list<Class> set)
+    {
+        return std::find(set.begin(), set.end(), value) != set.end();
+    }
+
+    /// Implements the rules LB11 to LB18 for the class @p A and the class @p B following it after spaces.
+    constexpr bool prohibited_after_spaces(Class A, Class B)
+    {
+        using C = Class;
+
+        auto const a = base_class(A);
+        auto const b = base_class(B);
+
+        // LB11: Do not break before Word Joiner.
+        if (b == C::WJ)
+            return true;
+
+        // LB13: Do not break before ‘]’ or ‘!’ or ‘;’ or ‘/’, even after spaces.
+        if (is_one_of(b, { C::CL, C::CP, C::EX, C::IS, C::SY }))
+            return true;
+
+        // LB14: Do not break after ‘[’, even after spaces.
+        if (a == C::OP)
+            return true;
+
+        // LB15: Do not break within ‘”[’, even with intervening spaces.
+        if (a == C::QU && b == C::OP)
+            return true;
+
+        // LB16: Do not break between closing punctuation and a nonstarter, even with intervening spaces.
+        if (is_one_of(a, { C::CL, C::CP }) && b == C::NS)
+            return true;
+
+        // LB17: Do not break within ‘——’, even with intervening spaces.
+        if (a == C::B2 && b == C::B2)
+            return true;
+
+        // LB18: Break after spaces.
+        return false;
+    }
+
+    /// Implements the rules LB11 to LB31 for the class @p A directly followed by the class @p B.
+    constexpr bool prohibited(Class A, Class B)
+    {
+        using C = Class;
+
+        auto const a = base_class(A);
+        auto const b = base_class(B);
+
+        // LB11: Do not break before or after Word Joiner.
+        if (a == C::WJ || b == C::WJ)
+            return true;
+
+        // LB12: Do not break after NBSP and related characters.
+        if (a == C::GL)
+            return true;
+
+        // LB12a: Do not break before NBSP and related characters, except after spaces and hyphens.
+        if (b == C::GL && !is_one_of(a, { C::BA, C::HY }))
+            return true;
+
+        // LB13: Do not break before ‘]’ or ‘!’ or ‘;’ or ‘/’.
+        if (is_one_of(b, { C::CL, C::CP, C::EX, C::IS, C::SY }))
+            return true;
+
+        // LB14: Do not break after ‘[’.
+        if (a == C::OP)
+            return true;
+
+        // LB15: Do not break within ‘”[’.
+        if (a == C::QU && b == C::OP)
+            return true;
+
+        // LB16: Do not break between closing punctuation and a nonstarter.
+        if (is_one_of(a, { C::CL, C::CP }) && b == C::NS)
+            return true;
+
+        // LB17: Do not break within ‘——’.
+        if (a == C::B2 && b == C::B2)
+            return true;
+
+        // LB19: Do not break before or after quotation marks.
+        if (a == C::QU || b == C::QU)
+            return true;
+
+        // LB20: Break before and after unresolved CB.
+        if (a == C::CB || b == C::CB)
+            return false;
+
+        // LB21: Do not break before hyphen-minus, other hyphens, fixed-width spaces,
+        // small kana, and other non-starters, or after acute accents.
+        if (is_one_of(b, { C::BA, C::HY, C::NS }) || a == C::BB)
+            return true;
+
+        // LB21a: Don't break after Hebrew + Hyphen.
+        if (A == C::HYAfterHL || A == C::BAAfterHL)
+            return true;
+
+        // LB21b: Don’t break between Solidus and Hebrew letters.
+        if (a == C::SY && b == C::HL)
+            return true;
+
+        // LB22: Do not break before ellipses.
+        if (b == C::IN)
+            return true;
+
+        // LB23: Do not break between digits and letters.
+        if ((is_one_of(a, { C::AL, C::HL }) && b == C::NU) || (a == C::NU && is_one_of(b, { C::AL, C::HL })))
+            return true;
+
+        // LB23a: Do not break between numeric prefixes and ideographs,
+        // or between ideographs and numeric postfixes.
+        if ((a == C::PR && is_one_of(b, { C::ID, C::EB, C::EM }))
+            || (is_one_of(a, { C::ID, C::EB, C::EM }) && b == C::PO))
+            return true;
+
+        // LB24: Do not break between numeric prefix/postfix and letters,
+        // or between letters and prefix/postfix.
+        if ((is_one_of(a, { C::PR, C::PO }) && is_one_of(b, { C::AL, C::HL }))
+            || (is_one_of(a, { C::AL, C::HL }) && is_one_of(b, { C::PR, C::PO })))
+            return true;
+
+        // LB25: Do not break between the following pairs of classes relevant to numbers.
+        if ((is_one_of(a, { C::CL, C::CP, C::NU }) && is_one_of(b, { C::PO, C::PR }))
+            || (is_one_of(a, { C::PO, C::PR }) && is_one_of(b, { C::OP, C::NU }))
+            || (is_one_of(a, { C::HY, C::IS, C::NU, C::SY }) && b == C::NU))
+            return true;
+
+        // LB26: Do not break a Korean syllable.
+        if ((a == C::JL && is_one_of(b, { C::JL, C::JV, C::H2, C::H3 }))
+            || (is_one_of(a, { C::JV, C::H2 }) && is_one_of(b, { C::JV, C::JT }))
+            || (is_one_of(a, { C::JT, C::H3 }) && b == C::JT))
+            return true;
+
+        // LB27: Treat a Korean Syllable Block the same as ID.
+        if ((is_one_of(a, { C::JL, C::JV, C::JT, C::H2, C::H3 }) && b == C::PO)
+            || (a == C::PR && is_one_of(b, { C::JL, C::JV, C::JT, C::H2, C::H3 })))
+            return true;
+
+        // LB28: Do not break between alphabetics (“at”).
+        if (is_one_of(a, { C::AL, C::HL }) && is_one_of(b, { C::AL, C::HL }))
+            return true;
+
+        // LB29: Do not break between numeric punctuation and alphabetics (“e.g.”).
+        if (a == C::IS && is_one_of(b, { C::AL, C::HL }))
+            return true;
+
+        // LB30: Do not break between letters, numbers, or ordinary symbols and opening
+        // or closing parentheses, except for East Asian parentheses.
+        if ((is_one_of(a, { C::AL, C::HL, C::NU }) && B == C::OP)
+            || (A == C::CP && is_one_of(b, { C::AL, C::HL, C::NU })))
+            return true;
+
+        // LB30a: Break between two regional indicator symbols if and only if there are an even number
+        // of regional indicators preceding the position of the break.
+        if (A == C::RIOdd && b == C::RI)
+            return true;
+
+        // LB30b: Do not break between an emoji base (or potential emoji) and an emoji modifier.
+        if ((a == C::EB || A == C::IDPictographic) && b == C::EM)
+            return true;
+
+        // LB31: Break everywhere else.
+        return false;
+    }
+
+    struct transition
+    {
+        line_break_opportunity opportunity;
+        Class next;
+        Mode mode = Mode::Plain;
+    };
+
+    /// Returns the context at the start of a line with the class @p B.
+    constexpr transition enter(line_break_opportunity opportunity, Class B)
+    {
+        switch (B)
+        {
+            case Class::SP: return { opportunity, Class::Sot, Mode::Spaces };
+            case Class::CM: return { opportunity, Class::AL };             // LB10
+            case Class::ZWJ: return { opportunity, Class::AL, Mode::Zwj }; // LB10
+            case Class::RI: return { opportunity, Class::RIOdd };
+            default: return { opportunity, B };
+        }
+    }
+
+    /// Implements the rules LB2 to LB31 for the class @p A before a potential line break, what is between
+    /// them (@p mode), and the class @p B of the codepoint following it.
+    constexpr transition make_transition(Class A, Mode mode, Class B)
+    {
+        using C = Class;
+        using O = line_break_opportunity;
+
+        // LB2: Never break at the start of text.
+        if (A == C::Sot && mode == Mode::Plain)
+            return enter(O::None, B);
+
+        if (mode == Mode::Plain)
+        {
+            // LB4: Always break after hard line breaks.
+            if (A == C::BK)
+                return enter(O::Mandatory, B);
+
+            // LB5: Treat CR followed by LF, as well as CR, LF, and NL as hard line breaks.
+            if (A == C::CR && B == C::LF)
+                return { O::None, C::LF };
+            if (is_one_of(A, { C::CR, C::LF, C::NL }))
+                return enter(O::Mandatory, B);
+        }
+
+        // LB6: Do not break before hard line breaks.
+        if (is_one_of(B, { C::BK, C::CR, C::LF, C::NL }))
+            return { O::None, B };
+
+        // LB7: Do not break before spaces or zero width space.
+        if (B == C::SP)
+            return { O::None, A, Mode::Spaces };
+        if (B == C::ZW)
+            return { O::None, C::ZW };
+
+        // LB8: Break before any character following a zero-width space, even if one or more spaces intervene.
+        if (A == C::ZW)
+            return enter(O::Allowed, B);
+
+        // LB8a: Do not break after a zero width joiner.
+        if (mode == Mode::Zwj)
+        {
+            auto result = make_transition(A, Mode::Plain, B);
+            result.opportunity = O::None;
+            return result;
+        }
+
+        // LB9: Do not break a combining character sequence; treat it as if it has the line breaking class
+        // of the base character in all of the following rules. Treat ZWJ as if it were CM.
+        if (mode == Mode::Plain && is_one_of(B, { C::CM, C::ZWJ }))
+            return { O::None, A, B == C::ZWJ ? Mode::Zwj : Mode::Plain };
+
+        // LB10: Treat any remaining combining mark or ZWJ as AL.
+        auto const b = is_one_of(B, { C::CM, C::ZWJ }) ? C::AL : B;
+        auto const nextMode = B == C::ZWJ ? Mode::Zwj : Mode::Plain;
+
+        if (mode == Mode::Spaces)
+        {
+            if (prohibited_after_spaces(A, b))
+                return { O::None, b == C::RI ? C::RIOdd : b, nextMode };
+            auto result = enter(O::Allowed, b);
+            result.mode = nextMode;
+            return result;
+        }
+
+        if (!prohibited(A, b))
+        {
+            auto result = enter(O::Allowed, b);
+            result.mode = nextMode;
+            return result;
+        }
+
+        // Keep track of the classes that LB21a and LB30a look at.
+        auto next = b;
+        if (A == C::HL && b == C::HY)
+            next = C::HYAfterHL;
+        else if (A == C::HL && b == C::BA)
+            next = C::BAAfterHL;
+        else if (b == C::RI)
+            next = A == C::RIOdd ? C::RI : C::RIOdd;
+
+        return { O::None, next, nextMode };
+    }
+
+    /// Each transition holds the line break opportunity (upper bits) and the next context (lower 8 bits).
+    using transition_table = std::array<std::array<uint16_t, size_t { 1 } << ModeShift>, ContextCount>;
+
+    /// Transitions by context, that is, the class preceding a potential line break and what is between it
+    /// and the potential line break, and by the class of the codepoint following it.
+    constexpr transition_table make_transition_table()
+    {
+        auto table = transition_table {};
+        for (size_t context = 0; context < ContextCount; ++context)
+        {
+            auto const A = static_cast<Class>(context % (size_t { 1 } << ModeShift));
+            auto const mode = static_cast<Mode>(context >> ModeShift);
+            for (size_t b = 0; b < ClassCount && static_cast<size_t>(A) < ClassCount; ++b)
+            {
+                auto const t = make_transition(A, mode, static_cast<Class>(b));
+                auto const next = static_cast<size_t>(t.next) | (static_cast<size_t>(t.mode) << ModeShift);
+                table[context][b] = static_cast<uint16_t>(next | (static_cast<size_t>(t.opportunity) << 8));
+            }
+        }
+        return table;
+    }
+
+    constexpr transition_table Transitions = make_transition_table(); // NOLINT(readability-identifier-naming)
+
+    /// Advances @p context by the next codepoint of class @p next.
+    inline line_break_opportunity step(uint8_t& context, Class next) noexcept
+    {
+        auto const transition = Transitions[context][static_cast<size_t>(next)];
+        context = static_cast<uint8_t>(transition);
+        return static_cast<line_break_opportunity>(transition >> 8);
+    }
+
+    inline Class class_of(break_properties::tables_view const& tables, char32_t codepoint) noexcept
+    {
+        return class_of(tables.get(codepoint));
+    }
+
+    struct decoded
+    {
+        char32_t codepoint;
+        size_t length;
+    };
+
+    constexpr char32_t ReplacementCharacter = 0xFFFD; // NOLINT(readability-identifier-naming)
+
+    constexpr decoded decode_utf8(string_view text) noexcept
+    {
+        auto const sequence = decode_utf8_sequence(text);
+        if (sequence.status != ConversionStatus::Success)
+            return { ReplacementCharacter, sequence.length };
+        return { sequence.value, sequence.length };
+    }
+
+    /// Runs the line breaking rules over the codepoints @p decode yields as (codepoint, length
+    /// in code units), until the first line break opportunity after the start of the text
+    /// of @p size code units.
+    template <typename Decoder>
+    line_break_position run(size_t size, Decoder decode) noexcept
+    {
+        auto const tables = break_properties::configured_tables();
+        auto context = uint8_t { 0 };
+        auto offset = size_t { 0 };
+        while (offset < size)
+        {
+            auto const [codepoint, length] = decode(offset);
+            if (auto const opportunity = step(context, class_of(tables, codepoint));
+                opportunity != line_break_opportunity::None)
+                return { offset, opportunity };
+            offset += length;
+        }
+        return { size, line_break_opportunity::Mandatory };
+    }
+
+    /// Fills a line_break_buffer with the line break opportunities before the grapheme clusters received.
+    class line_break_buffer_receiver
+    {
+      public:
+        line_break_buffer_receiver(line_break_buffer& buffer,
+                                   line_segmenter_state& state,
+                                   char const* base) noexcept:
+            _buffer { buffer },
+            _state { state },
+            _base { base },
+            _tables { break_properties::configured_tables() }
+        {
+        }
+
+        [[nodiscard]] size_t remaining() const noexcept { return _buffer.capacity - _buffer.size; }
+
+        void receiveAsciiSequence(string_view sequence) noexcept
+        {
+            // ASCII codepoints are always in the direct (flat) table.
+            static_assert(break_properties::tables_view::direct_size >= 0x80);
+            auto const* direct = _tables.direct;
+            auto const offset = static_cast<size_t>(sequence.data() - _base);
+            auto context = _state.context;
+            for (size_t i = 0; i < sequence.size(); ++i)
+            {
+                // Letters following letters (LB28) dominate most text. Testing for them up front
+                // lets the next iteration start without waiting for the transition table lookup.
+                auto const next = class_of(direct[static_cast<uint8_t>(sequence[i])]);
+                if (next == Class::AL && context == static_cast<uint8_t>(Class::AL))
+                    continue;
+                push(offset + i, _columns + i, step(context, next));
+            }
+            _state.context = context;
+            _columns += sequence.size();
+        }
+
+        void receiveGraphemeCluster(string_view cluster, size_t columnCount) noexcept
+        {
+            auto const offset = static_cast<size_t>(cluster.data() - _base);
+            auto const [codepoint, length] = decode_utf8(cluster);
+            push(offset, _columns, step(_state.context, class_of(_tables, codepoint)));
+
+            // Line break opportunities within grapheme clusters are not reported.
+            for (auto i = length; i < cluster.size();)
+            {
+                auto const next = decode_utf8(cluster.substr(i));
+                (void) step(_state.context, class_of(_tables, next.codepoint));
+                i += next.length;
+            }
+            _columns += columnCount;
+        }
+
+        void receiveInvalidGraphemeCluster(string_view sequence) noexcept
+        {
+            auto const offset = static_cast<size_t>(sequence.data() - _base);
+            auto const next = class_of(_tables, ReplacementCharacter);
+            push(offset, _columns, step(_state.context, next));
+            ++_columns;
+        }
+
+      private:
+        void push(size_t offset, size_t columns, line_break_opportunity opportunity) noexcept
+        {
+            if (opportunity == line_break_opportunity::None)
+                return;
+            assert(_buffer.size < _buffer.capacity);
+            _buffer.offsets[_buffer.size] = offset;
+            _buffer.columns[_buffer.size] = columns;
+            _buffer.mandatory[_buffer.size] = opportunity == line_break_opportunity::Mandatory;
+            ++_buffer.size;
+        }
+
+        line_break_buffer& _buffer;
+        line_segmenter_state& _state;
+        char const* _base;
+        break_properties::tables_view _tables; // as configured when starting to segment
+        size_t _columns = 0;
+    };
+} // namespace
+
+line_break_opportunity line_break_process(char32_t nextCodepoint, line_segmenter_state& state) noexcept
+{
+    return step(state.context, class_of(break_properties::configured_tables(), nextCodepoint));
+}
+
+line_break_opportunity line_break_process(break_properties nextProperties,
+                                          line_segmenter_state& state) noexcept
+{
+    return step(state.context, class_of(nextProperties));
+}
+
+line_break_position next_line_break(std::u32string_view text) noexcept
+{
+    return run(text.size(), [text](size_t offset) noexcept { return decoded { text[offset], 1 }; });
+}
+
+line_break_position next_line_break(string_view text) noexcept
+{
+    return run(text.size(), [text](size_t offset) noexcept { return decode_utf8(text.substr(offset)); });
+}
+
+scan_result scan_text(scan_state& state,
+                      line_segmenter_state& lineState,
+                      string_view text,
+                      size_t maxColumnCount,
+                      line_break_buffer& buffer) noexcept
+{
+    // Offsets are relative to the start of the result, which includes a resumed UTF-8 sequence.
+    auto const base = state.utf8.expectedLength ? text.data() - state.utf8.currentLength : text.data();
+    auto receiver = line_break_buffer_receiver { buffer, lineState, base };
+    buffer.size = 0;
+    return scan_text(state, text, maxColumnCount, receiver);
+}
+
+} // namespace unicode
@@ -0,0 +1,179 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/scan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace unicode
+{
+
+/// Whether a line may or must be broken before a codepoint, as per UAX #14.
+enum class line_break_opportunity : uint8_t
+{
+    None,
+    Allowed,
+    Mandatory,
+};
+
+/// Holds the state line breaking needs to carry forward from one codepoint to the next,
+/// that is, the line breaking context after the last processed codepoint.
+///
+/// A default constructed state is at the start of the text, where no line is broken.
+struct line_segmenter_state
+{
+    uint8_t context = 0;
+};
+
+/// Processes the next codepoint of the text.
+///
+/// @returns whether a line may or must be broken before @p nextCodepoint, as per the line breaking
+///          rules LB2 to LB31 of UAX #14 (without tailoring).
+[[nodiscard]] line_break_opportunity line_break_process(char32_t nextCodepoint,
+                                                        line_segmenter_state& state) noexcept;
+
+/// Same as above, but with the already looked up break properties of the next codepoint.
+[[nodiscard]] line_break_opportunity line_break_process(break_properties nextProperties,
+                                                        line_segmenter_state& state) noexcept;
+
+/// Holds a line break opportunity as found by next_line_break().
+struct line_break_position
+{
+    /// Offset of the line break opportunity in code units.
+    size_t offset;
+
+    /// Whether the line may or must be broken at @c offset.
+    /// A line must always be broken at the end of the text (LB3).
+    line_break_opportunity opportunity;
+};
+
+/// Returns the first line break opportunity in @p text after its start.
+[[nodiscard]] line_break_position next_line_break(std::u32string_view text) noexcept;
+
+/// Same as above but for UTF-8 text, with the offset in bytes.
+///
+/// Ill-formed UTF-8 sequences are treated as U+FFFD REPLACEMENT CHARACTER.
+[[nodiscard]] line_break_position next_line_break(std::string_view text) noexcept;
+
+/// Segments UTF-8 text at its line break opportunities, as per UAX #14, without copying,
+/// i.e. yielding views into the given text, each of which ends at a line break opportunity.
+struct utf8_line_segmenter
+{
+    class iterator;
+
+    explicit utf8_line_segmenter(std::string_view text) noexcept: _text { text } {}
+
+    [[nodiscard]] iterator begin() const noexcept;
+    [[nodiscard]] iterator end() const noexcept;
+
+  private:
+    std::string_view _text;
+};
+
+class utf8_line_segmenter::iterator
+{
+  public:
+    using value_type = std::string_view;
+
+    iterator(char const* data, char const* end) noexcept: _end { end } { next(data); }
+
+    value_type const& operator*() const noexcept { return _segment; }
+    value_type const* operator->() const noexcept { return &_segment; }
+
+    /// Whether the line may or must be broken after the current segment.
+    [[nodiscard]] line_break_opportunity opportunity() const noexcept { return _opportunity; }
+
+    iterator& operator++() noexcept
+    {
+        next(_segment.data() + _segment.size());
+        return *this;
+    }
+
+    iterator operator++(int) noexcept
+    {
+        auto tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(iterator const& other) const noexcept { return _segment.data() == other._segment.data(); }
+    bool operator!=(iterator const& other) const noexcept { return !(*this == other); }
+
+  private:
+    void next(char const* data) noexcept
+    {
+        auto const position = next_line_break(value_type(data, static_cast<size_t>(_end - data)));
+        _segment = value_type(data, position.offset);
+        _opportunity = position.opportunity;
+    }
+
+    value_type _segment;
+    line_break_opportunity _opportunity = line_break_opportunity::Mandatory;
+    char const* _end;
+};
+
+inline utf8_line_segmenter::iterator utf8_line_segmenter::begin() const noexcept
+{
+    return iterator { _text.data(), _text.data() + _text.size() };
+}
+
+inline utf8_line_segmenter::iterator utf8_line_segmenter::end() const noexcept
+{
+    return iterator { _text.data() + _text.size(), _text.data() + _text.size() };
+}
+
+/// Caller provided structure-of-arrays buffer to be filled with line break opportunities by scan_text().
+///
+/// Each array must be able to hold @c capacity elements.
+struct line_break_buffer
+{
+    /// Byte offsets of the line break opportunities before scanned grapheme clusters,
+    /// relative to scan_result::start.
+    size_t* offsets = nullptr;
+
+    /// Number of columns scanned before each line break opportunity, that is,
+    /// the width of the line up to it, if the line started at scan_result::start.
+    size_t* columns = nullptr;
+
+    /// Whether or not the line must be broken at the line break opportunity.
+    bool* mandatory = nullptr;
+
+    /// Number of elements each of the arrays can hold.
+    size_t capacity = 0;
+
+    /// Number of line break opportunities filled in by the last call to scan_text().
+    size_t size = 0;
+};
+
+/// Same as scan_text() with a grapheme_cluster_buffer, but filling @p buffer with the line break
+/// opportunities before the scanned grapheme clusters, as per UAX #14, and their column positions,
+/// such that text can be reflowed in a single pass.
+///
+/// Line break opportunities within grapheme clusters are not reported.
+/// The line breaking state is carried forward in @p lineState from one call to the next,
+/// like the grapheme segmentation state in @p state.
+///
+/// Scanning additionally stops when the buffer cannot take the line break opportunity
+/// of another grapheme cluster.
+scan_result scan_text(scan_state& state,
+                      line_segmenter_state& lineState,
+                      std::string_view text,
+                      size_t maxColumnCount,
+                      line_break_buffer& buffer) noexcept;
+
+} // namespace unicode
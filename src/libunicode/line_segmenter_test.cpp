@@ -0,0 +1,205 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/line_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace unicode;
+using namespace std::string_literals;
+using namespace std;
+
+namespace
+{
+
+auto segments(u32string_view text)
+{
+    auto const utf8 = convert_to<char>(text);
+    auto result = vector<u32string> {};
+    for (auto const segment: utf8_line_segmenter(utf8))
+        result.emplace_back(convert_to<char32_t>(segment));
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("line_segmenter.spaces", "[line_segmenter]")
+{
+    // LB7, LB18: Break after spaces.
+    CHECK(segments(U"Hello  world") == vector<u32string> { U"Hello  ", U"world" });
+    CHECK(segments(U"  a") == vector<u32string> { U"  ", U"a" });
+
+    // LB13, LB14, LB17: Do not break before closing punctuation or after opening punctuation,
+    // and within '——', even after spaces.
+    CHECK(segments(U"a  ) b") == vector<u32string> { U"a  ) ", U"b" });
+    CHECK(segments(U"(  a") == vector<u32string> { U"(  a" });
+    CHECK(segments(U"\u2014 \u2014") == vector<u32string> { U"\u2014 \u2014" });
+}
+
+TEST_CASE("line_segmenter.hard_line_breaks", "[line_segmenter]")
+{
+    auto const text = "a\r\nb\u2028c\u0085d"s;
+    auto segmenter = utf8_line_segmenter(text);
+    auto i = segmenter.begin();
+    CHECK(*i == "a\r\n");
+    CHECK(i.opportunity() == line_break_opportunity::Mandatory);
+    ++i;
+    CHECK(*i == "b\u2028");
+    CHECK(i.opportunity() == line_break_opportunity::Mandatory);
+    ++i;
+    CHECK(*i == "c\u0085");
+    ++i;
+    CHECK(*i == "d");
+    CHECK(i.opportunity() == line_break_opportunity::Mandatory); // LB3
+    ++i;
+    CHECK(i == segmenter.end());
+}
+
+TEST_CASE("line_segmenter.glue", "[line_segmenter]")
+{
+    // LB8, LB11, LB12: zero width space, word joiner and no-break space.
+    CHECK(segments(U"a\u200Bb") == vector<u32string> { U"a\u200B", U"b" });
+    CHECK(segments(U"a\u200B b") == vector<u32string> { U"a\u200B ", U"b" });
+    CHECK(segments(U"a \u2060b") == vector<u32string> { U"a \u2060b" });
+    CHECK(segments(U"a\u00A0b") == vector<u32string> { U"a\u00A0b" });
+
+    // LB9, LB10: Combining marks stick to their base, unless following spaces.
+    CHECK(segments(U"a\u0301b") == vector<u32string> { U"a\u0301b" });
+    CHECK(segments(U"\u4E00\u0301\u4E01") == vector<u32string> { U"\u4E00\u0301", U"\u4E01" });
+
+    // LB8a: Do not break after a zero width joiner.
+    CHECK(segments(U"\u4E00\u200D\u4E01") == vector<u32string> { U"\u4E00\u200D\u4E01" });
+}
+
+TEST_CASE("line_segmenter.punctuation_and_numbers", "[line_segmenter]")
+{
+    // LB21: Break after hyphens, but not before, LB21a: except after Hebrew + Hyphen.
+    CHECK(segments(U"can't-stop now") == vector<u32string> { U"can't-", U"stop ", U"now" });
+    CHECK(segments(U"\u05D0-a") == vector<u32string> { U"\u05D0-a" });
+
+    // LB25: Do not break numbers.
+    CHECK(segments(U"$(12.50), 100%") == vector<u32string> { U"$(12.50), ", U"100%" });
+
+    // LB30: Do not break between letters and parentheses, except for East Asian ones.
+    CHECK(segments(U"a(b)c") == vector<u32string> { U"a(b)c" });
+    CHECK(segments(U"a\u3008b") == vector<u32string> { U"a", U"\u3008b" });
+}
+
+TEST_CASE("line_segmenter.ideographs", "[line_segmenter]")
+{
+    // LB31: Break between ideographs, LB13, LB21: but not before closing punctuation or nonstarters.
+    CHECK(segments(U"\u4E00\u4E01\u3001\u3041") == vector<u32string> { U"\u4E00", U"\u4E01\u3001\u3041" });
+
+    // LB26: Do not break Korean syllables.
+    CHECK(segments(U"\u1100\u1161\u11A8\uAC00\uAC00")
+          == vector<u32string> { U"\u1100\u1161\u11A8", U"\uAC00", U"\uAC00" });
+}
+
+TEST_CASE("line_segmenter.emoji", "[line_segmenter]")
+{
+    // LB30a: regional indicator pairs, LB30b: emoji modifiers.
+    CHECK(segments(U"\U0001F1E6\U0001F1E7\U0001F1E8")
+          == vector<u32string> { U"\U0001F1E6\U0001F1E7", U"\U0001F1E8" });
+    CHECK(segments(U"\u261D\U0001F3FB\u4E00\U0001F3FB")
+          == vector<u32string> { U"\u261D\U0001F3FB", U"\u4E00", U"\U0001F3FB" });
+}
+
+TEST_CASE("line_segmenter.next_line_break", "[line_segmenter]")
+{
+    CHECK(next_line_break(U""sv).offset == 0);
+    CHECK(next_line_break(U""sv).opportunity == line_break_opportunity::Mandatory);
+
+    auto const position = next_line_break(U"ab cd"sv);
+    CHECK(position.offset == 3);
+    CHECK(position.opportunity == line_break_opportunity::Allowed);
+
+    // Ill-formed UTF-8 is treated as U+FFFD.
+    CHECK(next_line_break("a\xFF b"sv).offset == 3);
+}
+
+TEST_CASE("line_segmenter.stream", "[line_segmenter]")
+{
+    // Restarting at each line break opportunity yields the same as processing the text in one go.
+    auto const text = U"(a)  b\u200B  \u05D0-\u2014 \u2014\u4E00\u200D\u0301\U0001F1E6\U0001F1E7\U0001F1E8"
+                      U"$1.5%\r\n\u3008x\u3009 \u261D\U0001F3FB \u0E01\u0E01\u00A0- \u2060z"s;
+
+    auto expected = vector<size_t> {};
+    auto state = line_segmenter_state {};
+    for (size_t i = 0; i < text.size(); ++i)
+        if (line_break_process(text[i], state) != line_break_opportunity::None)
+            expected.push_back(i);
+    expected.push_back(text.size());
+
+    auto actual = vector<size_t> {};
+    for (size_t offset = 0; offset < text.size();)
+    {
+        offset += next_line_break(u32string_view(text).substr(offset)).offset;
+        actual.push_back(offset);
+    }
+    CHECK(actual == expected);
+}
+
+TEST_CASE("line_segmenter.scan_text", "[line_segmenter]")
+{
+    auto const text = "Hello world, \u4E00\u4E01 ok"sv;
+
+    auto offsets = array<size_t, 16> {};
+    auto columns = array<size_t, 16> {};
+    auto mandatory = array<bool, 16> {};
+    auto buffer = line_break_buffer { offsets.data(), columns.data(), mandatory.data(), offsets.size() };
+
+    auto state = scan_state {};
+    auto lineState = line_segmenter_state {};
+    auto const result = scan_text(state, lineState, text, 80, buffer);
+    CHECK(result.count == 20);
+    REQUIRE(buffer.size == 4);
+    CHECK(vector<size_t>(offsets.begin(), offsets.begin() + 4) == vector<size_t> { 6, 13, 16, 20 });
+    CHECK(vector<size_t>(columns.begin(), columns.begin() + 4) == vector<size_t> { 6, 13, 15, 18 });
+    CHECK(!mandatory[0]);
+}
+
+TEST_CASE("line_segmenter.scan_text.resume", "[line_segmenter]")
+{
+    // The line breaking state is carried over from one call to the next.
+    auto offsets = array<size_t, 16> {};
+    auto columns = array<size_t, 16> {};
+    auto mandatory = array<bool, 16> {};
+    auto buffer = line_break_buffer { offsets.data(), columns.data(), mandatory.data(), offsets.size() };
+
+    auto state = scan_state {};
+    auto lineState = line_segmenter_state {};
+    (void) scan_text(state, lineState, "\u05D0-"sv, 80, buffer);
+    CHECK(buffer.size == 0);
+    (void) scan_text(state, lineState, "a b-"sv, 80, buffer);
+    REQUIRE(buffer.size == 1);
+    CHECK(offsets[0] == 2);
+    CHECK(columns[0] == 2);
+    (void) scan_text(state, lineState, "c"sv, 80, buffer);
+    REQUIRE(buffer.size == 1);
+    CHECK(offsets[0] == 0);
+    CHECK(columns[0] == 0);
+
+    // Scanning stops when the buffer is full.
+    auto small = line_break_buffer { offsets.data(), columns.data(), mandatory.data(), 2 };
+    auto const text = "a b c d"sv;
+    state = {};
+    lineState = {};
+    auto const result = scan_text(state, lineState, text, 80, small);
+    CHECK(small.size <= 2);
+    CHECK(result.end < text.data() + text.size());
+}
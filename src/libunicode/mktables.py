@@ -31,7 +31,17 @@ Scripts_fname = 'Scripts.txt'
 Blocks_fname = 'Blocks.txt'
 ScriptExtensions_fname = 'ScriptExtensions.txt'
 Emoji_data_fname = '/emoji/emoji-data.txt'
+# Not part of UCD.zip, but published along with it (see LIBUNICODE_EMOJI_SEQUENCES_DOWNLOAD_URL).
+Emoji_sequences_fnames = ['/emoji/emoji-sequences.txt', '/emoji/emoji-zwj-sequences.txt']
 EastAsianWidth_fname = 'EastAsianWidth.txt'
+DerivedBidiClass_fname = '/extracted/DerivedBidiClass.txt'
+BidiBrackets_fname = 'BidiBrackets.txt'
+UnicodeData_fname = 'UnicodeData.txt'
+DerivedNormalizationProps_fname = 'DerivedNormalizationProps.txt'
+SpecialCasing_fname = 'SpecialCasing.txt'
+CaseFolding_fname = 'CaseFolding.txt'
+LineBreak_fname = 'LineBreak.txt'
+WordBreakProperty_fname = '/auxiliary/WordBreakProperty.txt'
 
 PLANES = [
     {'plane':  0, 'start':   0x0000, 'end':  0x0FFFF, 'short':    'BMP', 'name': 'Basic Multilingual Plane'},
@@ -56,9 +66,27 @@ PLANES = [
 # Unicode 15.0 database: https://www.unicode.org/Public/15.0.0/ucd/
 UCD_DIR = argv[1]
 
+# With --multistage, property accessors look up codepoints in two-stage tables in constant time,
+# instead of binary searching through tables of codepoint ranges.
+MULTISTAGE_TABLES = '--multistage' in argv[2:]
+MULTISTAGE_TABLES_MARKER = '// Property lookup tables: {}\n'.format('multistage' if MULTISTAGE_TABLES else 'ranges')
+MULTISTAGE_BLOCK_SIZES = [32, 64, 128, 256, 512]
+MAX_CODEPOINT = 0x10FFFF
+
 FOLD_OPEN = '{{{'
 FOLD_CLOSE = '}}}'
 
+# Keep in sync with emoji_sequence_hash and detail::perfect_hash_slot() in emoji_sequence.h.
+def emoji_sequence_hash(_sequence):
+    value = 0x811C9DC5
+    for codepoint in _sequence:
+        value = ((value ^ codepoint) * 0x01000193) & 0xFFFFFFFF
+    return value
+
+def perfect_hash_slot(_hash, _salt, _count):
+    mixed = (((_hash + _salt) * 0x9E3779B9) ^ (_hash * 0x31415926)) & 0xFFFFFFFF
+    return (mixed * _count) >> 32
+
 def uopen(filename):
     return codecs_open(filename, encoding = 'utf8')
 
@@ -75,6 +103,9 @@ def minimal_uint(maxValue):
     else:
         return 'uint64_t'
 
+def minimal_uint_size(maxValue):
+    return {'uint8_t': 1, 'uint16_t': 2, 'uint32_t': 4, 'uint64_t': 8}[minimal_uint(maxValue)]
+
 class EnumBuilder(ABC): # {{{
     @abstractmethod
     def output(self):
@@ -131,6 +162,7 @@ class EnumClassWriter(EnumBuilder): # {{{
         self.filename = _header_filename
         self.file = open(_header_filename, 'w', encoding='utf-8', newline='\u000A')
         self.next_value = 0
+        self.enum_values = dict() # maps enum class to a dict mapping member names to their values
 
         self.file.write(globals()['__doc__'])
         self.file.write('#pragma once\n')
@@ -149,9 +181,12 @@ class EnumClassWriter(EnumBuilder): # {{{
 
     def end(self):
         self.file.write('enum class {}: {}\n{{\n'.format(self.enum_class, minimal_uint(len(self.collected_enum_values))))
+        values = dict()
         for name in self.collected_enum_values:
             self.file.write('    {0} = {1},\n'.format(sanitize_identifier(name), self.next_value))
+            values[sanitize_identifier(name)] = self.next_value
             self.next_value += 1
+        self.enum_values[self.enum_class] = values
         self.file.write("};\n\n")
 
     def output(self):
@@ -322,8 +357,12 @@ class UCDGenerator: # {{{
         self.general_category = list()
         self.blocks = list()
 
+        self.multistage = MULTISTAGE_TABLES
+        self.block_sizes = dict()
+
+        self.enum_class_writer = EnumClassWriter(HEADER_ROOT + '/ucd_enums.h')
         self.builder = EnumBuilderArray([ # TODO: rename to enum_builder
-            EnumClassWriter(HEADER_ROOT + '/ucd_enums.h'),
+            self.enum_class_writer,
             EnumOstreamWriter(HEADER_ROOT + '/ucd_ostream.h'),
             EnumFmtWriter(HEADER_ROOT + '/ucd_fmt.h')
         ])
@@ -347,7 +386,14 @@ class UCDGenerator: # {{{
 
         self.process_grapheme_break_props()
         self.process_east_asian_width()
+        self.process_enumerated_property(DerivedBidiClass_fname, 'Bidi_Class', 'Left_To_Right')
+        self.process_bidi_brackets()
+        self.process_normalization()
+        self.process_case_mappings()
+        self.process_enumerated_property(LineBreak_fname, 'Line_Break', 'Unknown')
+        self.process_enumerated_property(WordBreakProperty_fname, 'Word_Break', 'Other')
         self.process_emoji_props()
+        self.process_emoji_sequences()
 
         self.file_footer()
 
@@ -362,7 +408,9 @@ class UCDGenerator: # {{{
 
 #include <libunicode/ucd_enums.h>
 
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace unicode
@@ -371,7 +419,9 @@ namespace unicode
 """)
 
         self.impl.write(globals()['__doc__'])
+        self.impl.write(MULTISTAGE_TABLES_MARKER)
         self.impl.write("""
+#include <libunicode/emoji_sequence.h>
 #include <libunicode/ucd.h>
 #include <libunicode/ucd_private.h>
 
@@ -481,6 +531,60 @@ namespace unicode
         self.impl.write("} // namespace tables\n\n")
     # }}}
 
+    # {{{ multistage table writer
+    def table_lookup(self, _name, _type, _default, _codepoint = 'codepoint'):
+        """ Returns the expression looking up the property value of _codepoint in the tables of _name. """
+        if self.multistage:
+            return 'lookup<{0}>(tables::{1}_stage1, tables::{1}_stage2, {2}, {3}::{4})'.format(
+                self.block_sizes[_name], _name, _codepoint, _type, _default)
+        return 'search(tables::{0}, {1}).value_or({2}::{3})'.format(_name, _codepoint, _type, _default)
+
+    def write_multistage_table(self, _name, _type, _ranges, _default):
+        """ Writes the two-stage tables _name_stage1 and _name_stage2 mapping each codepoint to
+            the enum value of _type that the _ranges assign to it, or _default otherwise.
+        """
+        enum_values = self.enum_class_writer.enum_values[_type]
+        values = [enum_values[_default]] * (MAX_CODEPOINT + 1)
+        for r in _ranges:
+            values[r['start']:r['end'] + 1] = [enum_values[sanitize_identifier(r['property'])]] * (r['end'] - r['start'] + 1)
+        self.write_two_stage_table(_name, values, len(enum_values))
+
+    def write_two_stage_table(self, _name, _values, _value_count):
+        """ Writes the two-stage tables _name_stage1 and _name_stage2 mapping each codepoint to its
+            integer value in _values, each of them being less than _value_count.
+
+            The codepoints are split into blocks, with stage1 mapping each block to the index of its values
+            in stage2. Blocks with the same values share them, and the block size yielding the smallest
+            tables is chosen.
+        """
+        best = None
+        for block_size in MULTISTAGE_BLOCK_SIZES:
+            blocks = dict()
+            stage1 = []
+            for start in range(0, len(_values), block_size):
+                stage1.append(blocks.setdefault(tuple(_values[start:start + block_size]), len(blocks)))
+            table_size = (len(stage1) * minimal_uint_size(len(blocks))
+                          + len(blocks) * block_size * minimal_uint_size(_value_count))
+            if best is None or table_size < best['size']:
+                best = {'size': table_size, 'block_size': block_size, 'stage1': stage1, 'blocks': list(blocks.keys())}
+        self.block_sizes[_name] = best['block_size']
+
+        def write_array(_suffix, _element_type, _elements):
+            self.impl.write("auto static const {}_{} = std::array<{}, {}>{{ // {}\n".format(
+                _name, _suffix, _element_type, len(_elements), FOLD_OPEN))
+            for i in range(0, len(_elements), 32):
+                self.impl.write('    {},\n'.format(', '.join(str(e) for e in _elements[i:i + 32])))
+            self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+
+        self.impl.write("namespace tables {\n")
+        self.impl.write("// clang-format off\n")
+        self.impl.write("// {} bytes, in blocks of {} codepoints\n".format(best['size'], best['block_size']))
+        write_array('stage1', minimal_uint(len(best['blocks'])), best['stage1'])
+        write_array('stage2', minimal_uint(_value_count), [v for block in best['blocks'] for v in block])
+        self.impl.write("// clang-format on\n")
+        self.impl.write("} // end namespace tables\n\n")
+    # }}}
+
     def write_properties(self): # {{{
         for name in sorted(self.property_values.keys()):
             if len(self.property_values[name].keys()) == 0:
@@ -687,6 +791,12 @@ namespace unicode
         # }}}
 
     def write_tables_and_functions(self, props): # {{{
+        if self.multistage:
+            for name in sorted(props.keys()):
+                self.write_multistage_table(name, name, props[name], 'Undefined')
+            self.write_functions(props)
+            return
+
         # write range tables
         self.impl.write("namespace tables {\n")
         for name in sorted(props.keys()):
@@ -706,11 +816,14 @@ namespace unicode
                            propRange['comment']))
             self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
         self.impl.write("} // end namespace tables\n\n")
+        self.write_functions(props)
+        # }}}
 
+    def write_functions(self, props): # {{{
         for name in sorted(props.keys()):
             self.header.write(f'{name} {name.lower()}(char32_t codepoint) noexcept;\n')
             self.impl.write(f'{name} {name.lower()}(char32_t codepoint) noexcept {{\n')
-            self.impl.write(f'    return search(tables::{name}, codepoint).value_or({name}::Undefined);\n')
+            self.impl.write('    return {};\n'.format(self.table_lookup(name, name, 'Undefined')))
             self.impl.write('}\n\n')
         self.header.write('\n')
         self.impl.write('\n')
@@ -727,25 +840,9 @@ namespace unicode
         props = self.scripts
         element_type = 'Prop<unicode::{}>'.format(name)
 
-        self.impl.write("namespace tables {\n")
-        self.impl.write("auto static const {} = std::array<{}, {}>{{ // {}\n".format(
-            name,
-            element_type,
-            len(props),
-            FOLD_OPEN))
         pset = set()
         for propRange in props:
             pset.add(propRange['property'])
-            self.impl.write("    {} {{ {{ 0x{:>04X}, 0x{:>04X} }}, unicode::{}::{} }}, // {}\n".format(
-                            element_type,
-                            propRange['start'],
-                            propRange['end'],
-                            name,
-                            propRange['property'],
-                            propRange['comment']))
-
-        self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
-        self.impl.write("} // end namespace tables\n\n")
 
         self.builder.begin(name, 0)
         self.builder.member('Invalid')
@@ -756,14 +853,43 @@ namespace unicode
                 self.builder.member(p)
         self.builder.end()
 
+        if self.multistage:
+            self.write_multistage_table(name, name, props, 'Unknown')
+        else:
+            self.write_scripts_ranges()
+
         # codepoint-to-script mapping function
         self.header.write('{} {}(char32_t codepoint) noexcept;\n\n'.format(name, name.lower()))
 
         self.impl.write('{} {}(char32_t codepoint) noexcept {{\n'.format(name, name.lower()))
-        self.impl.write('    return search(tables::{}, codepoint).value_or(Script::Unknown);\n'.format(name))
+        self.impl.write('    return {};\n'.format(self.table_lookup(name, name, 'Unknown')))
         self.impl.write('}\n\n')
         # }}}
 
+    def write_scripts_ranges(self): # {{{
+        name = 'Script'
+        props = self.scripts
+        element_type = 'Prop<unicode::{}>'.format(name)
+
+        self.impl.write("namespace tables {\n")
+        self.impl.write("auto static const {} = std::array<{}, {}>{{ // {}\n".format(
+            name,
+            element_type,
+            len(props),
+            FOLD_OPEN))
+        for propRange in props:
+            self.impl.write("    {} {{ {{ 0x{:>04X}, 0x{:>04X} }}, unicode::{}::{} }}, // {}\n".format(
+                            element_type,
+                            propRange['start'],
+                            propRange['end'],
+                            name,
+                            propRange['property'],
+                            propRange['comment']))
+
+        self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+        self.impl.write("} // end namespace tables\n\n")
+        # }}}
+
     def load_blocks(self): # {{{
         filename = self.ucd_dir + '/' + Blocks_fname
         with uopen(filename) as f:
@@ -933,9 +1059,411 @@ namespace unicode
             self.header.write('\n')
         # }}}
 
+    def process_bidi_brackets(self): # {{{
+        """ Writes the accessors for the Bidi_Paired_Bracket and Bidi_Paired_Bracket_Type properties. """
+        # 0028; 0029; o # LEFT PARENTHESIS
+        lineRE = re.compile(r'^([0-9A-F]+)\s*;\s*([0-9A-F]+)\s*;\s*([oc])\s*#\s*(.*)$')
+        brackets = []
+        with uopen(self.ucd_dir + '/' + BidiBrackets_fname) as f:
+            for line in f:
+                m = lineRE.match(line)
+                if m:
+                    brackets.append({'codepoint': int(m.group(1), 16),
+                                     'paired': int(m.group(2), 16),
+                                     'type': 'Open' if m.group(3) == 'o' else 'Close',
+                                     'comment': m.group(4)})
+        brackets.sort(key = lambda a: a['codepoint'])
+
+        self.impl.write("namespace tables {\n")
+        self.impl.write("// clang-format off\n")
+        self.impl.write("auto static const Bidi_Paired_Bracket = std::array<Prop<char32_t>, {}>{{ // {}\n".format(
+            len(brackets), FOLD_OPEN))
+        for bracket in brackets:
+            self.impl.write("    Prop<char32_t> {{ {{ 0x{0:>04X}, 0x{0:>04X} }}, 0x{1:>04X} }}, // {2}\n".format(
+                bracket['codepoint'], bracket['paired'], bracket['comment']))
+        self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+        self.impl.write("auto static const Bidi_Paired_Bracket_Type = std::array<Prop<::unicode::Bidi_Paired_Bracket_Type>, {}>{{ // {}\n".format(
+            len(brackets), FOLD_OPEN))
+        for bracket in brackets:
+            self.impl.write("    Prop<::unicode::Bidi_Paired_Bracket_Type> {{ {{ 0x{0:>04X}, 0x{0:>04X} }}, ::unicode::Bidi_Paired_Bracket_Type::{1} }},\n".format(
+                bracket['codepoint'], bracket['type']))
+        self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+        self.impl.write("// clang-format on\n")
+        self.impl.write("} // end namespace tables\n\n")
+
+        self.impl.write('char32_t bidi_paired_bracket(char32_t codepoint) noexcept {\n')
+        self.impl.write('    return search(tables::Bidi_Paired_Bracket, codepoint).value_or(codepoint);\n')
+        self.impl.write('}\n\n')
+        self.impl.write('Bidi_Paired_Bracket_Type bidi_paired_bracket_type(char32_t codepoint) noexcept {\n')
+        self.impl.write('    return search(tables::Bidi_Paired_Bracket_Type, codepoint).value_or(Bidi_Paired_Bracket_Type::None);\n')
+        self.impl.write('}\n\n')
+
+        self.header.write('/// Returns the opening or closing bracket paired with the given one, or the codepoint itself if none.\n')
+        self.header.write('char32_t bidi_paired_bracket(char32_t codepoint) noexcept;\n\n')
+        self.header.write('Bidi_Paired_Bracket_Type bidi_paired_bracket_type(char32_t codepoint) noexcept;\n\n')
+        # }}}
+
+    def process_normalization(self): # {{{
+        """ Writes the accessors of the decomposition and composition mappings that normalization (UAX #15)
+            is built upon.
+
+            The decompositions are stored fully decomposed and canonically ordered, such that a single
+            lookup yields the whole decomposition of a codepoint. Hangul syllables are decomposed (and composed)
+            algorithmically, and therefore not part of the tables.
+        """
+        # 00C0;LATIN CAPITAL LETTER A WITH GRAVE;Lu;0;L;0041 0300;;;;N;;;;00E0;
+        # FB01;LATIN SMALL LIGATURE FI;Ll;0;L;<compat> 0066 0069;;;;N;;;;;
+        combining_classes = dict()
+        mappings = dict()
+        with uopen(self.ucd_dir + '/' + UnicodeData_fname) as f:
+            for line in f:
+                fields = line.split(';')
+                if len(fields) < 6:
+                    continue
+                codepoint = int(fields[0], 16)
+                if int(fields[3]) != 0:
+                    combining_classes[codepoint] = int(fields[3])
+                decomposition = fields[5].split()
+                if decomposition:
+                    compat = decomposition[0].startswith('<')
+                    mappings[codepoint] = (compat, [int(c, 16) for c in decomposition[compat:]])
+
+        # 0340..0341    ; Full_Composition_Exclusion # Mn   [2] COMBINING GRAVE TONE MARK..COMBINING ACUTE TONE MARK
+        exclusions = set()
+        with uopen(self.ucd_dir + '/' + DerivedNormalizationProps_fname) as f:
+            for line in f:
+                fields = [field.strip() for field in line.split('#')[0].split(';')]
+                if len(fields) != 2 or fields[1] != 'Full_Composition_Exclusion':
+                    continue
+                bounds = [int(c, 16) for c in fields[0].split('..')]
+                exclusions.update(range(bounds[0], bounds[-1] + 1))
+
+        def decompose(_codepoint, _compat):
+            if _codepoint not in mappings or (mappings[_codepoint][0] and not _compat):
+                return [_codepoint]
+            result = [c for m in mappings[_codepoint][1] for c in decompose(m, _compat)]
+            # Canonical ordering, i.e. a stable sort of each run of non-starters by their combining class.
+            i = 0
+            while i < len(result):
+                j = i
+                while j < len(result) and combining_classes.get(result[j], 0) != 0:
+                    j += 1
+                result[i:j] = sorted(result[i:j], key = lambda c: combining_classes[c])
+                i = j + 1
+            return result
+
+        decompositions = {(): 0}
+        canonical = [0] * (MAX_CODEPOINT + 1)
+        compatibility = [0] * (MAX_CODEPOINT + 1)
+        for codepoint in sorted(mappings.keys()):
+            compat = mappings[codepoint][0]
+            if not compat:
+                canonical[codepoint] = decompositions.setdefault(tuple(decompose(codepoint, False)), len(decompositions))
+            compatibility[codepoint] = decompositions.setdefault(tuple(decompose(codepoint, True)), len(decompositions))
+
+        compositions = dict()
+        for codepoint in sorted(mappings.keys()):
+            compat, mapping = mappings[codepoint]
+            if not compat and len(mapping) == 2 and codepoint not in exclusions:
+                compositions.setdefault(mapping[0], []).append((mapping[1], codepoint))
+        firsts = sorted(compositions.keys())
+        composition = [0] * (MAX_CODEPOINT + 1)
+        for i, first in enumerate(firsts):
+            composition[first] = i + 1
+
+        decomposition_offsets = [0]
+        for sequence in decompositions.keys():
+            decomposition_offsets.append(decomposition_offsets[-1] + len(sequence))
+        composition_offsets = [0, 0]
+        composition_pairs = []
+        for first in firsts:
+            composition_pairs += sorted(compositions[first])
+            composition_offsets.append(len(composition_pairs))
+
+        def write_array(_name, _element_type, _elements, _format = str):
+            self.impl.write("auto static const {} = std::array<{}, {}>{{ // {}\n".format(
+                _name, _element_type, len(_elements), FOLD_OPEN))
+            for i in range(0, len(_elements), 16):
+                self.impl.write('    {},\n'.format(', '.join(_format(e) for e in _elements[i:i + 16])))
+            self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+
+        hex_codepoint = lambda c: '0x{:>04X}'.format(c)
+        self.impl.write("namespace tables {\n")
+        self.impl.write("// clang-format off\n")
+        self.impl.write("// {} distinct decompositions, {} primary composites\n".format(
+            len(decompositions) - 1, len(composition_pairs)))
+        write_array('Decomposition_offsets', minimal_uint(decomposition_offsets[-1]), decomposition_offsets)
+        write_array('Decompositions', 'char32_t', [c for sequence in decompositions.keys() for c in sequence],
+                    hex_codepoint)
+        write_array('Composition_offsets', minimal_uint(composition_offsets[-1]), composition_offsets)
+        write_array('Composition_seconds', 'char32_t', [pair[0] for pair in composition_pairs], hex_codepoint)
+        write_array('Composition_composites', 'char32_t', [pair[1] for pair in composition_pairs], hex_codepoint)
+        self.impl.write("// clang-format on\n")
+        self.impl.write("} // end namespace tables\n\n")
+
+        self.write_two_stage_table('Canonical_Decomposition', canonical, len(decompositions))
+        self.write_two_stage_table('Compatibility_Decomposition', compatibility, len(decompositions))
+        self.write_two_stage_table('Composition', composition, len(firsts) + 1)
+
+        for name in ['Canonical_Decomposition', 'Compatibility_Decomposition']:
+            self.impl.write('std::u32string_view {}(char32_t codepoint) noexcept {{\n'.format(name.lower()))
+            self.impl.write('    auto const index = lookup<{0}>(tables::{1}_stage1, tables::{1}_stage2, codepoint, size_t {{ 0 }});\n'.format(
+                self.block_sizes[name], name))
+            self.impl.write('    auto const offset = tables::Decomposition_offsets[index];\n')
+            self.impl.write('    auto const length = static_cast<size_t>(tables::Decomposition_offsets[index + 1] - offset);\n')
+            self.impl.write('    return std::u32string_view(tables::Decompositions.data() + offset, length);\n')
+            self.impl.write('}\n\n')
+
+        self.impl.write('std::optional<char32_t> primary_composite(char32_t first, char32_t second) noexcept {\n')
+        self.impl.write('    auto const index = lookup<{}>(tables::Composition_stage1, tables::Composition_stage2, first, size_t {{ 0 }});\n'.format(
+            self.block_sizes['Composition']))
+        self.impl.write('    for (auto i = tables::Composition_offsets[index]; i < tables::Composition_offsets[index + 1]; ++i)\n')
+        self.impl.write('        if (tables::Composition_seconds[i] == second)\n')
+        self.impl.write('            return tables::Composition_composites[i];\n')
+        self.impl.write('    return std::nullopt;\n')
+        self.impl.write('}\n\n')
+
+        self.header.write('/// Returns the full canonical decomposition of the given codepoint, canonically ordered,\n')
+        self.header.write('/// or an empty string if it has none.\n')
+        self.header.write('///\n')
+        self.header.write('/// Hangul syllables are decomposed algorithmically and have none here.\n')
+        self.header.write('std::u32string_view canonical_decomposition(char32_t codepoint) noexcept;\n\n')
+        self.header.write('/// Same as canonical_decomposition(), but also applying the compatibility decomposition mappings.\n')
+        self.header.write('std::u32string_view compatibility_decomposition(char32_t codepoint) noexcept;\n\n')
+        self.header.write('/// Returns the primary composite of the given pair of codepoints, i.e. the codepoint canonically\n')
+        self.header.write('/// decomposing into them that is not excluded from composition, if any.\n')
+        self.header.write('///\n')
+        self.header.write('/// Hangul syllables are composed algorithmically and have none here.\n')
+        self.header.write('std::optional<char32_t> primary_composite(char32_t first, char32_t second) noexcept;\n\n')
+        # }}}
+
+    def process_case_mappings(self): # {{{
+        """ Writes the accessors of the simple and full case mappings and case foldings.
+
+            The simple mappings are stored as deltas to the codepoint being mapped, such that runs of
+            codepoints mapping alike (e.g. each capital letter of a script to its small letter) share
+            the same values, and all mappings of a codepoint are looked up through a single two-stage table.
+            Only the unconditional full mappings of SpecialCasing.txt are included.
+        """
+        # 0041;LATIN CAPITAL LETTER A;Lu;0;L;;;;;N;;;;0061;
+        lowercase = dict()
+        uppercase = dict()
+        with uopen(self.ucd_dir + '/' + UnicodeData_fname) as f:
+            for line in f:
+                fields = line.split(';')
+                if len(fields) < 15:
+                    continue
+                codepoint = int(fields[0], 16)
+                if fields[12]:
+                    uppercase[codepoint] = int(fields[12], 16)
+                if fields[13]:
+                    lowercase[codepoint] = int(fields[13], 16)
+
+        # 00DF; 00DF; 0053 0073; 0053 0053; # LATIN SMALL LETTER SHARP S
+        # 03A3; 03C2; 03A3; 03A3; Final_Sigma; # GREEK CAPITAL LETTER SIGMA
+        full_lowercase = dict()
+        full_uppercase = dict()
+        with uopen(self.ucd_dir + '/' + SpecialCasing_fname) as f:
+            for line in f:
+                fields = [field.strip() for field in line.split('#')[0].split(';')]
+                if len(fields) != 5 or fields[4]:
+                    continue # not a mapping, or a conditional one
+                codepoint = int(fields[0], 16)
+                full_lowercase[codepoint] = tuple(int(c, 16) for c in fields[1].split())
+                full_uppercase[codepoint] = tuple(int(c, 16) for c in fields[3].split())
+
+        # 0041; C; 0061; # LATIN CAPITAL LETTER A
+        # 00DF; F; 0073 0073; # LATIN SMALL LETTER SHARP S
+        folding = dict()
+        full_folding = dict()
+        with uopen(self.ucd_dir + '/' + CaseFolding_fname) as f:
+            for line in f:
+                fields = [field.strip() for field in line.split('#')[0].split(';')]
+                if len(fields) < 3:
+                    continue
+                codepoint = int(fields[0], 16)
+                mapping = tuple(int(c, 16) for c in fields[2].split())
+                if fields[1] in ('C', 'S'):
+                    folding[codepoint] = mapping[0]
+                elif fields[1] == 'F':
+                    full_folding[codepoint] = mapping
+
+        expansions = {(): 0}
+        def expansion(_codepoint, _full, _simple):
+            """ Returns the index of the full mapping of _codepoint, or 0 if it is the simple mapping. """
+            mapping = _full.get(_codepoint)
+            if mapping is None or mapping == (_simple.get(_codepoint, _codepoint),):
+                return 0
+            return expansions.setdefault(mapping, len(expansions))
+
+        records = {(0, 0, 0, 0, 0, 0): 0}
+        case_mapping = [0] * (MAX_CODEPOINT + 1)
+        for codepoint in sorted(set(lowercase) | set(uppercase) | set(folding) | set(full_lowercase)
+                                | set(full_uppercase) | set(full_folding)):
+            record = (lowercase.get(codepoint, codepoint) - codepoint,
+                      uppercase.get(codepoint, codepoint) - codepoint,
+                      folding.get(codepoint, codepoint) - codepoint,
+                      expansion(codepoint, full_lowercase, lowercase),
+                      expansion(codepoint, full_uppercase, uppercase),
+                      expansion(codepoint, full_folding, folding))
+            case_mapping[codepoint] = records.setdefault(record, len(records))
+
+        expansion_offsets = [0]
+        for sequence in expansions.keys():
+            expansion_offsets.append(expansion_offsets[-1] + len(sequence))
+
+        def write_array(_name, _element_type, _elements, _format = str):
+            self.impl.write("auto static const {} = std::array<{}, {}>{{ // {}\n".format(
+                _name, _element_type, len(_elements), FOLD_OPEN))
+            for i in range(0, len(_elements), 16):
+                self.impl.write('    {},\n'.format(', '.join(_format(e) for e in _elements[i:i + 16])))
+            self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+
+        kinds = ['Lowercase', 'Uppercase', 'Case_Folding']
+        self.impl.write("namespace tables {\n")
+        self.impl.write("// clang-format off\n")
+        self.impl.write("// {} distinct case mappings, {} full mappings\n".format(len(records), len(expansions) - 1))
+        for i, kind in enumerate(kinds):
+            write_array(kind + '_deltas', 'int32_t', [record[i] for record in records.keys()])
+        for i, kind in enumerate(kinds):
+            write_array(kind + '_expansions', minimal_uint(len(expansions)), [record[3 + i] for record in records.keys()])
+        write_array('Case_Expansion_offsets', minimal_uint(expansion_offsets[-1]), expansion_offsets)
+        write_array('Case_Expansions', 'char32_t', [c for sequence in expansions.keys() for c in sequence],
+                    lambda c: '0x{:>04X}'.format(c))
+        self.impl.write("// clang-format on\n")
+        self.impl.write("} // end namespace tables\n\n")
+
+        self.write_two_stage_table('Case_Mapping', case_mapping, len(records))
+        lookup = 'lookup<{}>(tables::Case_Mapping_stage1, tables::Case_Mapping_stage2, codepoint, size_t {{ 0 }})'.format(
+            self.block_sizes['Case_Mapping'])
+
+        functions = [('simple_lowercase_mapping', 'full_lowercase_mapping', 'Lowercase'),
+                     ('simple_uppercase_mapping', 'full_uppercase_mapping', 'Uppercase'),
+                     ('simple_case_folding', 'full_case_folding', 'Case_Folding')]
+        for simple, full, kind in functions:
+            self.impl.write('char32_t {}(char32_t codepoint) noexcept {{\n'.format(simple))
+            self.impl.write('    auto const delta = tables::{}_deltas[{}];\n'.format(kind, lookup))
+            self.impl.write('    return static_cast<char32_t>(static_cast<int32_t>(codepoint) + delta);\n')
+            self.impl.write('}\n\n')
+            self.impl.write('std::u32string_view {}(char32_t codepoint) noexcept {{\n'.format(full))
+            self.impl.write('    auto const index = tables::{}_expansions[{}];\n'.format(kind, lookup))
+            self.impl.write('    auto const offset = tables::Case_Expansion_offsets[index];\n')
+            self.impl.write('    auto const length = static_cast<size_t>(tables::Case_Expansion_offsets[index + 1] - offset);\n')
+            self.impl.write('    return std::u32string_view(tables::Case_Expansions.data() + offset, length);\n')
+            self.impl.write('}\n\n')
+
+        self.header.write('/// Returns the simple lowercase mapping of the given codepoint, or the codepoint itself if it has none.\n')
+        self.header.write('char32_t simple_lowercase_mapping(char32_t codepoint) noexcept;\n\n')
+        self.header.write('/// Returns the simple uppercase mapping of the given codepoint, or the codepoint itself if it has none.\n')
+        self.header.write('char32_t simple_uppercase_mapping(char32_t codepoint) noexcept;\n\n')
+        self.header.write('/// Returns the simple case folding (status C and S) of the given codepoint,\n')
+        self.header.write('/// or the codepoint itself if it has none.\n')
+        self.header.write('char32_t simple_case_folding(char32_t codepoint) noexcept;\n\n')
+        self.header.write('/// Returns the unconditional full lowercase mapping of the given codepoint as per SpecialCasing.txt,\n')
+        self.header.write('/// or an empty string if it is the simple lowercase mapping.\n')
+        self.header.write('std::u32string_view full_lowercase_mapping(char32_t codepoint) noexcept;\n\n')
+        self.header.write('/// Returns the unconditional full uppercase mapping of the given codepoint as per SpecialCasing.txt,\n')
+        self.header.write('/// or an empty string if it is the simple uppercase mapping.\n')
+        self.header.write('std::u32string_view full_uppercase_mapping(char32_t codepoint) noexcept;\n\n')
+        self.header.write('/// Returns the full case folding (status F) of the given codepoint,\n')
+        self.header.write('/// or an empty string if it is the simple case folding.\n')
+        self.header.write('std::u32string_view full_case_folding(char32_t codepoint) noexcept;\n\n')
+        # }}}
+
+    def process_emoji_sequences(self): # {{{
+        """ Writes is_rgi_emoji_sequence(), looking up the RGI emoji sequences in a minimal perfect hash.
+
+            The sequences are bucketed by their slot with salt 0, and starting with the largest bucket,
+            each bucket is assigned the first salt that maps all of its sequences to distinct free slots.
+        """
+        sequences = set()
+        for fname in Emoji_sequences_fnames:
+            if not os.path.exists(self.ucd_dir + fname):
+                print('Warning: {} not found, no emoji sequence is considered RGI.'.format(self.ucd_dir + fname))
+                continue
+            with uopen(self.ucd_dir + fname) as f:
+                # 1F468 200D 1F469 200D 1F467 ; RGI_Emoji_ZWJ_Sequence ; family: man, woman, girl # E2.0 [1] (...)
+                # 231A..231B ; Basic_Emoji ; watch..hourglass done # E0.6 [2] (...)
+                for line in f:
+                    fields = line.split('#')[0].split(';')
+                    if len(fields) < 2:
+                        continue
+                    codepoints = fields[0].strip()
+                    m = re.match(r'^([0-9A-F]+)\.\.([0-9A-F]+)$', codepoints)
+                    if m:
+                        for codepoint in range(int(m.group(1), 16), int(m.group(2), 16) + 1):
+                            sequences.add((codepoint,))
+                    else:
+                        sequences.add(tuple(int(c, 16) for c in codepoints.split()))
+
+        sequences = sorted(sequences)
+        count = len(sequences)
+        hashes = [emoji_sequence_hash(sequence) for sequence in sequences]
+        if len(set(hashes)) != count:
+            raise Exception('Emoji sequence hash collision.')
+
+        if count == 0:
+            self.impl.write('bool is_rgi_emoji_sequence(std::u32string_view, emoji_sequence_hash) noexcept {\n')
+            self.impl.write('    return false;\n')
+            self.impl.write('}\n\n')
+            return
+
+        buckets = [[] for _ in range(count)]
+        for i in range(count):
+            buckets[perfect_hash_slot(hashes[i], 0, count)].append(i)
+        salts = [0] * count
+        slots = [None] * count
+        for bucket_index in sorted(range(count), key = lambda b: -len(buckets[b])):
+            bucket = buckets[bucket_index]
+            if not bucket:
+                break
+            salt = 1
+            while True:
+                candidates = [perfect_hash_slot(hashes[i], salt, count) for i in bucket]
+                if len(set(candidates)) == len(bucket) and all(slots[c] is None for c in candidates):
+                    break
+                salt += 1
+            salts[bucket_index] = salt
+            for i, candidate in zip(bucket, candidates):
+                slots[candidate] = sequences[i]
+
+        offsets = [0]
+        for sequence in slots:
+            offsets.append(offsets[-1] + len(sequence))
+
+        self.impl.write("namespace tables {\n")
+        self.impl.write("// clang-format off\n")
+        self.impl.write("// {} RGI emoji sequences\n".format(count))
+        self.impl.write("auto static const RGI_Emoji_Sequence_salts = std::array<{}, {}>{{ // {}\n".format(
+            minimal_uint(max(salts)), count, FOLD_OPEN))
+        for i in range(0, count, 32):
+            self.impl.write('    {},\n'.format(', '.join(str(salt) for salt in salts[i:i + 32])))
+        self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+        self.impl.write("auto static const RGI_Emoji_Sequence_offsets = std::array<{}, {}>{{ // {}\n".format(
+            minimal_uint(offsets[-1]), len(offsets), FOLD_OPEN))
+        for i in range(0, len(offsets), 32):
+            self.impl.write('    {},\n'.format(', '.join(str(offset) for offset in offsets[i:i + 32])))
+        self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+        self.impl.write("auto static const RGI_Emoji_Sequences = std::array<char32_t, {}>{{ // {}\n".format(
+            offsets[-1], FOLD_OPEN))
+        for sequence in slots:
+            self.impl.write('    {},\n'.format(', '.join('0x{:>04X}'.format(c) for c in sequence)))
+        self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+        self.impl.write("// clang-format on\n")
+        self.impl.write("} // end namespace tables\n\n")
+
+        self.impl.write('bool is_rgi_emoji_sequence(std::u32string_view sequence, emoji_sequence_hash hash) noexcept {\n')
+        self.impl.write('    auto const count = tables::RGI_Emoji_Sequence_salts.size();\n')
+        self.impl.write('    auto const salt = tables::RGI_Emoji_Sequence_salts[detail::perfect_hash_slot(hash.value, 0, count)];\n')
+        self.impl.write('    auto const slot = detail::perfect_hash_slot(hash.value, salt, count);\n')
+        self.impl.write('    auto const offset = tables::RGI_Emoji_Sequence_offsets[slot];\n')
+        self.impl.write('    auto const length = static_cast<size_t>(tables::RGI_Emoji_Sequence_offsets[slot + 1] - offset);\n')
+        self.impl.write('    return sequence == std::u32string_view(tables::RGI_Emoji_Sequences.data() + offset, length);\n')
+        self.impl.write('}\n\n')
+        # }}}
+
     def write_blocks(self): # {{{
         UNSPECIFIED = 'Unspecified'
-        element_type = 'Prop<{}>'.format('::unicode::Block')
 
         # Construct enum class:
         block_titles = set()
@@ -947,6 +1475,24 @@ namespace unicode
             self.builder.member(sanitize_identifier(block_title))
         self.builder.end()
 
+        if self.multistage:
+            ranges = [{'start': b['start'], 'end': b['end'], 'property': b['title']} for b in self.blocks]
+            self.write_multistage_table('Block', 'Block', ranges, UNSPECIFIED)
+        else:
+            self.write_blocks_ranges()
+
+        # write out search function
+        self.impl.write("Block block(char32_t codepoint) noexcept {\n")
+        self.impl.write("    return {};\n".format(self.table_lookup('Block', '::unicode::Block', UNSPECIFIED)))
+        self.impl.write("}\n\n")
+
+        self.header.write("Block block(char32_t codepoint) noexcept;\n\n")
+
+        # }}}
+
+    def write_blocks_ranges(self): # {{{
+        element_type = 'Prop<{}>'.format('::unicode::Block')
+
         # Constract Table definition for associating codepoint ranges with a block:
         self.impl.write("namespace tables {\n")
         self.impl.write("auto static const {} = std::array<{}, {}>{{ // {}\n".format(
@@ -964,42 +1510,16 @@ namespace unicode
                 sanitize_identifier(block['title'])))
         self.impl.write("};\n") # close table
         self.impl.write("} // end namespace tables {}\n\n")
-
-        # write out search function
-        self.impl.write("Block block(char32_t codepoint) noexcept {\n")
-        self.impl.write("    return search(tables::Block, codepoint).value_or(::unicode::Block::Unspecified);\n")
-        self.impl.write("}\n\n")
-
-        self.header.write("Block block(char32_t codepoint) noexcept;\n\n")
-
         # }}}
 
     def write_general_categories(self): # {{{
         UNSPECIFIED = 'Unspecified'
         gcats = self.general_category
-
-        self.impl.write("namespace tables {\n")
         type_name = "General_Category"
-        fqdn_type_name = "::unicode::{}".format(type_name)
-        element_type = 'Prop<{}>'.format(fqdn_type_name)
-        self.impl.write("auto const {} = std::array<{}, {}>{{\n".format(
-            type_name,
-            element_type,
-            len(gcats)
-        ))
+
         cats = set()
         for cat in gcats:
             cats.add(cat['property'])
-            self.impl.write(
-                "    {} {{ {{ 0x{:>04X}, 0x{:>04X} }}, {}::{} }}, // {}\n".format(
-                element_type,
-                cat['start'],
-                cat['end'],
-                fqdn_type_name,
-                cat['property'],
-                cat['comment']))
-        self.impl.write("};\n")
-        self.impl.write("} // end namespace tables\n\n")
 
         # builder
         self.builder.begin('General_Category')
@@ -1008,11 +1528,34 @@ namespace unicode
             self.builder.member(cat)
         self.builder.end()
 
+        if self.multistage:
+            self.write_multistage_table(type_name, type_name, gcats, UNSPECIFIED)
+        else:
+            self.impl.write("namespace tables {\n")
+            fqdn_type_name = "::unicode::{}".format(type_name)
+            element_type = 'Prop<{}>'.format(fqdn_type_name)
+            self.impl.write("auto const {} = std::array<{}, {}>{{\n".format(
+                type_name,
+                element_type,
+                len(gcats)
+            ))
+            for cat in gcats:
+                self.impl.write(
+                    "    {} {{ {{ 0x{:>04X}, 0x{:>04X} }}, {}::{} }}, // {}\n".format(
+                    element_type,
+                    cat['start'],
+                    cat['end'],
+                    fqdn_type_name,
+                    cat['property'],
+                    cat['comment']))
+            self.impl.write("};\n")
+            self.impl.write("} // end namespace tables\n\n")
+
         # getter impl
         self.impl.write("namespace {}\n".format(type_name.lower()))
         self.impl.write("{\n")
         self.impl.write("    {} get(char32_t value) noexcept {{\n".format(type_name))
-        self.impl.write("        return search(tables::{}, value).value_or({}::{});\n".format(type_name, type_name, UNSPECIFIED))
+        self.impl.write("        return {};\n".format(self.table_lookup(type_name, type_name, UNSPECIFIED, 'value')))
         self.impl.write("    }\n")
         self.impl.write("}\n\n")
         # -----------------------------------------------------------------------------------------------
@@ -1107,7 +1650,6 @@ namespace unicode
         }
         type_name = 'EastAsianWidth'
         table_name = type_name
-        prop_type = '::unicode::{}'.format(type_name)
 
         # TODO: Merge sequentially directly connected neighbors that have the same value
 
@@ -1135,40 +1677,122 @@ namespace unicode
             # api: signature
             self.header.write('EastAsianWidth east_asian_width(char32_t codepoint) noexcept;\n\n')
 
-            # impl: range tables
-            self.impl.write("namespace tables {\n")
-            element_type = 'Prop<{}>'.format(prop_type)
-            self.impl.write("auto static const {} = std::array<{}, {}>{{ // {}\n".format(
-                table_name,
-                element_type,
-                len(compact_ranges),
-                FOLD_OPEN
-            ))
-            for range in compact_ranges:
-                if len(range.comments) > 1:
-                    for comment in range.comments:
-                        self.impl.write("    // {}\n".format(comment))
-                self.impl.write("    {} {{ {{ 0x{:>04X}, 0x{:>04X} }}, {}::{} }},".format(
-                                element_type,
-                                range.range_from,
-                                range.range_to,
-                                prop_type,
-                                WIDTH_NAMES[range.value]))
-                if range.count == 1 and len(range.comments) == 1:
-                    self.impl.write(" // {}".format(range.comments[0]))
-                elif range.count > 1:
-                    self.impl.write(" // #{}".format(range.count))
-                self.impl.write('\n')
-            self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
-            self.impl.write("} // end namespace tables\n\n")
+            if self.multistage:
+                ranges = [{'start': r.range_from, 'end': r.range_to, 'property': WIDTH_NAMES[r.value]}
+                          for r in compact_ranges]
+                self.write_multistage_table(table_name, type_name, ranges, 'Unspecified')
+            else:
+                self.write_east_asian_width_ranges(compact_ranges, WIDTH_NAMES)
 
             # impl: function
             self.impl.write(
                 'EastAsianWidth east_asian_width(char32_t codepoint) noexcept {\n' +
-                '    return search(tables::EastAsianWidth, codepoint).value_or(EastAsianWidth::Unspecified);\n'
+                '    return {};\n'.format(self.table_lookup(table_name, type_name, 'Unspecified')) +
                 '}\n\n'
             )
             # }}}
+
+    def write_east_asian_width_ranges(self, compact_ranges, WIDTH_NAMES): # {{{
+        table_name = 'EastAsianWidth'
+        prop_type = '::unicode::{}'.format(table_name)
+
+        # impl: range tables
+        self.impl.write("namespace tables {\n")
+        element_type = 'Prop<{}>'.format(prop_type)
+        self.impl.write("auto static const {} = std::array<{}, {}>{{ // {}\n".format(
+            table_name,
+            element_type,
+            len(compact_ranges),
+            FOLD_OPEN
+        ))
+        for range in compact_ranges:
+            if len(range.comments) > 1:
+                for comment in range.comments:
+                    self.impl.write("    // {}\n".format(comment))
+            self.impl.write("    {} {{ {{ 0x{:>04X}, 0x{:>04X} }}, {}::{} }},".format(
+                            element_type,
+                            range.range_from,
+                            range.range_to,
+                            prop_type,
+                            WIDTH_NAMES[range.value]))
+            if range.count == 1 and len(range.comments) == 1:
+                self.impl.write(" // {}".format(range.comments[0]))
+            elif range.count > 1:
+                self.impl.write(" // #{}".format(range.count))
+            self.impl.write('\n')
+        self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+        self.impl.write("} // end namespace tables\n\n")
+        # }}}
+
+    def process_enumerated_property(self, filename: str, type_name: str, default: str): # {{{
+        """ Writes the accessor for the enumerated property type_name, whose values are listed in filename.
+
+            Values may be given by their short or long names. Codepoints not listed get the value of
+            the @missing line covering them, if any, or default.
+        """
+        aliases = self.property_values[type_name]
+        def long_name(value):
+            return sanitize_identifier(aliases.get(value, value))
+
+        missingRE = re.compile(r'^#\s*@missing:\s*([0-9A-F]+)\.\.([0-9A-F]+)\s*;\s*(\w+)')
+        values = [None] * (MAX_CODEPOINT + 1)
+        missing = []
+        with uopen(self.ucd_dir + '/' + filename) as f:
+            for line in f:
+                m = missingRE.match(line)
+                if m:
+                    missing.append((int(m.group(1), 16), int(m.group(2), 16), long_name(m.group(3))))
+                    continue
+                r = self.parse_range(line)
+                if r != None:
+                    values[r['start']:r['end'] + 1] = [long_name(r['property'])] * (r['end'] - r['start'] + 1)
+
+        # An @missing line covering all codepoints overrides the default value, while others only
+        # apply to codepoints that are not listed.
+        for (start, end, value) in missing:
+            if start == 0 and end == MAX_CODEPOINT:
+                default = value
+        for (start, end, value) in missing:
+            if not (start == 0 and end == MAX_CODEPOINT):
+                for codepoint in range(start, end + 1):
+                    if values[codepoint] is None:
+                        values[codepoint] = value
+
+        # Collect the ranges of codepoints not having the default value.
+        ranges = []
+        for codepoint, value in enumerate(values):
+            if value is None or value == default:
+                continue
+            if len(ranges) != 0 and ranges[-1]['end'] + 1 == codepoint and ranges[-1]['property'] == value:
+                ranges[-1]['end'] = codepoint
+            else:
+                ranges.append({'start': codepoint, 'end': codepoint, 'property': value})
+
+        if self.multistage:
+            self.write_multistage_table(type_name, type_name, ranges, default)
+        else:
+            element_type = 'Prop<::unicode::{}>'.format(type_name)
+            self.impl.write("namespace tables {\n")
+            self.impl.write("auto static const {} = std::array<{}, {}>{{ // {}\n".format(
+                type_name,
+                element_type,
+                len(ranges),
+                FOLD_OPEN))
+            for r in ranges:
+                self.impl.write("    {} {{ {{ 0x{:>04X}, 0x{:>04X} }}, ::unicode::{}::{} }},\n".format(
+                                element_type,
+                                r['start'],
+                                r['end'],
+                                type_name,
+                                r['property']))
+            self.impl.write("}}; // {}\n".format(FOLD_CLOSE))
+            self.impl.write("} // end namespace tables\n\n")
+
+        self.header.write('{} {}(char32_t codepoint) noexcept;\n\n'.format(type_name, type_name.lower()))
+        self.impl.write('{} {}(char32_t codepoint) noexcept {{\n'.format(type_name, type_name.lower()))
+        self.impl.write('    return {};\n'.format(self.table_lookup(type_name, type_name, default)))
+        self.impl.write('}\n\n')
+        # }}}
 # }}}
 
 def needs_run():
@@ -1177,9 +1801,11 @@ def needs_run():
             st = os.stat(HEADER_ROOT + '/' + filename)
             if st.st_mtime < SCRIPT_MTIME:
                 return True
+        # Regenerate when switching between range and multistage tables.
+        with open(HEADER_ROOT + '/ucd.cpp', encoding='utf-8') as f:
+            return not MULTISTAGE_TABLES_MARKER in f.read(4096)
     except FileNotFoundError:
         return True
-    return False
 
 def main():
     if needs_run():
@@ -19,33 +19,85 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iomanip>
 #include <iterator>
 #include <limits>
-#include <optional>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace support
 {
 
+namespace detail
+{
+    /// FNV-1a hash over the object representation of the given range of values.
+    template <typename T>
+    std::size_t hash_bytes(T const* values, std::size_t count) noexcept
+    {
+        auto const* bytes = reinterpret_cast<unsigned char const*>(values);
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (std::size_t i = 0; i < count * sizeof(T); ++i)
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        return static_cast<std::size_t>(hash);
+    }
+
+    /// Hashes table values: by their object representation if that is unique, std::hash otherwise.
+    template <typename T>
+    struct value_hash
+    {
+        std::size_t operator()(T const& value) const noexcept
+        {
+            if constexpr (std::has_unique_object_representations_v<T>)
+                return hash_bytes(&value, 1);
+            else
+                return std::hash<T> {}(value);
+        }
+    };
+
+    /// Hashes a block of stage indices.
+    template <typename T>
+    struct block_hash
+    {
+        std::size_t operator()(std::vector<T> const& block) const noexcept
+        {
+            return hash_bytes(block.data(), block.size());
+        }
+    };
+} // namespace detail
+
 template <typename T,
           typename SourceType,
           typename Stage1ElementType,
           typename Stage2ElementType,
           SourceType BlockSize,
-          SourceType MaxValue = std::numeric_limits<SourceType>::max()>
+          SourceType MaxValue = std::numeric_limits<SourceType>::max(),
+          SourceType DirectSize = 0>
 struct multistage_table
 {
-    using view_type =
-        multistage_table_view<T, SourceType, Stage1ElementType, Stage2ElementType, BlockSize, MaxValue>;
+    using view_type = multistage_table_view<T,
+                                            SourceType,
+                                            Stage1ElementType,
+                                            Stage2ElementType,
+                                            BlockSize,
+                                            MaxValue,
+                                            DirectSize>;
 
     std::vector<Stage1ElementType> stage1; // div
     std::vector<Stage2ElementType> stage2; // mod
     std::vector<T> stage3;                 // values
+    std::vector<T> direct;                 // values for [0, DirectSize)
 
-    auto to_view() const noexcept { return view_type { stage1.data(), stage2.data(), stage3.data() }; }
+    auto to_view() const noexcept
+    {
+        return view_type { stage1.data(), stage2.data(), stage3.data(), direct.data() };
+    }
 
     T const& get(SourceType index) const noexcept { return to_view().get(index); }
 };
@@ -55,29 +107,42 @@ template <typename T,
           typename Stage1ElementType,
           typename Stage2ElementType,
           SourceType BlockSize,
-          SourceType MaxValue = std::numeric_limits<SourceType>::max()>
+          SourceType MaxValue = std::numeric_limits<SourceType>::max(),
+          SourceType DirectSize = 0>
 class multistage_table_generator
 {
   public:
-    T const* _input;
-    size_t _inputSize;
-    multistage_table<T, SourceType, Stage1ElementType, Stage2ElementType, BlockSize, MaxValue>& _output;
+    using table_type =
+        multistage_table<T, SourceType, Stage1ElementType, Stage2ElementType, BlockSize, MaxValue, DirectSize>;
+
+    multistage_table_generator(T const* input, size_t inputSize, table_type& output):
+        _input { input }, _inputSize { inputSize }, _output { output }
+    {
+    }
 
     void generate()
     {
         assert(_inputSize % BlockSize == 0);
+        assert(DirectSize <= _inputSize);
         _output.stage1.resize(_inputSize / BlockSize);
         for (SourceType blockStart = 0; blockStart <= _inputSize - BlockSize; blockStart += BlockSize)
             _output.stage1[blockStart / BlockSize] = get_or_create_index_to_stage2_block(blockStart);
+        _output.direct.assign(_input, _input + DirectSize);
+        _stage2Blocks.clear();
+        _stage3Indices.clear();
     }
 
     void verify() const
     {
-        for (SourceType blockStart = 0; blockStart <= _inputSize - BlockSize; ++blockStart)
+        for (SourceType blockStart = 0; blockStart <= _inputSize - BlockSize; blockStart += BlockSize)
             verify_block(blockStart / BlockSize);
     }
 
   private:
+    T const* _input;
+    size_t _inputSize;
+    table_type& _output;
+
     void verify_block(SourceType blockNumber) const
     {
         for (SourceType codepoint = blockNumber * BlockSize; codepoint < (blockNumber + 1) * BlockSize;
@@ -97,61 +162,41 @@ class multistage_table_generator
 
     Stage1ElementType get_or_create_index_to_stage2_block(SourceType blockStart)
     {
-        if (auto other_block = find_same_block(static_cast<size_t>(blockStart)))
-            return _output.stage1[other_block.value()];
+        auto block = std::vector<Stage2ElementType>(BlockSize);
+        for (SourceType i = 0; i < BlockSize; ++i)
+            block[i] = get_or_create_stage3_index(blockStart + i);
+
+        if (auto const i = _stage2Blocks.find(block); i != _stage2Blocks.end())
+            return i->second;
 
         // Block has not been seen yet. Create a new block.
         auto const stage2Index = _output.stage2.size() / BlockSize;
-        assert(stage2Index < std::numeric_limits<Stage2ElementType>::max());
-
-        for (SourceType index = blockStart; index < blockStart + BlockSize; ++index)
-            _output.stage2.emplace_back(get_or_create_stage3_index(index));
+        assert(stage2Index <= std::numeric_limits<Stage1ElementType>::max());
 
+        _output.stage2.insert(_output.stage2.end(), block.begin(), block.end());
         assert(_output.stage2.size() % BlockSize == 0);
 
+        _stage2Blocks.emplace(std::move(block), static_cast<Stage1ElementType>(stage2Index));
         return static_cast<Stage1ElementType>(stage2Index);
     }
 
-    std::optional<size_t> find_same_block(size_t blockStart) const noexcept
-    {
-        assert(blockStart % BlockSize == 0);
-        assert(blockStart + BlockSize <= _inputSize);
-
-        for (size_t otherBlockStart = 0; otherBlockStart < blockStart; otherBlockStart += BlockSize)
-            if (is_same_block(otherBlockStart, blockStart))
-                return { otherBlockStart / BlockSize };
-
-        return std::nullopt;
-    }
-
-    /// Tests if two given blocks are equivalent.
-    /// @p a and @p b are both absolute offsets to the start of each block.
-    bool is_same_block(size_t a, size_t b) const noexcept
-    {
-        assert(a % BlockSize == 0);
-        assert(b % BlockSize == 0);
-        assert(a + BlockSize <= _inputSize);
-        assert(b + BlockSize <= _inputSize);
-
-        for (size_t i = 0; i < BlockSize; ++i)
-            if (_input[a + i] != _input[b + i])
-                return false;
-
-        return true;
-    }
-
-    Stage2ElementType get_or_create_stage3_index(SourceType stage1Index)
+    Stage2ElementType get_or_create_stage3_index(SourceType index)
     {
         auto& properties = _output.stage3;
-        auto const propertyIterator = find(properties.begin(), properties.end(), _input[stage1Index]);
-        if (propertyIterator != properties.end())
-            return static_cast<Stage2ElementType>(distance(properties.begin(), propertyIterator));
+        if (auto const i = _stage3Indices.find(_input[index]); i != _stage3Indices.end())
+            return i->second;
 
         auto const stage3Index = properties.size();
-        properties.emplace_back(_input[stage1Index]);
-        assert(stage3Index < std::numeric_limits<Stage2ElementType>::max());
+        assert(stage3Index <= std::numeric_limits<Stage2ElementType>::max());
+        properties.emplace_back(_input[index]);
+        _stage3Indices.emplace(_input[index], static_cast<Stage2ElementType>(stage3Index));
         return static_cast<Stage2ElementType>(stage3Index);
     }
+
+    // Lookup structures for deduplicating stage 2 blocks and stage 3 values.
+    std::unordered_map<std::vector<Stage2ElementType>, Stage1ElementType, detail::block_hash<Stage2ElementType>>
+        _stage2Blocks {};
+    std::unordered_map<T, Stage2ElementType, detail::value_hash<T>> _stage3Indices {};
 };
 
 template <typename T,
@@ -159,17 +204,125 @@ template <typename T,
           typename Stage1ElementType,
           typename Stage2ElementType,
           SourceType BlockSize,
-          SourceType MaxValue = std::numeric_limits<SourceType>::max()>
+          SourceType MaxValue = std::numeric_limits<SourceType>::max(),
+          SourceType DirectSize = 0>
 void generate(
     T const* input,
     size_t inputSize,
-    multistage_table<T, SourceType, Stage1ElementType, Stage2ElementType, BlockSize, MaxValue>& output)
+    multistage_table<T, SourceType, Stage1ElementType, Stage2ElementType, BlockSize, MaxValue, DirectSize>&
+        output)
 {
-    auto builder =
-        multistage_table_generator<T, SourceType, Stage1ElementType, Stage2ElementType, BlockSize, MaxValue> {
-            input, inputSize, output
-        };
+    auto builder = multistage_table_generator<T,
+                                              SourceType,
+                                              Stage1ElementType,
+                                              Stage2ElementType,
+                                              BlockSize,
+                                              MaxValue,
+                                              DirectSize> { input, inputSize, output };
     builder.generate();
 }
 
+/// Size and access characteristics of a multistage table layout, as computed by explore_layout().
+struct multistage_layout_statistics
+{
+    /// Block sizes of the index stages, from the outermost to the innermost one.
+    /// A single block size describes the two-level layout used by multistage_table_view.
+    std::vector<size_t> blockSizes;
+
+    /// Number of elements and bytes per element of each stage, from the first stage to the values.
+    std::vector<size_t> stageSizes;
+    std::vector<size_t> stageElementSizes;
+
+    size_t totalBytes = 0;
+
+    /// Number of cache lines touched by a single lookup (one per stage).
+    size_t cacheLinesPerLookup = 0;
+
+    /// Number of distinct cache lines touched when looking up every index of the probed range.
+    size_t probedCacheLines = 0;
+};
+
+/// Computes the size of a multistage table over the given input for the given index block sizes
+/// (from the outermost to the innermost stage), without materializing the table itself.
+///
+/// @param probeSize number of leading indices whose lookups are simulated
+///                  to compute multistage_layout_statistics::probedCacheLines.
+template <typename T>
+multistage_layout_statistics explore_layout(T const* input,
+                                            size_t inputSize,
+                                            std::vector<size_t> const& blockSizes,
+                                            size_t probeSize,
+                                            size_t cacheLineSize = 64)
+{
+    auto constexpr elementSize = [](std::vector<uint32_t> const& values) -> size_t {
+        auto const maxValue = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+        return maxValue <= 0xFF ? 1 : maxValue <= 0xFFFF ? 2 : 4;
+    };
+
+    // Map the input to value indices.
+    auto values = std::unordered_map<T, uint32_t, detail::value_hash<T>> {};
+    auto current = std::vector<uint32_t>(inputSize);
+    for (size_t i = 0; i < inputSize; ++i)
+        current[i] = values.emplace(input[i], static_cast<uint32_t>(values.size())).first->second;
+
+    // Deduplicate blocks, from the innermost index stage outwards.
+    // Each level replaces the current index array by the block numbers into its unique blocks.
+    auto levels = std::vector<std::vector<uint32_t>> {}; // innermost first
+    for (auto blockSize = blockSizes.rbegin(); blockSize != blockSizes.rend(); ++blockSize)
+    {
+        assert(current.size() % *blockSize == 0);
+        auto blocks = std::unordered_map<std::vector<uint32_t>, uint32_t, detail::block_hash<uint32_t>> {};
+        auto unique = std::vector<uint32_t> {};
+        auto next = std::vector<uint32_t>(current.size() / *blockSize);
+        for (size_t i = 0; i < next.size(); ++i)
+        {
+            auto block = std::vector<uint32_t>(current.begin() + static_cast<std::ptrdiff_t>(i * *blockSize),
+                                               current.begin() + static_cast<std::ptrdiff_t>((i + 1) * *blockSize));
+            auto const [iter, inserted] = blocks.emplace(std::move(block), static_cast<uint32_t>(blocks.size()));
+            if (inserted)
+                unique.insert(unique.end(), iter->first.begin(), iter->first.end());
+            next[i] = iter->second;
+        }
+        levels.emplace_back(std::move(unique));
+        current = std::move(next);
+    }
+    levels.emplace_back(std::move(current));
+    std::reverse(levels.begin(), levels.end()); // outermost first
+
+    auto result = multistage_layout_statistics {};
+    result.blockSizes = blockSizes;
+    for (auto const& level: levels)
+    {
+        result.stageSizes.push_back(level.size());
+        result.stageElementSizes.push_back(elementSize(level));
+    }
+    result.stageSizes.push_back(values.size());
+    result.stageElementSizes.push_back(sizeof(T));
+    for (size_t i = 0; i < result.stageSizes.size(); ++i)
+        result.totalBytes += result.stageSizes[i] * result.stageElementSizes[i];
+    result.cacheLinesPerLookup = result.stageSizes.size();
+
+    // Simulate the lookups of the probed range.
+    auto spans = std::vector<size_t>(blockSizes.size() + 1, 1); // number of inputs covered per element
+    for (size_t i = blockSizes.size(); i > 0; --i)
+        spans[i - 1] = spans[i] * blockSizes[i - 1];
+    auto touched = std::unordered_set<uint64_t> {};
+    for (size_t index = 0; index < std::min(probeSize, inputSize); ++index)
+    {
+        auto position = index / spans[0];
+        for (size_t stage = 0; stage < levels.size(); ++stage)
+        {
+            touched.insert((uint64_t(stage) << 48) | (position * result.stageElementSizes[stage] / cacheLineSize));
+            auto const value = levels[stage][position];
+            position = stage + 1 < levels.size()
+                           ? value * blockSizes[stage] + (index / spans[stage + 1]) % blockSizes[stage]
+                           : value;
+        }
+        touched.insert((uint64_t(levels.size()) << 48) | (position * sizeof(T) / cacheLineSize));
+    }
+    result.probedCacheLines = touched.size();
+
+    return result;
+}
+
 } // namespace support
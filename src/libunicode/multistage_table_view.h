@@ -13,18 +13,40 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 
+#if defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_IX86))
+    #include <xmmintrin.h> // _mm_prefetch
+#endif
+
 namespace support
 {
 
+/// Hints the CPU to fetch the cache line containing the given address.
+inline void prefetch(void const* address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<char const*>(address), _MM_HINT_T0);
+#else
+    (void) address;
+#endif
+}
+
+/// Read-only view onto a multistage lookup table.
+///
+/// If @p DirectSize is non-zero, the values for the indices [0, DirectSize) are additionally
+/// available in a flat table, that is used instead of walking all stages for that (frequently used) range.
 template <typename T,
           typename SourceType,
           typename Stage1ElementType,
           typename Stage2ElementType,
           SourceType BlockSize,
-          SourceType MaxValue = std::numeric_limits<SourceType>::max()>
+          SourceType MaxValue = std::numeric_limits<SourceType>::max(),
+          SourceType DirectSize = 0>
 struct multistage_table_view
 {
     using source_type = SourceType;
@@ -35,23 +57,82 @@ struct multistage_table_view
     stage1_element_type const* stage1; // div
     stage2_element_type const* stage2; // mod
     value_type const* stage3;          // values
+    value_type const* direct {};       // values for [0, DirectSize)
 
     static std::size_t constexpr block_size = BlockSize;
+    static std::size_t constexpr direct_size = DirectSize;
 
     // size_t size() const noexcept { return stage1.size(); }
 
-    value_type const& get(source_type index, source_type fallback = source_type {}) const noexcept
+    constexpr value_type const& get(source_type index, source_type fallback = source_type {}) const noexcept
     {
         return unsafe_get(index <= MaxValue ? index : fallback);
     }
 
-    value_type const& unsafe_get(source_type index) const noexcept
+    constexpr value_type const& unsafe_get(source_type index) const noexcept
+    {
+        if constexpr (DirectSize != 0)
+            if (index < DirectSize)
+                return direct[index];
+
+        return stage3[unsafe_stage3_index(index)];
+    }
+
+    /// Returns the index into stage3 of the value for @p index, walking stage 1 and 2 regardless of
+    /// DirectSize, such that the values of tables sharing these stages can be read off the same walk.
+    constexpr stage2_element_type unsafe_stage3_index(source_type index) const noexcept
     {
         auto const block_number = stage1[index / BlockSize];
         auto const block_start = block_number * BlockSize;
         auto const element_offset = index % BlockSize;
-        auto const property_index = stage2[block_start + element_offset];
-        return stage3[property_index];
+        return stage2[block_start + element_offset];
+    }
+
+    /// Looks up @p count indices at once, storing the values into @p out.
+    ///
+    /// This is semantically equivalent to calling get() for each index,
+    /// but keeps the table loads of consecutive indices independent of each other
+    /// and prefetches ahead, so that their latencies overlap.
+    template <typename Index>
+    void get_many(Index const* in,
+                  std::size_t count,
+                  value_type* out,
+                  source_type fallback = source_type {}) const noexcept
+    {
+        get_many(
+            in, count, out, [](value_type const& value) -> value_type const& { return value; }, fallback);
+    }
+
+    /// Same as get_many() but only storing a projection of each looked up value into @p out,
+    /// such as a single member of it.
+    template <typename Index, typename Output, typename Projection>
+    void get_many(Index const* in,
+                  std::size_t count,
+                  Output* out,
+                  Projection projection,
+                  source_type fallback = source_type {}) const noexcept
+    {
+        constexpr std::size_t PrefetchDistance = 16;
+
+        std::size_t i = 0;
+        for (; i + PrefetchDistance < count; ++i)
+        {
+            prefetch(stage2_address(clamp(static_cast<source_type>(in[i + PrefetchDistance]), fallback)));
+            out[i] = projection(unsafe_get(clamp(static_cast<source_type>(in[i]), fallback)));
+        }
+        for (; i < count; ++i)
+            out[i] = projection(unsafe_get(clamp(static_cast<source_type>(in[i]), fallback)));
+    }
+
+  private:
+    static constexpr source_type clamp(source_type index, source_type fallback) noexcept
+    {
+        return index <= MaxValue ? index : fallback;
+    }
+
+    stage2_element_type const* stage2_address(source_type index) const noexcept
+    {
+        return stage2 + stage1[index / BlockSize] * BlockSize + index % BlockSize;
     }
 };
 
@@ -0,0 +1,365 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/convert.h>
+#include <libunicode/normalization.h>
+#include <libunicode/ucd.h>
+
+#include <cstring>
+#include <iterator>
+#include <optional>
+
+namespace unicode
+{
+
+namespace
+{
+    // Hangul syllable decomposition and composition, as per section 3.12 of the Unicode Standard.
+    constexpr char32_t SBase = 0xAC00;           // NOLINT(readability-identifier-naming)
+    constexpr char32_t LBase = 0x1100;           // NOLINT(readability-identifier-naming)
+    constexpr char32_t VBase = 0x1161;           // NOLINT(readability-identifier-naming)
+    constexpr char32_t TBase = 0x11A7;           // NOLINT(readability-identifier-naming)
+    constexpr char32_t LCount = 19;              // NOLINT(readability-identifier-naming)
+    constexpr char32_t VCount = 21;              // NOLINT(readability-identifier-naming)
+    constexpr char32_t TCount = 28;              // NOLINT(readability-identifier-naming)
+    constexpr char32_t NCount = VCount * TCount; // NOLINT(readability-identifier-naming)
+    constexpr char32_t SCount = LCount * NCount; // NOLINT(readability-identifier-naming)
+
+    constexpr bool is_composing(normalization_form form) noexcept
+    {
+        return form == normalization_form::NFC || form == normalization_form::NFKC;
+    }
+
+    constexpr bool is_compatibility(normalization_form form) noexcept
+    {
+        return form == normalization_form::NFKC || form == normalization_form::NFKD;
+    }
+
+    using tables_view = normalization_properties::tables_view;
+
+    uint8_t combining_class(tables_view const& tables, char32_t codepoint) noexcept
+    {
+        return tables.get(codepoint).canonical_combining_class;
+    }
+
+    /// Checks text codepoint by codepoint, as per section 9 of UAX #15, keeping track of
+    /// the last normalization-stable boundary in front of the first codepoint that is not Yes.
+    class quick_checker
+    {
+      public:
+        quick_checker(normalization_form form, tables_view const& tables) noexcept: _tables { tables }
+        {
+            using P = normalization_properties;
+            switch (form)
+            {
+                case normalization_form::NFC:
+                    _noFlag = P::FlagNFCQuickCheckNo;
+                    _maybeFlag = P::FlagNFCQuickCheckMaybe;
+                    break;
+                case normalization_form::NFD: _noFlag = P::FlagNFDQuickCheckNo; break;
+                case normalization_form::NFKC:
+                    _noFlag = P::FlagNFKCQuickCheckNo;
+                    _maybeFlag = P::FlagNFKCQuickCheckMaybe;
+                    break;
+                case normalization_form::NFKD: _noFlag = P::FlagNFKDQuickCheckNo; break;
+            }
+        }
+
+        [[nodiscard]] quick_check_result result() const noexcept { return _result; }
+
+        /// Offset of the last codepoint in front of the first one that is not Yes, that is a starter
+        /// and never interacts with what precedes it, i.e. where normalization can start from.
+        [[nodiscard]] size_t boundary() const noexcept { return _boundary; }
+
+        /// Checks the codepoint at @p offset, which is US-ASCII and therefore a stable boundary.
+        void ascii(size_t offset) noexcept
+        {
+            _lastCombiningClass = 0;
+            if (_result == quick_check_result::Yes)
+                _boundary = offset;
+        }
+
+        /// Checks the @p codepoint at @p offset.
+        ///
+        /// @returns false if the text is not normalized, such that checking can stop.
+        bool check(char32_t codepoint, size_t offset) noexcept
+        {
+            auto const properties = _tables.get(codepoint);
+            auto const combiningClass = properties.canonical_combining_class;
+            if ((combiningClass != 0 && _lastCombiningClass > combiningClass) || (properties.flags & _noFlag))
+            {
+                _result = quick_check_result::No;
+                return false;
+            }
+            if (properties.flags & _maybeFlag)
+                _result = quick_check_result::Maybe;
+            else if (combiningClass == 0 && _result == quick_check_result::Yes)
+                _boundary = offset;
+            _lastCombiningClass = combiningClass;
+            return true;
+        }
+
+      private:
+        tables_view const& _tables;
+        uint8_t _noFlag = 0;
+        uint8_t _maybeFlag = 0;
+        uint8_t _lastCombiningClass = 0;
+        quick_check_result _result = quick_check_result::Yes;
+        size_t _boundary = 0;
+    };
+
+    void check(std::u32string_view text, quick_checker& checker) noexcept
+    {
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            if (text[i] < 0x80)
+                checker.ascii(i);
+            else if (!checker.check(text[i], i))
+                return;
+        }
+    }
+
+    /// Ill-formed sequences are treated like US-ASCII characters.
+    void check(std::string_view text, quick_checker& checker) noexcept
+    {
+        size_t i = 0;
+        while (i < text.size())
+        {
+            // Skip US-ASCII eight bytes at a time.
+            if (uint64_t bytes = 0; i + sizeof(bytes) <= text.size())
+            {
+                std::memcpy(&bytes, text.data() + i, sizeof(bytes));
+                if ((bytes & 0x8080'8080'8080'8080) == 0)
+                {
+                    i += sizeof(bytes);
+                    checker.ascii(i - 1);
+                    continue;
+                }
+            }
+
+            if (static_cast<uint8_t>(text[i]) < 0x80)
+            {
+                checker.ascii(i++);
+                continue;
+            }
+
+            auto const sequence = decode_utf8_sequence(text.substr(i));
+            if (sequence.status != ConversionStatus::Success)
+                checker.ascii(i);
+            else if (!checker.check(sequence.value, i))
+                return;
+            i += sequence.length;
+        }
+    }
+
+    /// Appends @p codepoint to @p output, in canonical order with the non-starters in front of it
+    /// (behind @p start), that is, stably sorted by their combining class.
+    void append_ordered(tables_view const& tables, char32_t codepoint, std::u32string& output, size_t start)
+    {
+        auto const combiningClass = combining_class(tables, codepoint);
+        auto i = output.size();
+        output.push_back(codepoint);
+        if (combiningClass == 0)
+            return;
+        for (; i > start && combining_class(tables, output[i - 1]) > combiningClass; --i)
+            output[i] = output[i - 1];
+        output[i] = codepoint;
+    }
+
+    void append_decomposed(tables_view const& tables,
+                           char32_t codepoint,
+                           bool compatibility,
+                           std::u32string& output,
+                           size_t start)
+    {
+        if (SBase <= codepoint && codepoint < SBase + SCount)
+        {
+            auto const index = codepoint - SBase;
+            output.push_back(LBase + index / NCount);
+            output.push_back(VBase + (index % NCount) / TCount);
+            if (index % TCount != 0)
+                output.push_back(TBase + index % TCount);
+            return;
+        }
+
+        auto const decomposition =
+            compatibility ? compatibility_decomposition(codepoint) : canonical_decomposition(codepoint);
+        if (decomposition.empty())
+            append_ordered(tables, codepoint, output, start);
+        else
+            for (auto const c: decomposition)
+                append_ordered(tables, c, output, start);
+    }
+
+    std::optional<char32_t> compose(char32_t first, char32_t second) noexcept
+    {
+        if (LBase <= first && first < LBase + LCount && VBase <= second && second < VBase + VCount)
+            return SBase + ((first - LBase) * VCount + (second - VBase)) * TCount;
+
+        if (SBase <= first && first < SBase + SCount && (first - SBase) % TCount == 0 && TBase < second
+            && second < TBase + TCount)
+            return first + (second - TBase);
+
+        return primary_composite(first, second);
+    }
+
+    /// Canonically composes the fully decomposed text in @p output behind @p start, in place,
+    /// as per definition D117 of the Unicode Standard.
+    void compose(tables_view const& tables, std::u32string& output, size_t start)
+    {
+        if (output.size() <= start)
+            return;
+
+        // The last kept codepoint's combining class, where a non-starter at the start of the text
+        // has none to compose with.
+        auto starter = start;
+        auto lastCombiningClass = combining_class(tables, output[start]) == 0 ? 0 : 256;
+        auto end = start + 1;
+        for (auto i = start + 1; i < output.size(); ++i)
+        {
+            auto const codepoint = output[i];
+            auto const combiningClass = static_cast<int>(combining_class(tables, codepoint));
+            if (lastCombiningClass < combiningClass || lastCombiningClass == 0)
+            {
+                if (auto const composite = compose(output[starter], codepoint); composite.has_value())
+                {
+                    output[starter] = *composite;
+                    continue;
+                }
+            }
+            if (combiningClass == 0)
+                starter = end;
+            lastCombiningClass = combiningClass;
+            output[end++] = codepoint;
+        }
+        output.resize(end);
+    }
+
+    /// Appends @p text normalized into @p output, which must end at a normalization-stable boundary.
+    void append_normalized(std::u32string_view text,
+                           normalization_form form,
+                           tables_view const& tables,
+                           std::u32string& output)
+    {
+        auto const start = output.size();
+        for (auto const codepoint: text)
+            append_decomposed(tables, codepoint, is_compatibility(form), output, start);
+        if (is_composing(form))
+            compose(tables, output, start);
+    }
+} // namespace
+
+quick_check_result quick_check(std::u32string_view text, normalization_form form) noexcept
+{
+    auto const tables = normalization_properties::configured_tables();
+    auto checker = quick_checker { form, tables };
+    check(text, checker);
+    return checker.result();
+}
+
+quick_check_result quick_check(std::string_view text, normalization_form form) noexcept
+{
+    auto const tables = normalization_properties::configured_tables();
+    auto checker = quick_checker { form, tables };
+    check(text, checker);
+    return checker.result();
+}
+
+std::u32string_view normalizer::operator()(std::u32string_view text)
+{
+    auto const tables = normalization_properties::configured_tables();
+    auto checker = quick_checker { _form, tables };
+    check(text, checker);
+    if (checker.result() == quick_check_result::Yes)
+        return text;
+
+    _output.assign(text.substr(0, checker.boundary()));
+    append_normalized(text.substr(checker.boundary()), _form, tables, _output);
+    if (_output == text)
+        return text;
+    return _output;
+}
+
+std::string_view normalizer::operator()(std::string_view text)
+{
+    auto const tables = normalization_properties::configured_tables();
+    auto checker = quick_checker { _form, tables };
+    check(text, checker);
+    if (checker.result() == quick_check_result::Yes)
+        return text;
+
+    _encoded.assign(text.substr(0, checker.boundary()));
+
+    // Normalizes each run of well-formed UTF-8 sequences, copying the ill-formed ones between them.
+    auto const flush = [&]() {
+        _output.clear();
+        append_normalized(_decoded, _form, tables, _output);
+        for (auto const codepoint: _output)
+            encoder<char> {}(codepoint, std::back_inserter(_encoded));
+        _decoded.clear();
+    };
+
+    _decoded.clear();
+    for (auto i = checker.boundary(); i < text.size();)
+    {
+        auto const sequence = decode_utf8_sequence(text.substr(i));
+        if (sequence.status == ConversionStatus::Success)
+            _decoded.push_back(sequence.value);
+        else
+        {
+            flush();
+            _encoded.append(text.substr(i, sequence.length));
+        }
+        i += sequence.length;
+    }
+    flush();
+
+    if (_encoded == text)
+        return text;
+    return _encoded;
+}
+
+bool is_normalized(std::u32string_view text, normalization_form form)
+{
+    switch (quick_check(text, form))
+    {
+        case quick_check_result::Yes: return true;
+        case quick_check_result::No: return false;
+        case quick_check_result::Maybe: break;
+    }
+    return normalizer { form }(text) == text;
+}
+
+bool is_normalized(std::string_view text, normalization_form form)
+{
+    switch (quick_check(text, form))
+    {
+        case quick_check_result::Yes: return true;
+        case quick_check_result::No: return false;
+        case quick_check_result::Maybe: break;
+    }
+    return normalizer { form }(text) == text;
+}
+
+std::u32string normalize(std::u32string_view text, normalization_form form)
+{
+    return std::u32string(normalizer { form }(text));
+}
+
+std::string normalize(std::string_view text, normalization_form form)
+{
+    return std::string(normalizer { form }(text));
+}
+
+} // namespace unicode
@@ -0,0 +1,98 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace unicode
+{
+
+/// The Unicode normalization forms, as per UAX #15.
+enum class normalization_form : uint8_t
+{
+    NFC,
+    NFD,
+    NFKC,
+    NFKD,
+};
+
+/// Result of quick_check().
+enum class quick_check_result : uint8_t
+{
+    /// The text is in the normalization form.
+    Yes,
+    /// The text is not in the normalization form.
+    No,
+    /// The text may or may not be in the normalization form, which is only known once it is normalized.
+    Maybe,
+};
+
+/// Tests whether @p text is in the normalization @p form, as per section 9 of UAX #15,
+/// in a single pass over the text, without normalizing it.
+[[nodiscard]] quick_check_result quick_check(std::u32string_view text, normalization_form form) noexcept;
+
+/// Same as quick_check(std::u32string_view, normalization_form), but for UTF-8 encoded @p text.
+///
+/// Ill-formed UTF-8 sequences are treated like US-ASCII characters, i.e. as starters that never interact
+/// with what surrounds them.
+[[nodiscard]] quick_check_result quick_check(std::string_view text, normalization_form form) noexcept;
+
+/// Normalizes text into a normalization form, reusing its buffers for the normalized text,
+/// such that normalizing text repeatedly (e.g. each line of user input) does not allocate anymore,
+/// once the buffers have grown to the longest text.
+///
+/// Text that is already normalized, as far as quick_check() can tell, is returned as is,
+/// without copying it. Otherwise, only the text from the last normalization-stable boundary in front
+/// of the first unnormalized codepoint onwards is normalized, copying what precedes it unchanged.
+class normalizer
+{
+  public:
+    explicit normalizer(normalization_form form) noexcept: _form { form } {}
+
+    [[nodiscard]] normalization_form form() const noexcept { return _form; }
+
+    /// Normalizes @p text.
+    ///
+    /// @returns either @p text itself, if it is already normalized, or the normalized text,
+    ///          pointing into this normalizer, being valid until it is used again.
+    [[nodiscard]] std::u32string_view operator()(std::u32string_view text);
+
+    /// Same as operator()(std::u32string_view), but for UTF-8 encoded @p text.
+    ///
+    /// Ill-formed UTF-8 sequences are copied unchanged.
+    [[nodiscard]] std::string_view operator()(std::string_view text);
+
+  private:
+    normalization_form _form;
+    std::u32string _output;
+    std::u32string _decoded; // Codepoints of the UTF-8 text being normalized.
+    std::string _encoded;
+};
+
+/// Tests whether @p text is in the normalization @p form, normalizing it only if quick_check() cannot tell.
+[[nodiscard]] bool is_normalized(std::u32string_view text, normalization_form form);
+
+/// Same as is_normalized(std::u32string_view, normalization_form), but for UTF-8 encoded @p text.
+[[nodiscard]] bool is_normalized(std::string_view text, normalization_form form);
+
+/// Returns @p text normalized into the normalization @p form.
+[[nodiscard]] std::u32string normalize(std::u32string_view text, normalization_form form);
+
+/// Returns the UTF-8 encoded @p text normalized into the normalization @p form,
+/// with ill-formed UTF-8 sequences being copied unchanged.
+[[nodiscard]] std::string normalize(std::string_view text, normalization_form form);
+
+} // namespace unicode
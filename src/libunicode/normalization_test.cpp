@@ -0,0 +1,145 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/convert.h>
+#include <libunicode/normalization.h>
+#include <libunicode/ucd.h>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+
+using namespace std::string_view_literals;
+using unicode::normalization_form;
+using unicode::normalize;
+using unicode::normalizer;
+using unicode::quick_check;
+using unicode::quick_check_result;
+
+namespace
+{
+
+// Asserts the normalization of @p source into each form, as in the columns of NormalizationTest.txt.
+void check_forms(std::u32string_view source,
+                 std::u32string_view nfc,
+                 std::u32string_view nfd,
+                 std::u32string_view nfkc,
+                 std::u32string_view nfkd)
+{
+    INFO(unicode::convert_to<char>(source));
+    CHECK(normalize(source, normalization_form::NFC) == nfc);
+    CHECK(normalize(source, normalization_form::NFD) == nfd);
+    CHECK(normalize(source, normalization_form::NFKC) == nfkc);
+    CHECK(normalize(source, normalization_form::NFKD) == nfkd);
+}
+
+} // namespace
+
+TEST_CASE("normalization.properties", "[normalization]")
+{
+    using unicode::normalization_properties;
+    CHECK(normalization_properties::get(U'a').canonical_combining_class == 0);
+    CHECK(normalization_properties::get(U'\u0301').canonical_combining_class == 230);
+    CHECK(normalization_properties::get(U'\u0323').canonical_combining_class == 220);
+    CHECK(normalization_properties::get(U'\u0301').nfc_quick_check() == unicode::NFC_Quick_Check::Maybe);
+    CHECK(normalization_properties::get(U'\u0340').nfc_quick_check() == unicode::NFC_Quick_Check::No);
+    CHECK(normalization_properties::get(U'\u00E9').nfc_quick_check() == unicode::NFC_Quick_Check::Yes);
+    CHECK(!normalization_properties::get(U'\u00E9').nfd_quick_check());
+    CHECK(normalization_properties::get(U'\uFB01').nfkc_quick_check() == unicode::NFKC_Quick_Check::No);
+    CHECK(!normalization_properties::get(U'\uFB01').nfkd_quick_check());
+
+    CHECK(unicode::canonical_decomposition(U'\u00C5') == U"A\u030A");
+    CHECK(unicode::canonical_decomposition(U'\u1E69') == U"s\u0323\u0307");
+    CHECK(unicode::canonical_decomposition(U'\uFB01').empty());
+    CHECK(unicode::compatibility_decomposition(U'\uFB01') == U"fi");
+    CHECK(unicode::primary_composite(U'A', U'\u030A') == U'\u00C5');
+    CHECK(!unicode::primary_composite(U'\u0915', U'\u093C').has_value()); // U+0958 is excluded.
+}
+
+TEST_CASE("normalization.forms", "[normalization]")
+{
+    // Canonical equivalents.
+    check_forms(U"\u00C5", U"\u00C5", U"A\u030A", U"\u00C5", U"A\u030A");
+    check_forms(U"\u212B", U"\u00C5", U"A\u030A", U"\u00C5", U"A\u030A");
+    check_forms(U"\u1E0B\u0323", U"\u1E0D\u0307", U"d\u0323\u0307", U"\u1E0D\u0307", U"d\u0323\u0307");
+    check_forms(U"q\u0307\u0323", U"q\u0323\u0307", U"q\u0323\u0307", U"q\u0323\u0307", U"q\u0323\u0307");
+
+    // Compatibility equivalents.
+    check_forms(U"\uFB01", U"\uFB01", U"\uFB01", U"fi", U"fi");
+    check_forms(U"x\u2075", U"x\u2075", U"x\u2075", U"x5", U"x5");
+    check_forms(U"\u1E9B\u0323", U"\u1E9B\u0323", U"\u017F\u0323\u0307", U"\u1E69", U"s\u0323\u0307");
+
+    // Composition exclusions and blocked composition.
+    check_forms(U"\u0958", U"\u0915\u093C", U"\u0915\u093C", U"\u0915\u093C", U"\u0915\u093C");
+    check_forms(U"a\u0301\u0301", U"\u00E1\u0301", U"a\u0301\u0301", U"\u00E1\u0301", U"a\u0301\u0301");
+    check_forms(U"\u0301a", U"\u0301a", U"\u0301a", U"\u0301a", U"\u0301a");
+
+    // Hangul syllables.
+    check_forms(U"\uAC00", U"\uAC00", U"\u1100\u1161", U"\uAC00", U"\u1100\u1161");
+    check_forms(U"\uD4DB", U"\uD4DB", U"\u1111\u1171\u11B6", U"\uD4DB", U"\u1111\u1171\u11B6");
+    check_forms(U"\u1111\u1171\u11B6", U"\uD4DB", U"\u1111\u1171\u11B6", U"\uD4DB", U"\u1111\u1171\u11B6");
+
+    check_forms(U"", U"", U"", U"", U"");
+}
+
+TEST_CASE("normalization.quick_check", "[normalization]")
+{
+    CHECK(quick_check(U"Hello, World!"sv, normalization_form::NFC) == quick_check_result::Yes);
+    CHECK(quick_check(U"\u00E9t\u00E9"sv, normalization_form::NFC) == quick_check_result::Yes);
+    CHECK(quick_check(U"\u00E9t\u00E9"sv, normalization_form::NFD) == quick_check_result::No);
+    CHECK(quick_check(U"e\u0301"sv, normalization_form::NFC) == quick_check_result::Maybe);
+    CHECK(quick_check(U"e\u0301"sv, normalization_form::NFD) == quick_check_result::Yes);
+    CHECK(quick_check(U"a\u0307\u0323"sv, normalization_form::NFD) == quick_check_result::No);
+    CHECK(quick_check(U"\uFB01"sv, normalization_form::NFC) == quick_check_result::Yes);
+    CHECK(quick_check(U"\uFB01"sv, normalization_form::NFKC) == quick_check_result::No);
+
+    CHECK(quick_check("Hello, World!"sv, normalization_form::NFC) == quick_check_result::Yes);
+    CHECK(quick_check("e\xCC\x81"sv, normalization_form::NFC) == quick_check_result::Maybe);
+    CHECK(quick_check("\xC3\xA9"sv, normalization_form::NFD) == quick_check_result::No);
+    CHECK(quick_check("\xFF\xCC\x81"sv, normalization_form::NFD) == quick_check_result::Yes);
+
+    CHECK(unicode::is_normalized(U"x\u0301"sv, normalization_form::NFC));
+    CHECK(!unicode::is_normalized(U"e\u0301"sv, normalization_form::NFC));
+    CHECK(!unicode::is_normalized("e\xCC\x81"sv, normalization_form::NFC));
+}
+
+TEST_CASE("normalization.normalizer", "[normalization]")
+{
+    auto nfc = normalizer { normalization_form::NFC };
+
+    // Normalized text is returned as is, also if that is only known after normalizing it.
+    for (auto const text: { U"Hello, World!"sv, U"\u00E9t\u00E9"sv, U"x\u0301"sv, U""sv })
+    {
+        auto const result = nfc(text);
+        CHECK(result.data() == text.data());
+        CHECK(result.size() == text.size());
+    }
+    auto const ascii = "Hello, World! The quick brown fox jumps over the lazy dog."sv;
+    CHECK(nfc(ascii).data() == ascii.data());
+
+    // Only the text from the last stable boundary onwards is normalized.
+    CHECK(nfc(U"Caf\u00E9, cafe\u0301, cafe\u0301\u0323!"sv) == U"Caf\u00E9, caf\u00E9, caf\u1EB9\u0301!"sv);
+    CHECK(nfc(U"abcdefghe\u0301"sv) == U"abcdefgh\u00E9"sv);
+    CHECK(nfc("cafe\xCC\x81"sv) == "caf\xC3\xA9"sv);
+    CHECK(nfc("The quick brown fox caf\xC3\xA9 cafe\xCC\x81"sv)
+          == "The quick brown fox caf\xC3\xA9 caf\xC3\xA9"sv);
+    CHECK(normalize("\xEF\xAC\x81x"sv, normalization_form::NFKD) == "fix"sv);
+
+    // Ill-formed UTF-8 sequences are copied unchanged, separating the text around them.
+    CHECK(nfc("\xFF"
+              "e\xCC\x81\xE2\x82"
+              "\xCC\x81"sv)
+          == "\xFF\xC3\xA9\xE2\x82\xCC\x81"sv);
+}
@@ -0,0 +1,59 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/orientation_segmenter.h>
+
+namespace unicode
+{
+
+namespace
+{
+    bool is_extender(codepoint_properties const& properties) noexcept
+    {
+        return properties.grapheme_cluster_break == Grapheme_Cluster_Break::Extend
+               || properties.grapheme_cluster_break == Grapheme_Cluster_Break::ZWJ;
+    }
+} // namespace
+
+bool orientation_segmenter::consume(out<size_t> size, out<TextOrientation> orientation) noexcept
+{
+    if (offset_ >= size_)
+        return false;
+
+    auto const tables = codepoint_properties::configured_tables();
+
+    // Leading extenders have nothing to extend, and thus get the orientation of the codepoint behind them.
+    auto current = TextOrientation::Sideways;
+    for (auto i = offset_; i < size_; ++i)
+    {
+        auto const properties = tables.get(text_[i]);
+        if (!is_extender(properties))
+        {
+            current = orientation_of(properties);
+            break;
+        }
+    }
+
+    for (++offset_; offset_ < size_; ++offset_)
+    {
+        auto const properties = tables.get(text_[offset_]);
+        if (!is_extender(properties) && orientation_of(properties) != current)
+            break;
+    }
+
+    *size = offset_;
+    *orientation = current;
+    return true;
+}
+
+} // namespace unicode
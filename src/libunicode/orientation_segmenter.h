@@ -0,0 +1,94 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/support.h>
+#include <libunicode/ucd_enums.h>
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+namespace unicode
+{
+
+/// Orientation of text set in vertical lines of mixed orientation (CSS text-orientation: mixed).
+enum class TextOrientation
+{
+    /// Set upright, for the Vertical_Orientation U, Tu and Tr,
+    /// where the latter two are to be shaped with vertical alternates (the OpenType feature vert).
+    Upright,
+    /// Set sideways, i.e. rotated 90 degrees clockwise, for the Vertical_Orientation R.
+    Sideways,
+};
+
+/// Segments text into runs of the same TextOrientation, as per UAX #50, e.g. as part of a
+/// basic_run_segmenter.
+///
+/// Combining marks and other grapheme cluster extenders (Grapheme_Cluster_Break Extend and ZWJ)
+/// are set in the orientation of the codepoint they extend, rather than their own.
+class orientation_segmenter
+{
+  public:
+    using property_type = TextOrientation;
+
+    constexpr orientation_segmenter() noexcept = default;
+
+    constexpr orientation_segmenter(char32_t const* text, size_t size) noexcept:
+        text_ { text }, size_ { size }
+    {
+    }
+
+    constexpr explicit orientation_segmenter(std::u32string_view text) noexcept:
+        orientation_segmenter(text.data(), text.size())
+    {
+    }
+
+    bool consume(out<size_t> size, out<TextOrientation> orientation) noexcept;
+
+    /// @returns the orientation of a codepoint of the given properties.
+    [[nodiscard]] static constexpr TextOrientation orientation_of(
+        codepoint_properties const& properties) noexcept
+    {
+        return properties.vertical_orientation == Vertical_Orientation::Rotated ? TextOrientation::Sideways
+                                                                                : TextOrientation::Upright;
+    }
+
+  private:
+    char32_t const* text_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& os, TextOrientation value)
+{
+    switch (value)
+    {
+        case TextOrientation::Upright: return os << "Upright";
+        case TextOrientation::Sideways: return os << "Sideways";
+    }
+    return os;
+}
+
+} // namespace unicode
+
+// clang-format off
+#if __has_include(<fmt/ostream.h>)
+#include <fmt/ostream.h>
+#if FMT_VERSION >= (9 * 10000 + 1 * 100 + 0)
+template <> struct fmt::formatter<unicode::TextOrientation>: fmt::ostream_formatter {};
+#endif
+#endif
+// clang-format on
@@ -0,0 +1,84 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/orientation_segmenter.h>
+#include <libunicode/run_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace unicode;
+
+namespace
+{
+std::vector<std::pair<size_t, TextOrientation>> orientations(std::u32string_view text)
+{
+    auto runs = std::vector<std::pair<size_t, TextOrientation>> {};
+    auto segmenter = orientation_segmenter { text };
+    auto end = size_t { 0 };
+    auto orientation = TextOrientation::Upright;
+    while (segmenter.consume(out(end), out(orientation)))
+        runs.emplace_back(end, orientation);
+    return runs;
+}
+} // namespace
+
+TEST_CASE("orientation_segmenter.empty", "[orientation_segmenter]")
+{
+    CHECK(orientations(U"").empty());
+}
+
+TEST_CASE("orientation_segmenter.HangulSpace", "[orientation_segmenter]")
+{
+    CHECK(orientations(U"\uD0A4\uC2A4\uC758 \uACE0\uC720\uC870\uAC74\uC740")
+          == std::vector<std::pair<size_t, TextOrientation>> {
+              { 3, TextOrientation::Upright },
+              { 4, TextOrientation::Sideways },
+              { 9, TextOrientation::Upright },
+          });
+}
+
+TEST_CASE("orientation_segmenter.combining", "[orientation_segmenter]")
+{
+    // Combining marks take the orientation of their base, or of the codepoint following them, if leading.
+    CHECK(orientations(U"\u4E00\u0301\u4E8C") == std::vector { std::pair { size_t { 3 }, TextOrientation::Upright } });
+    CHECK(orientations(U"a\u0301\u4E00")
+          == std::vector<std::pair<size_t, TextOrientation>> {
+              { 2, TextOrientation::Sideways },
+              { 3, TextOrientation::Upright },
+          });
+    CHECK(orientations(U"\u0301\u0300\u4E00") == std::vector { std::pair { size_t { 3 }, TextOrientation::Upright } });
+}
+
+TEST_CASE("orientation_segmenter.run_segmenter", "[orientation_segmenter]")
+{
+    using range = vertical_run_segmenter::range;
+
+    // Japanese with punctuation mixed inside, set sideways.
+    auto const text = std::u32string_view(U"\u3044\u308D\u306F\u306B.\u00A1\u307B\u3078\u3068");
+    auto segmenter = vertical_run_segmenter { text };
+    auto runs = std::vector<range> {};
+    auto run = range {};
+    while (segmenter.consume(out(run)))
+        runs.push_back(run);
+
+    CHECK(runs
+          == std::vector<range> {
+              range { 0, 4, { Script::Hiragana, PresentationStyle::Text, TextOrientation::Upright } },
+              range { 4, 6, { Script::Hiragana, PresentationStyle::Text, TextOrientation::Sideways } },
+              range { 6, 9, { Script::Hiragana, PresentationStyle::Text, TextOrientation::Upright } },
+          });
+}
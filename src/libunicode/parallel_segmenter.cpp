@@ -0,0 +1,119 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/parallel_segmenter.h>
+#include <libunicode/utf8_grapheme_segmenter.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+using std::string_view;
+using std::vector;
+
+namespace unicode
+{
+
+namespace
+{
+    // Tests if a grapheme cluster always ends at the given byte, and the next UTF-8 sequence
+    // starts right after it. CR is excluded as it does not break before LF (GB3).
+    constexpr bool is_resynchronization_point(char ch) noexcept
+    {
+        return static_cast<uint8_t>(ch) < 0x20 && ch != '\r';
+    }
+} // namespace
+
+vector<string_view> split_at_resynchronization_points(string_view text, size_t maxChunkCount)
+{
+    auto chunks = vector<string_view> {};
+    chunks.reserve(std::max(size_t { 1 }, maxChunkCount));
+
+    size_t chunkStart = 0;
+    for (size_t i = 1; i < maxChunkCount; ++i)
+    {
+        auto const target = std::max(chunkStart, text.size() / maxChunkCount * i);
+        auto const found = std::find_if(text.begin() + static_cast<std::ptrdiff_t>(target), text.end(),
+                                        is_resynchronization_point);
+        if (found == text.end())
+            break;
+
+        auto const chunkEnd = static_cast<size_t>(std::distance(text.begin(), found)) + 1;
+        if (chunkEnd == text.size())
+            break;
+
+        chunks.emplace_back(text.substr(chunkStart, chunkEnd - chunkStart));
+        chunkStart = chunkEnd;
+    }
+    chunks.emplace_back(text.substr(chunkStart));
+
+    return chunks;
+}
+
+size_t default_thread_count() noexcept
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+grapheme_cluster_totals count_grapheme_clusters(string_view text) noexcept
+{
+    auto totals = grapheme_cluster_totals {};
+    for (auto const& cluster: utf8_grapheme_cluster_segmenter(text))
+    {
+        ++totals.count;
+        totals.columns += cluster.width;
+    }
+    return totals;
+}
+
+grapheme_cluster_totals parallel_count_grapheme_clusters(string_view text, size_t threadCount)
+{
+    auto totals = grapheme_cluster_totals {};
+    for (auto const& chunkTotals: parallel_for_each_chunk<grapheme_cluster_totals>(
+             text, threadCount, [](string_view chunk) { return count_grapheme_clusters(chunk); }))
+        totals += chunkTotals;
+    return totals;
+}
+
+vector<size_t> grapheme_cluster_offsets(string_view text)
+{
+    auto offsets = vector<size_t> {};
+    for (auto const& cluster: utf8_grapheme_cluster_segmenter(text))
+        offsets.push_back(static_cast<size_t>(cluster.text.data() - text.data()));
+    return offsets;
+}
+
+vector<size_t> parallel_grapheme_cluster_offsets(string_view text, size_t threadCount)
+{
+    auto const chunkOffsets =
+        parallel_for_each_chunk<vector<size_t>>(text, threadCount, [text](string_view chunk) {
+            // Offsets are made relative to the whole text right away, for merging to be a plain copy.
+            auto offsets = grapheme_cluster_offsets(chunk);
+            auto const chunkStart = static_cast<size_t>(chunk.data() - text.data());
+            for (auto& offset: offsets)
+                offset += chunkStart;
+            return offsets;
+        });
+
+    auto size = size_t { 0 };
+    for (auto const& offsets: chunkOffsets)
+        size += offsets.size();
+
+    auto result = vector<size_t> {};
+    result.reserve(size);
+    for (auto const& offsets: chunkOffsets)
+        result.insert(result.end(), offsets.begin(), offsets.end());
+    return result;
+}
+
+} // namespace unicode
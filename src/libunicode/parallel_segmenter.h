@@ -0,0 +1,134 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace unicode
+{
+
+/// Totals of the grapheme clusters of a UTF-8 text, as segmented by utf8_grapheme_cluster_segmenter.
+struct grapheme_cluster_totals
+{
+    size_t count = 0;   // Number of grapheme clusters.
+    size_t columns = 0; // Sum of the widths of all grapheme clusters.
+
+    constexpr grapheme_cluster_totals& operator+=(grapheme_cluster_totals const& other) noexcept
+    {
+        count += other.count;
+        columns += other.columns;
+        return *this;
+    }
+
+    constexpr bool operator==(grapheme_cluster_totals const& other) const noexcept
+    {
+        return count == other.count && columns == other.columns;
+    }
+};
+
+/// Minimum number of bytes worth handing over to another thread.
+constexpr size_t MinimumParallelChunkSize = 64 * 1024; // NOLINT(readability-identifier-naming)
+
+/// Splits UTF-8 @p text into at most @p maxChunkCount chunks of about the same size.
+///
+/// Chunks end right after a resynchronization point, i.e. an LF or any other C0 control character
+/// except for CR. Grapheme clusters never span such a point (GB4), and neither do UTF-8 sequences,
+/// so segmenting each chunk on its own yields the same grapheme clusters as segmenting the whole text.
+///
+/// Chunks are merged if there is no resynchronization point in between.
+std::vector<std::string_view> split_at_resynchronization_points(std::string_view text, size_t maxChunkCount);
+
+/// Invokes @p process for each chunk of @p text (see split_at_resynchronization_points()),
+/// on up to @p threadCount threads, and returns the results in the order of the chunks.
+///
+/// Texts are not split into chunks smaller than MinimumParallelChunkSize, and a single chunk
+/// is processed on the calling thread. If @p process throws, the exception of the first chunk
+/// that failed is rethrown on the calling thread once all chunks are processed.
+template <typename Result, typename Process>
+std::vector<Result> parallel_for_each_chunk(std::string_view text, size_t threadCount, Process process)
+{
+    auto const maxChunkCount =
+        std::max(size_t { 1 }, std::min(threadCount, text.size() / MinimumParallelChunkSize));
+    auto const chunks = split_at_resynchronization_points(text, maxChunkCount);
+    auto results = std::vector<Result>(chunks.size());
+
+    if (chunks.size() == 1)
+    {
+        results[0] = process(chunks[0]);
+        return results;
+    }
+
+    auto errors = std::vector<std::exception_ptr>(chunks.size());
+    auto const processChunk = [&](size_t i) noexcept {
+        try
+        {
+            results[i] = process(chunks[i]);
+        }
+        catch (...)
+        {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    auto threads = std::vector<std::thread> {};
+    auto const joinAll = [&]() {
+        for (auto& thread: threads)
+            thread.join();
+    };
+
+    try
+    {
+        threads.reserve(chunks.size() - 1);
+        for (size_t i = 1; i < chunks.size(); ++i)
+            threads.emplace_back(processChunk, i);
+    }
+    catch (...)
+    {
+        joinAll();
+        throw;
+    }
+
+    processChunk(0);
+    joinAll();
+
+    for (auto const& error: errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    return results;
+}
+
+/// Returns the default number of threads to use, being the number of hardware threads.
+[[nodiscard]] size_t default_thread_count() noexcept;
+
+/// Sums up the grapheme clusters of @p text and their widths.
+[[nodiscard]] grapheme_cluster_totals count_grapheme_clusters(std::string_view text) noexcept;
+
+/// Same as count_grapheme_clusters() but processing chunks of @p text in parallel.
+[[nodiscard]] grapheme_cluster_totals parallel_count_grapheme_clusters(
+    std::string_view text, size_t threadCount = default_thread_count());
+
+/// Returns the offsets in bytes into @p text at which a grapheme cluster starts.
+[[nodiscard]] std::vector<size_t> grapheme_cluster_offsets(std::string_view text);
+
+/// Same as grapheme_cluster_offsets() but processing chunks of @p text in parallel.
+[[nodiscard]] std::vector<size_t> parallel_grapheme_cluster_offsets(
+    std::string_view text, size_t threadCount = default_thread_count());
+
+} // namespace unicode
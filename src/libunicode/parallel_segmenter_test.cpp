@@ -0,0 +1,91 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/parallel_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace unicode;
+using namespace std::string_view_literals;
+
+TEST_CASE("parallel_segmenter.split")
+{
+    CHECK(split_at_resynchronization_points(""sv, 4) == std::vector<std::string_view> { ""sv });
+    CHECK(split_at_resynchronization_points("abc"sv, 4) == std::vector<std::string_view> { "abc"sv });
+    CHECK(split_at_resynchronization_points("ab\ncd\nef\ngh"sv, 4)
+          == std::vector<std::string_view> { "ab\n"sv, "cd\n"sv, "ef\n"sv, "gh"sv });
+    CHECK(split_at_resynchronization_points("ab\ncd\nef\ngh"sv, 2)
+          == std::vector<std::string_view> { "ab\ncd\n"sv, "ef\ngh"sv });
+
+    // Chunks are merged if there is no resynchronization point in between.
+    CHECK(split_at_resynchronization_points("abcdefgh\n"sv, 4)
+          == std::vector<std::string_view> { "abcdefgh\n"sv });
+    CHECK(split_at_resynchronization_points("abcdefg\nh"sv, 4)
+          == std::vector<std::string_view> { "abcdefg\n"sv, "h"sv });
+
+    // Not between CR and LF, but after other controls.
+    CHECK(split_at_resynchronization_points("abc\r\ndef"sv, 2)
+          == std::vector<std::string_view> { "abc\r\n"sv, "def"sv });
+    CHECK(split_at_resynchronization_points("abc\tdef"sv, 2)
+          == std::vector<std::string_view> { "abc\t"sv, "def"sv });
+}
+
+TEST_CASE("parallel_segmenter.same_as_sequential")
+{
+    auto const line = convert_to<char>(
+        std::u32string_view(U"Hello, 世界!\r\n\U0001F1E9\U0001F1EA\U0001F468‍\U0001F469‍\U0001F467"
+                            U"é©️\t각\n"));
+    auto text = std::string {};
+    while (text.size() < 8 * MinimumParallelChunkSize)
+    {
+        text += line;
+        text += "\xE2\x82"; // ill-formed, followed by a resynchronization point
+        text += "\x1B";
+    }
+
+    auto const totals = count_grapheme_clusters(text);
+    auto const offsets = grapheme_cluster_offsets(text);
+    CHECK(totals.count == offsets.size());
+
+    for (auto const threadCount: { size_t { 1 }, size_t { 2 }, size_t { 3 }, size_t { 8 }, size_t { 64 } })
+    {
+        INFO("threads: " << threadCount);
+        auto const chunks = split_at_resynchronization_points(text, threadCount);
+        CHECK(chunks.size() == threadCount);
+        CHECK(parallel_count_grapheme_clusters(text, threadCount) == totals);
+        CHECK(parallel_grapheme_cluster_offsets(text, threadCount) == offsets);
+    }
+}
+
+TEST_CASE("parallel_segmenter.exception")
+{
+    // An exception thrown on any thread is rethrown on the calling one, after all threads are done.
+    auto text = std::string {};
+    while (text.size() < 4 * MinimumParallelChunkSize)
+        text += "abc\n";
+    auto const chunks = split_at_resynchronization_points(text, 4);
+    REQUIRE(chunks.size() == 4);
+    auto const lastChunk = chunks.back();
+    auto const process = [&](std::string_view chunk) -> size_t {
+        if (chunk.data() == lastChunk.data())
+            throw std::runtime_error("failed");
+        return chunk.size();
+    };
+    CHECK_THROWS_AS(parallel_for_each_chunk<size_t>(text, 4, process), std::runtime_error);
+}
@@ -13,7 +13,9 @@
  */
 #pragma once
 
+#include <libunicode/bidi_segmenter.h>
 #include <libunicode/emoji_segmenter.h>
+#include <libunicode/orientation_segmenter.h>
 #include <libunicode/script_segmenter.h>
 #include <libunicode/support.h>
 #include <libunicode/ucd.h>
@@ -23,6 +25,7 @@
 #include <iterator>
 #include <ostream>
 #include <tuple>
+#include <utility>
 
 namespace unicode
 {
@@ -49,6 +52,8 @@ namespace detail
 ///
 /// @see script_segmenter
 /// @see emoji_segmenter
+/// @see bidi_segmenter
+/// @see orientation_segmenter
 /// @see grapheme_segmenter
 template <typename... Segmenter>
 class basic_run_segmenter
@@ -92,6 +97,13 @@ class basic_run_segmenter
         initialize<0, Segmenter...>(text, size);
     }
 
+    /// Same as above, but with segmenters constructed by the caller, e.g. with resources of their own
+    /// (such as a bidi_segmenter with a caller-owned bidi_arena).
+    basic_run_segmenter(std::u32string_view sv, Segmenter... segmenters):
+        segmenter_ { std::move(segmenters)... }, size_ { sv.size() }
+    {
+    }
+
     constexpr bool finished() const noexcept { return lastSplit_ >= size_; }
 
     /// Splits input text into segments, such as pure text by script, emoji-emoji, or emoji-text.
@@ -177,4 +189,10 @@ class basic_run_segmenter
 
 using run_segmenter = basic_run_segmenter<script_segmenter, emoji_segmenter>;
 
+/// Same as run_segmenter, but also segmenting by resolved bidi embedding level.
+using bidi_run_segmenter = basic_run_segmenter<script_segmenter, emoji_segmenter, bidi_segmenter>;
+
+/// Same as run_segmenter, but also segmenting by orientation, for text set in vertical lines.
+using vertical_run_segmenter = basic_run_segmenter<script_segmenter, emoji_segmenter, orientation_segmenter>;
+
 } // namespace unicode
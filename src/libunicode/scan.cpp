@@ -11,6 +11,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <libunicode/convert.h>
 #include <libunicode/grapheme_segmenter.h>
 #include <libunicode/intrinsics.h>
 #include <libunicode/scan.h>
@@ -18,18 +19,16 @@
 #include <libunicode/width.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <iterator>
 #include <numeric>
 #include <string_view>
+#include <utility>
 
-#if defined(__SSE2__)
-    #include <immintrin.h>
-#endif
 
 using std::distance;
-using std::get;
-using std::holds_alternative;
 using std::max;
 using std::min;
 using std::string_view;
@@ -48,6 +47,17 @@ namespace
 #endif
     }
 
+    [[maybe_unused]] int countTrailingZeroBits64(uint64_t value) noexcept
+    {
+#if defined(_WIN32)
+        unsigned long index = 0;
+        _BitScanForward64(&index, value);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
     template <typename T>
     constexpr bool ascending(T low, T val, T high) noexcept
     {
@@ -59,240 +69,367 @@ namespace
         return static_cast<uint8_t>(ch) < 0x20;
     }
 
-    // Tests if given UTF-8 byte is part of a complex Unicode codepoint, that is, a value greater than U+7E.
-    constexpr bool is_complex(char ch) noexcept
-    {
-        return static_cast<uint8_t>(ch) & 0x80;
-    }
-
     // Tests if given UTF-8 byte is a single US-ASCII text codepoint. This excludes control characters.
     constexpr bool is_ascii(char ch) noexcept
     {
-        return !is_control(ch) && !is_complex(ch);
+        return !is_control(ch) && !detail::is_complex(ch);
     }
 } // namespace
 
-size_t detail::scan_for_text_ascii(string_view text, size_t maxColumnCount) noexcept
+namespace
 {
-    auto input = text.data();
-    auto const end = text.data() + min(text.size(), maxColumnCount);
+    // Returns a pointer to the first byte in [input, end) that is not US-ASCII text
+    // (i.e. a C0 control character or part of a complex UTF-8 sequence), or end if none found.
+    using ascii_scanner = char const* (*) (char const* input, char const* end) noexcept;
+
+    char const* scan_ascii_scalar(char const* input, char const* end) noexcept
+    {
+        while (input != end && is_ascii(*input))
+            ++input;
+        return input;
+    }
 
-    intrinsics::m128i const ControlCodeMax = intrinsics::set1_epi8(0x20); // 0..0x1F
-    intrinsics::m128i const Complex = intrinsics::set1_epi8(-128);        // equals to 0x80 (0b1000'0000)
+    // NB: All vectorized scanners below use a single signed comparison against 0x20,
+    // because any byte with the highest bit set (complex UTF-8 sequence) is negative when
+    // interpreted as signed, and thus also less than 0x20 (C0 control character).
 
-    while (input < end - sizeof(intrinsics::m128i))
+#if defined(__x86_64__) || defined(_M_AMD64)
+    char const* scan_ascii_sse2(char const* input, char const* end) noexcept
     {
-        intrinsics::m128i batch = intrinsics::load_unaligned((intrinsics::m128i*) input);
-        intrinsics::m128i isControl = intrinsics::compare_less(batch, ControlCodeMax);
-        intrinsics::m128i isComplex = intrinsics::and128(batch, Complex);
-        // intrinsics::m128i isComplex = _mm_cmplt_epi8(batch, Complex);
-        intrinsics::m128i testPack = intrinsics::or128(isControl, isComplex);
-        if (int const check = intrinsics::movemask_epi8(testPack); check != 0)
+        intrinsics::m128i const ControlCodeMax = intrinsics::set1_epi8(0x20); // 0..0x1F
+
+        while (end - input >= static_cast<ptrdiff_t>(sizeof(intrinsics::m128i)))
         {
-            int advance = countTrailingZeroBits(static_cast<unsigned>(check));
-            input += advance;
-            break;
+            intrinsics::m128i const batch = intrinsics::load_unaligned((intrinsics::m128i const*) input);
+            if (int const check = intrinsics::movemask_epi8(intrinsics::compare_less(batch, ControlCodeMax));
+                check != 0)
+                return input + countTrailingZeroBits(static_cast<unsigned>(check));
+            input += sizeof(intrinsics::m128i);
         }
-        input += sizeof(intrinsics::m128i);
-    }
 
-    while (input != end && is_ascii(*input))
-        ++input;
+        return scan_ascii_scalar(input, end);
+    }
 
-    // if (static_cast<size_t>(distance(text.data(), input)))
-    //     fmt::print(
-    //         "countAsciiTextChars: {} bytes: \"{}\"\n",
-    //         static_cast<size_t>(distance(text.data(), input)),
-    //         (string_view(text.data(), static_cast<size_t>(distance(text.data(), input)))));
+    LIBUNICODE_TARGET("avx2") char const* scan_ascii_avx2(char const* input, char const* end) noexcept
+    {
+        using avx2 = intrinsics_avx2;
+        constexpr auto VectorSize = static_cast<ptrdiff_t>(sizeof(avx2::m256i));
 
-    return static_cast<size_t>(distance(text.data(), input));
-}
+        avx2::m256i const ControlCodeMax = avx2::set1_epi8(0x20);
 
-scan_result detail::scan_for_text_nonascii(scan_state& state,
-                                           string_view text,
-                                           size_t maxColumnCount,
-                                           grapheme_cluster_receiver& receiver) noexcept
-{
-    size_t count = 0;
+        // Two vectors per iteration, to keep both load ports busy.
+        while (end - input >= 2 * VectorSize)
+        {
+            avx2::m256i const a = avx2::compare_less(avx2::load_unaligned(input), ControlCodeMax);
+            avx2::m256i const b = avx2::compare_less(avx2::load_unaligned(input + VectorSize), ControlCodeMax);
+            if (avx2::movemask_epi8(avx2::or256(a, b)) != 0)
+            {
+                if (uint32_t const check = avx2::movemask_epi8(a); check != 0)
+                    return input + countTrailingZeroBits(check);
+                return input + VectorSize + countTrailingZeroBits(avx2::movemask_epi8(b));
+            }
+            input += 2 * VectorSize;
+        }
 
-    char const* start = text.data();
-    char const* end = start + text.size();
-    char const* input = start;
-    char const* clusterStart = start;
-    char const* lastCodepointStart = start;
+        if (end - input >= VectorSize)
+        {
+            avx2::m256i const a = avx2::compare_less(avx2::load_unaligned(input), ControlCodeMax);
+            if (uint32_t const check = avx2::movemask_epi8(a); check != 0)
+                return input + countTrailingZeroBits(check);
+            input += VectorSize;
+        }
 
-    unsigned byteCount = 0; // bytes consume for the current codepoint
+        return scan_ascii_scalar(input, end);
+    }
 
-    // TODO: move currentClusterWidth to scan_state.
-    size_t currentClusterWidth = 0; // current grapheme cluster's East Asian Width
+    LIBUNICODE_TARGET("avx512f,avx512bw")
+    char const* scan_ascii_avx512bw(char const* input, char const* end) noexcept
+    {
+        using avx512 = intrinsics_avx512;
+        constexpr auto VectorSize = static_cast<ptrdiff_t>(sizeof(avx512::m512i));
 
-    char const* resultStart = state.utf8.expectedLength ? start - state.utf8.currentLength : start;
-    char const* resultEnd = resultStart;
+        avx512::m512i const ControlCodeMax = avx512::set1_epi8(0x20);
 
-    while (input != end && count <= maxColumnCount)
-    {
-        if (is_control(*input) || !is_complex(*input))
+        while (end - input >= VectorSize)
         {
-            // Incomplete UTF-8 sequence hit. That's invalid as well.
-            if (state.utf8.expectedLength)
-            {
-                ++count;
-                receiver.receiveInvalidGraphemeCluster();
-                state.utf8 = {};
-            }
-            state.lastCodepointHint = 0;
-            resultEnd = input;
-            break;
+            if (uint64_t const check = avx512::compare_less(avx512::load_unaligned(input), ControlCodeMax);
+                check != 0)
+                return input + countTrailingZeroBits64(check);
+            input += VectorSize;
         }
 
-        auto const result = from_utf8(state.utf8, static_cast<uint8_t>(*input++));
-        ++byteCount;
+        return scan_ascii_sse2(input, end);
+    }
 
-        if (holds_alternative<Incomplete>(result))
-            continue;
+    ascii_scanner select_ascii_scanner() noexcept
+    {
+        if (cpu_supports_avx512bw())
+            return &scan_ascii_avx512bw;
+        if (cpu_supports_avx2())
+            return &scan_ascii_avx2;
+        return &scan_ascii_sse2;
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    char const* scan_ascii_neon(char const* input, char const* end) noexcept
+    {
+        constexpr auto VectorSize = static_cast<ptrdiff_t>(sizeof(intrinsics::m128i));
+
+        intrinsics::m128i const ControlCodeMax = intrinsics::set1_epi8(0x20);
+
+        auto const test = [&](char const* p) noexcept {
+            return intrinsics::compare_less(intrinsics::load_unaligned((intrinsics::m128i const*) p),
+                                            ControlCodeMax);
+        };
 
-        if (holds_alternative<Success>(result))
+        // Four vectors per iteration with a single horizontal reduction.
+        while (end - input >= 4 * VectorSize)
         {
-            auto const prevCodepoint = state.lastCodepointHint;
-            auto const nextCodepoint = get<Success>(result).value;
-            auto const nextWidth = max(currentClusterWidth, static_cast<size_t>(width(nextCodepoint)));
-            state.lastCodepointHint = nextCodepoint;
-            if (grapheme_segmenter::breakable(prevCodepoint, nextCodepoint))
-            {
-                // Flush out current grapheme cluster's East Asian Width.
-                count += currentClusterWidth;
-
-                if (count + nextWidth > maxColumnCount)
-                {
-                    // Currently scanned grapheme cluster won't fit. Break at start.
-                    currentClusterWidth = 0;
-                    input -= byteCount;
-                    break;
-                }
-                receiver.receiveGraphemeCluster(string_view(clusterStart, byteCount), currentClusterWidth);
-
-                // And start a new grapheme cluster.
-                currentClusterWidth = nextWidth;
-                clusterStart = lastCodepointStart;
-                lastCodepointStart = input - byteCount;
-                byteCount = 0;
-                resultEnd = input;
-            }
-            else
-            {
-                resultEnd = input;
-                // Increase width on VS16 but do not decrease on VS15.
-                if (nextCodepoint == 0xFE0F) // VS16
-                {
-                    currentClusterWidth = 2;
-                    if (count + currentClusterWidth > maxColumnCount)
-                    {
-                        // Rewinding by {byteCount} bytes (overflow due to VS16).
-                        currentClusterWidth = 0;
-                        input = clusterStart;
-                        break;
-                    }
-                }
-
-                // Consumed {byteCount} bytes for grapheme cluster.
-                lastCodepointStart = input - byteCount;
-            }
+            auto const a = test(input);
+            auto const b = test(input + VectorSize);
+            auto const c = test(input + 2 * VectorSize);
+            auto const d = test(input + 3 * VectorSize);
+            if (intrinsics::any(intrinsics::or128(intrinsics::or128(a, b), intrinsics::or128(c, d))))
+                break; // Locate the exact position in the loop below.
+            input += 4 * VectorSize;
         }
-        else
+
+        while (end - input >= VectorSize)
         {
-            assert(holds_alternative<Invalid>(result));
-            count++;
-            receiver.receiveInvalidGraphemeCluster();
-            currentClusterWidth = 0;
-            state.lastCodepointHint = 0;
-            state.utf8.expectedLength = 0;
-            byteCount = 0;
+            if (uint64_t const check = intrinsics::movemask_nibbles(test(input)); check != 0)
+                return input + countTrailingZeroBits64(check) / 4;
+            input += VectorSize;
         }
+
+        return scan_ascii_scalar(input, end);
     }
-    count += currentClusterWidth;
 
-    assert(resultStart <= resultEnd);
+    ascii_scanner select_ascii_scanner() noexcept
+    {
+        return &scan_ascii_neon;
+    }
+#else
+    ascii_scanner select_ascii_scanner() noexcept
+    {
+        return &scan_ascii_scalar;
+    }
+#endif
+} // namespace
+
+size_t detail::scan_for_text_ascii(string_view text, size_t maxColumnCount) noexcept
+{
+    // The best implementation for the running CPU is determined once, on first use.
+    static ascii_scanner const scanAscii = select_ascii_scanner();
 
-    state.next = input;
-    return { count, resultStart, resultEnd };
+    auto const input = text.data();
+    auto const end = input + min(text.size(), maxColumnCount);
+
+    return static_cast<size_t>(distance(input, scanAscii(input, end)));
 }
 
-scan_result scan_text(scan_state& state, std::string_view text, size_t maxColumnCount) noexcept
+namespace
 {
-    return scan_text(state, text, maxColumnCount, null_receiver::get());
+    // {{{ UTF-8 block decoding for the non-US-ASCII scan path
+
+    /// Returns the length of the UTF-8 sequence introduced by the given lead byte,
+    /// or 0 if the given byte is no valid lead byte of a multibyte sequence.
+    constexpr int sequence_length(uint8_t lead) noexcept
+    {
+        if ((lead & 0b1110'0000) == 0b1100'0000)
+            return 2;
+        if ((lead & 0b1111'0000) == 0b1110'0000)
+            return 3;
+        if ((lead & 0b1111'1000) == 0b1111'0000)
+            return 4;
+        return 0;
+    }
+
+} // namespace
+
+char const* detail::find_ascii_byte(char const* input, char const* end) noexcept
+{
+#if defined(__x86_64__) || defined(_M_AMD64)
+    while (end - input >= static_cast<ptrdiff_t>(sizeof(intrinsics::m128i)))
+    {
+        intrinsics::m128i const batch = intrinsics::load_unaligned((intrinsics::m128i const*) input);
+        // The movemask has bits set for non-US-ASCII bytes, because their highest bit is set.
+        if (unsigned const check = ~static_cast<unsigned>(intrinsics::movemask_epi8(batch)) & 0xFFFF;
+            check != 0)
+            return input + countTrailingZeroBits(check);
+        input += sizeof(intrinsics::m128i);
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    intrinsics::m128i const MinusOne = intrinsics::set1_epi8(-1);
+    while (end - input >= static_cast<ptrdiff_t>(sizeof(intrinsics::m128i)))
+    {
+        intrinsics::m128i const batch = intrinsics::load_unaligned((intrinsics::m128i const*) input);
+        // US-ASCII bytes are the only ones not negative when interpreted as signed.
+        if (uint64_t const check = intrinsics::movemask_nibbles(intrinsics::compare_less(MinusOne, batch));
+            check != 0)
+            return input + countTrailingZeroBits64(check) / 4;
+        input += sizeof(intrinsics::m128i);
+    }
+#endif
+    while (input != end && is_complex(*input))
+        ++input;
+    return input;
 }
 
-scan_result scan_text(scan_state& state,
-                      std::string_view text,
-                      size_t maxColumnCount,
-                      grapheme_cluster_receiver& receiver) noexcept
+char const* detail::decode_block(char const* input,
+                                 char const* end,
+                                 narrow_codepoint_properties::tables_view const& tables,
+                                 codepoint_block& block) noexcept
 {
-    //       ----(a)--->   A   -------> END
-    //                   ^   |
-    //                   |   |
-    // Start            (a) (b)
-    //                   |   |
-    //                   |   v
-    //       ----(b)--->   B   -------> END
-
-    enum class NextState
+    block.count = 0;
+
+    while (input != end && block.count != codepoint_block::Capacity)
     {
-        Trivial,
-        Complex
-    };
+        block.positions[block.count] = input;
 
-    auto result = scan_result { 0, text.data(), text.data() };
+        auto const lead = static_cast<uint8_t>(*input);
+        auto const length = sequence_length(lead);
+        if (!length)
+        {
+            // Stray continuation byte or invalid lead byte.
+            block.codepoints[block.count++] = InvalidSequence;
+            ++input;
+            continue;
+        }
 
-    if (state.next == nullptr)
-        state.next = text.data();
+        if (end - input < length)
+        {
+            // Not enough bytes left. Either this sequence is incomplete (and thus left to the caller),
+            // or it is cut short by another lead byte and therefore invalid.
+            auto cut = input + 1;
+            while (cut != end && is_continuation(*cut))
+                ++cut;
+            if (cut == end)
+                break;
+            block.codepoints[block.count++] = InvalidSequence;
+            input = cut;
+            continue;
+        }
 
-    // If state indicates that we previously started consuming a UTF-8 sequence but did not complete yet,
-    // attempt to finish that one first.
-    if (state.utf8.expectedLength != 0)
-    {
-        result = detail::scan_for_text_nonascii(state, text, maxColumnCount, receiver);
-        text = std::string_view(result.end,
-                                static_cast<size_t>(std::distance(result.end, text.data() + text.size())));
+        auto codepoint = static_cast<char32_t>(lead & (0x7F >> length));
+        int i = 1;
+        for (; i < length && is_continuation(input[i]); ++i)
+            codepoint = (codepoint << 6) | (static_cast<uint8_t>(input[i]) & 0b0011'1111);
+
+        block.codepoints[block.count++] = i == length ? codepoint : InvalidSequence;
+        input += i;
     }
 
-    if (text.empty())
-        return result;
+    block.positions[block.count] = input;
+
+    // NB: Invalid sequences resolve to the properties of U+0000, and are ignored by the caller.
+    tables.get_many(block.codepoints.data(), block.count, block.properties.data());
+
+    return input;
+}
+
+void detail::save_incomplete_sequence(utf8_decoder_state& utf8, char const* input, char const* end) noexcept
+{
+    auto const lead = static_cast<uint8_t>(*input);
+    utf8.expectedLength = static_cast<unsigned>(sequence_length(lead));
+    utf8.currentLength = static_cast<unsigned>(distance(input, end));
+    utf8.character = lead & (0x7F >> utf8.expectedLength);
+    while (++input != end)
+        utf8.character = (utf8.character << 6) | (static_cast<uint8_t>(*input) & 0b0011'1111);
+}
+// }}}
+
+scan_result detail::scan_for_text_nonascii(scan_state& state,
+                                           string_view text,
+                                           size_t maxColumnCount,
+                                           grapheme_cluster_receiver& receiver) noexcept
+{
+    return scan_for_text_nonascii<grapheme_cluster_receiver>(state, text, maxColumnCount, receiver);
+}
 
-    auto nextState = is_complex(text.front()) ? NextState::Complex : NextState::Trivial;
-    while (result.count < maxColumnCount && state.next != (text.data() + text.size()))
+namespace
+{
+    /// Fills a grapheme_cluster_buffer with the grapheme clusters received.
+    class grapheme_cluster_buffer_receiver
     {
-        switch (nextState)
+      public:
+        grapheme_cluster_buffer_receiver(grapheme_cluster_buffer& buffer, char const* base) noexcept:
+            _buffer { buffer }, _base { base }
         {
-            case NextState::Trivial: {
-                auto const count = detail::scan_for_text_ascii(text, maxColumnCount - result.count);
-                if (!count)
-                    return result;
-                receiver.receiveAsciiSequence(text.substr(0, count));
-                result.count += count;
-                state.next += count;
-                result.end += count;
-                nextState = NextState::Complex;
-                text.remove_prefix(count);
-                break;
-            }
-            case NextState::Complex: {
-                auto const sub =
-                    detail::scan_for_text_nonascii(state, text, maxColumnCount - result.count, receiver);
-                if (!sub.count)
-                    return result;
-                nextState = NextState::Trivial;
-                result.count += sub.count;
-                result.end = sub.end;
-                text.remove_prefix(static_cast<size_t>(std::distance(sub.start, sub.end)));
-                break;
+        }
+
+        [[nodiscard]] size_t remaining() const noexcept { return _buffer.capacity - _buffer.size; }
+
+        void receiveAsciiSequence(string_view sequence) noexcept
+        {
+            auto const offset = static_cast<size_t>(sequence.data() - _base);
+            for (size_t i = 0; i < sequence.size(); ++i)
+                push(offset + i, 1, false);
+            _asciiEnd = sequence.data() + sequence.size();
+            _asciiLast = sequence.back();
+        }
+
+        void receiveGraphemeCluster(string_view cluster, size_t columnCount) noexcept
+        {
+            // scan_text() passes codepoints continuing the grapheme cluster of the last US-ASCII character
+            // (e.g. VS16 or combining marks) on their own, which thus extend the last entry.
+            auto const asciiEnd = std::exchange(_asciiEnd, nullptr);
+            if (cluster.data() == asciiEnd
+                && !grapheme_segmenter::breakable(static_cast<char32_t>(_asciiLast),
+                                                  decode_utf8_sequence(cluster).value))
+            {
+                _buffer.widths[_buffer.size - 1] += static_cast<uint8_t>(columnCount);
+                return;
             }
+            push(static_cast<size_t>(cluster.data() - _base), static_cast<uint8_t>(columnCount), false);
         }
-    }
 
-    assert(result.start <= result.end);
-    assert(result.end <= state.next);
+        void receiveInvalidGraphemeCluster(string_view sequence) noexcept
+        {
+            push(static_cast<size_t>(sequence.data() - _base), 1, true);
+            _asciiEnd = nullptr;
+        }
+
+      private:
+        void push(size_t offset, uint8_t width, bool invalid) noexcept
+        {
+            assert(_buffer.size < _buffer.capacity);
+            _buffer.offsets[_buffer.size] = offset;
+            _buffer.widths[_buffer.size] = width;
+            _buffer.invalid[_buffer.size] = invalid;
+            ++_buffer.size;
+        }
+
+        grapheme_cluster_buffer& _buffer;
+        char const* _base;
+
+        // End and last character of the last US-ASCII sequence received.
+        char const* _asciiEnd = nullptr;
+        char _asciiLast = 0;
+    };
+} // namespace
+
+scan_result scan_text(scan_state& state, std::string_view text, size_t maxColumnCount) noexcept
+{
+    return scan_text(state, text, maxColumnCount, null_receiver::get());
+}
+
+scan_result scan_text(scan_state& state,
+                      std::string_view text,
+                      size_t maxColumnCount,
+                      grapheme_cluster_receiver& receiver) noexcept
+{
+    return scan_text<grapheme_cluster_receiver>(state, text, maxColumnCount, receiver);
+}
 
-    return result;
+scan_result scan_text(scan_state& state,
+                      std::string_view text,
+                      size_t maxColumnCount,
+                      grapheme_cluster_buffer& buffer) noexcept
+{
+    // Offsets are relative to the start of the result, which includes a resumed UTF-8 sequence.
+    auto const base = state.utf8.expectedLength ? text.data() - state.utf8.currentLength : text.data();
+    auto receiver = grapheme_cluster_buffer_receiver { buffer, base };
+    buffer.size = 0;
+    return scan_text(state, text, maxColumnCount, receiver);
 }
 
 } // namespace unicode
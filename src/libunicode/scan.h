@@ -13,8 +13,21 @@
  */
 #pragma once
 
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/grapheme_cluster_cache.h>
+#include <libunicode/grapheme_segmenter.h>
+#include <libunicode/statistics.h>
 #include <libunicode/utf8.h>
+#include <libunicode/width_policy.h>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <string_view>
 
 namespace unicode
@@ -40,14 +53,35 @@ struct scan_result
 ///
 /// This state holds the UTF-8 decoding state, if processing had to be stopped
 /// at an incomplete UTF-8 byte sequence,
-/// and the last decoded Unicode codepoint necessary for grapheme cluster segmentation.
+/// and the grapheme segmentation state after the last scanned codepoint,
+/// such that grapheme clusters split across calls are segmented as if scanned at once.
 struct scan_state
 {
     utf8_decoder_state utf8 {};
-    char32_t lastCodepointHint {};
+    grapheme_segmenter_state grapheme {};
 
     /// Pointer to one byte after the last scanned codepoint.
     char const* next {};
+
+    /// Number of columns of the last scanned grapheme cluster, such that a grapheme cluster continued
+    /// by the next call, e.g. widened by VS16, only accounts for the columns it adds.
+    size_t lastClusterWidth = 0;
+
+    /// Optional cache of grapheme clusters to skip repeated grapheme clusters of more than one
+    /// codepoint in one go. It is not owned, and not reset along with the rest of the state.
+    grapheme_cluster_cache* cache = nullptr;
+
+    /// Optional statistics to count the work done into, if statistics_enabled.
+    /// It is not owned, and not reset along with the rest of the state.
+    statistics* stats = nullptr;
+
+    /// Optional policy of the widths of codepoints to scan with, rather than those of width().
+    /// Its tables replace the configured ones, so the adjusted width does not cost another lookup.
+    /// It is not owned, and not reset along with the rest of the state.
+    ///
+    /// The widths in the cache, if any, depend on the policy, so it must not be shared with
+    /// scans of other policies.
+    width_policy const* widths = nullptr;
 };
 
 /// Callback-interface that allows precisely understanding the structure of a UTF-8 sequence.
@@ -76,9 +110,104 @@ class null_receiver final: public grapheme_cluster_receiver
     }
 };
 
+/// Caller provided structure-of-arrays buffer to be filled with grapheme clusters by scan_text().
+///
+/// Each array must be able to hold @c capacity elements.
+/// Scanning stops before the grapheme cluster that would exceed the capacity.
+struct grapheme_cluster_buffer
+{
+    /// Byte offsets at which the grapheme clusters start, relative to scan_result::start.
+    /// A grapheme cluster ends where the next one starts, the last one at scan_result::end.
+    size_t* offsets = nullptr;
+
+    /// Widths of the grapheme clusters in columns.
+    uint8_t* widths = nullptr;
+
+    /// Whether or not the grapheme cluster is an invalid UTF-8 sequence.
+    bool* invalid = nullptr;
+
+    /// Number of elements each of the arrays can hold.
+    size_t capacity = 0;
+
+    /// Number of grapheme clusters filled in by the last call to scan_text().
+    size_t size = 0;
+};
+
 namespace detail
 {
+    /// Receivers that can only take a limited number of further grapheme clusters.
+    template <typename Receiver>
+    concept bounded_receiver = requires(Receiver const& receiver) {
+        { receiver.remaining() } -> std::convertible_to<size_t>;
+    };
+
+    /// Receivers that take the UTF-8 sequence an invalid grapheme cluster consists of.
+    template <typename Receiver>
+    concept invalid_sequence_receiver = requires(Receiver& receiver, std::string_view sequence) {
+        receiver.receiveInvalidGraphemeCluster(sequence);
+    };
+
+    template <typename Receiver>
+    constexpr size_t remaining_capacity(Receiver const& receiver) noexcept
+    {
+        if constexpr (bounded_receiver<Receiver>)
+            return receiver.remaining();
+        else
+            return std::numeric_limits<size_t>::max();
+    }
+
+    /// Marks an invalid UTF-8 sequence in a decoded codepoint_block.
+    constexpr char32_t InvalidSequence = 0xFFFF'FFFF; // NOLINT(readability-identifier-naming)
+
+    /// Holds a block of consecutively decoded codepoints, their codepoint properties,
+    /// and the boundaries of the UTF-8 sequences they have been decoded from.
+    struct codepoint_block
+    {
+        static constexpr size_t Capacity = 64;
+
+        size_t count = 0;
+        std::array<char32_t, Capacity> codepoints;
+        std::array<narrow_codepoint_properties, Capacity> properties;
+
+        /// The i-th codepoint was decoded from the UTF-8 sequence [positions[i], positions[i + 1]).
+        std::array<char const*, Capacity + 1> positions;
+    };
+
+    // Tests if given UTF-8 byte is part of a complex Unicode codepoint, that is, a value greater than U+7E.
+    constexpr bool is_complex(char ch) noexcept
+    {
+        return static_cast<uint8_t>(ch) & 0x80;
+    }
+
+    constexpr bool is_continuation(char ch) noexcept
+    {
+        return (static_cast<uint8_t>(ch) & 0b1100'0000) == 0b1000'0000;
+    }
+
+    /// Returns a pointer to the first US-ASCII byte (including C0 control characters) in [input, end),
+    /// or end if there is none.
+    char const* find_ascii_byte(char const* input, char const* end) noexcept;
+
+    /// Decodes the UTF-8 sequences in [input, end) into @p block, up to its capacity,
+    /// looking up their properties in @p tables, and returns a pointer to the first byte not decoded.
+    ///
+    /// An incomplete UTF-8 sequence at the end of the input is not decoded.
+    char const* decode_block(char const* input,
+                             char const* end,
+                             narrow_codepoint_properties::tables_view const& tables,
+                             codepoint_block& block) noexcept;
+
+    /// Stores the incomplete UTF-8 sequence [input, end) into the decoder state @p utf8.
+    void save_incomplete_sequence(utf8_decoder_state& utf8, char const* input, char const* end) noexcept;
+
     size_t scan_for_text_ascii(std::string_view text, size_t maxColumnCount) noexcept;
+
+    template <typename Receiver>
+    scan_result scan_for_text_nonascii(scan_state& state,
+                                       std::string_view text,
+                                       size_t maxColumnCount,
+                                       Receiver& receiver) noexcept;
+
     scan_result scan_for_text_nonascii(scan_state& state,
                                        std::string_view text,
                                        size_t maxColumnCount,
@@ -91,7 +220,8 @@ namespace detail
 ///
 /// - given the input sequence, the right most invalid or complete UTF-8 sequence is processed,
 /// - maxColumnCount is reached and the next grapheme cluster would exceed the given limit,
-/// - a control character is about to be processed.
+/// - a control character is about to be processed,
+/// - the receiver, if given, cannot take another grapheme cluster.
 ///
 /// When this function returns, it is guaranteed to not contain an incomplete UTF-8 sequence
 /// at the end of the output sequence.
@@ -109,4 +239,382 @@ scan_result scan_text(scan_state& state,
                       size_t maxColumnCount,
                       grapheme_cluster_receiver& receiver) noexcept;
 
+/// Same as above, but invoking the callbacks of @p receiver without virtual dispatch.
+///
+/// The Receiver type must provide the member functions of grapheme_cluster_receiver,
+/// but does not need to derive from it. A receiver whose callbacks are visible to the compiler
+/// can have them inlined into the scanning loop.
+///
+/// In addition, a receiver may provide
+///
+/// - @c remaining(), the number of grapheme clusters it can still take, to make scanning stop
+///   before exceeding it, where each US-ASCII character counts as one grapheme cluster, and
+/// - @c receiveInvalidGraphemeCluster(std::string_view) to receive the invalid UTF-8 sequence.
+template <typename Receiver>
+scan_result scan_text(scan_state& state,
+                      std::string_view text,
+                      size_t maxColumnCount,
+                      Receiver& receiver) noexcept;
+
+/// Same as above, but filling @p buffer with the scanned grapheme clusters, allowing them
+/// to be processed in one go rather than by callbacks interleaved with decoding.
+///
+/// Scanning additionally stops when the buffer is full. Grapheme clusters of prior contents
+/// of the buffer are overwritten.
+scan_result scan_text(scan_state& state,
+                      std::string_view text,
+                      size_t maxColumnCount,
+                      grapheme_cluster_buffer& buffer) noexcept;
+
+// {{{ implementation
+template <typename Receiver>
+scan_result detail::scan_for_text_nonascii(scan_state& state,
+                                           std::string_view text,
+                                           size_t maxColumnCount,
+                                           Receiver& receiver) noexcept
+{
+    char const* const start = text.data();
+    char const* const end = start + text.size();
+    char const* input = start;
+
+    char const* const resultStart = state.utf8.expectedLength ? start - state.utf8.currentLength : start;
+    char const* resultEnd = resultStart;
+    size_t count = 0;
+
+    // The grapheme cluster currently being scanned, if any, and how many of its columns
+    // were accounted for by a previous call already, if it continues a grapheme cluster from there.
+    char const* clusterStart = nullptr;
+    size_t clusterWidth = 0;
+    size_t clusterAccountedWidth = 0;
+    size_t lastClusterWidth = state.lastClusterWidth;
+
+    // Whether the current grapheme cluster can be cached (it started within this call), how many
+    // codepoints it has, and how many of its bytes were found in the cache, if any.
+    bool clusterCacheable = false;
+    size_t clusterCodepoints = 0;
+    size_t clusterCachedSize = 0;
+
+    // Set when the current grapheme cluster was found in the cache, to skip the codepoints up to it.
+    char const* skipTo = nullptr;
+
+    // The codepoint properties along with their widths, as per the width policy, if any.
+    // They are captured once, for the pointers to stay in registers, and the tables to stay the same
+    // throughout the call, even if others are configured in the meantime.
+    auto const tables =
+        state.widths ? state.widths->tables() : narrow_codepoint_properties::configured_tables();
+
+    // Grapheme segmentation state is carried forward from one codepoint to the next,
+    // and from one call to the next.
+    auto graphemeState = state.grapheme;
+    auto lastState = state.grapheme;      // State after the last successfully scanned codepoint.
+    auto precedingState = state.grapheme; // State before the current grapheme cluster.
+
+    // Set when scanning has to stop early, because the next grapheme cluster does not fit.
+    char const* stopPosition = nullptr;
+    auto stopState = grapheme_segmenter_state {};
+
+    auto const flushCluster = [&]() noexcept {
+        if (!clusterStart)
+            return;
+        count += clusterWidth - clusterAccountedWidth;
+        detail::count(state.stats, &statistics::graphemeClusters);
+        auto const cluster = std::string_view(clusterStart, static_cast<size_t>(resultEnd - clusterStart));
+        if (state.cache && clusterCacheable && clusterCodepoints > 1 && cluster.size() > clusterCachedSize)
+            state.cache->insert(cluster, clusterWidth, lastState);
+        receiver.receiveGraphemeCluster(cluster, clusterWidth - clusterAccountedWidth);
+        lastClusterWidth = clusterWidth;
+        clusterStart = nullptr;
+    };
+
+    // Processes a single decoded codepoint. Returns false if scanning must stop.
+    auto const process = [&](char32_t codepoint,
+                             narrow_codepoint_properties properties,
+                             char const* sequenceStart,
+                             char const* sequenceEnd) noexcept -> bool {
+        if (codepoint == InvalidSequence)
+        {
+            flushCluster();
+            if (count + 1 > maxColumnCount || remaining_capacity(receiver) == 0)
+            {
+                if (count + 1 > maxColumnCount)
+                    detail::count(state.stats, &statistics::columnLimitStops);
+                stopPosition = sequenceStart;
+                stopState = lastState;
+                return false;
+            }
+            ++count;
+            detail::count(state.stats, &statistics::invalidSequences);
+            if constexpr (invalid_sequence_receiver<Receiver>)
+                receiver.receiveInvalidGraphemeCluster(
+                    std::string_view(sequenceStart, static_cast<size_t>(sequenceEnd - sequenceStart)));
+            else
+                receiver.receiveInvalidGraphemeCluster();
+            grapheme_process_init(0, graphemeState);
+            lastState = graphemeState;
+            lastClusterWidth = 1;
+            resultEnd = sequenceEnd;
+            return true;
+        }
+
+        bool const breakable = grapheme_process_breakable(codepoint, properties, graphemeState);
+        if (breakable || !clusterStart)
+        {
+            // Start a new grapheme cluster. If it is not breakable, it continues a grapheme cluster
+            // that has been already accounted for by a previous call, and only its added columns count.
+            auto const accountedWidth = breakable ? size_t { 0 } : lastClusterWidth;
+            auto const width = breakable           ? size_t { properties.char_width() }
+                               : codepoint == 0xFE0F ? std::max(accountedWidth, size_t { 2 })
+                                                     : accountedWidth;
+            flushCluster();
+            if (count + width - accountedWidth > maxColumnCount || remaining_capacity(receiver) == 0)
+            {
+                if (count + width - accountedWidth > maxColumnCount)
+                    detail::count(state.stats, &statistics::columnLimitStops);
+                // Currently scanned grapheme cluster won't fit. Break at start.
+                stopPosition = sequenceStart;
+                stopState = lastState;
+                return false;
+            }
+            clusterStart = sequenceStart;
+            clusterWidth = width;
+            clusterAccountedWidth = accountedWidth;
+            clusterCacheable = breakable && sequenceStart >= start;
+            clusterCodepoints = 1;
+            clusterCachedSize = 0;
+            precedingState = lastState;
+        }
+        else
+        {
+            ++clusterCodepoints;
+
+            // The grapheme cluster has more than one codepoint. Have a look if it is a known one.
+            grapheme_cluster_cache::entry const* cached = nullptr;
+            if (state.cache && clusterCacheable && clusterCodepoints == 2)
+                cached = state.cache->find(
+                    std::string_view(clusterStart, static_cast<size_t>(end - clusterStart)));
+
+            // Increase width on VS16 but do not decrease on VS15.
+            auto const width = cached ? size_t { cached->width } : codepoint == 0xFE0F ? 2u : 0u;
+            if (width > clusterWidth)
+            {
+                if (count + width - clusterAccountedWidth > maxColumnCount)
+                {
+                    // Rewinding to the start of the grapheme cluster (overflow due to VS16).
+                    detail::count(state.stats, &statistics::rewinds);
+                    detail::count(state.stats, &statistics::columnLimitStops);
+                    stopPosition = clusterStart;
+                    stopState = precedingState;
+                    clusterStart = nullptr;
+                    return false;
+                }
+                clusterWidth = width;
+            }
+
+            if (cached)
+            {
+                clusterCachedSize = cached->size;
+                graphemeState = cached->state;
+                lastState = graphemeState;
+                resultEnd = clusterStart + cached->size;
+                skipTo = resultEnd;
+                return true;
+            }
+        }
+
+        lastState = graphemeState;
+        resultEnd = sequenceEnd;
+        return true;
+    };
+
+    // If we previously started consuming a UTF-8 sequence but did not complete yet, finish that one first.
+    auto const pendingSequence = state.utf8;
+    if (state.utf8.expectedLength)
+    {
+        auto& utf8 = state.utf8;
+        while (input != end && is_continuation(*input) && utf8.currentLength < utf8.expectedLength)
+        {
+            utf8.character = (utf8.character << 6) | (static_cast<uint8_t>(*input++) & 0b0011'1111);
+            ++utf8.currentLength;
+        }
+
+        if (utf8.currentLength == utf8.expectedLength)
+        {
+            auto const codepoint = utf8.character;
+            utf8 = {};
+            detail::count(state.stats, &statistics::propertyLookups);
+            process(codepoint, tables.get(codepoint), resultStart, input);
+        }
+        else if (input != end)
+        {
+            // Sequence interrupted by a non-continuation byte.
+            utf8 = {};
+            process(InvalidSequence, {}, resultStart, input);
+        }
+    }
+
+    char const* const runEnd = stopPosition ? input : find_ascii_byte(input, end);
+    codepoint_block block;
+
+    while (!stopPosition && input != runEnd)
+    {
+        char const* const next = decode_block(input, runEnd, tables, block);
+        detail::count(state.stats, &statistics::propertyLookups, block.count);
+        if (block.count == 0)
+        {
+            // Trailing incomplete UTF-8 sequence.
+            if (runEnd == end)
+                save_incomplete_sequence(state.utf8, input, end);
+            else
+                process(InvalidSequence, {}, input, runEnd); // interrupted by a US-ASCII byte.
+            break;
+        }
+
+        auto resumeAt = next;
+        for (size_t i = 0; i < block.count; ++i)
+        {
+            auto const& position = block.positions;
+            if (!process(block.codepoints[i], block.properties[i], position[i], position[i + 1]))
+                break;
+            if (skipTo)
+            {
+                // Skip the codepoints of the cached grapheme cluster, which may end beyond this block.
+                while (i + 1 < block.count && position[i + 1] < skipTo)
+                    ++i;
+                resumeAt = std::max(next, skipTo);
+                skipTo = nullptr;
+            }
+        }
+
+        input = resumeAt;
+    }
+
+    if (stopPosition)
+    {
+        if (stopPosition < start)
+        {
+            // The very first (resumed) UTF-8 sequence did not fit. Leave it pending.
+            state.utf8 = pendingSequence;
+            state.next = start;
+        }
+        else
+            state.next = stopPosition;
+        state.grapheme = stopState;
+        state.lastClusterWidth = lastClusterWidth;
+        resultEnd = stopPosition;
+    }
+    else
+    {
+        flushCluster();
+        state.next = runEnd;
+        state.grapheme = lastState;
+        state.lastClusterWidth = lastClusterWidth;
+        if (runEnd != end)
+            grapheme_process_init(0, state.grapheme); // Followed by a US-ASCII byte, which always breaks.
+    }
+
+    detail::count(state.stats, &statistics::complexBytes, static_cast<uint64_t>(state.next - start));
+    assert(resultStart <= resultEnd);
+
+    return { count, resultStart, resultEnd };
+}
+
+
+template <typename Receiver>
+scan_result scan_text(scan_state& state,
+                      std::string_view text,
+                      size_t maxColumnCount,
+                      Receiver& receiver) noexcept
+{
+    //       ----(a)--->   A   -------> END
+    //                   ^   |
+    //                   |   |
+    // Start            (a) (b)
+    //                   |   |
+    //                   |   v
+    //       ----(b)--->   B   -------> END
+
+    enum class NextState
+    {
+        Trivial,
+        Complex
+    };
+
+    auto result = scan_result { 0, text.data(), text.data() };
+
+    if (state.next == nullptr)
+        state.next = text.data();
+
+    // If state indicates that we previously started consuming a UTF-8 sequence but did not complete yet,
+    // attempt to finish that one first.
+    if (state.utf8.expectedLength != 0)
+    {
+        result = detail::scan_for_text_nonascii<Receiver>(state, text, maxColumnCount, receiver);
+        if (state.utf8.expectedLength != 0)
+            return result; // Still incomplete, or the grapheme cluster it starts did not fit.
+        text = std::string_view(result.end,
+                                static_cast<size_t>(std::distance(result.end, text.data() + text.size())));
+    }
+
+    if (text.empty())
+        return result;
+
+    // Counts stopping before a US-ASCII character, because all columns are used up.
+    auto const countAsciiStop = [&]() noexcept {
+        if constexpr (statistics_enabled)
+            if (result.count == maxColumnCount && static_cast<uint8_t>(text.front()) >= 0x20
+                && !detail::is_complex(text.front()))
+                detail::count(state.stats, &statistics::columnLimitStops);
+    };
+
+    auto nextState = detail::is_complex(text.front()) ? NextState::Complex : NextState::Trivial;
+    // NB: Scanning goes on when all columns are used up, as grapheme cluster continuations and
+    // zero-width grapheme clusters still fit, regardless of the calls the text is scanned by.
+    while (state.next != (text.data() + text.size()))
+    {
+        switch (nextState)
+        {
+            case NextState::Trivial: {
+                auto const count = detail::scan_for_text_ascii(
+                    text, std::min(maxColumnCount - result.count, detail::remaining_capacity(receiver)));
+                if (!count)
+                {
+                    countAsciiStop();
+                    return result;
+                }
+                detail::count(state.stats, &statistics::asciiBytes, count);
+                receiver.receiveAsciiSequence(text.substr(0, count));
+                grapheme_process_init(static_cast<uint8_t>(text[count - 1]), state.grapheme);
+                state.lastClusterWidth = 1;
+                result.count += count;
+                state.next += count;
+                result.end += count;
+                nextState = NextState::Complex;
+                text.remove_prefix(count);
+                break;
+            }
+            case NextState::Complex: {
+                auto const sub = detail::scan_for_text_nonascii<Receiver>(
+                    state, text, maxColumnCount - result.count, receiver);
+                if (state.next == text.data())
+                {
+                    // Nothing consumed, e.g. due to the next grapheme cluster not fitting.
+                    countAsciiStop();
+                    return result;
+                }
+                nextState = NextState::Trivial;
+                result.count += sub.count;
+                result.end = sub.end;
+                text.remove_prefix(static_cast<size_t>(std::distance(sub.start, sub.end)));
+                break;
+            }
+        }
+    }
+
+    assert(result.start <= result.end);
+    assert(result.end <= state.next);
+
+    return result;
+}
+// }}}
+
 } // namespace unicode
@@ -0,0 +1,453 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/grapheme_cluster_cache.h>
+#include <libunicode/scan.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Differential harness for scan_text(), feeding the same input once in one go and once in
+// randomly sized chunks, as it arrives from a PTY, and checking that both yield the same.
+//
+// The input is prefixed by a header choosing the column limit, the chunk size distribution
+// and whether or not to use a grapheme_cluster_cache, followed by the text to scan.
+//
+// Built with -DLIBUNICODE_LIBFUZZER, this is a libFuzzer target. Otherwise it runs inputs
+// given as files (e.g. libFuzzer reproducers), or randomly generated inputs, and with
+// --throughput measures the throughput of scan_text() for a range of chunk sizes.
+
+using namespace std::string_view_literals;
+using unicode::grapheme_cluster_cache;
+
+namespace
+{
+
+/// Number of header bytes preceding the text to scan.
+constexpr size_t HeaderSize = 4; // NOLINT(readability-identifier-naming)
+
+struct event
+{
+    enum class kind : uint8_t
+    {
+        Ascii,
+        GraphemeCluster,
+        Invalid,
+        Control,
+        LineWrap,
+        Incomplete,
+    };
+
+    kind type;
+    size_t offset; // Relative to the start of the text.
+    size_t size;
+    size_t width;
+
+    [[nodiscard]] size_t end() const noexcept { return offset + size; }
+
+    bool operator==(event const&) const noexcept = default;
+};
+
+/// Records the events of scan_text(), each US-ASCII character as one event of its own.
+class event_recorder
+{
+  public:
+    explicit event_recorder(char const* text): _text { text } {}
+
+    void receiveAsciiSequence(std::string_view sequence) noexcept
+    {
+        for (size_t i = 0; i < sequence.size(); ++i)
+            _events.push_back({ event::kind::Ascii, offset_of(sequence.data()) + i, 1, 1 });
+    }
+
+    void receiveGraphemeCluster(std::string_view cluster, size_t columnCount) noexcept
+    {
+        _events.push_back(
+            { event::kind::GraphemeCluster, offset_of(cluster.data()), cluster.size(), columnCount });
+    }
+
+    void receiveInvalidGraphemeCluster(std::string_view sequence) noexcept
+    {
+        _events.push_back({ event::kind::Invalid, offset_of(sequence.data()), sequence.size(), 1 });
+    }
+
+    void record(event::kind type, char const* position)
+    {
+        _events.push_back({ type, offset_of(position), 0, 0 });
+    }
+
+    [[nodiscard]] std::vector<event>& events() noexcept { return _events; }
+
+  private:
+    [[nodiscard]] size_t offset_of(char const* position) const noexcept
+    {
+        return static_cast<size_t>(position - _text);
+    }
+
+    char const* _text;
+    std::vector<event> _events;
+};
+
+struct scan_outcome
+{
+    std::vector<event> events;
+    size_t columns = 0; // Sum of scan_result::count.
+};
+
+/// Scans all of @p text, fed in by the chunks ending at @p chunkEnds, wrapping at @p lineWidth columns
+/// and continuing after control characters, the way a terminal emulator does.
+scan_outcome scan(std::string_view text,
+                  std::vector<size_t> const& chunkEnds,
+                  size_t lineWidth,
+                  grapheme_cluster_cache* cache)
+{
+    auto recorder = event_recorder { text.data() };
+    auto outcome = scan_outcome {};
+    auto state = unicode::scan_state {};
+    state.cache = cache;
+    size_t column = 0;
+
+    char const* input = text.data();
+    for (auto const chunkEnd: chunkEnds)
+    {
+        char const* const end = text.data() + chunkEnd;
+        while (input != end)
+        {
+            auto const chunk = std::string_view(input, static_cast<size_t>(end - input));
+            auto const result = unicode::scan_text(state, chunk, lineWidth - column, recorder);
+            outcome.columns += result.count;
+            column += result.count;
+            input = state.next;
+            if (input == end)
+                break;
+
+            // A pending UTF-8 sequence that did not fit is scanned before the control character.
+            if (static_cast<uint8_t>(*input) < 0x20 && !state.utf8.expectedLength)
+            {
+                recorder.record(event::kind::Control, input);
+                ++input;
+                state = {};
+                state.cache = cache;
+            }
+            else
+            {
+                // The line wraps before the next grapheme cluster, which may start with a pending sequence.
+                recorder.record(event::kind::LineWrap, input - state.utf8.currentLength);
+                column = 0;
+            }
+        }
+    }
+
+    if (state.utf8.expectedLength)
+        recorder.record(event::kind::Incomplete, text.data() + text.size());
+
+    outcome.events = std::move(recorder.events());
+    return outcome;
+}
+
+/// Merges the grapheme clusters continued across calls to scan_text() into the grapheme cluster they
+/// continue, i.e. those starting where @p boundaries, the boundaries of the scan in one go, have none,
+/// along with the columns they add.
+void merge_continuations(std::vector<event>& events, std::set<size_t> const& boundaries)
+{
+    auto merged = std::vector<event> {};
+    for (auto const& current: events)
+    {
+        if (!merged.empty() && current.type == event::kind::GraphemeCluster
+            && merged.back().type == event::kind::GraphemeCluster && merged.back().end() == current.offset
+            && !boundaries.count(current.offset))
+        {
+            merged.back().size += current.size;
+            merged.back().width += current.width;
+        }
+        else
+            merged.push_back(current);
+    }
+    events = std::move(merged);
+}
+
+[[noreturn]] void report_mismatch(std::string_view text,
+                                  std::vector<size_t> const& chunkEnds,
+                                  size_t lineWidth,
+                                  scan_outcome const& whole,
+                                  scan_outcome const& chunked)
+{
+    std::fprintf(stderr, "scan_text() mismatch for line width %zu, text:", lineWidth);
+    for (auto const ch: text)
+        std::fprintf(stderr, " %02X", static_cast<uint8_t>(ch));
+    std::fprintf(stderr, "\nchunk ends:");
+    for (auto const chunkEnd: chunkEnds)
+        std::fprintf(stderr, " %zu", chunkEnd);
+    std::fprintf(stderr, "\ncolumns: %zu vs %zu\n", whole.columns, chunked.columns);
+    for (size_t i = 0; i < std::max(whole.events.size(), chunked.events.size()); ++i)
+    {
+        auto const print = [](std::vector<event> const& events, size_t i) {
+            if (i < events.size())
+                std::fprintf(stderr,
+                             "%d@%zu+%zu:%zu",
+                             static_cast<int>(events[i].type),
+                             events[i].offset,
+                             events[i].size,
+                             events[i].width);
+        };
+        auto const same =
+            i < whole.events.size() && i < chunked.events.size() && whole.events[i] == chunked.events[i];
+        std::fprintf(stderr, "%c ", same ? ' ' : '!');
+        print(whole.events, i);
+        std::fprintf(stderr, "\t");
+        print(chunked.events, i);
+        std::fprintf(stderr, "\n");
+    }
+    std::abort();
+}
+
+void check_chunking(uint8_t const* data, size_t size)
+{
+    if (size < HeaderSize)
+        return;
+
+    auto const lineWidth = size_t { 2 } + data[0] % 79;
+    auto const maxChunkSize = data[1] & 1 ? size_t { 64 } : size_t { 8 };
+    auto const useCache = (data[1] & 2) != 0;
+    auto rng = std::minstd_rand { static_cast<uint32_t>(data[2] | data[3] << 8) };
+    auto const text = std::string_view(reinterpret_cast<char const*>(data) + HeaderSize, size - HeaderSize);
+
+    if (text.empty())
+        return;
+
+    auto const whole = scan(text, { text.size() }, lineWidth, nullptr);
+
+    // A VS16 scanned by a later call than the grapheme cluster it widens starts in cannot move the part
+    // of the grapheme cluster scanned by then to the next line, if it no longer fits. That is by design,
+    // hence chunks do not split such grapheme clusters.
+    auto unsplittable = std::vector<bool>(text.size() + 1, false);
+    for (auto const& e: whole.events)
+        if (e.type == event::kind::GraphemeCluster
+            && text.substr(e.offset, e.size).find("\xEF\xB8\x8F"sv, 1) != std::string_view::npos)
+            std::fill(unsplittable.begin() + static_cast<ptrdiff_t>(e.offset) + 1,
+                      unsplittable.begin() + static_cast<ptrdiff_t>(e.end()),
+                      true);
+
+    auto chunkEnds = std::vector<size_t> {};
+    for (size_t offset = 0; offset < text.size();)
+    {
+        offset = std::min(offset + 1 + rng() % maxChunkSize, text.size());
+        while (unsplittable[offset])
+            ++offset;
+        chunkEnds.push_back(offset);
+    }
+
+    auto cache = grapheme_cluster_cache { 16 };
+    auto chunked = scan(text, chunkEnds, lineWidth, useCache ? &cache : nullptr);
+
+    auto boundaries = std::set<size_t> {};
+    for (auto const& e: whole.events)
+        boundaries.insert(e.offset);
+    merge_continuations(chunked.events, boundaries);
+
+    if (whole.columns != chunked.columns || whole.events != chunked.events)
+        report_mismatch(text, chunkEnds, lineWidth, whole, chunked);
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* data, size_t size);
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* data, size_t size)
+{
+    check_chunking(data, size);
+    return 0;
+}
+
+#if !defined(LIBUNICODE_LIBFUZZER)
+
+namespace
+{
+
+// Fragments random texts are composed of, covering grapheme clusters of more than one codepoint,
+// also across US-ASCII, control characters and ill-formed UTF-8.
+constexpr auto Fragments = std::array { // NOLINT(readability-identifier-naming)
+    "a"sv,
+    "Hello, World "sv,
+    "\n"sv,
+    "\r\n"sv,
+    "\t"sv,
+    "e\u0301"sv,
+    "\u0301"sv,
+    "\u4E00"sv,
+    "\u4E00\u4E01\u4E02"sv,
+    "\u2764"sv,
+    "\uFE0E"sv,
+    "\uFE0F"sv,
+    "\u200D"sv,
+    "\U0001F468\u200D\U0001F469\u200D\U0001F467"sv,
+    "\U0001F1E9\U0001F1EA"sv,
+    "\U0001F1E9"sv,
+    "\u261D\U0001F3FB"sv,
+    "\u1100\u1161\u11A8"sv,
+    "\u0915\u094D\u0937"sv,
+    "\u0600"sv,
+    "\xFF"sv,
+    "\x80"sv,
+    "\xC3"sv,
+    "\xE4\xB8"sv,
+    "\xF0\x9F\x98"sv,
+};
+
+std::string random_input(std::mt19937& rng)
+{
+    auto input = std::string(HeaderSize, '\0');
+    for (auto& ch: input)
+        ch = static_cast<char>(rng());
+    auto const fragments = rng() % 48;
+    for (size_t i = 0; i < fragments; ++i)
+        input += Fragments[rng() % Fragments.size()];
+    return input;
+}
+
+/// Returns a text of about @p size bytes, of mixed US-ASCII, CJK and emoji, as seen in a terminal.
+std::string throughput_corpus(size_t size)
+{
+    auto rng = std::mt19937 { 4711 };
+    auto text = std::string {};
+    while (text.size() < size)
+    {
+        switch (rng() % 8)
+        {
+            case 0: text += "\u4E00\u4E01\u4E02\u4E03 "sv; break;
+            case 1: text += "\U0001F468\u200D\U0001F469\u200D\U0001F467 \u2764\uFE0F "sv; break;
+            case 2: text += "na\u0301ive \u0915\u094D\u0937 "sv; break;
+            default: text += "drwxr-xr-x  2 user group 4096 Jun 14 09:21 libunicode "sv; break;
+        }
+    }
+    return text;
+}
+
+/// Scans @p text in chunks of @p chunkSize bytes until at least @p duration passed, and returns the
+/// throughput in MiB/s.
+double measure_throughput(std::string_view text, size_t chunkSize, std::chrono::milliseconds duration)
+{
+    using clock = std::chrono::steady_clock;
+    auto receiver = unicode::null_receiver {};
+    size_t bytes = 0;
+    size_t columns = 0;
+    auto const start = clock::now();
+    auto elapsed = clock::duration {};
+    do
+    {
+        auto state = unicode::scan_state {};
+        for (size_t offset = 0; offset < text.size(); offset += chunkSize)
+        {
+            auto input = text.substr(offset, chunkSize);
+            while (!input.empty())
+            {
+                columns += unicode::scan_text(state, input, 80, receiver).count;
+                input.remove_prefix(static_cast<size_t>(state.next - input.data()));
+            }
+        }
+        bytes += text.size();
+        elapsed = clock::now() - start;
+    } while (elapsed < duration);
+
+    if (!columns)
+        std::abort(); // NB: Keeps the scanning from being optimized away.
+    return static_cast<double>(bytes) / (1024.0 * 1024.0) / std::chrono::duration<double>(elapsed).count();
+}
+
+std::string read_file(char const* fileName)
+{
+    auto file = std::ifstream(fileName, std::ios::binary);
+    auto contents = std::string {};
+    if (!file)
+        return contents;
+    file.seekg(0, std::ios::end);
+    contents.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+    return contents;
+}
+
+int run_throughput(char const* fileName)
+{
+    auto text = std::string {};
+    if (fileName)
+        text = read_file(fileName);
+    else
+        text = throughput_corpus(1024 * 1024);
+
+    // scan_text() stops at control characters, which are not what is measured here.
+    std::replace_if(text.begin(), text.end(), [](char ch) { return static_cast<uint8_t>(ch) < 0x20; }, ' ');
+
+    std::printf("%10s  %10s\n", "chunk size", "MiB/s");
+    for (auto const chunkSize: { 1, 2, 3, 4, 8, 16, 64, 256, 1024, 4096, 16384, 65536 })
+        std::printf("%10d  %10.1f\n",
+                    chunkSize,
+                    measure_throughput(text, static_cast<size_t>(chunkSize), std::chrono::milliseconds(200)));
+    std::printf(
+        "%10s  %10.1f\n", "whole", measure_throughput(text, text.size(), std::chrono::milliseconds(200)));
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+// Usage: unicode_scan_fuzz [--runs N] [--seed N] [FILE...]
+//        unicode_scan_fuzz --throughput [FILE]
+int main(int argc, char const* argv[])
+{
+    auto runs = 100'000ul;
+    auto seed = 1u;
+    auto files = std::vector<char const*> {};
+    for (int i = 1; i < argc; ++i)
+    {
+        auto const arg = std::string_view(argv[i]);
+        if (arg == "--throughput")
+            return run_throughput(i + 1 < argc ? argv[i + 1] : nullptr);
+        else if (arg == "--runs" && i + 1 < argc)
+            runs = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else
+            files.push_back(argv[i]);
+    }
+
+    for (auto const* fileName: files)
+    {
+        auto const input = read_file(fileName);
+        check_chunking(reinterpret_cast<uint8_t const*>(input.data()), input.size());
+    }
+
+    if (files.empty())
+    {
+        auto rng = std::mt19937 { seed };
+        for (size_t run = 0; run < runs; ++run)
+        {
+            auto const input = random_input(rng);
+            check_chunking(reinterpret_cast<uint8_t const*>(input.data()), input.size());
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#endif
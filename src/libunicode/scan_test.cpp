@@ -19,6 +19,7 @@
 
 #include <catch2/catch.hpp>
 
+#include <array>
 #include <string_view>
 
 using std::string_view;
@@ -133,6 +134,27 @@ TEST_CASE("scan.ascii.until_complex")
     CHECK(scan_for_text_ascii("0123456789{\xE2\x94\x80}ABCDEF", 80) == 11);
 }
 
+TEST_CASE("scan.ascii.wide")
+{
+    // Exercises the wider (32/64/128 bytes per iteration) vectorized code paths
+    // by placing a stop byte at every possible position of a long line of text.
+    auto const text = std::string(200, 'a');
+    CHECK(scan_for_text_ascii(text, text.size()) == text.size());
+    CHECK(scan_for_text_ascii(text, 150) == 150);
+
+    for (auto const stopByte: { '\033', '\x80', '\xFF', '\0' })
+    {
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            auto line = text;
+            line[i] = stopByte;
+            INFO(fmt::format("stop byte 0x{:02X} at offset {}", static_cast<uint8_t>(stopByte), i));
+            CHECK(scan_for_text_ascii(line, line.size()) == i);
+            CHECK(scan_for_text_ascii(line, i / 2) == i / 2);
+        }
+    }
+}
+
 TEST_CASE("scan.complex.grapheme_cluster.1")
 {
     auto state = unicode::scan_state {};
@@ -303,7 +325,6 @@ TEST_CASE("scan.complex.VS16")
     CHECK(state.next == s.data());
 }
 
-#if 0
 namespace
 {
 
@@ -365,8 +386,8 @@ void testScanText(int lineNo,
     CHECK(size_t(result.start - start) == 0);
     CHECK(size_t(result.end - start) == expectation.size());
     CHECK(result.count == expectedColumnCount.value);
-    CHECK(result.next[0] == stopByte);
-    CHECK(result.next == fullText.data() + expectation.size());
+    CHECK(state.next[0] == static_cast<char>(stopByte));
+    CHECK(state.next == fullText.data() + expectation.size());
 
     CHECK(graphemeClusterCollector.output.size() == analyzedGraphemeClusters.size());
     auto const iMax = std::min(analyzedGraphemeClusters.size(), graphemeClusterCollector.output.size());
@@ -410,4 +431,335 @@ TEST_CASE("scan.invalid")
                    U"A", U"B", U"C", U"D", U"E", U"F" });
     // clang-format on
 }
-#endif
+
+TEST_CASE("scan.complex.grapheme_clusters")
+{
+    auto const RC = U"\uFFFD"sv;
+
+    // clang-format off
+    testScanText(__LINE__, 1_columns, "e\xCC\x81"_bvec, '\n', { U"e", U"\u0301" });            // after US-ASCII
+    testScanText(__LINE__, 1_columns, "\xC3\xA9\xCC\x81"_bvec, '\n', { U"\u00E9\u0301" });    // combining
+    testScanText(__LINE__, 3_columns, "\xF0\x9F\x98\x80\xC2\xA9"_bvec, '\n', { U"\U0001F600", U"\u00A9" });
+    testScanText(__LINE__, 2_columns, "\xC2\xA9\xEF\xB8\x8F"_bvec, '\n', { U"\u00A9\uFE0F" });    // VS16
+    testScanText(__LINE__, 3_columns, "\xC2\xA9\xB1\xC2\xA9"_bvec, '\n', { U"\u00A9", RC, U"\u00A9" });
+    testScanText(__LINE__, 3_columns, "\xC2\xA9\xE2\x94\xC2\xA9"_bvec, '\n', { U"\u00A9", RC, U"\u00A9" });
+    testScanText(__LINE__, 2_columns, "\xC2\xA9\xE2\x94"_bvec, '\n', { U"\u00A9", RC });   // cut by US-ASCII
+    // clang-format on
+}
+
+TEST_CASE("scan.complex.long_runs")
+{
+    // Exceeds the internal block size of decoded codepoints, with grapheme clusters crossing block boundaries.
+    auto const parts = std::vector<std::pair<std::u32string_view, size_t>> {
+        { U"\u4E00"sv, 2 },
+        { U"\u00E9\u0301"sv, 1 },
+        { FamilyEmoji, 2 },
+        { U"\u00E9"sv, 1 },
+    };
+
+    for (auto const& [part, columns]: parts)
+    {
+        auto text32 = std::u32string {};
+        for (size_t i = 0; i < 100; ++i)
+            text32 += part;
+        auto const text = u8(std::u32string_view(text32));
+        INFO(u8(part));
+
+        auto collector = grapheme_cluster_collector {};
+        auto state = unicode::scan_state {};
+        auto const result = unicode::scan_text(state, text, 1000, collector);
+        CHECK(result.count == 100 * columns);
+        CHECK(state.next == text.data() + text.size());
+        REQUIRE(collector.output.size() == 100);
+        for (auto const& cluster: collector.output)
+            CHECK(cluster == part);
+
+        // Width limited scan stops at a grapheme cluster boundary.
+        state = {};
+        auto const limited = unicode::scan_text(state, text, 51 * columns - 1);
+        CHECK(limited.count == 50 * columns);
+        CHECK(state.next == text.data() + text.size() / 2);
+    }
+}
+
+TEST_CASE("scan.complex.sliced_calls.every_offset")
+{
+    // Splits the input at every possible byte offset and checks that the result is independent of it.
+    auto const text = u8(U"\u4E00\u00A9\U0001F600\u00E9\u4E01"sv);
+    for (size_t split = 0; split <= text.size(); ++split)
+    {
+        INFO(fmt::format("split at {}", split));
+        auto state = unicode::scan_state {};
+        auto const first = unicode::scan_text(state, string_view(text.data(), split), 80);
+        auto const second =
+            unicode::scan_text(state, string_view(state.next, static_cast<size_t>(text.data() + text.size() - state.next)), 80);
+        CHECK(first.count + second.count == 8);
+        CHECK(state.next == text.data() + text.size());
+        CHECK(state.utf8.expectedLength == 0);
+    }
+}
+
+TEST_CASE("scan.complex.sliced_calls.grapheme_state")
+{
+    // Regional indicator pairs and emoji ZWJ sequences split across calls are segmented as if scanned at once.
+    auto const flag = U"\U0001F1E9\U0001F1EA"sv;
+    auto const text32 = std::u32string(flag) + std::u32string(flag) + std::u32string(FamilyEmoji)
+                        + std::u32string(flag) + U"é́"s;
+    auto const text = u8(std::u32string_view(text32));
+
+    auto state = unicode::scan_state {};
+    auto const whole = unicode::scan_text(state, text, 80).count;
+
+    for (size_t split = 0; split <= text.size(); ++split)
+    {
+        INFO(fmt::format("split at {}", split));
+        state = unicode::scan_state {};
+        auto const first = unicode::scan_text(state, string_view(text.data(), split), 80);
+        auto const second =
+            unicode::scan_text(state, string_view(state.next, static_cast<size_t>(text.data() + text.size() - state.next)), 80);
+        CHECK(first.count + second.count == whole);
+        CHECK(state.next == text.data() + text.size());
+    }
+}
+
+TEST_CASE("scan.complex.sliced_calls.VS16")
+{
+    // A grapheme cluster widened by VS16 in a later call only accounts for the columns it adds.
+    for (auto const& text: { u8(U"\u2764\uFE0F"sv), u8(U"\U0001F600\uFE0F"sv), "#"s + u8(U"\uFE0F"sv) })
+    {
+        INFO(text);
+        auto const split = text.size() - 3;
+        auto state = unicode::scan_state {};
+        auto const first = unicode::scan_text(state, string_view(text.data(), split), 80);
+        auto const second = unicode::scan_text(state, string_view(text.data() + split, 3), 80);
+        CHECK(first.count + second.count == 2);
+    }
+}
+
+TEST_CASE("scan.complex.sliced_calls.full_line")
+{
+    // Grapheme cluster continuations still fit when all columns are used up, also in a later call.
+    auto const text = u8(U"\u4E00\u0301"sv);
+    auto state = unicode::scan_state {};
+    CHECK(unicode::scan_text(state, string_view(text.data(), 3), 2).count == 2);
+    CHECK(unicode::scan_text(state, string_view(text.data() + 3, 2), 0).count == 0);
+    CHECK(state.next == text.data() + text.size());
+
+    auto const ascii = "e"s + u8(U"\u0301"sv);
+    state = {};
+    CHECK(unicode::scan_text(state, ascii, 1).count == 1);
+    CHECK(state.next == ascii.data() + ascii.size());
+}
+
+TEST_CASE("scan.complex.sliced_calls.pending_does_not_fit")
+{
+    // A resumed UTF-8 sequence that does not fit is left pending, rather than scanned again as invalid.
+    auto const text = "\xF0\x9F\x87\xA9"sv; // U+1F1E9
+    auto collector = grapheme_cluster_collector {};
+    auto state = unicode::scan_state {};
+    (void) unicode::scan_text(state, text.substr(0, 1), 80, collector);
+    auto const result = unicode::scan_text(state, text.substr(1), 0, collector);
+    CHECK(result.count == 0);
+    CHECK(collector.output.empty());
+    CHECK(state.next == text.data() + 1);
+    CHECK(state.utf8.expectedLength == 4);
+}
+
+namespace
+{
+
+// Receives grapheme clusters without deriving from grapheme_cluster_receiver.
+struct grapheme_cluster_widths
+{
+    std::vector<size_t> widths;
+
+    void receiveAsciiSequence(std::string_view sequence) noexcept
+    {
+        widths.insert(widths.end(), sequence.size(), 1);
+    }
+
+    void receiveGraphemeCluster(std::string_view, size_t columnCount) noexcept
+    {
+        widths.push_back(columnCount);
+    }
+
+    void receiveInvalidGraphemeCluster() noexcept { widths.push_back(1); }
+};
+
+class grapheme_cluster_width_collector final: public unicode::grapheme_cluster_receiver
+{
+  public:
+    grapheme_cluster_widths collected;
+
+    void receiveAsciiSequence(std::string_view sequence) noexcept override
+    {
+        collected.receiveAsciiSequence(sequence);
+    }
+
+    void receiveGraphemeCluster(std::string_view cluster, size_t columnCount) noexcept override
+    {
+        collected.receiveGraphemeCluster(cluster, columnCount);
+    }
+
+    void receiveInvalidGraphemeCluster() noexcept override { collected.receiveInvalidGraphemeCluster(); }
+};
+
+} // namespace
+
+TEST_CASE("scan.template_receiver")
+{
+    auto const text = u8(U"ab一é́c\U0001F600©️d"sv) + "\xC2" + "e";
+
+    for (size_t const limit: { size_t { 3 }, size_t { 80 } })
+    {
+        INFO(fmt::format("limit {}", limit));
+
+        auto virtualReceiver = grapheme_cluster_width_collector {};
+        auto virtualState = unicode::scan_state {};
+        auto const virtualResult = unicode::scan_text(
+            virtualState, text, limit, static_cast<unicode::grapheme_cluster_receiver&>(virtualReceiver));
+
+        auto templateReceiver = grapheme_cluster_widths {};
+        auto templateState = unicode::scan_state {};
+        auto const templateResult = unicode::scan_text(templateState, text, limit, templateReceiver);
+
+        CHECK(templateResult.count == virtualResult.count);
+        CHECK(templateResult.end == virtualResult.end);
+        CHECK(templateState.next == virtualState.next);
+        CHECK(templateReceiver.widths == virtualReceiver.collected.widths);
+    }
+}
+
+namespace
+{
+
+template <size_t Capacity>
+struct grapheme_cluster_storage
+{
+    std::array<size_t, Capacity> offsets {};
+    std::array<uint8_t, Capacity> widths {};
+    std::array<bool, Capacity> invalid {};
+    unicode::grapheme_cluster_buffer buffer { offsets.data(), widths.data(), invalid.data(), Capacity, 0 };
+};
+
+} // namespace
+
+TEST_CASE("scan.buffer")
+{
+    // "a", "一", "é́", invalid continuation byte, "\U0001F600", "b"
+    auto const text = "a"s + u8(U"\u4E00\u00E9\u0301"sv) + "\x80" + u8(U"\U0001F600"sv) + "b";
+
+    auto storage = grapheme_cluster_storage<8> {};
+    auto state = unicode::scan_state {};
+    auto const result = unicode::scan_text(state, text, 80, storage.buffer);
+
+    CHECK(result.count == 8);
+    CHECK(result.start == text.data());
+    CHECK(result.end == text.data() + text.size());
+    REQUIRE(storage.buffer.size == 6);
+    CHECK(storage.offsets[0] == 0);
+    CHECK(storage.offsets[1] == 1);
+    CHECK(storage.offsets[2] == 4);
+    CHECK(storage.offsets[3] == 8);
+    CHECK(storage.offsets[4] == 9);
+    CHECK(storage.offsets[5] == 13);
+    CHECK(storage.widths[0] == 1);
+    CHECK(storage.widths[1] == 2);
+    CHECK(storage.widths[2] == 1);
+    CHECK(storage.widths[3] == 1);
+    CHECK(storage.widths[4] == 2);
+    CHECK(storage.widths[5] == 1);
+    for (size_t i = 0; i < storage.buffer.size; ++i)
+        CHECK(storage.invalid[i] == (i == 3));
+
+    // Column limit reached before the buffer is full.
+    state = {};
+    auto const limited = unicode::scan_text(state, text, 4, storage.buffer);
+    CHECK(limited.count == 4);
+    CHECK(storage.buffer.size == 3);
+    CHECK(state.next == text.data() + 8);
+}
+
+TEST_CASE("scan.buffer.ascii_continuation")
+{
+    // Codepoints continuing the grapheme cluster of a US-ASCII character extend its entry.
+    auto const decomposed = "e"s + u8(U"\u0301"sv) + "x";
+    auto storage = grapheme_cluster_storage<8> {};
+    auto state = unicode::scan_state {};
+    auto const result = unicode::scan_text(state, decomposed, 80, storage.buffer);
+    REQUIRE(storage.buffer.size == 2);
+    CHECK(storage.offsets[0] == 0);
+    CHECK(storage.offsets[1] == 3);
+    CHECK(storage.widths[0] + storage.widths[1] == result.count);
+    CHECK(storage.widths[1] == 1);
+
+    auto const presentation = "a"s + u8(U"\uFE0F"sv);
+    state = {};
+    auto const emoji = unicode::scan_text(state, presentation, 80, storage.buffer);
+    REQUIRE(storage.buffer.size == 1);
+    CHECK(storage.offsets[0] == 0);
+    CHECK(storage.widths[0] == emoji.count);
+    CHECK(!storage.invalid[0]);
+}
+
+TEST_CASE("scan.buffer.full")
+{
+    // Scanning with a small buffer over and over yields the same grapheme clusters as a single scan.
+    auto const text = "ab"s + u8(U"\u4E00\u00E9\u0301\U0001F600\u00A9\uFE0F"sv) + "cdef" + u8(U"\u4E01"sv);
+
+    auto expected = grapheme_cluster_collector {};
+    auto state = unicode::scan_state {};
+    unicode::scan_text(state, text, 80, expected);
+
+    auto storage = grapheme_cluster_storage<3> {};
+    auto clusters = std::vector<std::u32string> {};
+    size_t columns = 0;
+    state = {};
+    for (auto input = std::string_view(text); !input.empty();)
+    {
+        auto const result = unicode::scan_text(state, input, 80, storage.buffer);
+        REQUIRE(storage.buffer.size != 0);
+        CHECK(storage.buffer.size <= 3);
+        for (size_t i = 0; i < storage.buffer.size; ++i)
+        {
+            auto const begin = result.start + storage.offsets[i];
+            auto const end = i + 1 < storage.buffer.size ? result.start + storage.offsets[i + 1] : result.end;
+            auto const cluster = std::string_view(begin, static_cast<size_t>(end - begin));
+            clusters.emplace_back(unicode::convert_to<char32_t>(cluster));
+            columns += storage.widths[i];
+        }
+        input.remove_prefix(static_cast<size_t>(state.next - input.data()));
+    }
+
+    CHECK(clusters == expected.output);
+    CHECK(columns == 15);
+}
+
+TEST_CASE("scan.width_policy")
+{
+    // U+00A1 and U+2026 (East_Asian_Width Ambiguous), "a", a Private Use Area codepoint, "e" with U+0301.
+    auto const text = u8(U"\u00A1\u2026a\uE000e\u0301"sv);
+    auto const overrides = std::array { unicode::width_override { 0xE000, 0xE0FF, 2 } };
+    auto const policy = unicode::width_policy { unicode::ambiguous_width::Wide, overrides };
+
+    auto state = unicode::scan_state {};
+    CHECK(unicode::scan_text(state, text, 80).count == 5);
+
+    state = {};
+    state.widths = &policy;
+    CHECK(unicode::scan_text(state, text, 80).count == 8);
+
+    // The column limit respects the adjusted widths.
+    state = {};
+    state.widths = &policy;
+    auto const limited = unicode::scan_text(state, text, 3);
+    CHECK(limited.count == 2);
+    CHECK(state.next == text.data() + 2);
+
+    // Grapheme clusters split across calls are scanned as if scanned at once.
+    state = {};
+    state.widths = &policy;
+    auto const first = unicode::scan_text(state, std::string_view(text).substr(0, 7), 80);
+    auto const second = unicode::scan_text(state, std::string_view(text).substr(7), 80);
+    CHECK(first.count + second.count == 8);
+}
@@ -15,6 +15,9 @@
 #include <libunicode/ucd.h>
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
 
 using namespace std;
 
@@ -40,108 +43,126 @@ optional<script_segmenter::result> script_segmenter::consume()
     if (offset_ >= size_)
         return nullopt;
 
+    auto const tables = script_properties::configured_tables();
     while (offset_ < size_)
     {
-        ScriptSet const nextScriptSet = getScriptsFor(currentChar());
+        if (auto const script = push(tables.get(currentChar())); script.has_value())
+            return result { *script, offset_++ };
 
-        if (!mergeSets(nextScriptSet, currentScriptSet_))
-        {
-            // If merging failed, then we have found a script segmeent boundary.
-            auto const res = result { resolveScript(), offset_ };
-            currentScriptSet_ = nextScriptSet;
-            return res;
-        }
-
-        offset_++;
+        offset_ = skipSameScriptProperties(offset_ + 1, tables);
     }
 
     auto const res = result { resolveScript(), offset_ };
-    currentScriptSet_.clear();
+    currentScriptSet_.scripts = {};
+    lastProperties_.reset();
     return res;
 }
 
-bool script_segmenter::mergeSets(ScriptSet const& nextSet, ScriptSet& currentSet)
+size_t script_segmenter::skipSameScriptProperties(size_t offset,
+                                                  script_properties::tables_view const& tables) const noexcept
 {
-    if (nextSet.empty() || currentSet.empty())
-        return false;
+    if (!lastProperties_)
+        return offset;
 
-    auto currentSetIter = currentSet.begin();
-    auto const currentSetEnd = currentSet.end();
+    // The properties are looked up in blocks, growing for as long as they stay the same,
+    // and compared without branching (a word of mismatch bits per block).
+    constexpr size_t InitialBlockSize = 8;
+    constexpr size_t MaxBlockSize = 64;
 
-    Script priorityScript = *currentSetIter++;
-
-    if (!isPreferred(nextSet.at(0)))
+    auto block = array<script_properties, MaxBlockSize> {};
+    auto const expected = *lastProperties_;
+    for (size_t blockSize = InitialBlockSize; offset < size_; blockSize = min(2 * blockSize, MaxBlockSize))
     {
-        if (nextSet.size() == 2 && !isPreferred(priorityScript) && commonPreferredScript_ == Script::Common)
-            commonPreferredScript_ = nextSet.at(1);
-        return true;
-    }
+        auto const count = min(blockSize, size_ - offset);
+        tables.get_many(data_ + offset, count, block.data());
 
-    // If priorityScript is either Common or Inherited then take nextScriptSet
-    if (!isPreferred(priorityScript))
-    {
-        currentSet = nextSet;
-        return true;
+        uint64_t mismatches = 0;
+        for (size_t i = 0; i < count; ++i)
+            mismatches |= uint64_t { block[i] != expected } << i;
+
+        if (mismatches)
+            return offset + static_cast<size_t>(countr_zero(mismatches));
+
+        offset += count;
     }
 
-    auto nextSetIter = nextSet.begin();
-    auto const nextSetEnd = nextSet.end();
+    return offset;
+}
 
-    if (currentSetIter == currentSetEnd)
-        return std::find(nextSetIter, nextSetEnd, priorityScript) != nextSetEnd;
+optional<Script> script_segmenter::push(char32_t codepoint)
+{
+    return push(script_properties::get(codepoint));
+}
 
-    // See if we have a priority script, and if not, get it from the nextScriptSet
-    bool hasPriorityScript = find(nextSetIter, nextSetEnd, priorityScript) != nextSetEnd;
-    if (!hasPriorityScript)
-    {
-        priorityScript = *nextSetIter++;
-        hasPriorityScript = find(currentSetIter, currentSetEnd, priorityScript) != currentSetEnd;
-    }
+optional<Script> script_segmenter::push(script_properties properties)
+{
+    if (properties == lastProperties_ && !currentScriptSet_.empty())
+        return nullopt;
 
-    auto currentWriteIter = currentSet.begin();
-    if (hasPriorityScript)
-        *currentWriteIter++ = priorityScript;
+    lastProperties_ = properties;
+    ScriptSet const nextScriptSet = getScriptsFor(properties);
+
+    if (mergeSets(nextScriptSet, currentScriptSet_))
+        return nullopt;
 
-    // Intersect the remaining nextScriptSet into the currentSetIter.
-    if (nextSetIter != nextSetEnd)
+    // If merging failed, then we have found a script segmeent boundary.
+    auto const script = resolveScript();
+    currentScriptSet_ = nextScriptSet;
+
+    // The codepoint starting the new segment is merged into it as any other one.
+    mergeSets(nextScriptSet, currentScriptSet_);
+
+    return script;
+}
+
+bool script_segmenter::mergeSets(ScriptSet const& nextSet, ScriptSet& currentSet)
+{
+    if (nextSet.empty() || currentSet.empty())
+        return false;
+
+    if (!isPreferred(nextSet.priority))
     {
-        while (currentSetIter != currentSetEnd)
+        if (nextSet.scripts.size() == 2 && !isPreferred(currentSet.priority)
+            && commonPreferredScript_ == Script::Common)
         {
-            auto const sc = *currentSetIter++;
-            if (find(nextSetIter, nextSetEnd, sc) != nextSetEnd)
-                *currentWriteIter++ = sc;
+            auto others = nextSet.scripts;
+            others.erase(nextSet.priority);
+            commonPreferredScript_ = others.first();
         }
+        return true;
+    }
+
+    // If the current priority script is either Common or Inherited then take nextScriptSet
+    if (!isPreferred(currentSet.priority))
+    {
+        currentSet = nextSet;
+        return true;
     }
 
-    // NB: first is always smaller than second, so it is save to cast to unsigned.
-    auto const writeCount = static_cast<size_t>(distance(currentSet.begin(), currentWriteIter));
-    if (writeCount == 0)
+    auto const intersection = currentSet.scripts & nextSet.scripts;
+    if (intersection.empty())
         return false;
 
-    currentSet.resize(writeCount);
+    // Keep the priority script if possible, otherwise take the one of nextSet.
+    if (!nextSet.scripts.contains(currentSet.priority))
+        currentSet.priority =
+            currentSet.scripts.contains(nextSet.priority) ? nextSet.priority : intersection.first();
+
+    currentSet.scripts = intersection;
     return true;
 }
 
-script_segmenter::ScriptSet script_segmenter::getScriptsFor(char32_t codepoint)
+script_segmenter::ScriptSet script_segmenter::getScriptsFor(script_properties properties) noexcept
 {
-    ScriptSet scriptSet;
-
-    // Collect all script(/-extensions) for @p _codepoint into scriptSet.
-    size_t const sceCount = script_extensions(codepoint, scriptSet.data(), scriptSet.capacity());
-    scriptSet.resize(sceCount);
-
-    // Get the script for @p _codepoint.
-    Script const sc = script(codepoint);
-
-    // If the script of @p _codepoint is also in scriptSet,
-    // then move it to the front of the set,
-    // otherwise append it to the back of scriptSet.
-    if (auto i = find(scriptSet.begin(), scriptSet.end(), sc); i != scriptSet.end())
-        swap(*i, *scriptSet.begin());
-    else
-        scriptSet.push_back(sc);
-
-    return scriptSet;
+    // The script of a codepoint takes priority amongst its script extensions.
+    // If it is not one of them (e.g. Common or Inherited), it is merely added to the set.
+    auto result = ScriptSet { properties.script_extensions(), properties.script };
+    if (!result.scripts.contains(properties.script))
+    {
+        result.priority = result.scripts.first();
+        result.scripts.insert(properties.script);
+    }
+    return result;
 }
 
 } // namespace unicode
@@ -13,6 +13,7 @@
  */
 #pragma once
 
+#include <libunicode/codepoint_properties.h>
 #include <libunicode/support.h>
 #include <libunicode/ucd.h>
 
@@ -40,13 +41,11 @@ class script_segmenter
     constexpr script_segmenter(char32_t const* data, size_t size) noexcept:
         data_ { data }, offset_ { 0 }, size_ { size }
     {
-        currentScriptSet_.push_back(Script::Common);
     }
 
     constexpr script_segmenter(std::u32string_view data) noexcept:
         data_ { data.data() }, offset_ { 0 }, size_ { data.size() }
     {
-        currentScriptSet_.push_back(Script::Common);
     }
 
     struct result
@@ -57,6 +56,22 @@ class script_segmenter
 
     std::optional<result> consume();
 
+    /// Processes the next @p codepoint of a text that is segmented incrementally,
+    /// i.e. without this segmenter holding the text.
+    ///
+    /// Looks up the configured tables on each call. To push the codepoints of a whole text, look up
+    /// their script properties through script_properties::configured_tables() once instead.
+    ///
+    /// @returns the script of the segment ending right before @p codepoint,
+    ///          if @p codepoint starts a new segment.
+    std::optional<Script> push(char32_t codepoint);
+
+    /// Same as push(char32_t), but with the script properties of the codepoint looked up by the caller.
+    std::optional<Script> push(script_properties properties);
+
+    /// @returns the script of the segment processed so far by push().
+    constexpr Script currentScript() const noexcept { return resolveScript(); }
+
     using property_type = Script;
 
     bool consume(out<size_t> size, out<Script> script)
@@ -71,7 +86,15 @@ class script_segmenter
     }
 
   private:
-    using ScriptSet = fs_array<Script, 32>;
+    /// Scripts a segment (or a single codepoint) can be attributed to,
+    /// along with the one to attribute it to, if it remains in the set.
+    struct ScriptSet
+    {
+        script_set scripts;
+        Script priority = Script::Invalid;
+
+        [[nodiscard]] constexpr bool empty() const noexcept { return scripts.empty(); }
+    };
 
     /// constexpr-version of strlen for UTF-32 strings
     constexpr size_t getStringLength(char32_t const* data) noexcept
@@ -85,8 +108,13 @@ class script_segmenter
         return n;
     }
 
-    /// Returnes all scripts that this @p _codepoint is associated with.
-    ScriptSet getScriptsFor(char32_t codepoint);
+    /// Returnes all scripts that codepoints of the given script properties are associated with.
+    static ScriptSet getScriptsFor(script_properties properties) noexcept;
+
+    /// Returns the offset of the first codepoint at or after @p offset
+    /// whose script properties differ from lastProperties_.
+    size_t skipSameScriptProperties(size_t offset,
+                                    script_properties::tables_view const& tables) const noexcept;
 
     /// Intersects @p _nextSet into @p _currentSet.
     ///
@@ -97,10 +125,10 @@ class script_segmenter
     /// Returns the resolved script.
     ///
     /// That is, if currentScriptSet is {Common}, then the preferred script for Common, otherwise
-    /// whatever currentScriptSet's one and only element contains.
+    /// whatever currentScriptSet's priority script is.
     constexpr Script resolveScript() const noexcept
     {
-        Script const result = currentScriptSet_.at(0);
+        Script const result = currentScriptSet_.priority;
         return result == Script::Common ? commonPreferredScript_ : result;
     }
 
@@ -112,8 +140,12 @@ class script_segmenter
     size_t offset_ = 0;
     size_t size_ = 0;
 
-    ScriptSet currentScriptSet_ {};
+    ScriptSet currentScriptSet_ { script_set { Script::Common }, Script::Common };
     Script commonPreferredScript_ = Script::Common;
+
+    // Script properties of the last codepoint merged into currentScriptSet_.
+    // Merging the same script properties again never changes the segment.
+    std::optional<script_properties> lastProperties_ {};
 };
 
 } // namespace unicode
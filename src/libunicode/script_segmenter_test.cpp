@@ -89,3 +89,51 @@ TEST_CASE("script_segmenter.latin_and_greek", "[script_segmenter]")
     auto const r3 = seg.consume();
     REQUIRE_FALSE(r3.has_value());
 }
+
+TEST_CASE("script_segmenter.script_extensions", "[script_segmenter]")
+{
+    // U+0964 DEVANAGARI DANDA is of script Common, but used with Devanagari and Bengali, amongst others.
+    auto constexpr str = U"\u0915\u0964 \u0995\u0964"sv;
+    auto seg = unicode::script_segmenter { str };
+
+    auto const r1 = seg.consume();
+    REQUIRE(r1.has_value());
+    CHECK(r1.value().size == 3);
+    CHECK(r1.value().script == unicode::Script::Devanagari);
+
+    auto const r2 = seg.consume();
+    REQUIRE(r2.has_value());
+    CHECK(r2.value().size == 5);
+    CHECK(r2.value().script == unicode::Script::Bengali);
+
+    REQUIRE_FALSE(seg.consume().has_value());
+}
+
+TEST_CASE("script_segmenter.long_runs", "[script_segmenter]")
+{
+    // Runs of codepoints of the same script are skipped over in blocks.
+    auto text = std::u32string {};
+    for (size_t i = 0; i < 100; ++i)
+        text += U"\u4E00";
+    text += U"abc";
+    for (size_t i = 0; i < 200; ++i)
+        text += U'\u03BB';
+
+    auto seg = unicode::script_segmenter { text };
+    auto const r1 = seg.consume();
+    REQUIRE(r1.has_value());
+    CHECK(r1.value().size == 100);
+    CHECK(r1.value().script == unicode::Script::Han);
+
+    auto const r2 = seg.consume();
+    REQUIRE(r2.has_value());
+    CHECK(r2.value().size == 103);
+    CHECK(r2.value().script == unicode::Script::Latin);
+
+    auto const r3 = seg.consume();
+    REQUIRE(r3.has_value());
+    CHECK(r3.value().size == 303);
+    CHECK(r3.value().script == unicode::Script::Greek);
+
+    REQUIRE_FALSE(seg.consume().has_value());
+}
@@ -0,0 +1,90 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace unicode
+{
+
+/// Whether or not scan_text() and the grapheme segmenters count their work into a given statistics,
+/// which is the case if libunicode is built with LIBUNICODE_STATISTICS (CMake option of the same name).
+///
+/// Otherwise, counting is compiled out entirely, and the statistics stay zero.
+#if defined(LIBUNICODE_STATISTICS)
+constexpr bool statistics_enabled = true; // NOLINT(readability-identifier-naming)
+#else
+constexpr bool statistics_enabled = false; // NOLINT(readability-identifier-naming)
+#endif
+
+/// Counters of where scan_text() and the grapheme segmenters spend their time,
+/// accumulated over all calls it is passed to, e.g. to be exported into a metrics pipeline.
+///
+/// A statistics object is not synchronized, i.e. each thread must count into one of its own.
+struct statistics
+{
+    /// Number of bytes scanned by the US-ASCII fast path of scan_text().
+    uint64_t asciiBytes = 0;
+
+    /// Number of bytes decoded codepoint by codepoint.
+    uint64_t complexBytes = 0;
+
+    /// Number of grapheme clusters segmented, except for those of US-ASCII scanned by scan_text().
+    uint64_t graphemeClusters = 0;
+
+    /// Number of ill-formed UTF-8 sequences.
+    uint64_t invalidSequences = 0;
+
+    /// Number of times scan_text() had to rewind to the start of a grapheme cluster,
+    /// because a VS16 made it exceed the maximum number of columns.
+    uint64_t rewinds = 0;
+
+    /// Number of times scan_text() stopped early, because the next grapheme cluster would exceed
+    /// the maximum number of columns.
+    uint64_t columnLimitStops = 0;
+
+    /// Number of codepoint properties table lookups.
+    uint64_t propertyLookups = 0;
+
+    constexpr statistics& operator+=(statistics const& other) noexcept
+    {
+        asciiBytes += other.asciiBytes;
+        complexBytes += other.complexBytes;
+        graphemeClusters += other.graphemeClusters;
+        invalidSequences += other.invalidSequences;
+        rewinds += other.rewinds;
+        columnLimitStops += other.columnLimitStops;
+        propertyLookups += other.propertyLookups;
+        return *this;
+    }
+
+    constexpr bool operator==(statistics const&) const noexcept = default;
+};
+
+namespace detail
+{
+    /// Adds @p n to the @p counter of @p stats, if given, and if statistics are enabled at all.
+    constexpr void count([[maybe_unused]] statistics* stats,
+                         [[maybe_unused]] uint64_t statistics::*counter,
+                         [[maybe_unused]] uint64_t n = 1) noexcept
+    {
+        if constexpr (statistics_enabled)
+        {
+            if (stats)
+                stats->*counter += n;
+        }
+    }
+} // namespace detail
+
+} // namespace unicode
@@ -0,0 +1,146 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/grapheme_segmenter.h>
+#include <libunicode/scan.h>
+#include <libunicode/statistics.h>
+#include <libunicode/utf8_grapheme_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <fmt/format.h>
+
+#include <string>
+#include <string_view>
+
+using namespace unicode;
+using namespace std::string_view_literals;
+
+namespace Catch
+{
+template <>
+struct StringMaker<statistics>
+{
+    static std::string convert(statistics const& s)
+    {
+        return fmt::format("{{ascii {}, complex {}, clusters {}, invalid {}, rewinds {}, stops {}, "
+                           "lookups {}}}",
+                           s.asciiBytes,
+                           s.complexBytes,
+                           s.graphemeClusters,
+                           s.invalidSequences,
+                           s.rewinds,
+                           s.columnLimitStops,
+                           s.propertyLookups);
+    }
+};
+} // namespace Catch
+
+namespace
+{
+
+// Returns @p expected if statistics are enabled, and all zero statistics otherwise.
+statistics expect(statistics expected) noexcept
+{
+    return statistics_enabled ? expected : statistics {};
+}
+
+statistics scan(std::string_view text, size_t maxColumnCount)
+{
+    auto stats = statistics {};
+    auto state = scan_state {};
+    state.stats = &stats;
+    while (!text.empty())
+    {
+        scan_text(state, text, maxColumnCount);
+        if (state.next == text.data())
+            break;
+        text.remove_prefix(static_cast<size_t>(state.next - text.data()));
+    }
+    return stats;
+}
+
+} // namespace
+
+TEST_CASE("statistics.accumulate")
+{
+    auto total = statistics { 1, 2, 3, 4, 5, 6, 7 };
+    total += statistics { 7, 6, 5, 4, 3, 2, 1 };
+    CHECK(total == statistics { 8, 8, 8, 8, 8, 8, 8 });
+}
+
+TEST_CASE("statistics.scan.mixed")
+{
+    // "ab", U+00E4 and an ill-formed byte, decoded as U+FFFD, followed by " c".
+    auto const stats = scan("ab\u00E4\xFF c"sv, 80);
+    CHECK(stats == expect({ .asciiBytes = 4, .complexBytes = 3, .graphemeClusters = 1, .invalidSequences = 1,
+                            .rewinds = 0, .columnLimitStops = 0, .propertyLookups = 2 }));
+}
+
+TEST_CASE("statistics.scan.column_limit")
+{
+    auto stats = statistics {};
+    auto state = scan_state {};
+    state.stats = &stats;
+
+    auto const ascii = "abc"sv;
+    scan_text(state, ascii, 2);
+    CHECK(stats == expect({ .asciiBytes = 2, .columnLimitStops = 1 }));
+    scan_text(state, ascii.substr(2), 0);
+    CHECK(stats == expect({ .asciiBytes = 2, .columnLimitStops = 2 }));
+
+    // Nothing to stop before at the end of the text.
+    stats = {};
+    scan_text(state, ascii, 3);
+    CHECK(stats == expect({ .asciiBytes = 3 }));
+
+    // Two wide grapheme clusters, of which the second one does not fit into the 3 columns.
+    stats = {};
+    auto const emoji = "\U0001F600\U0001F600"sv;
+    scan_text(state, emoji, 3);
+    CHECK(stats == expect({ .complexBytes = 4, .graphemeClusters = 1, .columnLimitStops = 1,
+                            .propertyLookups = 2 }));
+}
+
+TEST_CASE("statistics.scan.rewind")
+{
+    // U+2764 is one column wide, but two with VS16, which does not fit into one column.
+    auto stats = statistics {};
+    auto state = scan_state {};
+    state.stats = &stats;
+    auto const text = "\u2764\uFE0F"sv;
+    auto const result = scan_text(state, text, 1);
+    CHECK(result.count == 0);
+    CHECK(state.next == text.data());
+    CHECK(stats.rewinds == (statistics_enabled ? 1 : 0));
+    CHECK(stats.columnLimitStops == (statistics_enabled ? 1 : 0));
+}
+
+TEST_CASE("statistics.grapheme_segmenter")
+{
+    auto stats = statistics {};
+    auto const text = U"a\u0301b\U0001F1E9\U0001F1EA"sv;
+    for (auto segmenter = grapheme_segmenter(text, &stats); segmenter; ++segmenter)
+        ;
+    CHECK(stats == expect({ .graphemeClusters = 3, .propertyLookups = 5 }));
+}
+
+TEST_CASE("statistics.utf8_grapheme_cluster_segmenter")
+{
+    auto stats = statistics {};
+    auto const text = "a\u0301\xFF\U0001F1E9\U0001F1EA"sv;
+    for ([[maybe_unused]] auto const& cluster: utf8_grapheme_cluster_segmenter(text, nullptr, &stats))
+        ;
+    CHECK(stats == expect({ .complexBytes = text.size(), .graphemeClusters = 3, .invalidSequences = 1,
+                            .propertyLookups = 5 }));
+}
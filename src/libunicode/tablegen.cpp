@@ -12,15 +12,23 @@
  * limitations under the License.
  */
 #include <libunicode/codepoint_properties.h>
+#include <libunicode/codepoint_properties_file.h>
 #include <libunicode/codepoint_properties_loader.h>
 #include <libunicode/scoped_timer.h>
 #include <libunicode/ucd_ostream.h>
 
+#include <cstring>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 using namespace std::string_literals;
 
@@ -50,43 +58,69 @@ std::string_view minimum_uint_t(std::vector<T> const& values)
     return "uint64_t";
 }
 
+/// Output streams of the generated C++ tables.
+///
+/// Each table is declared in the header and defined in the implementation file, unless
+/// the tables are generated for use in constant expressions, in which case they are defined
+/// as inline constexpr variables in the header, and the implementation file is left without them.
+struct cxx_table_output
+{
+    std::ostream& header;
+    std::ostream& implementation;
+    bool constexprTables = false;
+
+    /// Writes the definition of the table @p name up to its initializer, and returns the stream
+    /// to write the initializer into.
+    std::ostream& define(std::string_view elementTypeName,
+                         size_t size,
+                         std::string_view name,
+                         bool cacheLineAligned = false)
+    {
+        auto const alignment = cacheLineAligned ? "alignas(64) " : "";
+        if (constexprTables)
+        {
+            header << alignment << "inline constexpr std::array<" << elementTypeName << ", " << size << "> "
+                   << name;
+            return header;
+        }
+        header << "extern std::array<" << elementTypeName << ", " << size << "> const " << name << ";\n";
+        implementation << alignment << "std::array<" << elementTypeName << ", " << size << "> const " << name;
+        return implementation;
+    }
+};
+
 template <typename T>
-void write_cxx_table(std::ostream& header,
-                     std::ostream& implementation,
+void write_cxx_table(cxx_table_output& output,
                      std::vector<T> const& table,
                      std::string_view name,
-                     bool commentOnBlock)
+                     size_t commentOnBlockSize = 0)
 {
     auto constexpr ColumnCount = 16;
 
-    auto const elementTypeName = minimum_uint_t(table);
-
-    header << "extern std::array<" << elementTypeName << ", " << table.size() << "> const " << name << ";\n";
-    implementation << "std::array<" << elementTypeName << ", " << table.size() << "> const " << name << " {";
+    auto& implementation = output.define(minimum_uint_t(table), table.size(), name);
+    implementation << " {";
     for (size_t i = 0; i < table.size(); ++i)
     {
         if (i % ColumnCount == 0)
             implementation << "\n    ";
 
-        if (commentOnBlock && i % unicode::codepoint_properties::tables_view::block_size == 0)
-            implementation << "// block number: "
-                           << (i / unicode::codepoint_properties::tables_view::block_size) << "\n    ";
+        if (commentOnBlockSize && i % commentOnBlockSize == 0)
+            implementation << "// block number: " << (i / commentOnBlockSize) << "\n    ";
 
         implementation << std::right << std::setw(4) << unsigned(table[i]) << ',';
     }
     implementation << "\n};\n\n";
 }
 
-void write_cxx_properties_table(std::ostream& header,
-                                std::ostream& implementation,
+void write_cxx_properties_table(cxx_table_output& output,
                                 std::vector<unicode::codepoint_properties> const& propertiesTable,
-                                std::string_view tableName)
+                                std::string_view tableName,
+                                bool cacheLineAligned = false)
 {
     using namespace unicode;
-    header << "extern std::array<codepoint_properties, " << propertiesTable.size() << "> const " << tableName
-           << ";\n";
-    implementation << "std::array<codepoint_properties, " << propertiesTable.size() << "> const " << tableName
-                   << "{{\n";
+    auto& implementation =
+        output.define("codepoint_properties", propertiesTable.size(), tableName, cacheLineAligned);
+    implementation << "{{\n";
     for (size_t i = 0; i < propertiesTable.size(); ++i)
     {
         // clang-format off
@@ -99,34 +133,233 @@ void write_cxx_properties_table(std::ostream& header,
                        << "East_Asian_Width::" << properties.east_asian_width << ", "
                        << "General_Category::" << properties.general_category << ", "
                        << "EmojiSegmentationCategory::" << properties.emoji_segmentation_category << ", "
-                       << "Age::" << properties.age
+                       << "Age::" << properties.age << ", "
+                       << "Vertical_Orientation::" << properties.vertical_orientation
                        << "},\n";
         // clang-format on
     }
     implementation << "}};\n\n";
 }
 
-void write_cxx_properties_table(std::ostream& header,
-                                std::ostream& implementation,
-                                std::vector<std::string> const& propertiesTable,
-                                std::string_view tableName)
+void write_cxx_narrow_properties_table(cxx_table_output& output,
+                                       std::vector<unicode::codepoint_properties> const& propertiesTable,
+                                       std::string_view tableName,
+                                       bool cacheLineAligned = false)
 {
     using namespace unicode;
-    header << "extern std::array<std::string_view, " << propertiesTable.size() << "> const " << tableName
-           << ";\n";
-    implementation << "std::array<std::string_view, " << propertiesTable.size() << "> const " << tableName
-                   << "{{\n";
+    auto constexpr ColumnCount = 16;
+
+    auto& implementation =
+        output.define("narrow_codepoint_properties", propertiesTable.size(), tableName, cacheLineAligned);
+    implementation << "{{";
     for (size_t i = 0; i < propertiesTable.size(); ++i)
-        implementation << "    \"" << propertiesTable[i] << "\"sv,\n";
+    {
+        auto const& properties = propertiesTable[i];
+        auto const narrow = narrow_codepoint_properties::from(properties);
+
+        // Ensure that the values fit into their bit fields.
+        if (narrow.char_width() != properties.char_width
+            || narrow.grapheme_cluster_break() != properties.grapheme_cluster_break)
+            throw std::runtime_error("Codepoint properties do not fit into narrow_codepoint_properties.");
+
+        if (i % ColumnCount == 0)
+            implementation << "\n    ";
+        implementation << "{ " << std::right << std::setw(3) << unsigned(narrow.value) << " },";
+    }
+    implementation << "\n}};\n\n";
+}
+
+void write_cxx_script_properties_table(cxx_table_output& output,
+                                       std::vector<unicode::script_properties> const& scriptsTable,
+                                       std::string_view tableName,
+                                       bool cacheLineAligned = false)
+{
+    using namespace unicode;
+    auto& implementation =
+        output.define("script_properties", scriptsTable.size(), tableName, cacheLineAligned);
+    implementation << "{{\n";
+    for (auto const& scripts: scriptsTable)
+        implementation << "    { Script::" << scripts.script << ", " << unsigned(scripts.extensions)
+                       << " },\n";
     implementation << "}};\n\n";
 }
 
+void write_cxx_break_properties_table(cxx_table_output& output,
+                                      std::vector<unicode::break_properties> const& breaksTable,
+                                      std::string_view tableName,
+                                      bool cacheLineAligned = false)
+{
+    using namespace unicode;
+    auto& implementation = output.define("break_properties", breaksTable.size(), tableName, cacheLineAligned);
+    implementation << "{{\n";
+    for (auto const& breaks: breaksTable)
+        implementation << "    { Word_Break::" << breaks.word_break << ", Line_Break::" << breaks.line_break
+                       << ", " << unsigned(breaks.flags) << " },\n";
+    implementation << "}};\n\n";
+}
+
+void write_cxx_normalization_properties_table(cxx_table_output& output,
+                                              std::vector<unicode::normalization_properties> const& table,
+                                              std::string_view tableName,
+                                              bool cacheLineAligned = false)
+{
+    auto constexpr ColumnCount = 8;
+
+    auto& implementation =
+        output.define("normalization_properties", table.size(), tableName, cacheLineAligned);
+    implementation << "{{";
+    for (size_t i = 0; i < table.size(); ++i)
+    {
+        if (i % ColumnCount == 0)
+            implementation << "\n    ";
+        implementation << "{ " << std::right << std::setw(3) << unsigned(table[i].canonical_combining_class)
+                       << ", " << std::setw(2) << unsigned(table[i].flags) << " },";
+    }
+    implementation << "\n}};\n\n";
+}
+
+void write_cxx_script_sets(cxx_table_output& output,
+                           std::vector<unicode::script_set> const& sets,
+                           std::string_view tableName)
+{
+    using namespace unicode;
+    auto& implementation = output.define("script_set", sets.size(), tableName);
+    implementation << "{\n";
+    for (auto const& set: sets)
+    {
+        implementation << "    script_set { { ";
+        for (auto const word: set.words())
+            implementation << "0x" << std::hex << std::setw(16) << std::setfill('0') << word << std::dec
+                           << std::setfill(' ') << "ull, ";
+        implementation << "} },\n";
+    }
+    implementation << "};\n\n";
+}
+
+void write_cxx_identifier_bitmaps(cxx_table_output& output,
+                                  std::vector<unicode::identifier_bitmap> const& blocks,
+                                  std::string_view tableName)
+{
+    using namespace unicode;
+    auto& implementation = output.define("identifier_bitmap", blocks.size(), tableName);
+    implementation << "{\n";
+    for (auto const& block: blocks)
+    {
+        implementation << "    identifier_bitmap { {";
+        for (size_t i = 0; i < block.words().size(); ++i)
+        {
+            implementation << (i % identifier_bitmap::WordsPerProperty == 0 ? "\n        " : " ") << "0x"
+                           << std::hex << std::setw(16) << std::setfill('0') << block.words()[i]
+                           << std::dec << std::setfill(' ') << "ull,";
+        }
+        implementation << "\n    } },\n";
+    }
+    implementation << "};\n\n";
+}
+
+/// Compressed codepoint names, as described in codepoint_names_view.
+struct compressed_names
+{
+    std::vector<uint32_t> offsets; // offset into names for each distinct name
+    std::vector<uint8_t> names;
+    std::vector<uint32_t> wordOffsets;
+    std::vector<uint8_t> words;
+};
+
+compressed_names compress_names(std::vector<std::string> const& names)
+{
+    using unicode::codepoint_names_view;
+
+    auto const _ = support::scoped_timer(&std::cout, "Compressing codepoint names");
+
+    struct parsed_name
+    {
+        std::vector<std::string_view> words;
+        uint8_t flags = 0;
+    };
+
+    // Split the names into words, leaving out the placeholder of algorithmically derived suffixes.
+    auto parsedNames = std::vector<parsed_name> {};
+    auto frequencies = std::unordered_map<std::string_view, size_t> {};
+    for (auto const& name: names)
+    {
+        auto text = std::string_view(name);
+        auto parsed = parsed_name {};
+        if (!text.empty() && text.back() == '*')
+        {
+            text.remove_suffix(1);
+            parsed.flags = text == "HANGUL SYLLABLE " ? codepoint_names_view::FlagHangulSyllable
+                                                      : codepoint_names_view::FlagHexSuffix;
+        }
+
+        if (text.size() + 7 > codepoint_names_view::MaxNameLength)
+            throw std::runtime_error("Codepoint name too long: "s + name);
+
+        while (!text.empty() || parsed.flags)
+        {
+            auto const end = std::min(text.find(' '), text.size());
+            parsed.words.emplace_back(text.substr(0, end));
+            ++frequencies[parsed.words.back()];
+            if (end == text.size())
+                break;
+            text.remove_prefix(end + 1);
+        }
+
+        if (parsed.words.size() > codepoint_names_view::TokenCountMask)
+            throw std::runtime_error("Codepoint name has too many words: "s + name);
+
+        parsedNames.emplace_back(std::move(parsed));
+    }
+
+    // The most frequent words get the shortest encodings.
+    auto dictionary = std::vector<std::string_view> {};
+    for (auto const& [word, frequency]: frequencies)
+        dictionary.emplace_back(word);
+    std::sort(dictionary.begin(), dictionary.end(), [&](auto a, auto b) {
+        return frequencies[a] != frequencies[b] ? frequencies[a] > frequencies[b] : a < b;
+    });
+    if (dictionary.size() > codepoint_names_view::MaxWordCount)
+        throw std::runtime_error("Too many distinct words in codepoint names.");
+
+    auto result = compressed_names {};
+    auto wordIndices = std::unordered_map<std::string_view, size_t> {};
+    for (auto const word: dictionary)
+    {
+        wordIndices[word] = result.wordOffsets.size();
+        result.wordOffsets.push_back(static_cast<uint32_t>(result.words.size()));
+        result.words.insert(result.words.end(), word.begin(), word.end());
+    }
+    result.wordOffsets.push_back(static_cast<uint32_t>(result.words.size()));
+
+    for (auto const& parsed: parsedNames)
+    {
+        result.offsets.push_back(static_cast<uint32_t>(result.names.size()));
+        result.names.push_back(static_cast<uint8_t>(parsed.words.size() | parsed.flags));
+        for (auto const word: parsed.words)
+        {
+            auto const index = wordIndices[word];
+            if (index >= codepoint_names_view::WideWordIndexFlag)
+                result.names.push_back(
+                    static_cast<uint8_t>(codepoint_names_view::WideWordIndexFlag | (index >> 8)));
+            result.names.push_back(static_cast<uint8_t>(index & 0xFF));
+        }
+    }
+
+    return result;
+}
+
 void write_cxx_tables(unicode::codepoint_properties_table const& tables,
                       unicode::codepoint_names_table const& namesTables,
+                      unicode::script_properties_table const& scriptsTables,
+                      unicode::break_properties_table const& breaksTables,
+                      unicode::normalization_properties_table const& normalizationTables,
+                      unicode::identifier_bitmaps_table const& identifierTables,
+                      compressed_names const& names,
                       std::ostream& header,
                       std::ostream& implementation,
                       std::ostream& namesFile,
-                      std::string_view namespaceName)
+                      std::string_view namespaceName,
+                      bool constexprTables)
 {
     auto const _ = support::scoped_timer(&std::cout, "Writing C++ table files");
 
@@ -157,31 +390,184 @@ void write_cxx_tables(unicode::codepoint_properties_table const& tables,
     implementation << "\n";
     implementation << "namespace " << namespaceName << "\n";
     implementation << "{\n\n";
-    write_cxx_table(header, implementation, tables.stage1, "stage1", false);
-    write_cxx_table(header, implementation, tables.stage2, "stage2", true);
-    write_cxx_properties_table(header, implementation, tables.stage3, "properties");
+    auto properties = cxx_table_output { header, implementation, constexprTables };
+    write_cxx_table(properties, tables.stage1, "stage1");
+    write_cxx_table(properties, tables.stage2, "stage2", tables.to_view().block_size);
+    write_cxx_properties_table(properties, tables.stage3, "properties");
+    write_cxx_properties_table(properties, tables.direct, "properties_direct", true);
+    write_cxx_narrow_properties_table(properties, tables.stage3, "narrow_properties");
+    write_cxx_narrow_properties_table(properties, tables.direct, "narrow_properties_direct", true);
+    write_cxx_script_properties_table(properties, scriptsTables.stage3, "scripts");
+    write_cxx_script_properties_table(properties, scriptsTables.direct, "scripts_direct", true);
+    write_cxx_script_sets(properties, scriptsTables.sets, "script_sets");
+    write_cxx_break_properties_table(properties, breaksTables.stage3, "breaks");
+    write_cxx_break_properties_table(properties, breaksTables.direct, "breaks_direct", true);
+    write_cxx_normalization_properties_table(properties, normalizationTables.stage3, "normalization");
+    write_cxx_normalization_properties_table(
+        properties, normalizationTables.direct, "normalization_direct", true);
+    write_cxx_table(properties, identifierTables.stage1, "identifier_stage1");
+    write_cxx_identifier_bitmaps(properties, identifierTables.blocks, "identifier_blocks");
     implementation << "} // end namespace " << namespaceName << "\n";
 
     namesFile << disclaimer;
     namesFile << "#include <libunicode/codepoint_properties_data.h>\n";
     namesFile << "\n";
     namesFile << "#include <array>\n";
-    namesFile << "#include <string_view>\n";
     namesFile << "#include <cstdint>\n";
     namesFile << "\n";
     namesFile << "using namespace unicode;\n";
-    namesFile << "using namespace std::string_view_literals;\n";
     namesFile << "\n";
     namesFile << "namespace " << namespaceName << "\n";
     namesFile << "{\n\n";
-    write_cxx_table(header, namesFile, namesTables.stage1, "names_stage1", false);
-    write_cxx_table(header, namesFile, namesTables.stage2, "names_stage2", true);
-    write_cxx_properties_table(header, namesFile, namesTables.stage3, "names_stage3");
+    // The names are not needed in constant expressions, and by far the largest tables.
+    auto namesOutput = cxx_table_output { header, namesFile };
+    write_cxx_table(namesOutput, namesTables.stage1, "names_stage1");
+    write_cxx_table(namesOutput, namesTables.stage2, "names_stage2", namesTables.to_view().block_size);
+    write_cxx_table(namesOutput, names.offsets, "names_stage3");
+    write_cxx_table(namesOutput, names.names, "names_data");
+    write_cxx_table(namesOutput, names.wordOffsets, "names_word_offsets");
+    write_cxx_table(namesOutput, names.words, "names_words");
     namesFile << "} // end namespace " << namespaceName << "\n";
 
     header << "\n} // end namespace " << namespaceName << "\n";
 }
 
+/// Writes the tables in the binary format described in codepoint_properties_file.h.
+void write_table_file(unicode::codepoint_properties_table const& tables,
+                      unicode::codepoint_names_table const& namesTables,
+                      unicode::script_properties_table const& scriptsTables,
+                      unicode::break_properties_table const& breaksTables,
+                      unicode::normalization_properties_table const& normalizationTables,
+                      unicode::identifier_bitmaps_table const& identifierTables,
+                      compressed_names const& names,
+                      std::string_view ucdVersion,
+                      std::ostream& output)
+{
+    using namespace unicode;
+    using table_file::section;
+
+    auto const _ = support::scoped_timer(&std::cout, "Writing binary table file");
+
+    auto const narrow = [](std::vector<codepoint_properties> const& properties) {
+        auto result = std::vector<narrow_codepoint_properties> {};
+        for (auto const& p: properties)
+            result.emplace_back(narrow_codepoint_properties::from(p));
+        return result;
+    };
+
+    auto header = table_file::header {};
+    std::memcpy(header.magic, table_file::Magic, sizeof(header.magic));
+    header.format_version = table_file::FormatVersion;
+    header.byte_order_mark = table_file::ByteOrderMark;
+    ucdVersion.copy(header.ucd_version, std::min(ucdVersion.size(), sizeof(header.ucd_version) - 1));
+    header.block_size = codepoint_properties::tables_view::block_size;
+    header.direct_size = codepoint_properties::tables_view::direct_size;
+    header.stage1_element_size = sizeof(codepoint_properties::tables_view::stage1_element_type);
+    header.stage2_element_size = sizeof(codepoint_properties::tables_view::stage2_element_type);
+    header.properties_size = sizeof(codepoint_properties);
+    header.names_block_size = codepoint_properties::names_view::index_view::block_size;
+
+    auto body = std::string {};
+    auto const append = [&](section id, auto const& elements) {
+        auto const bytes = elements.size() * sizeof(elements[0]);
+        auto const offset = sizeof(header) + body.size();
+        auto const padding = (table_file::SectionAlignment - offset % table_file::SectionAlignment)
+                             % table_file::SectionAlignment;
+        body.append(padding, '\0');
+        header.sections[static_cast<size_t>(id)] = { offset + padding, bytes };
+        body.append(reinterpret_cast<char const*>(elements.data()), bytes);
+    };
+    append(section::stage1, tables.stage1);
+    append(section::stage2, tables.stage2);
+    append(section::properties, tables.stage3);
+    append(section::properties_direct, tables.direct);
+    append(section::narrow_properties, narrow(tables.stage3));
+    append(section::narrow_properties_direct, narrow(tables.direct));
+    append(section::names_stage1, namesTables.stage1);
+    append(section::names_stage2, namesTables.stage2);
+    append(section::names_stage3, names.offsets);
+    append(section::names_data, names.names);
+    append(section::names_word_offsets, names.wordOffsets);
+    append(section::names_words, names.words);
+    append(section::script_properties, scriptsTables.stage3);
+    append(section::script_properties_direct, scriptsTables.direct);
+    append(section::script_sets, scriptsTables.sets);
+    append(section::break_properties, breaksTables.stage3);
+    append(section::break_properties_direct, breaksTables.direct);
+    append(section::normalization_properties, normalizationTables.stage3);
+    append(section::normalization_properties_direct, normalizationTables.direct);
+    append(section::identifier_stage1, identifierTables.stage1);
+    append(section::identifier_blocks, identifierTables.blocks);
+
+    output.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    output.write(body.data(), static_cast<std::streamsize>(body.size()));
+}
+
+/// Reports the sizes of some candidate multistage table layouts for the codepoint properties,
+/// including the ones with more index stages than multistage_table_view supports,
+/// and warns if the configured layout is not the smallest supported one.
+void explore_layouts(unicode::codepoint_properties_table const& tables, std::ostream& log)
+{
+    auto const candidates = std::vector<std::vector<size_t>> {
+        { 32 },     { 64 },     { 128 },    { 256 },    { 512 },    { 1024 },   { 16, 16 },
+        { 32, 16 }, { 64, 16 }, { 128, 16 }, { 32, 32 }, { 64, 32 }, { 16, 64 }, { 32, 64 },
+    };
+
+    auto statistics = std::vector<support::multistage_layout_statistics> {};
+    {
+        auto const _ = support::scoped_timer(&log, "Exploring multistage table layouts");
+
+        auto input = std::vector<unicode::codepoint_properties>(0x110'000);
+        for (char32_t codepoint = 0; codepoint < input.size(); ++codepoint)
+            input[codepoint] = tables.get(codepoint);
+
+        // The candidates are independent of each other, and thus explored in parallel.
+        auto explored = std::vector<std::future<support::multistage_layout_statistics>> {};
+        for (auto const& candidate: candidates)
+            explored.emplace_back(std::async(std::launch::async, [&input, &candidate]() {
+                return support::explore_layout(input.data(), input.size(), candidate, 0x10000);
+            }));
+        for (auto& future: explored)
+            statistics.emplace_back(future.get());
+    }
+
+    // clang-format off
+    log << "    layout      | stage sizes (elements x bytes)                    | bytes   | lines/lookup | BMP lines\n";
+    log << "    ------------+---------------------------------------------------+---------+--------------+----------\n";
+    // clang-format on
+
+    auto best = std::optional<support::multistage_layout_statistics> {};
+    for (auto const& stats: statistics)
+    {
+        auto layout = std::ostringstream {};
+        for (size_t i = 0; i < stats.blockSizes.size(); ++i)
+            layout << (i ? "/" : "") << stats.blockSizes[i];
+
+        auto stages = std::ostringstream {};
+        for (size_t i = 0; i < stats.stageSizes.size(); ++i)
+            stages << (i ? " + " : "") << stats.stageSizes[i] << 'x' << stats.stageElementSizes[i];
+
+        log << "    " << std::left << std::setw(11) << layout.str() << " | " << std::setw(49) << stages.str() << " | "
+            << std::right << std::setw(7) << stats.totalBytes << " | " << std::setw(12)
+            << stats.cacheLinesPerLookup << " | " << std::setw(9) << stats.probedCacheLines << '\n';
+
+        // multistage_table_view supports a single index stage, with 8-bit or 16-bit stage elements.
+        auto const supported =
+            stats.blockSizes.size() == 1 && stats.stageElementSizes[0] <= 2 && stats.stageElementSizes[1] <= 2;
+        if (supported && (!best || stats.totalBytes < best->totalBytes))
+            best = stats;
+    }
+
+    if (!best)
+        throw std::runtime_error("No supported multistage table layout found.");
+
+    auto constexpr ConfiguredBlockSize = unicode::codepoint_properties::tables_view::block_size;
+    log << "Smallest supported layout: block size " << best->blockSizes.front() << " (" << best->totalBytes
+        << " bytes), configured: block size " << ConfiguredBlockSize << '\n';
+    if (best->blockSizes.front() != ConfiguredBlockSize)
+        log << "Warning: The configured codepoint properties table layout is not the smallest supported one.\n";
+}
+
 char const* consumeParamterOrDefault(int& i, int argc, char const* argv[], char const* defaultValue) noexcept
 {
     if (argc > i)
@@ -192,7 +578,11 @@ char const* consumeParamterOrDefault(int& i, int argc, char const* argv[], char
 
 } // namespace
 
-// Usage: unicode_tablgen UCD_directory CPP_OUTPUTFILE NAMESPACE
+// Usage: unicode_tablgen UCD_directory CPP_HEADER CPP_IMPLEMENTATION CPP_NAMES NAMESPACE
+//                        [TABLE_FILE [UCD_VERSION [--constexpr]]]
+//
+// With --constexpr, the codepoint properties tables are defined inline constexpr in CPP_HEADER,
+// such that they can be used in constant expressions.
 int main(int argc, char const* argv[])
 {
     // clang-format off
@@ -202,14 +592,46 @@ int main(int argc, char const* argv[])
     auto const cxxImplementationFileName = consumeParamterOrDefault(i, argc, argv, "codepoint_properties_data.cpp");
     auto const cxxNamesFileName = consumeParamterOrDefault(i, argc, argv, "codepoint_names_data.cpp");
     auto const namespaceName = consumeParamterOrDefault(i, argc, argv, "unicode::precompiled");
+    auto const tableFileName = consumeParamterOrDefault(i, argc, argv, nullptr);
+    auto const ucdVersion = consumeParamterOrDefault(i, argc, argv, "");
+    auto const constexprTables = consumeParamterOrDefault(i, argc, argv, "") == "--constexpr"s;
     // clang-format on
 
     auto headerFile = std::ofstream(cxxHeaderFileName);
     auto implementationFile = std::ofstream(cxxImplementationFileName);
     auto namesFile = std::ofstream(cxxNamesFileName);
-    auto const [props, names] = unicode::load_from_directory(ucdDataDirectory, &std::cout);
+    auto const [props, namesTables, scriptsTables, breaksTables, normalizationTables, identifierTables] =
+        unicode::load_from_directory(ucdDataDirectory, &std::cout);
+    auto const names = compress_names(namesTables.stage3);
+
+    explore_layouts(props, std::cout);
 
-    write_cxx_tables(props, names, headerFile, implementationFile, namesFile, namespaceName);
+    write_cxx_tables(props,
+                     namesTables,
+                     scriptsTables,
+                     breaksTables,
+                     normalizationTables,
+                     identifierTables,
+                     names,
+                     headerFile,
+                     implementationFile,
+                     namesFile,
+                     namespaceName,
+                     constexprTables);
+
+    if (tableFileName)
+    {
+        auto tableFile = std::ofstream(tableFileName, std::ios::binary);
+        write_table_file(props,
+                         namesTables,
+                         scriptsTables,
+                         breaksTables,
+                         normalizationTables,
+                         identifierTables,
+                         names,
+                         ucdVersion,
+                         tableFile);
+    }
 
     return EXIT_SUCCESS;
 }
@@ -68,7 +68,11 @@ constexpr std::optional<T> search(std::array<Prop<T>, N> const& ranges, char32_t
         if (I.interval.to < codepoint)
             a = i + 1;
         else if (I.interval.from > codepoint)
+        {
+            if (i == 0)
+                return std::nullopt;
             b = i - 1;
+        }
         else
             return I.property;
     }
@@ -79,4 +83,25 @@ constexpr std::optional<T> search(std::array<Prop<T>, N> const& ranges, char32_t
     return std::nullopt;
 }
 
+/// Looks up the property value of @p codepoint in two-stage tables, as generated by mktables.py --multistage.
+///
+/// The codepoints are split into blocks of BlockSize codepoints, with @p stage1 mapping each block
+/// to the index of its values in @p stage2.
+///
+/// @returns the property value, or @p fallback if @p codepoint is out of range.
+template <size_t BlockSize, typename T, typename Index, size_t N1, typename Value, size_t N2>
+constexpr T lookup(std::array<Index, N1> const& stage1,
+                   std::array<Value, N2> const& stage2,
+                   char32_t codepoint,
+                   T fallback) noexcept
+{
+    static_assert((BlockSize & (BlockSize - 1)) == 0, "BlockSize must be a power of two.");
+
+    if (codepoint / BlockSize >= N1)
+        return fallback;
+
+    return static_cast<T>(stage2[static_cast<size_t>(stage1[codepoint / BlockSize]) * BlockSize
+                                 + codepoint % BlockSize]);
+}
+
 } // namespace unicode
@@ -0,0 +1,479 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/column_slice.h>
+#include <libunicode/convert.h>
+#include <libunicode/fused_run_segmenter.h>
+#include <libunicode/grapheme_segmenter.h>
+#include <libunicode/identifier.h>
+#include <libunicode/run_segmenter.h>
+#include <libunicode/scan.h>
+#include <libunicode/utf8.h>
+#include <libunicode/width.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+// Benchmarks the hot paths of libunicode against corpora of typical real-world text.
+//
+// Each benchmark reports the throughput in bytes of UTF-8 input per second, and in
+// codepoints per second. Pass --benchmark_perf_counters=CYCLES,INSTRUCTIONS to also
+// count hardware events (if Google Benchmark was built with libpfm), and
+// --benchmark_out=FILE --benchmark_out_format=json to write a report that
+// scripts/compare-benchmarks.py compares against benchmarks/baseline.json.
+
+using namespace std::string_view_literals;
+
+namespace
+{
+
+/// Size of each corpus, in bytes of UTF-8, large enough to exceed the L1 but not the L2 cache.
+constexpr size_t CorpusSize = 128 * 1024; // NOLINT(readability-identifier-naming)
+
+struct corpus
+{
+    std::string name;
+    std::string utf8;
+    std::u32string utf32;
+};
+
+/// Concatenates randomly chosen @p phrases, each followed by @p separator, up to CorpusSize bytes.
+std::string compose(std::vector<std::string_view> const& phrases, std::string_view separator)
+{
+    auto rng = std::mt19937 { 4711 }; // NB: Fixed seed, such that the corpora do not differ between runs.
+    auto pick = std::uniform_int_distribution<size_t> { 0, phrases.size() - 1 };
+    auto text = std::string {};
+    while (text.size() < CorpusSize)
+    {
+        text += phrases[pick(rng)];
+        text += separator;
+    }
+    return text;
+}
+
+std::string ascii_logs()
+{
+    return compose(
+        {
+            "2023-06-14T09:21:07.113Z INFO  [http] GET /api/v1/users/4711 200 12.4ms"sv,
+            "2023-06-14T09:21:07.245Z DEBUG [db] SELECT id, name FROM users WHERE id = $1 (rows=1)"sv,
+            "2023-06-14T09:21:08.002Z WARN  [cache] eviction of 128 entries, hit ratio 0.87"sv,
+            "2023-06-14T09:21:09.519Z ERROR [worker-3] job 0x7f3a2c failed: connection reset by peer"sv,
+        },
+        "\n");
+}
+
+std::string cjk()
+{
+    return compose(
+        {
+            "\u7D71\u4E00\u78BC\u662F\u96FB\u8166\u79D1\u5B78\u9818\u57DF\u88E1\u7684\u4E00\u9805\u696D"
+            "\u754C\u6A19\u6E96\uFF0C\u5305\u62EC\u5B57\u5143\u96C6\u3001\u7DE8\u78BC\u65B9\u6848\u7B49"
+            "\u3002"sv,
+            "\u30E6\u30CB\u30B3\u30FC\u30C9\u306F\u3001\u7B26\u53F7\u5316\u6587\u5B57\u96C6\u5408\u3084"
+            "\u6587\u5B57\u7B26\u53F7\u5316\u65B9\u5F0F\u306A\u3069\u3092\u5B9A\u3081\u305F\u3001\u6587"
+            "\u5B57\u30B3\u30FC\u30C9\u306E\u696D\u754C\u898F\u683C\u3067\u3042\u308B\u3002"sv,
+            "\uC720\uB2C8\uCF54\uB4DC\uB294 \uC804 \uC138\uACC4\uC758 \uBAA8\uB4E0 \uBB38\uC790\uB97C "
+            "\uCEF4\uD4E8\uD130\uC5D0\uC11C \uC77C\uAD00\uB418\uAC8C \uD45C\uD604\uD558\uACE0 \uB2E4"
+            "\uB8F0 \uC218 \uC788\uB3C4\uB85D \uC124\uACC4\uB41C \uC0B0\uC5C5 \uD45C\uC900\uC774\uB2E4."sv,
+        },
+        " ");
+}
+
+std::string arabic()
+{
+    return compose(
+        {
+            "\u064A\u0648\u0646\u064A\u0643\u0648\u062F \u0647\u0648 \u0645\u0639\u064A\u0627\u0631 "
+            "\u0635\u0646\u0627\u0639\u064A \u064A\u0647\u062F\u0641 \u0625\u0644\u0649 \u062A\u0645"
+            "\u0643\u064A\u0646 \u0627\u0644\u062D\u0648\u0627\u0633\u064A\u0628 \u0645\u0646 \u062A"
+            "\u0645\u062B\u064A\u0644 \u0627\u0644\u0646\u0635\u0648\u0635 \u0627\u0644\u0645\u0643\u062A"
+            "\u0648\u0628\u0629 \u0628\u0623\u063A\u0644\u0628 \u0646\u0638\u0645 \u0627\u0644\u0643"
+            "\u062A\u0627\u0628\u0629."sv,
+            "\u0627\u064E\u0644\u0633\u064E\u0651\u0644\u064E\u0627\u0645\u064F \u0639\u064E\u0644\u064E"
+            "\u064A\u0652\u0643\u064F\u0645\u0652 \u0648\u064E\u0631\u064E\u062D\u0652\u0645\u064E\u0629"
+            "\u064F \u0627\u0644\u0644\u0647\u0650 \u0648\u064E\u0628\u064E\u0631\u064E\u0643\u064E\u0627"
+            "\u062A\u064F\u0647\u064F"sv,
+        },
+        " ");
+}
+
+std::string devanagari()
+{
+    return compose(
+        {
+            "\u092F\u0942\u0928\u093F\u0915\u094B\u0921 \u092A\u094D\u0930\u0924\u094D\u092F\u0947\u0915 "
+            "\u0905\u0915\u094D\u0937\u0930 \u0915\u0947 \u0932\u093F\u090F \u090F\u0915 \u0935\u093F"
+            "\u0936\u0947\u0937 \u0938\u0902\u0916\u094D\u092F\u093E \u092A\u094D\u0930\u0926\u093E\u0928"
+            " \u0915\u0930\u0924\u093E \u0939\u0948, \u091A\u093E\u0939\u0947 \u0915\u094B\u0908 \u092D"
+            "\u0940 \u0915\u092E\u094D\u092A\u094D\u092F\u0942\u091F\u0930 \u092A\u094D\u0932\u0947\u091F"
+            "\u092B\u0949\u0930\u094D\u092E \u0939\u094B\u0964"sv,
+            "\u0915\u094D\u0937\u0924\u094D\u0930\u093F\u092F \u0924\u094D\u0930\u094D\u092F\u092E\u094D"
+            "\u092C\u0915\u0902 \u0936\u094D\u0930\u0940\u092E\u093E\u0928\u094D \u0926\u094D\u0935\u093E"
+            "\u0930\u093E \u092A\u094D\u0930\u091C\u094D\u091E\u093E"sv,
+        },
+        " ");
+}
+
+std::string emoji_chat()
+{
+    return compose(
+        {
+            "see you tomorrow \U0001F44B\U0001F60A"sv,
+            "family trip \U0001F468\u200D\U0001F469\u200D\U0001F467\u200D\U0001F466 to \U0001F1E9"
+            "\U0001F1EA and \U0001F1EF\U0001F1F5 \u2708\uFE0F"sv,
+            "great job \U0001F44D\U0001F3FD\U0001F44D\U0001F3FF \u2764\uFE0F\u2764\uFE0F\u2764\uFE0F"sv,
+            "\U0001F9D1\u200D\U0001F4BB coding all night \u2615\uFE0F\u2615\uFE0F \U0001F3F3\uFE0F\u200D"
+            "\U0001F308"sv,
+            "lol \U0001F602\U0001F602\U0001F602\U0001F923"sv,
+        },
+        " ");
+}
+
+/// Random bytes, mostly forming ill-formed UTF-8, yet without C0 control characters.
+std::string invalid_utf8()
+{
+    auto rng = std::mt19937 { 4711 };
+    auto byte = std::uniform_int_distribution<int> { 0x20, 0xFF };
+    auto text = std::string(CorpusSize, '\0');
+    for (auto& ch: text)
+        ch = static_cast<char>(byte(rng));
+    return text;
+}
+
+std::vector<corpus> const& corpora()
+{
+    static auto const all = [] {
+        auto result = std::vector<corpus> {};
+        auto add = [&](std::string name, std::string text) {
+            auto utf32 = unicode::convert_to<char32_t>(std::string_view(text));
+            result.push_back(corpus { std::move(name), std::move(text), std::move(utf32) });
+        };
+        add("ascii_logs", ascii_logs());
+        add("cjk", cjk());
+        add("arabic", arabic());
+        add("devanagari", devanagari());
+        add("emoji_chat", emoji_chat());
+        add("invalid_utf8", invalid_utf8());
+        return result;
+    }();
+    return all;
+}
+
+void set_throughput(benchmark::State& state, corpus const& input)
+{
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.utf8.size()));
+    state.counters["codepoints"] = benchmark::Counter(static_cast<double>(input.utf32.size()),
+                                                      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void scan_text(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        // Scans all of the text, continuing after each control character scan_text() stops at.
+        auto columns = size_t { 0 };
+        auto scanState = unicode::scan_state {};
+        auto const* const end = input.utf8.data() + input.utf8.size();
+        for (auto const* text = input.utf8.data(); text != end;)
+        {
+            columns += unicode::scan_text(scanState,
+                                          std::string_view(text, static_cast<size_t>(end - text)),
+                                          std::numeric_limits<size_t>::max())
+                           .count;
+            text = scanState.next;
+            if (text != end)
+                ++text;
+        }
+        benchmark::DoNotOptimize(columns);
+    }
+    set_throughput(state, input);
+}
+
+/// Counts the grapheme clusters received, such that scanning them cannot be optimized away.
+class counting_receiver final: public unicode::grapheme_cluster_receiver
+{
+  public:
+    void receiveAsciiSequence(std::string_view codepoints) noexcept override { count += codepoints.size(); }
+    void receiveGraphemeCluster(std::string_view, size_t) noexcept override { ++count; }
+    void receiveInvalidGraphemeCluster() noexcept override { ++count; }
+
+    size_t count = 0;
+};
+
+/// Scans all of the text like scan_text() above, passing the grapheme clusters to @p receiver,
+/// through the template overload of scan_text() unless Receiver is grapheme_cluster_receiver.
+template <typename Receiver>
+void scan_text_into(benchmark::State& state, corpus const& input, Receiver& receiver)
+{
+    for (auto _: state)
+    {
+        auto scanState = unicode::scan_state {};
+        auto const* const end = input.utf8.data() + input.utf8.size();
+        for (auto const* text = input.utf8.data(); text != end;)
+        {
+            (void) unicode::scan_text(scanState,
+                                      std::string_view(text, static_cast<size_t>(end - text)),
+                                      std::numeric_limits<size_t>::max(),
+                                      receiver);
+            text = scanState.next;
+            if (text != end)
+                ++text;
+        }
+        benchmark::DoNotOptimize(receiver);
+    }
+    set_throughput(state, input);
+}
+
+/// Scans with a final receiver, whose callbacks are dispatched statically.
+void scan_text_static_receiver(benchmark::State& state, corpus const& input)
+{
+    auto receiver = counting_receiver {};
+    scan_text_into<counting_receiver>(state, input, receiver);
+}
+
+/// Scans with the same receiver, but through the virtual callbacks of grapheme_cluster_receiver.
+void scan_text_virtual_receiver(benchmark::State& state, corpus const& input)
+{
+    auto receiver = counting_receiver {};
+    scan_text_into<unicode::grapheme_cluster_receiver>(state, input, receiver);
+}
+
+void grapheme_segmenter(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        auto clusters = size_t { 0 };
+        for (auto segmenter = unicode::grapheme_segmenter(input.utf32); segmenter.codepointsAvailable();
+             ++segmenter)
+            ++clusters;
+        benchmark::DoNotOptimize(clusters);
+    }
+    set_throughput(state, input);
+}
+
+void run_segmenter(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        auto runs = size_t { 0 };
+        auto segmenter = unicode::run_segmenter(input.utf32);
+        auto run = unicode::run_segmenter::range {};
+        while (segmenter.consume(unicode::out(run)))
+            ++runs;
+        benchmark::DoNotOptimize(runs);
+    }
+    set_throughput(state, input);
+}
+
+void fused_run_segmenter(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        auto runs = size_t { 0 };
+        auto segmenter = unicode::fused_run_segmenter(input.utf32);
+        auto run = unicode::fused_run_segmenter::range {};
+        while (segmenter.consume(unicode::out(run)))
+            ++runs;
+        benchmark::DoNotOptimize(runs);
+    }
+    set_throughput(state, input);
+}
+
+void convert_to_utf32(benchmark::State& state, corpus const& input)
+{
+    auto output = std::u32string {};
+    output.reserve(input.utf32.size());
+    for (auto _: state)
+    {
+        output.clear();
+        unicode::convert_to<char32_t>(std::string_view(input.utf8), std::back_inserter(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    set_throughput(state, input);
+}
+
+void convert_to_utf8(benchmark::State& state, corpus const& input)
+{
+    auto output = std::string {};
+    output.reserve(input.utf8.size() * 2);
+    for (auto _: state)
+    {
+        output.clear();
+        unicode::convert_to<char>(std::u32string_view(input.utf32), std::back_inserter(output));
+        benchmark::DoNotOptimize(output.data());
+    }
+    set_throughput(state, input);
+}
+
+void codepoint_properties_get(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        auto widths = size_t { 0 };
+        for (auto const codepoint: input.utf32)
+            widths += unicode::codepoint_properties::get(codepoint).char_width;
+        benchmark::DoNotOptimize(widths);
+    }
+    set_throughput(state, input);
+}
+
+// The following benchmarks call the per codepoint (or per byte) primitives in a loop of their own,
+// such that their cost is dominated by the calls rather than by what is built on top of them.
+
+void width(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        auto widths = 0;
+        for (auto const codepoint: input.utf32)
+            widths += unicode::width(codepoint);
+        benchmark::DoNotOptimize(widths);
+    }
+    set_throughput(state, input);
+}
+
+void from_utf8(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        auto decoder = unicode::utf8_decoder_state {};
+        auto codepoints = size_t { 0 };
+        for (auto const byte: input.utf8)
+        {
+            auto const result = unicode::from_utf8(decoder, static_cast<uint8_t>(byte));
+            if (std::holds_alternative<unicode::Success>(result))
+                ++codepoints;
+        }
+        benchmark::DoNotOptimize(codepoints);
+    }
+    set_throughput(state, input);
+}
+
+void decode_utf8(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        auto decoder = unicode::utf8_decoder_state {};
+        auto codepoints = size_t { 0 };
+        for (auto const byte: input.utf8)
+            if (unicode::decode_utf8(decoder, static_cast<uint8_t>(byte)) < unicode::Utf8Invalid)
+                ++codepoints;
+        benchmark::DoNotOptimize(codepoints);
+    }
+    set_throughput(state, input);
+}
+
+void grapheme_process_breakable(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        auto segmenterState = unicode::grapheme_segmenter_state {};
+        auto breaks = size_t { 0 };
+        for (auto const codepoint: input.utf32)
+            if (unicode::grapheme_process_breakable(codepoint, segmenterState))
+                ++breaks;
+        benchmark::DoNotOptimize(breaks);
+    }
+    set_throughput(state, input);
+}
+
+void scan_identifier(benchmark::State& state, corpus const& input)
+{
+    for (auto _: state)
+    {
+        // Lexes all of the text into identifiers, white space and single bytes of anything else.
+        auto identifiers = size_t { 0 };
+        auto text = std::string_view(input.utf8);
+        while (!text.empty())
+        {
+            auto length = unicode::scan_identifier(text);
+            identifiers += length != 0 ? 1 : 0;
+            if (length == 0)
+                length = unicode::scan_pattern_white_space(text);
+            text.remove_prefix(length != 0 ? length : 1);
+        }
+        benchmark::DoNotOptimize(identifiers);
+    }
+    set_throughput(state, input);
+}
+
+void slice_columns(benchmark::State& state, corpus const& input)
+{
+    // Slices the last 80 columns, i.e. scans all of the text.
+    auto const columns = unicode::column_index(input.utf8).columns();
+    for (auto _: state)
+        benchmark::DoNotOptimize(unicode::slice_columns(input.utf8, columns - 80, columns));
+    set_throughput(state, input);
+}
+
+void column_index_slice(benchmark::State& state, corpus const& input)
+{
+    // Slices 80 columns at a time, as if horizontally scrolling through all of the text.
+    auto const index = unicode::column_index(input.utf8);
+    auto first = size_t { 0 };
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(index.slice(first, first + 80));
+        first = (first + 97) % index.columns();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    using benchmark_function = void (*)(benchmark::State&, corpus const&);
+    auto const benchmarks = std::array<std::pair<char const*, benchmark_function>, 16> { {
+        { "scan_text", &scan_text },
+        { "scan_text<static receiver>", &scan_text_static_receiver },
+        { "scan_text<virtual receiver>", &scan_text_virtual_receiver },
+        { "grapheme_segmenter", &grapheme_segmenter },
+        { "run_segmenter", &run_segmenter },
+        { "fused_run_segmenter", &fused_run_segmenter },
+        { "convert_to<char32_t>", &convert_to_utf32 },
+        { "convert_to<char>", &convert_to_utf8 },
+        { "codepoint_properties::get", &codepoint_properties_get },
+        { "width", &width },
+        { "from_utf8", &from_utf8 },
+        { "decode_utf8", &decode_utf8 },
+        { "grapheme_process_breakable", &grapheme_process_breakable },
+        { "scan_identifier", &scan_identifier },
+        { "slice_columns", &slice_columns },
+        { "column_index::slice", &column_index_slice },
+    } };
+
+    for (auto const& [name, function]: benchmarks)
+        for (auto const& input: corpora())
+            benchmark::RegisterBenchmark((std::string(name) + '/' + input.name).c_str(),
+                                         [function = function, &input](benchmark::State& state) {
+                                             function(state, input);
+                                         });
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -13,6 +13,9 @@
  */
 #pragma once
 
+#include <libunicode/convert.h>
+
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -58,18 +61,20 @@ constexpr inline unsigned to_utf8(char32_t character, uint8_t* result)
     }
 }
 
+/// Converts a UTF-32 string into an UTF-8 string, reusing the storage of @p output.
+///
+/// Ill-formed codepoints are replaced with U+FFFD.
+inline void to_utf8(std::u32string_view characters, std::string& output)
+{
+    output.resize(utf8_length(characters));
+    convert_utf32_to_utf8(characters, output, ConversionErrorPolicy::Replace);
+}
+
 /// Converts a UTF-32 string into an UTF-8 sring.
 inline std::string to_utf8(char32_t const* characters, size_t n)
 {
     std::string s;
-    s.reserve(n);
-    for (size_t i = 0; i < n; ++i)
-    {
-        uint8_t bytes[4];
-        unsigned const len = to_utf8(characters[i], bytes);
-        s.append((char const*) bytes, len);
-    }
-
+    to_utf8(std::u32string_view(characters, n), s);
     return s;
 }
 
@@ -105,35 +110,97 @@ struct Success { char32_t value; };
 
 using ConvertResult = std::variant<Invalid, Incomplete, Success>;
 
-/// Progressively decodes a UTF-8 codepoint.
-ConvertResult from_utf8(utf8_decoder_state& state, uint8_t value) noexcept;
+/// Return value of decode_utf8(), if more bytes are needed to complete the current codepoint.
+constexpr char32_t Utf8Incomplete = static_cast<char32_t>(-1); // NOLINT(readability-identifier-naming)
 
-inline unsigned from_utf8i(utf8_decoder_state& state, uint8_t value)
+/// Return value of decode_utf8(), if the current UTF-8 sequence is ill-formed.
+constexpr char32_t Utf8Invalid = static_cast<char32_t>(-2); // NOLINT(readability-identifier-naming)
+
+namespace detail
+{
+    /// Length of the UTF-8 sequence a byte with the given number of leading one bits starts,
+    /// or 0 if it cannot start one at all (i.e. it is a continuation byte, or 0xF8 and above).
+    constexpr uint8_t utf8_sequence_length[9] = { 1, 0, 2, 3, 4, 0, 0, 0, 0 };
+} // namespace detail
+
+/// Progressively decodes a UTF-8 codepoint.
+///
+/// Returns the decoded codepoint if @p value completes it, or otherwise Utf8Incomplete or Utf8Invalid,
+/// which are both above the Unicode codespace, so that the caller tests for a result with a single
+/// comparison, rather than visiting a ConvertResult.
+///
+/// A byte that starts a new sequence while the previous one is still incomplete results into Invalid,
+/// but also already starts decoding the next codepoint.
+///
+/// Defined inline, as it is called for every single byte of the input.
+constexpr char32_t decode_utf8(utf8_decoder_state& state, uint8_t value) noexcept
 {
-    auto const result = from_utf8(state, value);
+    if (!state.expectedLength)
+    {
+        state.currentLength = 1;
+        if (value < 0x80)
+            return value;
+
+        auto const length = detail::utf8_sequence_length[std::countl_one(value)];
+        if (!length)
+            return Utf8Invalid;
+
+        state.expectedLength = length;
+        state.character = value & (0x7Fu >> length);
+        return Utf8Incomplete;
+    }
+
+    if (static_cast<uint8_t>(value - 0xC0) < 0x38)
+    {
+        // We have a new codepoint (lead byte 0xC0..0xF7), but the previous one was incomplete.
+        // Return Invalid for the current incomplete codepoint, but have already started the next codepoint.
+        auto const length = detail::utf8_sequence_length[std::countl_one(value)];
+        state.currentLength = 1;
+        state.expectedLength = length;
+        state.character = value & (0x7Fu >> length);
+        return Utf8Invalid;
+    }
 
-    if (std::holds_alternative<Incomplete>(result))
-        return static_cast<unsigned>(-1);
+    state.character = (state.character << 6) | (value & 0b0011'1111);
+    if (++state.currentLength < state.expectedLength)
+        return Utf8Incomplete;
 
-    if (std::holds_alternative<Invalid>(result))
-        return static_cast<unsigned>(-2);
+    state.expectedLength = 0; // reset state
+    return state.character;
+}
+
+/// Progressively decodes a UTF-8 codepoint, same as decode_utf8(), but wrapping its result
+/// into a ConvertResult.
+inline ConvertResult from_utf8(utf8_decoder_state& state, uint8_t value) noexcept
+{
+    auto const result = decode_utf8(state, value);
+    if (result == Utf8Incomplete)
+        return Incomplete {};
+    if (result == Utf8Invalid)
+        return Invalid {};
+    return Success { result };
+}
 
-    return std::get<Success>(result).value;
+inline unsigned from_utf8i(utf8_decoder_state& state, uint8_t value)
+{
+    return decode_utf8(state, value);
 }
 
 inline ConvertResult from_utf8(uint8_t const* bytes, size_t* size)
 {
     auto state = utf8_decoder_state {};
-    auto result = ConvertResult {};
+    auto result = Utf8Incomplete;
 
     do
-        result = from_utf8(state, *bytes++);
-    while (std::holds_alternative<Incomplete>(result));
+        result = decode_utf8(state, *bytes++);
+    while (result == Utf8Incomplete);
 
     if (size)
         *size = state.currentLength;
 
-    return result;
+    if (result == Utf8Invalid)
+        return Invalid {};
+    return Success { result };
 }
 
 #if 0 // TODO(do that later) __cplusplus > 201703L // C++20 (char8_t)
@@ -152,17 +219,26 @@ template <typename T = char32_t>
 inline std::basic_string<T> from_utf8(std::string_view bytes)
 {
     static_assert(sizeof(T) == 4);
-    std::basic_string<T> s;
-    size_t offset = 0;
-    while (offset < bytes.size())
+    if constexpr (std::is_same_v<T, char32_t>)
+        return convert_to<char32_t>(bytes);
+    else
     {
-        size_t i {};
-        ConvertResult const result = from_utf8(bytes.data() + offset, &i);
-        if (std::holds_alternative<Success>(result))
-            s += T(std::get<Success>(result).value);
-        offset += i;
+        std::basic_string<T> s;
+        size_t offset = 0;
+        while (offset < bytes.size())
+        {
+            auto state = utf8_decoder_state {};
+            auto result = Utf8Incomplete;
+            do
+                result = decode_utf8(state, static_cast<uint8_t>(bytes[offset++]));
+            while (result == Utf8Incomplete && offset < bytes.size());
+            if (result == Utf8Invalid && state.expectedLength)
+                --offset; // The byte cutting short the invalid sequence starts the next one.
+            else if (result != Utf8Invalid)
+                s += T(result);
+        }
+        return s;
     }
-    return s;
 }
 
 } // namespace unicode
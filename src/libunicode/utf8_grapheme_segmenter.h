@@ -11,10 +11,17 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#pragma once
+
 #include <libunicode/convert.h>
+#include <libunicode/emoji_sequence.h>
+#include <libunicode/grapheme_cluster_cache.h>
 #include <libunicode/grapheme_segmenter.h>
+#include <libunicode/statistics.h>
 #include <libunicode/utf8.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <ostream>
 #include <string_view>
 
@@ -52,6 +59,10 @@ class utf8_grapheme_segmenter::iterator
     value_type const& value() const noexcept;
     value_type const& operator*() const noexcept;
 
+    /// Tests whether the current grapheme cluster is an RGI emoji sequence (see is_rgi_emoji_sequence()),
+    /// with its hash computed while segmenting it.
+    bool isRGIEmojiSequence() const noexcept { return is_rgi_emoji_sequence(_cluster, _clusterHash); }
+
     iterator& operator++() noexcept;
     iterator operator++(int) noexcept;
 
@@ -68,9 +79,93 @@ class utf8_grapheme_segmenter::iterator
     char const* _nextUtf8;
     char const* _end;
     utf8_decoder_state _utf8_decoder_state {};
-    ConvertResult _result = Incomplete {};
     char32_t _nextCodepoint {};
     value_type _cluster {};
+    emoji_sequence_hash _clusterHash {};
+};
+
+/// A grapheme cluster, referring to the UTF-8 text it has been segmented from.
+struct utf8_grapheme_cluster
+{
+    /// The UTF-8 sequences the grapheme cluster consists of.
+    std::string_view text;
+
+    /// Number of columns the grapheme cluster occupies, being the width of its first codepoint,
+    /// or 2 if it contains U+FE0F VARIATION SELECTOR-16 (as in scan_text()).
+    size_t width;
+
+    /// First codepoint of the grapheme cluster, with ill-formed UTF-8 decoded as U+FFFD.
+    char32_t codepoint;
+
+    /// Properties of the first codepoint.
+    narrow_codepoint_properties properties;
+};
+
+/// Segments UTF-8 text into grapheme clusters without copying, i.e. yielding
+/// views into the given text rather than decoding it into UTF-32.
+struct utf8_grapheme_cluster_segmenter
+{
+    class iterator;
+
+    explicit utf8_grapheme_cluster_segmenter(std::string_view text) noexcept;
+
+    /// Same as above, but skipping the repeated grapheme clusters found in @p cache in one go,
+    /// and storing the others in it, if given, and counting the work done into @p stats
+    /// (see statistics_enabled).
+    utf8_grapheme_cluster_segmenter(std::string_view text,
+                                    grapheme_cluster_cache* cache,
+                                    statistics* stats = nullptr) noexcept;
+
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+
+  private:
+    std::string_view _text;
+    grapheme_cluster_cache* _cache = nullptr;
+    statistics* _stats = nullptr;
+};
+
+class utf8_grapheme_cluster_segmenter::iterator
+{
+  public:
+    using value_type = utf8_grapheme_cluster;
+
+    iterator(char const* data,
+             char const* end,
+             grapheme_cluster_cache* cache = nullptr,
+             statistics* stats = nullptr) noexcept;
+
+    value_type const& value() const noexcept { return _cluster; }
+    value_type const& operator*() const noexcept { return _cluster; }
+    value_type const* operator->() const noexcept { return &_cluster; }
+
+    iterator& operator++() noexcept;
+    iterator operator++(int) noexcept;
+
+    bool operator==(iterator const& other) const noexcept
+    {
+        return _cluster.text.data() == other._cluster.text.data();
+    }
+
+    bool operator!=(iterator const& other) const noexcept { return !(*this == other); }
+
+  private:
+    void decodeNextCodepoint() noexcept;
+    void consumeGraphemeCluster() noexcept;
+
+    char const* _next;    // Start of the next codepoint.
+    char const* _end;
+    grapheme_cluster_cache* _cache;
+    statistics* _stats;
+    size_t _nextLength {}; // Length of the next codepoint's UTF-8 sequence.
+    bool _nextInvalid {};  // Whether the next codepoint's UTF-8 sequence is ill-formed.
+    char32_t _nextCodepoint {};
+    narrow_codepoint_properties _nextProperties {};
+    // The tables as configured when starting to segment.
+    narrow_codepoint_properties::tables_view const* _tables =
+        &narrow_codepoint_properties::configured_tables();
+    grapheme_segmenter_state _state {};
+    value_type _cluster {};
 };
 
 // {{{ utf8_grapheme_segmenter implementation
@@ -118,17 +213,11 @@ inline char32_t utf8_grapheme_segmenter::iterator::consumeCodepoint() noexcept
     _nextCodepointStart = _nextUtf8;
     while (_nextUtf8 != _end)
     {
-        _result = from_utf8(_utf8_decoder_state, uint8_t(*_nextUtf8++));
-        if (std::holds_alternative<Success>(_result))
+        auto const decoded = decode_utf8(_utf8_decoder_state, uint8_t(*_nextUtf8++));
+        if (decoded != Utf8Incomplete)
         {
             auto const result = _nextCodepoint;
-            _nextCodepoint = std::get<Success>(_result).value;
-            return result;
-        }
-        if (std::holds_alternative<Invalid>(_result))
-        {
-            auto const result = _nextCodepoint;
-            _nextCodepoint = ReplacementChar;
+            _nextCodepoint = decoded == Utf8Invalid ? ReplacementChar : decoded;
             return result;
         }
     }
@@ -141,11 +230,13 @@ inline void utf8_grapheme_segmenter::iterator::consumeGraphemeCluster() noexcept
 {
     _clusterStart = _nextCodepointStart;
     _cluster.clear();
+    _clusterHash = {};
 
     bool nonbreakable = true;
     while (_nextCodepointStart != _end && nonbreakable)
     {
         _cluster.push_back(consumeCodepoint());
+        _clusterHash.append(_cluster.back());
         nonbreakable = unicode::grapheme_segmenter::nonbreakable(_cluster.back(), _nextCodepoint);
     }
 }
@@ -174,6 +265,123 @@ inline bool utf8_grapheme_segmenter::iterator::operator!=(iterator const& other)
 }
 // }}}
 
+// {{{ utf8_grapheme_cluster_segmenter implementation
+inline utf8_grapheme_cluster_segmenter::utf8_grapheme_cluster_segmenter(std::string_view text) noexcept:
+    _text { text }
+{
+}
+
+inline utf8_grapheme_cluster_segmenter::utf8_grapheme_cluster_segmenter(
+    std::string_view text, grapheme_cluster_cache* cache, statistics* stats) noexcept:
+    _text { text }, _cache { cache }, _stats { stats }
+{
+}
+
+inline utf8_grapheme_cluster_segmenter::iterator utf8_grapheme_cluster_segmenter::begin() const noexcept
+{
+    return iterator { _text.data(), _text.data() + _text.size(), _cache, _stats };
+}
+
+inline utf8_grapheme_cluster_segmenter::iterator utf8_grapheme_cluster_segmenter::end() const noexcept
+{
+    return iterator { _text.data() + _text.size(), _text.data() + _text.size() };
+}
+
+inline utf8_grapheme_cluster_segmenter::iterator::iterator(char const* data,
+                                                          char const* end,
+                                                          grapheme_cluster_cache* cache,
+                                                          statistics* stats) noexcept:
+    _next { data }, _end { end }, _cache { cache }, _stats { stats }
+{
+    decodeNextCodepoint();
+    consumeGraphemeCluster();
+}
+
+inline void utf8_grapheme_cluster_segmenter::iterator::decodeNextCodepoint() noexcept
+{
+    if (_next == _end)
+        return;
+
+    auto const sequence = decode_utf8_sequence(std::string_view(_next, static_cast<size_t>(_end - _next)));
+    _nextLength = sequence.length;
+    _nextInvalid = sequence.status != ConversionStatus::Success;
+    _nextCodepoint = sequence.status == ConversionStatus::Success ? sequence.value : char32_t { 0xFFFD };
+    _nextProperties = _tables->get(_nextCodepoint);
+    detail::count(_stats, &statistics::invalidSequences, _nextInvalid ? 1 : 0);
+    detail::count(_stats, &statistics::propertyLookups);
+}
+
+inline void utf8_grapheme_cluster_segmenter::iterator::consumeGraphemeCluster() noexcept
+{
+    auto const start = _next;
+    if (start == _end)
+    {
+        _cluster = { std::string_view(_end, 0), 0, 0, {} };
+        return;
+    }
+
+    _cluster.codepoint = _nextCodepoint;
+    _cluster.properties = _nextProperties;
+    _cluster.width = _nextProperties.char_width();
+    grapheme_process_init(_nextCodepoint, _nextProperties, _state);
+
+    // Grapheme clusters with ill-formed UTF-8 sequences are not cached,
+    // as scan_text() treats these as grapheme clusters of their own.
+    auto cacheable = _cache && !_nextInvalid;
+    auto codepointCount = size_t { 1 };
+    auto cachedSize = size_t { 0 };
+    auto clusterState = _state; // State after the last codepoint of the grapheme cluster.
+
+    _next += _nextLength;
+    decodeNextCodepoint();
+    while (_next != _end && !grapheme_process_breakable(_nextCodepoint, _nextProperties, _state))
+    {
+        clusterState = _state;
+        if (++codepointCount == 2 && cacheable)
+        {
+            auto const remaining = std::string_view(start, static_cast<size_t>(_end - start));
+            if (auto const* const cached = _cache->find(remaining))
+            {
+                // Skip the known part of the grapheme cluster.
+                _cluster.width = std::max(_cluster.width, size_t { cached->width });
+                _state = cached->state;
+                clusterState = _state;
+                cachedSize = cached->size;
+                _next = start + cached->size;
+                decodeNextCodepoint();
+                continue;
+            }
+        }
+        if (_nextCodepoint == 0xFE0F) // VS16
+            _cluster.width = 2;
+        cacheable = cacheable && !_nextInvalid;
+        _next += _nextLength;
+        decodeNextCodepoint();
+    }
+
+    _cluster.text = std::string_view(start, static_cast<size_t>(_next - start));
+    detail::count(_stats, &statistics::graphemeClusters);
+    detail::count(_stats, &statistics::complexBytes, _cluster.text.size());
+    if (cacheable && codepointCount > 1 && _cluster.text.size() > cachedSize)
+        _cache->insert(_cluster.text, _cluster.width, clusterState);
+}
+
+inline utf8_grapheme_cluster_segmenter::iterator&
+utf8_grapheme_cluster_segmenter::iterator::operator++() noexcept
+{
+    consumeGraphemeCluster();
+    return *this;
+}
+
+inline utf8_grapheme_cluster_segmenter::iterator utf8_grapheme_cluster_segmenter::iterator::operator++(
+    int) noexcept
+{
+    auto tmp(*this);
+    ++*this;
+    return tmp;
+}
+// }}}
+
 } // namespace unicode
 
 namespace std
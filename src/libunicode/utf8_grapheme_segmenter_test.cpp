@@ -18,6 +18,7 @@
 #include <catch2/catch.hpp>
 
 #include <string_view>
+#include <vector>
 
 using namespace std::string_literals;
 using namespace std::string_view_literals;
@@ -88,3 +89,53 @@ TEST_CASE("utf8_grapheme_segmenter.mixed")
     test_utf8_grapheme_cluster_segmentation(U"├"sv, U"─"sv, U" "sv, U"Y"sv, U"e"sv, U"s"sv);
     test_utf8_grapheme_cluster_segmentation(U"X"sv, U"\U0001F926\U0001F3FC\u200D\u2642\uFE0F"sv, U"5"sv);
 }
+
+TEST_CASE("utf8_grapheme_cluster_segmenter.empty")
+{
+    auto const segmenter = unicode::utf8_grapheme_cluster_segmenter(""sv);
+    CHECK(segmenter.begin() == segmenter.end());
+    CHECK(segmenter.begin()->text.empty());
+}
+
+TEST_CASE("utf8_grapheme_cluster_segmenter.mixed")
+{
+    // clang-format off
+    auto const text = "X"
+                      "\xF0\x9F\xA4\xA6\xF0\x9F\x8F\xBC\xE2\x80\x8D\xE2\x99\x82\xEF\xB8\x8F" // 🤦🏼‍♂️
+                      "\xE4\xB8\x80"                                                         // 一
+                      "e\xCC\x81"                                                            // é
+                      "\xE2\x9C\x8C\xEF\xB8\x8F"                                             // ✌️
+                      "\xFF"                                                                 // ill-formed
+                      "\r\n"
+                      "\xF0\x9F\x87\xA9\xF0\x9F\x87\xAA\xF0\x9F\x87\xA9"                     // 🇩🇪 + 🇩
+                      ""sv;
+    // clang-format on
+
+    auto clusters = std::vector<unicode::utf8_grapheme_cluster> {};
+    auto const segmenter = unicode::utf8_grapheme_cluster_segmenter(text);
+    for (auto const& cluster: segmenter)
+        clusters.push_back(cluster);
+
+    REQUIRE(clusters.size() == 9);
+    CHECK(clusters[0].text == "X");
+    CHECK(clusters[0].width == 1);
+    CHECK(clusters[1].text == text.substr(1, 17));
+    CHECK(clusters[1].codepoint == 0x1F926);
+    CHECK(clusters[1].width == 2);
+    CHECK(clusters[1].properties.extended_pictographic());
+    CHECK(clusters[2].text == "\xE4\xB8\x80");
+    CHECK(clusters[2].width == 2);
+    CHECK(clusters[3].text == "e\xCC\x81");
+    CHECK(clusters[3].width == 1);
+    CHECK(clusters[4].text == "\xE2\x9C\x8C\xEF\xB8\x8F");
+    CHECK(clusters[4].width == 2);
+    CHECK(clusters[5].text == "\xFF");
+    CHECK(clusters[5].codepoint == 0xFFFD);
+    CHECK(clusters[6].text == "\r\n");
+    CHECK(clusters[7].text == "\xF0\x9F\x87\xA9\xF0\x9F\x87\xAA");
+    CHECK(clusters[8].text == "\xF0\x9F\x87\xA9");
+
+    // Clusters refer into the given text.
+    CHECK(clusters.front().text.data() == text.data());
+    CHECK(clusters.back().text.data() + clusters.back().text.size() == text.data() + text.size());
+}
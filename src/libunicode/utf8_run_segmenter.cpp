@@ -0,0 +1,163 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/convert.h>
+#include <libunicode/utf8_run_segmenter.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using std::string_view;
+
+namespace unicode
+{
+
+namespace
+{
+    constexpr char32_t ReplacementCharacter = 0xFFFD; // NOLINT(readability-identifier-naming)
+    constexpr size_t MaxSequenceLength = 4;           // NOLINT(readability-identifier-naming)
+
+    char32_t decoded_value(utf8_sequence const& sequence) noexcept
+    {
+        return sequence.status == ConversionStatus::Success ? sequence.value : ReplacementCharacter;
+    }
+} // namespace
+
+void utf8_run_segmenter::feed(string_view chunk, range_handler const& onRange)
+{
+    auto const chunkOffset = _size;
+    _size += chunk.size();
+    size_t i = 0;
+
+    // Complete the UTF-8 sequence started at the end of the previous chunk, if any.
+    if (!_pendingBytes.empty())
+    {
+        auto const pendingLength = _pendingBytes.size();
+        auto const sequenceStart = chunkOffset - pendingLength;
+        _pendingBytes += chunk.substr(0, MaxSequenceLength - pendingLength);
+        auto const sequence = decode_utf8_sequence(_pendingBytes);
+        if (sequence.status == ConversionStatus::Incomplete && sequence.length == _pendingBytes.size())
+            return; // Still incomplete, as the chunk is tiny.
+
+        // The maximal subpart of an ill-formed sequence covers at least all of the pending bytes,
+        // as those are a prefix of a well-formed one.
+        append(decoded_value(sequence), sequenceStart);
+        i = sequence.length - pendingLength;
+        _pendingBytes.clear();
+    }
+
+    while (i < chunk.size())
+    {
+        if (static_cast<uint8_t>(chunk[i]) < 0x80)
+        {
+            append(static_cast<char32_t>(chunk[i]), chunkOffset + i);
+            ++i;
+            continue;
+        }
+
+        auto const sequence = decode_utf8_sequence(chunk.substr(i));
+        if (sequence.status == ConversionStatus::Incomplete && i + sequence.length == chunk.size())
+        {
+            _pendingBytes = chunk.substr(i);
+            break;
+        }
+
+        append(decoded_value(sequence), chunkOffset + i);
+        i += sequence.length;
+    }
+
+    // All but the last grapheme cluster are complete.
+    process(_clusterStart, onRange);
+}
+
+void utf8_run_segmenter::finish(range_handler const& onRange)
+{
+    if (!_pendingBytes.empty())
+        append(ReplacementCharacter, _size - _pendingBytes.size());
+
+    process(_codepoints.size(), onRange);
+
+    if (_started)
+    {
+        closeRun(_size);
+        flushRuns(_scriptSegmenter.currentScript(), onRange);
+    }
+
+    *this = utf8_run_segmenter {};
+}
+
+void utf8_run_segmenter::append(char32_t codepoint, size_t offset)
+{
+    if (grapheme_process_breakable(codepoint, _graphemeState))
+        _clusterStart = _codepoints.size();
+
+    _codepoints.push_back(codepoint);
+    _offsets.push_back(offset);
+}
+
+void utf8_run_segmenter::process(size_t count, range_handler const& onRange)
+{
+    if (count == 0)
+        return;
+
+    // No emoji sequence spans past a grapheme cluster boundary, so that segmenting the complete
+    // grapheme clusters on their own yields the same presentation styles as segmenting the whole text.
+    auto emojiSegmenter = emoji_segmenter { _codepoints.data(), count };
+    auto segmentEnd = size_t { 0 };
+    auto presentation = PresentationStyle::Text;
+    auto const scripts = script_properties::configured_tables();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        while (i == segmentEnd && emojiSegmenter.consume(out(segmentEnd), out(presentation)))
+            ;
+
+        auto const offset = _offsets[i];
+        auto const endedScript = _scriptSegmenter.push(scripts.get(_codepoints[i]));
+
+        if (!_started)
+        {
+            _started = true;
+            _runStart = offset;
+        }
+        else if (endedScript.has_value())
+        {
+            closeRun(offset);
+            flushRuns(*endedScript, onRange);
+        }
+        else if (presentation != _presentation)
+            closeRun(offset);
+
+        _presentation = presentation;
+    }
+
+    _codepoints.erase(0, count);
+    _offsets.erase(_offsets.begin(), _offsets.begin() + static_cast<std::ptrdiff_t>(count));
+    _clusterStart -= std::min(_clusterStart, count);
+}
+
+void utf8_run_segmenter::closeRun(size_t end)
+{
+    _pendingRuns.push_back(pending_run { _runStart, end, _presentation });
+    _runStart = end;
+}
+
+void utf8_run_segmenter::flushRuns(Script script, range_handler const& onRange)
+{
+    for (auto const& run: _pendingRuns)
+        onRange(range { run.start, run.end, { script, run.presentation } });
+    _pendingRuns.clear();
+}
+
+} // namespace unicode
@@ -0,0 +1,86 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/grapheme_segmenter.h>
+#include <libunicode/run_segmenter.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace unicode
+{
+
+/// Segments UTF-8 text that arrives in chunks into the same runs as run_segmenter,
+/// with the ranges referring to byte offsets into the whole text.
+///
+/// Only the codepoints of the grapheme cluster at the end of the text fed so far are kept,
+/// as no emoji sequence extends beyond a grapheme cluster. Runs are emitted as soon as their
+/// script is known, that is, when the script segment containing them ends.
+///
+/// Ill-formed UTF-8 sequences are segmented as U+FFFD REPLACEMENT CHARACTER.
+class utf8_run_segmenter
+{
+  public:
+    using range = run_segmenter::range;
+    using range_handler = std::function<void(range const&)>;
+
+    /// Segments the next @p chunk of UTF-8 text, invoking @p onRange for every run
+    /// that is known to be complete.
+    void feed(std::string_view chunk, range_handler const& onRange);
+
+    /// Segments the remainder of the text, invoking @p onRange for every run not emitted yet.
+    ///
+    /// The segmenter can be used for another text afterwards.
+    void finish(range_handler const& onRange);
+
+    /// @returns the number of bytes fed so far.
+    [[nodiscard]] size_t size() const noexcept { return _size; }
+
+  private:
+    void append(char32_t codepoint, size_t offset);
+    void process(size_t count, range_handler const& onRange);
+    void closeRun(size_t end);
+    void flushRuns(Script script, range_handler const& onRange);
+
+    // Bytes of an incomplete UTF-8 sequence at the end of the last chunk.
+    std::string _pendingBytes;
+    size_t _size = 0;
+
+    // Codepoints that have not been processed yet, along with their byte offsets.
+    // All but the ones of the last grapheme cluster are ready to be processed.
+    std::u32string _codepoints;
+    std::vector<size_t> _offsets;
+    size_t _clusterStart = 0; // index into _codepoints of the last grapheme cluster
+    grapheme_segmenter_state _graphemeState {};
+
+    script_segmenter _scriptSegmenter { std::u32string_view {} };
+    bool _started = false;
+    PresentationStyle _presentation = PresentationStyle::Text;
+
+    // Runs of the current script segment, whose script is not known yet.
+    struct pending_run
+    {
+        size_t start;
+        size_t end;
+        PresentationStyle presentation;
+    };
+    std::vector<pending_run> _pendingRuns;
+    size_t _runStart = 0;
+};
+
+} // namespace unicode
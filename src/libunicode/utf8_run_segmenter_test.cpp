@@ -0,0 +1,127 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/convert.h>
+#include <libunicode/utf8_run_segmenter.h>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::string_view_literals;
+using namespace unicode;
+
+namespace
+{
+
+using range = utf8_run_segmenter::range;
+
+// Segments the whole text with run_segmenter, translating codepoint offsets to byte offsets.
+std::vector<range> segment_whole(std::u32string_view text)
+{
+    auto byteOffsets = std::vector<size_t> { 0 };
+    for (auto const codepoint: text)
+        byteOffsets.push_back(byteOffsets.back() + utf8_length(std::u32string_view(&codepoint, 1)));
+
+    auto ranges = std::vector<range> {};
+    auto segmenter = run_segmenter { text };
+    auto current = run_segmenter::range {};
+    while (segmenter.consume(out(current)))
+        ranges.push_back(range { byteOffsets[current.start], byteOffsets[current.end], current.properties });
+    return ranges;
+}
+
+// Segments the text with utf8_run_segmenter, fed in chunks of at most chunkSize bytes,
+// starting with a chunk of firstChunkSize.
+std::vector<range> segment_chunked(std::string_view text, size_t firstChunkSize, size_t chunkSize)
+{
+    auto ranges = std::vector<range> {};
+    auto const collect = [&](range const& r) {
+        ranges.push_back(r);
+    };
+
+    auto segmenter = utf8_run_segmenter {};
+    segmenter.feed(text.substr(0, firstChunkSize), collect);
+    for (size_t i = firstChunkSize; i < text.size(); i += chunkSize)
+        segmenter.feed(text.substr(i, chunkSize), collect);
+    segmenter.finish(collect);
+    return ranges;
+}
+
+} // namespace
+
+TEST_CASE("utf8_run_segmenter.empty")
+{
+    CHECK(segment_chunked(""sv, 0, 1).empty());
+}
+
+TEST_CASE("utf8_run_segmenter.byte_offsets")
+{
+    auto const text = convert_to<char>(std::u32string_view(U"AB😀CD"));
+    CHECK(segment_chunked(text, text.size(), 1)
+          == std::vector<range> {
+              range { 0, 2, { Script::Latin, PresentationStyle::Text } },
+              range { 2, 6, { Script::Latin, PresentationStyle::Emoji } },
+              range { 6, 8, { Script::Latin, PresentationStyle::Text } },
+          });
+}
+
+TEST_CASE("utf8_run_segmenter.invalid")
+{
+    // Ill-formed sequences, incomplete one at the end.
+    auto const text = "ab\xE2\x82x\xF0\x9F"sv;
+    auto const expected = segment_whole(U"ab�x�");
+    REQUIRE(expected.size() == 1);
+    CHECK(expected[0].end == 9);
+    for (size_t split = 0; split <= text.size(); ++split)
+    {
+        INFO("split at " << split);
+        auto const actual = segment_chunked(text, split, text.size());
+        REQUIRE(actual.size() == 1);
+        CHECK(actual[0].end == text.size());
+        CHECK(actual[0].properties == expected[0].properties);
+    }
+}
+
+TEST_CASE("utf8_run_segmenter.same_as_run_segmenter")
+{
+    auto const texts = std::vector<std::u32string_view> {
+        U"\U0001F600︎",
+        U"A 😀",
+        U"AB😀CD",
+        U"نص키스의",
+        U"百家姓ऋषियों🌱🌲🌳🌴百家姓🌱🌲",
+        U"◌́◌̀◌̈◌̂◌̄◌̊",
+        U"いろはに.…¡ほへと",
+        U"👩‍👩‍👧‍👦👩‍❤️‍💋‍👨abcd👩‍👩\U0000200D‍efg",
+        U"⛹🏻✍🏻✊🏼",
+        U"աբգαβγԱԲԳ",
+        U"🏴󠁧󠁢󠁷󠁬󠁳󠁿🏴󠁧󠁢󠁳󠁣󠁴󠁿🇩🇪🇩🇪1️⃣x",
+    };
+
+    for (auto const text32: texts)
+    {
+        auto const text = convert_to<char>(text32);
+        auto const expected = segment_whole(text32);
+        INFO(text);
+
+        CHECK(segment_chunked(text, 0, 1) == expected);
+        for (size_t split = 0; split <= text.size(); ++split)
+        {
+            INFO("split at " << split);
+            CHECK(segment_chunked(text, split, text.size()) == expected);
+        }
+    }
+}
@@ -260,3 +260,72 @@ TEST_CASE("utf8.iter", "[utf8]")
     REQUIRE(holds_alternative<Success>(result));
     REQUIRE(get<Success>(result).value == U'\U0001F600');
 }
+
+namespace
+{
+
+std::u32string decode_all(std::string_view bytes)
+{
+    auto state = utf8_decoder_state {};
+    auto result = u32string {};
+    for (auto const byte: bytes)
+    {
+        auto const decoded = decode_utf8(state, static_cast<uint8_t>(byte));
+        if (decoded == Utf8Invalid)
+            result += U'\uFFFD';
+        else if (decoded != Utf8Incomplete)
+            result += decoded;
+    }
+    return result;
+}
+
+constexpr char32_t decode_constexpr(uint8_t a, uint8_t b)
+{
+    auto state = utf8_decoder_state {};
+    [[maybe_unused]] auto const first = decode_utf8(state, a);
+    return decode_utf8(state, b);
+}
+
+} // namespace
+
+TEST_CASE("utf8.decode_utf8", "[utf8]")
+{
+    static_assert(decode_constexpr(0xC3, 0xB6) == U'\u00F6');
+    static_assert(decode_constexpr(0xE2, 0x82) == Utf8Incomplete);
+    static_assert(decode_constexpr(0xC3, 0xC3) == Utf8Invalid);
+
+    CHECK(decode_all("[\xC3\xB6\xE2\x82\xAC\xF0\x9F\x98\x80") == U"[\u00F6\u20AC\U0001F600");
+
+    // Bytes that cannot start a sequence.
+    CHECK(decode_all("a\x80" "b\xF8" "c\xFF") == U"a\uFFFD" "b\uFFFD" "c\uFFFD");
+
+    // A lead byte cuts short the pending sequence, and starts the next one.
+    CHECK(decode_all("\xE2\x82\xC3\xB6") == U"\uFFFD\u00F6");
+    CHECK(decode_all("\xF0\x9F\xF0\x9F\x98\x80") == U"\uFFFD\U0001F600");
+
+    // Same results as from_utf8() and from_utf8i().
+    for (unsigned lead = 0; lead <= 0xFF; ++lead)
+    {
+        for (unsigned next = 0; next <= 0xFF; ++next)
+        {
+            INFO(fmt::format("bytes: {:02X} {:02X}", lead, next));
+            auto a = utf8_decoder_state {};
+            auto b = utf8_decoder_state {};
+            for (auto const byte: { lead, next })
+            {
+                auto const decoded = decode_utf8(a, static_cast<uint8_t>(byte));
+                auto const legacy = from_utf8(b, static_cast<uint8_t>(byte));
+                if (decoded == Utf8Incomplete)
+                    REQUIRE(holds_alternative<Incomplete>(legacy));
+                else if (decoded == Utf8Invalid)
+                    REQUIRE(holds_alternative<Invalid>(legacy));
+                else
+                    REQUIRE(get<Success>(legacy).value == decoded);
+            }
+            auto c = utf8_decoder_state {};
+            from_utf8i(c, static_cast<uint8_t>(lead));
+            REQUIRE(from_utf8i(c, static_cast<uint8_t>(next))
+                    == decode_constexpr(static_cast<uint8_t>(lead), static_cast<uint8_t>(next)));
+        }
+    }
+}
@@ -13,10 +13,18 @@
  */
 #pragma once
 
+#include <libunicode/codepoint_properties.h>
+
 namespace unicode
 {
 
 /// Returns the number of text columns the given codepoint would need to be displayed.
-int width(char32_t codepoint) noexcept;
+///
+/// Defined inline, such that per codepoint loops only load from the tables in libunicode,
+/// rather than calling into it.
+inline int width(char32_t codepoint) noexcept
+{
+    return narrow_codepoint_properties::get(codepoint).char_width();
+}
 
 } // namespace unicode
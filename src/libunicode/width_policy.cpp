@@ -0,0 +1,163 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/multistage_table_generator.h>
+#include <libunicode/width_policy.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace unicode
+{
+
+namespace
+{
+    using tables_view = narrow_codepoint_properties::tables_view;
+
+    constexpr char32_t MaxCodepoint = 0x10FFFF;                 // NOLINT(readability-identifier-naming)
+    constexpr size_t BlockSize = tables_view::block_size;       // NOLINT(readability-identifier-naming)
+    constexpr size_t Stage1Size = (MaxCodepoint + 1) / BlockSize; // NOLINT(readability-identifier-naming)
+
+    narrow_codepoint_properties with_width(narrow_codepoint_properties properties, unsigned width) noexcept
+    {
+        auto const others = static_cast<uint8_t>(properties.value & ~narrow_codepoint_properties::WidthMask);
+        return { static_cast<uint8_t>(others | width) };
+    }
+
+    narrow_codepoint_properties adjusted(narrow_codepoint_properties properties,
+                                         codepoint_properties const& full,
+                                         ambiguous_width ambiguous) noexcept
+    {
+        // Ambiguous codepoints that are zero-width (e.g. combining marks) stay so in East Asian contexts.
+        if (ambiguous == ambiguous_width::Wide && full.east_asian_width == East_Asian_Width::Ambiguous
+            && properties.char_width() == 1)
+            return with_width(properties, 2);
+        return properties;
+    }
+
+    /// Finds or adds the index of each value of the values table.
+    class value_indices
+    {
+      public:
+        explicit value_indices(std::vector<narrow_codepoint_properties>& values): _values { values }
+        {
+            _indices.fill(Unused);
+            for (size_t i = _values.size(); i > 0; --i)
+                _indices[_values[i - 1].value] = static_cast<uint16_t>(i - 1);
+        }
+
+        uint16_t operator()(narrow_codepoint_properties value)
+        {
+            auto& index = _indices[value.value];
+            if (index == Unused)
+            {
+                index = static_cast<uint16_t>(_values.size());
+                _values.push_back(value);
+            }
+            return index;
+        }
+
+      private:
+        // NOLINTNEXTLINE(readability-identifier-naming)
+        static constexpr uint16_t Unused = std::numeric_limits<uint16_t>::max();
+
+        std::vector<narrow_codepoint_properties>& _values;
+        std::array<uint16_t, 256> _indices {};
+    };
+} // namespace
+
+width_policy::width_policy(): width_policy(ambiguous_width::Narrow)
+{
+}
+
+width_policy::width_policy(ambiguous_width ambiguous, std::span<width_override const> overrides):
+    _ambiguous { ambiguous }, _tables { narrow_codepoint_properties::configured_tables() }
+{
+    for (auto const& entry: overrides)
+        if (entry.first > entry.last || entry.last > MaxCodepoint
+            || entry.width > narrow_codepoint_properties::WidthMask)
+            throw std::invalid_argument("Invalid codepoint width override.");
+
+    // The sizes of the tables follow from the indices into them.
+    auto const& full = codepoint_properties::configured_tables();
+    auto const stage2Size = (*std::max_element(_tables.stage1, _tables.stage1 + Stage1Size) + 1u) * BlockSize;
+    auto const valueCount = *std::max_element(_tables.stage2, _tables.stage2 + stage2Size) + 1u;
+
+    _values.resize(valueCount);
+    for (size_t i = 0; i < valueCount; ++i)
+        _values[i] = adjusted(_tables.stage3[i], full.stage3[i], ambiguous);
+    _direct.resize(tables_view::direct_size);
+    for (size_t i = 0; i < tables_view::direct_size; ++i)
+        _direct[i] = adjusted(_tables.direct[i], full.direct[i], ambiguous);
+
+    // Overridden codepoints of the direct table are adjusted in place, and those of the stages get own
+    // stage 2 blocks, holding the indices of own values, deduplicated as the blocks are likely alike.
+    auto indices = value_indices { _values };
+    auto blocks = std::map<size_t, std::vector<uint16_t>> {};
+    for (auto const& entry: overrides)
+    {
+        for (auto codepoint = std::max(entry.first, char32_t { 0x80 }); codepoint <= entry.last;)
+        {
+            if (codepoint < tables_view::direct_size)
+            {
+                _direct[codepoint] = with_width(_direct[codepoint], entry.width);
+                ++codepoint;
+                continue;
+            }
+
+            auto const blockNumber = codepoint / BlockSize;
+            auto& block = blocks[blockNumber];
+            if (block.empty())
+            {
+                auto const* const source = _tables.stage2 + _tables.stage1[blockNumber] * BlockSize;
+                block.assign(source, source + BlockSize);
+            }
+            auto const blockEnd =
+                std::min(entry.last, static_cast<char32_t>((blockNumber + 1) * BlockSize - 1));
+            for (; codepoint <= blockEnd; ++codepoint)
+            {
+                auto& index = block[codepoint % BlockSize];
+                index = indices(with_width(_values[index], entry.width));
+            }
+            if (blockEnd == MaxCodepoint)
+                break;
+        }
+    }
+
+    if (!blocks.empty())
+    {
+        _stage1.assign(_tables.stage1, _tables.stage1 + Stage1Size);
+        _stage2.assign(_tables.stage2, _tables.stage2 + stage2Size);
+        auto created =
+            std::unordered_map<std::vector<uint16_t>, uint16_t, support::detail::block_hash<uint16_t>> {};
+        for (auto const& [blockNumber, block]: blocks)
+        {
+            auto const next = static_cast<uint16_t>(_stage2.size() / BlockSize);
+            auto const [i, inserted] = created.try_emplace(block, next);
+            if (inserted)
+                _stage2.insert(_stage2.end(), block.begin(), block.end());
+            _stage1[blockNumber] = i->second;
+        }
+        _tables.stage1 = _stage1.data();
+        _tables.stage2 = _stage2.data();
+    }
+
+    _tables.stage3 = _values.data();
+    _tables.direct = _direct.data();
+}
+
+} // namespace unicode
@@ -0,0 +1,96 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <libunicode/codepoint_properties.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace unicode
+{
+
+/// Width of the codepoints of East_Asian_Width Ambiguous, as per UAX #11.
+enum class ambiguous_width : uint8_t
+{
+    /// One column, as in non East Asian contexts (the default).
+    Narrow,
+    /// Two columns, as in East Asian contexts (e.g. for CJK fonts and locales).
+    Wide,
+};
+
+/// Width of a range of codepoints, overriding the width of the codepoint properties.
+struct width_override
+{
+    char32_t first;
+    char32_t last; // inclusive
+    uint8_t width;
+};
+
+/// Policy of the widths of codepoints, e.g. for the font and locale a terminal renders text with.
+///
+/// The widths are compiled into an own set of narrow_codepoint_properties tables, such that the
+/// policy-adjusted width is still a single table lookup, along with the other narrow properties.
+/// Their values are a copy of the configured ones, adjusted to the ambiguous width,
+/// and only the stage 2 blocks of overridden codepoints are copied and adjusted.
+/// Everything else is shared with the currently configured tables, which must thus outlive the policy.
+///
+/// US-ASCII characters are always one column wide, so overrides of these are ignored.
+class width_policy
+{
+  public:
+    /// Constructs the policy of the configured codepoint properties, i.e. of width().
+    width_policy();
+
+    /// Constructs a policy of the given ambiguous width, and overrides applied in order,
+    /// i.e. later overrides take precedence over earlier ones.
+    ///
+    /// @throws std::invalid_argument if an override is not a range of codepoints of at most 3 columns.
+    explicit width_policy(ambiguous_width ambiguous, std::span<width_override const> overrides = {});
+
+    width_policy(width_policy const&) = delete;
+    width_policy& operator=(width_policy const&) = delete;
+    width_policy(width_policy&&) noexcept = default;
+    width_policy& operator=(width_policy&&) noexcept = default;
+    ~width_policy() = default;
+
+    [[nodiscard]] ambiguous_width ambiguous() const noexcept { return _ambiguous; }
+
+    /// The narrow_codepoint_properties tables with the policy-adjusted widths.
+    [[nodiscard]] narrow_codepoint_properties::tables_view const& tables() const noexcept { return _tables; }
+
+    /// Retrieves the narrow codepoint properties for the given codepoint, with its policy-adjusted width.
+    [[nodiscard]] narrow_codepoint_properties get(char32_t codepoint) const noexcept
+    {
+        return _tables.get(codepoint);
+    }
+
+    /// Returns the number of text columns the given codepoint would need to be displayed.
+    [[nodiscard]] int width(char32_t codepoint) const noexcept { return get(codepoint).char_width(); }
+
+  private:
+    ambiguous_width _ambiguous = ambiguous_width::Narrow;
+
+    // Stage 1 and 2 only hold anything if there are overrides, and are shared otherwise.
+    std::vector<uint16_t> _stage1;
+    std::vector<uint16_t> _stage2;
+    std::vector<narrow_codepoint_properties> _values;
+    std::vector<narrow_codepoint_properties> _direct;
+
+    narrow_codepoint_properties::tables_view _tables;
+};
+
+} // namespace unicode
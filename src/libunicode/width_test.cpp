@@ -11,10 +11,17 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <libunicode/codepoint_properties.h>
 #include <libunicode/width.h>
+#include <libunicode/width_policy.h>
+
+#include <fmt/format.h>
 
 #include <catch2/catch.hpp>
 
+#include <array>
+#include <stdexcept>
+
 TEST_CASE("random test", "[width]")
 {
     // C0
@@ -34,3 +41,90 @@ TEST_CASE("random test", "[width]")
     CHECK(unicode::width(U'\U0001F60A') == 2); // 😊 :blush:
     CHECK(unicode::width(U'\U0001F480') == 2); // 💀 :skull:
 }
+
+TEST_CASE("width_policy.default", "[width]")
+{
+    auto const policy = unicode::width_policy {};
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+        if (policy.get(codepoint).value != unicode::narrow_codepoint_properties::get(codepoint).value)
+            FAIL(fmt::format("U+{:04X} differs", static_cast<uint32_t>(codepoint)));
+}
+
+TEST_CASE("width_policy.ambiguous", "[width]")
+{
+    auto const policy = unicode::width_policy { unicode::ambiguous_width::Wide };
+    CHECK(policy.ambiguous() == unicode::ambiguous_width::Wide);
+
+    CHECK(policy.width(U'\u00A1') == 2); // INVERTED EXCLAMATION MARK
+    CHECK(policy.width(U'\u2026') == 2); // HORIZONTAL ELLIPSIS
+    CHECK(policy.width(U'\u0391') == 2); // GREEK CAPITAL LETTER ALPHA
+    CHECK(policy.width(U'\u0300') == 0); // COMBINING GRAVE ACCENT stays zero-width
+    CHECK(policy.width(U'\uFE0F') == 0); // VARIATION SELECTOR-16 stays zero-width
+    CHECK(policy.width(U'A') == 1);
+    CHECK(policy.width(U'\u4E00') == 2);
+
+    for (char32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+    {
+        auto const properties = unicode::codepoint_properties::get(codepoint);
+        auto const expected = properties.east_asian_width == unicode::East_Asian_Width::Ambiguous
+                                      && properties.char_width == 1
+                                  ? 2
+                                  : unicode::width(codepoint);
+        auto const value = static_cast<uint32_t>(codepoint);
+        if (policy.width(codepoint) != expected)
+            FAIL(fmt::format("U+{:04X} has width {}", value, policy.width(codepoint)));
+        if (policy.get(codepoint).grapheme_cluster_break()
+            != unicode::narrow_codepoint_properties::get(codepoint).grapheme_cluster_break())
+            FAIL(fmt::format("U+{:04X} changed its Grapheme_Cluster_Break", value));
+    }
+}
+
+TEST_CASE("width_policy.overrides", "[width]")
+{
+    auto const overrides = std::array {
+        unicode::width_override { 0xE000, 0xF8FF, 2 },     // Private Use Area
+        unicode::width_override { 0xE010, 0xE010, 1 },     // takes precedence over the above
+        unicode::width_override { 0x00B0, 0x00B1, 2 },     // within the direct table
+        unicode::width_override { 0x0041, 0x0042, 2 },     // US-ASCII, ignored
+        unicode::width_override { 0x10FFF0, 0x10FFFF, 0 }, // up to the last codepoint
+        unicode::width_override { 0x1F600, 0x1F600, 1 },   // emoji
+    };
+    auto const policy = unicode::width_policy { unicode::ambiguous_width::Narrow, overrides };
+
+    CHECK(policy.width(0xE000) == 2);
+    CHECK(policy.width(0xE00F) == 2);
+    CHECK(policy.width(0xE010) == 1);
+    CHECK(policy.width(0xF8FF) == 2);
+    CHECK(policy.width(0xF900) == unicode::width(0xF900));
+    CHECK(policy.width(0xDFFF) == unicode::width(0xDFFF));
+    CHECK(policy.width(0x00AF) == 1);
+    CHECK(policy.width(0x00B0) == 2);
+    CHECK(policy.width(0x00B1) == 2);
+    CHECK(policy.width(0x00B2) == 1);
+    CHECK(policy.width(U'A') == 1);
+    CHECK(policy.width(0x10FFEF) == unicode::width(0x10FFEF));
+    CHECK(policy.width(0x10FFFF) == 0);
+    CHECK(policy.width(0x1F600) == 1);
+    CHECK(policy.width(0x1F601) == 2);
+    CHECK(policy.width(U'\u00A1') == 1);
+
+    // Overrides only change the width.
+    for (auto const codepoint: { 0xB0u, 0xE000u, 0xE010u, 0x1F600u, 0x10FFFFu })
+        CHECK((policy.get(codepoint).value & ~unicode::narrow_codepoint_properties::WidthMask)
+              == (unicode::narrow_codepoint_properties::get(codepoint).value
+                  & ~unicode::narrow_codepoint_properties::WidthMask));
+    CHECK(policy.get(0x1F600).extended_pictographic());
+
+    // Moving retains the tables.
+    auto const moved =
+        unicode::width_policy { unicode::width_policy { unicode::ambiguous_width::Wide, overrides } };
+    CHECK(moved.width(0xE010) == 1);
+    CHECK(moved.width(U'\u00A1') == 2);
+
+    auto const invalid = std::array { unicode::width_override { 0xE000, 0xDFFF, 2 } };
+    CHECK_THROWS_AS(unicode::width_policy(unicode::ambiguous_width::Narrow, invalid), std::invalid_argument);
+    auto const tooWide = std::array { unicode::width_override { 0xE000, 0xE000, 4 } };
+    CHECK_THROWS_AS(unicode::width_policy(unicode::ambiguous_width::Narrow, tooWide), std::invalid_argument);
+    auto const beyond = std::array { unicode::width_override { 0x10FFFF, 0x110000, 1 } };
+    CHECK_THROWS_AS(unicode::width_policy(unicode::ambiguous_width::Narrow, beyond), std::invalid_argument);
+}
@@ -0,0 +1,294 @@
+/**
+ * This file is part of the "libunicode" project
+ *   Copyright (c) 2023 Christian Parpart <christian@parpart.family>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <libunicode/codepoint_properties.h>
+#include <libunicode/convert.h>
+#include <libunicode/word_segmenter.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace unicode
+{
+
+namespace
+{
+    // States of the word boundary DFA, that is, what the rules of UAX #29 need to know
+    // about the text since the start of the current word.
+    enum class State : uint8_t
+    {
+        Start,        // at the start of the text
+        CR,           // after CR (WB3)
+        Newline,      // after LF, Newline or CR LF (WB3a)
+        Other,        // after anything no further rule looks at
+        WSegSpace,    // directly after WSegSpace (WB3d)
+        ALetter,      // after ALetter (Extend | Format | ZWJ)*
+        Hebrew,       // after Hebrew_Letter (Extend | Format | ZWJ)*
+        Numeric,      // after Numeric (Extend | Format | ZWJ)*
+        Katakana,     // after Katakana (Extend | Format | ZWJ)*
+        ExtendNumLet, // after ExtendNumLet (Extend | Format | ZWJ)*
+        RIOdd,        // after an odd number of Regional_Indicator (WB15, WB16)
+        HebrewSQ,     // after Hebrew_Letter Single_Quote (WB7a)
+
+        // Pending states, that is, whether there is a word boundary before their last
+        // MidLetter, MidNum, MidNumLet, Single_Quote or Double_Quote depends on what follows.
+        LetterMid,  // after AHLetter (MidLetter | MidNumLetQ), pending WB6 and WB7
+        HebrewDQ,   // after Hebrew_Letter Double_Quote, pending WB7b and WB7c
+        NumericMid, // after Numeric (MidNum | MidNumLetQ), pending WB11 and WB12
+    };
+
+    constexpr size_t StateCount = static_cast<size_t>(State::NumericMid) + 1;
+
+    // Set in states whose last codepoint is a ZWJ (WB3c).
+    constexpr uint8_t ZwjFlag = 0x10;            // NOLINT(readability-identifier-naming)
+    constexpr size_t ContextCount = ZwjFlag * 2; // NOLINT(readability-identifier-naming)
+
+    static_assert(StateCount <= ZwjFlag);
+
+    // Actions upon processing the next codepoint.
+    enum class Action : uint8_t
+    {
+        NoBreak,   // continue the word
+        Break,     // the word ends before the next codepoint
+        Tentative, // continue the word, but end it before the next codepoint if rejected later on
+        Reject,    // the word ends before the codepoint that entered the pending state
+    };
+
+    // Number of Word_Break values plus one bit for Extended_Pictographic.
+    constexpr size_t ExtendedPictographicShift = 5;               // NOLINT(readability-identifier-naming)
+    constexpr size_t ClassCount = 2 << ExtendedPictographicShift; // NOLINT(readability-identifier-naming)
+
+    static_assert(static_cast<size_t>(Word_Break::ZWJ) < (1 << ExtendedPictographicShift));
+
+    constexpr size_t class_of(break_properties properties) noexcept
+    {
+        return static_cast<size_t>(properties.word_break)
+               | (size_t { properties.extended_pictographic() } << ExtendedPictographicShift);
+    }
+
+    constexpr bool is_one_of(Word_Break value, std::initializer_list<Word_Break> set)
+    {
+        return std::find(set.begin(), set.end(), value) != set.end();
+    }
+
+    constexpr bool is_ahletter(Word_Break value)
+    {
+        return value == Word_Break::ALetter || value == Word_Break::Hebrew_Letter;
+    }
+
+    /// Returns the state a word starting with @p B is in.
+    constexpr State initial_state(Word_Break B)
+    {
+        using WB = Word_Break;
+
+        switch (B)
+        {
+            case WB::CR: return State::CR;
+            case WB::LF:
+            case WB::Newline: return State::Newline;
+            case WB::WSegSpace: return State::WSegSpace;
+            case WB::ALetter: return State::ALetter;
+            case WB::Hebrew_Letter: return State::Hebrew;
+            case WB::Numeric: return State::Numeric;
+            case WB::Katakana: return State::Katakana;
+            case WB::ExtendNumLet: return State::ExtendNumLet;
+            case WB::Regional_Indicator: return State::RIOdd;
+            default: return State::Other;
+        }
+    }
+
+    struct transition
+    {
+        Action action;
+        State next = State::Other;
+    };
+
+    /// Implements the rules WB3 to WB999 for the state @p A before and the Word_Break
+    /// value @p B and Extended_Pictographic property @p pictographicB after a potential word boundary.
+    constexpr transition make_transition(State A, bool zwj, Word_Break B, bool pictographicB)
+    {
+        using WB = Word_Break;
+
+        // Do not break within an empty word.
+        if (A == State::Start)
+            return { Action::NoBreak, initial_state(B) };
+
+        // WB3: Do not break between a CR and LF.
+        if (A == State::CR && B == WB::LF)
+            return { Action::NoBreak, State::Newline };
+
+        // WB3a: Otherwise break after Newlines.
+        if (A == State::CR || A == State::Newline)
+            return { Action::Break };
+
+        // Resolve pending states: WB7, WB7c and WB11 either apply after the next non-ignored codepoint,
+        // or the word ends before the codepoint that entered the pending state.
+        if (A == State::LetterMid || A == State::HebrewDQ || A == State::NumericMid)
+        {
+            if ((A == State::LetterMid && is_ahletter(B)) || (A == State::HebrewDQ && B == WB::Hebrew_Letter)
+                || (A == State::NumericMid && B == WB::Numeric))
+                return { Action::NoBreak, initial_state(B) };
+            if (is_one_of(B, { WB::Extend, WB::Format, WB::ZWJ }))
+                return { Action::NoBreak, A };
+            return { Action::Reject };
+        }
+
+        // WB3b: Break before Newlines.
+        if (is_one_of(B, { WB::CR, WB::LF, WB::Newline }))
+            return { Action::Break };
+
+        // WB3c: Do not break within emoji zwj sequences.
+        if (zwj && pictographicB)
+            return { Action::NoBreak, initial_state(B) };
+
+        // WB3d: Keep horizontal whitespace together.
+        if (A == State::WSegSpace && B == WB::WSegSpace)
+            return { Action::NoBreak, State::WSegSpace };
+
+        // WB4: Ignore Format and Extend characters, except after sot, CR, LF, and Newline.
+        if (is_one_of(B, { WB::Extend, WB::Format, WB::ZWJ }))
+            return { Action::NoBreak, A == State::WSegSpace ? State::Other : A };
+
+        auto const ahletterA = A == State::ALetter || A == State::Hebrew;
+
+        // WB5, WB8, WB9, WB10: Do not break within sequences of letters and digits.
+        if ((ahletterA || A == State::Numeric) && (is_ahletter(B) || B == WB::Numeric))
+            return { Action::NoBreak, initial_state(B) };
+
+        // WB7a: Do not break between a Hebrew letter and a single quote.
+        if (A == State::Hebrew && B == WB::Single_Quote)
+            return { Action::NoBreak, State::HebrewSQ };
+
+        // WB6: Do not break letters across certain punctuation, if followed by a letter (WB7).
+        if (ahletterA && is_one_of(B, { WB::MidLetter, WB::MidNumLet, WB::Single_Quote }))
+            return { Action::Tentative, State::LetterMid };
+
+        // WB7b: Do not break between a Hebrew letter and a double quote, if followed by one (WB7c).
+        if (A == State::Hebrew && B == WB::Double_Quote)
+            return { Action::Tentative, State::HebrewDQ };
+
+        // WB7: Do not break after a Hebrew letter and a single quote, if followed by a letter.
+        if (A == State::HebrewSQ && is_ahletter(B))
+            return { Action::NoBreak, initial_state(B) };
+
+        // WB12: Do not break numbers across certain punctuation, if followed by a digit (WB11).
+        if (A == State::Numeric && is_one_of(B, { WB::MidNum, WB::MidNumLet, WB::Single_Quote }))
+            return { Action::Tentative, State::NumericMid };
+
+        // WB13: Do not break between Katakana.
+        if (A == State::Katakana && B == WB::Katakana)
+            return { Action::NoBreak, State::Katakana };
+
+        // WB13a: Do not break from extenders.
+        if ((ahletterA || A == State::Numeric || A == State::Katakana || A == State::ExtendNumLet)
+            && B == WB::ExtendNumLet)
+            return { Action::NoBreak, State::ExtendNumLet };
+
+        // WB13b: Do not break to extenders.
+        if (A == State::ExtendNumLet && (is_ahletter(B) || B == WB::Numeric || B == WB::Katakana))
+            return { Action::NoBreak, initial_state(B) };
+
+        // WB15, WB16: Do not break within emoji flag sequences, i.e. between pairs of regional indicators.
+        if (A == State::RIOdd && B == WB::Regional_Indicator)
+            return { Action::NoBreak, State::Other };
+
+        // WB999: Otherwise, break everywhere.
+        return { Action::Break };
+    }
+
+    /// Each transition holds the next context (upper bits) and the action (lower two bits).
+    using transition_table = std::array<std::array<uint8_t, ClassCount>, ContextCount>;
+
+    /// Transitions by context, that is, the state and whether its last codepoint is a ZWJ,
+    /// and by the Word_Break and Extended_Pictographic properties of the next codepoint.
+    constexpr transition_table make_transition_table()
+    {
+        auto table = transition_table {};
+        for (size_t context = 0; context < ContextCount; ++context)
+        {
+            for (size_t b = 0; b < ClassCount; ++b)
+            {
+                auto const B = static_cast<Word_Break>(b & ((1 << ExtendedPictographicShift) - 1));
+                auto const state = static_cast<State>(context & (ZwjFlag - 1));
+                if (state >= static_cast<State>(StateCount) || B > Word_Break::ZWJ)
+                {
+                    table[context][b] = static_cast<uint8_t>(Action::Break);
+                    continue;
+                }
+                auto const t = make_transition(state, context & ZwjFlag, B, b >> ExtendedPictographicShift);
+                auto const next = static_cast<uint8_t>(t.next) | (B == Word_Break::ZWJ ? ZwjFlag : 0);
+                table[context][b] = static_cast<uint8_t>((next << 2) | static_cast<uint8_t>(t.action));
+            }
+        }
+        return table;
+    }
+
+    constexpr transition_table Transitions = make_transition_table(); // NOLINT(readability-identifier-naming)
+
+    constexpr bool is_pending(uint8_t context) noexcept
+    {
+        return (context & (ZwjFlag - 1)) >= static_cast<uint8_t>(State::LetterMid);
+    }
+
+    /// Runs the DFA over the codepoints @p decode yields as (codepoint, length in code units),
+    /// until the first word boundary after the start of the text of @p size code units.
+    template <typename Decoder>
+    size_t run(size_t size, Decoder decode) noexcept
+    {
+        auto context = uint8_t { 0 };
+        auto pending = size_t { 0 };
+        auto offset = size_t { 0 };
+        auto const tables = break_properties::configured_tables();
+        while (offset < size)
+        {
+            auto const [codepoint, length] = decode(offset);
+            auto const transition = Transitions[context][class_of(tables.get(codepoint))];
+            switch (static_cast<Action>(transition & 3))
+            {
+                case Action::NoBreak: break;
+                case Action::Break: return offset;
+                case Action::Tentative: pending = offset; break;
+                case Action::Reject: return pending;
+            }
+            context = static_cast<uint8_t>(transition >> 2);
+            offset += length;
+        }
+        return is_pending(context) ? pending : size;
+    }
+
+    struct decoded
+    {
+        char32_t codepoint;
+        size_t length;
+    };
+} // namespace
+
+size_t next_word_boundary(std::u32string_view text) noexcept
+{
+    return run(text.size(), [text](size_t offset) noexcept { return decoded { text[offset], 1 }; });
+}
+
+size_t next_word_boundary(std::string_view text) noexcept
+{
+    return run(text.size(), [text](size_t offset) noexcept {
+        auto const sequence = decode_utf8_sequence(text.substr(offset));
+        if (sequence.status != ConversionStatus::Success)
+            return decoded { 0xFFFD, sequence.length };
+        return decoded { sequence.value, sequence.length };
+    });
+}
+
+} // namespace unicode
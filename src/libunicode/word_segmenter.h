@@ -13,11 +13,26 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <string_view>
 
 namespace unicode
 {
 
+/// Returns the offset of the first word boundary in @p text after its start, as per the
+/// word boundary rules of UAX #29, i.e. the length of the word at the start of @p text.
+///
+/// @returns 0 if @p text is empty.
+[[nodiscard]] size_t next_word_boundary(std::u32string_view text) noexcept;
+
+/// Same as next_word_boundary(std::u32string_view) but for UTF-8 text, returning the offset in bytes.
+///
+/// Ill-formed UTF-8 sequences are segmented as U+FFFD REPLACEMENT CHARACTER.
+[[nodiscard]] size_t next_word_boundary(std::string_view text) noexcept;
+
+/// Segments UTF-32 text into words, as per the word boundary rules of UAX #29.
+///
+/// Words include the ones made of spaces or punctuation, i.e. concatenating all of them yields the text.
 class word_segmenter
 {
   public:
@@ -25,41 +40,21 @@ class word_segmenter
     using iterator = char_type const*;
     using view_type = std::basic_string_view<char_type>;
 
-    constexpr word_segmenter(std::basic_string_view<char_type> const& str):
+    word_segmenter(std::basic_string_view<char_type> const& str) noexcept:
         word_segmenter(str.data(), str.data() + str.size())
     {
     }
 
-    constexpr word_segmenter(): word_segmenter({}, {}) {}
+    word_segmenter() noexcept: word_segmenter({}, {}) {}
 
-    constexpr bool empty() const noexcept { return size() == 0; }
-    constexpr std::size_t size() const noexcept { return static_cast<size_t>(_right - _left); }
-    constexpr view_type operator*() const noexcept { return view_type(_left, size()); }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return static_cast<size_t>(_right - _left); }
+    [[nodiscard]] constexpr view_type operator*() const noexcept { return view_type(_left, size()); }
 
-    constexpr word_segmenter& operator++() noexcept
+    word_segmenter& operator++() noexcept
     {
         _left = _right;
-        while (_right != _end)
-        {
-            switch (_state)
-            {
-                case State::NoWord:
-                    if (!isDelimiter(*_right))
-                    {
-                        _state = State::Word;
-                        return *this;
-                    }
-                    break;
-                case State::Word:
-                    if (isDelimiter(*_right))
-                    {
-                        _state = State::NoWord;
-                        return *this;
-                    }
-                    break;
-            }
-            ++_right;
-        }
+        _right += next_word_boundary(view_type(_left, static_cast<size_t>(_end - _left)));
         return *this;
     }
 
@@ -71,39 +66,74 @@ class word_segmenter
     constexpr bool operator!=(word_segmenter const& rhs) const noexcept { return !(*this == rhs); }
 
   private:
-    constexpr word_segmenter(iterator begin, iterator end):
-        _left { begin },
-        _right { begin },
-        _state { begin != end ? (isDelimiter(*_right) ? State::NoWord : State::Word) : State::NoWord },
-        _end { end }
+    word_segmenter(iterator begin, iterator end) noexcept: _left { begin }, _right { begin }, _end { end }
     {
         ++*this;
     }
 
-    constexpr bool isDelimiter(char_type character) const noexcept
+    iterator _left;
+    iterator _right;
+    iterator _end;
+};
+
+/// Segments UTF-8 text into words, as per the word boundary rules of UAX #29, without copying,
+/// i.e. yielding views into the given text.
+struct utf8_word_segmenter
+{
+    class iterator;
+
+    explicit utf8_word_segmenter(std::string_view text) noexcept: _text { text } {}
+
+    [[nodiscard]] iterator begin() const noexcept;
+    [[nodiscard]] iterator end() const noexcept;
+
+  private:
+    std::string_view _text;
+};
+
+class utf8_word_segmenter::iterator
+{
+  public:
+    using value_type = std::string_view;
+
+    iterator(char const* data, char const* end) noexcept: _end { end }
     {
-        switch (character)
-        {
-            case ' ':
-            case '\r':
-            case '\n':
-            case '\t': return true;
-            default: return false;
-        }
+        _word = value_type(data, next_word_boundary(value_type(data, static_cast<size_t>(end - data))));
     }
 
-    // private fields
-    //
-    enum class State
+    value_type const& operator*() const noexcept { return _word; }
+    value_type const* operator->() const noexcept { return &_word; }
+
+    iterator& operator++() noexcept
     {
-        Word,
-        NoWord
-    };
+        auto const* next = _word.data() + _word.size();
+        _word = value_type(next, next_word_boundary(value_type(next, static_cast<size_t>(_end - next))));
+        return *this;
+    }
 
-    iterator _left;
-    iterator _right;
-    State _state;
-    iterator _end;
+    iterator operator++(int) noexcept
+    {
+        auto tmp(*this);
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(iterator const& other) const noexcept { return _word.data() == other._word.data(); }
+    bool operator!=(iterator const& other) const noexcept { return !(*this == other); }
+
+  private:
+    value_type _word;
+    char const* _end;
 };
 
+inline utf8_word_segmenter::iterator utf8_word_segmenter::begin() const noexcept
+{
+    return iterator { _text.data(), _text.data() + _text.size() };
+}
+
+inline utf8_word_segmenter::iterator utf8_word_segmenter::end() const noexcept
+{
+    return iterator { _text.data() + _text.size(), _text.data() + _text.size() };
+}
+
 } // namespace unicode
@@ -11,31 +11,143 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <libunicode/convert.h>
 #include <libunicode/word_segmenter.h>
 
 #include <catch2/catch.hpp>
 
+#include <string>
+#include <vector>
+
 using namespace unicode;
 using namespace std::string_literals;
 using namespace std;
 
+namespace
+{
+
+auto words(u32string_view text)
+{
+    auto result = vector<u32string> {};
+    for (auto ws = word_segmenter(text); !ws.empty(); ++ws)
+        result.emplace_back(*ws);
+    return result;
+}
+
+auto utf8_words(string_view text)
+{
+    auto result = vector<string> {};
+    for (auto const word: utf8_word_segmenter(text))
+        result.emplace_back(word);
+    return result;
+}
+
+} // namespace
+
 TEST_CASE("word_segmenter.HelloWorld", "[word_segmenter]")
 {
     auto constexpr s = U"Hello, \t World!"sv;
 
     auto ws = word_segmenter(s);
-    CHECK(*ws == U"Hello,");
-    CHECK(ws.size() == 6);
+    CHECK(*ws == U"Hello");
+    CHECK(ws.size() == 5);
+
+    ++ws;
+    CHECK(*ws == U",");
+
+    ++ws;
+    CHECK(*ws == U" ");
 
     ++ws;
-    CHECK(*ws == U" \t ");
-    CHECK(ws.size() == 3);
+    CHECK(*ws == U"\t");
 
     ++ws;
-    CHECK(*ws == U"World!");
-    CHECK(ws.size() == 6);
+    CHECK(*ws == U" ");
+
+    ++ws;
+    CHECK(*ws == U"World");
+    CHECK(ws.size() == 5);
+
+    ++ws;
+    CHECK(*ws == U"!");
 
     ++ws;
     CHECK(*ws == U"");
     CHECK(ws.size() == 0);
+    CHECK(ws == word_segmenter(s.substr(s.size())));
+}
+
+TEST_CASE("word_segmenter.empty", "[word_segmenter]")
+{
+    CHECK(word_segmenter().empty());
+    CHECK(next_word_boundary(u32string_view {}) == 0);
+    CHECK(next_word_boundary(string_view {}) == 0);
+    CHECK(utf8_word_segmenter("").begin() == utf8_word_segmenter("").end());
+}
+
+TEST_CASE("word_segmenter.letters_and_digits", "[word_segmenter]")
+{
+    // WB6, WB7, WB11, WB12: letters and digits across punctuation, if followed by one.
+    CHECK(words(U"can't stop") == vector<u32string> { U"can't", U" ", U"stop" });
+    CHECK(words(U"e.g.") == vector<u32string> { U"e.g", U"." });
+    CHECK(words(U"3.14, 1,000") == vector<u32string> { U"3.14", U",", U" ", U"1,000" });
+    CHECK(words(U"a.1") == vector<u32string> { U"a", U".", U"1" });
+    CHECK(words(U"1.a") == vector<u32string> { U"1", U".", U"a" });
+    CHECK(words(U"a:") == vector<u32string> { U"a", U":" });
+    CHECK(words(U"a::b") == vector<u32string> { U"a", U":", U":", U"b" });
+
+    // WB9, WB10, WB13a, WB13b: letters, digits and connectors.
+    CHECK(words(U"snake_case42 x") == vector<u32string> { U"snake_case42", U" ", U"x" });
+
+    // WB4: Extend and Format characters are ignored.
+    CHECK(words(U"a\u0301.\u0301b") == vector<u32string> { U"a\u0301.\u0301b" });
+    CHECK(words(U"a\u00AD:") == vector<u32string> { U"a\u00AD", U":" });
+}
+
+TEST_CASE("word_segmenter.hebrew", "[word_segmenter]")
+{
+    // WB7a: Hebrew letter and single quote, WB7b/WB7c: double quote between Hebrew letters.
+    CHECK(words(U"\u05D0'") == vector<u32string> { U"\u05D0'" });
+    CHECK(words(U"\u05D0\"\u05D1") == vector<u32string> { U"\u05D0\"\u05D1" });
+    CHECK(words(U"\u05D0\"") == vector<u32string> { U"\u05D0", U"\"" });
+    CHECK(words(U"a'") == vector<u32string> { U"a", U"'" });
+}
+
+TEST_CASE("word_segmenter.katakana", "[word_segmenter]")
+{
+    CHECK(words(U"\u30A2\u30A4a") == vector<u32string> { U"\u30A2\u30A4", U"a" });
+}
+
+TEST_CASE("word_segmenter.newlines_and_spaces", "[word_segmenter]")
+{
+    // WB3, WB3a, WB3b, WB3d.
+    CHECK(words(U"a\r\n\r\nb") == vector<u32string> { U"a", U"\r\n", U"\r\n", U"b" });
+    CHECK(words(U"\n\u0301") == vector<u32string> { U"\n", U"\u0301" });
+    CHECK(words(U"a  \u0301 b") == vector<u32string> { U"a", U"  \u0301", U" ", U"b" });
+    CHECK(words(U"a:\n") == vector<u32string> { U"a", U":", U"\n" });
+}
+
+TEST_CASE("word_segmenter.emoji", "[word_segmenter]")
+{
+    // WB3c: emoji zwj sequences.
+    CHECK(words(U"\U0001F468\u200D\U0001F469!") == vector<u32string> { U"\U0001F468\u200D\U0001F469", U"!" });
+    CHECK(words(U" \u200D\U0001F469") == vector<u32string> { U" \u200D\U0001F469" });
+
+    // WB15, WB16: regional indicator pairs.
+    CHECK(words(U"\U0001F1E9\U0001F1EA\U0001F1EB\U0001F1F7\U0001F1EE")
+          == vector<u32string> { U"\U0001F1E9\U0001F1EA", U"\U0001F1EB\U0001F1F7", U"\U0001F1EE" });
+}
+
+TEST_CASE("word_segmenter.utf8", "[word_segmenter]")
+{
+    auto const text = U"Gr\u00FC\u00DFe, \u05D0\"\u05D1 3.14 \U0001F468\u200D\U0001F469 can't\r\n"s;
+
+    auto expected = vector<string> {};
+    for (auto const& word: words(text))
+        expected.emplace_back(convert_to<char>(u32string_view(word)));
+    CHECK(utf8_words(convert_to<char>(u32string_view(text))) == expected);
+
+    // Ill-formed sequences are words of their own, like U+FFFD.
+    CHECK(utf8_words("a\xC3 b\xFF") == vector<string> { "a", "\xC3", " ", "b", "\xFF" });
+    CHECK(utf8_words("ab\xE2\x82") == vector<string> { "ab", "\xE2\x82" });
 }
@@ -16,20 +16,36 @@
 #include <libunicode/grapheme_segmenter.h>
 #include <libunicode/run_segmenter.h>
 #include <libunicode/ucd.h>
-#include <libunicode/ucd_ostream.h>
+#include <libunicode/ucd_fmt.h>
 #include <libunicode/utf8.h>
+#include <libunicode/utf8_grapheme_segmenter.h>
+#include <libunicode/utf8_run_segmenter.h>
 #include <libunicode/width.h>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
 #include <array>
-#include <fstream>
-#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
-#include <memory>
 #include <numeric>
-#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+    #include <fcntl.h>
+    #include <io.h>
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
 
 using namespace std::string_literals;
 using namespace std::string_view_literals;
@@ -38,23 +54,12 @@ using std::array;
 using std::basic_string;
 using std::basic_string_view;
 using std::cerr;
-using std::cin;
-using std::cout;
-using std::get;
-using std::holds_alternative;
-using std::ifstream;
-using std::ios;
-using std::istream;
-using std::istreambuf_iterator;
-using std::make_unique;
 using std::optional;
 using std::pair;
 using std::string;
 using std::string_view;
 using std::u32string;
 using std::u32string_view;
-using std::unique_ptr;
-using std::variant;
 
 // {{{ escape(...)
 namespace
@@ -115,61 +120,379 @@ inline string escape(string const& s)
     return escape(begin(s), end(s));
 }
 
-} // namespace
 // }}}
 
-// TODO
-// void grapheme_clusters(istream& _in)
-// {
-//     while (_in.good())
-//     {
-//     }
-// }
+// {{{ input and output
+/// Input text, memory-mapped from a file, or read at once from standard input.
+class mapped_input
+{
+  public:
+    /// Maps the file at @p path, or reads standard input if @p path is "-".
+    explicit mapped_input(string const& path);
+    mapped_input(mapped_input const&) = delete;
+    mapped_input& operator=(mapped_input const&) = delete;
+    ~mapped_input();
+
+    [[nodiscard]] string_view text() const noexcept { return _text; }
+
+  private:
+    string _buffer; // contents of standard input
+    void* _mapping = nullptr;
+    size_t _mappingSize = 0;
+    string_view _text;
+};
 
-void codepoints(istream& in) // {{{
+mapped_input::mapped_input(string const& path)
 {
-    auto lastOffset = 0;
-    auto totalOffset = 0;
-    auto utf8_state = unicode::utf8_decoder_state {};
-    auto last_wc = char32_t {};
+    if (path == "-")
+    {
+        // Reads in chunks, doubling the buffer whenever it is full.
+        _buffer.resize(64 * 1024);
+        auto size = size_t { 0 };
+        while (auto const count = std::fread(_buffer.data() + size, 1, _buffer.size() - size, stdin))
+        {
+            size += count;
+            if (size == _buffer.size())
+                _buffer.resize(2 * _buffer.size());
+        }
+        if (std::ferror(stdin))
+            throw std::runtime_error("Could not read standard input.");
+        _buffer.resize(size);
+        _text = _buffer;
+        return;
+    }
+
+#if defined(_WIN32)
+    auto const file = CreateFileA(path.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_FLAG_SEQUENTIAL_SCAN,
+                                  nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Could not open file: "s + path);
+
+    auto fileSize = LARGE_INTEGER {};
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Could not determine file size: "s + path);
+    }
+    if (fileSize.QuadPart == 0) // cannot be mapped
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    auto const mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        throw std::runtime_error("Could not map file: "s + path);
+
+    _mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!_mapping)
+        throw std::runtime_error("Could not map file: "s + path);
+    _mappingSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::runtime_error("Could not open file: "s + path);
+
+    struct stat st {};
+    if (fstat(fd, &st) < 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Could not determine file size: "s + path);
+    }
+    if (st.st_size == 0) // cannot be mapped
+    {
+        ::close(fd);
+        return;
+    }
+
+    auto const size = static_cast<size_t>(st.st_size);
+    auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        throw std::runtime_error("Could not map file: "s + path);
+    madvise(data, size, MADV_SEQUENTIAL);
+    _mapping = data;
+    _mappingSize = size;
+#endif
+
+    _text = string_view(static_cast<char const*>(_mapping), _mappingSize);
+}
+
+mapped_input::~mapped_input()
+{
+    if (!_mapping)
+        return;
+#if defined(_WIN32)
+    UnmapViewOfFile(_mapping);
+#else
+    munmap(_mapping, _mappingSize);
+#endif
+}
+
+/// Output to standard output, formatted into a buffer that is written in large blocks.
+class output_buffer
+{
+  public:
+    output_buffer() { _buffer.reserve(Capacity + Capacity / 16); }
+    output_buffer(output_buffer const&) = delete;
+    output_buffer& operator=(output_buffer const&) = delete;
+    ~output_buffer() { flush(); }
+
+    template <typename... Args>
+    void print(fmt::format_string<Args...> format, Args&&... args)
+    {
+        fmt::format_to(std::back_inserter(_buffer), format, std::forward<Args>(args)...);
+        flushIfFull();
+    }
+
+    void write(void const* data, size_t size)
+    {
+        _buffer.append(static_cast<char const*>(data), size);
+        flushIfFull();
+    }
+
+    void flush()
+    {
+        std::fwrite(_buffer.data(), 1, _buffer.size(), stdout);
+        std::fflush(stdout);
+        _buffer.clear();
+    }
+
+  private:
+    static constexpr size_t Capacity = 1024 * 1024; // NOLINT(readability-identifier-naming)
+
+    void flushIfFull()
+    {
+        if (_buffer.size() >= Capacity)
+            flush();
+    }
+
+    string _buffer;
+};
+
+enum class output_format
+{
+    Text,
+    JsonLines,
+    Binary,
+};
+
+/// Record of the binary output format, in host byte order.
+struct binary_record
+{
+    uint64_t offset;      // in bytes
+    uint64_t length;      // in bytes
+    uint32_t codepoint;   // first codepoint of a grapheme cluster, 0 for runs
+    uint8_t type;         // 0 for a grapheme cluster, 1 for a run
+    uint8_t width;        // columns of a grapheme cluster, 0 for runs
+    uint8_t script;       // unicode::Script of a run, 0 for grapheme clusters
+    uint8_t presentation; // unicode::PresentationStyle of a run, 0 for grapheme clusters
+};
+static_assert(sizeof(binary_record) == 24);
+// }}}
+
+// {{{ segments
+size_t countCodepoints(string_view text) noexcept
+{
+    size_t count = 0;
+    for (size_t i = 0; i < text.size(); ++count)
+        i += unicode::decode_utf8_sequence(text.substr(i)).length;
+    return count;
+}
+
+struct segment_statistics
+{
+    size_t bytes = 0;
+    size_t codepoints = 0;
+    size_t graphemeClusters = 0;
+    size_t columns = 0;
+    size_t runs = 0;
+    size_t emojiRuns = 0;
+};
 
-    for (;;)
+void writeCluster(output_buffer& output,
+                  output_format format,
+                  size_t offset,
+                  unicode::utf8_grapheme_cluster const& cluster)
+{
+    switch (format)
     {
-        uint8_t ch {};
-        in.read((char*) &ch, sizeof(ch));
-        if (!in.good())
+        case output_format::Text:
+            output.print("{:>10} {:>4} grapheme U+{:04X} width:{} UTF8:{}\n",
+                         offset,
+                         cluster.text.size(),
+                         static_cast<uint32_t>(cluster.codepoint),
+                         cluster.width,
+                         escape(cluster.text.begin(), cluster.text.end()));
+            break;
+        case output_format::JsonLines:
+            output.print(R"({{"type":"grapheme","offset":{},"length":{},"codepoint":{},"width":{}}})"
+                         "\n",
+                         offset,
+                         cluster.text.size(),
+                         static_cast<uint32_t>(cluster.codepoint),
+                         cluster.width);
+            break;
+        case output_format::Binary: {
+            auto const record = binary_record { offset,
+                                                cluster.text.size(),
+                                                static_cast<uint32_t>(cluster.codepoint),
+                                                0,
+                                                static_cast<uint8_t>(cluster.width),
+                                                0,
+                                                0 };
+            output.write(&record, sizeof(record));
+            break;
+        }
+    }
+}
+
+void writeRun(output_buffer& output, output_format format, unicode::run_segmenter::range const& run)
+{
+    auto const script = std::get<unicode::Script>(run.properties);
+    auto const presentation = std::get<unicode::PresentationStyle>(run.properties);
+    switch (format)
+    {
+        case output_format::Text:
+            output.print(
+                "{:>10} {:>4} run      {} {}\n", run.start, run.end - run.start, script, presentation);
+            break;
+        case output_format::JsonLines:
+            output.print(R"({{"type":"run","offset":{},"length":{},"script":"{}","presentation":"{}"}})"
+                         "\n",
+                         run.start,
+                         run.end - run.start,
+                         script,
+                         presentation);
             break;
+        case output_format::Binary: {
+            auto const record = binary_record { run.start,
+                                                run.end - run.start,
+                                                0,
+                                                1,
+                                                0,
+                                                static_cast<uint8_t>(script),
+                                                static_cast<uint8_t>(presentation) };
+            output.write(&record, sizeof(record));
+            break;
+        }
+    }
+}
+
+void writeStatistics(output_buffer& output,
+                     output_format format,
+                     segment_statistics const& stats,
+                     std::chrono::duration<double> elapsed)
+{
+    auto const seconds = elapsed.count();
+    auto const megabytesPerSecond = seconds > 0 ? static_cast<double>(stats.bytes) / 1e6 / seconds : 0.0;
+    if (format == output_format::JsonLines)
+    {
+        output.print(R"({{"bytes":{},"codepoints":{},"grapheme_clusters":{},"columns":{},"runs":{},)"
+                     R"("emoji_runs":{},"seconds":{:.6f},"megabytes_per_second":{:.1f}}})"
+                     "\n",
+                     stats.bytes,
+                     stats.codepoints,
+                     stats.graphemeClusters,
+                     stats.columns,
+                     stats.runs,
+                     stats.emojiRuns,
+                     seconds,
+                     megabytesPerSecond);
+        return;
+    }
+
+    output.print("bytes:             {}\n", stats.bytes);
+    output.print("codepoints:        {}\n", stats.codepoints);
+    output.print("grapheme clusters: {}\n", stats.graphemeClusters);
+    output.print("columns:           {}\n", stats.columns);
+    output.print("runs:              {} ({} emoji)\n", stats.runs, stats.emojiRuns);
+    output.print("time:              {:.3f} s\n", seconds);
+    output.print("throughput:        {:.1f} MB/s\n", megabytesPerSecond);
+}
+// }}}
+
+/// Segments the text into grapheme clusters and into runs of script and presentation style (emoji or text)
+/// in a single pass over the text, a window at a time, such that both segmenters process each window
+/// while it is in the cache, writing the segments as they complete.
+///
+/// With @p statsOnly, only a summary of the counts and the throughput is written.
+void segments(string_view text, output_format format, bool statsOnly) // {{{
+{
+    auto constexpr WindowSize = size_t { 64 * 1024 };
+
+    auto output = output_buffer {};
+    auto stats = segment_statistics {};
+    stats.bytes = text.size();
+    auto const startTime = std::chrono::steady_clock::now();
+
+    auto const onCluster = [&](unicode::utf8_grapheme_cluster const& cluster) {
+        ++stats.graphemeClusters;
+        stats.codepoints += countCodepoints(cluster.text);
+        stats.columns += cluster.width;
+        if (!statsOnly)
+            writeCluster(output, format, static_cast<size_t>(cluster.text.data() - text.data()), cluster);
+    };
+    auto const onRun = unicode::utf8_run_segmenter::range_handler { [&](auto const& run) {
+        ++stats.runs;
+        if (std::get<unicode::PresentationStyle>(run.properties) == unicode::PresentationStyle::Emoji)
+            ++stats.emojiRuns;
+        if (!statsOnly)
+            writeRun(output, format, run);
+    } };
+
+    auto const clusters = unicode::utf8_grapheme_cluster_segmenter { text };
+    auto cluster = clusters.begin();
+    auto const clustersEnd = clusters.end();
+    auto runs = unicode::utf8_run_segmenter {};
+    for (size_t windowStart = 0; windowStart < text.size(); windowStart += WindowSize)
+    {
+        auto const window = text.substr(windowStart, WindowSize);
+        runs.feed(window, onRun);
+        auto const* const windowEnd = window.data() + window.size();
+        for (; cluster != clustersEnd && cluster->text.data() + cluster->text.size() <= windowEnd; ++cluster)
+            onCluster(*cluster);
+    }
+    runs.finish(onRun);
+    for (; cluster != clustersEnd; ++cluster)
+        onCluster(*cluster);
 
-        totalOffset++;
+    if (statsOnly)
+        writeStatistics(output, format, stats, std::chrono::steady_clock::now() - startTime);
+} // }}}
 
-        auto const convertResult = from_utf8(utf8_state, ch);
+void codepoints(string_view text) // {{{
+{
+    auto output = output_buffer {};
+    auto last_wc = char32_t {};
 
-        if (holds_alternative<unicode::Success>(convertResult))
+    for (size_t offset = 0; offset < text.size();)
+    {
+        auto const sequence = unicode::decode_utf8_sequence(text.substr(offset));
+        if (sequence.status == unicode::ConversionStatus::Success)
         {
-            char32_t const wc = get<unicode::Success>(convertResult).value;
+            char32_t const wc = sequence.value;
             int const width = unicode::width(wc);
             bool breakable = !last_wc || unicode::grapheme_segmenter::breakable(last_wc, wc);
             last_wc = wc;
-            // TODO: breakable buggy lol what?
-            if (width >= 0)
-            {
-                string const u8 = escape(unicode::to_utf8(wc));
-
-                cout << fmt::format("{:>3}: U+{:08X} [{}] [{:<10}] {} width:{} UTF8:{}\n",
-                                    lastOffset,
-                                    static_cast<uint32_t>(wc),
-                                    isEmoji(wc) ? "EMOJI" : "TEXT ",
-                                    unicode::script(wc),
-                                    breakable ? "[breakable  ]" : "[unbreakable]",
-                                    width,
-                                    u8);
-            }
-            lastOffset = totalOffset;
-        }
-        else if (holds_alternative<unicode::Invalid>(convertResult))
-        {
-            lastOffset = totalOffset;
+            auto const u8 = text.substr(offset, sequence.length);
+            output.print("{:>3}: U+{:08X} [{}] [{:<10}] {} width:{} UTF8:{}\n",
+                         offset,
+                         static_cast<uint32_t>(wc),
+                         isEmoji(wc) ? "EMOJI" : "TEXT ",
+                         fmt::format("{}", unicode::script(wc)),
+                         breakable ? "[breakable  ]" : "[unbreakable]",
+                         width,
+                         escape(u8.begin(), u8.end()));
         }
+        offset += sequence.length;
     }
 } // }}}
 
@@ -181,20 +504,19 @@ string scriptExtensionsString(char32_t codepoint)
 {
     array<unicode::Script, 32> scripts {};
     size_t count = unicode::script_extensions(codepoint, scripts.data(), scripts.size());
-    std::stringstream sstr;
+    string result;
     for (size_t i = 0; i < count; ++i)
     {
         if (i)
-            sstr << ", ";
-        sstr << fmt::format("{}", scripts[i]);
+            result += ", ";
+        result += fmt::format("{}", scripts[i]);
     }
-    return sstr.str();
+    return result;
 }
 
-int scripts(istream& in) // {{{
+int scripts(string_view text) // {{{
 {
-    string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
-    u32string const codepoints = convert_to<char32_t>(string_view(bytes));
+    u32string const codepoints = convert_to<char32_t>(text);
 
     unicode::script_segmenter segmenter(codepoints);
 
@@ -202,20 +524,21 @@ int scripts(istream& in) // {{{
     size_t nextPosition {};
     unicode::Script script {};
 
-    cout << "   INDEX     CODEPOINT    TEXT  WIDTH   SCRIPT          SCRIPT EXTS\n";
+    auto output = output_buffer {};
+    output.print("   INDEX     CODEPOINT    TEXT  WIDTH   SCRIPT          SCRIPT EXTS\n");
     while (segmenter.consume(out(nextPosition), out(script)))
     {
-        cout << fmt::format("{}-{}: {}\n", frontPosition, nextPosition - 1, script);
+        output.print("{}-{}: {}\n", frontPosition, nextPosition - 1, script);
         for (size_t i = frontPosition; i < nextPosition; ++i)
         {
             auto const cp = codepoints[i];
-            cout << fmt::format("    {:>04}:    U+{:08X}   {}\t∆ {}\t{:<12}\t({})\n",
-                                i,
-                                unsigned(cp),
-                                convert_to<char>(cp),
-                                unicode::width(cp),
-                                unicode::script(cp),
-                                scriptExtensionsString(cp));
+            output.print("    {:>04}:    U+{:08X}   {}\t∆ {}\t{:<12}\t({})\n",
+                         i,
+                         unsigned(cp),
+                         convert_to<char>(cp),
+                         unicode::width(cp),
+                         fmt::format("{}", unicode::script(cp)),
+                         scriptExtensionsString(cp));
         }
         frontPosition = nextPosition;
     }
@@ -223,26 +546,25 @@ int scripts(istream& in) // {{{
     return EXIT_SUCCESS;
 } // }}}
 
-int runs(istream& in) // {{{
+int runs(string_view text) // {{{
 {
-    string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
-    u32string const codepoints = convert_to<char32_t>(string_view(bytes));
+    u32string const codepoints = convert_to<char32_t>(text);
 
     run_segmenter rs(codepoints);
     run_segmenter::range run;
 
+    auto output = output_buffer {};
     while (rs.consume(out(run)))
     {
-        auto const script = get<unicode::Script>(run.properties);
-        auto const presentationStyle = get<unicode::PresentationStyle>(run.properties);
+        auto const script = std::get<unicode::Script>(run.properties);
+        auto const presentationStyle = std::get<unicode::PresentationStyle>(run.properties);
 
-        cout << fmt::format(
+        output.print(
             "{}-{} ({}): {} {}\n", run.start, run.end - 1, run.end - run.start, script, presentationStyle);
         auto const text32 = u32string_view(codepoints.data() + run.start, run.end - run.start);
         auto const text8 = convert_to<char>(text32);
         auto const textEscaped = replaceAll("\033"sv, "\\033"sv, string_view(text8));
-        cout << '"' << "\033[32m" << textEscaped << "\033[m"
-             << "\"\n\n";
+        output.print("\"\033[32m{}\033[m\"\n\n", textEscaped);
     }
 
     return EXIT_SUCCESS;
@@ -253,63 +575,119 @@ enum class Cmd
     Codepoints,
     Runs,
     Scripts,
+    Segments,
 };
 
-using InputStream = variant<istream*, unique_ptr<istream>>;
-
-auto parseArgs(int argc, char const* argv[]) -> optional<pair<Cmd, InputStream>>
+struct Options
 {
-    auto constexpr DefaultCmd = Cmd::Codepoints;
-
-    if (argc != 3)
-        return { { DefaultCmd, &cin } };
+    Cmd cmd = Cmd::Codepoints;
+    string inputFile = "-";
+    output_format format = output_format::Text;
+    bool stats = false;
+};
 
-    string_view const arg = argv[1];
+auto parseArgs(int argc, char const* argv[]) -> optional<Options>
+{
+    static auto constexpr commands = array<pair<string_view, Cmd>, 5> {
+        pair { "codepoints"sv, Cmd::Codepoints }, pair { "cp"sv, Cmd::Codepoints },
+        pair { "runs"sv, Cmd::Runs },             pair { "scripts"sv, Cmd::Scripts },
+        pair { "segments"sv, Cmd::Segments },
+    };
+    static auto constexpr formats = array<pair<string_view, output_format>, 3> {
+        pair { "text"sv, output_format::Text },
+        pair { "jsonl"sv, output_format::JsonLines },
+        pair { "binary"sv, output_format::Binary },
+    };
+    auto constexpr FormatOption = "--format="sv;
+
+    auto options = Options {};
+    auto positionals = std::vector<string_view> {};
+    for (int i = 1; i < argc; ++i)
+    {
+        auto const arg = string_view(argv[i]);
+        if (arg == "--stats")
+            options.stats = true;
+        else if (arg.starts_with(FormatOption))
+        {
+            auto const name = arg.substr(FormatOption.size());
+            auto const format = std::find_if(
+                formats.begin(), formats.end(), [&](auto const& mapping) { return mapping.first == name; });
+            if (format == formats.end())
+                return std::nullopt;
+            options.format = format->second;
+        }
+        else if (arg.starts_with("--"))
+            return std::nullopt;
+        else
+            positionals.push_back(arg);
+    }
+    if (positionals.size() > 2)
+        return std::nullopt;
 
-    static auto constexpr mappings =
-        array<pair<string_view, Cmd>, 4> { pair { "codepoints"sv, Cmd::Codepoints },
-                                           pair { "cp"sv, Cmd::Codepoints },
-                                           pair { "runs"sv, Cmd::Runs },
-                                           pair { "scripts"sv, Cmd::Scripts } };
+    auto const command = [&](string_view name) {
+        return std::find_if(
+            commands.begin(), commands.end(), [&](auto const& mapping) { return mapping.first == name; });
+    };
 
-    for (auto const& mapping: mappings)
-        if (mapping.first == arg)
-            return { { mapping.second, make_unique<ifstream>(argv[2], ios::binary) } };
+    // A single argument is either the command or the input file, the command defaulting to codepoints.
+    if (!positionals.empty())
+    {
+        if (auto const i = command(positionals.front()); i != commands.end())
+        {
+            options.cmd = i->second;
+            positionals.erase(positionals.begin());
+        }
+        else if (positionals.size() == 2)
+            return std::nullopt;
+    }
+    if (!positionals.empty())
+        options.inputFile = string(positionals.front());
+    if (options.stats)
+        options.cmd = Cmd::Segments;
 
-    return { { DefaultCmd, make_unique<ifstream>(argv[2], ios::binary) } };
+    return options;
 }
 
 int run(int argc, char const* argv[])
 {
-    // TODO: hb-inspect codepoints FILE           Inspects source by UTF-32 codepoints
-    // TODO: hb-inspect grapheme-clusters FILE    Inspects source by grapheme cluster
-    // TODO: hb-inspect script-clusters FILE      Inspects source by script cluster
-
-    auto args = parseArgs(argc, argv);
-    if (!args.has_value())
+    auto const options = parseArgs(argc, argv);
+    if (!options.has_value())
     {
         cerr << "Usage error.\n"
              << "Usage:\n"
-             << "    uc-inspect codepoints FILE\n"
-             << "    uc-inspect runs FILE\n"
-             << "    uc-inspect scripts FILE\n";
+             << "    uc-inspect [codepoints] [FILE]\n"
+             << "    uc-inspect runs [FILE]\n"
+             << "    uc-inspect scripts [FILE]\n"
+             << "    uc-inspect segments [--format=text|jsonl|binary] [FILE]\n"
+             << "    uc-inspect --stats [--format=text|jsonl] [FILE]\n"
+             << "\n"
+             << "FILE is memory-mapped, and defaults to - for the standard input.\n"
+             << "segments writes the grapheme clusters and the runs of script and presentation style\n"
+             << "of a single pass over the input. --stats writes a summary of that pass only.\n";
         return EXIT_FAILURE;
     }
 
-    auto& [cmd, inputStreamVar] = *args;
-    istream& in = holds_alternative<istream*>(inputStreamVar) ? *get<istream*>(inputStreamVar)
-                                                              : *get<unique_ptr<istream>>(inputStreamVar);
+#if defined(_WIN32)
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
 
-    switch (cmd)
+    auto const input = mapped_input { options->inputFile };
+    auto const text = input.text();
+
+    switch (options->cmd)
     {
-        case Cmd::Codepoints: codepoints(in); break;
-        case Cmd::Runs: runs(in); break;
-        case Cmd::Scripts: scripts(in); break;
+        case Cmd::Codepoints: codepoints(text); break;
+        case Cmd::Runs: runs(text); break;
+        case Cmd::Scripts: scripts(text); break;
+        case Cmd::Segments: segments(text, options->format, options->stats); break;
     }
 
     return EXIT_SUCCESS;
 }
 
+} // namespace
+
 int main(int argc, char const* argv[])
 {
     try